@@ -18,6 +18,12 @@ NV_BOOL chrtr2 (NV_INT32 file_number, nvMap *map, MISC *misc, OPTIONS *options)
   if (hnd < 0) return (NVTrue);
 
 
+  //  We read the displayed window twice (min/max pass and drawing pass) so we let the CHRTR2 library cache the
+  //  blocks.  For tiled files this also means that each tile is only read from disk once.
+
+  chrtr2_open_cache (hnd, 128);
+
+
   misc->overlays[k][file_number].x_bin_size_degrees = (NV_FLOAT64) header.lon_grid_size_degrees;
   misc->overlays[k][file_number].y_bin_size_degrees = (NV_FLOAT64) header.lat_grid_size_degrees;
   misc->overlays[k][file_number].mbr.min_x = (NV_FLOAT64) header.mbr.wlon;
@@ -16,7 +16,7 @@
 
 #ifndef VERSION
 
-#define     VERSION     "PFM Software - areaCheck V5.11 - 07/22/11"
+#define     VERSION     "PFM Software - areaCheck V5.12 - 10/19/26"
 
 #endif
 
@@ -506,4 +506,12 @@
     Using setSidebarUrls function from nvutility to make sure that current working directory (.) and
     last used directory are in the sidebar URL list of QFileDialogs.
 
+
+    Version 5.12
+    Jan C. Depner
+    10/19/26
+
+    Opens a CHRTR2 block cache when drawing CHRTR2 overlays so the window is only read from disk once (and so tiled
+    CHRTR2 files are read a tile at a time).
+
 */
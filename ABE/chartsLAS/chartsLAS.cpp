@@ -334,453 +334,444 @@ chartsLAS::slotCustomButtonClicked (int id __attribute__ ((unused)))
     }
 
 
-  //  Main processing loop
+  //  Build the area index grid over the combined MBR of the areas that we were able to read.  Since the areas are added
+  //  to the cells in order we'll get the same area that the old, check every area, method got.
 
-  TOF_HEADER_T                    tof_header;
-  TOPO_OUTPUT_T                   tof;
-  HOF_HEADER_T                    hof_header;
-  HYDRO_OUTPUT_T                  hof;
-  NV_INT32                        prev_hit = -1;
+  AREA_INDEX area_index;
+  NV_INT32 good_areas = 0;
 
+  memset (&area_index, 0, sizeof (AREA_INDEX));
 
-  progress.obar->setRange (0, input_file_count * 100);
-
-
-  //  Loop through each input file.
-
-  FILE *fp;
-  NV_CHAR string[1024];
-
-
-  for (NV_INT32 i = 0 ; i < input_file_count ; i++)
+  for (NV_INT32 i = 0 ; i < input_area_count ; i++)
     {
-      for (NV_INT32 j = 0 ; j < input_area_count ; j++)
-        {
-          input_area_def[j].writer = NULL;
-          input_area_def[j].header = NULL;
-          input_area_def[j].opened = NVFalse;
-        }
-
-
-      strcpy (string, input_file_def[i].name.toAscii ());
-
-
-      QString status;
-      status.sprintf ("Processing file %d of %d : ", i + 1, input_file_count);
-      status += QFileInfo (input_file_def[i].name).fileName ();
-
-      QListWidgetItem *stat = new QListWidgetItem (status);
-
-      progress.list->addItem (stat);
-      progress.list->setCurrentItem (stat);
-      progress.list->scrollToItem (stat);
+      input_area_def[i].prepared = NULL;
+      input_area_def[i].ascfp[0] = input_area_def[i].ascfp[1] = input_area_def[i].hasfp = NULL;
+      input_area_def[i].writer = NULL;
+      input_area_def[i].header = NULL;
+      input_area_def[i].opened = NVFalse;
 
-
-      //  TOF file section
-
-      if (input_file_def[i].type)
+      if (input_area_def[i].poly_count)
         {
-          //  Try to open the input file.
+          if (!input_area_def[i].rect_flag)
+            input_area_def[i].prepared = prepare_polygon2 (input_area_def[i].polygon_x, input_area_def[i].polygon_y,
+                                                           input_area_def[i].poly_count);
 
-          if ((fp = open_tof_file (string)) == NULL)
+          if (!good_areas)
             {
-              QMessageBox::warning (this, tr ("chartsLAS Open input files"), tr ("The file ") + input_file_def[i].name + 
-                                    tr (" could not be opened.") + tr ("  The error message returned was:\n\n") +
-                                    QString (strerror (errno)));
+              area_index.mbr = input_area_def[i].mbr;
             }
           else
             {
-              //  Read the header
-
-              tof_read_header (fp, &tof_header);
-
-
-              //  Check for files older than 10/07/2011.  At that point we changed the way we load TOF data into PFM
-              //  so that we load first returns even if the second return is bad.
-
-              ver_dep_flag = NVFalse;
-              NV_INT64 hd_start_time;
-              sscanf (tof_header.text.start_time, NV_INT64_SPECIFIER, &hd_start_time);
-              if (hd_start_time < 1317945600000000LL) ver_dep_flag = NVTrue;
+              area_index.mbr.min_x = qMin (area_index.mbr.min_x, input_area_def[i].mbr.min_x);
+              area_index.mbr.min_y = qMin (area_index.mbr.min_y, input_area_def[i].mbr.min_y);
+              area_index.mbr.max_x = qMax (area_index.mbr.max_x, input_area_def[i].mbr.max_x);
+              area_index.mbr.max_y = qMax (area_index.mbr.max_y, input_area_def[i].mbr.max_y);
+            }
 
+          good_areas++;
+        }
+    }
 
-              progress.fbar->reset ();
+  if (good_areas)
+    {
+      area_index.width = area_index.height = AREA_INDEX_SIZE;
 
-              progress.fbox->setTitle (QFileInfo (input_file_def[i].name).fileName ());
+      area_index.x_size = (area_index.mbr.max_x - area_index.mbr.min_x) / (NV_FLOAT64) area_index.width;
+      area_index.y_size = (area_index.mbr.max_y - area_index.mbr.min_y) / (NV_FLOAT64) area_index.height;
+      if (area_index.x_size <= 0.0) area_index.x_size = 1.0;
+      if (area_index.y_size <= 0.0) area_index.y_size = 1.0;
 
-              progress.fbar->setRange (0, tof_header.text.number_shots);
+      NV_INT32 cells = area_index.width * area_index.height;
 
+      area_index.cell_start = (NV_INT32 *) calloc (cells + 1, sizeof (NV_INT32));
+      NV_INT32 *cell_fill = (NV_INT32 *) calloc (cells, sizeof (NV_INT32));
 
-              NV_INT32 prog_count = 0;
+      if (area_index.cell_start == NULL || cell_fill == NULL)
+        {
+          perror ("Allocating area index");
+          exit (-1);
+        }
 
 
-              //  Loop through the entire file reading each record.
+      //  First pass counts the areas in each cell, second pass fills them in.
 
-              while (tof_read_record (fp, TOF_NEXT_RECORD, &tof))
+      for (NV_INT32 pass = 0 ; pass < 2 ; pass++)
+        {
+          for (NV_INT32 i = 0 ; i < input_area_count ; i++)
+            {
+              if (!input_area_def[i].poly_count) continue;
+
+              NV_INT32 start_col = qMin ((NV_INT32) ((input_area_def[i].mbr.min_x - area_index.mbr.min_x) / area_index.x_size),
+                                         area_index.width - 1);
+              NV_INT32 end_col = qMin ((NV_INT32) ((input_area_def[i].mbr.max_x - area_index.mbr.min_x) / area_index.x_size),
+                                       area_index.width - 1);
+              NV_INT32 start_row = qMin ((NV_INT32) ((input_area_def[i].mbr.min_y - area_index.mbr.min_y) / area_index.y_size),
+                                         area_index.height - 1);
+              NV_INT32 end_row = qMin ((NV_INT32) ((input_area_def[i].mbr.max_y - area_index.mbr.min_y) / area_index.y_size),
+                                       area_index.height - 1);
+
+              for (NV_INT32 row = start_row ; row <= end_row ; row++)
                 {
-                  for (NV_INT32 k = 0 ; k < 2 ; k++)
+                  for (NV_INT32 col = start_col ; col <= end_col ; col++)
                     {
-                      NV_FLOAT64 lat, lon;
+                      NV_INT32 cell = row * area_index.width + col;
 
-                      if (k)
+                      if (pass)
                         {
-                          lat = tof.latitude_last;
-                          lon = tof.longitude_last;
+                          area_index.cell_area[cell_fill[cell]++] = i;
                         }
                       else
                         {
-                          lat = tof.latitude_first;
-                          lon = tof.longitude_first;
+                          area_index.cell_start[cell + 1]++;
                         }
+                    }
+                }
+            }
 
+          if (!pass)
+            {
+              for (NV_INT32 i = 0 ; i < cells ; i++)
+                {
+                  area_index.cell_start[i + 1] += area_index.cell_start[i];
+                  cell_fill[i] = area_index.cell_start[i];
+                }
 
-                      //  Check against last area hit first then if it's not in that box check the rest.
-
-                      NV_INT32 hit = -1;
-
-                      if (prev_hit != -1)
-                        {
-                          if (input_area_def[prev_hit].rect_flag)
-                            {
-                              if (lon >= input_area_def[prev_hit].mbr.min_x && lon <= input_area_def[prev_hit].mbr.max_x &&
-                                  lat >= input_area_def[prev_hit].mbr.min_y && lat <= input_area_def[prev_hit].mbr.max_y) hit = prev_hit;
-                            }
-                          else
-                            {
-                              if (inside_polygon2 (input_area_def[prev_hit].polygon_x, input_area_def[prev_hit].polygon_y, 
-                                                   input_area_def[prev_hit].poly_count, lon, lat)) hit = prev_hit;
-                            }
-                        }
+              area_index.cell_area = (NV_INT32 *) malloc (area_index.cell_start[cells] * sizeof (NV_INT32));
 
+              if (area_index.cell_area == NULL)
+                {
+                  perror ("Allocating area index");
+                  exit (-1);
+                }
+            }
+        }
 
-                      //  If the point wasn't in the previous area, beat the input point against all of the area boundaries to find
-                      //  out which one it is in (if any).
+      free (cell_fill);
+    }
 
-                      if (hit == -1)
-                        {
-                          for (NV_INT32 j = 0 ; j < input_area_count ; j++)
-                            {
-                              if (input_area_def[j].rect_flag)
-                                {
-                                  if (lon >= input_area_def[j].mbr.min_x && lon <= input_area_def[j].mbr.max_x &&
-                                      lat >= input_area_def[j].mbr.min_y && lat <= input_area_def[j].mbr.max_y)
-                                    {
-                                      hit = j;
-                                      break;
-                                    }
-                                }
-                              else
-                                {
-                                  if (inside_polygon2 (input_area_def[j].polygon_x, input_area_def[j].polygon_y, 
-                                                       input_area_def[j].poly_count, lon, lat))
-                                    {
-                                      hit = j;
-                                      break;
-                                    }
-                                }
-                            }
-                        }
-                      prev_hit = hit;
 
+  //  Read the input file headers.  The CHARTS library sets a static byte swap flag when it reads a header so we do
+  //  this before the input threads are started.  The threads' record reads use the flag from the last TOF or HOF header
+  //  read here so, if the files don't all have the same byte order, we only use one thread and it reads each header
+  //  again.
 
-                      //  If the point is in one of the areas, we need to create or open an LAS file and a pair of ASCII
-                      //  files.
+  FILE_QUEUE queue;
 
-                      if (hit >= 0)
-                        {
-                          QString new_file, asc_file, ext;
-                          ext.sprintf (".ta%1d", k + 1);
+  queue.file = (FILE_STATE *) calloc (qMax (input_file_count, 1), sizeof (FILE_STATE));
 
-                          new_file = input_area_def[hit].dir_name + "/" + filePrefix + "__Area_" + input_area_def[hit].name + "__" + 
-                            QFileInfo (input_file_def[i].name).baseName () + ".las";
-                          asc_file = input_area_def[hit].dir_name + "/" + filePrefix + "__Area_" + input_area_def[hit].name + ext;
+  if (queue.file == NULL)
+    {
+      perror ("Allocating input file information");
+      exit (-1);
+    }
 
+  NV_INT32 endian[2] = {-1, -1};
+  queue.read_headers = NVFalse;
 
-                          NV_CHAR nf[1024], af[2][1024];
-                          strcpy (nf, new_file.toAscii ());
-                          strcpy (af[k], asc_file.toAscii ());
+  for (NV_INT32 i = 0 ; i < input_file_count ; i++)
+    {
+      NV_CHAR string[1024];
+      strcpy (string, input_file_def[i].name.toAscii ());
 
+      FILE *fp;
+      NV_INT32 file_endian = 0;
 
-                          QFileInfo new_file_info (new_file);
-                          QFileInfo asc_file_info (asc_file);
+      if (input_file_def[i].type)
+        {
+          if ((fp = open_tof_file (string)) != NULL)
+            {
+              tof_read_header (fp, &queue.file[i].tof_header);
+              queue.file[i].number_shots = queue.file[i].tof_header.text.number_shots;
+              file_endian = queue.file[i].tof_header.text.endian;
+            }
+        }
+      else
+        {
+          HOF_HEADER_T hof_header;
 
+          if ((fp = open_hof_file (string)) != NULL)
+            {
+              hof_read_header (fp, &hof_header);
+              queue.file[i].number_shots = hof_header.text.number_shots;
+              file_endian = hof_header.text.endian;
+            }
+        }
 
-                          //  If the las file for this area already exists but we didn't create it (opened = NVFalse) then
-                          //  we need to get rid of it.
+      queue.file[i].error = errno;
 
-                          if (new_file_info.exists () && !input_area_def[hit].opened) remove (nf);
+      if (fp != NULL)
+        {
+          queue.file[i].opened = NVTrue;
 
+          NV_INT32 type = input_file_def[i].type ? 1 : 0;
 
-                          //  If the ASCII file doesn't exist, create it and write the header
+          if (endian[type] != -1 && endian[type] != file_endian) queue.read_headers = NVTrue;
+          endian[type] = file_endian;
 
-                          if (!asc_file_info.exists ())
-                            {
-                              if ((input_area_def[hit].ascfp[k] = fopen64 (af[k], "w")) == NULL)
-                                {
-                                  perror (af[k]);
-                                  exit (-1);
-                                }
+          fclose (fp);
+        }
+    }
 
-                              fprintf (input_area_def[hit].ascfp[k], 
-                                       "# LONGITUDE, LATITUDE, UTM ZONE, EASTING, NORTHING, ELEV, ELEV (ellipsoid),  YYYY/MM/DD,HH:MM:SS.SSSSSS INTENSITY\n");
-                            }
 
+  //  Main processing loop.  The input files are read by the input threads (each with its own copy of the area
+  //  projections) while this thread writes the per area output of each input file in order.  The slot count is capped
+  //  at MAX_INPUT_SLOTS so the memory used doesn't grow with the number of cores.
 
-                          //  If the ASCII file exists, open it.
+  NV_INT32 num_threads = qMin (qMax (QThread::idealThreadCount (), 1), MAX_INPUT_THREADS);
+  if (num_threads > input_file_count) num_threads = qMax (input_file_count, 1);
+  if (queue.read_headers) num_threads = 1;
 
-                          else
-                            {
-                              if (input_area_def[hit].ascfp[k] == NULL)
-                                {
-                                  if ((input_area_def[hit].ascfp[k] = fopen64 (af[k], "a")) == NULL)
-                                    {
-                                      perror (af[k]);
-                                      exit (-1);
-                                    }
-                                }
-                            }
+  queue.num_files = input_file_count;
+  queue.next_file = 0;
+  queue.write_file = 0;
+  queue.num_slots = qMin (qMax (num_threads * 2, 2), MAX_INPUT_SLOTS);
+  queue.free_slots = queue.num_slots;
 
+  queue.slot = (CHUNK_SLOT *) calloc (queue.num_slots, sizeof (CHUNK_SLOT));
 
+  if (queue.slot == NULL)
+    {
+      perror ("Allocating input chunk slots");
+      exit (-1);
+    }
 
-                          //  If the LAS file doesn't exist, create it and write the dummy header (place holder)
 
-                          if (!new_file_info.exists ())
-                            {
-                              //  write partial header as placeholder
+  inputThread input_thread[MAX_INPUT_THREADS];
 
-                              input_area_def[hit].tmp_num_recs[0] = 0;
-                              input_area_def[hit].tmp_num_recs[1] = 0;
+  for (NV_INT32 i = 0 ; i < num_threads ; i++)
+    input_thread[i].prepare (&queue, input_file_def, input_area_def, input_area_count, &area_index, geoid03);
 
-                              input_area_def[hit].min.x = 99999999999.0;
-                              input_area_def[hit].max.x = -99999999999.0;
-                              input_area_def[hit].min.y = 99999999999.0;
-                              input_area_def[hit].max.y = -99999999999.0;
-                              input_area_def[hit].min.z = 99999999999.0;
-                              input_area_def[hit].max.z = -99999999999.0;
 
-                              if (!writeLASHeader (nf, tof_header, &input_area_def[hit]))
-                                {
-                                  LASError_Print ("Could not open LAS file");
-                                  exit (-1);
-                                }
-                            }
+  progress.obar->setRange (0, input_file_count * 100);
 
 
-                          //  Write out the LAS record
+  //  Loop through each input file.
 
-                          writeLASRecord (tof, &input_area_def[hit], k);
+  for (NV_INT32 i = 0 ; i < input_file_count ; i++)
+    {
+      QString status;
+      status.sprintf ("Processing file %d of %d : ", i + 1, input_file_count);
+      status += QFileInfo (input_file_def[i].name).fileName ();
 
+      QListWidgetItem *stat = new QListWidgetItem (status);
 
-                          //  Write out the ASCII record
+      progress.list->addItem (stat);
+      progress.list->setCurrentItem (stat);
+      progress.list->scrollToItem (stat);
 
-                          writeTOFASCRecord (tof, k, &input_area_def[hit]);
-                        }
-                    }
+      progress.fbar->reset ();
 
+      progress.fbox->setTitle (QFileInfo (input_file_def[i].name).fileName ());
 
-                  progress.fbar->setValue (prog_count);
+      if (queue.file[i].number_shots) progress.fbar->setRange (0, queue.file[i].number_shots);
 
-                  progress.obar->setValue (i * 100 + (NV_INT32) (((NV_FLOAT32) prog_count / 
-                                                                  (NV_FLOAT32) tof_header.text.number_shots) * 100.0));
-                  qApp->processEvents ();
 
-                  prog_count++;
-                }
+      //  Write the file's chunks in order.
 
-              fclose (fp);
+      NV_INT32 chunk = 0;
+      NV_BOOL last = NVFalse;
 
-              progress.fbar->setValue (tof_header.text.number_shots);
+      while (!last)
+        {
+          //  Wait for the chunk.  The input threads wake us up whenever they finish a chunk.  The timeout is only there
+          //  so that we can keep the progress bars and the rest of the GUI alive while the file is being read.
 
+          CHUNK_SLOT *slot = NULL;
 
-              //  Write final header for each LAS file and close the LAS files and ASCII files
+          queue.mutex.lock ();
 
-              for (NV_INT32 i = 0 ; i < input_area_count ; i++)
+          while (1)
+            {
+              for (NV_INT32 j = 0 ; j < queue.num_slots ; j++)
                 {
-                  if (input_area_def[i].opened) 
+                  if (queue.slot[j].state == SLOT_READY && queue.slot[j].file == i && queue.slot[j].chunk == chunk)
                     {
-                      writeLASHeader (NULL, tof_header, &input_area_def[i]);
-
-                      if (input_area_def[i].ascfp[0] != NULL) fclose (input_area_def[i].ascfp[0]);
-                      if (input_area_def[i].ascfp[1] != NULL) fclose (input_area_def[i].ascfp[1]);
-                      input_area_def[i].ascfp[0] = NULL;
-                      input_area_def[i].ascfp[1] = NULL;
+                      slot = &queue.slot[j];
+                      break;
                     }
-                  input_area_def[i].opened = NVFalse;
                 }
-            }
-        }
 
+              if (slot != NULL) break;
 
-      //  HOF file section
-
-      else
-        {
-          //  Try to open the HOF file
-
-          if ((fp = open_hof_file (string)) == NULL)
-            {
-              QMessageBox::warning (this, tr ("Open input files"), tr ("The file ") + input_file_def[i].name + 
-                                    tr (" could not be opened.") + tr ("  The error message returned was:\n\n") +
-                                    QString (strerror (errno)));
-            }
-          else
-            {
-              //  Read the header
-
-              hof_read_header (fp, &hof_header);
+              if (!queue.slot_ready.wait (&queue.mutex, 100))
+                {
+                  NV_INT32 records_read = queue.file[i].records_read;
+                  NV_INT32 number_shots = queue.file[i].number_shots;
+                  queue.mutex.unlock ();
 
-              progress.fbar->reset ();
+                  if (number_shots)
+                    {
+                      progress.fbar->setValue (records_read);
 
-              progress.fbox->setTitle (QFileInfo (input_file_def[i].name).fileName ());
+                      progress.obar->setValue (i * 100 + (NV_INT32) (((NV_FLOAT32) records_read /
+                                                                        (NV_FLOAT32) number_shots) * 100.0));
+                    }
 
-              progress.fbar->setRange (0, hof_header.text.number_shots);
+                  qApp->processEvents ();
 
+                  queue.mutex.lock ();
+                }
+            }
 
-              NV_INT32 prog_count = 0;
+          queue.mutex.unlock ();
 
 
-              //  Loop through the entire file
+          //  TOF file section
 
-              while (hof_read_record (fp, HOF_NEXT_RECORD, &hof))
+          if (input_file_def[i].type)
+            {
+              for (NV_INT32 j = 0 ; j < slot->count ; j++)
                 {
-                  NV_FLOAT64 lat = hof.latitude, lon = hof.longitude;
-
+                  AREA_RECORD *rec = &slot->rec[j];
+                  AREA_DEFINITION *area = &input_area_def[rec->area];
 
-                  //  Check against last area hit first then if it's not in that box check the rest.
 
-                  NV_INT32 hit = -1;
+                  //  Each input file gets its own LAS file in each area.  If it already exists we get rid of it.  The
+                  //  LAS file is opened with a placeholder header the first time the file hits the area and the final
+                  //  header is written after the file's last chunk.
 
-                  if (prev_hit != -1)
+                  if (!area->opened)
                     {
-                      if (input_area_def[prev_hit].rect_flag)
-                        {
-                          if (lon >= input_area_def[prev_hit].mbr.min_x && lon <= input_area_def[prev_hit].mbr.max_x &&
-                              lat >= input_area_def[prev_hit].mbr.min_y && lat <= input_area_def[prev_hit].mbr.max_y) hit = prev_hit;
-                        }
-                      else
-                        {
-                          if (inside_polygon2 (input_area_def[prev_hit].polygon_x, input_area_def[prev_hit].polygon_y, 
-                                               input_area_def[prev_hit].poly_count, lon, lat)) hit = prev_hit;
-                        }
-                    }
+                      QString new_file = area->dir_name + "/" + filePrefix + "__Area_" + area->name + "__" + 
+                        QFileInfo (input_file_def[i].name).baseName () + ".las";
 
+                      NV_CHAR nf[1024];
+                      strcpy (nf, new_file.toAscii ());
 
-                  //  If the point wasn't in the previous area, beat the input point against all of the area boundaries to find out which one it is in (if any).
+                      remove (nf);
 
-                  if (hit == -1)
-                    {
-                      for (NV_INT32 j = 0 ; j < input_area_count ; j++)
+                      area->tmp_num_recs[0] = 0;
+                      area->tmp_num_recs[1] = 0;
+
+                      area->min.x = 99999999999.0;
+                      area->max.x = -99999999999.0;
+                      area->min.y = 99999999999.0;
+                      area->max.y = -99999999999.0;
+                      area->min.z = 99999999999.0;
+                      area->max.z = -99999999999.0;
+
+                      if (!writeLASHeader (nf, queue.file[i].tof_header, area))
                         {
-                          if (input_area_def[j].rect_flag)
-                            {
-                              if (lon >= input_area_def[j].mbr.min_x && lon <= input_area_def[j].mbr.max_x &&
-                                  lat >= input_area_def[j].mbr.min_y && lat <= input_area_def[j].mbr.max_y)
-                                {
-                                  hit = j;
-                                  break;
-                                }
-                            }
-                          else
-                            {
-                              if (inside_polygon2 (input_area_def[j].polygon_x, input_area_def[j].polygon_y, 
-                                                   input_area_def[j].poly_count, lon, lat))
-                                {
-                                  hit = j;
-                                  break;
-                                }
-                            }
+                          LASError_Print ("Could not open LAS file");
+                          exit (-1);
                         }
                     }
-                  prev_hit = hit;
 
+                  if (rec->las_valid) writeLASRecord (&rec->las, area);
 
-                  //  If the point is in one of the areas we need to create or open the ASCII output file
 
-                  if (hit >= 0)
-                    {
-                      QString asc_file;
-                      asc_file = input_area_def[hit].dir_name + QString ((NV_CHAR) SEPARATOR) + filePrefix + "__Area_" +
-                        input_area_def[hit].name + ".has"; 
+                  //  The ASCII files for the area are opened the first time we need them and stay open for the whole run.
 
-                      NV_CHAR af[1024];
-                      strcpy (af, asc_file.toAscii ());
+                  if (area->ascfp[rec->k] == NULL)
+                    {
+                      QString ext;
+                      ext.sprintf (".ta%1d", rec->k + 1);
 
+                      area->ascfp[rec->k] =
+                        openASCFile (area->dir_name + "/" + filePrefix + "__Area_" + area->name + ext,
+                                     "# LONGITUDE, LATITUDE, UTM ZONE, EASTING, NORTHING, ELEV, ELEV (ellipsoid),  YYYY/MM/DD,HH:MM:SS.SSSSSS INTENSITY\n");
+                    }
 
-                      QFileInfo asc_file_info (asc_file);
+                  if (rec->text_length) fwrite (&slot->text.data[rec->text_offset], rec->text_length, 1, area->ascfp[rec->k]);
+                }
 
 
-                      //  If the file doesn't exist, create it
+              //  Write the final headers of the file's LAS files.
 
-                      if (!asc_file_info.exists ())
+              if (slot->last)
+                {
+                  for (NV_INT32 j = 0 ; j < input_area_count ; j++)
+                    {
+                      if (input_area_def[j].opened)
                         {
-                          if ((input_area_def[hit].ascfp[0] = fopen64 (af, "w")) == NULL)
-                            {
-                              perror (af);
-                              exit (-1);
-                            }
-
-                          fprintf (input_area_def[hit].ascfp[0], 
-                                   "# LONGITUDE, LATITUDE, UTM ZONE, EASTING, NORTHING, ELEV, ELEV (ellipsoid), YYYY/MM/DD,HH:MM:SS.SSSSSS\n");
+                          writeLASHeader (NULL, queue.file[i].tof_header, &input_area_def[j]);
 
+                          input_area_def[j].opened = NVFalse;
+                        }
+                    }
+                }
+            }
 
-                          //  Dummy the opened value to signify we opened this file
 
-                          input_area_def[hit].opened = NVTrue;
-                        }
+          //  HOF file section
 
+          else
+            {
+              for (NV_INT32 j = 0 ; j < slot->count ; j++)
+                {
+                  AREA_RECORD *rec = &slot->rec[j];
+                  AREA_DEFINITION *area = &input_area_def[rec->area];
 
-                      //  If it does exist, open it
+                  if (area->hasfp == NULL)
+                    {
+                      area->hasfp =
+                        openASCFile (area->dir_name + QString ((NV_CHAR) SEPARATOR) + filePrefix + "__Area_" + area->name + ".has",
+                                     "# LONGITUDE, LATITUDE, UTM ZONE, EASTING, NORTHING, ELEV, ELEV (ellipsoid), YYYY/MM/DD,HH:MM:SS.SSSSSS\n");
+                    }
 
-                      else
-                        {
-                          if (!input_area_def[hit].opened)
-                            {
-                              if ((input_area_def[hit].ascfp[0] = fopen64 (af, "a")) == NULL)
-                                {
-                                  perror (af);
-                                  exit (-1);
-                                }
+                  if (rec->text_length) fwrite (&slot->text.data[rec->text_offset], rec->text_length, 1, area->hasfp);
+                }
+            }
 
 
-                              //  Dummy the opened value to signify we opened this file
+          last = slot->last;
+          chunk++;
 
-                              input_area_def[hit].opened = NVTrue;
-                            }
-                        }
 
+          //  Free the slot for the next chunk.
 
-                      //  Write the HOF record to the ASCII file
+          queue.mutex.lock ();
+          slot->state = SLOT_FREE;
+          queue.free_slots++;
+          if (last) queue.write_file++;
+          queue.slot_free.wakeAll ();
+          queue.mutex.unlock ();
+        }
 
-                      writeHOFASCRecord (hof, &input_area_def[hit]);
-                    }
 
+      if (!queue.file[i].opened)
+        {
+          QMessageBox::warning (this, tr ("chartsLAS Open input files"), tr ("The file ") + input_file_def[i].name + 
+                                tr (" could not be opened.") + tr ("  The error message returned was:\n\n") +
+                                QString (strerror (queue.file[i].error)));
+        }
 
-                  progress.fbar->setValue (prog_count);
+      progress.fbar->setValue (progress.fbar->maximum ());
+      progress.obar->setValue ((i + 1) * 100);
+      qApp->processEvents ();
+    }
 
-                  progress.obar->setValue (i * 100 + (NV_INT32) (((NV_FLOAT32) prog_count / 
-                                                                  (NV_FLOAT32) hof_header.text.number_shots) * 100.0));
-                  qApp->processEvents ();
 
-                  prog_count++;
-                }
+  for (NV_INT32 i = 0 ; i < num_threads ; i++) input_thread[i].wait ();
 
-              fclose (fp);
 
-              progress.fbar->setValue (hof_header.text.number_shots);
+  //  Close the output files.
 
+  for (NV_INT32 i = 0 ; i < input_area_count ; i++)
+    {
+      if (input_area_def[i].ascfp[0] != NULL) fclose (input_area_def[i].ascfp[0]);
+      if (input_area_def[i].ascfp[1] != NULL) fclose (input_area_def[i].ascfp[1]);
+      if (input_area_def[i].hasfp != NULL) fclose (input_area_def[i].hasfp);
+      input_area_def[i].ascfp[0] = input_area_def[i].ascfp[1] = input_area_def[i].hasfp = NULL;
 
-              //  Close the output files.
+      if (input_area_def[i].prepared) free_prepared_polygon (input_area_def[i].prepared);
+      input_area_def[i].prepared = NULL;
+    }
 
-              for (NV_INT32 i = 0 ; i < input_area_count ; i++)
-                {
-                  if (input_area_def[i].opened) fclose (input_area_def[i].ascfp[0]);
 
-                  input_area_def[i].opened = NVFalse;
-                }
-            }
-        }
+  for (NV_INT32 i = 0 ; i < queue.num_slots ; i++)
+    {
+      if (queue.slot[i].text.data) free (queue.slot[i].text.data);
+      if (queue.slot[i].rec) free (queue.slot[i].rec);
     }
 
+  free (queue.slot);
+  free (queue.file);
+
+  if (area_index.cell_start) free (area_index.cell_start);
+  if (area_index.cell_area) free (area_index.cell_area);
+
+
   progress.obar->setValue (input_file_count * 100);
 
 
@@ -1087,11 +1078,10 @@ chartsLAS::writeLASHeader (NV_CHAR *file, TOF_HEADER_T tof_header, AREA_DEFINITI
 
 
 void 
-chartsLAS::writeLASRecord (TOPO_OUTPUT_T tof, AREA_DEFINITION *area_def, NV_INT32 k)
+chartsLAS::writeLASRecord (LAS_POINT *point, AREA_DEFINITION *area_def)
 {
-  NV_INT32                        scan_direction, edge_of_flightline, intens;
+  NV_INT32                        edge_of_flightline;
   LASPointH                       las = NULL;
-  NV_FLOAT64                      lat, lon, z;
 
 
   //  We're blowing off the edge_of_flightline 'cause we really don't care ;-)
@@ -1099,119 +1089,29 @@ chartsLAS::writeLASRecord (TOPO_OUTPUT_T tof, AREA_DEFINITION *area_def, NV_INT3
   edge_of_flightline = 0;
 
 
-  scan_direction = 1;
-  if (tof.scanner_azimuth < 0.0) scan_direction = 0;
-
-
-  if (k)
-    {
-      //  A confidence value of 50 or below is bad.
-
-      if (tof.elevation_last == -998.0 || tof.conf_last <= 50) return;
-
-      area_def->tmp_num_recs[1]++;
-
-      lat = tof.latitude_last;
-      lon = tof.longitude_last;
-      z = tof.elevation_last;
-      intens = tof.intensity_last;
-    }
-  else
-    {
-      if (fabsf (tof.elevation_last - tof.elevation_first) <= 0.05) return;
-
-
-      //  A confidence value of 50 or below is bad.
-
-      if (tof.elevation_first == -998.0 || tof.conf_first <= 50) return;
-
-
-      //  We don't load first returns if the last return was bad in files prior to 10/07/2011.
-
-      if (ver_dep_flag && tof.elevation_last <= -998.0) return;
-
-
-      area_def->tmp_num_recs[0]++;
-
-      lat = tof.latitude_first;
-      lon = tof.longitude_first;
-      z = tof.elevation_first;
-      intens = tof.intensity_first;
-    }
+  area_def->tmp_num_recs[point->return_number - 1]++;
 
 
   las = LASPoint_Create ();
 
 
-  //  We're really setting the LASF 1.1 classification bits here but since classification
-  //  wasn't really defined in 1.0 it shouldn't matter.
-
-
-  //   Classification status byte (bits defined in GCSCnsts.h)
-
-  //     bit 0 = classified        (1=classified; 0=not classified)
-  //     bit 1 = non-bare_earth1   (0x02);
-  //     bit 2 = non-bare_earth2   (0x04);
-  //     bit 3 = water             (0x08);   
-  //     rest TBD.
-
-  //     If only the first bit is set it is BARE EARTH.
-  //     If value is 0, it has not been classified.
-  //     Yes, this is a weird definition...
-  //     In future the two non bare earth bits will be split into
-  //     buildings/vegetation.
-
-  if (tof.classification_status & 0x01)
-    {
-      if (!(tof.classification_status & 0x0e))
-        {
-          LASPoint_SetClassification (las, 2);
-        }
-      else if (tof.classification_status & 0x02)
-        {
-          LASPoint_SetClassification (las, 6);
-        }
-      else if (tof.classification_status & 0x04)
-        {
-          LASPoint_SetClassification (las, 4);
-        }
-      else if (tof.classification_status & 0x08)
-        {
-          LASPoint_SetClassification (las, 9);
-        }
-    }
-
-
-  LASPoint_SetScanAngleRank (las, NINT (tof.scanner_azimuth));
+  //  The classification was set from the TOF classification status by the input thread (0 means not classified).
 
-  LASPoint_SetTime (las, (NV_FLOAT64) tof.timestamp / 1000000.0 - area_def->start_week);
+  if (point->classification) LASPoint_SetClassification (las, point->classification);
 
 
-  //  If we are correcting to orthometric height... 
+  LASPoint_SetScanAngleRank (las, point->scan_angle_rank);
 
-  if (geoid03)
-    {
-      NV_FLOAT32 value = get_geoid03 (lat, lon);
-
-      if (value != -999.0)
-        {
-          z -= value;
-        }
-    }
-
-
-  NV_U_BYTE num_ret = 1;
-  if (tof.elevation_last != -998.0 && tof.conf_last > 50 && tof.elevation_first != -998.0 && tof.conf_first > 50 &&
-      fabsf (tof.elevation_last - tof.elevation_first) > 0.05) num_ret = 2;
+  LASPoint_SetTime (las, (NV_FLOAT64) point->timestamp / 1000000.0 - area_def->start_week);
 
 
-  LASPoint_SetX (las, lon);
-  LASPoint_SetY (las, lat);
-  LASPoint_SetZ (las, z);
-  LASPoint_SetIntensity (las, intens);
-  LASPoint_SetReturnNumber (las, k + 1);
-  LASPoint_SetNumberOfReturns (las, num_ret);
-  LASPoint_SetScanDirection (las, scan_direction);
+  LASPoint_SetX (las, point->lon);
+  LASPoint_SetY (las, point->lat);
+  LASPoint_SetZ (las, point->z);
+  LASPoint_SetIntensity (las, point->intensity);
+  LASPoint_SetReturnNumber (las, point->return_number);
+  LASPoint_SetNumberOfReturns (las, point->number_of_returns);
+  LASPoint_SetScanDirection (las, point->scan_direction);
   LASPoint_SetFlightLineEdge (las, edge_of_flightline);
 
 
@@ -1225,130 +1125,45 @@ chartsLAS::writeLASRecord (TOPO_OUTPUT_T tof, AREA_DEFINITION *area_def, NV_INT3
   LASPoint_Destroy (las);
   las = NULL;
 
-  area_def->min.x = MIN (area_def->min.x, lon);
-  area_def->min.y = MIN (area_def->min.y, lat);
-  area_def->min.z = MIN (area_def->min.z, z);
-  area_def->max.x = MAX (area_def->max.x, lon);
-  area_def->max.y = MAX (area_def->max.y, lat);
-  area_def->max.z = MAX (area_def->max.z, z);
+  area_def->min.x = MIN (area_def->min.x, point->lon);
+  area_def->min.y = MIN (area_def->min.y, point->lat);
+  area_def->min.z = MIN (area_def->min.z, point->z);
+  area_def->max.x = MAX (area_def->max.x, point->lon);
+  area_def->max.y = MAX (area_def->max.y, point->lat);
+  area_def->max.z = MAX (area_def->max.z, point->z);
 }
 
 
 
-void 
-chartsLAS::writeTOFASCRecord (TOPO_OUTPUT_T tof, NV_INT32 k, AREA_DEFINITION *area_def)
-{
-  NV_INT32        year, day, hour, minute, month, mday, intens;
-  NV_FLOAT32      second, elev, res_elev;
-  NV_FLOAT64      lat, lon;
+//  Open an area ASCII output file.  If it doesn't exist we create it and write the header, otherwise we append to it.
 
+FILE *
+chartsLAS::openASCFile (QString asc_file, const NV_CHAR *header)
+{
+  FILE *fp;
+  NV_CHAR af[1024];
 
-  charts_cvtime (tof.timestamp, &year, &day, &hour, &minute, &second);
-  charts_jday2mday (year, day, &month, &mday);
-  month++;
 
+  strcpy (af, asc_file.toAscii ());
 
-  if (k)
+  if (!QFileInfo (asc_file).exists ())
     {
-      //  A confidence value of 50 or below is bad.
-
-      if (tof.elevation_last == -998.0 || tof.conf_last <= 50) return;
+      if ((fp = fopen64 (af, "w")) == NULL)
+        {
+          perror (af);
+          exit (-1);
+        }
 
-      lat = tof.latitude_last;
-      lon = tof.longitude_last;
-      elev = tof.elevation_last;
-      res_elev = tof.result_elevation_last;
-      intens = tof.intensity_last;
+      fprintf (fp, "%s", header);
     }
   else
     {
-      //  A confidence value of 50 or below is bad.
-
-      if (tof.elevation_first == -998.0 || tof.conf_first <= 50) return;
-
-
-      //  We don't load first returns if the last return was bad in files prior to 10/07/2011.
-
-      if (ver_dep_flag && tof.elevation_last <= -998.0) return;
-
-
-      lat = tof.latitude_first;
-      lon = tof.longitude_first;
-      elev = tof.elevation_first; 
-      res_elev = tof.result_elevation_first;
-      intens = tof.intensity_first;
-    }
-
-
-  NV_FLOAT64 x, y;
-
-
-  //  If we are correcting to orthometric height... 
-
-  if (geoid03)
-    {
-      NV_FLOAT32 value = get_geoid03 (lat, lon);
-
-      if (value != -999.0) elev -= value;
-    }
-
-
-  x = lon * NV_DEG_TO_RAD;
-  y = lat * NV_DEG_TO_RAD;
-  pj_transform (area_def->pj_latlon, area_def->pj_utm, 1, 1, &x, &y, NULL);
-
-  fprintf (area_def->ascfp[k], "%0.9lf,%0.9lf,%d,%0.3f,%0.3f,%0.2f,%0.2f,%d/%02d/%02d,%02d:%02d:%09.6f,%d\n",
-           lon, lat, area_def->zone, x, y, elev, res_elev, year + 1900, month, mday, hour, minute, second, intens);
-}
-
-
-
-void 
-chartsLAS::writeHOFASCRecord (HYDRO_OUTPUT_T hof, AREA_DEFINITION *area_def)
-{
-  NV_INT32        year, day, hour, minute, month, mday;
-  NV_FLOAT32      second;
-
-
-  if (!(hof.status & AU_STATUS_DELETED_BIT) && hof.abdc >= 70 && hof.correct_depth != -998.0)
-    {
-      charts_cvtime (hof.timestamp, &year, &day, &hour, &minute, &second);
-      charts_jday2mday (year, day, &month, &mday);
-      month++;
-
-
-      NV_FLOAT64 x, y;
-      NV_FLOAT32 z, ze;
-
-
-      //  If we are correcting to orthometric height... 
-
-      if (geoid03 && hof.data_type)
-        {
-          NV_FLOAT32 value = get_geoid03 (hof.latitude, hof.longitude);
-
-          if (value != -999.0)
-            {
-              z = hof.correct_depth - value;
-            }
-          else
-            {
-              z = hof.correct_depth;
-            }
-          ze = hof.kgps_elevation;
-        }
-      else
+      if ((fp = fopen64 (af, "a")) == NULL)
         {
-          z = hof.correct_depth;
-          ze = hof.result_depth;
+          perror (af);
+          exit (-1);
         }
-
-
-      x = hof.longitude * NV_DEG_TO_RAD;
-      y = hof.latitude * NV_DEG_TO_RAD;
-      pj_transform (area_def->pj_latlon, area_def->pj_utm, 1, 1, &x, &y, NULL);
-
-      fprintf (area_def->ascfp[0], "%0.9lf,%0.9lf,%d,%0.3f,%0.3f,%0.2f,%0.2f,%d/%02d/%02d,%02d:%02d:%09.6f\n",  
-               hof.longitude, hof.latitude, area_def->zone, x, y, z, ze, year + 1900, month, mday, hour, minute, second);
     }
+
+  return (fp);
 }
@@ -6,6 +6,7 @@
 #include "areaInputPage.hpp"
 #include "fileInputPage.hpp"
 #include "runPage.hpp"
+#include "inputThread.hpp"
 #include "version.hpp"
 
 
@@ -29,9 +30,8 @@ protected:
   void cleanupPage (int id);
 
   NV_BOOL writeLASHeader (NV_CHAR *file, TOF_HEADER_T tof_header, AREA_DEFINITION *area_def);
-  void writeLASRecord (TOPO_OUTPUT_T tof, AREA_DEFINITION *area_def, NV_INT32 k);
-  void writeTOFASCRecord (TOPO_OUTPUT_T tof, NV_INT32 k, AREA_DEFINITION *area_def);
-  void writeHOFASCRecord (HYDRO_OUTPUT_T hof, AREA_DEFINITION *area_def);
+  void writeLASRecord (LAS_POINT *point, AREA_DEFINITION *area_def);
+  FILE *openASCFile (QString asc_file, const NV_CHAR *header);
 
   void envin ();
   void envout ();
@@ -39,7 +39,7 @@ protected:
 
   NV_INT32         input_area_count, input_file_count, window_x, window_y, window_width, window_height, datum;
 
-  NV_BOOL          geoid03, ver_dep_flag;
+  NV_BOOL          geoid03;
 
   AREA_DEFINITION  *input_area_def;
 
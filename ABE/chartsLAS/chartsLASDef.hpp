@@ -22,6 +22,12 @@
 #define  GCS_WGS_84           4326
 #define  GCS_NAD83            4269
 
+#define  MAX_INPUT_THREADS    16
+#define  MAX_INPUT_SLOTS      8          //  Maximum number of chunks waiting to be written (regardless of thread count)
+#define  INPUT_CHUNK_SHOTS    10000      //  Number of input records in a chunk
+#define  AREA_INDEX_SIZE      64         //  Number of rows and columns in the area index grid
+
+
 typedef struct
 {
   QString             name;
@@ -57,6 +63,7 @@ typedef struct
   NV_FLOAT64          polygon_x[50];
   NV_FLOAT64          polygon_y[50];
   NV_INT32            poly_count;
+  PREPARED_POLYGON    *prepared;
   NV_BOOL             rect_flag;
   NV_F64_XYMBR        mbr;
   NV_INT32            tmp_num_recs[2];
@@ -69,10 +76,124 @@ typedef struct
   projPJ              pj_utm;
   projPJ              pj_latlon;
   NV_INT32            zone;
-  FILE                *ascfp[2];
+  FILE                *ascfp[2];              //  TOF .ta1 and .ta2 files (opened once per run)
+  FILE                *hasfp;                 //  HOF .has file (opened once per run)
 } AREA_DEFINITION;
 
 
+//  Grid index over the area polygons.  Each cell lists (in area order) the areas whose MBR touches the cell so that
+//  we only have to check a point against the few areas that might contain it.
+
+typedef struct
+{
+  NV_F64_XYMBR        mbr;
+  NV_INT32            width;
+  NV_INT32            height;
+  NV_FLOAT64          x_size;
+  NV_FLOAT64          y_size;
+  NV_INT32            *cell_start;            //  [width * height + 1]
+  NV_INT32            *cell_area;
+} AREA_INDEX;
+
+
+typedef struct
+{
+  NV_CHAR             *data;
+  size_t              size;
+  size_t              allocated;
+} OUTPUT_BUFFER;
+
+
+//  A TOF return that passed the LAS checks.  The LAS points are built from these in the GUI thread since that is where
+//  the LAS files (and the GPS start of week) are handled.
+
+typedef struct
+{
+  NV_FLOAT64          lon;
+  NV_FLOAT64          lat;
+  NV_FLOAT64          z;
+  NV_INT64            timestamp;
+  NV_INT32            intensity;
+  NV_INT32            scan_angle_rank;
+  NV_U_BYTE           classification;
+  NV_U_BYTE           return_number;
+  NV_U_BYTE           number_of_returns;
+  NV_U_BYTE           scan_direction;
+} LAS_POINT;
+
+
+//  A return that fell in one of the areas.  The LAS point is only written if the return passed the LAS checks and the
+//  ASCII line (in the chunk's text buffer) is only written if it passed the ASCII checks.
+
+typedef struct
+{
+  NV_INT32            area;
+  NV_INT32            k;                      //  0 for first return (or HOF), 1 for last return
+  NV_BOOL             las_valid;
+  LAS_POINT           las;
+  size_t              text_offset;
+  NV_INT32            text_length;            //  0 if there is no ASCII line
+} AREA_RECORD;
+
+
+//  Input file information.  The headers are read in the GUI thread before the input threads are started since the
+//  CHARTS library sets its (static) byte swap flag when it reads a header.
+
+typedef struct
+{
+  NV_BOOL             opened;                 //  Set if the input file could be opened
+  NV_INT32            error;                  //  errno if the file couldn't be opened
+  TOF_HEADER_T        tof_header;
+  NV_INT32            number_shots;
+  NV_INT32            records_read;
+} FILE_STATE;
+
+
+#define  SLOT_FREE            0
+#define  SLOT_FILLING         1
+#define  SLOT_READY           2
+
+
+//  Output from INPUT_CHUNK_SHOTS records of one input file.  Every input file ends with a chunk that has last set (an
+//  empty one if the file couldn't be opened).
+
+typedef struct
+{
+  NV_INT32            state;
+  NV_INT32            file;
+  NV_INT32            chunk;
+  NV_BOOL             last;
+  OUTPUT_BUFFER       text;
+  AREA_RECORD         *rec;
+  NV_INT32            count;
+  NV_INT32            allocated;
+} CHUNK_SLOT;
+
+
+//  Shared state for the input threads and the output writer (the GUI thread).  The threads take the input files in
+//  order and hand the areas' output back a chunk at a time.  The writer writes the chunks in file and chunk order so the
+//  output files are the same as if the input files were processed one at a time.  The last free slot is only given to
+//  the thread reading the file that is being written.  Otherwise the threads that are ahead of the writer could fill
+//  every slot while the writer is waiting for that file.
+
+typedef struct
+{
+  QMutex              mutex;
+  QWaitCondition      slot_free;              //  Signaled by the writer when it has written a chunk
+  QWaitCondition      slot_ready;             //  Signaled by an input thread when it has finished a chunk
+  QMutex              lib_mutex;              //  PROJ.4 initialization and get_geoid03 aren't reentrant
+  NV_BOOL             read_headers;           //  The input files' byte orders differ so the (single) input thread has
+                                              //  to read each header again before reading the records
+  FILE_STATE          *file;                  //  [num_files]
+  NV_INT32            num_files;
+  NV_INT32            next_file;              //  Next file to be read
+  NV_INT32            write_file;             //  Next file to be written
+  NV_INT32            num_slots;
+  NV_INT32            free_slots;
+  CHUNK_SLOT          *slot;                  //  [num_slots]
+} FILE_QUEUE;
+
+
 typedef struct
 {
   QGroupBox           *obox;
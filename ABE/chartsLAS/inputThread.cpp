@@ -0,0 +1,712 @@
+#include "inputThread.hpp"
+
+inputThread::inputThread (QObject *parent)
+  : QThread(parent)
+{
+  pj_utm = pj_latlon = NULL;
+  l_area_count = 0;
+}
+
+
+
+inputThread::~inputThread ()
+{
+  for (NV_INT32 i = 0 ; i < l_area_count ; i++)
+    {
+      if (pj_utm && pj_utm[i]) pj_free (pj_utm[i]);
+      if (pj_latlon && pj_latlon[i]) pj_free (pj_latlon[i]);
+    }
+
+  if (pj_utm) free (pj_utm);
+  if (pj_latlon) free (pj_latlon);
+}
+
+
+
+void inputThread::prepare (FILE_QUEUE *fq, FILE_DEFINITION *fd, AREA_DEFINITION *ad, NV_INT32 ac, AREA_INDEX *ai,
+                           NV_BOOL geoid)
+{
+  QMutexLocker locker (&mutex);
+
+  l_queue = fq;
+  l_file_def = fd;
+  l_area_def = ad;
+  l_area_count = ac;
+  l_area_index = ai;
+  l_geoid03 = geoid;
+
+
+  //  Each thread gets its own copy of the area projections (built the first time the thread hits the area) since
+  //  PROJ.4 projections can't be shared between threads.
+
+  pj_utm = (projPJ *) calloc (qMax (l_area_count, 1), sizeof (projPJ));
+  pj_latlon = (projPJ *) calloc (qMax (l_area_count, 1), sizeof (projPJ));
+
+  if (pj_utm == NULL || pj_latlon == NULL)
+    {
+      perror ("Allocating thread projections");
+      exit (-1);
+    }
+
+  if (!isRunning ()) start ();
+}
+
+
+
+//  Convert CHARTS microseconds from the epoch to year, month, day, hour, minute, and second.  This is the same as
+//  charts_cvtime followed by charts_jday2mday but neither of those is reentrant (localtime and a static month table).
+
+static void cvtime (NV_INT64 micro_sec, NV_INT32 *year, NV_INT32 *month, NV_INT32 *mday, NV_INT32 *hour,
+                    NV_INT32 *minute, NV_FLOAT32 *second)
+{
+  NV_INT64 tv_sec = micro_sec / 1000000;
+  NV_INT32 msec = micro_sec % 1000000;
+
+  NV_INT64 days = tv_sec / 86400;
+  NV_INT32 secs = tv_sec % 86400;
+
+  if (secs < 0)
+    {
+      secs += 86400;
+      days--;
+    }
+
+  *hour = secs / 3600;
+  *minute = (secs % 3600) / 60;
+  *second = (NV_FLOAT32) (secs % 60) + (NV_FLOAT32) ((NV_FLOAT64) msec / 1000000.);
+
+
+  //  Days from 1970-01-01 to civil date (proleptic Gregorian calendar, years starting on March 1st).
+
+  days += 719468;
+  NV_INT64 era = (days >= 0 ? days : days - 146096) / 146097;
+  NV_INT32 doe = (NV_INT32) (days - era * 146097);
+  NV_INT32 yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  NV_INT32 doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  NV_INT32 mp = (5 * doy + 2) / 153;
+
+  *mday = doy - (153 * mp + 2) / 5 + 1;
+  *month = mp < 10 ? mp + 3 : mp - 9;
+  *year = (NV_INT32) (yoe + era * 400) + (*month <= 2);
+}
+
+
+
+static void append (OUTPUT_BUFFER *buf, const NV_CHAR *text, NV_INT32 length)
+{
+  if (buf->size + length > buf->allocated)
+    {
+      buf->allocated = qMax (buf->allocated * 2, buf->size + length + 65536);
+
+      buf->data = (NV_CHAR *) realloc (buf->data, buf->allocated);
+
+      if (buf->data == NULL)
+        {
+          perror ("Allocating output buffer");
+          exit (-1);
+        }
+    }
+
+  memcpy (&buf->data[buf->size], text, length);
+  buf->size += length;
+}
+
+
+
+static NV_BOOL inside_area (AREA_DEFINITION *area, NV_FLOAT64 lat, NV_FLOAT64 lon)
+{
+  if (!area->poly_count) return (NVFalse);
+
+  if (lon < area->mbr.min_x || lon > area->mbr.max_x || lat < area->mbr.min_y || lat > area->mbr.max_y) return (NVFalse);
+
+  if (area->rect_flag) return (NVTrue);
+
+  return (inside_prepared_polygon (area->prepared, lon, lat));
+}
+
+
+
+//  Find the area that the point is in (-1 if none).
+
+NV_INT32 inputThread::find_area (NV_FLOAT64 lat, NV_FLOAT64 lon)
+{
+  AREA_INDEX *ai = l_area_index;
+
+
+  //  Check against last area hit first then if it's not in that area check the areas that touch the index cell.
+
+  if (prev_hit != -1 && inside_area (&l_area_def[prev_hit], lat, lon)) return (prev_hit);
+
+  prev_hit = -1;
+
+  if (!ai->width || lon < ai->mbr.min_x || lon > ai->mbr.max_x || lat < ai->mbr.min_y || lat > ai->mbr.max_y) return (-1);
+
+  NV_INT32 col = qMin ((NV_INT32) ((lon - ai->mbr.min_x) / ai->x_size), ai->width - 1);
+  NV_INT32 row = qMin ((NV_INT32) ((lat - ai->mbr.min_y) / ai->y_size), ai->height - 1);
+  NV_INT32 cell = row * ai->width + col;
+
+  for (NV_INT32 i = ai->cell_start[cell] ; i < ai->cell_start[cell + 1] ; i++)
+    {
+      if (inside_area (&l_area_def[ai->cell_area[i]], lat, lon))
+        {
+          prev_hit = ai->cell_area[i];
+          break;
+        }
+    }
+
+  return (prev_hit);
+}
+
+
+
+void inputThread::utm (NV_INT32 area, NV_FLOAT64 lat, NV_FLOAT64 lon, NV_FLOAT64 *x, NV_FLOAT64 *y)
+{
+  if (pj_utm[area] == NULL)
+    {
+      l_queue->lib_mutex.lock ();
+
+      NV_CHAR *utm_def = pj_get_def (l_area_def[area].pj_utm, 0);
+      NV_CHAR *latlon_def = pj_get_def (l_area_def[area].pj_latlon, 0);
+
+      pj_utm[area] = pj_init_plus (utm_def);
+      pj_latlon[area] = pj_init_plus (latlon_def);
+
+      pj_dalloc (utm_def);
+      pj_dalloc (latlon_def);
+
+      l_queue->lib_mutex.unlock ();
+
+      if (!pj_utm[area] || !pj_latlon[area])
+        {
+          fprintf (stderr, "Error initializing thread projections\n");
+          exit (-1);
+        }
+    }
+
+  *x = lon * NV_DEG_TO_RAD;
+  *y = lat * NV_DEG_TO_RAD;
+  pj_transform (pj_latlon[area], pj_utm[area], 1, 1, x, y, NULL);
+}
+
+
+
+NV_FLOAT32 inputThread::geoid (NV_FLOAT64 lat, NV_FLOAT64 lon)
+{
+  l_queue->lib_mutex.lock ();
+  NV_FLOAT32 value = get_geoid03 (lat, lon);
+  l_queue->lib_mutex.unlock ();
+
+  return (value);
+}
+
+
+
+void inputThread::addLASPoint (TOPO_OUTPUT_T *tof, NV_INT32 k, AREA_RECORD *rec)
+{
+  LAS_POINT point;
+
+
+  memset (&point, 0, sizeof (LAS_POINT));
+
+
+  if (k)
+    {
+      //  A confidence value of 50 or below is bad.
+
+      if (tof->elevation_last == -998.0 || tof->conf_last <= 50) return;
+
+      point.lat = tof->latitude_last;
+      point.lon = tof->longitude_last;
+      point.z = tof->elevation_last;
+      point.intensity = tof->intensity_last;
+    }
+  else
+    {
+      if (fabsf (tof->elevation_last - tof->elevation_first) <= 0.05) return;
+
+
+      //  A confidence value of 50 or below is bad.
+
+      if (tof->elevation_first == -998.0 || tof->conf_first <= 50) return;
+
+
+      //  We don't load first returns if the last return was bad in files prior to 10/07/2011.
+
+      if (ver_dep_flag && tof->elevation_last <= -998.0) return;
+
+
+      point.lat = tof->latitude_first;
+      point.lon = tof->longitude_first;
+      point.z = tof->elevation_first;
+      point.intensity = tof->intensity_first;
+    }
+
+
+  //  We're really setting the LASF 1.1 classification bits here but since classification
+  //  wasn't really defined in 1.0 it shouldn't matter.
+
+
+  //   Classification status byte (bits defined in GCSCnsts.h)
+
+  //     bit 0 = classified        (1=classified; 0=not classified)
+  //     bit 1 = non-bare_earth1   (0x02);
+  //     bit 2 = non-bare_earth2   (0x04);
+  //     bit 3 = water             (0x08);
+  //     rest TBD.
+
+  //     If only the first bit is set it is BARE EARTH.
+  //     If value is 0, it has not been classified.
+  //     Yes, this is a weird definition...
+  //     In future the two non bare earth bits will be split into
+  //     buildings/vegetation.
+
+  if (tof->classification_status & 0x01)
+    {
+      if (!(tof->classification_status & 0x0e))
+        {
+          point.classification = 2;
+        }
+      else if (tof->classification_status & 0x02)
+        {
+          point.classification = 6;
+        }
+      else if (tof->classification_status & 0x04)
+        {
+          point.classification = 4;
+        }
+      else if (tof->classification_status & 0x08)
+        {
+          point.classification = 9;
+        }
+    }
+
+
+  point.scan_angle_rank = NINT (tof->scanner_azimuth);
+  point.timestamp = tof->timestamp;
+
+
+  //  If we are correcting to orthometric height...
+
+  if (l_geoid03)
+    {
+      NV_FLOAT32 value = geoid (point.lat, point.lon);
+
+      if (value != -999.0) point.z -= value;
+    }
+
+
+  point.number_of_returns = 1;
+  if (tof->elevation_last != -998.0 && tof->conf_last > 50 && tof->elevation_first != -998.0 && tof->conf_first > 50 &&
+      fabsf (tof->elevation_last - tof->elevation_first) > 0.05) point.number_of_returns = 2;
+
+  point.return_number = k + 1;
+
+  point.scan_direction = 1;
+  if (tof->scanner_azimuth < 0.0) point.scan_direction = 0;
+
+
+  rec->las = point;
+  rec->las_valid = NVTrue;
+}
+
+
+
+void inputThread::addTOFASCRecord (TOPO_OUTPUT_T *tof, NV_INT32 k, CHUNK_SLOT *slot, AREA_RECORD *rec)
+{
+  NV_INT32        year, hour, minute, month, mday, intens;
+  NV_FLOAT32      second, elev, res_elev;
+  NV_FLOAT64      lat, lon;
+  NV_CHAR         line[512];
+
+
+  if (k)
+    {
+      //  A confidence value of 50 or below is bad.
+
+      if (tof->elevation_last == -998.0 || tof->conf_last <= 50) return;
+
+      lat = tof->latitude_last;
+      lon = tof->longitude_last;
+      elev = tof->elevation_last;
+      res_elev = tof->result_elevation_last;
+      intens = tof->intensity_last;
+    }
+  else
+    {
+      //  A confidence value of 50 or below is bad.
+
+      if (tof->elevation_first == -998.0 || tof->conf_first <= 50) return;
+
+
+      //  We don't load first returns if the last return was bad in files prior to 10/07/2011.
+
+      if (ver_dep_flag && tof->elevation_last <= -998.0) return;
+
+
+      lat = tof->latitude_first;
+      lon = tof->longitude_first;
+      elev = tof->elevation_first;
+      res_elev = tof->result_elevation_first;
+      intens = tof->intensity_first;
+    }
+
+
+  cvtime (tof->timestamp, &year, &month, &mday, &hour, &minute, &second);
+
+
+  //  If we are correcting to orthometric height...
+
+  if (l_geoid03)
+    {
+      NV_FLOAT32 value = geoid (lat, lon);
+
+      if (value != -999.0) elev -= value;
+    }
+
+
+  NV_FLOAT64 x, y;
+
+  utm (rec->area, lat, lon, &x, &y);
+
+  NV_INT32 length = sprintf (line, "%0.9lf,%0.9lf,%d,%0.3f,%0.3f,%0.2f,%0.2f,%d/%02d/%02d,%02d:%02d:%09.6f,%d\n",
+                             lon, lat, l_area_def[rec->area].zone, x, y, elev, res_elev, year, month, mday, hour, minute,
+                             second, intens);
+
+  rec->text_offset = slot->text.size;
+  rec->text_length = length;
+
+  append (&slot->text, line, length);
+}
+
+
+
+void inputThread::addHOFASCRecord (HYDRO_OUTPUT_T *hof, CHUNK_SLOT *slot, AREA_RECORD *rec)
+{
+  NV_INT32        year, hour, minute, month, mday;
+  NV_FLOAT32      second;
+  NV_CHAR         line[512];
+
+
+  if (!(hof->status & AU_STATUS_DELETED_BIT) && hof->abdc >= 70 && hof->correct_depth != -998.0)
+    {
+      cvtime (hof->timestamp, &year, &month, &mday, &hour, &minute, &second);
+
+
+      NV_FLOAT64 x, y;
+      NV_FLOAT32 z, ze;
+
+
+      //  If we are correcting to orthometric height...
+
+      if (l_geoid03 && hof->data_type)
+        {
+          NV_FLOAT32 value = geoid (hof->latitude, hof->longitude);
+
+          if (value != -999.0)
+            {
+              z = hof->correct_depth - value;
+            }
+          else
+            {
+              z = hof->correct_depth;
+            }
+          ze = hof->kgps_elevation;
+        }
+      else
+        {
+          z = hof->correct_depth;
+          ze = hof->result_depth;
+        }
+
+
+      utm (rec->area, hof->latitude, hof->longitude, &x, &y);
+
+      NV_INT32 length = sprintf (line, "%0.9lf,%0.9lf,%d,%0.3f,%0.3f,%0.2f,%0.2f,%d/%02d/%02d,%02d:%02d:%09.6f\n",
+                                 hof->longitude, hof->latitude, l_area_def[rec->area].zone, x, y, z, ze, year, month, mday,
+                                 hour, minute, second);
+
+      rec->text_offset = slot->text.size;
+      rec->text_length = length;
+
+      append (&slot->text, line, length);
+    }
+}
+
+
+
+//  Add a record for a return that fell in an area to the chunk.
+
+AREA_RECORD *inputThread::addRecord (CHUNK_SLOT *slot, NV_INT32 area, NV_INT32 k)
+{
+  if (slot->count == slot->allocated)
+    {
+      slot->allocated = qMax (slot->allocated * 2, 1024);
+
+      slot->rec = (AREA_RECORD *) realloc (slot->rec, slot->allocated * sizeof (AREA_RECORD));
+
+      if (slot->rec == NULL)
+        {
+          perror ("Allocating chunk records");
+          exit (-1);
+        }
+    }
+
+  AREA_RECORD *rec = &slot->rec[slot->count++];
+
+  memset (rec, 0, sizeof (AREA_RECORD));
+
+  rec->area = area;
+  rec->k = k;
+
+  return (rec);
+}
+
+
+
+//  Get a free slot for a chunk of the file.  The last free slot is saved for the file that is being written.
+
+CHUNK_SLOT *inputThread::getSlot (NV_INT32 file, NV_INT32 chunk)
+{
+  FILE_QUEUE *fq = l_queue;
+  CHUNK_SLOT *slot = NULL;
+
+
+  fq->mutex.lock ();
+
+  while (!fq->free_slots || (fq->free_slots == 1 && file != fq->write_file)) fq->slot_free.wait (&fq->mutex);
+
+  for (NV_INT32 i = 0 ; i < fq->num_slots ; i++)
+    {
+      if (fq->slot[i].state == SLOT_FREE)
+        {
+          slot = &fq->slot[i];
+          break;
+        }
+    }
+
+  slot->state = SLOT_FILLING;
+  fq->free_slots--;
+
+  fq->mutex.unlock ();
+
+
+  slot->file = file;
+  slot->chunk = chunk;
+  slot->last = NVFalse;
+  slot->text.size = 0;
+  slot->count = 0;
+
+  return (slot);
+}
+
+
+
+//  Hand the chunk to the writer.
+
+void inputThread::putSlot (CHUNK_SLOT *slot, NV_BOOL last, NV_INT32 records_read)
+{
+  slot->last = last;
+
+  l_queue->mutex.lock ();
+  l_queue->file[slot->file].records_read = records_read;
+  slot->state = SLOT_READY;
+  l_queue->slot_ready.wakeAll ();
+  l_queue->mutex.unlock ();
+}
+
+
+
+void inputThread::process_tof (FILE *fp, NV_INT32 file)
+{
+  TOPO_OUTPUT_T tof;
+  NV_INT32 count = 0, chunk = 0;
+
+
+  //  Check for files older than 10/07/2011.  At that point we changed the way we load TOF data into PFM
+  //  so that we load first returns even if the second return is bad.
+
+  ver_dep_flag = NVFalse;
+  NV_INT64 hd_start_time;
+  sscanf (l_queue->file[file].tof_header.text.start_time, NV_INT64_SPECIFIER, &hd_start_time);
+  if (hd_start_time < 1317945600000000LL) ver_dep_flag = NVTrue;
+
+
+  CHUNK_SLOT *slot = getSlot (file, chunk);
+
+
+  //  Loop through the entire file reading each record.
+
+  while (tof_read_record (fp, TOF_NEXT_RECORD, &tof))
+    {
+      for (NV_INT32 k = 0 ; k < 2 ; k++)
+        {
+          NV_FLOAT64 lat, lon;
+
+          if (k)
+            {
+              lat = tof.latitude_last;
+              lon = tof.longitude_last;
+            }
+          else
+            {
+              lat = tof.latitude_first;
+              lon = tof.longitude_first;
+            }
+
+
+          NV_INT32 hit = find_area (lat, lon);
+
+
+          //  If the point is in one of the areas, add it to the LAS points and the ASCII output for the area.
+
+          if (hit >= 0)
+            {
+              AREA_RECORD *rec = addRecord (slot, hit, k);
+
+              addLASPoint (&tof, k, rec);
+              addTOFASCRecord (&tof, k, slot, rec);
+            }
+        }
+
+
+      if (!(++count % INPUT_CHUNK_SHOTS))
+        {
+          putSlot (slot, NVFalse, count);
+          slot = getSlot (file, ++chunk);
+        }
+      else if (!(count % 1000))
+        {
+          l_queue->mutex.lock ();
+          l_queue->file[file].records_read = count;
+          l_queue->mutex.unlock ();
+        }
+    }
+
+  putSlot (slot, NVTrue, count);
+}
+
+
+
+void inputThread::process_hof (FILE *fp, NV_INT32 file)
+{
+  HYDRO_OUTPUT_T hof;
+  NV_INT32 count = 0, chunk = 0;
+
+
+  CHUNK_SLOT *slot = getSlot (file, chunk);
+
+
+  //  Loop through the entire file
+
+  while (hof_read_record (fp, HOF_NEXT_RECORD, &hof))
+    {
+      NV_INT32 hit = find_area (hof.latitude, hof.longitude);
+
+
+      //  If the point is in one of the areas add it to the ASCII output for the area.
+
+      if (hit >= 0)
+        {
+          AREA_RECORD *rec = addRecord (slot, hit, 0);
+
+          addHOFASCRecord (&hof, slot, rec);
+        }
+
+
+      if (!(++count % INPUT_CHUNK_SHOTS))
+        {
+          putSlot (slot, NVFalse, count);
+          slot = getSlot (file, ++chunk);
+        }
+      else if (!(count % 1000))
+        {
+          l_queue->mutex.lock ();
+          l_queue->file[file].records_read = count;
+          l_queue->mutex.unlock ();
+        }
+    }
+
+  putSlot (slot, NVTrue, count);
+}
+
+
+
+void inputThread::run ()
+{
+  FILE_QUEUE *fq = l_queue;
+  TOF_HEADER_T tof_header;
+  HOF_HEADER_T hof_header;
+  NV_CHAR string[1024];
+
+
+  while (1)
+    {
+      //  Get the next file.
+
+      fq->mutex.lock ();
+
+      NV_INT32 file = fq->next_file;
+
+      if (file >= fq->num_files)
+        {
+          fq->mutex.unlock ();
+          break;
+        }
+
+      fq->next_file++;
+
+      fq->mutex.unlock ();
+
+
+      prev_hit = -1;
+
+
+      //  The header was read (and the file checked) before the threads were started.  The CHARTS record reads skip
+      //  over the header.
+
+      FILE *fp = NULL;
+
+      if (fq->file[file].opened)
+        {
+          strcpy (string, l_file_def[file].name.toAscii ());
+
+          if (l_file_def[file].type)
+            {
+              if ((fp = open_tof_file (string)) != NULL && fq->read_headers) tof_read_header (fp, &tof_header);
+            }
+          else
+            {
+              if ((fp = open_hof_file (string)) != NULL && fq->read_headers) hof_read_header (fp, &hof_header);
+            }
+
+          if (fp == NULL)
+            {
+              fq->mutex.lock ();
+              fq->file[file].opened = NVFalse;
+              fq->file[file].error = errno;
+              fq->mutex.unlock ();
+            }
+        }
+
+
+      if (fp != NULL)
+        {
+          if (l_file_def[file].type)
+            {
+              process_tof (fp, file);
+            }
+          else
+            {
+              process_hof (fp, file);
+            }
+
+          fclose (fp);
+        }
+      else
+        {
+          //  The writer still needs a last chunk for the file.
+
+          putSlot (getSlot (file, 0), NVTrue, 0);
+        }
+    }
+}
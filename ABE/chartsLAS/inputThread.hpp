@@ -0,0 +1,60 @@
+#ifndef INPUTTHREAD_H
+#define INPUTTHREAD_H
+
+
+#include "chartsLASDef.hpp"
+
+
+class inputThread:public QThread
+{
+  Q_OBJECT 
+
+
+public:
+
+  inputThread (QObject *parent = 0);
+  ~inputThread ();
+
+  void prepare (FILE_QUEUE *fq = NULL, FILE_DEFINITION *fd = NULL, AREA_DEFINITION *ad = NULL, NV_INT32 ac = 0,
+                AREA_INDEX *ai = NULL, NV_BOOL geoid = NVFalse);
+
+
+protected:
+
+
+  QMutex           mutex;
+
+  FILE_QUEUE       *l_queue;
+
+  FILE_DEFINITION  *l_file_def;
+
+  AREA_DEFINITION  *l_area_def;
+
+  AREA_INDEX       *l_area_index;
+
+  NV_INT32         l_area_count, prev_hit;
+
+  NV_BOOL          l_geoid03, ver_dep_flag;
+
+  projPJ           *pj_utm, *pj_latlon;
+
+  void             run ();
+  AREA_RECORD      *addRecord (CHUNK_SLOT *slot, NV_INT32 area, NV_INT32 k);
+  CHUNK_SLOT       *getSlot (NV_INT32 file, NV_INT32 chunk);
+  void             putSlot (CHUNK_SLOT *slot, NV_BOOL last, NV_INT32 records_read);
+  void             process_tof (FILE *fp, NV_INT32 file);
+  void             process_hof (FILE *fp, NV_INT32 file);
+  NV_INT32         find_area (NV_FLOAT64 lat, NV_FLOAT64 lon);
+  void             utm (NV_INT32 area, NV_FLOAT64 lat, NV_FLOAT64 lon, NV_FLOAT64 *x, NV_FLOAT64 *y);
+  NV_FLOAT32       geoid (NV_FLOAT64 lat, NV_FLOAT64 lon);
+  void             addLASPoint (TOPO_OUTPUT_T *tof, NV_INT32 k, AREA_RECORD *rec);
+  void             addTOFASCRecord (TOPO_OUTPUT_T *tof, NV_INT32 k, CHUNK_SLOT *slot, AREA_RECORD *rec);
+  void             addHOFASCRecord (HYDRO_OUTPUT_T *hof, CHUNK_SLOT *slot, AREA_RECORD *rec);
+
+
+protected slots:
+
+private:
+};
+
+#endif
@@ -16,7 +16,7 @@
 
 #ifndef VERSION
 
-#define     VERSION     "PFM Software - chartsLAS V5.02 - 10/06/11"
+#define     VERSION     "PFM Software - chartsLAS V5.03 - 10/19/26"
 
 #endif
 
@@ -257,4 +257,13 @@
     To match a change in the TOF PFM loader we now check input files start times against 10/07/2011.
     Files prior to that date will ignore the first return if the last return was -998.0.
 
+
+    Version 5.03
+    Jan C. Depner
+    10/19/26
+
+    Input files are now read by a pool of threads and the per area output is written in input file order. Area output
+    files are opened once per run instead of being checked for each record. Points are found using a grid index of the
+    area MBRs and prepared polygons.
+
 */
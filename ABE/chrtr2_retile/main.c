@@ -0,0 +1,229 @@
+
+/*********************************************************************************************
+
+    This program is public domain software that was developed by 
+    the U.S. Naval Oceanographic Office.
+
+    This is a work of the US Government. In accordance with 17 USC 105,
+    copyright protection is not available for any work of the US Government.
+
+    This software is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+*********************************************************************************************/
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+
+#include "chrtr2.h"
+
+#include "version.h"
+
+
+/*  Size of the block cache used on the input file.  This is enough to hold a full band of 256 cell tiles
+    for very wide files so each input tile only gets read once.  */
+
+#define CACHE_MEGABYTES    256
+
+
+/*****************************************************************************
+
+    Program:    chrtr2_retile
+
+    Purpose:    Copies a CHRTR2 file to a new CHRTR2 file using either the
+                tiled layout or the original row ordered layout.  Tiled
+                files are much faster to read when you only want a small
+                rectangular area of a very large file.
+
+    Programmer: Jan C. Depner
+
+    Date:       10/19/26
+
+*****************************************************************************/
+
+
+void usage ()
+{
+  fprintf (stderr, "\nUsage: chrtr2_retile [-t TILE_SIZE] <INPUT_CHRTR2_FILE> <OUTPUT_CHRTR2_FILE>\n");
+  fprintf (stderr, "\nWhere:\n\n");
+  fprintf (stderr, "\t-t  =  tile size in grid cells (default 256)\n");
+  fprintf (stderr, "\t\tSet to 0 to convert a tiled file back to the row ordered layout\n\n");
+  fprintf (stderr, "\tExample: chrtr2_retile -t 128 fred.ch2 fred_tiled.ch2\n\n");
+  fflush (stderr);
+}
+
+
+
+NV_INT32 main (NV_INT32 argc, char **argv)
+{
+  NV_INT32            i, j, in_hnd, out_hnd, tile_size, rows, cols, percent = 0, old_percent = -1;
+  CHRTR2_HEADER       in_header, out_header;
+  CHRTR2_RECORD       *chrtr2_record;
+  NV_CHAR             c;
+  extern char         *optarg;
+  extern int          optind;
+
+
+  fprintf (stderr, "\n\n%s\n\n", VERSION);
+  fflush (stderr);
+
+
+  tile_size = 256;
+
+
+  while ((c = getopt (argc, argv, "t:")) != EOF)
+    {
+      switch (c)
+        {
+        case 't':
+          sscanf (optarg, "%d", &tile_size);
+          break;
+
+        default:
+          usage ();
+          exit (-1);
+          break;
+        }
+    }
+
+
+  /*  Make sure we got the mandatory file name arguments.  */
+
+  if (optind + 1 >= argc || tile_size < 0)
+    {
+      usage ();
+      exit (-1);
+    }
+
+
+  if (!strcmp (argv[optind], argv[optind + 1]))
+    {
+      fprintf (stderr, "The input and output files must be different.\n\n");
+      exit (-1);
+    }
+
+
+  if ((in_hnd = chrtr2_open_file (argv[optind], &in_header, CHRTR2_READONLY)) < 0)
+    {
+      chrtr2_perror ();
+      exit (-1);
+    }
+
+  chrtr2_open_cache (in_hnd, CACHE_MEGABYTES);
+
+
+  /*  The output header is the same as the input header except for the tile size.  */
+
+  out_header = in_header;
+  out_header.tile_size = tile_size;
+
+  if ((out_hnd = chrtr2_create_file (argv[optind + 1], &out_header)) < 0)
+    {
+      chrtr2_perror ();
+      exit (-1);
+    }
+
+
+  fprintf (stderr, "Input file  : %s\n", argv[optind]);
+  fprintf (stderr, "Output file : %s\n\n", argv[optind + 1]);
+  fflush (stderr);
+
+
+  /*  Tiled output is written one output tile at a time so the output file is written sequentially.  Row ordered
+      output is written a row at a time.  */
+
+  if (tile_size)
+    {
+      chrtr2_record = (CHRTR2_RECORD *) malloc (tile_size * tile_size * sizeof (CHRTR2_RECORD));
+    }
+  else
+    {
+      chrtr2_record = (CHRTR2_RECORD *) malloc (in_header.width * sizeof (CHRTR2_RECORD));
+    }
+
+  if (chrtr2_record == NULL)
+    {
+      perror ("Allocating chrtr2_record memory");
+      exit (-1);
+    }
+
+
+  for (i = 0 ; i < in_header.height ; i += rows)
+    {
+      if (tile_size)
+        {
+          rows = tile_size;
+          if (i + rows > in_header.height) rows = in_header.height - i;
+
+          for (j = 0 ; j < in_header.width ; j += cols)
+            {
+              NV_INT32 k;
+
+              cols = tile_size;
+              if (j + cols > in_header.width) cols = in_header.width - j;
+
+              if (chrtr2_read_window (in_hnd, i, j, rows, cols, chrtr2_record))
+                {
+                  chrtr2_perror ();
+                  exit (-1);
+                }
+
+              for (k = 0 ; k < rows ; k++)
+                {
+                  if (chrtr2_write_row (out_hnd, i + k, j, cols, &chrtr2_record[k * cols]))
+                    {
+                      chrtr2_perror ();
+                      exit (-1);
+                    }
+                }
+            }
+        }
+      else
+        {
+          rows = 1;
+
+          if (chrtr2_read_row (in_hnd, i, 0, in_header.width, chrtr2_record))
+            {
+              chrtr2_perror ();
+              exit (-1);
+            }
+
+          if (chrtr2_write_row (out_hnd, i, 0, in_header.width, chrtr2_record))
+            {
+              chrtr2_perror ();
+              exit (-1);
+            }
+        }
+
+
+      percent = (NV_INT32) (((NV_FLOAT32) (i + rows) / (NV_FLOAT32) in_header.height) * 100.0);
+      if (percent != old_percent)
+        {
+          old_percent = percent;
+          fprintf (stderr, "Converting rows : %03d%%          \r", percent);
+          fflush (stderr);
+        }
+    }
+
+  fprintf (stderr, "100%% rows converted                       \n\n");
+  fflush (stderr);
+
+
+  free (chrtr2_record);
+
+
+  chrtr2_close_file (in_hnd);
+
+  if (chrtr2_close_file (out_hnd))
+    {
+      chrtr2_perror ();
+      exit (-1);
+    }
+
+
+  return (0);
+}
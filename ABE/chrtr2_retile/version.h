@@ -0,0 +1,30 @@
+
+/*********************************************************************************************
+
+    This program is public domain software that was developed by 
+    the U.S. Naval Oceanographic Office.
+
+    This is a work of the US Government. In accordance with 17 USC 105,
+    copyright protection is not available for any work of the US Government.
+
+    This software is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+*********************************************************************************************/
+
+#ifndef VERSION
+
+#define     VERSION     "PFM Software - chrtr2_retile V1.00 - 10/19/26"
+
+#endif
+
+/*
+
+    Version 1.00
+    Jan C. Depner
+    10/19/26
+
+    First version.
+
+*/
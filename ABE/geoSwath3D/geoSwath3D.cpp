@@ -4811,15 +4811,7 @@ geoSwath3D::slotQuit ()
   misc.statusProg->setTextVisible (TRUE);
   qApp->processEvents();
 
-  for (NV_INT32 i = 0 ; i < data.count ; i++)
-    {
-      if (data.oval[i] != data.val[i])
-        {
-          misc.statusProg->setValue (i);
-
-          io_data_write (data.val[i], data.rec[i], data.sub[i], data.time[i]);
-	}
-    }
+  io_data_write_modified (&data, misc.statusProg);
 
   misc.statusProg->reset ();
   misc.statusProg->setRange (0, 100);
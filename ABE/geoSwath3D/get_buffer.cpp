@@ -35,15 +35,7 @@ void get_buffer (POINT_DATA *data, MISC *misc, NV_INT32 record)
   misc->statusProg->setTextVisible (TRUE);
   qApp->processEvents();
 
-  for (NV_INT32 i = 0 ; i < data->count ; i++)
-    {
-      if (data->oval[i] != data->val[i])
-        {
-          misc->statusProg->setValue (i);
-
-          io_data_write (data->val[i], data->rec[i], data->sub[i], data->time[i]);
-	}
-    }
+  io_data_write_modified (data, misc->statusProg);
 
   misc->statusProg->reset ();
   misc->statusProg->setRange (0, 100);
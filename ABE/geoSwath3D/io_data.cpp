@@ -41,6 +41,19 @@ static NV_INT32             last_rec = -1;
 
 
 
+//  Modified point list for io_data_write_modified.
+
+#define WRITE_BLOCK_RECORDS 256
+
+typedef struct
+{
+  NV_U_INT32                rec;
+  NV_INT32                  sub;
+  NV_INT32                  index;
+} WRITE_REC;
+
+
+
 static QProgressBar *indexProg;
 
 
@@ -757,116 +770,124 @@ void io_data_read (NV_INT32 num_records, POINT_DATA *data, QProgressBar *prog)
 
 
 
-void io_data_write (NV_U_INT32 val, NV_INT32 rec, NV_INT32 sub, NV_FLOAT64 time)
+//  Test the time passed back from the program against the one read in for the same rec.  If they don't match,
+//  you've got problems.
+
+static void check_time (NV_FLOAT64 file_time, NV_FLOAT64 time, NV_INT32 rec)
 {
-    NV_INT64      timestamp;
+  if (fabs (file_time - time) > 0.000001)
+    {
+      printf ("Time mismatch in io_data_write %f %f %d\n", file_time, time, rec);
+      exit (-1);
+    }
+}
 
 
-    if (no_edit) return;
 
+//  Set the validity of one return in a TOF record.
 
-    switch (type)
-      {
-      case PFM_SHOALS_TOF_DATA:
+static void set_tof_record (TOPO_OUTPUT_T *record, NV_U_INT32 val, NV_INT32 rec, NV_INT32 sub, NV_FLOAT64 time)
+{
+  charts_cvtime (record->timestamp, &year, &day, &hour, &minute, &second);
 
-        //  Read a record.  You don't have enough information to rebuild the record so you have 
-        //  to read it.
+  check_time (normtime (year, day, hour, minute, second), time, rec);
 
-        tof_read_record (fp, rec, &tof_record);
-        timestamp = tof_record.timestamp;
 
-        charts_cvtime (timestamp, &year, &day, &hour, &minute, &second);
+  if (sub)
+    {
+      if (val & PFM_INVAL)
+        {
+          if (record->conf_last > 0) record->conf_last = -record->conf_last;
+        }
+      else
+        {
+          if (record->conf_last < 0) record->conf_last = -record->conf_last;
+        }
+    }
+  else
+    {
+      if (val & PFM_INVAL)
+        {
+          if (record->conf_first > 0) record->conf_first = -record->conf_first;
+        }
+      else
+        {
+          if (record->conf_first < 0) record->conf_first = -record->conf_first;
+        }
+    }
+}
 
 
-        //  Test the time passed back from the program against the one just read in
-        //  for the same rec.  If they don't match, you've got problems.
-        
-        if (fabs (normtime (year, day, hour, minute, second) - time) > 0.000001)
-          {
-            printf ("Time mismatch in io_data_write %f %f %d\n",
-                    normtime (year, day, hour, minute, second), time, rec);
-            exit (-1);
-          }
 
+//  Set the validity of a HOF record.
 
-        if (sub)
-          {
-            if (val & PFM_INVAL)
-              {
-                if (tof_record.conf_last > 0) tof_record.conf_last = -tof_record.conf_last;
-              }
-            else
-              {
-                if (tof_record.conf_last < 0) tof_record.conf_last = -tof_record.conf_last;
-              }
-          }
-        else
-          {
-            if (val & PFM_INVAL)
-              {
-                if (tof_record.conf_first > 0) tof_record.conf_first = -tof_record.conf_first;
-              }
-            else
-              {
-                if (tof_record.conf_first < 0) tof_record.conf_first = -tof_record.conf_first;
-              }
-          }
+static void set_hof_record (HYDRO_OUTPUT_T *record, NV_U_INT32 val, NV_INT32 rec, NV_FLOAT64 time)
+{
+  charts_cvtime (record->timestamp, &year, &day, &hour, &minute, &second);
 
+  check_time (normtime (year, day, hour, minute, second), time, rec);
 
-        tof_write_record (fp, rec, tof_record);
 
-        break;
+  /*  HOF uses the lower three bits of the status field for status thusly :
 
+      bit 0 = deleted    (1)
+      bit 1 = kept       (2)
+      bit 2 = swapped    (4)
+  */
 
-      case PFM_CHARTS_HOF_DATA:
+  record->status = 0;
+  if (val & PFM_INVAL) record->status |= AU_STATUS_DELETED_BIT;
 
-        //  Read a record.  You don't have enough information to rebuild the record so you have 
-        //  to read it.
 
-        hof_read_record (fp, rec, &hof_record);
-        timestamp = hof_record.timestamp;
+  record->suspect_status = 0;
+  if (val & PFM_SUSPECT) record->suspect_status = SUSPECT_STATUS_SUSPECT_BIT;
+  if (val & PFM_SELECTED_FEATURE) record->suspect_status |= SUSPECT_STATUS_FEATURE_BIT;
 
 
-        charts_cvtime (timestamp, &year, &day, &hour, &minute, &second);
+  //  Another thing with the hof data - if the invalid bit is set we also set the abdc to a
+  //  negative (or vice-versa).
 
+  if (val & PFM_INVAL)
+    {
+      if (record->abdc > 0) record->abdc = -record->abdc;
+    }
+  else
+    {
+      if (record->abdc < 0) record->abdc = -record->abdc;
+    }
+}
 
-        //  Test the time passed back from the program against the one just read in
-        //  for the same rec.  If they don't match, you've got problems.
-        
-        if (fabs (normtime (year, day, hour, minute, second) - time) > 0.000001)
-          {
-            printf ("Time mismatch in io_data_write %f %f %d\n",
-                    normtime (year, day, hour, minute, second), time, rec);
-            exit (-1);
-          }
 
-        /*  HOF uses the lower three bits of the status field for status thusly :
 
-        bit 0 = deleted    (1) 
-        bit 1 = kept       (2) 
-        bit 2 = swapped    (4)      
-        */
+void io_data_write (NV_U_INT32 val, NV_INT32 rec, NV_INT32 sub, NV_FLOAT64 time)
+{
+    if (no_edit) return;
 
-        hof_record.status = 0;
-        if (val & PFM_INVAL) hof_record.status |= AU_STATUS_DELETED_BIT;
 
+    switch (type)
+      {
+      case PFM_SHOALS_TOF_DATA:
 
-        hof_record.suspect_status = 0;
-        if (val & PFM_SUSPECT) hof_record.suspect_status = SUSPECT_STATUS_SUSPECT_BIT;
-        if (val & PFM_SELECTED_FEATURE) hof_record.suspect_status |= SUSPECT_STATUS_FEATURE_BIT;
+        //  Read a record.  You don't have enough information to rebuild the record so you have
+        //  to read it.
 
+        tof_read_record (fp, rec, &tof_record);
 
-        //  Another thing with the hof data - if the invalid bit is set we also set the abdc to a 
-        //  negative (or vice-versa).
+        set_tof_record (&tof_record, val, rec, sub, time);
 
-        if (val & PFM_INVAL)
-          {
-            if (hof_record.abdc > 0) hof_record.abdc = -hof_record.abdc;
-          }
-        else
-          {
-            if (hof_record.abdc < 0) hof_record.abdc = -hof_record.abdc;
-          }
+        tof_write_record (fp, rec, tof_record);
+
+        break;
+
+
+      case PFM_CHARTS_HOF_DATA:
+
+        //  Read a record.  You don't have enough information to rebuild the record so you have
+        //  to read it.
+
+        hof_read_record (fp, rec, &hof_record);
+
+        set_hof_record (&hof_record, val, rec, time);
 
         hof_write_record (fp, rec, hof_record);
 
@@ -875,23 +896,14 @@ void io_data_write (NV_U_INT32 val, NV_INT32 rec, NV_INT32 sub, NV_FLOAT64 time)
 
       case PFM_WLF_DATA:
 
-        //  Read a record.  You don't have enough information to rebuild the record so you have 
+        //  Read a record.  You don't have enough information to rebuild the record so you have
         //  to read it.
 
         wlf_read_record (wlf_handle, rec, &wlf_record, NVFalse, NULL);
 
         cvtime (wlf_record.tv_sec, wlf_record.tv_nsec, &year, &day, &hour, &minute, &second);
 
-
-        //  Test the time passed back from the program against the one just read in
-        //  for the same rec.  If they don't match, you've got problems.
-        
-        if (fabs (normtime (year, day, hour, minute, second) - time) > 0.000001)
-          {
-            printf ("Time mismatch in io_data_write %f %f %d\n",
-                    normtime (year, day, hour, minute, second), time, rec);
-            exit (-1);
-          }
+        check_time (normtime (year, day, hour, minute, second), time, rec);
 
 
         if (val & WLF_MANUALLY_INVAL) wlf_record.status = PFM_MANUALLY_INVAL;
@@ -915,15 +927,7 @@ void io_data_write (NV_U_INT32 val, NV_INT32 rec, NV_INT32 sub, NV_FLOAT64 time)
 
         cvtime (hawkeye_record.tv_sec, hawkeye_record.tv_nsec, &year, &day, &hour, &minute, &second);
 
-
-        //  Test the time passed back from the program against the one just read in
-        //  for the same rec.  If they don't match, you've got problems.
-        
-        if (fabs (normtime (year, day, hour, minute, second) - time) > 0.000001)
-          {
-            printf ("Time mismatch in io_data_write %f %f %d\n", normtime (year, day, hour, minute, second), time, rec);
-            exit (-1);
-          }
+        check_time (normtime (year, day, hour, minute, second), time, rec);
 
 
         if (val & PFM_INVAL)
@@ -943,11 +947,11 @@ void io_data_write (NV_U_INT32 val, NV_INT32 rec, NV_INT32 sub, NV_FLOAT64 time)
       case PFM_GSF_DATA:
 
         //  If the rec number has changed, flush the last write buffer.
-    
+
         if (rec != last_rec)
           {
             //  Don't write the first time through.
-        
+
             if (last_rec != -1)
               {
                 gsf_data_id.record_number = last_rec;
@@ -955,7 +959,7 @@ void io_data_write (NV_U_INT32 val, NV_INT32 rec, NV_INT32 sub, NV_FLOAT64 time)
               }
 
 
-            //  Read a record.  You don't have enough information to rebuild the record so you 
+            //  Read a record.  You don't have enough information to rebuild the record so you
             //  have to read it.
 
             gsf_data_id.record_number = rec;
@@ -966,28 +970,18 @@ void io_data_write (NV_U_INT32 val, NV_INT32 rec, NV_INT32 sub, NV_FLOAT64 time)
               }
 
             //  Save the last rec number.
-        
+
             last_rec = rec;
           }
 
 
-        //  Test the time passed back from the program against the one just read in
-        //  for the same rec.  If they don't match, you've got problems.
-        
-        if (fabs (norm_posix_time (gsf_records.mb_ping.ping_time.tv_sec, 
-                                   gsf_records.mb_ping.ping_time.tv_nsec) - time) > 0.000001)
-          {
-            printf ("Time mismatch in io_data_write %f %f %d\n",
-                    norm_posix_time (gsf_records.mb_ping.ping_time.tv_sec,
-                                     gsf_records.mb_ping.ping_time.tv_nsec), time, rec);
-            exit (-1);
-          }
+        check_time (norm_posix_time (gsf_records.mb_ping.ping_time.tv_sec, gsf_records.mb_ping.ping_time.tv_nsec), time, rec);
 
 
         //  Convert the PFM validity data to GSF validity data (we're buffering by ping so we'll write it out later).
 
         //  Don't do anything if the entire ping was bad.
-    
+
         if (!(gsf_records.mb_ping.ping_flags & GSF_IGNORE_PING))
           {
             //  Set the beam flags.  Don't write the record yet, we'll do that if/when the record changes
@@ -1000,6 +994,187 @@ void io_data_write (NV_U_INT32 val, NV_INT32 rec, NV_INT32 sub, NV_FLOAT64 time)
 
 
 
+//  This is the record/subrecord sort function for qsort.
+
+static NV_INT32 compare_write_recs (const void *a, const void *b)
+{
+  WRITE_REC *sa = (WRITE_REC *) (a);
+  WRITE_REC *sb = (WRITE_REC *) (b);
+
+
+  if (sa->rec != sb->rec) return (sa->rec < sb->rec ? -1 : 1);
+
+  if (sa->sub != sb->sub) return (sa->sub < sb->sub ? -1 : 1);
+
+  return (sa->index < sb->index ? -1 : (sa->index > sb->index ? 1 : 0));
+}
+
+
+
+/*
+    Write all of the modified points in the buffer back to the file.  Rather than doing a read/modify/write for
+    every point in whatever order the points happen to be in memory, we sort the modified points by record and
+    subrecord number so that the file is read and written front to back and each record is only read and written
+    once.  For TOF and HOF files, runs of adjacent records are read and written as a single block.
+*/
+
+void io_data_write_modified (POINT_DATA *data, QProgressBar *prog)
+{
+  if (no_edit) return;
+
+
+  WRITE_REC *list = (WRITE_REC *) malloc (data->count * sizeof (WRITE_REC));
+  if (list == NULL && data->count)
+    {
+      perror ("Allocating write list in io_data.cpp");
+      exit (-1);
+    }
+
+  NV_INT32 count = 0;
+  for (NV_INT32 i = 0 ; i < data->count ; i++)
+    {
+      if (data->oval[i] != data->val[i])
+        {
+          list[count].rec = data->rec[i];
+          list[count].sub = data->sub[i];
+          list[count].index = i;
+          count++;
+        }
+    }
+
+  if (!count)
+    {
+      free (list);
+      return;
+    }
+
+
+  qsort (list, count, sizeof (WRITE_REC), compare_write_recs);
+
+
+  prog->setRange (0, count);
+
+
+  switch (type)
+    {
+    case PFM_SHOALS_TOF_DATA:
+    case PFM_CHARTS_HOF_DATA:
+      {
+        TOPO_OUTPUT_T *tof_block = NULL;
+        HYDRO_OUTPUT_T *hof_block = NULL;
+
+        if (type == PFM_SHOALS_TOF_DATA)
+          {
+            tof_block = (TOPO_OUTPUT_T *) malloc (WRITE_BLOCK_RECORDS * sizeof (TOPO_OUTPUT_T));
+          }
+        else
+          {
+            hof_block = (HYDRO_OUTPUT_T *) malloc (WRITE_BLOCK_RECORDS * sizeof (HYDRO_OUTPUT_T));
+          }
+
+        if (tof_block == NULL && hof_block == NULL)
+          {
+            perror ("Allocating write block in io_data.cpp");
+            exit (-1);
+          }
+
+
+        for (NV_INT32 i = 0 ; i < count ; )
+          {
+            //  Find the end of the run of adjacent records (or the end of the block).
+
+            NV_INT32 start_rec = list[i].rec;
+            NV_INT32 j = i + 1;
+
+            while (j < count && (NV_INT32) list[j].rec - (NV_INT32) list[j - 1].rec <= 1 &&
+                   (NV_INT32) list[j].rec - start_rec < WRITE_BLOCK_RECORDS) j++;
+
+            NV_INT32 num_recs = list[j - 1].rec - start_rec + 1;
+
+
+            //  Read the block.  You don't have enough information to rebuild the records so you have to read them.
+
+            for (NV_INT32 k = 0 ; k < num_recs ; k++)
+              {
+                if (type == PFM_SHOALS_TOF_DATA)
+                  {
+                    tof_read_record (fp, k ? TOF_NEXT_RECORD : start_rec, &tof_block[k]);
+                  }
+                else
+                  {
+                    hof_read_record (fp, k ? HOF_NEXT_RECORD : start_rec, &hof_block[k]);
+                  }
+              }
+
+
+            //  Modify the records.
+
+            for (NV_INT32 k = i ; k < j ; k++)
+              {
+                NV_INT32 ndx = list[k].index;
+
+                if (type == PFM_SHOALS_TOF_DATA)
+                  {
+                    set_tof_record (&tof_block[list[k].rec - start_rec], data->val[ndx], data->rec[ndx], data->sub[ndx], data->time[ndx]);
+                  }
+                else
+                  {
+                    set_hof_record (&hof_block[list[k].rec - start_rec], data->val[ndx], data->rec[ndx], data->time[ndx]);
+                  }
+              }
+
+
+            //  Write the block back out.
+
+            for (NV_INT32 k = 0 ; k < num_recs ; k++)
+              {
+                if (type == PFM_SHOALS_TOF_DATA)
+                  {
+                    tof_write_record (fp, k ? TOF_NEXT_RECORD : start_rec, tof_block[k]);
+                  }
+                else
+                  {
+                    hof_write_record (fp, k ? HOF_NEXT_RECORD : start_rec, hof_block[k]);
+                  }
+              }
+
+            prog->setValue (j);
+            qApp->processEvents ();
+
+            i = j;
+          }
+
+        if (tof_block) free (tof_block);
+        if (hof_block) free (hof_block);
+      }
+      break;
+
+
+      //  WLF, HAWKEYE, and GSF do their own buffering so we just feed them the points in order.  For GSF this means
+      //  that each ping is only read and written once.
+
+    default:
+      for (NV_INT32 i = 0 ; i < count ; i++)
+        {
+          NV_INT32 ndx = list[i].index;
+
+          io_data_write (data->val[ndx], data->rec[ndx], data->sub[ndx], data->time[ndx]);
+
+          if (!(i % 1000))
+            {
+              prog->setValue (i);
+              qApp->processEvents ();
+            }
+        }
+      break;
+    }
+
+
+  free (list);
+}
+
+
+
 NV_INT32 get_record ()
 {
     /*  REQUIRED    */
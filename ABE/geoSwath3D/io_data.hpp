@@ -23,6 +23,7 @@ NV_INT32 io_data_open (MISC *misc, OPTIONS *options);
 void io_data_close ();
 void io_data_read (NV_INT32 num_records, POINT_DATA *data, QProgressBar *prog);
 void io_data_write (NV_U_INT32 val, NV_INT32 rec, NV_INT32 sub, NV_FLOAT64 time);
+void io_data_write_modified (POINT_DATA *data, QProgressBar *prog);
 NV_INT32 get_record ();
 void set_record (NV_INT32 record);
 NV_FLOAT64 rec_time (NV_INT32 record);
@@ -16,7 +16,7 @@
 
 #ifndef VERSION
 
-#define     VERSION     "PFM Software - geoSwath3D V3.14 - 07/22/11"
+#define     VERSION     "PFM Software - geoSwath3D V3.15 - 10/19/26"
 
 #endif
 
@@ -183,4 +183,12 @@
     Using setSidebarUrls function from nvutility to make sure that current working directory (.) and
     last used directory are in the sidebar URL list of QFileDialogs.
 
+
+    Version 3.15
+    Jan C. Depner
+    10/19/26
+
+    Modified points are now sorted by record and written back with io_data_write_modified so each record is read and
+    written once, front to back.  Runs of adjacent TOF and HOF records are read and written as a single block.
+
 */
@@ -23,8 +23,6 @@ protected:
 
   MISC            misc;
 
-  WAVE_DATA       *wave_data;
-
 
 protected slots:
 
@@ -0,0 +1,112 @@
+#include "hofWaveFilterDef.hpp"
+
+
+/***************************************************************************\
+*                                                                           *
+*   Module Name:        pfm_filter_plugin_run                               *
+*                                                                           *
+*   Programmer(s):      Jan C. Depner                                       *
+*                                                                           *
+*   Date Written:       October 19, 2026                                    *
+*                                                                           *
+*   Purpose:            Entry point for the hofWaveFilterPlugin library.    *
+*                       This runs the same filter as the hofWaveFilter      *
+*                       program but it's called directly by pfmEdit3D with  *
+*                       the point cloud so we don't have to start a         *
+*                       process or pass the data through shared memory.     *
+*                       See PFM_FILTER_PLUGIN_ARGS in ABE.h.                *
+*                                                                           *
+*   Arguments:          args        -   plugin arguments                    *
+*                                                                           *
+*   Return Value:       0 on success, -1 on error                           *
+*                                                                           *
+\***************************************************************************/
+
+#ifdef NVWIN3X
+extern "C" __declspec (dllexport) NV_INT32 pfm_filter_plugin_run (PFM_FILTER_PLUGIN_ARGS *args)
+#else
+extern "C" NV_INT32 pfm_filter_plugin_run (PFM_FILTER_PLUGIN_ARGS *args)
+#endif
+{
+  NV_INT32 hof_wave_filter (MISC *misc, NV_CHAR *error);
+
+
+  args->kill_count = 0;
+  args->error[0] = 0;
+
+  if (args->version != PFM_FILTER_PLUGIN_VERSION)
+    {
+      sprintf (args->error, "hofWaveFilterPlugin version %d does not match caller version %d", PFM_FILTER_PLUGIN_VERSION, args->version);
+      return (-1);
+    }
+
+  if (args->count != args->abe_share->point_cloud_count)
+    {
+      sprintf (args->error, "hofWaveFilterPlugin point count %d does not match ABE point cloud count %d", args->count,
+               args->abe_share->point_cloud_count);
+      return (-1);
+    }
+
+
+  MISC misc;
+
+  memset (&misc, 0, sizeof (MISC));
+
+  misc.abe_share = args->abe_share;
+  misc.data = args->data;
+
+
+  //  Use the caller's PFM handles if we have them, otherwise open the PFM files ourselves.
+
+  if (args->pfm_handle)
+    {
+      for (NV_INT32 pfm = 0 ; pfm < misc.abe_share->pfm_count ; pfm++) misc.pfm_handle[pfm] = args->pfm_handle[pfm];
+    }
+  else
+    {
+      //  Open from a copy of the open arguments so we don't change the ones in shared memory.
+
+      for (NV_INT32 pfm = 0 ; pfm < misc.abe_share->pfm_count ; pfm++)
+        {
+          PFM_OPEN_ARGS open_args = misc.abe_share->open_args[pfm];
+          open_args.checkpoint = 0;
+
+          if ((misc.pfm_handle[pfm] = open_existing_pfm_file (&open_args)) < 0)
+            {
+              sprintf (args->error, "%s : %s", open_args.list_path, pfm_error_str (pfm_error));
+
+              for (NV_INT32 i = 0 ; i < pfm ; i++) close_pfm_file (misc.pfm_handle[i]);
+
+              return (-1);
+            }
+        }
+    }
+
+
+  NV_INT32 status = hof_wave_filter (&misc, args->error);
+
+
+  if (!args->pfm_handle)
+    {
+      for (NV_INT32 pfm = 0 ; pfm < misc.abe_share->pfm_count ; pfm++) close_pfm_file (misc.pfm_handle[pfm]);
+    }
+
+  if (status) return (status);
+
+
+  //  The filter flags points using exflag (the same way the program does).  Move those flags to the kill array so that
+  //  the point cloud is left the way we found it.
+
+  for (NV_INT32 i = 0 ; i < args->count ; i++)
+    {
+      if (args->data[i].exflag)
+        {
+          args->data[i].exflag = NVFalse;
+          args->kill[i] = NVTrue;
+          args->kill_count++;
+        }
+    }
+
+
+  return (0);
+}
@@ -15,7 +15,7 @@
 
 #ifndef VERSION
 
-#define     VERSION     "PFM Software - hofWaveFilter V1.12 - 07/08/11"
+#define     VERSION     "PFM Software - hofWaveFilter V1.20 - 10/19/26"
 
 #endif
 
@@ -77,4 +77,19 @@
     where they got near the surface.  The original plan for the prior to first drop kill was to remove surface
     returns but those are pretty easy to spot anyway.
 
+
+    Version 1.13
+    Jan C. Depner
+    10/19/26
+
+    Convert all point positions to meters with one geo_distance_xy call instead of two geo_distance calls per point.
+
+
+    Version 1.20
+    Jan C. Depner
+    10/19/26
+
+    Moved the filter itself into hof_wave_filter.cpp so that it can also be built as the hofWaveFilterPlugin library.
+    pfmEdit3D loads the plugin and calls it directly with the point cloud instead of running this program.
+
 */
@@ -27,6 +27,20 @@ NV_U_INT32 getColorOffset (QString colorInt)
 
 
 
+//  GDAL progress callback for building the overviews.
+
+static int CPL_STDCALL overviewProgress (double dfComplete, const char *pszMessage __attribute__ ((unused)), void *pProgressArg)
+{
+  QProgressDialog *progress = (QProgressDialog *) pProgressArg;
+
+  progress->setValue ((NV_INT32) (dfComplete * 100.0));
+  qApp->processEvents ();
+
+  return (TRUE);
+}
+
+
+
 NV_CHAR *get_geotiff (NV_CHAR *mosaic_file, MISC *misc)
 {
   static NV_CHAR string[512];
@@ -90,29 +104,11 @@ NV_CHAR *get_geotiff (NV_CHAR *mosaic_file, MISC *misc)
               return (string);
             }
 
-          if (misc->full_res_image != NULL) delete misc->full_res_image;
-
-
-          /*  This is how I used to read geoTIFFs but for some reason it stopped working along about Qt 4.7.2 so now I use GDAL to
-              read it.  I really need to keep testing to see if this starts working again because it's a bit faster and probably
-              a lot more bullet proof.
-
-          misc->full_res_image = new QImage (mosaic_file);
-
-          if (misc->full_res_image == NULL || misc->full_res_image->width () == 0 || fmisc->ull_res_image->height () == 0)
-            {
-              sprintf (string, "Unable to read file %s", gen_basename (mosaic_file));
-              delete poDataset;
-              return (string);
-            }
-          */
-
+          //  We no longer read the whole image here.  The tile threads read the part of the mosaic that is being displayed
+          //  (at the overview level closest to the display resolution) when it's needed.  Here we just check the bands.
 
-          //  This is how I read geoTIFFs now...
-
-          GDALRasterBand *poBand[4];
-          QString dataType[4], colorInt[4];
-          NV_U_INT32 mult[4] = {0, 0, 0, 0};
+          GDALRasterBand *poBand;
+          QString dataType, colorInt;
 
 
           NV_INT32 rasterCount = poDataset->GetRasterCount ();
@@ -123,77 +119,74 @@ NV_CHAR *get_geotiff (NV_CHAR *mosaic_file, MISC *misc)
               return (string);
             }
 
-          for (NV_INT32 i = 0 ; i < rasterCount ; i++)
+
+          //  We only have room for 4 bands (ARGB) in a pixel.
+
+          misc->band_count = qMin (rasterCount, 4);
+
+          for (NV_INT32 i = 0 ; i < misc->band_count ; i++)
             {
-              poBand[i] = poDataset->GetRasterBand (i + 1);
+              poBand = poDataset->GetRasterBand (i + 1);
 
-              dataType[i] = QString (GDALGetDataTypeName (poBand[i]->GetRasterDataType ()));
-              colorInt[i] = QString (GDALGetColorInterpretationName (poBand[i]->GetColorInterpretation ()));
+              dataType = QString (GDALGetDataTypeName (poBand->GetRasterDataType ()));
+              colorInt = QString (GDALGetColorInterpretationName (poBand->GetColorInterpretation ()));
 
 
               //  We can only handle Byte data (i.e. RGB or ARGB)
 
-              if (dataType[i] != "Byte")
+              if (dataType != "Byte")
                 {
                   delete poDataset;
                   sprintf (string, "Can only handle Byte data type");
                   return (string);
                 }
 
-              mult[i] = getColorOffset (colorInt[i]);
+              misc->band_mult[i] = getColorOffset (colorInt);
             }
 
-          NV_INT32 nXSize = poBand[0]->GetXSize ();
-          NV_INT32 nYSize = poBand[0]->GetYSize ();
 
-          misc->full_res_image = new QImage (nXSize, nYSize, QImage::Format_ARGB32);
-          if (misc->full_res_image == NULL || misc->full_res_image->width () == 0 || misc->full_res_image->height () == 0)
-            {
-              sprintf (string, "Unable to open image!");
-              delete poDataset;
-              return (string);
-            }
+          //  Number of overview levels needed to get the whole mosaic into about one tile.
 
-          NV_U_INT32 *color = new NV_U_INT32[nXSize];
-          NV_U_BYTE *pafScanline = (NV_U_BYTE *) CPLMalloc (sizeof (NV_U_BYTE) * nXSize);
+          misc->max_level = 0;
+          while (qMax (misc->mosaic_width, misc->mosaic_height) >> misc->max_level > TILE_SIZE) misc->max_level++;
 
-          for (NV_INT32 i = 0 ; i < nYSize ; i++)
-            {
-              //  If we don't have an alpha band set it to 255.
 
-              for (NV_INT32 k = 0 ; k < nXSize ; k++)
-                {
-                  if (rasterCount < 4)
-                    {
-                      color[k] = 0xff000000;
-                    }
-                  else
-                    {
-                      color[k] = 0x0;
-                    }
-                }
+          //  Build the overviews if the file doesn't already have them.  Since the file is opened read-only GDAL puts them
+          //  in an .ovr file next to the mosaic so we only have to do this the first time a mosaic is viewed.  If we can't
+          //  write the .ovr file we can still view the mosaic, it's just slower when zoomed out.
 
+          poBand = poDataset->GetRasterBand (1);
 
-              //  Read the raster bands.
-
-              for (NV_INT32 j = 0 ; j < rasterCount ; j++)
-                {
-                  poBand[j]->RasterIO (GF_Read, 0, i, nXSize, 1, pafScanline, nXSize, 1, GDT_Byte, 0, 0);
-                  for (NV_INT32 k = 0 ; k < nXSize ; k++) color[k] += ((NV_U_INT32) pafScanline[k]) * mult[j];
-                }
+          if (misc->max_level && poBand->GetOverviewCount () < misc->max_level)
+            {
+              NV_INT32 *levels = new NV_INT32[misc->max_level];
+              for (NV_INT32 i = 0 ; i < misc->max_level ; i++) levels[i] = 1 << (i + 1);
 
+              QProgressDialog progress (QString ("Building overviews for %1").arg (gen_basename (mosaic_file)), QString (), 0, 100);
+              progress.setWindowModality (Qt::ApplicationModal);
+              progress.show ();
+              qApp->processEvents ();
 
-              //  Set the image pixels.
+              CPLPushErrorHandler (CPLQuietErrorHandler);
+              poDataset->BuildOverviews ("AVERAGE", misc->max_level, levels, 0, NULL, overviewProgress, &progress);
+              CPLPopErrorHandler ();
 
-              for (NV_INT32 k = 0 ; k < nXSize ; k++)
-                {
-                  misc->full_res_image->setPixel (k, i, color[k]);
-                }
+              delete[] levels;
             }
 
-          delete (color);
-          CPLFree (pafScanline);
           delete poDataset;
+
+
+          //  Throw away any tiles from the last mosaic.
+
+          strcpy (misc->mosaic_path, mosaic_file);
+
+          misc->tiles.mutex.lock ();
+          misc->tiles.requests.clear ();
+          misc->tiles.cache.clear ();
+          misc->tiles.last_used.clear ();
+          misc->tiles.generation++;
+          misc->tiles.mutex.unlock ();
         }
       else
         {
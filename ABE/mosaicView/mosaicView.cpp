@@ -48,7 +48,10 @@ mosaicView::mosaicView (NV_INT32 argc, NV_CHAR **argv, QWidget * parent):
   prev_poly_lon = -181.0;
   popup_active = NVFalse;
   double_click = NVFalse;
-  misc.full_res_image = NULL;
+  misc.tiles.loading = 0;
+  misc.tiles.frame = 0;
+  misc.tiles.generation = 0;
+  misc.tiles.quit = NVFalse;
   misc.drawing = NVTrue;
   rb_rectangle = -1;
   rb_polygon = -1;
@@ -169,6 +172,17 @@ mosaicView::mosaicView (NV_INT32 argc, NV_CHAR **argv, QWidget * parent):
     }
 
 
+  //  Start the tile loading threads.  They sleep until slotPreRedraw asks for tiles.
+
+  num_tile_threads = qMin (qMax (QThread::idealThreadCount (), 1), MAX_TILE_THREADS);
+
+  for (NV_INT32 i = 0 ; i < num_tile_threads ; i++)
+    {
+      tile_thread[i] = new tileThread (this);
+      tile_thread[i]->prepare (&misc);
+    }
+
+
   strcpy (mosaic_file, argv[optind]);
 
 
@@ -1667,7 +1681,93 @@ mosaicView::slotPreRedraw (NVMAP_DEF map_mapdef)
   NV_INT32 high = y[0] - y[1];
 
 
-  QPixmap sub_image = QPixmap::fromImage (misc.full_res_image->copy (start_x, start_y, cols, rows));
+  if (rows <= 0 || cols <= 0 || wide <= 0 || high <= 0) return;
+
+
+  //  Pick the overview level that is closest to (but not coarser than) the screen resolution.  Level n has 1/2^n of
+  //  the full resolution rows and columns.
+
+  NV_INT32 level = 0;
+  NV_FLOAT64 reduction = qMin ((NV_FLOAT64) cols / (NV_FLOAT64) wide, (NV_FLOAT64) rows / (NV_FLOAT64) high);
+  if (reduction >= 2.0) level = (NV_INT32) floor (log (reduction) / log (2.0));
+  level = qMin (level, misc.max_level);
+
+
+  //  The part of the level that we need and the tiles that cover it.
+
+  NV_INT32 lx0 = start_x >> level;
+  NV_INT32 ly0 = start_y >> level;
+  NV_INT32 lx1 = (end_x - 1) >> level;
+  NV_INT32 ly1 = (end_y - 1) >> level;
+
+  NV_INT32 tx0 = lx0 / TILE_SIZE;
+  NV_INT32 ty0 = ly0 / TILE_SIZE;
+  NV_INT32 tx1 = lx1 / TILE_SIZE;
+  NV_INT32 ty1 = ly1 / TILE_SIZE;
+
+
+  //  Mark the tiles we need as used in this frame (so they won't get dropped from the cache) and ask the tile threads
+  //  for the ones that we don't have.
+
+  misc.tiles.mutex.lock ();
+
+  misc.tiles.frame++;
+
+  for (NV_INT32 ty = ty0 ; ty <= ty1 ; ty++)
+    {
+      for (NV_INT32 tx = tx0 ; tx <= tx1 ; tx++)
+        {
+          quint64 key = TILE_KEY (level, tx, ty);
+
+          misc.tiles.last_used.insert (key, misc.tiles.frame);
+
+          if (!misc.tiles.cache.contains (key) && !misc.tiles.requests.contains (key)) misc.tiles.requests.append (key);
+        }
+    }
+
+  misc.tiles.work.wakeAll ();
+
+
+  //  Wait for the tile threads to finish.  If all of the tiles were already in the cache we don't wait at all.  The
+  //  thread that loads the last tile wakes us up, we only time out to keep the GUI alive during long loads.
+
+  while (!misc.tiles.requests.isEmpty () || misc.tiles.loading)
+    {
+      if (!misc.tiles.done.wait (&misc.tiles.mutex, 100))
+        {
+          misc.tiles.mutex.unlock ();
+
+          qApp->processEvents ();
+
+          misc.tiles.mutex.lock ();
+        }
+    }
+
+
+  //  Put the tiles together.
+
+  QImage sub = QImage (lx1 - lx0 + 1, ly1 - ly0 + 1, QImage::Format_ARGB32);
+  sub.fill (0x0);
+
+  QPainter painter (&sub);
+
+  for (NV_INT32 ty = ty0 ; ty <= ty1 ; ty++)
+    {
+      for (NV_INT32 tx = tx0 ; tx <= tx1 ; tx++)
+        {
+          QHash<quint64, QImage>::const_iterator it = misc.tiles.cache.constFind (TILE_KEY (level, tx, ty));
+
+          if (it != misc.tiles.cache.constEnd () && !it.value ().isNull ())
+            painter.drawImage (tx * TILE_SIZE - lx0, ty * TILE_SIZE - ly0, it.value ());
+        }
+    }
+
+  painter.end ();
+
+  misc.tiles.mutex.unlock ();
+
+
+  QPixmap sub_image = QPixmap::fromImage (sub);
   QPixmap scaled_image = sub_image.scaled (wide, high, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
 
 
@@ -1778,6 +1878,16 @@ mosaicView::slotQuit ()
   envout (&options, this);
 
 
+  //  Stop the tile threads.
+
+  misc.tiles.mutex.lock ();
+  misc.tiles.quit = NVTrue;
+  misc.tiles.work.wakeAll ();
+  misc.tiles.mutex.unlock ();
+
+  for (NV_INT32 i = 0 ; i < num_tile_threads ; i++) tile_thread[i]->wait ();
+
+
   //  Get rid of the shared memory.
 
   misc.abeShare->detach ();
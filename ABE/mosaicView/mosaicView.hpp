@@ -20,6 +20,7 @@
 #include "version.hpp"
 #include "prefs.hpp"
 #include "editFeature.hpp"
+#include "tileThread.hpp"
 
 
 
@@ -63,6 +64,10 @@ protected:
 
   nvMap           *map;
 
+  tileThread      *tile_thread[MAX_TILE_THREADS];
+
+  NV_INT32        num_tile_threads;
+
   NV_INT32        feature_circle_pixels, menu_cursor_x, menu_cursor_y, redraw_count;
 
   QCursor         zoomCursor, editFeatureCursor, deleteFeatureCursor, addFeatureCursor, pencilCursor;
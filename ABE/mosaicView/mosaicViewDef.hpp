@@ -45,6 +45,14 @@ using namespace std;  // Windoze bullshit - God forbid they should follow a stan
 #define         POLYGON_POINTS              NVMAP_POLYGON_POINTS
 
 
+//  The mosaic is read in TILE_SIZE square tiles at the overview level closest to the display resolution.
+
+#define         TILE_SIZE                   256
+#define         MAX_TILE_THREADS            8
+#define         MAX_CACHED_TILES            1024
+#define         TILE_KEY(l,x,y)             (((quint64) (l) << 48) | ((quint64) (y) << 24) | (quint64) (x))
+
+
 //  The OPTIONS structure contains all those variables that can be saved to the
 //  users mosaicView QSettings.
 
@@ -84,6 +92,25 @@ typedef struct
 } OPTIONS;
 
 
+//  Tile loading and caching.  The GUI thread adds tiles to the request list and the tile threads read them (each with
+//  its own GDAL dataset) into the cache.  Tiles are stamped with the frame in which they were last needed so that the
+//  least recently used ones can be dropped when the cache is full.
+
+typedef struct
+{
+  QMutex      mutex;
+  QWaitCondition work;                    //  Wakes the tile threads when there are tiles to load (or it's time to quit)
+  QWaitCondition done;                    //  Wakes slotPreRedraw when the last requested tile has been loaded
+  QList<quint64> requests;                //  Tiles waiting to be loaded
+  NV_INT32    loading;                    //  Number of tiles being loaded
+  QHash<quint64, QImage> cache;           //  Loaded tiles
+  QHash<quint64, NV_U_INT32> last_used;   //  Frame in which each tile was last needed
+  NV_U_INT32  frame;                      //  Incremented for each redraw
+  NV_INT32    generation;                 //  Incremented each time a mosaic is opened
+  NV_BOOL     quit;
+} TILE_QUEUE;
+
+
 //  General stuff.
 
 typedef struct
@@ -108,7 +135,11 @@ typedef struct
   NV_F64_XYMBR geotiff_area;              //  Bounds of the GeoTIFF file
   NV_INT32    mosaic_width;
   NV_INT32    mosaic_height;
-  QImage      *full_res_image;
+  NV_CHAR     mosaic_path[512];           //  GeoTIFF file name
+  NV_INT32    band_count;                 //  Number of bands used (3 for RGB, 4 for ARGB)
+  NV_U_INT32  band_mult[4];               //  Multiplier to move each band into its place in an ARGB pixel
+  NV_INT32    max_level;                  //  Highest overview level (level n is 1/2^n resolution)
+  TILE_QUEUE  tiles;
   QSharedMemory *abeShare;                //  ABE's shared memory pointer.
   ABE_SHARE   *abe_share;                 //  Pointer to the ABE_SHARE structure in shared memory.
 } MISC;
@@ -0,0 +1,191 @@
+#include "tileThread.hpp"
+
+
+tileThread::tileThread (QObject *parent)
+  : QThread(parent)
+{
+  dataset = NULL;
+  generation = -1;
+  band_buffer = NULL;
+}
+
+
+
+tileThread::~tileThread ()
+{
+  if (dataset) delete dataset;
+  if (band_buffer) free (band_buffer);
+}
+
+
+
+void tileThread::prepare (MISC *mi)
+{
+  QMutexLocker locker (&mutex);
+
+  l_misc = mi;
+
+  if (!isRunning ()) start ();
+}
+
+
+
+//  Read one tile.  The key holds the overview level and the tile column and row at that level.  We ask GDAL for the
+//  full resolution window scaled down to the tile size and it reads from the overview that matches.
+
+NV_BOOL tileThread::load_tile (quint64 key, QImage *image)
+{
+  NV_INT32 level = (NV_INT32) (key >> 48);
+  NV_INT32 tile_y = (NV_INT32) ((key >> 24) & 0xffffff);
+  NV_INT32 tile_x = (NV_INT32) (key & 0xffffff);
+
+
+  //  Size of the mosaic at this level.
+
+  NV_INT32 level_width = (l_misc->mosaic_width + (1 << level) - 1) >> level;
+  NV_INT32 level_height = (l_misc->mosaic_height + (1 << level) - 1) >> level;
+
+  NV_INT32 x0 = tile_x * TILE_SIZE;
+  NV_INT32 y0 = tile_y * TILE_SIZE;
+  NV_INT32 w = qMin (TILE_SIZE, level_width - x0);
+  NV_INT32 h = qMin (TILE_SIZE, level_height - y0);
+
+  if (w <= 0 || h <= 0) return (NVFalse);
+
+
+  //  Full resolution window.
+
+  NV_INT32 sx = x0 << level;
+  NV_INT32 sy = y0 << level;
+  NV_INT32 sw = qMin (w << level, l_misc->mosaic_width - sx);
+  NV_INT32 sh = qMin (h << level, l_misc->mosaic_height - sy);
+
+
+  *image = QImage (w, h, QImage::Format_ARGB32);
+  if (image->isNull ()) return (NVFalse);
+
+
+  //  If we don't have an alpha band set it to 255.
+
+  image->fill (l_misc->band_count < 4 ? 0xff000000 : 0x0);
+
+
+  for (NV_INT32 j = 0 ; j < l_misc->band_count ; j++)
+    {
+      GDALRasterBand *poBand = dataset->GetRasterBand (j + 1);
+
+      if (poBand->RasterIO (GF_Read, sx, sy, sw, sh, band_buffer, w, h, GDT_Byte, 0, 0) != CE_None) return (NVFalse);
+
+      for (NV_INT32 i = 0 ; i < h ; i++)
+        {
+          NV_U_INT32 *line = (NV_U_INT32 *) image->scanLine (i);
+          NV_U_BYTE *band = &band_buffer[i * w];
+
+          for (NV_INT32 k = 0 ; k < w ; k++) line[k] += ((NV_U_INT32) band[k]) * l_misc->band_mult[j];
+        }
+    }
+
+  return (NVTrue);
+}
+
+
+
+void tileThread::run ()
+{
+  TILE_QUEUE *tq = &l_misc->tiles;
+
+
+  band_buffer = (NV_U_BYTE *) malloc (TILE_SIZE * TILE_SIZE);
+
+  if (band_buffer == NULL)
+    {
+      perror ("Allocating tile buffer");
+      exit (-1);
+    }
+
+
+  while (1)
+    {
+      //  Wait for a tile to load.
+
+      tq->mutex.lock ();
+
+      while (!tq->quit && tq->requests.isEmpty ()) tq->work.wait (&tq->mutex);
+
+      if (tq->quit)
+        {
+          tq->mutex.unlock ();
+          break;
+        }
+
+      quint64 key = tq->requests.takeFirst ();
+      tq->loading++;
+
+
+      //  Open the mosaic if we haven't opened it yet or a new one has been opened since the last tile.
+
+      if (generation != tq->generation)
+        {
+          if (dataset) delete dataset;
+
+          dataset = (GDALDataset *) GDALOpen (l_misc->mosaic_path, GA_ReadOnly);
+          generation = tq->generation;
+        }
+
+      NV_INT32 tile_generation = generation;
+
+      tq->mutex.unlock ();
+
+
+      QImage image;
+      NV_BOOL loaded = NVFalse;
+
+      if (dataset) loaded = load_tile (key, &image);
+
+
+      tq->mutex.lock ();
+
+
+      //  Don't keep tiles from a mosaic that has been replaced while we were reading.
+
+      if (tile_generation == tq->generation)
+        {
+          //  Put an empty image in the cache if we couldn't read the tile so that we don't keep asking for it.
+
+          if (!loaded) image = QImage ();
+
+          tq->cache.insert (key, image);
+          tq->last_used.insert (key, tq->frame);
+
+
+          //  Drop the least recently used tiles that aren't needed for the current frame.
+
+          while (tq->cache.size () > MAX_CACHED_TILES)
+            {
+              quint64 oldest = 0;
+              NV_U_INT32 oldest_frame = tq->frame;
+
+              QHash<quint64, NV_U_INT32>::const_iterator it;
+              for (it = tq->last_used.constBegin () ; it != tq->last_used.constEnd () ; ++it)
+                {
+                  if (it.value () < oldest_frame)
+                    {
+                      oldest = it.key ();
+                      oldest_frame = it.value ();
+                    }
+                }
+
+              if (oldest_frame == tq->frame) break;
+
+              tq->cache.remove (oldest);
+              tq->last_used.remove (oldest);
+            }
+        }
+
+      tq->loading--;
+
+      if (tq->requests.isEmpty () && !tq->loading) tq->done.wakeAll ();
+
+      tq->mutex.unlock ();
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef TILETHREAD_H
+#define TILETHREAD_H
+
+
+#include "mosaicViewDef.hpp"
+
+
+class tileThread:public QThread
+{
+  Q_OBJECT 
+
+
+public:
+
+  tileThread (QObject *parent = 0);
+  ~tileThread ();
+
+  void prepare (MISC *mi = NULL);
+
+
+protected:
+
+
+  QMutex           mutex;
+
+  MISC             *l_misc;
+
+  GDALDataset      *dataset;
+
+  NV_INT32         generation;
+
+  NV_U_BYTE        *band_buffer;
+
+  void             run ();
+  NV_BOOL          load_tile (quint64 key, QImage *image);
+
+
+protected slots:
+
+private:
+};
+
+#endif
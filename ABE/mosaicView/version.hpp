@@ -15,7 +15,7 @@
 
 #ifndef VERSION
 
-#define     VERSION     "PFM Software - mosaicView V1.34 - 04/15/11"
+#define     VERSION     "PFM Software - mosaicView V1.35 - 10/19/26"
 
 #endif
 
@@ -219,4 +219,12 @@
 
     Fixed the geoTIFF reading by switching to using GDAL instead of Qt.  Hopefully Qt will get fixed eventually.
 
+
+    Version 1.35
+    Jan C. Depner
+    10/19/26
+
+    Replaced the full resolution in-memory image with tiles read on demand from GDAL overviews (built the first time a
+    mosaic is opened) by a pool of tile threads.  Tiles are kept in an LRU cache.
+
 */
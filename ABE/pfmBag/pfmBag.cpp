@@ -1,5 +1,7 @@
 #include "pfmBag.hpp"
 #include "pfmBagHelp.hpp"
+#include "weightThread.hpp"
+#include "rowThread.hpp"
 
 
 NV_FLOAT64 settings_version = 1.0;
@@ -990,8 +992,7 @@ pfmBag::slotCustomButtonClicked (int id __attribute__ ((unused)))
   BFDATA_HEADER bfd_header;
   BFDATA_SHORT_FEATURE *feature;
   NV_BOOL features = NVFalse;
-  NV_FLOAT64 *radius = NULL, log_array[100], lat = 0.0, lon = 0.0, northing = 0.0, easting = 0.0;
-  NV_F64_COORD2 xy[2] = {{0.0, 0.0}, {0.0, 0.0}};
+  NV_FLOAT64 *radius = NULL, log_array[100], lat = 0.0, lon = 0.0;
 
 
   //  Set up the log array for scaling so we don't have to keep computing powers of ten in the main loop.  Note that I'm
@@ -1104,120 +1105,150 @@ pfmBag::slotCustomButtonClicked (int id __attribute__ ((unused)))
         }
 
 
-      //  Populate the weight array using the features.
+      //  Populate the weight array using the features.  Instead of checking every feature against every cell we
+      //  project each feature once and figure out which cells can possibly be inside its search radius (its
+      //  footprint).  The cells are then split into row bands and each band is done in a separate thread.
 
-      progress.wbar->setRange (0, height);
-      for (NV_INT32 i = 0 ; i < height ; i++)
+      WEIGHT_GRID grid;
+
+      grid.projection = options.projection;
+      grid.pfm_handle = pfm_handle;
+      grid.width = width;
+      grid.height = height;
+      grid.half_x = half_x;
+      grid.half_y = half_y;
+      grid.log_array = log_array;
+
+      if (options.projection)
         {
-          progress.wbar->setValue (i);
+          grid.min_x = proj_mbr.min_x;
+          grid.min_y = proj_mbr.min_y;
+          grid.x_bin_size = grid.y_bin_size = options.mbin_size;
+        }
+      else
+        {
+          grid.min_x = mbr.min_x;
+          grid.min_y = mbr.min_y;
+          grid.x_bin_size = x_bin_size_degrees;
+          grid.y_bin_size = y_bin_size_degrees;
 
-          if (options.projection)
-            {
-              xy[0].y = proj_mbr.min_y + (NV_FLOAT64) i * options.mbin_size;
-              xy[1].y = xy[0].y + options.mbin_size;
 
-              northing = xy[0].y + half_y;
-            }
-          else
-            {
-              xy[0].y = mbr.min_y + (NV_FLOAT64) i * y_bin_size_degrees;
-              xy[1].y = xy[0].y + y_bin_size_degrees;
+          //  Make sure the pfm_geo_distance tables are built before we start the threads.  After that
+          //  pfm_geo_distance only reads them.
 
-              lat = xy[0].y + half_y;
-            }
+          pfm_geo_distance_init (pfm_handle);
+        }
+
+
+      WEIGHT_FEATURE *weight_feature = (WEIGHT_FEATURE *) calloc (qMax ((NV_INT32) bfd_header.number_of_records, 1),
+                                                                  sizeof (WEIGHT_FEATURE));
+      if (weight_feature == NULL)
+        {
+          QMessageBox::critical (this, tr ("pfmBag Error"), tr ("Allocating weight feature memory.\n") + QString (strerror (errno)));
+          exit (-1);
+        }
+
+      NV_INT32 weight_count = 0;
 
-          for (NV_INT32 j = 0 ; j < width ; j++)
+      for (NV_U_INT32 k = 0 ; k < bfd_header.number_of_records ; k++)
+        {
+          //  Make sure the feature that has been read is inside the bounds of the BAG being built.
+          //  Also check the confidence.  If it is 0 it's invalid.  If it is 2 it was probably
+          //  set with mosaicView and is non-sonar.  If it's 1 it's probably not very good.
+
+          if (feature[k].confidence_level > 2 && feature[k].longitude >= mbr.min_x && feature[k].longitude <= mbr.max_x &&
+              feature[k].latitude >= mbr.min_y && feature[k].latitude <= mbr.max_y)
             {
+              WEIGHT_FEATURE *wf = &weight_feature[weight_count];
+              NV_FLOAT64 x_radius, y_radius;
+
+              wf->radius = radius[k];
+
               if (options.projection)
                 {
-                  xy[0].x = proj_mbr.min_x + (NV_FLOAT64) j * options.mbin_size;
-                  xy[1].x = xy[0].x + options.mbin_size;
+                  wf->x = feature[k].longitude * NV_DEG_TO_RAD;
+                  wf->y = feature[k].latitude * NV_DEG_TO_RAD;
+                  pj_transform (pj_latlon, pj_utm, 1, 1, &wf->x, &wf->y, NULL);
 
-                  easting = xy[0].x + half_x;
+                  x_radius = y_radius = radius[k];
                 }
               else
                 {
-                  xy[0].x = mbr.min_x + (NV_FLOAT64) j * x_bin_size_degrees;
-                  xy[1].x = xy[0].x + x_bin_size_degrees;
+                  wf->x = feature[k].longitude;
+                  wf->y = feature[k].latitude;
+
 
-                  lon = xy[0].x + half_x;
+                  //  Convert the radius to degrees.  We use the poleward edge of the search radius for the longitude
+                  //  since that is where a meter covers the most longitude.
+
+                  newgp (wf->y, wf->x, 0.0, radius[k], &lat, &lon);
+                  y_radius = fabs (lat - wf->y);
+
+                  NV_FLOAT64 edge_lat = wf->y >= 0.0 ? wf->y + y_radius : wf->y - y_radius;
+                  newgp (edge_lat, wf->x, 90.0, radius[k], &lat, &lon);
+                  x_radius = fabs (lon - wf->x);
                 }
 
-              NV_FLOAT64 sum = 0.0;
-              NV_BOOL hit = NVFalse;
 
+              //  Add a bit of slop to allow for the approximations in the distance computations and one cell on each
+              //  side for round off.
 
-              for (NV_U_INT32 k = 0 ; k < bfd_header.number_of_records ; k++)
-                {
-                  //  Make sure the feature that has been read is inside the bounds of the BAG being built.
-                  //  Also check the confidence.  If it is 0 it's invalid.  If it is 2 it was probably
-                  //  set with mosaicView and is non-sonar.  If it's 1 it's probably not very good.
+              x_radius *= 1.1;
+              y_radius *= 1.1;
 
-                  if (feature[k].confidence_level > 2 && feature[k].longitude >= mbr.min_x && feature[k].longitude <= mbr.max_x &&
-                      feature[k].latitude >= mbr.min_y && feature[k].latitude <= mbr.max_y)
-                    {
-                      //  Simple check first...  If it's in the same bin then we set the sum to 100.0 and move on.
+              wf->start_row = qMax ((NV_INT32) floor ((wf->y - y_radius - grid.min_y - half_y) / grid.y_bin_size) - 1, 0);
+              wf->end_row = qMin ((NV_INT32) floor ((wf->y + y_radius - grid.min_y - half_y) / grid.y_bin_size) + 1, height - 1);
+              wf->start_col = qMax ((NV_INT32) floor ((wf->x - x_radius - grid.min_x - half_x) / grid.x_bin_size) - 1, 0);
+              wf->end_col = qMin ((NV_INT32) floor ((wf->x + x_radius - grid.min_x - half_x) / grid.x_bin_size) + 1, width - 1);
 
-                      if (feature[k].longitude >= xy[0].x && feature[k].longitude <= xy[1].x &&
-                          feature[k].latitude >= xy[0].y && feature[k].latitude <= xy[1].y)
-                        {
-                          sum = 100.0;
-                          hit = NVTrue;
-                          break;
-                        }
+              if (wf->start_row <= wf->end_row && wf->start_col <= wf->end_col) weight_count++;
+            }
+        }
 
 
-                      //  Now for the more complicated stuff...  We have to compute the distance from the feature to the
-                      //  cell center to compute the weight.
+      //  Start the threads.  Each one gets a band of rows.
 
-                      NV_FLOAT64 dist;
+      weightThread weight_thread[MAX_WEIGHT_THREADS];
 
-                      if (options.projection)
-                        {
-                          NV_FLOAT64 x = feature[k].longitude * NV_DEG_TO_RAD;
-                          NV_FLOAT64 y = feature[k].latitude * NV_DEG_TO_RAD;
-                          pj_transform (pj_latlon, pj_utm, 1, 1, &x, &y, NULL);
-                          dist = sqrt ((northing - y) * (northing - y) + (easting - x) * (easting - x));
-                        }
-                      else
-                        {
-                          pfm_geo_distance (pfm_handle, lat, lon, feature[k].latitude, feature[k].longitude, &dist);
-                        }
+      NV_INT32 num_threads = qMin (qMax (QThread::idealThreadCount (), 1), MAX_WEIGHT_THREADS);
+      num_threads = qMax (qMin (num_threads, height), 1);
 
+      NV_INT32 band_height = height / num_threads + 1;
 
-                      //  If we're less than our prescribed distance away from any feature, we want to use a combination of
-                      //  the minimum depth in the bin and the average depth for the bin.  We use a power of ten, or log,
-                      //  curve to blend the two depths together.  Linear blending falls off too quickly and leaves you
-                      //  with the same old spike sticking up (like we used to have with the tracking list).  The blending
-                      //  works by taking 100 percent of the minimum depth in the bin in which the feature is located and
-                      //  100 percent of the average depth in bins that are more than the feature search radius away from
-                      //  the feature.  As we move away from the feature (but still inside the search radius) we include
-                      //  more of the average and less of the minimum (based on the precomputed log curve).  If the search
-                      //  radii of two features overlap we add the blended minimum depth components (not to exceed 100 percent).
-                      //  If, at any point in the feature comparison for a single bin, we exceed 100 percent we stop doing
-                      //  the feature comparison for that bin.  This saves us a bit of time.
+      for (NV_INT32 i = 0 ; i < num_threads ; i++)
+        {
+          NV_INT32 start_row = i * band_height;
+          NV_INT32 end_row = qMin (start_row + band_height - 1, height - 1);
 
-                      if (dist < radius[k])
-                        {
-                          NV_FLOAT64 percent = dist / radius[k];
-                          NV_INT32 index = NINT (percent * 100.0);
-
-                          if (index < 100)
-                            {
-                              sum += 100.0 - (log_array[index] * 10.0);
-                              hit = NVTrue;
-                              if (sum >= 100.0) break;
-                            }
-                        }
-                    }
-                }
+          weight_thread[i].weight (&grid, weight_feature, weight_count, weight, start_row, end_row);
+        }
+
+
+      //  Keep the progress bar updated until all of the threads are finished.
+
+      progress.wbar->setRange (0, height);
+
+      NV_BOOL done = NVFalse;
+      while (!done)
+        {
+          done = NVTrue;
+          NV_INT32 rows = 0;
 
-              if (hit) weight[i][j] = qMin (NINT (sum), 100);
+          for (NV_INT32 i = 0 ; i < num_threads ; i++)
+            {
+              weight_thread[i].wait (100);
+
+              if (!weight_thread[i].isFinished ()) done = NVFalse;
+
+              rows += weight_thread[i].rowsDone ();
             }
 
+          progress.wbar->setValue (rows);
           qApp->processEvents ();
         }
 
+      free (weight_feature);
+
       progress.wbar->setValue (height);
       qApp->processEvents ();
     }
@@ -1256,38 +1287,18 @@ pfmBag::slotCustomButtonClicked (int id __attribute__ ((unused)))
     }
 
 
-  //  Allocate the elevation array.
-
-  NV_FLOAT32 *elevation = (NV_FLOAT32 *) calloc (width, sizeof (NV_FLOAT32));
-
-  if (elevation == NULL)
-    {
-      perror (tr ("Allocating elevation memory").toAscii ());
-      exit (-1);
-    }
-
-
-  //  Allocate the uncertainty array.
-
-  NV_FLOAT32 *uncert = NULL;
-  if (options.uncertainty)
-    {
-      uncert = (NV_FLOAT32 *) calloc (width, sizeof (NV_FLOAT32));
-
-      if (uncert == NULL)
-        {
-          perror (tr ("Allocating uncertainty memory").toAscii ());
-          exit (-1);
-        }
-    }
-
-
   //  Set to compressionLevel 1.
 
   opt_data_sep.compressionLevel = 1;
   data.compressionLevel = 1;
 
 
+  //  Use square chunks so that the BAG can be read efficiently in tiles.
+
+  opt_data_sep.chunkSize = BAG_CHUNK_SIZE;
+  data.chunkSize = BAG_CHUNK_SIZE;
+
+
   //  Create the BAG file.
 
   if ((err = bagFileCreate (name, &data, &bagHandle)) != BAG_SUCCESS)
@@ -1309,8 +1320,6 @@ pfmBag::slotCustomButtonClicked (int id __attribute__ ((unused)))
 
   progress.mbar->setRange (0, height);
 
-  NV_FLOAT64 py[2] = {0.0, 0.0};
-
 
   //  Figure out where (if anywhere) the final uncertainty attribute is stored.
 
@@ -1325,266 +1334,173 @@ pfmBag::slotCustomButtonClicked (int id __attribute__ ((unused)))
     }
 
 
-  //  Loop for the height of the PFM.
+  //  The output rows are computed in bands by the row threads (each with its own PFM handle and projections) while
+  //  this thread writes the finished bands to the BAG in order.
 
-  for (NV_INT32 i = 0 ; i < height ; i++)
-    {
-      progress.mbar->setValue (i);
+  NV_INT32 num_threads = qMin (qMax (QThread::idealThreadCount (), 1), MAX_ROW_THREADS);
 
-      if (options.projection)
-        {
-          py[0] = proj_mbr.min_y + (NV_FLOAT64) i * options.mbin_size;
-          py[1] = py[0] + options.mbin_size;
-        }
-      else
-        {
-          xy[0].y = mbr.min_y + (NV_FLOAT64) i * y_bin_size_degrees;
-          xy[1].y = xy[0].y + y_bin_size_degrees;
-        }
+  ROW_BANDS bands;
 
+  bands.width = width;
+  bands.height = height;
+  bands.band_rows = ROW_BAND_SIZE;
+  bands.num_bands = (height + ROW_BAND_SIZE - 1) / ROW_BAND_SIZE;
+  bands.next_band = 0;
+  bands.write_band = 0;
+  bands.num_slots = num_threads * 2;
+  bands.rows_done = 0;
+  bands.mbr = mbr;
+  bands.proj_mbr = proj_mbr;
+  bands.x_bin_size_degrees = x_bin_size_degrees;
+  bands.y_bin_size_degrees = y_bin_size_degrees;
+  bands.fu_attr = fu_attr;
+  bands.weight = weight;
 
-      //  Loop for the width of the PFM.
+  bands.elevation = (NV_FLOAT32 **) calloc (bands.num_slots, sizeof (NV_FLOAT32 *));
+  bands.uncert = NULL;
+  if (options.uncertainty) bands.uncert = (NV_FLOAT32 **) calloc (bands.num_slots, sizeof (NV_FLOAT32 *));
+  bands.ready = (NV_BOOL *) calloc (bands.num_slots, sizeof (NV_BOOL));
 
-      for (NV_INT32 j = 0 ; j < width ; j++)
-        {
-          NV_I32_COORD2 coord[2];
+  if (bands.elevation == NULL || (options.uncertainty && bands.uncert == NULL) || bands.ready == NULL)
+    {
+      perror (tr ("Allocating row band memory").toAscii ());
+      exit (-1);
+    }
+
+  for (NV_INT32 i = 0 ; i < bands.num_slots ; i++)
+    {
+      bands.elevation[i] = (NV_FLOAT32 *) calloc (bands.band_rows * width, sizeof (NV_FLOAT32));
 
+      if (bands.elevation[i] == NULL)
+        {
+          perror (tr ("Allocating elevation memory").toAscii ());
+          exit (-1);
+        }
 
-          //  Determine the range of the cell coordinates of the cells that have data in the output bin.
+      if (options.uncertainty)
+        {
+          bands.uncert[i] = (NV_FLOAT32 *) calloc (bands.band_rows * width, sizeof (NV_FLOAT32));
 
-          if (options.projection)
-            {
-              xy[0].x = proj_mbr.min_x + (NV_FLOAT64) j * options.mbin_size;
-              xy[1].x = xy[0].x + options.mbin_size;
-
-              NV_FLOAT64 x = xy[0].x;
-              NV_FLOAT64 y = py[0];
-              pj_transform (pj_utm, pj_latlon, 1, 1, &x, &y, NULL);
-              xy[0].x = x * NV_RAD_TO_DEG;
-              xy[0].y = y * NV_RAD_TO_DEG;
-
-              x = xy[1].x;
-              y = py[1];
-              pj_transform (pj_utm, pj_latlon, 1, 1, &x, &y, NULL);
-              xy[1].x = x * NV_RAD_TO_DEG;
-              xy[1].y = y * NV_RAD_TO_DEG;
-            }
-          else
+          if (bands.uncert[i] == NULL)
             {
-              xy[0].x = mbr.min_x + (NV_FLOAT64) j * x_bin_size_degrees;
-              xy[1].x = xy[0].x + x_bin_size_degrees;
+              perror (tr ("Allocating uncertainty memory").toAscii ());
+              exit (-1);
             }
+        }
+    }
 
 
-          compute_index_ptr (xy[0], &coord[0], &open_args.head);
-          compute_index_ptr (xy[1], &coord[1], &open_args.head);
+  rowThread row_thread[MAX_ROW_THREADS];
+  NV_INT32 row_handle[MAX_ROW_THREADS];
+  PFM_OPEN_ARGS row_open_args[MAX_ROW_THREADS];
+  projPJ row_pj_utm[MAX_ROW_THREADS], row_pj_latlon[MAX_ROW_THREADS];
+
+  for (NV_INT32 i = 0 ; i < num_threads ; i++)
+    {
+      strcpy (row_open_args[i].list_path, open_args.list_path);
 
+      row_open_args[i].checkpoint = 0;
+      if ((row_handle[i] = open_existing_pfm_file (&row_open_args[i])) < 0) pfm_error_exit (pfm_error);
 
-          elevation[j] = NULL_ELEVATION;
-          if (options.uncertainty) uncert[j] = NULL_UNCERTAINTY;
 
+      row_pj_utm[i] = row_pj_latlon[i] = NULL;
 
-          NV_FLOAT64 sum = 0.0;
-          NV_FLOAT64 sum2 = 0.0;
-          NV_FLOAT64 uncert_sum = 0.0;
-          NV_FLOAT64 uncert_sum2 = 0.0;
-          NV_FLOAT64 min_uncert = 0.0;
-          NV_INT32 count = 0;
-          NV_FLOAT64 max_z = -999999999.0;
-          NV_FLOAT64 min_z = 999999999.0;
+      if (options.projection)
+        {
+          NV_CHAR *utm_def = pj_get_def (pj_utm, 0);
+          NV_CHAR *latlon_def = pj_get_def (pj_latlon, 0);
 
+          row_pj_utm[i] = pj_init_plus (utm_def);
+          row_pj_latlon[i] = pj_init_plus (latlon_def);
 
-          //  If we're running a CUBE surface we can't change the bin size or select the uncertainty type.
-          //  These will be hard-wired.
+          pj_dalloc (utm_def);
+          pj_dalloc (latlon_def);
 
-          if (options.surface == CUBE_SURFACE)
+          if (!row_pj_utm[i] || !row_pj_latlon[i])
             {
-              BIN_RECORD bin;
-
-              read_bin_record_index (pfm_handle, coord[0], &bin);
+              QMessageBox::critical (this, tr ("pfmBag"), tr ("Error initializing thread projections\n"));
+              exit (-1);
+            }
+        }
 
-              if (bin.validity & PFM_DATA)
-                {
-                  sum = bin.avg_filtered_depth;
-                  min_z = bin.min_filtered_depth;
-                  min_uncert = uncert_sum = bin.attr[fu_attr];
-                  count = 1;
+      row_thread[i].prepare (&options, &bands, row_handle[i], &row_open_args[i], row_pj_utm[i], row_pj_latlon[i]);
+    }
 
 
-                  //  If we are creating the enhanced surface we need to get the uncertainty of the minimum depth.
+  //  Write the bands as they are finished.
 
-                  if (options.enhanced)
-                    {
-                      DEPTH_RECORD *depth;
-                      NV_INT32 numrecs;
+  for (NV_INT32 band = 0 ; band < bands.num_bands ; band++)
+    {
+      NV_INT32 slot = band % bands.num_slots;
 
-                      if (!read_depth_array_index (pfm_handle, coord[0], &depth, &numrecs))
-                        {
-                          for (NV_INT32 p = 0 ; p < numrecs ; p++)
-                            {
-                              if (!(depth[p].validity & (PFM_INVAL | PFM_DELETED | PFM_REFERENCE)))
-                                {
-                                  if (depth[p].xyz.z <= min_z)
-                                    {
-                                      min_uncert = depth[p].vertical_error;
-                                      break;
-                                    }
-                                }
-                            }
-
-                          free (depth);
-                        }
-                    }
-                }
-            }
-          else
-            {
-              //  Loop over the height and width of the covering cells.
 
-              for (NV_INT32 m = coord[0].y ; m <= coord[1].y ; m++)
-                {
-                  if (m >= 0 && m < open_args.head.bin_height)
-                    {
-                      NV_I32_COORD2 icoord;
-                      icoord.y = m;
+      //  Wait for the band while keeping the progress bar updated.
 
-                      for (NV_INT32 n = coord[0].x ; n <= coord[1].x ; n++)
-                        {
-                          if (n >= 0 && n < open_args.head.bin_width)
-                            {
-                              icoord.x = n;
-
-
-                              DEPTH_RECORD *depth;
-                              NV_INT32 numrecs;
-
-                              if (!read_depth_array_index (pfm_handle, icoord, &depth, &numrecs))
-                                {
-                                  for (NV_INT32 p = 0 ; p < numrecs ; p++)
-                                    {
-                                      if ((!(depth[p].validity & (PFM_INVAL | PFM_DELETED | PFM_REFERENCE))) &&
-                                          depth[p].xyz.x >= xy[0].x && depth[p].xyz.x <= xy[1].x &&
-                                          depth[p].xyz.y >= xy[0].y && depth[p].xyz.y <= xy[1].y)
-                                        {
-
-                                          //  Get the minimum depth and the uncertainty of that depth.
-
-                                          if (depth[p].xyz.z <= min_z)
-                                            {
-                                              min_uncert = depth[p].vertical_error;
-                                              min_z = depth[p].xyz.z;
-                                            }
-
-                                          max_z = qMax (max_z, depth[p].xyz.z);
-
-                                          if (options.surface != CUBE_SURFACE)
-                                            {
-                                              sum += depth[p].xyz.z;
-                                              sum2 += depth[p].xyz.z * depth[p].xyz.z;
-                                              uncert_sum += depth[p].vertical_error;
-                                              uncert_sum2 += depth[p].vertical_error * depth[p].vertical_error;
-                                              count++;
-                                            }
-                                        }
-                                    }
-
-                                  free (depth);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+      while (1)
+        {
+          bands.mutex.lock ();
+          NV_BOOL ready = bands.ready[slot];
+          NV_INT32 rows_done = bands.rows_done;
+          bands.mutex.unlock ();
 
+          if (ready) break;
 
+          progress.mbar->setValue (rows_done);
           qApp->processEvents ();
 
-
-          if (min_z > 99999999.0) count = 0;
+#ifdef NVWIN3X
+          Sleep (100);
+#else
+          usleep (100000);
+#endif
+        }
 
 
-          if (count)
-            {
-              NV_FLOAT64 avg = sum / (NV_FLOAT64) count;
+      NV_INT32 start_row = band * bands.band_rows;
+      NV_INT32 end_row = qMin (start_row + bands.band_rows, height);
 
+      for (NV_INT32 i = start_row ; i < end_row ; i++)
+        {
+          NV_INT32 offset = (i - start_row) * width;
 
-              switch (options.uncertainty)
-                {
-                case NO_UNCERT:
-                  break;
+          err = bagWriteRow (bagHandle, i, 0, width - 1, Elevation, (void *) &bands.elevation[slot][offset]);
+          if (options.uncertainty) err = bagWriteRow (bagHandle, i, 0, width - 1, Uncertainty, (void *) &bands.uncert[slot][offset]);
+        }
 
-                case STD_UNCERT:
-                  uncert[j] = 0.0;
 
-                  if (count > 1)
-                    {
-                      NV_FLOAT64 variance = ((sum2 - ((NV_FLOAT64) count * (pow (avg, 2.0)))) / ((NV_FLOAT64) count - 1.0));
-                      if (variance >= 0.0) uncert[j] = sqrt (variance);
-                    }
-                  break;
+      //  Free the slot for the next band.
 
-                case FIN_UNCERT:
-                  if (options.enhanced)
-                    {
-                      NV_FLOAT32 weight1 = (100.0 - (NV_FLOAT32) weight[i][j]) / 100.0;
-                      NV_FLOAT32 weight2 = (NV_FLOAT32) weight[i][j] / 100.0;
-                      uncert[j] = -((uncert_sum / (NV_FLOAT64) count) * weight1 + min_uncert * weight2);
-                    }
-                  else
-                    {
-                      uncert[j] = uncert_sum / (NV_FLOAT64) count;
-                    }
-                  break;
+      bands.mutex.lock ();
+      bands.ready[slot] = NVFalse;
+      bands.write_band++;
+      bands.slot_free.wakeAll ();
+      bands.mutex.unlock ();
 
-                case TPE_UNCERT:
-                  if (options.enhanced)
-                    {
-                      NV_FLOAT32 weight1 = (100.0 - (NV_FLOAT32) weight[i][j]) / 100.0;
-                      NV_FLOAT32 weight2 = (NV_FLOAT32) weight[i][j] / 100.0;
-                      uncert[j] = -((sqrt (uncert_sum2 / (NV_FLOAT64) count)) * weight1 + min_uncert * weight2);
-                    }
-                  else
-                    {
-                      uncert[j] = sqrt (uncert_sum2 / (NV_FLOAT64) count);
-                    }
-                  break;
-                }
+      progress.mbar->setValue (end_row);
+      qApp->processEvents ();
+    }
 
 
-              switch (options.surface)
-                {
-                case MIN_SURFACE:
-                  elevation[j] = -min_z;
-                  break;
+  for (NV_INT32 i = 0 ; i < num_threads ; i++)
+    {
+      row_thread[i].wait ();
 
-                case MAX_SURFACE:
-                  elevation[j] = -max_z;
-                  break;
+      close_pfm_file (row_handle[i]);
 
-                case AVG_SURFACE:
-                case CUBE_SURFACE:
-                  if (options.enhanced)
-                    {
-                      NV_FLOAT32 weight1 = (100.0 - (NV_FLOAT32) weight[i][j]) / 100.0;
-                      NV_FLOAT32 weight2 = (NV_FLOAT32) weight[i][j] / 100.0;
-                      elevation[j] = -(avg * weight1 + min_z * weight2);
-                    }
-                  else
-                    {
-                      elevation[j] = -avg;
-                    }
-                }
-            }
-        }
+      if (row_pj_utm[i]) pj_free (row_pj_utm[i]);
+      if (row_pj_latlon[i]) pj_free (row_pj_latlon[i]);
+    }
 
 
-      err = bagWriteRow (bagHandle, i, 0, width - 1, Elevation, (void *) elevation);
-      if (options.uncertainty) err = bagWriteRow (bagHandle, i, 0, width - 1, Uncertainty, (void *) uncert);
+  for (NV_INT32 i = 0 ; i < bands.num_slots ; i++)
+    {
+      free (bands.elevation[i]);
+      if (options.uncertainty) free (bands.uncert[i]);
     }
 
-
-  free (elevation);
-  if (options.uncertainty) free (uncert);
+  free (bands.elevation);
+  if (options.uncertainty) free (bands.uncert);
+  free (bands.ready);
 
   progress.mbar->setValue (height);
   qApp->processEvents ();
@@ -30,6 +30,13 @@
 #define FIN_UNCERT   3
 
 
+#define MAX_WEIGHT_THREADS 16
+#define MAX_ROW_THREADS    16
+#define BAG_CHUNK_SIZE     256        //  HDF5 chunk size (rows and columns) for the BAG layers
+#define ROW_BAND_SIZE      32         //  Number of output rows computed at one time by a row thread
+#define ROW_BIN_CACHE      4          //  Number of PFM bin rows cached by each row thread
+
+
 typedef struct
 {
   NV_BOOL            active;
@@ -95,5 +102,71 @@ typedef struct
 } RUN_PROGRESS;
 
 
+//  Geometry of the enhanced surface weight grid.  These are in northings and eastings for UTM output or lat/lon for geodetic
+//  output.
+
+typedef struct
+{
+  NV_BOOL             projection;
+  NV_INT32            pfm_handle;            //  Used for pfm_geo_distance when not projected
+  NV_INT32            width;
+  NV_INT32            height;
+  NV_FLOAT64          min_x;
+  NV_FLOAT64          min_y;
+  NV_FLOAT64          x_bin_size;
+  NV_FLOAT64          y_bin_size;
+  NV_FLOAT64          half_x;                //  Offset from the lower left corner of a cell to the cell center
+  NV_FLOAT64          half_y;
+  NV_FLOAT64          *log_array;            //  Precomputed 100 element log blending curve
+} WEIGHT_GRID;
+
+
+//  Shared state for the row threads and the BAG writer.  The output rows are computed in bands of band_rows rows.  The threads take bands in order and put the results in
+//  one of num_slots slots.  The writer (the GUI thread) writes the bands in order and frees the slots.  A thread won't start
+//  a band until its slot is free, so at most num_slots bands are in memory at any one time.
+
+typedef struct
+{
+  QMutex              mutex;
+  QWaitCondition      slot_free;
+  NV_INT32            width;
+  NV_INT32            height;
+  NV_INT32            band_rows;
+  NV_INT32            num_bands;
+  NV_INT32            next_band;             //  Next band to be computed
+  NV_INT32            write_band;            //  Next band to be written
+  NV_INT32            num_slots;
+  NV_FLOAT32          **elevation;           //  [num_slots][band_rows * width]
+  NV_FLOAT32          **uncert;              //  [num_slots][band_rows * width] (NULL if no uncertainty)
+  NV_BOOL             *ready;                //  [num_slots]
+  NV_INT32            rows_done;
+
+
+  //  Output grid definition.
+
+  NV_F64_XYMBR        mbr;
+  NV_F64_XYMBR        proj_mbr;
+  NV_FLOAT64          x_bin_size_degrees;
+  NV_FLOAT64          y_bin_size_degrees;
+  NV_INT32            fu_attr;               //  Final uncertainty attribute (-1 if not present)
+  NV_U_BYTE           **weight;              //  Enhanced surface weights (NULL if not enhanced)
+} ROW_BANDS;
+
+
+//  A feature that will be used to build the enhanced surface weights.  The position is projected (if needed) once and we
+//  only look at the cells within the start/end row/column footprint of the feature's search radius.
+
+typedef struct
+{
+  NV_FLOAT64          x;                     //  Easting or longitude
+  NV_FLOAT64          y;                     //  Northing or latitude
+  NV_FLOAT64          radius;
+  NV_INT32            start_row;
+  NV_INT32            end_row;
+  NV_INT32            start_col;
+  NV_INT32            end_col;
+} WEIGHT_FEATURE;
+
+
 
 #endif
@@ -0,0 +1,384 @@
+#include "rowThread.hpp"
+
+rowThread::rowThread (QObject *parent)
+  : QThread(parent)
+{
+  for (NV_INT32 i = 0 ; i < ROW_BIN_CACHE ; i++)
+    {
+      cache[i] = NULL;
+      cache_row[i] = -1;
+    }
+
+  cache_next = 0;
+}
+
+
+
+rowThread::~rowThread ()
+{
+  for (NV_INT32 i = 0 ; i < ROW_BIN_CACHE ; i++) if (cache[i]) free (cache[i]);
+}
+
+
+
+//  Each thread needs its own PFM handle and its own projections since neither the PFM library nor PROJ.4 can be
+//  shared between threads.
+
+void rowThread::prepare (OPTIONS *op, ROW_BANDS *rb, NV_INT32 ph, PFM_OPEN_ARGS *oa, projPJ pu, projPJ pl)
+{
+  QMutexLocker locker (&mutex);
+
+  l_options = op;
+  l_bands = rb;
+  l_pfm_handle = ph;
+  l_open_args = *oa;
+  l_pj_utm = pu;
+  l_pj_latlon = pl;
+
+  if (!isRunning ()) start ();
+}
+
+
+
+//  Get a bin record from the small cache of PFM bin rows.  The output rows usually cover the same one or two PFM rows
+//  so this saves us a lot of single bin reads.  Returns NVFalse if the coordinates are outside of the PFM.
+
+NV_BOOL rowThread::get_bin (NV_I32_COORD2 coord, BIN_RECORD *bin)
+{
+  if (coord.y < 0 || coord.y >= l_open_args.head.bin_height || coord.x < 0 || coord.x >= l_open_args.head.bin_width) return (NVFalse);
+
+  for (NV_INT32 i = 0 ; i < ROW_BIN_CACHE ; i++)
+    {
+      if (cache_row[i] == coord.y)
+        {
+          *bin = cache[i][coord.x];
+          return (NVTrue);
+        }
+    }
+
+
+  //  Not in the cache so replace the oldest row.
+
+  NV_INT32 slot = cache_next;
+  cache_next = (cache_next + 1) % ROW_BIN_CACHE;
+
+  if (cache[slot] == NULL)
+    {
+      cache[slot] = (BIN_RECORD *) calloc (l_open_args.head.bin_width, sizeof (BIN_RECORD));
+
+      if (cache[slot] == NULL)
+        {
+          perror ("Allocating bin row cache");
+          exit (-1);
+        }
+    }
+
+  read_bin_row (l_pfm_handle, l_open_args.head.bin_width, coord.y, 0, cache[slot]);
+  cache_row[slot] = coord.y;
+
+  *bin = cache[slot][coord.x];
+
+  return (NVTrue);
+}
+
+
+
+//  Compute the elevation (and uncertainty) values for output row i.
+
+void rowThread::compute_row (NV_INT32 i, NV_FLOAT32 *elevation, NV_FLOAT32 *uncert)
+{
+  OPTIONS *options = l_options;
+  ROW_BANDS *rb = l_bands;
+  NV_F64_COORD2 xy[2];
+  NV_FLOAT64 py[2] = {0.0, 0.0};
+
+
+  if (options->projection)
+    {
+      py[0] = rb->proj_mbr.min_y + (NV_FLOAT64) i * options->mbin_size;
+      py[1] = py[0] + options->mbin_size;
+    }
+  else
+    {
+      xy[0].y = rb->mbr.min_y + (NV_FLOAT64) i * rb->y_bin_size_degrees;
+      xy[1].y = xy[0].y + rb->y_bin_size_degrees;
+    }
+
+
+  //  Loop for the width of the PFM.
+
+  for (NV_INT32 j = 0 ; j < rb->width ; j++)
+    {
+      NV_I32_COORD2 coord[2];
+
+
+      //  Determine the range of the cell coordinates of the cells that have data in the output bin.
+
+      if (options->projection)
+        {
+          xy[0].x = rb->proj_mbr.min_x + (NV_FLOAT64) j * options->mbin_size;
+          xy[1].x = xy[0].x + options->mbin_size;
+
+          NV_FLOAT64 x = xy[0].x;
+          NV_FLOAT64 y = py[0];
+          pj_transform (l_pj_utm, l_pj_latlon, 1, 1, &x, &y, NULL);
+          xy[0].x = x * NV_RAD_TO_DEG;
+          xy[0].y = y * NV_RAD_TO_DEG;
+
+          x = xy[1].x;
+          y = py[1];
+          pj_transform (l_pj_utm, l_pj_latlon, 1, 1, &x, &y, NULL);
+          xy[1].x = x * NV_RAD_TO_DEG;
+          xy[1].y = y * NV_RAD_TO_DEG;
+        }
+      else
+        {
+          xy[0].x = rb->mbr.min_x + (NV_FLOAT64) j * rb->x_bin_size_degrees;
+          xy[1].x = xy[0].x + rb->x_bin_size_degrees;
+        }
+
+
+      compute_index_ptr (xy[0], &coord[0], &l_open_args.head);
+      compute_index_ptr (xy[1], &coord[1], &l_open_args.head);
+
+
+      elevation[j] = NULL_ELEVATION;
+      if (options->uncertainty) uncert[j] = NULL_UNCERTAINTY;
+
+
+      NV_FLOAT64 sum = 0.0;
+      NV_FLOAT64 sum2 = 0.0;
+      NV_FLOAT64 uncert_sum = 0.0;
+      NV_FLOAT64 uncert_sum2 = 0.0;
+      NV_FLOAT64 min_uncert = 0.0;
+      NV_INT32 count = 0;
+      NV_FLOAT64 max_z = -999999999.0;
+      NV_FLOAT64 min_z = 999999999.0;
+      BIN_RECORD bin;
+
+
+      //  If we're running a CUBE surface we can't change the bin size or select the uncertainty type.
+      //  These will be hard-wired.
+
+      if (options->surface == CUBE_SURFACE)
+        {
+          if (get_bin (coord[0], &bin) && (bin.validity & PFM_DATA))
+            {
+              sum = bin.avg_filtered_depth;
+              min_z = bin.min_filtered_depth;
+              min_uncert = uncert_sum = (rb->fu_attr >= 0) ? bin.attr[rb->fu_attr] : 0.0;
+              count = 1;
+
+
+              //  If we are creating the enhanced surface we need to get the uncertainty of the minimum depth.
+
+              if (options->enhanced)
+                {
+                  DEPTH_RECORD *depth;
+                  NV_INT32 numrecs;
+
+                  if (!read_depth_array_index (l_pfm_handle, coord[0], &depth, &numrecs))
+                    {
+                      for (NV_INT32 p = 0 ; p < numrecs ; p++)
+                        {
+                          if (!(depth[p].validity & (PFM_INVAL | PFM_DELETED | PFM_REFERENCE)))
+                            {
+                              if (depth[p].xyz.z <= min_z)
+                                {
+                                  min_uncert = depth[p].vertical_error;
+                                  break;
+                                }
+                            }
+                        }
+
+                      free (depth);
+                    }
+                }
+            }
+        }
+      else
+        {
+          //  Loop over the height and width of the covering cells.
+
+          for (NV_INT32 m = coord[0].y ; m <= coord[1].y ; m++)
+            {
+              if (m >= 0 && m < l_open_args.head.bin_height)
+                {
+                  NV_I32_COORD2 icoord;
+                  icoord.y = m;
+
+                  for (NV_INT32 n = coord[0].x ; n <= coord[1].x ; n++)
+                    {
+                      icoord.x = n;
+
+
+                      //  Don't bother trying to read the depths for empty bins.
+
+                      if (get_bin (icoord, &bin) && bin.num_soundings)
+                        {
+                          DEPTH_RECORD *depth;
+                          NV_INT32 numrecs;
+
+                          if (!read_depth_array_index (l_pfm_handle, icoord, &depth, &numrecs))
+                            {
+                              for (NV_INT32 p = 0 ; p < numrecs ; p++)
+                                {
+                                  if ((!(depth[p].validity & (PFM_INVAL | PFM_DELETED | PFM_REFERENCE))) &&
+                                      depth[p].xyz.x >= xy[0].x && depth[p].xyz.x <= xy[1].x &&
+                                      depth[p].xyz.y >= xy[0].y && depth[p].xyz.y <= xy[1].y)
+                                    {
+                                      //  Get the minimum depth and the uncertainty of that depth.
+
+                                      if (depth[p].xyz.z <= min_z)
+                                        {
+                                          min_uncert = depth[p].vertical_error;
+                                          min_z = depth[p].xyz.z;
+                                        }
+
+                                      max_z = qMax (max_z, depth[p].xyz.z);
+
+                                      sum += depth[p].xyz.z;
+                                      sum2 += depth[p].xyz.z * depth[p].xyz.z;
+                                      uncert_sum += depth[p].vertical_error;
+                                      uncert_sum2 += depth[p].vertical_error * depth[p].vertical_error;
+                                      count++;
+                                    }
+                                }
+
+                              free (depth);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+
+      if (min_z > 99999999.0) count = 0;
+
+
+      if (count)
+        {
+          NV_FLOAT64 avg = sum / (NV_FLOAT64) count;
+          NV_FLOAT32 weight1 = 1.0, weight2 = 0.0;
+
+          if (options->enhanced)
+            {
+              weight1 = (100.0 - (NV_FLOAT32) rb->weight[i][j]) / 100.0;
+              weight2 = (NV_FLOAT32) rb->weight[i][j] / 100.0;
+            }
+
+
+          switch (options->uncertainty)
+            {
+            case NO_UNCERT:
+              break;
+
+            case STD_UNCERT:
+              uncert[j] = 0.0;
+
+              if (count > 1)
+                {
+                  NV_FLOAT64 variance = ((sum2 - ((NV_FLOAT64) count * (pow (avg, 2.0)))) / ((NV_FLOAT64) count - 1.0));
+                  if (variance >= 0.0) uncert[j] = sqrt (variance);
+                }
+              break;
+
+            case FIN_UNCERT:
+              if (options->enhanced)
+                {
+                  uncert[j] = -((uncert_sum / (NV_FLOAT64) count) * weight1 + min_uncert * weight2);
+                }
+              else
+                {
+                  uncert[j] = uncert_sum / (NV_FLOAT64) count;
+                }
+              break;
+
+            case TPE_UNCERT:
+              if (options->enhanced)
+                {
+                  uncert[j] = -((sqrt (uncert_sum2 / (NV_FLOAT64) count)) * weight1 + min_uncert * weight2);
+                }
+              else
+                {
+                  uncert[j] = sqrt (uncert_sum2 / (NV_FLOAT64) count);
+                }
+              break;
+            }
+
+
+          switch (options->surface)
+            {
+            case MIN_SURFACE:
+              elevation[j] = -min_z;
+              break;
+
+            case MAX_SURFACE:
+              elevation[j] = -max_z;
+              break;
+
+            case AVG_SURFACE:
+            case CUBE_SURFACE:
+              if (options->enhanced)
+                {
+                  elevation[j] = -(avg * weight1 + min_z * weight2);
+                }
+              else
+                {
+                  elevation[j] = -avg;
+                }
+            }
+        }
+    }
+}
+
+
+
+void rowThread::run ()
+{
+  ROW_BANDS *rb = l_bands;
+
+
+  while (1)
+    {
+      //  Get the next band and wait for its slot to be free.
+
+      rb->mutex.lock ();
+
+      NV_INT32 band = rb->next_band;
+
+      if (band >= rb->num_bands)
+        {
+          rb->mutex.unlock ();
+          break;
+        }
+
+      rb->next_band++;
+
+      while (band >= rb->write_band + rb->num_slots) rb->slot_free.wait (&rb->mutex);
+
+      rb->mutex.unlock ();
+
+
+      NV_INT32 slot = band % rb->num_slots;
+      NV_INT32 start_row = band * rb->band_rows;
+      NV_INT32 end_row = qMin (start_row + rb->band_rows, rb->height);
+
+      for (NV_INT32 i = start_row ; i < end_row ; i++)
+        {
+          NV_INT32 offset = (i - start_row) * rb->width;
+
+          compute_row (i, &rb->elevation[slot][offset], rb->uncert ? &rb->uncert[slot][offset] : NULL);
+
+          rb->mutex.lock ();
+          rb->rows_done++;
+          rb->mutex.unlock ();
+        }
+
+
+      rb->mutex.lock ();
+      rb->ready[slot] = NVTrue;
+      rb->mutex.unlock ();
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef ROWTHREAD_H
+#define ROWTHREAD_H
+
+
+#include "pfmBagDef.hpp"
+
+
+class rowThread:public QThread
+{
+  Q_OBJECT 
+
+
+public:
+
+  rowThread (QObject *parent = 0);
+  ~rowThread ();
+
+  void prepare (OPTIONS *op = NULL, ROW_BANDS *rb = NULL, NV_INT32 ph = -1, PFM_OPEN_ARGS *oa = NULL, projPJ pu = NULL,
+                projPJ pl = NULL);
+
+
+protected:
+
+
+  QMutex           mutex;
+
+  OPTIONS          *l_options;
+
+  ROW_BANDS        *l_bands;
+
+  PFM_OPEN_ARGS    l_open_args;
+
+  NV_INT32         l_pfm_handle, cache_row[ROW_BIN_CACHE], cache_next;
+
+  BIN_RECORD       *cache[ROW_BIN_CACHE];
+
+  projPJ           l_pj_utm, l_pj_latlon;
+
+  void             run ();
+  NV_BOOL          get_bin (NV_I32_COORD2 coord, BIN_RECORD *bin);
+  void             compute_row (NV_INT32 i, NV_FLOAT32 *elevation, NV_FLOAT32 *uncert);
+
+
+protected slots:
+
+private:
+};
+
+#endif
@@ -15,7 +15,7 @@
 
 #ifndef VERSION
 
-#define     VERSION     "PFM Software - pfmBag V3.30 - 11/04/11"
+#define     VERSION     "PFM Software - pfmBag V3.33 - 10/19/26"
 
 #endif
 
@@ -211,4 +211,27 @@
     Average TPE or Final Uncertainty with the TPE fo the minimum sounding in the area of features
     when creating the enhanced navigation surface.
 
+
+    Version 3.31
+    Jan C. Depner
+    10/19/26
+
+    Compute the enhanced surface weights by splatting each feature into only the cells inside its search radius footprint
+    and split the weight grid into row bands that are computed in separate threads.
+
+
+    Version 3.32
+    Jan C. Depner
+    10/19/26
+
+    Compute the output rows in bands using multiple threads (each with its own PFM handle) while the GUI thread writes the
+    finished bands to the BAG in order.  Set the BAG chunk size to 256 for tiled access.
+
+
+    Version 3.33
+    Jan C. Depner
+    10/19/26
+
+    Use pfm_geo_distance_init to build the distance tables before starting the weight threads.
+
 */
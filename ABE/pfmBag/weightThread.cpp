@@ -0,0 +1,206 @@
+#include "weightThread.hpp"
+
+weightThread::weightThread (QObject *parent)
+  : QThread(parent)
+{
+  rows_done = 0;
+}
+
+
+
+weightThread::~weightThread ()
+{
+}
+
+
+
+//  Each thread computes the weights for rows start_row through end_row of the weight grid.  Since the rows don't overlap
+//  we don't need to lock the weight array.
+
+void weightThread::weight (WEIGHT_GRID *wg, WEIGHT_FEATURE *wf, NV_INT32 count, NV_U_BYTE **w, NV_INT32 sr, NV_INT32 er)
+{
+  QMutexLocker locker (&mutex);
+
+  l_grid = wg;
+  l_features = wf;
+  l_count = count;
+  l_weight = w;
+  l_start_row = sr;
+  l_end_row = er;
+  rows_done = 0;
+
+  if (!isRunning ()) start ();
+}
+
+
+
+NV_INT32 weightThread::rowsDone ()
+{
+  QMutexLocker locker (&mutex);
+
+  return (rows_done);
+}
+
+
+
+void weightThread::run ()
+{
+  NV_FLOAT64          xy[2][2], lat = 0.0, lon = 0.0, northing = 0.0, easting = 0.0;
+
+
+  mutex.lock ();
+
+  WEIGHT_GRID *grid = l_grid;
+  WEIGHT_FEATURE *feature = l_features;
+  NV_INT32 count = l_count;
+  NV_U_BYTE **weight = l_weight;
+  NV_INT32 start_row = l_start_row;
+  NV_INT32 end_row = l_end_row;
+
+  mutex.unlock ();
+
+
+  //  Get the list of features whose footprint touches our rows.  We keep these in the original feature order so that the
+  //  sums are accumulated in the same order that they would be if we checked every feature for every cell.
+
+  NV_INT32 *band = (NV_INT32 *) calloc (qMax (count, 1), sizeof (NV_INT32));
+  NV_FLOAT64 *sum = (NV_FLOAT64 *) calloc (grid->width, sizeof (NV_FLOAT64));
+  NV_BOOL *hit = (NV_BOOL *) calloc (grid->width, sizeof (NV_BOOL));
+
+  if (band == NULL || sum == NULL || hit == NULL)
+    {
+      perror ("Allocating weight thread memory");
+      exit (-1);
+    }
+
+  NV_INT32 band_count = 0;
+  for (NV_INT32 k = 0 ; k < count ; k++)
+    {
+      if (feature[k].end_row >= start_row && feature[k].start_row <= end_row) band[band_count++] = k;
+    }
+
+
+  for (NV_INT32 i = start_row ; i <= end_row ; i++)
+    {
+      xy[0][1] = grid->min_y + (NV_FLOAT64) i * grid->y_bin_size;
+      xy[1][1] = xy[0][1] + grid->y_bin_size;
+
+      if (grid->projection)
+        {
+          northing = xy[0][1] + grid->half_y;
+        }
+      else
+        {
+          lat = xy[0][1] + grid->half_y;
+        }
+
+
+      //  Splat each feature into the cells of this row that are inside its footprint.
+
+      NV_INT32 min_col = grid->width, max_col = -1;
+
+      for (NV_INT32 b = 0 ; b < band_count ; b++)
+        {
+          WEIGHT_FEATURE *f = &feature[band[b]];
+
+          if (i < f->start_row || i > f->end_row) continue;
+
+
+          //  Clear the part of the row buffers that we haven't used yet on this row.
+
+          if (max_col < 0)
+            {
+              min_col = f->start_col;
+              max_col = f->start_col - 1;
+            }
+
+          for (NV_INT32 j = f->start_col ; j < min_col ; j++)
+            {
+              sum[j] = 0.0;
+              hit[j] = NVFalse;
+            }
+
+          for (NV_INT32 j = max_col + 1 ; j <= f->end_col ; j++)
+            {
+              sum[j] = 0.0;
+              hit[j] = NVFalse;
+            }
+
+          min_col = qMin (min_col, f->start_col);
+          max_col = qMax (max_col, f->end_col);
+
+
+          for (NV_INT32 j = f->start_col ; j <= f->end_col ; j++)
+            {
+              //  Once we've hit 100 percent there's no point in adding any more features to this cell.
+
+              if (sum[j] >= 100.0) continue;
+
+
+              xy[0][0] = grid->min_x + (NV_FLOAT64) j * grid->x_bin_size;
+              xy[1][0] = xy[0][0] + grid->x_bin_size;
+
+
+              //  Simple check first...  If it's in the same bin then we set the sum to 100.0 and move on.
+
+              if (f->x >= xy[0][0] && f->x <= xy[1][0] && f->y >= xy[0][1] && f->y <= xy[1][1])
+                {
+                  sum[j] = 100.0;
+                  hit[j] = NVTrue;
+                  continue;
+                }
+
+
+              //  Now for the more complicated stuff...  We have to compute the distance from the feature to the
+              //  cell center to compute the weight.
+
+              NV_FLOAT64 dist;
+
+              if (grid->projection)
+                {
+                  easting = xy[0][0] + grid->half_x;
+
+                  dist = sqrt ((northing - f->y) * (northing - f->y) + (easting - f->x) * (easting - f->x));
+                }
+              else
+                {
+                  lon = xy[0][0] + grid->half_x;
+
+                  if (pfm_geo_distance (grid->pfm_handle, lat, lon, f->y, f->x, &dist)) continue;
+                }
+
+
+              //  If we're less than our prescribed distance away from any feature, we want to use a combination of
+              //  the minimum depth in the bin and the average depth for the bin (see the comments in pfmBag.cpp).
+
+              if (dist < f->radius)
+                {
+                  NV_FLOAT64 percent = dist / f->radius;
+                  NV_INT32 index = NINT (percent * 100.0);
+
+                  if (index < 100)
+                    {
+                      sum[j] += 100.0 - (grid->log_array[index] * 10.0);
+                      hit[j] = NVTrue;
+                    }
+                }
+            }
+        }
+
+
+      for (NV_INT32 j = min_col ; j <= max_col ; j++)
+        {
+          if (hit[j]) weight[i][j] = qMin (NINT (sum[j]), 100);
+        }
+
+
+      mutex.lock ();
+      rows_done++;
+      mutex.unlock ();
+    }
+
+
+  free (band);
+  free (sum);
+  free (hit);
+}
@@ -0,0 +1,44 @@
+#ifndef WEIGHTTHREAD_H
+#define WEIGHTTHREAD_H
+
+
+#include "pfmBagDef.hpp"
+
+
+class weightThread:public QThread
+{
+  Q_OBJECT 
+
+
+public:
+
+  weightThread (QObject *parent = 0);
+  ~weightThread ();
+
+  void weight (WEIGHT_GRID *wg = NULL, WEIGHT_FEATURE *wf = NULL, NV_INT32 count = 0, NV_U_BYTE **w = NULL, NV_INT32 sr = 0,
+               NV_INT32 er = -1);
+  NV_INT32 rowsDone ();
+
+
+protected:
+
+
+  QMutex           mutex;
+
+  WEIGHT_GRID      *l_grid;
+
+  WEIGHT_FEATURE   *l_features;
+
+  NV_INT32         l_count, l_start_row, l_end_row, rows_done;
+
+  NV_U_BYTE        **l_weight;
+
+  void             run ();
+
+
+protected slots:
+
+private:
+};
+
+#endif
@@ -39,7 +39,11 @@
 #include "externalFilter.hpp"
 
 
-//!  This is used to run an external filter program.  At present we only use it for the hofWaveFilter.
+/*!
+  This is used to run an external filter program.  At present we only use it for the hofWaveFilter.  If there is an
+  in-process plugin version of the filter (e.g. libhofWaveFilterPlugin.so, see PFM_FILTER_PLUGIN_ARGS in ABE.h) we call
+  it directly with the point cloud instead of starting the program and passing the data through shared memory.
+*/
 
 externalFilter::externalFilter (QWidget *parent, nvMapGL *ma, OPTIONS *op, MISC *mi, NV_INT32 prog, NV_BOOL *failed):
   QProcess (parent)
@@ -61,6 +65,46 @@ externalFilter::externalFilter (QWidget *parent, nvMapGL *ma, OPTIONS *op, MISC
   qApp->processEvents();
 
 
+  plugin_thread = NULL;
+  plugin_args.kill = NULL;
+
+  PFM_FILTER_PLUGIN_FUNC plugin_func = loadPlugin (options->name[prog]);
+
+  if (plugin_func != NULL)
+    {
+      plugin_args.version = PFM_FILTER_PLUGIN_VERSION;
+      plugin_args.abe_share = misc->abe_share;
+      plugin_args.data = misc->data;
+      plugin_args.count = misc->abe_share->point_cloud_count;
+
+      //  Don't pass our PFM handles.  If the plugin was linked against a static libpfm it has its own handle tables and
+      //  our handles mean nothing to it so we let it open the PFM files itself.
+
+      plugin_args.pfm_handle = NULL;
+      plugin_args.kill_count = 0;
+      plugin_args.error[0] = 0;
+
+      plugin_args.kill = (NV_BOOL *) calloc (plugin_args.count + 1, sizeof (NV_BOOL));
+
+      if (plugin_args.kill == NULL)
+        {
+          perror ("Allocating plugin_args.kill memory in externalFilter.cpp");
+          exit (-1);
+        }
+
+
+      //  We keep the point cloud shared memory locked since we're the only ones using it.
+
+      plugin_thread = new pluginThread (this);
+
+      connect (plugin_thread, SIGNAL (finished ()), this, SLOT (slotPluginDone ()));
+
+      plugin_thread->prepare (plugin_func, &plugin_args);
+
+      return;
+    }
+
+
   QString progString = options->prog[prog];
 
   QString actionString = options->action[prog];
@@ -87,6 +131,30 @@ externalFilter::~externalFilter ()
 
 
 
+//!  Look for the plugin version of the filter program in the library path, next to the executable, and in ../lib.
+
+PFM_FILTER_PLUGIN_FUNC 
+externalFilter::loadPlugin (QString name)
+{
+  QString libName = name + "Plugin";
+
+  QStringList paths;
+  paths += libName;
+  paths += QCoreApplication::applicationDirPath () + "/" + libName;
+  paths += QCoreApplication::applicationDirPath () + "/../lib/" + libName;
+
+  for (NV_INT32 i = 0 ; i < paths.size () ; i++)
+    {
+      library.setFileName (paths.at (i));
+
+      if (library.load ()) return ((PFM_FILTER_PLUGIN_FUNC) library.resolve (PFM_FILTER_PLUGIN_ENTRY));
+    }
+
+  return (NULL);
+}
+
+
+
 void 
 externalFilter::slotError (QProcess::ProcessError error)
 {
@@ -190,6 +258,55 @@ externalFilter::slotDone (int exitCode __attribute__ ((unused)), QProcess::ExitS
 
 
 
+void 
+externalFilter::slotPluginDone ()
+{
+  if (plugin_thread->status ())
+    {
+      QMessageBox::critical (pa, tr ("pfmEdit3D filter plugin"), tr ("The filter plugin failed!") + "\n" + QString (plugin_args.error));
+    }
+  else if (plugin_args.kill_count)
+    {
+      misc->filter_kill_list = (NV_INT32 *) realloc (misc->filter_kill_list, (misc->filter_kill_count + plugin_args.kill_count) *
+                                                     sizeof (NV_INT32));
+
+      if (misc->filter_kill_list == NULL)
+        {
+          perror ("Allocating misc->filter_kill_list memory in externalFilter.cpp");
+          exit (-1);
+        }
+
+      for (NV_INT32 i = 0 ; i < plugin_args.count ; i++)
+        {
+          if (plugin_args.kill[i] && !misc->data[i].mask)
+            {
+              misc->filter_kill_list[misc->filter_kill_count] = i;
+              misc->filter_kill_count++;
+            }
+        }
+    }
+
+  free (plugin_args.kill);
+  plugin_args.kill = NULL;
+
+
+  //  Force a redraw of the waveMonitor just in case.
+
+  misc->abe_share->modcode = WAVEMONITOR_FORCE_REDRAW;
+
+
+  misc->statusProgLabel->setVisible (TRUE);
+  misc->statusProg->setRange (0, 100);
+  misc->statusProg->reset ();
+  misc->statusProg->setTextVisible (TRUE);
+  qApp->processEvents();
+
+
+  emit externalFilterDone ();
+}
+
+
+
 void 
 externalFilter::slotReadyReadStandardError ()
 {
@@ -41,6 +41,7 @@
 
 #include "pfmEdit3DDef.hpp"
 #include "sharedFile.h"
+#include "pluginThread.hpp"
 
 
 class externalFilter:public QProcess
@@ -74,6 +75,15 @@ protected:
 
   QWidget         *pa;
 
+  QLibrary        library;
+
+  pluginThread    *plugin_thread;
+
+  PFM_FILTER_PLUGIN_ARGS plugin_args;
+
+
+  PFM_FILTER_PLUGIN_FUNC loadPlugin (QString name);
+
 
 protected slots:
 
@@ -81,6 +91,7 @@ protected slots:
   void slotError (QProcess::ProcessError error);
   void slotReadyReadStandardError ();
   void slotReadyReadStandardOutput ();
+  void slotPluginDone ();
 
 
 private:
@@ -37,6 +37,7 @@
 
 
 #include "pfmEdit3D.hpp"
+#include "filterThread.hpp"
 
 
 typedef struct
@@ -66,7 +67,8 @@ typedef struct
 } FEATURE_RECORD;
 
 
-static BIN_DEPTH      **bin_depth;
+static BIN_DEPTH      **bin_depth = NULL;
+static REC_VAL        *rec_val = NULL;
 NV_F64_XYMBR          bounds;
 static FEATURE_RECORD *feature = NULL;
 static NV_INT32       feature_count = 0;
@@ -156,6 +158,29 @@ void compute_bin_values (BIN_DEPTH *bin_depth, MISC *misc)
  
 *********************************************************************/
 
+//!  Free the bins and the point array used by the filter.
+
+static void freeAreaFilter (NV_INT32 height)
+{
+  if (bin_depth != NULL)
+    {
+      for (NV_INT32 i = 0 ; i < height ; i++)
+        {
+          if (bin_depth[i] != NULL) free (bin_depth[i]);
+        }
+      free (bin_depth);
+      bin_depth = NULL;
+    }
+
+  if (rec_val != NULL)
+    {
+      free (rec_val);
+      rec_val = NULL;
+    }
+}
+
+
+
 NV_BOOL InitializeAreaFilter (NV_INT32 width, NV_INT32 height, MISC *misc)
 {
   //  Allocate the memory for all of the bins.
@@ -174,14 +199,25 @@ NV_BOOL InitializeAreaFilter (NV_INT32 width, NV_INT32 height, MISC *misc)
 
       if (bin_depth[i] == NULL)
         {
-          free (bin_depth);
+          freeAreaFilter (height);
           QMessageBox::critical (0, pfmEdit3D::tr ("pfmEdit3D filter"), pfmEdit3D::tr ("Unable to allocate memory for filtering!"));
           return (NVFalse);
         }
     }
 
 
-  //  Populate all of the bins with depth data.
+  //  We're going to put all of the points into a single array sorted by bin (a counting sort).  The first pass counts the
+  //  points in each bin, the second pass drops each point into its bin's slot in the array.  This beats the hell out of
+  //  reallocating every bin's record list for every point.
+
+  NV_INT32 *bin_index = (NV_INT32 *) malloc (misc->abe_share->point_cloud_count * sizeof (NV_INT32));
+
+  if (bin_index == NULL && misc->abe_share->point_cloud_count)
+    {
+      freeAreaFilter (height);
+      QMessageBox::critical (0, pfmEdit3D::tr ("pfmEdit3D filter"), pfmEdit3D::tr ("Unable to allocate memory for filtering!"));
+      return (NVFalse);
+    }
 
   for (NV_INT32 i = 0 ; i < misc->abe_share->point_cloud_count ; i++)
     {
@@ -193,51 +229,78 @@ NV_BOOL InitializeAreaFilter (NV_INT32 width, NV_INT32 height, MISC *misc)
 
       if (row < 0 || col < 0)
         {
-          for (NV_INT32 j = 0 ; j < height ; j++)
-            {
-              if (bin_depth[j] != NULL) 
-                {
-                  for (NV_INT32 k = 0 ; k < width ; k++)
-                    {
-                      if (bin_depth[j][k].rv) free (bin_depth[j][k].rv);
-                    }
-                  free (bin_depth[j]);
-                }
-            }
+          free (bin_index);
+          freeAreaFilter (height);
           return (NVFalse);
         }
 
-      NV_INT32 recnum = bin_depth[row][col].num_soundings;
 
-      bin_depth[row][col].rv = (REC_VAL *) realloc (bin_depth[row][col].rv, (recnum + 1) * sizeof (REC_VAL));
+      //  Points outside of the bin array can't affect the filter so we just skip them.
 
+      if (row >= height || col >= width)
+        {
+          bin_index[i] = -1;
+        }
+      else
+        {
+          bin_index[i] = row * width + col;
+          bin_depth[row][col].num_soundings++;
+        }
+    }
 
-      //  Make sure we allocated the memory.
 
-      if (bin_depth[row][col].rv == NULL)
-        {
-          for (NV_INT32 j = 0 ; j < height ; j++)
-            {
-              if (bin_depth[j] != NULL) 
-                {
-                  for (NV_INT32 k = 0 ; k < width ; k++)
-                    {
-                      if (bin_depth[j][k].rv) free (bin_depth[j][k].rv);
-                    }
-                  free (bin_depth[j]);
-                }
-            }
+  NV_INT32 total = 0;
 
-          QMessageBox::critical (0, pfmEdit3D::tr ("pfmEdit3D filter"), pfmEdit3D::tr ("Unable to allocate memory for filtering!"));
-          return (NVFalse);
+  for (NV_INT32 i = 0 ; i < height ; i++)
+    {
+      for (NV_INT32 j = 0 ; j < width ; j++) total += bin_depth[i][j].num_soundings;
+    }
+
+
+  rec_val = (REC_VAL *) malloc ((total ? total : 1) * sizeof (REC_VAL));
+
+  if (rec_val == NULL)
+    {
+      free (bin_index);
+      freeAreaFilter (height);
+      QMessageBox::critical (0, pfmEdit3D::tr ("pfmEdit3D filter"), pfmEdit3D::tr ("Unable to allocate memory for filtering!"));
+      return (NVFalse);
+    }
+
+
+  //  Point each bin at its slot in the array.  We reuse num_soundings as the fill index in the second pass.
+
+  NV_INT32 offset = 0;
+
+  for (NV_INT32 i = 0 ; i < height ; i++)
+    {
+      for (NV_INT32 j = 0 ; j < width ; j++)
+        {
+          bin_depth[i][j].rv = &rec_val[offset];
+          offset += bin_depth[i][j].num_soundings;
+          bin_depth[i][j].num_soundings = 0;
         }
+    }
 
-      bin_depth[row][col].rv[recnum].val = misc->data[i].val;
-      bin_depth[row][col].rv[recnum].rec = i;
 
-      bin_depth[row][col].num_soundings++;
+  //  Populate all of the bins with depth data (in point order so the results match the old per bin lists).
+
+  for (NV_INT32 i = 0 ; i < misc->abe_share->point_cloud_count ; i++)
+    {
+      if (bin_index[i] < 0) continue;
+
+      BIN_DEPTH *bin = &bin_depth[bin_index[i] / width][bin_index[i] % width];
+
+      NV_INT32 recnum = bin->num_soundings;
+
+      bin->rv[recnum].val = misc->data[i].val;
+      bin->rv[recnum].rec = i;
+
+      bin->num_soundings++;
     }
 
+  free (bin_index);
+
 
   //  Now compute the average and standard deviation for the bin.
 
@@ -265,6 +328,7 @@ NV_BOOL InitializeAreaFilter (NV_INT32 width, NV_INT32 height, MISC *misc)
                    - pfm          = PFM layer number
                    - coord        = current cell coordinate that we are processing.
                    - bin_diagonal = diagonal distance between bins in meters
+                   - wave         = shared filter thread state (points to be invalidated go in this row's kill list)
  
  - Method :        If the slope is low (< 1 degree) we'll use an average of the cell standard
                    deviations to beat the depths against.  Otherwise, we'll compute the
@@ -283,7 +347,8 @@ NV_BOOL InitializeAreaFilter (NV_INT32 width, NV_INT32 height, MISC *misc)
 
 ********************************************************************/
 
-NV_BOOL AreaFilter (OPTIONS *options, MISC *misc, NV_FLOAT64 bin_diagonal, NV_INT32 row, NV_INT32 col, NV_FLOAT64 *mx, NV_FLOAT64 *my, NV_INT32 poly_count)
+NV_BOOL AreaFilter (OPTIONS *options, MISC *misc, NV_FLOAT64 bin_diagonal, NV_INT32 row, NV_INT32 col, NV_FLOAT64 *mx, NV_FLOAT64 *my, NV_INT32 poly_count,
+                    FILTER_WAVE *wave)
 {
   //  If the center cell has no valid data, return.
 
@@ -444,16 +509,22 @@ NV_BOOL AreaFilter (OPTIONS *options, MISC *misc, NV_FLOAT64 bin_diagonal, NV_IN
 
                           if (filter_it)
                             {
-                              misc->filter_kill_list = (NV_INT32 *) realloc (misc->filter_kill_list, (misc->filter_kill_count + 1) * sizeof (NV_INT32));
+                              //  Each row has its own kill list so the threads don't have to fight over it.
 
-                              if (misc->filter_kill_list == NULL)
+                              if (wave->kill_count[row] == wave->kill_size[row])
                                 {
-                                  perror ("Allocating misc->filter_kill_list memory in filter.cpp");
-                                  exit (-1);
+                                  wave->kill_size[row] = qMax (wave->kill_size[row] * 2, 1024);
+                                  wave->kill_list[row] = (NV_INT32 *) realloc (wave->kill_list[row], wave->kill_size[row] * sizeof (NV_INT32));
+
+                                  if (wave->kill_list[row] == NULL)
+                                    {
+                                      perror ("Allocating wave->kill_list memory in filter.cpp");
+                                      exit (-1);
+                                    }
                                 }
 
-                              misc->filter_kill_list[misc->filter_kill_count] = bin_depth[row][col].rv[i].rec;
-                              misc->filter_kill_count++;
+                              wave->kill_list[row][wave->kill_count[row]] = bin_depth[row][col].rv[i].rec;
+                              wave->kill_count[row]++;
                             }
                         }
                     }
@@ -608,65 +679,142 @@ NV_BOOL filterPolyArea (OPTIONS *options, MISC *misc, NV_FLOAT64 *mx, NV_FLOAT64
   qApp->processEvents();
 
 
-  //  Note that we're not filtering the edge cells since we won't have surrounding data.
+  //  Set up the shared state for the filter threads.  Row 0 is an edge row that never gets filtered so we mark it done.
+
+  FILTER_WAVE wave;
+
+  wave.width = width;
+  wave.height = height;
+  wave.rows_done = 0;
+  wave.cancel = NVFalse;
+  wave.progress = (NV_INT32 *) calloc (height, sizeof (NV_INT32));
+  wave.kill_list = (NV_INT32 **) calloc (height, sizeof (NV_INT32 *));
+  wave.kill_count = (NV_INT32 *) calloc (height, sizeof (NV_INT32));
+  wave.kill_size = (NV_INT32 *) calloc (height, sizeof (NV_INT32));
+
+  if (wave.progress == NULL || wave.kill_list == NULL || wave.kill_count == NULL || wave.kill_size == NULL)
+    {
+      perror ("Allocating filter thread memory in filter.cpp");
+      exit (-1);
+    }
+
+  for (NV_INT32 i = 0 ; i < height ; i++) wave.progress[i] = 1;
+  wave.progress[0] = width - 1;
+
+
+  //  Note that we're not filtering the edge cells since we won't have surrounding data.  Each thread takes every
+  //  num_threads'th row starting at row 1 + thread number.
+
+  NV_INT32 num_threads = qMin (qMax (QThread::idealThreadCount (), 1), MAX_FILTER_THREADS);
+  num_threads = qMax (qMin (num_threads, height - 2), 1);
+
+  filterThread *filter_thread = new filterThread[num_threads];
+
+  for (NV_INT32 i = 0 ; i < num_threads ; i++)
+    filter_thread[i].prepare (options, misc, &wave, bin_diagonal, mx, my, count, i + 1, num_threads);
 
-  for (NV_INT32 i = 1 ; i < height - 1 ; i++)
+
+  //  Wait for the threads to finish while updating the progress bar and checking the event queue to see if the user
+  //  wants to interrupt the filter.
+
+  NV_BOOL canceled = NVFalse;
+  NV_INT32 rows = qMax (height - 2, 0);
+
+  while (NVTrue)
     {
-      misc->statusProg->setValue (i);
+      wave.mutex.lock ();
+      NV_INT32 rows_done = wave.rows_done;
+      wave.mutex.unlock ();
+
+      misc->statusProg->setValue (rows_done + 1);
 
+      if (rows_done >= rows) break;
 
-      for (NV_INT32 j = 1 ; j < width - 1 ; j++)
+
+      if (qApp->hasPendingEvents ())
         {
-          AreaFilter (options, misc, bin_diagonal, i, j, mx, my, count);
+          qApp->processEvents();
+          if (misc->drawing_canceled)
+            {
+              wave.mutex.lock ();
+              wave.cancel = NVTrue;
+              wave.progress_changed.wakeAll ();
+              wave.mutex.unlock ();
+
+              canceled = NVTrue;
+              break;
+            }
         }
 
+#ifdef NVWIN3X
+      Sleep (10);
+#else
+      usleep (10000);
+#endif
+    }
+
+
+  for (NV_INT32 i = 0 ; i < num_threads ; i++) filter_thread[i].wait ();
 
-      //  Check the event queue to see if the user wants to interrupt the filter.  Only 
-      //  check every 10th row so it doesn't slow things down too much.  */
+  delete[] filter_thread;
+
+
+  //  Put the kill lists together in row order.  This gives us the same list that we would get filtering one row at a time.
+
+  if (!canceled)
+    {
+      NV_INT32 total = misc->filter_kill_count;
+      for (NV_INT32 i = 0 ; i < height ; i++) total += wave.kill_count[i];
 
-      if (!(i % 10))
+      if (total > misc->filter_kill_count)
         {
-          if (qApp->hasPendingEvents ())
+          misc->filter_kill_list = (NV_INT32 *) realloc (misc->filter_kill_list, total * sizeof (NV_INT32));
+
+          if (misc->filter_kill_list == NULL)
+            {
+              perror ("Allocating misc->filter_kill_list memory in filter.cpp");
+              exit (-1);
+            }
+
+          for (NV_INT32 i = 0 ; i < height ; i++)
             {
-              qApp->processEvents();
-              if (misc->drawing_canceled)
+              if (wave.kill_count[i])
                 {
-                  misc->filter_kill_count = 0;
-                  misc->statusProg->reset ();
-                  misc->statusProg->setRange (0, 100);
-                  misc->statusProg->setValue (0);
-                  misc->statusProgLabel->setVisible (FALSE);
-                  misc->statusProg->setTextVisible (FALSE);
-                  misc->drawing_canceled = NVFalse;
-                  qApp->processEvents();
-                  return (NVFalse);
+                  memcpy (&misc->filter_kill_list[misc->filter_kill_count], wave.kill_list[i], wave.kill_count[i] * sizeof (NV_INT32));
+                  misc->filter_kill_count += wave.kill_count[i];
                 }
             }
         }
     }
 
+
+  for (NV_INT32 i = 0 ; i < height ; i++)
+    {
+      if (wave.kill_list[i] != NULL) free (wave.kill_list[i]);
+    }
+
+  free (wave.kill_list);
+  free (wave.kill_count);
+  free (wave.kill_size);
+  free (wave.progress);
+
+
+  if (canceled) misc->filter_kill_count = 0;
+
   misc->statusProg->reset ();
   misc->statusProg->setRange (0, 100);
   misc->statusProg->setValue (0);
   misc->statusProgLabel->setVisible (FALSE);
   misc->statusProg->setTextVisible (FALSE);
 
+  if (canceled) misc->drawing_canceled = NVFalse;
+
   qApp->processEvents();
 
 
   //  Free the memory used by the filter.
 
-  for (NV_INT32 i = 0 ; i < height ; i++)
-    {
-      if (bin_depth[i] != NULL) 
-        {
-          for (NV_INT32 j = 0 ; j < width ; j++)
-            {
-              if (bin_depth[i][j].rv) free (bin_depth[i][j].rv);
-            }
-          free (bin_depth[i]);
-        }
-    }
+  freeAreaFilter (height);
 
 
   //  Free the feature memory (if any)
@@ -679,5 +827,5 @@ NV_BOOL filterPolyArea (OPTIONS *options, MISC *misc, NV_FLOAT64 *mx, NV_FLOAT64
     }
 
 
-  return (NVTrue);
+  return (!canceled);
 }
@@ -0,0 +1,98 @@
+#include "filterThread.hpp"
+
+
+filterThread::filterThread (QObject *parent)
+  : QThread(parent)
+{
+}
+
+
+
+filterThread::~filterThread ()
+{
+}
+
+
+
+void filterThread::prepare (OPTIONS *op, MISC *mi, FILTER_WAVE *fw, NV_FLOAT64 bd, NV_FLOAT64 *x, NV_FLOAT64 *y, NV_INT32 pc,
+                            NV_INT32 fr, NV_INT32 nt)
+{
+  QMutexLocker locker (&mutex);
+
+  l_options = op;
+  l_misc = mi;
+  l_wave = fw;
+  l_bin_diagonal = bd;
+  l_mx = x;
+  l_my = y;
+  l_poly_count = pc;
+  l_first_row = fr;
+  l_num_threads = nt;
+
+  if (!isRunning ()) start ();
+}
+
+
+
+void filterThread::run ()
+{
+  NV_BOOL AreaFilter (OPTIONS *options, MISC *misc, NV_FLOAT64 bin_diagonal, NV_INT32 row, NV_INT32 col, NV_FLOAT64 *mx,
+                      NV_FLOAT64 *my, NV_INT32 poly_count, FILTER_WAVE *wave);
+
+
+  NV_INT32 width = l_wave->width;
+  NV_INT32 height = l_wave->height;
+
+
+  //  Note that we're not filtering the edge cells since we won't have surrounding data.
+
+  for (NV_INT32 row = l_first_row ; row < height - 1 ; row += l_num_threads)
+    {
+      //  Nothing to filter if the area is only two bins wide.
+
+      if (width < 3)
+        {
+          l_wave->mutex.lock ();
+          l_wave->progress[row] = width - 1;
+          l_wave->rows_done++;
+          l_wave->progress_changed.wakeAll ();
+          l_wave->mutex.unlock ();
+          continue;
+        }
+
+
+      for (NV_INT32 start_col = 1 ; start_col < width - 1 ; start_col += FILTER_CHUNK)
+        {
+          NV_INT32 end_col = qMin (start_col + FILTER_CHUNK, width - 1);
+
+
+          //  Wait for the row below to get past the bin to the upper right of the last bin in this chunk.
+
+          NV_INT32 need = qMin (end_col + 1, width - 1);
+
+          l_wave->mutex.lock ();
+
+          while (!l_wave->cancel && l_wave->progress[row - 1] < need) l_wave->progress_changed.wait (&l_wave->mutex);
+
+          NV_BOOL cancel = l_wave->cancel;
+
+          l_wave->mutex.unlock ();
+
+          if (cancel) return;
+
+
+          for (NV_INT32 col = start_col ; col < end_col ; col++)
+            AreaFilter (l_options, l_misc, l_bin_diagonal, row, col, l_mx, l_my, l_poly_count, l_wave);
+
+
+          l_wave->mutex.lock ();
+
+          l_wave->progress[row] = end_col;
+          if (end_col == width - 1) l_wave->rows_done++;
+
+          l_wave->progress_changed.wakeAll ();
+
+          l_wave->mutex.unlock ();
+        }
+    }
+}
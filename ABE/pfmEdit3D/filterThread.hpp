@@ -0,0 +1,45 @@
+#ifndef FILTERTHREAD_H
+#define FILTERTHREAD_H
+
+
+#include "pfmEdit3DDef.hpp"
+
+
+class filterThread:public QThread
+{
+  Q_OBJECT 
+
+
+public:
+
+  filterThread (QObject *parent = 0);
+  ~filterThread ();
+
+  void prepare (OPTIONS *op = NULL, MISC *mi = NULL, FILTER_WAVE *fw = NULL, NV_FLOAT64 bd = 0.0, NV_FLOAT64 *x = NULL,
+                NV_FLOAT64 *y = NULL, NV_INT32 pc = 0, NV_INT32 fr = 0, NV_INT32 nt = 1);
+
+
+protected:
+
+
+  QMutex           mutex;
+
+  OPTIONS          *l_options;
+
+  MISC             *l_misc;
+
+  FILTER_WAVE      *l_wave;
+
+  NV_FLOAT64       l_bin_diagonal, *l_mx, *l_my;
+
+  NV_INT32         l_poly_count, l_first_row, l_num_threads;
+
+  void             run ();
+
+
+protected slots:
+
+private:
+};
+
+#endif
@@ -106,6 +106,13 @@ void get_buffer (MISC *misc, OPTIONS *options)
   NV_INT32 point_count = 0;
   memset (data_type_lut, 0, MAX_PFM_FILES * PFM_MAX_FILES * sizeof (NV_INT16));
 
+
+  //  Area polygons can have thousands of vertices and we test every point against them so we prepare the polygon once.
+
+  PREPARED_POLYGON *area_poly = NULL;
+  if (misc->abe_share->polygon_count)
+    area_poly = prepare_polygon2 (misc->abe_share->polygon_x, misc->abe_share->polygon_y, misc->abe_share->polygon_count);
+
   for (NV_INT32 pfm = misc->abe_share->pfm_count - 1 ; pfm >= 0 ; pfm--)
     {
       //  File types.
@@ -223,10 +230,8 @@ void get_buffer (MISC *misc, OPTIONS *options)
                         misc->abe_share->open_args[pfm].head.x_bin_size_degrees;
                       NV_FLOAT64 elon = wlon + misc->abe_share->open_args[pfm].head.x_bin_size_degrees;
 
-                      if (inside_polygon2 (misc->abe_share->polygon_x, misc->abe_share->polygon_y, misc->abe_share->polygon_count, wlon, slat) ||
-                          inside_polygon2 (misc->abe_share->polygon_x, misc->abe_share->polygon_y, misc->abe_share->polygon_count, wlon, nlat) ||
-                          inside_polygon2 (misc->abe_share->polygon_x, misc->abe_share->polygon_y, misc->abe_share->polygon_count, elon, nlat) ||
-                          inside_polygon2 (misc->abe_share->polygon_x, misc->abe_share->polygon_y, misc->abe_share->polygon_count, elon, slat))
+                      if (inside_prepared_polygon (area_poly, wlon, slat) || inside_prepared_polygon (area_poly, wlon, nlat) ||
+                          inside_prepared_polygon (area_poly, elon, nlat) || inside_prepared_polygon (area_poly, elon, slat))
                         {
                           point_count += row[j].num_soundings;
                         }
@@ -276,18 +281,65 @@ void get_buffer (MISC *misc, OPTIONS *options)
   misc->dataShare->lock ();
 
 
+  //  Attach the persistent point cache (if pfmView created one).  Bins that were loaded by a previous edit session
+  //  and haven't changed since then will be pulled from the cache instead of being read from the PFM file.
+
+  open_point_cache (misc);
+
+
   //  Now we have to load the points that are inside our area of interest.
 
   for (NV_INT32 pfm = misc->abe_share->pfm_count - 1 ; pfm >= 0 ; pfm--)
     {
+      NV_INT32 row_width = (misc->ur[pfm].x - misc->ll[pfm].x) + 1;
+      BIN_RECORD *row = NULL;
+
+      if (misc->cache != NULL && row_width > 0)
+        {
+          row = (BIN_RECORD *) calloc (row_width, sizeof (BIN_RECORD));
+          if (row == NULL)
+            {
+              perror (pfmEdit3D::tr ("Allocating row in get_buffer").toAscii ());
+              exit (-1);
+            }
+        }
+
       for (NV_INT32 i = misc->ll[pfm].y ; i <= misc->ur[pfm].y ; i++)
         {
           coord.y = i;
+
+          if (row != NULL) read_bin_row (misc->pfm_handle[pfm], row_width, i, misc->ll[pfm].x, row);
+
           for (NV_INT32 j = misc->ll[pfm].x ; j <= misc->ur[pfm].x ; j++)
             {
               coord.x = j;
 
-              if (!read_depth_array_index (misc->pfm_handle[pfm], coord, &depth, &recnum))
+              NV_INT32 status = 0;
+
+              if (row != NULL)
+                {
+                  BIN_RECORD *bin = &row[j - misc->ll[pfm].x];
+
+                  if (!bin->num_soundings) continue;
+
+                  NV_INT32 index = find_cached_bin (misc, pfm, coord, bin);
+
+                  if (index >= 0)
+                    {
+                      recnum = read_cached_bin (misc, index, &depth);
+                    }
+                  else
+                    {
+                      status = read_depth_array_index (misc->pfm_handle[pfm], coord, &depth, &recnum);
+                      if (!status) add_cached_bin (misc, pfm, coord, bin, depth, recnum);
+                    }
+                }
+              else
+                {
+                  status = read_depth_array_index (misc->pfm_handle[pfm], coord, &depth, &recnum);
+                }
+
+              if (!status)
                 {
                   for (NV_INT32 k = 0 ; k < recnum ; k++)
                     {
@@ -301,8 +353,7 @@ void get_buffer (MISC *misc, OPTIONS *options)
                           NV_BOOL in = NVFalse;
                           if (misc->abe_share->polygon_count)
                             {
-                              if (inside_polygon2 (misc->abe_share->polygon_x, misc->abe_share->polygon_y, misc->abe_share->polygon_count,
-                                                   depth[k].xyz.x, depth[k].xyz.y)) in = NVTrue;
+                              if (inside_prepared_polygon (area_poly, depth[k].xyz.x, depth[k].xyz.y)) in = NVTrue;
                             }
                           else
                             {
@@ -394,8 +445,12 @@ void get_buffer (MISC *misc, OPTIONS *options)
                 }
             }
         }
+
+      if (row != NULL) free (row);
     }
 
+  free_prepared_polygon (area_poly);
+
 
   if (misc->line_count == 1)
     {
@@ -6476,6 +6476,41 @@ pfmEdit3D::slotResize (QResizeEvent *e __attribute__ ((unused)))
 
 
 
+//!  Allocate room for size points in the arrays that redrawMap loads into nvMapGL.
+
+static void size_points (POINT_ARRAYS *points, NV_INT32 size)
+{
+  points->size = size;
+
+  points->x = (NV_FLOAT64 *) realloc (points->x, sizeof (NV_FLOAT64) * points->size);
+  points->y = (NV_FLOAT64 *) realloc (points->y, sizeof (NV_FLOAT64) * points->size);
+  points->z = (NV_FLOAT32 *) realloc (points->z, sizeof (NV_FLOAT32) * points->size);
+  points->color = (NV_U_BYTE *) realloc (points->color, points->size * 4);
+
+  if (points->x == NULL || points->y == NULL || points->z == NULL || points->color == NULL)
+    {
+      perror ("Allocating point arrays");
+      exit (-1);
+    }
+}
+
+
+
+//!  Add a point to the arrays that redrawMap loads into nvMapGL.
+
+static void add_point (POINT_ARRAYS *points, NV_FLOAT64 x, NV_FLOAT64 y, NV_FLOAT32 z, NV_U_BYTE *color)
+{
+  if (points->count == points->size) size_points (points, qMax (points->size * 2, 1024));
+
+  points->x[points->count] = x;
+  points->y[points->count] = y;
+  points->z[points->count] = z;
+  memcpy (&points->color[points->count * 4], color, 4);
+  points->count++;
+}
+
+
+
 //!  This is where we load all of our data in to OpenGL display lists (in nvMapGL.cpp).
 
 void
@@ -6737,6 +6772,16 @@ pfmEdit3D::redrawMap (NV_BOOL redraw2D)
         setFlags (&misc, &options);
 
 
+      //  We build arrays of the points to be displayed and hand them to nvMapGL all at once.  The full set can't
+      //  be bigger than the point cloud so we allocate that up front.  The sparse set will grow as needed.
+
+      POINT_ARRAYS data_points, sparse_points;
+      memset (&data_points, 0, sizeof (POINT_ARRAYS));
+      memset (&sparse_points, 0, sizeof (POINT_ARRAYS));
+
+      size_points (&data_points, qMax (misc.abe_share->point_cloud_count, 1));
+
+
       for (NV_INT32 i = 0 ; i < misc.abe_share->point_cloud_count ; i++)
         {
           //  Check for single line display.
@@ -6861,7 +6906,7 @@ pfmEdit3D::redrawMap (NV_BOOL redraw2D)
                       //  If we are slicing and we need sparse data for rotation and zoom, only display sparse points
                       //  outside of the slice.  If we aren't slicing, display them all.
 
-                      if (!misc.slice || !trans) map->setDataPoints (misc.data[i].x, misc.data[i].y, -z_value, tmp, 0, NVFalse);
+                      if (!misc.slice || !trans) add_point (&data_points, misc.data[i].x, misc.data[i].y, -z_value, tmp);
 
 
                       //  Get the min and max displayed Z values for each bin.
@@ -6870,24 +6915,24 @@ pfmEdit3D::redrawMap (NV_BOOL redraw2D)
                         {
                           if (min_z_index >= 0)
                             {
-                              map->setSparsePoints (misc.data[min_z_index].x, misc.data[min_z_index].y, -misc.data[min_z_index].z, save_min, 0, NVFalse);
+                              add_point (&sparse_points, misc.data[min_z_index].x, misc.data[min_z_index].y, -misc.data[min_z_index].z, save_min);
 
 
                               //  If we're slicing and we need sparse data for zoom and rotate, only load points inside the slice.
 
-                              if (misc.slice && trans) map->setDataPoints (misc.data[min_z_index].x, misc.data[min_z_index].y, -misc.data[min_z_index].z,
-                                                                           tmp, 0, NVFalse);
+                              if (misc.slice && trans) add_point (&data_points, misc.data[min_z_index].x, misc.data[min_z_index].y,
+                                                                  -misc.data[min_z_index].z, tmp);
                             }
 
                           if (max_z_index >= 0 && max_z_index != min_z_index)
                             {
-                              map->setSparsePoints (misc.data[max_z_index].x, misc.data[max_z_index].y, -misc.data[max_z_index].z, save_max, 0, NVFalse);
+                              add_point (&sparse_points, misc.data[max_z_index].x, misc.data[max_z_index].y, -misc.data[max_z_index].z, save_max);
 
 
                               //  If we're slicing and we need sparse data for zoom and rotate, only load points inside the slice.
 
-                              if (misc.slice && trans) map->setDataPoints (misc.data[max_z_index].x, misc.data[max_z_index].y, -misc.data[max_z_index].z,
-                                                                           tmp, 0, NVFalse);
+                              if (misc.slice && trans) add_point (&data_points, misc.data[max_z_index].x, misc.data[max_z_index].y,
+                                                                  -misc.data[max_z_index].z, tmp);
                             }
 
                           min_z_index = max_z_index = -1;
@@ -6921,7 +6966,7 @@ pfmEdit3D::redrawMap (NV_BOOL redraw2D)
 
                   else
                     {
-                      map->setDataPoints (misc.data[i].x, misc.data[i].y, -z_value, tmp, 0, NVFalse);
+                      add_point (&data_points, misc.data[i].x, misc.data[i].y, -z_value, tmp);
                     }
 
 
@@ -6957,24 +7002,34 @@ pfmEdit3D::redrawMap (NV_BOOL redraw2D)
         {
           if (min_z_index >= 0)
             {
-              map->setSparsePoints (misc.data[min_z_index].x, misc.data[min_z_index].y, -misc.data[min_z_index].z, save_min, 0, NVFalse);
+              add_point (&sparse_points, misc.data[min_z_index].x, misc.data[min_z_index].y, -misc.data[min_z_index].z, save_min);
 
-              if (misc.slice) map->setDataPoints (misc.data[min_z_index].x, misc.data[min_z_index].y, -misc.data[min_z_index].z, save_min, 0, NVFalse);
+              if (misc.slice) add_point (&data_points, misc.data[min_z_index].x, misc.data[min_z_index].y, -misc.data[min_z_index].z, save_min);
 
             }
 
           if (max_z_index >= 0 && max_z_index != min_z_index)
             {
-              map->setSparsePoints (misc.data[max_z_index].x, misc.data[max_z_index].y, -misc.data[max_z_index].z, save_max, 0, NVFalse);
+              add_point (&sparse_points, misc.data[max_z_index].x, misc.data[max_z_index].y, -misc.data[max_z_index].z, save_max);
 
-              if (misc.slice) map->setDataPoints (misc.data[max_z_index].x, misc.data[max_z_index].y, -misc.data[max_z_index].z, save_max, 0, NVFalse);
+              if (misc.slice) add_point (&data_points, misc.data[max_z_index].x, misc.data[max_z_index].y, -misc.data[max_z_index].z, save_max);
             }
 
-          map->setSparsePoints (0.0, 0.0, 0.0, save_min, options.point_size, NVTrue);
+          map->setSparsePoints (sparse_points.count, sparse_points.x, sparse_points.y, sparse_points.z, sparse_points.color, options.point_size);
         }
 
 
-      map->setDataPoints (0.0, 0.0, 0.0, save_min, options.point_size, NVTrue);
+      map->setDataPoints (data_points.count, data_points.x, data_points.y, data_points.z, data_points.color, options.point_size, 0);
+
+
+      free (data_points.x);
+      free (data_points.y);
+      free (data_points.z);
+      free (data_points.color);
+      free (sparse_points.x);
+      free (sparse_points.y);
+      free (sparse_points.z);
+      free (sparse_points.color);
 
 
       /*  Contours on 3D maps look a bit weird so I'm commenting this out for now.
@@ -11329,6 +11384,7 @@ pfmEdit3D::clean_exit (NV_INT32 ret)
 
   misc.dataShare->unlock ();
   misc.dataShare->detach ();
+  if (misc.cacheShare) misc.cacheShare->detach ();
   misc.abeShare->detach ();
 
 
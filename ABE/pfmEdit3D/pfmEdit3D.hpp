@@ -58,6 +58,11 @@
 
 void get_buffer (MISC *misc, OPTIONS *options);
 NV_INT32 put_buffer (MISC *misc);
+POINT_CACHE *open_point_cache (MISC *misc);
+NV_INT32 find_cached_bin (MISC *misc, NV_INT32 pfm, NV_I32_COORD2 coord, BIN_RECORD *bin);
+NV_INT32 add_cached_bin (MISC *misc, NV_INT32 pfm, NV_I32_COORD2 coord, BIN_RECORD *bin, DEPTH_RECORD *depth, NV_INT32 numrecs);
+void drop_cached_bin (MISC *misc, NV_INT32 pfm, NV_I32_COORD2 coord);
+NV_INT32 read_cached_bin (MISC *misc, NV_INT32 index, DEPTH_RECORD **depth);
 NV_INT32 pseudo_dist_from_viewer (MISC *misc, NV_FLOAT64 x, NV_FLOAT64 y);
 
 
@@ -118,6 +118,8 @@
 #define         PRE_ATTR                    4
 #define         PRE_USER                    6
 #define         MAX_SLICE_SIZE              50
+#define         MAX_FILTER_THREADS          16
+#define         FILTER_CHUNK                16
 #define         MAX_TRANS_VALUE             64
 #define         CONTOUR_POINTS              1000
 #define         NUM_HSV                     NUM_ATTR + PRE_ATTR  //!<  Possible number of scale box HSV settings 
@@ -396,6 +398,41 @@ typedef struct
 } UNDO;
 
 
+//! Point arrays that redrawMap fills before loading them into nvMapGL all at once.
+
+typedef struct
+{
+  NV_INT32    count;                      //!<  Number of points in the arrays
+  NV_INT32    size;                       //!<  Number of points allocated
+  NV_FLOAT64  *x;                         //!<  X positions
+  NV_FLOAT64  *y;                         //!<  Y positions
+  NV_FLOAT32  *z;                         //!<  Z values
+  NV_U_BYTE   *color;                     //!<  RGBA colors (4 per point)
+} POINT_ARRAYS;
+
+
+/*!
+    Shared state for the area filter threads.  Each row of bins is filtered by one thread (rows are dealt out round robin)
+    but a row can't filter a bin until the row below it has filtered the bin to its upper right and the row below can't
+    get ahead of it.  That keeps every bin seeing exactly the neighbors it would see if the rows were filtered one at a
+    time so the results are the same no matter how many threads are used.
+*/
+
+typedef struct
+{
+  QMutex      mutex;
+  QWaitCondition progress_changed;        //!<  Signaled whenever a row moves ahead (or the filter is canceled)
+  NV_INT32    width;                      //!<  Width of the bin array
+  NV_INT32    height;                     //!<  Height of the bin array
+  NV_INT32    *progress;                  //!<  Next column to be filtered in each row (width - 1 when the row is done)
+  NV_INT32    rows_done;                  //!<  Number of rows finished
+  NV_BOOL     cancel;                     //!<  Set to stop the threads
+  NV_INT32    **kill_list;                //!<  Points to be invalidated for each row (in the order the serial filter would find them)
+  NV_INT32    *kill_count;                //!<  Number of points in each row's kill list
+  NV_INT32    *kill_size;                 //!<  Allocated size of each row's kill list
+} FILTER_WAVE;
+
+
 //! General stuff.
 
 typedef struct
@@ -467,6 +504,9 @@ typedef struct
   QSharedMemory *dataShare;               //!<  Point cloud shared memory.
   POINT_CLOUD *data;                      /*!<  Pointer to POINT_CLOUD structure in point cloud shared memory.  To see what is in the 
                                                 POINT_CLOUD structure please see the ABE.h file in the nvutility library.  */
+  QSharedMemory *cacheShare;              //!<  Persistent point cache shared memory (created by pfmView).
+  POINT_CACHE *cache;                     /*!<  Pointer to the POINT_CACHE structure in point cache shared memory (NULL if the cache
+                                                isn't available).  See ABE.h in the nvutility library.  */
   NV_F64_XYMBR displayed_area;            //!<  Currently displayed area
   NEAREST_STACK nearest_stack;            //!<  Nine points nearest to the cursor
   NV_FLOAT64  x_grid_size;                //!<  X grid spacing (degrees) for contours
@@ -0,0 +1,49 @@
+#include "pluginThread.hpp"
+
+
+//!  This runs an in-process filter plugin (see PFM_FILTER_PLUGIN_ARGS in ABE.h) so that the GUI doesn't freeze.
+
+pluginThread::pluginThread (QObject *parent)
+  : QThread(parent)
+{
+  l_status = 0;
+}
+
+
+
+pluginThread::~pluginThread ()
+{
+}
+
+
+
+void pluginThread::prepare (PFM_FILTER_PLUGIN_FUNC fu, PFM_FILTER_PLUGIN_ARGS *ar)
+{
+  QMutexLocker locker (&mutex);
+
+  l_func = fu;
+  l_args = ar;
+  l_status = 0;
+
+  if (!isRunning ()) start ();
+}
+
+
+
+NV_INT32 pluginThread::status ()
+{
+  QMutexLocker locker (&mutex);
+
+  return (l_status);
+}
+
+
+
+void pluginThread::run ()
+{
+  NV_INT32 status = (*l_func) (l_args);
+
+  mutex.lock ();
+  l_status = status;
+  mutex.unlock ();
+}
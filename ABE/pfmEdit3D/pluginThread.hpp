@@ -0,0 +1,42 @@
+#ifndef PLUGINTHREAD_H
+#define PLUGINTHREAD_H
+
+
+#include "pfmEdit3DDef.hpp"
+
+
+class pluginThread:public QThread
+{
+  Q_OBJECT 
+
+
+public:
+
+  pluginThread (QObject *parent = 0);
+  ~pluginThread ();
+
+  void prepare (PFM_FILTER_PLUGIN_FUNC fu = NULL, PFM_FILTER_PLUGIN_ARGS *ar = NULL);
+
+  NV_INT32 status ();
+
+
+protected:
+
+
+  QMutex                 mutex;
+
+  PFM_FILTER_PLUGIN_FUNC l_func;
+
+  PFM_FILTER_PLUGIN_ARGS *l_args;
+
+  NV_INT32               l_status;
+
+  void                   run ();
+
+
+protected slots:
+
+private:
+};
+
+#endif
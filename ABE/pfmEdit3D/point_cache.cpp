@@ -0,0 +1,521 @@
+
+/*********************************************************************************************
+
+    This is public domain software that was developed by the U.S. Naval Oceanographic Office.
+
+    This is a work of the US Government. In accordance with 17 USC 105, copyright protection
+    is not available for any work of the US Government.
+
+    Neither the United States Government nor any employees of the United States Government,
+    makes any warranty, express or implied, without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, or assumes any liability or
+    responsibility for the accuracy, completeness, or usefulness of any information,
+    apparatus, product, or process disclosed, or represents that its use would not infringe
+    privately-owned rights. Reference herein to any specific commercial products, process,
+    or service by trade name, trademark, manufacturer, or otherwise, does not necessarily
+    constitute or imply its endorsement, recommendation, or favoring by the United States
+    Government. The views and opinions of authors expressed herein do not necessarily state
+    or reflect those of the United States Government, and shall not be used for advertising
+    or product endorsement purposes.
+
+*********************************************************************************************/
+
+
+/****************************************  IMPORTANT NOTE  **********************************
+
+    Comments in this file that start with / * ! or / / ! are being used by Doxygen to
+    document the software.  Dashes in these comment blocks are used to create bullet lists.
+    The lack of blank lines after a block of dash preceeded comments means that the next
+    block of dash preceeded comments is a new, indented bullet list.  I've tried to keep the
+    Doxygen formatting to a minimum but there are some other items (like <br> and <pre>)
+    that need to be left alone.  If you see a comment that starts with / * ! or / / ! and
+    there is something that looks a bit weird it is probably due to some arcane Doxygen
+    syntax.  Be very careful modifying blocks of Doxygen comments.
+
+*****************************************  IMPORTANT NOTE  **********************************/
+
+
+#include "pfmEdit3D.hpp"
+
+
+/*
+
+    These functions manage the persistent point cache (see POINT_CACHE in ABE.h).  The cache shared memory is created by
+    pfmView so it stays around after pfmEdit3D exits.  Only pfmEdit3D adds points to it and only one pfmEdit3D can be
+    running from a pfmView at any one time so, in keeping with the rest of ABE, we don't lock it.
+
+*/
+
+
+//  Set if we couldn't make room for a bin in this edit session (so we don't keep trying).
+
+static NV_BOOL cache_full = NVFalse;
+
+
+
+static NV_INT32 cache_hash (POINT_CACHE *cache, NV_INT32 pfm, NV_I32_COORD2 coord)
+{
+  NV_U_INT32 h = ((NV_U_INT32) coord.x * 73856093U) ^ ((NV_U_INT32) coord.y * 19349663U) ^ ((NV_U_INT32) pfm * 83492791U);
+
+  return ((NV_INT32) (h & (cache->hash_size - 1)));
+}
+
+
+
+//  Clear the cache and set the PFM files that it is built from.
+
+static void reset_point_cache (MISC *misc)
+{
+  POINT_CACHE *cache = misc->cache;
+  NV_INT32 *hash = POINT_CACHE_COLUMN (cache, NV_INT32, hash_offset);
+
+  cache->pfm_count = misc->abe_share->pfm_count;
+  for (NV_INT32 pfm = 0 ; pfm < misc->abe_share->pfm_count ; pfm++) strcpy (cache->pfm_path[pfm], misc->abe_share->open_args[pfm].list_path);
+
+  cache->num_bins = 0;
+  cache->num_points = 0;
+
+  for (NV_INT32 i = 0 ; i < cache->hash_size ; i++) hash[i] = -1;
+}
+
+
+
+//  Move the points for count points starting at from down to to in every point column.
+
+static void move_points (POINT_CACHE *cache, NV_INT32 from, NV_INT32 to, NV_INT32 count)
+{
+  memmove (&POINT_CACHE_COLUMN (cache, NV_FLOAT32, dx_offset)[to], &POINT_CACHE_COLUMN (cache, NV_FLOAT32, dx_offset)[from], count * sizeof (NV_FLOAT32));
+  memmove (&POINT_CACHE_COLUMN (cache, NV_FLOAT32, dy_offset)[to], &POINT_CACHE_COLUMN (cache, NV_FLOAT32, dy_offset)[from], count * sizeof (NV_FLOAT32));
+  memmove (&POINT_CACHE_COLUMN (cache, NV_FLOAT64, z_offset)[to], &POINT_CACHE_COLUMN (cache, NV_FLOAT64, z_offset)[from], count * sizeof (NV_FLOAT64));
+  memmove (&POINT_CACHE_COLUMN (cache, NV_FLOAT32, herr_offset)[to], &POINT_CACHE_COLUMN (cache, NV_FLOAT32, herr_offset)[from], count * sizeof (NV_FLOAT32));
+  memmove (&POINT_CACHE_COLUMN (cache, NV_FLOAT32, verr_offset)[to], &POINT_CACHE_COLUMN (cache, NV_FLOAT32, verr_offset)[from], count * sizeof (NV_FLOAT32));
+  memmove (&POINT_CACHE_COLUMN (cache, NV_U_INT32, val_offset)[to], &POINT_CACHE_COLUMN (cache, NV_U_INT32, val_offset)[from], count * sizeof (NV_U_INT32));
+  memmove (&POINT_CACHE_COLUMN (cache, NV_INT16, file_offset)[to], &POINT_CACHE_COLUMN (cache, NV_INT16, file_offset)[from], count * sizeof (NV_INT16));
+  memmove (&POINT_CACHE_COLUMN (cache, NV_INT32, line_offset)[to], &POINT_CACHE_COLUMN (cache, NV_INT32, line_offset)[from], count * sizeof (NV_INT32));
+  memmove (&POINT_CACHE_COLUMN (cache, NV_U_INT32, rec_offset)[to], &POINT_CACHE_COLUMN (cache, NV_U_INT32, rec_offset)[from], count * sizeof (NV_U_INT32));
+  memmove (&POINT_CACHE_COLUMN (cache, NV_INT32, sub_offset)[to], &POINT_CACHE_COLUMN (cache, NV_INT32, sub_offset)[from], count * sizeof (NV_INT32));
+  memmove (&POINT_CACHE_COLUMN (cache, NV_INT64, addr_offset)[to], &POINT_CACHE_COLUMN (cache, NV_INT64, addr_offset)[from], count * sizeof (NV_INT64));
+  memmove (&POINT_CACHE_COLUMN (cache, NV_U_BYTE, pos_offset)[to], &POINT_CACHE_COLUMN (cache, NV_U_BYTE, pos_offset)[from], count * sizeof (NV_U_BYTE));
+
+  for (NV_INT32 m = 0 ; m < NUM_ATTR ; m++)
+    memmove (&POINT_CACHE_COLUMN (cache, NV_FLOAT32, attr_offset[m])[to], &POINT_CACHE_COLUMN (cache, NV_FLOAT32, attr_offset[m])[from],
+             count * sizeof (NV_FLOAT32));
+}
+
+
+
+/*
+    Make room for a bin with count points.  We drop the oldest bins that were cached by earlier edit sessions (never
+    the ones that belong to the area we're editing now) until a quarter of the cache (or at least enough for this bin)
+    is free, then move the remaining bins and points down over the dropped ones and rebuild the hash table.  Freeing
+    a quarter at a time keeps us from moving everything around for every bin we add.  Returns NVFalse if we couldn't
+    make enough room.
+*/
+
+static NV_BOOL make_room (POINT_CACHE *cache, NV_INT32 count)
+{
+  POINT_CACHE_BIN *bin = POINT_CACHE_COLUMN (cache, POINT_CACHE_BIN, bin_offset);
+  NV_INT32 *hash = POINT_CACHE_COLUMN (cache, NV_INT32, hash_offset);
+
+
+  //  Bins that have already been dropped will be recovered no matter what.
+
+  NV_INT32 live_bins = 0, live_points = 0;
+
+  for (NV_INT32 i = 0 ; i < cache->num_bins ; i++)
+    {
+      if (bin[i].pfm >= 0)
+        {
+          live_bins++;
+          live_points += bin[i].count;
+        }
+    }
+
+  NV_INT32 want_bins = qMax (cache->max_bins / 4, 1);
+  NV_INT32 want_points = qMax (cache->max_points / 4, count);
+
+  for (NV_INT32 i = 0 ; i < cache->num_bins && (cache->max_bins - live_bins < want_bins || cache->max_points - live_points < want_points) ; i++)
+    {
+      if (bin[i].pfm >= 0 && bin[i].session != cache->session)
+        {
+          bin[i].pfm = -1;
+          live_bins--;
+          live_points -= bin[i].count;
+        }
+    }
+
+
+  //  Move everything down (oldest first) and rebuild the hash chains.
+
+  NV_INT32 num_bins = 0, num_points = 0;
+
+  for (NV_INT32 i = 0 ; i < cache->hash_size ; i++) hash[i] = -1;
+
+  for (NV_INT32 i = 0 ; i < cache->num_bins ; i++)
+    {
+      if (bin[i].pfm < 0) continue;
+
+      if (bin[i].start != num_points) move_points (cache, bin[i].start, num_points, bin[i].count);
+
+      bin[num_bins] = bin[i];
+      bin[num_bins].start = num_points;
+
+      NV_I32_COORD2 coord = {bin[num_bins].x, bin[num_bins].y};
+      NV_INT32 h = cache_hash (cache, bin[num_bins].pfm, coord);
+
+      bin[num_bins].next = hash[h];
+      hash[h] = num_bins;
+
+      num_points += bin[num_bins].count;
+      num_bins++;
+    }
+
+  cache->num_bins = num_bins;
+  cache->num_points = num_points;
+
+  return (cache->num_bins < cache->max_bins && cache->num_points + count <= cache->max_points);
+}
+
+
+
+/***************************************************************************/
+/*!
+
+  - Module Name:        open_point_cache
+
+  - Programmer(s):      Jan C. Depner
+
+  - Date Written:       October 2026
+
+  - Purpose:            Attach to the point cache shared memory that was
+                        created by pfmView and start a new edit session.
+                        If the PFM files have changed since the cache was
+                        built, clear it.
+
+  - Return Value:       Pointer to the POINT_CACHE or NULL if it isn't
+                        available (e.g. we were started by pfmEditShell).
+
+****************************************************************************/
+
+POINT_CACHE *open_point_cache (MISC *misc)
+{
+  if (misc->cache == NULL)
+    {
+      //  The key is the parent process ID (the one used for the main ABE shared memory area) plus "_abe_pfmCache".
+
+      QString key;
+      key.sprintf ("%d_abe_pfmCache", misc->abe_share->ppid);
+
+      misc->cacheShare = new QSharedMemory (key);
+
+      if (!misc->cacheShare->attach (QSharedMemory::ReadWrite) || misc->cacheShare->size () < (NV_INT32) sizeof (POINT_CACHE) ||
+          ((POINT_CACHE *) misc->cacheShare->data ())->max_bins <= 0)
+        {
+          delete misc->cacheShare;
+          misc->cacheShare = NULL;
+          return (NULL);
+        }
+
+      misc->cache = (POINT_CACHE *) misc->cacheShare->data ();
+    }
+
+
+  //  Make sure the cache was built from the same PFM files (in the same order) that we are editing.
+
+  NV_BOOL same = (misc->cache->pfm_count == misc->abe_share->pfm_count);
+
+  for (NV_INT32 pfm = 0 ; same && pfm < misc->abe_share->pfm_count ; pfm++)
+    {
+      if (strcmp (misc->cache->pfm_path[pfm], misc->abe_share->open_args[pfm].list_path)) same = NVFalse;
+    }
+
+  if (!same) reset_point_cache (misc);
+
+
+  misc->cache->session++;
+  cache_full = NVFalse;
+
+  return (misc->cache);
+}
+
+
+
+/***************************************************************************/
+/*!
+
+  - Module Name:        find_cached_bin
+
+  - Programmer(s):      Jan C. Depner
+
+  - Date Written:       October 2026
+
+  - Purpose:            Look for a bin in the point cache.  If the bin is
+                        there but its stamp doesn't match the current bin
+                        record (i.e. the bin was modified since it was
+                        cached) it is dropped from the cache.  Bins that
+                        are found are marked as part of this edit session
+                        so they won't be dropped to make room for others.
+
+  - Return Value:       Index of the bin in the cache or -1 if not found
+
+****************************************************************************/
+
+NV_INT32 find_cached_bin (MISC *misc, NV_INT32 pfm, NV_I32_COORD2 coord, BIN_RECORD *bin)
+{
+  POINT_CACHE *cache = misc->cache;
+
+  if (cache == NULL) return (-1);
+
+  POINT_CACHE_BIN *cache_bin = POINT_CACHE_COLUMN (cache, POINT_CACHE_BIN, bin_offset);
+  NV_INT32 *hash = POINT_CACHE_COLUMN (cache, NV_INT32, hash_offset);
+
+  for (NV_INT32 i = hash[cache_hash (cache, pfm, coord)] ; i >= 0 ; i = cache_bin[i].next)
+    {
+      POINT_CACHE_BIN *cb = &cache_bin[i];
+
+      if (cb->pfm == pfm && cb->x == coord.x && cb->y == coord.y)
+        {
+          if (cb->num_soundings == bin->num_soundings && cb->validity == bin->validity && cb->min == bin->min_filtered_depth &&
+              cb->max == bin->max_filtered_depth && cb->avg == bin->avg_filtered_depth)
+            {
+              cb->session = cache->session;
+              return (i);
+            }
+
+          cb->pfm = -1;
+          return (-1);
+        }
+    }
+
+  return (-1);
+}
+
+
+
+/***************************************************************************/
+/*!
+
+  - Module Name:        add_cached_bin
+
+  - Programmer(s):      Jan C. Depner
+
+  - Date Written:       October 2026
+
+  - Purpose:            Add the non-deleted points from a depth record
+                        array to the point cache.  If the cache is full
+                        the oldest bins from earlier edit sessions are
+                        dropped to make room.
+
+  - Return Value:       Index of the bin in the cache or -1 if the bin
+                        couldn't be cached
+
+****************************************************************************/
+
+NV_INT32 add_cached_bin (MISC *misc, NV_INT32 pfm, NV_I32_COORD2 coord, BIN_RECORD *bin, DEPTH_RECORD *depth, NV_INT32 numrecs)
+{
+  POINT_CACHE *cache = misc->cache;
+
+  if (cache == NULL || cache_full) return (-1);
+
+
+  NV_INT32 count = 0;
+  for (NV_INT32 k = 0 ; k < numrecs ; k++) if (!(depth[k].validity & PFM_DELETED)) count++;
+
+  if (count > cache->max_points) return (-1);
+
+
+  if (cache->num_bins >= cache->max_bins || cache->num_points + count > cache->max_points)
+    {
+      if (!make_room (cache, count))
+        {
+          cache_full = NVTrue;
+          return (-1);
+        }
+    }
+
+
+  POINT_CACHE_BIN *cb = &POINT_CACHE_COLUMN (cache, POINT_CACHE_BIN, bin_offset)[cache->num_bins];
+  NV_INT32 *hash = POINT_CACHE_COLUMN (cache, NV_INT32, hash_offset);
+  NV_INT32 index = cache->num_bins++;
+  NV_INT32 h = cache_hash (cache, pfm, coord);
+
+  cb->pfm = pfm;
+  cb->x = coord.x;
+  cb->y = coord.y;
+  cb->session = cache->session;
+  cb->num_soundings = bin->num_soundings;
+  cb->validity = bin->validity;
+  cb->min = bin->min_filtered_depth;
+  cb->max = bin->max_filtered_depth;
+  cb->avg = bin->avg_filtered_depth;
+  cb->start = cache->num_points;
+  cb->count = count;
+  cb->next = hash[h];
+  hash[h] = index;
+
+
+  NV_FLOAT32 *dx = POINT_CACHE_COLUMN (cache, NV_FLOAT32, dx_offset);
+  NV_FLOAT32 *dy = POINT_CACHE_COLUMN (cache, NV_FLOAT32, dy_offset);
+  NV_FLOAT64 *z = POINT_CACHE_COLUMN (cache, NV_FLOAT64, z_offset);
+  NV_FLOAT32 *herr = POINT_CACHE_COLUMN (cache, NV_FLOAT32, herr_offset);
+  NV_FLOAT32 *verr = POINT_CACHE_COLUMN (cache, NV_FLOAT32, verr_offset);
+  NV_U_INT32 *val = POINT_CACHE_COLUMN (cache, NV_U_INT32, val_offset);
+  NV_INT16 *file = POINT_CACHE_COLUMN (cache, NV_INT16, file_offset);
+  NV_INT32 *line = POINT_CACHE_COLUMN (cache, NV_INT32, line_offset);
+  NV_U_INT32 *rec = POINT_CACHE_COLUMN (cache, NV_U_INT32, rec_offset);
+  NV_INT32 *sub = POINT_CACHE_COLUMN (cache, NV_INT32, sub_offset);
+  NV_INT64 *addr = POINT_CACHE_COLUMN (cache, NV_INT64, addr_offset);
+  NV_U_BYTE *pos = POINT_CACHE_COLUMN (cache, NV_U_BYTE, pos_offset);
+
+
+  //  Positions are stored relative to the southwest corner of the bin.
+
+  NV_FLOAT64 wlon = misc->abe_share->open_args[pfm].head.mbr.min_x + (NV_FLOAT64) coord.x * misc->abe_share->open_args[pfm].head.x_bin_size_degrees;
+  NV_FLOAT64 slat = misc->abe_share->open_args[pfm].head.mbr.min_y + (NV_FLOAT64) coord.y * misc->abe_share->open_args[pfm].head.y_bin_size_degrees;
+
+  NV_INT32 p = cb->start;
+
+  for (NV_INT32 k = 0 ; k < numrecs ; k++)
+    {
+      //  DO NOT use data marked as PFM_DELETED.
+
+      if (!(depth[k].validity & PFM_DELETED))
+        {
+          dx[p] = (NV_FLOAT32) (depth[k].xyz.x - wlon);
+          dy[p] = (NV_FLOAT32) (depth[k].xyz.y - slat);
+          z[p] = depth[k].xyz.z;
+          herr[p] = depth[k].horizontal_error;
+          verr[p] = depth[k].vertical_error;
+          val[p] = depth[k].validity;
+          file[p] = depth[k].file_number;
+          line[p] = depth[k].line_number;
+          rec[p] = depth[k].ping_number;
+          sub[p] = depth[k].beam_number;
+          addr[p] = depth[k].address.block;
+          pos[p] = depth[k].address.record;
+
+          for (NV_INT32 m = 0 ; m < misc->abe_share->open_args[pfm].head.num_ndx_attr ; m++)
+            POINT_CACHE_COLUMN (cache, NV_FLOAT32, attr_offset[m])[p] = depth[k].attr[m];
+
+          p++;
+        }
+    }
+
+  cache->num_points += count;
+
+  return (index);
+}
+
+
+
+/***************************************************************************/
+/*!
+
+  - Module Name:        drop_cached_bin
+
+  - Programmer(s):      Jan C. Depner
+
+  - Date Written:       October 2026
+
+  - Purpose:            Drop a bin from the point cache.  The bin is only
+                        marked as dropped (so it never matches).  The space
+                        used by it isn't recovered until we need to make
+                        room in the cache.
+
+  - Return Value:       void
+
+****************************************************************************/
+
+void drop_cached_bin (MISC *misc, NV_INT32 pfm, NV_I32_COORD2 coord)
+{
+  POINT_CACHE *cache = misc->cache;
+
+  if (cache == NULL) return;
+
+  POINT_CACHE_BIN *cache_bin = POINT_CACHE_COLUMN (cache, POINT_CACHE_BIN, bin_offset);
+  NV_INT32 *hash = POINT_CACHE_COLUMN (cache, NV_INT32, hash_offset);
+
+  for (NV_INT32 i = hash[cache_hash (cache, pfm, coord)] ; i >= 0 ; i = cache_bin[i].next)
+    {
+      if (cache_bin[i].pfm == pfm && cache_bin[i].x == coord.x && cache_bin[i].y == coord.y)
+        {
+          cache_bin[i].pfm = -1;
+          return;
+        }
+    }
+}
+
+
+
+/***************************************************************************/
+/*!
+
+  - Module Name:        read_cached_bin
+
+  - Programmer(s):      Jan C. Depner
+
+  - Date Written:       October 2026
+
+  - Purpose:            Rebuild a depth record array from a cached bin.
+                        This allows get_buffer to treat cached and uncached
+                        bins the same way.  The caller must free the array.
+
+  - Return Value:       Number of records in the array
+
+****************************************************************************/
+
+NV_INT32 read_cached_bin (MISC *misc, NV_INT32 index, DEPTH_RECORD **depth)
+{
+  POINT_CACHE *cache = misc->cache;
+  POINT_CACHE_BIN *cb = &POINT_CACHE_COLUMN (cache, POINT_CACHE_BIN, bin_offset)[index];
+  NV_INT32 pfm = cb->pfm;
+
+  *depth = (DEPTH_RECORD *) calloc (qMax (cb->count, 1), sizeof (DEPTH_RECORD));
+  if (*depth == NULL)
+    {
+      perror (pfmEdit3D::tr ("Allocating depth in read_cached_bin").toAscii ());
+      exit (-1);
+    }
+
+  NV_FLOAT32 *dx = POINT_CACHE_COLUMN (cache, NV_FLOAT32, dx_offset);
+  NV_FLOAT32 *dy = POINT_CACHE_COLUMN (cache, NV_FLOAT32, dy_offset);
+  NV_FLOAT64 *z = POINT_CACHE_COLUMN (cache, NV_FLOAT64, z_offset);
+  NV_FLOAT32 *herr = POINT_CACHE_COLUMN (cache, NV_FLOAT32, herr_offset);
+  NV_FLOAT32 *verr = POINT_CACHE_COLUMN (cache, NV_FLOAT32, verr_offset);
+  NV_U_INT32 *val = POINT_CACHE_COLUMN (cache, NV_U_INT32, val_offset);
+  NV_INT16 *file = POINT_CACHE_COLUMN (cache, NV_INT16, file_offset);
+  NV_INT32 *line = POINT_CACHE_COLUMN (cache, NV_INT32, line_offset);
+  NV_U_INT32 *rec = POINT_CACHE_COLUMN (cache, NV_U_INT32, rec_offset);
+  NV_INT32 *sub = POINT_CACHE_COLUMN (cache, NV_INT32, sub_offset);
+  NV_INT64 *addr = POINT_CACHE_COLUMN (cache, NV_INT64, addr_offset);
+  NV_U_BYTE *pos = POINT_CACHE_COLUMN (cache, NV_U_BYTE, pos_offset);
+
+  NV_FLOAT64 wlon = misc->abe_share->open_args[pfm].head.mbr.min_x + (NV_FLOAT64) cb->x * misc->abe_share->open_args[pfm].head.x_bin_size_degrees;
+  NV_FLOAT64 slat = misc->abe_share->open_args[pfm].head.mbr.min_y + (NV_FLOAT64) cb->y * misc->abe_share->open_args[pfm].head.y_bin_size_degrees;
+
+  for (NV_INT32 k = 0 ; k < cb->count ; k++)
+    {
+      NV_INT32 p = cb->start + k;
+      DEPTH_RECORD *d = &(*depth)[k];
+
+      d->coord.x = cb->x;
+      d->coord.y = cb->y;
+      d->xyz.x = wlon + (NV_FLOAT64) dx[p];
+      d->xyz.y = slat + (NV_FLOAT64) dy[p];
+      d->xyz.z = z[p];
+      d->horizontal_error = herr[p];
+      d->vertical_error = verr[p];
+      d->validity = val[p];
+      d->file_number = file[p];
+      d->line_number = line[p];
+      d->ping_number = rec[p];
+      d->beam_number = sub[p];
+      d->address.block = addr[p];
+      d->address.record = pos[p];
+
+      for (NV_INT32 m = 0 ; m < misc->abe_share->open_args[pfm].head.num_ndx_attr ; m++)
+        d->attr[m] = POINT_CACHE_COLUMN (cache, NV_FLOAT32, attr_offset[m])[p];
+    }
+
+  return (cb->count);
+}
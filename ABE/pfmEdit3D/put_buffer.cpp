@@ -183,6 +183,11 @@ NV_INT32 put_buffer (MISC *misc)
                         {
                           bin.validity |= PFM_DATA;
                           recompute_bin_values_index (misc->pfm_handle[pfm], coord, &bin, PFM_DATA);
+
+
+                          //  The cached copy of this bin (if any) is no longer valid.
+
+                          drop_cached_bin (misc, pfm, coord);
                         }
                     }
                 }
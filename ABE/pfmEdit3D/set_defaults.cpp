@@ -52,6 +52,8 @@ void set_defaults (MISC *misc, OPTIONS *options, NV_BOOL restore)
       misc->draw_area_height = 950;
       misc->drawing_canceled = NVFalse;
       misc->feature = NULL;
+      misc->cacheShare = NULL;
+      misc->cache = NULL;
       memset (&misc->bfd_header, 0, sizeof (BFDATA_HEADER));
       misc->feature_mod = NVFalse;
       misc->resized = NVTrue;
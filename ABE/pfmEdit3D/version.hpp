@@ -55,9 +55,9 @@
 #ifndef VERSION
 
 #ifdef OPTECH_CZMIL
-#define     VERSION     "CME Software - 3D Editor V4.79 - 10/24/11"
+#define     VERSION     "CME Software - 3D Editor V4.84 - 10/19/26"
 #else
-#define     VERSION     "PFM Software - pfmEdit3D V4.79 - 10/24/11"
+#define     VERSION     "PFM Software - pfmEdit3D V4.84 - 10/19/26"
 #endif
 
 #endif
@@ -1081,4 +1081,43 @@
     Added fix for invalid highlights not showing up when you delete data while displaying
     invalid with invalid data flagged.
 
+
+    Version 4.80
+    Jan C. Depner
+    10/19/26
+
+    Added a persistent point cache (created by pfmView) so that bins that were loaded in a previous edit session and
+    haven't changed since are not re-read from the PFM files.
+
+
+    Version 4.81
+    Jan C. Depner
+    10/19/26
+
+    Use a prepared polygon when loading points inside of a polygonal edit area.
+
+
+    Version 4.82
+    Jan C. Depner
+    10/19/26
+
+    Build arrays of the displayed points in redrawMap and load them with the new array versions of the nvMapGL setDataPoints
+    and setSparsePoints calls instead of one call per point.
+
+
+    Version 4.83
+    Jan C. Depner
+    10/19/26
+
+    Filter bins are now built with a two pass counting sort into one array instead of a realloc per point and the area
+    filter runs on multiple threads (rows interleaved with a column lag so the results are the same as the single threaded filter).
+
+
+    Version 4.84
+    Jan C. Depner
+    10/19/26
+
+    If the hofWaveFilterPlugin library can be found the HOF waveform filter is now run in-process on a thread with
+    direct access to the point cloud instead of running hofWaveFilter through QProcess and shared memory.
+
 </pre>*/
@@ -0,0 +1,381 @@
+#include "extractThread.hpp"
+
+
+//  Largest formatted ASCII record (UTM with two uncertainty values is about 100 characters).
+
+#define MAX_ASCII_RECORD 256
+
+
+extractThread::extractThread (QObject *parent)
+  : QThread(parent)
+{
+  bin_row = NULL;
+}
+
+
+
+extractThread::~extractThread ()
+{
+  if (bin_row) free (bin_row);
+}
+
+
+
+//  Each thread needs its own PFM handle and its own projections since neither the PFM library nor PROJ.4 can be
+//  shared between threads.
+
+void extractThread::prepare (OPTIONS *op, EXTRACT_BANDS *eb, NV_INT32 ph, projPJ pu, projPJ pl)
+{
+  QMutexLocker locker (&mutex);
+
+  l_options = op;
+  l_bands = eb;
+  l_pfm_handle = ph;
+  l_pj_utm = pu;
+  l_pj_latlon = pl;
+
+  if (!isRunning ()) start ();
+}
+
+
+
+//  Format a value with a fixed number of decimal places (up to 9) the same way printf ("%.*f") does, but without
+//  the overhead of parsing the format string.  The value is scaled and rounded to an integer.  If the scaled value
+//  is too large for the rounding to be exact (or it's NaN/Inf) or the fraction is too close to a rounding tie to be
+//  sure which way printf would round it, we let sprintf do it.  Returns a pointer to the end of the output.
+
+static NV_CHAR *format_fixed (NV_CHAR *ptr, NV_FLOAT64 value, NV_INT32 decimals)
+{
+  static const NV_FLOAT64 scale[10] = {1.0, 10.0, 100.0, 1000.0, 10000.0, 100000.0, 1000000.0, 10000000.0,
+                                       100000000.0, 1000000000.0};
+  NV_CHAR digits[32];
+
+
+  NV_FLOAT64 scaled = fabs (value) * scale[decimals];
+
+  if (!(scaled < 1.0e15)) return (ptr + sprintf (ptr, "%.*f", decimals, value));
+
+  NV_FLOAT64 whole = floor (scaled);
+  NV_FLOAT64 frac = scaled - whole;
+
+  if (fabs (frac - 0.5) <= scaled * 1.0e-15 + 1.0e-15) return (ptr + sprintf (ptr, "%.*f", decimals, value));
+
+  NV_U_INT64 n = (NV_U_INT64) whole;
+  if (frac > 0.5) n++;
+
+
+  //  printf keeps the sign of negative values that round to zero (and of -0.0).
+
+  if (copysign (1.0, value) < 0.0) *ptr++ = '-';
+
+
+  NV_INT32 count = 0;
+  do
+    {
+      digits[count++] = '0' + (NV_CHAR) (n % 10);
+      n /= 10;
+    } while (n || count <= decimals);
+
+  for (NV_INT32 i = count - 1 ; i >= 0 ; i--)
+    {
+      *ptr++ = digits[i];
+      if (i == decimals && decimals) *ptr++ = '.';
+    }
+
+  return (ptr);
+}
+
+
+
+//  Make sure there is room for bytes more bytes in the slot buffer and return a pointer to the end of the data.
+
+NV_CHAR *extractThread::reserve (EXTRACT_SLOT *slot, size_t bytes)
+{
+  if (slot->size + bytes > slot->allocated)
+    {
+      size_t new_size = qMax (slot->allocated * 2, slot->size + bytes + 65536);
+
+      slot->data = (NV_CHAR *) realloc (slot->data, new_size);
+
+      if (slot->data == NULL)
+        {
+          perror ("Allocating extract buffer");
+          exit (-1);
+        }
+
+      slot->allocated = new_size;
+    }
+
+  return (slot->data + slot->size);
+}
+
+
+
+//  Apply the Z corrections and options to a point and add it to the slot buffer in the output format.  Returns NVFalse
+//  if the point was excluded.
+
+NV_BOOL extractThread::output_point (EXTRACT_SLOT *slot, NV_FLOAT64 lat, NV_FLOAT64 lon, NV_FLOAT32 z, NV_INT32 num_unc,
+                                     NV_FLOAT32 unc0, NV_FLOAT32 unc1)
+{
+  OPTIONS *options = l_options;
+  NV_FLOAT32 value = z;
+
+
+  if (options->geoid03)
+    {
+      l_bands->geoid_mutex.lock ();
+      NV_FLOAT32 corr = get_geoid03 (lat, lon);
+      l_bands->geoid_mutex.unlock ();
+
+      value += corr;
+    }
+
+  if (options->cut && value > options->cutoff) value = options->cutoff;
+  value += options->datum_shift;
+
+
+  //  Check for exclude land option.
+
+  if (options->lnd && value < 0.0) return (NVFalse);
+
+
+  if (options->flp) value = -value;
+
+
+  switch (options->format)
+    {
+    case 0:
+      {
+        NV_CHAR *start = reserve (slot, MAX_ASCII_RECORD);
+        NV_CHAR *ptr = start;
+
+        if (options->utm)
+          {
+            NV_FLOAT64 x = lon * NV_DEG_TO_RAD;
+            NV_FLOAT64 y = lat * NV_DEG_TO_RAD;
+            pj_transform (l_pj_latlon, l_pj_utm, 1, 1, &x, &y, NULL);
+
+            *ptr++ = '0' + (NV_CHAR) (l_bands->zone / 10);
+            *ptr++ = '0' + (NV_CHAR) (l_bands->zone % 10);
+            *ptr++ = ',';
+            ptr = format_fixed (ptr, x, 2);
+            *ptr++ = ',';
+            ptr = format_fixed (ptr, y, 2);
+          }
+        else
+          {
+            ptr = format_fixed (ptr, lat, 9);
+            *ptr++ = ',';
+            ptr = format_fixed (ptr, lon, 9);
+          }
+
+        *ptr++ = ',';
+        ptr = format_fixed (ptr, (NV_FLOAT64) value, 2);
+
+        if (options->unc)
+          {
+            *ptr++ = ',';
+            ptr = format_fixed (ptr, (NV_FLOAT64) unc0, 2);
+
+            if (num_unc > 1)
+              {
+                *ptr++ = ',';
+                ptr = format_fixed (ptr, (NV_FLOAT64) unc1, 2);
+              }
+          }
+
+        *ptr++ = '\n';
+
+        slot->size += ptr - start;
+      }
+      break;
+
+    case 1:
+      {
+        LLZ_REC llz_rec;
+
+        memset (&llz_rec, 0, sizeof (LLZ_REC));
+        llz_rec.xy.lat = lat;
+        llz_rec.xy.lon = lon;
+        llz_rec.depth = value;
+        llz_rec.status = 0;
+
+        memcpy (reserve (slot, sizeof (LLZ_REC)), &llz_rec, sizeof (LLZ_REC));
+        slot->size += sizeof (LLZ_REC);
+      }
+      break;
+
+    case 2:
+      {
+        NV_INT32 rdp_data[3];
+
+        rdp_data[0] = NINT (lat * 10000000.0);
+        rdp_data[1] = NINT (lon * 10000000.0);
+        rdp_data[2] = NINT (value * 10000.0);
+
+        memcpy (reserve (slot, sizeof (rdp_data)), rdp_data, sizeof (rdp_data));
+        slot->size += sizeof (rdp_data);
+      }
+      break;
+
+    case 3:
+      {
+        NV_FLOAT64 xyz[3];
+
+        xyz[0] = lon;
+        xyz[1] = lat;
+        xyz[2] = (NV_FLOAT64) value;
+
+        memcpy (reserve (slot, sizeof (xyz)), xyz, sizeof (xyz));
+        slot->size += sizeof (xyz);
+      }
+      break;
+    }
+
+  return (NVTrue);
+}
+
+
+
+//  Extract the selected data source for PFM row i into the slot buffer.
+
+void extractThread::extract_row (NV_INT32 i, EXTRACT_SLOT *slot)
+{
+  OPTIONS *options = l_options;
+  EXTRACT_BANDS *eb = l_bands;
+  DEPTH_RECORD *depth;
+  NV_INT32 recnum, row_index = (i - eb->y_start) % eb->band_rows, count = 0;
+
+
+  read_bin_row (l_pfm_handle, eb->width, i, eb->x_start, bin_row);
+
+
+  for (NV_INT32 j = 0 ; j < eb->width ; j++)
+    {
+      BIN_RECORD *bin = &bin_row[j];
+
+      if (options->chk && !(bin->validity & (PFM_CHECKED | PFM_VERIFIED))) continue;
+
+      switch (options->source)
+        {
+        case 3:
+          if (!read_depth_array_index (l_pfm_handle, bin->coord, &depth, &recnum))
+            {
+              for (NV_INT32 k = 0 ; k < recnum ; k++)
+                {
+                  if (!(depth[k].validity & (PFM_INVAL | PFM_DELETED)))
+                    {
+                      if (!eb->polygon_count || inside (eb->polygon_x, eb->polygon_y, eb->polygon_count, depth[k].xyz.x, depth[k].xyz.y))
+                        {
+                          if (!(depth[k].validity & PFM_REFERENCE) || options->ref)
+                            {
+                              if (output_point (slot, depth[k].xyz.y, depth[k].xyz.x, depth[k].xyz.z, 2, depth[k].horizontal_error,
+                                                depth[k].vertical_error)) count++;
+                            }
+                        }
+                    }
+                }
+
+              free (depth);
+            }
+          break;
+
+        case 0:
+        case 1:
+          if (bin->validity & PFM_DATA)
+            {
+              if (!read_depth_array_index (l_pfm_handle, bin->coord, &depth, &recnum))
+                {
+                  for (NV_INT32 k = 0 ; k < recnum ; k++)
+                    {
+                      if (!(depth[k].validity & (PFM_INVAL | PFM_DELETED)))
+                        {
+                          //  Output the first point that matches the minimum or maximum filtered value.
+
+                          if ((options->source == 0 && fabs ((NV_FLOAT64) (bin->min_filtered_depth - depth[k].xyz.z)) < 0.0005) ||
+                              (options->source == 1 && fabs ((NV_FLOAT64) (bin->max_filtered_depth - depth[k].xyz.z)) < 0.005))
+                            {
+                              if (output_point (slot, depth[k].xyz.y, depth[k].xyz.x, depth[k].xyz.z, 1, bin->standard_dev, 0.0)) count++;
+                              break;
+                            }
+                        }
+                    }
+
+                  free (depth);
+                }
+            }
+          break;
+
+        case 2:
+          if (bin->validity & (PFM_DATA | PFM_INTERPOLATED))
+            {
+              if (output_point (slot, bin->xy.y, bin->xy.x, bin->avg_filtered_depth, 1, bin->standard_dev, 0.0)) count++;
+            }
+          break;
+        }
+    }
+
+
+  slot->row_end[row_index] = slot->size;
+  slot->row_count[row_index] = count;
+}
+
+
+
+void extractThread::run ()
+{
+  EXTRACT_BANDS *eb = l_bands;
+
+
+  bin_row = (BIN_RECORD *) realloc (bin_row, eb->width * sizeof (BIN_RECORD));
+
+  if (bin_row == NULL)
+    {
+      perror ("Allocating bin row");
+      exit (-1);
+    }
+
+
+  while (1)
+    {
+      //  Get the next band and wait for its slot to be free.
+
+      eb->mutex.lock ();
+
+      NV_INT32 band = eb->next_band;
+
+      if (band >= eb->num_bands)
+        {
+          eb->mutex.unlock ();
+          break;
+        }
+
+      eb->next_band++;
+
+      while (band >= eb->write_band + eb->num_slots) eb->slot_free.wait (&eb->mutex);
+
+      eb->mutex.unlock ();
+
+
+      EXTRACT_SLOT *slot = &eb->slot[band % eb->num_slots];
+      NV_INT32 start_row = eb->y_start + band * eb->band_rows;
+      NV_INT32 end_row = qMin (start_row + eb->band_rows, eb->y_start + eb->height);
+
+      slot->size = 0;
+
+      for (NV_INT32 i = start_row ; i < end_row ; i++)
+        {
+          extract_row (i, slot);
+
+          eb->mutex.lock ();
+          eb->rows_done++;
+          eb->mutex.unlock ();
+        }
+
+
+      eb->mutex.lock ();
+      eb->ready[band % eb->num_slots] = NVTrue;
+      eb->slot_ready.wakeAll ();
+      eb->mutex.unlock ();
+    }
+}
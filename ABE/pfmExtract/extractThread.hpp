@@ -0,0 +1,48 @@
+#ifndef EXTRACTTHREAD_H
+#define EXTRACTTHREAD_H
+
+
+#include "pfmExtractDef.hpp"
+
+
+class extractThread:public QThread
+{
+  Q_OBJECT 
+
+
+public:
+
+  extractThread (QObject *parent = 0);
+  ~extractThread ();
+
+  void prepare (OPTIONS *op = NULL, EXTRACT_BANDS *eb = NULL, NV_INT32 ph = -1, projPJ pu = NULL, projPJ pl = NULL);
+
+
+protected:
+
+
+  QMutex           mutex;
+
+  OPTIONS          *l_options;
+
+  EXTRACT_BANDS    *l_bands;
+
+  NV_INT32         l_pfm_handle;
+
+  BIN_RECORD       *bin_row;
+
+  projPJ           l_pj_utm, l_pj_latlon;
+
+  void             run ();
+  void             extract_row (NV_INT32 i, EXTRACT_SLOT *slot);
+  NV_BOOL          output_point (EXTRACT_SLOT *slot, NV_FLOAT64 lat, NV_FLOAT64 lon, NV_FLOAT32 z, NV_INT32 num_unc,
+                                 NV_FLOAT32 unc0, NV_FLOAT32 unc1);
+  NV_CHAR          *reserve (EXTRACT_SLOT *slot, size_t bytes);
+
+
+protected slots:
+
+private:
+};
+
+#endif
@@ -142,16 +142,12 @@ void
 pfmExtract::slotCustomButtonClicked (int id __attribute__ ((unused)))
 {
   FILE                *fp = NULL;
-  NV_INT32            i, j, k, endian, recnum, rdp_data[3], pfm_handle, out_count = 0, file_count = 0, polygon_count = 0,
+  NV_INT32            i, endian, pfm_handle, out_count = 0, file_count = 0, polygon_count = 0,
                       x_start, y_start, width, height, llz_hnd = -1, zone = 0;
   NV_U_INT32          max_file_size = 0, size = 0;
-  NV_FLOAT32          total;
-  BIN_RECORD          bin;
-  DEPTH_RECORD        *depth;
   NV_CHAR             out_file[256], orig[256], areafile[512];
-  NV_I32_COORD2       coord;
   PFM_OPEN_ARGS       open_args;
-  NV_FLOAT64          polygon_x[200], polygon_y[200], central_meridian, x, y, z;
+  NV_FLOAT64          polygon_x[200], polygon_y[200], central_meridian, xyz[3];
   NV_F64_XYMBR        mbr;
   LLZ_REC             llz_rec;
   LLZ_HEADER          llz_header;
@@ -386,423 +382,159 @@ pfmExtract::slotCustomButtonClicked (int id __attribute__ ((unused)))
     }
 
 
-  total = open_args.head.bin_height;
+  //  The PFM rows are extracted in bands by the extract threads (each with its own PFM handle and projections) while
+  //  this thread writes the finished bands to the output file(s) in order.  Since the bands are always written in
+  //  order the output is the same as it would be if we read the PFM one bin at a time.
 
+  NV_INT32 num_threads = qMin (qMax (QThread::idealThreadCount (), 1), MAX_EXTRACT_THREADS);
 
-  //  Loop over height & width of bins or area
+  EXTRACT_BANDS bands;
 
-  progress.ebar->setRange (0, height);
+  bands.x_start = x_start;
+  bands.y_start = y_start;
+  bands.width = width;
+  bands.height = height;
+  bands.band_rows = EXTRACT_BAND_SIZE;
+  bands.num_bands = (height + EXTRACT_BAND_SIZE - 1) / EXTRACT_BAND_SIZE;
+  bands.next_band = 0;
+  bands.write_band = 0;
+  bands.rows_done = 0;
+  bands.polygon_count = polygon_count;
+  bands.polygon_x = polygon_x;
+  bands.polygon_y = polygon_y;
+  bands.zone = zone;
+
+  if (num_threads > bands.num_bands) num_threads = qMax (bands.num_bands, 1);
+
+  bands.num_slots = num_threads * 2;
+
+  bands.slot = (EXTRACT_SLOT *) calloc (bands.num_slots, sizeof (EXTRACT_SLOT));
+  bands.ready = (NV_BOOL *) calloc (bands.num_slots, sizeof (NV_BOOL));
+
+  if (bands.slot == NULL || bands.ready == NULL)
+    {
+      perror (tr ("Allocating extract band memory").toAscii ());
+      exit (-1);
+    }
+
+  for (i = 0 ; i < bands.num_slots ; i++)
+    {
+      bands.slot[i].row_end = (size_t *) calloc (bands.band_rows, sizeof (size_t));
+      bands.slot[i].row_count = (NV_INT32 *) calloc (bands.band_rows, sizeof (NV_INT32));
+
+      if (bands.slot[i].row_end == NULL || bands.slot[i].row_count == NULL)
+        {
+          perror (tr ("Allocating extract band memory").toAscii ());
+          exit (-1);
+        }
+    }
+
+
+  extractThread extract_thread[MAX_EXTRACT_THREADS];
+  NV_INT32 thread_handle[MAX_EXTRACT_THREADS];
+  PFM_OPEN_ARGS thread_open_args[MAX_EXTRACT_THREADS];
+  projPJ thread_pj_utm[MAX_EXTRACT_THREADS], thread_pj_latlon[MAX_EXTRACT_THREADS];
 
-  NV_FLOAT32 value = 0.0;
-  for (i = y_start ; i < y_start + height ; i++)
+  for (i = 0 ; i < num_threads ; i++)
     {
-      coord.y = i;
-      for (j = x_start ; j < x_start + width ; j++)
+      strcpy (thread_open_args[i].list_path, open_args.list_path);
+
+      thread_open_args[i].checkpoint = 0;
+      if ((thread_handle[i] = open_existing_pfm_file (&thread_open_args[i])) < 0) pfm_error_exit (pfm_error);
+
+
+      thread_pj_utm[i] = thread_pj_latlon[i] = NULL;
+
+      if (options.utm)
         {
-          coord.x = j;
+          NV_CHAR *utm_def = pj_get_def (pj_utm, 0);
+          NV_CHAR *latlon_def = pj_get_def (pj_latlon, 0);
+
+          thread_pj_utm[i] = pj_init_plus (utm_def);
+          thread_pj_latlon[i] = pj_init_plus (latlon_def);
 
-          read_bin_record_index (pfm_handle, coord, &bin);
+          pj_dalloc (utm_def);
+          pj_dalloc (latlon_def);
 
-          if (!options.chk || (bin.validity & (PFM_CHECKED | PFM_VERIFIED)))
+          if (!thread_pj_utm[i] || !thread_pj_latlon[i])
             {
-              switch (options.source)
-                {
-                case 3:
-                  if (!read_depth_array_index (pfm_handle, coord, &depth, &recnum))
-                    {
-                      for (k = 0 ; k < recnum ; k++)
-                        {
-                          if (!(depth[k].validity & (PFM_INVAL | PFM_DELETED)))
-                            {
-                              if (!polygon_count || inside (polygon_x, polygon_y, polygon_count, depth[k].xyz.x, depth[k].xyz.y))
-                                {
-                                  if (!(depth[k].validity & PFM_REFERENCE) || options.ref)
-                                    {
-                                      out_count++;
-
-                                      value = depth[k].xyz.z;
-
-                                      if (options.geoid03)
-                                        {
-                                          NV_FLOAT32 corr = get_geoid03 (depth[k].xyz.y, depth[k].xyz.x);
-
-                                          value += corr;
-                                        }
-
-                                      if (options.cut && value > options.cutoff) value = options.cutoff;
-                                      value += options.datum_shift;
-
-
-                                      //  Check for exclude land option.
-
-                                      NV_BOOL skip = NVFalse;
-                                      if (options.lnd && value < 0.0) skip = NVTrue;
-
-                                      if (!skip)
-                                        {
-                                          if (options.flp) value = -value;
-
-                                          switch (options.format)
-                                            {
-                                            case 0:
-                                              if (options.utm)
-                                                {
-                                                  x = depth[k].xyz.x * NV_DEG_TO_RAD;
-                                                  y = depth[k].xyz.y * NV_DEG_TO_RAD;
-                                                  pj_transform (pj_latlon, pj_utm, 1, 1, &x, &y, NULL);
-
-                                                  if (options.unc)
-                                                    {
-                                                      fprintf (fp, "%02d,%.2f,%.2f,%.2f,%.2f,%.2f\n", zone, x, y, value, depth[k].horizontal_error,
-                                                               depth[k].vertical_error);
-                                                    }
-                                                  else
-                                                    {
-                                                      fprintf (fp, "%02d,%.2f,%.2f,%.2f\n", zone, x, y, value);
-                                                    }
-                                                }
-                                              else
-                                                {
-                                                  if (options.unc)
-                                                    {
-                                                      fprintf (fp, "%.9f,%.9f,%.2f,%.2f,%.2f\n", depth[k].xyz.y, depth[k].xyz.x, value, depth[k].horizontal_error,
-                                                               depth[k].vertical_error);
-                                                    }
-                                                  else
-                                                    {
-                                                      fprintf (fp, "%.9f,%.9f,%.2f\n", depth[k].xyz.y, depth[k].xyz.x, value);
-                                                    }
-                                                }
-                                              break;
-
-                                            case 1:
-                                              llz_rec.xy.lat = depth[k].xyz.y;
-                                              llz_rec.xy.lon = depth[k].xyz.x;
-                                              llz_rec.depth = value;
-                                              llz_rec.status = 0;
-
-                                              append_llz (llz_hnd, llz_rec);
-                                              break;
-
-                                            case 2:
-                                              rdp_data[0] = NINT (depth[k].xyz.y * 10000000.0);
-                                              rdp_data[1] = NINT (depth[k].xyz.x * 10000000.0);
-                                              rdp_data[2] = NINT (value * 10000.0);
-
-                                              fwrite (rdp_data, sizeof (rdp_data), 1, fp);
-                                              break;
-
-                                            case 3:
-                                              z = (NV_FLOAT64) value;
-                                              shape = SHPCreateObject (SHPT_POINTZ, -1, 0, NULL, NULL, 1, &depth[k].xyz.x, &depth[k].xyz.y, &z, NULL);
-
-                                              SHPWriteObject (shp_hnd, -1, shape);
-                                              SHPDestroyObject (shape);
-                                              break;
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                        }
+              QMessageBox::critical (this, tr ("pfmExtract"), tr ("Error initializing thread projections\n"));
+              exit (-1);
+            }
+        }
 
-                      free (depth);
-                    }
-                  break;
+      extract_thread[i].prepare (&options, &bands, thread_handle[i], thread_pj_utm[i], thread_pj_latlon[i]);
+    }
 
-                case 0:
-                case 1:
 
-                  if (bin.validity & PFM_DATA)
-                    {
-                      if (!read_depth_array_index (pfm_handle, coord, &depth, &recnum))
-                        {
-                          for (k = 0 ; k < recnum ; k++)
-                            {
-                              if (!(depth[k].validity & (PFM_INVAL | PFM_DELETED)))
-                                {
-                                  if (options.source == 0)
-                                    {
-                                      if (fabs ((NV_FLOAT64) (bin.min_filtered_depth - depth[k].xyz.z)) < 0.0005)
-                                        {
-                                          value = depth[k].xyz.z;
-
-                                          if (options.geoid03)
-                                            {
-                                              NV_FLOAT32 corr = get_geoid03 (depth[k].xyz.y, depth[k].xyz.x);
-
-                                              value += corr;
-                                            }
-
-                                          if (options.cut && value > options.cutoff) value = options.cutoff;
-                                          value += options.datum_shift;
-
-
-                                          //  Check for exclude land option.
-
-                                          NV_BOOL skip = NVFalse;
-                                          if (options.lnd && value < 0.0) skip = NVTrue;
-
-                                          if (!skip)
-                                            {
-                                              if (options.flp) value = -value;
-
-                                              switch (options.format)
-                                                {
-                                                case 0:
-                                                  if (options.utm)
-                                                    {
-                                                      x = depth[k].xyz.x * NV_DEG_TO_RAD;
-                                                      y = depth[k].xyz.y * NV_DEG_TO_RAD;
-                                                      pj_transform (pj_latlon, pj_utm, 1, 1, &x, &y, NULL);
-
-                                                      if (options.unc)
-                                                        {
-                                                          fprintf (fp, "%02d,%.2f,%.2f,%.2f,%.2f\n", zone, x, y, value, bin.standard_dev);
-                                                        }
-                                                      else
-                                                        {
-                                                          fprintf (fp, "%02d,%.2f,%.2f,%.2f\n", zone, x, y, value);
-                                                        }
-                                                    }
-                                                  else
-                                                    {
-                                                      if (options.unc)
-                                                        {
-                                                          fprintf (fp, "%.9f,%.9f,%.2f,%.2f\n", depth[k].xyz.y, depth[k].xyz.x, value, bin.standard_dev);
-                                                        }
-                                                      else
-                                                        {
-                                                          fprintf (fp, "%.9f,%.9f,%.2f\n", depth[k].xyz.y, depth[k].xyz.x, value);
-                                                        }
-                                                    }
-                                                  break;
-
-                                                case 1:
-                                                  llz_rec.xy.lat = depth[k].xyz.y;
-                                                  llz_rec.xy.lon = depth[k].xyz.x;
-                                                  llz_rec.depth = value;
-                                                  llz_rec.status = 0;
-
-                                                  append_llz (llz_hnd, llz_rec);
-                                                  break;
-
-                                                case 2:
-                                                  rdp_data[0] = NINT (depth[k].xyz.y * 10000000.0);
-                                                  rdp_data[1] = NINT (depth[k].xyz.x * 10000000.0);
-                                                  rdp_data[2] = NINT (value);
-
-                                                  fwrite (rdp_data, sizeof (rdp_data), 1, fp);
-                                                  break;
-
-                                                case 3:
-                                                  z = (NV_FLOAT64) value;
-                                                  shape = SHPCreateObject (SHPT_POINTZ, -1, 0, NULL, NULL, 1, &depth[k].xyz.x, &depth[k].xyz.y, &z, NULL);
-
-                                                  SHPWriteObject (shp_hnd, -1, shape);
-                                                  SHPDestroyObject (shape);
-                                                  break;
-                                                }
-
-                                              out_count++;
-                                            }
-                                          break;
-                                        }
-                                    }
-                                  else
-                                    {
-                                      if (fabs ((NV_FLOAT64) (bin.max_filtered_depth - depth[k].xyz.z)) < 0.005)
-                                        {
-                                          value = depth[k].xyz.z;
-
-                                          if (options.geoid03)
-                                            {
-                                              NV_FLOAT32 corr = get_geoid03 (depth[k].xyz.y, depth[k].xyz.x);
-
-                                              value += corr;
-                                            }
-
-                                          if (options.cut && value > options.cutoff) value = options.cutoff;
-                                          value += options.datum_shift;
-
-
-                                          //  Check for exclude land option.
-
-                                          NV_BOOL skip = NVFalse;
-                                          if (options.lnd && value < 0.0) skip = NVTrue;
-
-                                          if (!skip)
-                                            {
-                                              if (options.flp) value = -value;
-
-                                              switch (options.format)
-                                                {
-                                                case 0:
-                                                  if (options.utm)
-                                                    {
-                                                      x = depth[k].xyz.x * NV_DEG_TO_RAD;
-                                                      y = depth[k].xyz.y * NV_DEG_TO_RAD;
-                                                      pj_transform (pj_latlon, pj_utm, 1, 1, &x, &y, NULL);
-
-                                                      if (options.unc)
-                                                        {
-                                                          fprintf (fp, "%02d,%.2f,%.2f,%.2f,%.2f\n", zone, x, y, value, bin.standard_dev);
-                                                        }
-                                                      else
-                                                        {
-                                                          fprintf (fp, "%02d,%.2f,%.2f,%.2f\n", zone, x, y, value);
-                                                        }
-                                                    }
-                                                  else
-                                                    {
-                                                      if (options.unc)
-                                                        {
-                                                          fprintf (fp, "%.9f,%.9f,%.2f,%.2f\n", depth[k].xyz.y, depth[k].xyz.x, value, bin.standard_dev);
-                                                        }
-                                                      else
-                                                        {
-                                                          fprintf (fp, "%.9f,%.9f,%.2f\n", depth[k].xyz.y, depth[k].xyz.x, value);
-                                                        }
-                                                    }
-                                                  break;
-
-                                                case 1:
-                                                  llz_rec.xy.lat = depth[k].xyz.y;
-                                                  llz_rec.xy.lon = depth[k].xyz.x;
-                                                  llz_rec.depth = value;
-                                                  llz_rec.status = 0;
-
-                                                  append_llz (llz_hnd, llz_rec);
-                                                  break;
-
-                                                case 2:
-                                                  rdp_data[0] = NINT (depth[k].xyz.y * 10000000.0);
-                                                  rdp_data[1] = NINT (depth[k].xyz.x * 10000000.0);
-                                                  rdp_data[2] = NINT (value * 10000.0);
-
-                                                  fwrite (rdp_data, sizeof (rdp_data), 1, fp);
-                                                  break;
-
-                                                case 3:
-                                                  z = (NV_FLOAT64) value;
-                                                  shape = SHPCreateObject (SHPT_POINTZ, -1, 0, NULL, NULL, 1, &depth[k].xyz.x, &depth[k].xyz.y, &z, NULL);
-
-                                                  SHPWriteObject (shp_hnd, -1, shape);
-                                                  SHPDestroyObject (shape);
-                                                  break;
-                                                }
-
-                                              out_count++;
-                                            }
-                                          break;
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                      free (depth);
-                    }
-                  break;
+  //  For ASCII and RDP files we know exactly how many bytes we're writing so we can split the files before a row that
+  //  would put us over the maximum file size.  For LLZ and SHP files we check the file size before each row.
 
+  NV_INT64 header_size = 0;
+  if (options.format == 2) header_size = sizeof (NV_INT32);
+  NV_INT64 file_size = header_size;
 
-                case 2:
 
-                  if (bin.validity & (PFM_DATA | PFM_INTERPOLATED))
-                    {
-                      value = bin.avg_filtered_depth;
+  //  Loop over the height of the bins or area, writing the bands as they are finished.
 
-                      if (options.geoid03)
-                        {
-                          NV_FLOAT32 corr = get_geoid03 (bin.xy.y, bin.xy.x);
+  progress.ebar->setRange (0, height);
 
-                          value += corr;
-                        }
+  for (NV_INT32 band = 0 ; band < bands.num_bands ; band++)
+    {
+      NV_INT32 slot_num = band % bands.num_slots;
 
-                      if (options.cut && value > options.cutoff) value = options.cutoff;
-                      value += options.datum_shift;
 
+      //  Wait for the band.  The extract thread that finishes it wakes us up right away.  The timeout is only there so
+      //  that we can keep the progress bar and the rest of the GUI alive while a band is being extracted.
 
-                      //  Check for exclude land option.
+      bands.mutex.lock ();
 
-                      NV_BOOL skip = NVFalse;
-                      if (options.lnd && value < 0.0) skip = NVTrue;
+      while (!bands.ready[slot_num])
+        {
+          if (!bands.slot_ready.wait (&bands.mutex, 100))
+            {
+              NV_INT32 rows_done = bands.rows_done;
+              bands.mutex.unlock ();
 
-                      if (!skip)
-                        {
-                          if (options.flp) value = -value;
-
-                          switch (options.format)
-                            {
-                            case 0:
-                              if (options.utm)
-                                {
-                                  x = bin.xy.x * NV_DEG_TO_RAD;
-                                  y = bin.xy.y * NV_DEG_TO_RAD;
-                                  pj_transform (pj_latlon, pj_utm, 1, 1, &x, &y, NULL);
-
-                                  if (options.unc)
-                                    {
-                                      fprintf (fp, "%02d,%.2f,%.2f,%.2f,%.2f\n", zone, x, y, value, bin.standard_dev);
-                                    }
-                                  else
-                                    {
-                                      fprintf (fp, "%02d,%.2f,%.2f,%.2f\n", zone, x, y, value);
-                                    }
-                                }
-                              else
-                                {
-                                  if (options.unc)
-                                    {
-                                      fprintf (fp, "%.9f,%.9f,%.2f,%.2f\n", bin.xy.y, bin.xy.x, value, bin.standard_dev);
-                                    }
-                                  else
-                                    {
-                                      fprintf (fp, "%.9f,%.9f,%.2f\n", bin.xy.y, bin.xy.x, value);
-                                    }
-                                }
-                              break;
-
-                            case 1:
-                              llz_rec.xy.lat = bin.xy.y;
-                              llz_rec.xy.lon = bin.xy.x;
-                              llz_rec.depth = value;
-                              llz_rec.status = 0;
-
-                              append_llz (llz_hnd, llz_rec);
-                              break;
-
-                            case 2:
-                              rdp_data[0] = NINT (bin.xy.y * 10000000.0);
-                              rdp_data[1] = NINT (bin.xy.x * 10000000.0);
-                              rdp_data[2] = NINT (value * 10000.0);
-
-                              fwrite (rdp_data, sizeof (rdp_data), 1, fp);
-                              break;
-
-                            case 3:
-                              z = (NV_FLOAT64) value;
-                              shape = SHPCreateObject (SHPT_POINTZ, -1, 0, NULL, NULL, 1, &bin.xy.x, &bin.xy.y, &z, NULL);
-
-                              SHPWriteObject (shp_hnd, -1, shape);
-                              SHPDestroyObject (shape);
-                              break;
-                            }
-
-                          out_count++;
-                        }
-                    }
-                  break;
-                }
+              progress.ebar->setValue (rows_done);
+              qApp->processEvents ();
+
+              bands.mutex.lock ();
             }
+        }
+
+      bands.mutex.unlock ();
 
 
-          //  Make sure file size does not exceed 2GB.
+      EXTRACT_SLOT *slot = &bands.slot[slot_num];
+      NV_INT32 rows = qMin (bands.band_rows, height - band * bands.band_rows);
+
+      for (i = 0 ; i < rows ; i++)
+        {
+          size_t start = i ? slot->row_end[i - 1] : 0;
+          size_t bytes = slot->row_end[i] - start;
+
+          if (!bytes) continue;
+
+
+          //  Make sure file size does not exceed the maximum.
 
           if (options.size)
             {
-              size = QFileInfo (out_file).size ();
+              NV_BOOL new_file = NVFalse;
 
-              if (size >= max_file_size)
+              if (options.format == 0 || options.format == 2)
+                {
+                  if (file_size > header_size && file_size + (NV_INT64) bytes > (NV_INT64) max_file_size) new_file = NVTrue;
+                }
+              else
+                {
+                  size = QFileInfo (out_file).size ();
+
+                  if (size >= max_file_size) new_file = NVTrue;
+                }
+
+              if (new_file)
                 {
                   file_count++;
 
@@ -868,17 +600,81 @@ pfmExtract::slotCustomButtonClicked (int id __attribute__ ((unused)))
                       break;
                     }
 
+                  file_size = header_size;
+
 
                   extractList->addItem (tr ("FILE : ") + QString (out_file));
                 }
             }
+
+
+          switch (options.format)
+            {
+            case 0:
+            case 2:
+              fwrite (&slot->data[start], bytes, 1, fp);
+              file_size += bytes;
+              break;
+
+            case 1:
+              for (size_t pos = start ; pos < slot->row_end[i] ; pos += sizeof (LLZ_REC))
+                {
+                  memcpy (&llz_rec, &slot->data[pos], sizeof (LLZ_REC));
+                  append_llz (llz_hnd, llz_rec);
+                }
+              break;
+
+            case 3:
+              for (size_t pos = start ; pos < slot->row_end[i] ; pos += sizeof (xyz))
+                {
+                  memcpy (xyz, &slot->data[pos], sizeof (xyz));
+                  shape = SHPCreateObject (SHPT_POINTZ, -1, 0, NULL, NULL, 1, &xyz[0], &xyz[1], &xyz[2], NULL);
+
+                  SHPWriteObject (shp_hnd, -1, shape);
+                  SHPDestroyObject (shape);
+                }
+              break;
+            }
+
+          out_count += slot->row_count[i];
         }
 
 
-      progress.ebar->setValue (i - y_start);
+      //  Free the slot for the next band.
+
+      bands.mutex.lock ();
+      bands.ready[slot_num] = NVFalse;
+      bands.write_band++;
+      bands.slot_free.wakeAll ();
+      bands.mutex.unlock ();
+
+      progress.ebar->setValue (band * bands.band_rows + rows);
       qApp->processEvents ();
     }
 
+
+  for (i = 0 ; i < num_threads ; i++)
+    {
+      extract_thread[i].wait ();
+
+      close_pfm_file (thread_handle[i]);
+
+      if (thread_pj_utm[i]) pj_free (thread_pj_utm[i]);
+      if (thread_pj_latlon[i]) pj_free (thread_pj_latlon[i]);
+    }
+
+
+  for (i = 0 ; i < bands.num_slots ; i++)
+    {
+      if (bands.slot[i].data) free (bands.slot[i].data);
+      free (bands.slot[i].row_end);
+      free (bands.slot[i].row_count);
+    }
+
+  free (bands.slot);
+  free (bands.ready);
+
+
   progress.ebar->setValue (height);
   qApp->processEvents ();
 
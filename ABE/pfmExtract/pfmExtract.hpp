@@ -5,6 +5,7 @@
 #include "startPage.hpp"
 #include "optionsPage.hpp"
 #include "runPage.hpp"
+#include "extractThread.hpp"
 #include "version.hpp"
 
 
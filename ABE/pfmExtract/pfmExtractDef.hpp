@@ -18,6 +18,10 @@
 #include "llz.h"
 
 
+#define MAX_EXTRACT_THREADS 16
+#define EXTRACT_BAND_SIZE   16         //  Number of PFM rows extracted at one time by an extract thread
+
+
 typedef struct
 {
   NV_BYTE     source;                     //  0 - min filtered, 1 - max filtered, 2 - avg/MISP, 3 - all data.
@@ -49,4 +53,49 @@ typedef struct
 } RUN_PROGRESS;
 
 
+//  Output buffer for one band of PFM rows.  For ASCII output data holds the formatted text, for LLZ it holds LLZ_REC
+//  structures, for RDP it holds the three NV_INT32 values of each record, and for SHP it holds the x, y, and z
+//  NV_FLOAT64 values of each point.  row_end is the end offset of each row in data so that the writer can split the
+//  output files on row boundaries.
+
+typedef struct
+{
+  NV_CHAR             *data;
+  size_t              size;
+  size_t              allocated;
+  size_t              *row_end;              //  [band_rows]
+  NV_INT32            *row_count;            //  [band_rows] number of records output for each row
+} EXTRACT_SLOT;
+
+
+//  Shared state for the extract threads and the file writer.  The PFM rows are extracted in bands of band_rows rows.
+//  The threads take bands in order and put the results in one of num_slots slots.  The writer (the GUI thread) writes
+//  the bands in order and frees the slots so the output is the same no matter how many threads are used.  A thread
+//  won't start a band until its slot is free, so at most num_slots bands are in memory at any one time.
+
+typedef struct
+{
+  QMutex              mutex;
+  QWaitCondition      slot_free;             //  Signaled by the writer when it has written a band
+  QWaitCondition      slot_ready;            //  Signaled by an extract thread when it has finished a band
+  QMutex              geoid_mutex;           //  get_geoid03 is not reentrant
+  NV_INT32            x_start;
+  NV_INT32            y_start;
+  NV_INT32            width;
+  NV_INT32            height;
+  NV_INT32            band_rows;
+  NV_INT32            num_bands;
+  NV_INT32            next_band;             //  Next band to be extracted
+  NV_INT32            write_band;            //  Next band to be written
+  NV_INT32            num_slots;
+  EXTRACT_SLOT        *slot;                 //  [num_slots]
+  NV_BOOL             *ready;                //  [num_slots]
+  NV_INT32            rows_done;
+  NV_INT32            polygon_count;
+  NV_FLOAT64          *polygon_x;
+  NV_FLOAT64          *polygon_y;
+  NV_INT32            zone;
+} EXTRACT_BANDS;
+
+
 #endif
@@ -20,7 +20,7 @@
 
 #ifndef VERSION
 
-#define     VERSION     "PFM Software - pfmExtract V3.17 - 11/03/11"
+#define     VERSION     "PFM Software - pfmExtract V3.18 - 10/19/26"
 
 #endif
 
@@ -352,4 +352,13 @@
 
     Fixed geoid03 application bug.
 
+
+    Version 3.18
+    Jan C. Depner
+    10/19/26
+
+    Extraction is now done by a pool of threads (each with its own PFM handle) reading bands of rows with read_bin_row.
+    The bands are written in order so the output is identical regardless of the number of threads. ASCII output is
+    formatted without printf. Fixed min filtered RDP output scaling and the record count for excluded land points.
+
 */
@@ -266,6 +266,7 @@ void pfmFeature::slotHelpClicked ()
 void 
 pfmFeature::slotCustomButtonClicked (int id __attribute__ ((unused)))
 {
+  rowReader           reader;
   selectThread        select_thread[SELECT_PASSES];
   NV_FLOAT64          lat, lon;
   static NV_INT32     old_percent = -1;
@@ -386,7 +387,14 @@ pfmFeature::slotCustomButtonClicked (int id __attribute__ ((unused)))
     }
 
 
-  //  We open a different handle for each thread so that we don't have any collision problems in the PFM library.
+  //  Start the row reader.  This reads each row of the PFM once (using the main PFM handle) and shares the points with
+  //  all of the selection passes so we don't read the data SELECT_PASSES times.
+
+  reader.read (&options, pfm_handle, &open_args, SELECT_PASSES, start_size * pow (2.0, (NV_FLOAT64) (SELECT_PASSES - 1)));
+
+
+  //  We open a different handle for each thread so that we don't have any collision problems in the PFM library (the
+  //  passes still need pfm_geo_distance for the HPC check).
 
   PFM_OPEN_ARGS l_open_args[SELECT_PASSES];
 
@@ -401,7 +409,7 @@ pfmFeature::slotCustomButtonClicked (int id __attribute__ ((unused)))
       if ((l_pfm_handle[i] = open_existing_pfm_file (&l_open_args[i])) < 0) pfm_error_exit (pfm_error);
 
 
-      select_thread[i].select (&options, l_pfm_handle[i], &l_open_args[i], features, i, start_size);
+      select_thread[i].select (&options, l_pfm_handle[i], &l_open_args[i], &reader, features, i, start_size);
     }
 
 
@@ -433,6 +441,11 @@ pfmFeature::slotCustomButtonClicked (int id __attribute__ ((unused)))
   qApp->processEvents ();
 
 
+  //  The passes are done so the reader will finish up quickly (it skips rows that nobody needs).
+
+  reader.wait ();
+
+
   //  Compute our total possible features.
 
   NV_INT32 total = 0;
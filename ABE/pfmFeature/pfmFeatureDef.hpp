@@ -79,6 +79,33 @@ typedef struct
 } POINT_DATA;
 
 
+//  All of the valid points from one PFM row.  These are read once by the rowReader thread and shared by all of the
+//  selectThread passes.
+
+typedef struct
+{
+  NV_INT32            count;
+  POINT_DATA          *data;
+} ROW_POINTS;
+
+
+//  The points in one of the selectThread bins.  These are stored as separate arrays (instead of an array of POINT_DATA)
+//  so that the compiler can vectorize the octant search loops.  The arrays are grown by doubling "size" and are reused
+//  when the rows are shifted.
+
+typedef struct
+{
+  NV_INT32            count;
+  NV_INT32            size;
+  NV_FLOAT64          *x;
+  NV_FLOAT64          *y;
+  NV_FLOAT64          *z;
+  NV_U_INT32          *l;
+  NV_FLOAT32          *h;
+  NV_FLOAT32          *v;
+} POINT_CELL;
+
+
 //  This feature structure is overkill but, if I can come up with a better method of determining the
 //  shape of the feature, it may be useful in the future.
 
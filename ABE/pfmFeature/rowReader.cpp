@@ -0,0 +1,281 @@
+#include "rowReader.hpp"
+
+rowReader::rowReader (QObject *parent)
+  : QThread(parent)
+{
+  rows = NULL;
+  low_row = NULL;
+  ref_count = NULL;
+}
+
+
+
+rowReader::~rowReader ()
+{
+  if (rows)
+    {
+      for (NV_INT32 i = first_row ; i <= last_row ; i++) free_row (i);
+      free (rows);
+    }
+
+  if (low_row) free (low_row);
+  if (ref_count) free (ref_count);
+}
+
+
+
+//  Set up the row range, the reference counts, and the read ahead window and then start reading.  This has to be called
+//  before any of the selectThread passes are started since they will call getRow and release immediately.
+
+void rowReader::read (OPTIONS *op, NV_INT32 ph, PFM_OPEN_ARGS *oa, NV_INT32 passes, NV_FLOAT64 max_bin_size)
+{
+  NV_F64_COORD2       xy;
+  NV_I32_COORD2       coord;
+  NV_FLOAT64          lat, lon;
+
+
+  QMutexLocker locker (&mutex);
+
+  l_options = op;
+  l_pfm_handle = ph;
+  l_open_args = *oa;
+  l_passes = passes;
+
+
+  //  The passes read PFM rows from the southern edge of the selection area to, at most, three bin_size bins (at the largest
+  //  bin size) past the northern edge.  The column range is the same for every pass since it only depends on the longitude
+  //  limits of the area.
+
+  newgp (l_options->mbr.min_y, l_options->mbr.min_x, 0.0, 1.0, &lat, &lon);
+
+  NV_FLOAT64 max_bin_degrees = (lat - l_options->mbr.min_y) * max_bin_size;
+
+  xy.x = l_options->mbr.min_x;
+  xy.y = l_options->mbr.min_y;
+  compute_index_ptr (xy, &coord, &l_open_args.head);
+  first_row = qMax (coord.y, 0);
+  start_col = qMax (coord.x, 0);
+
+  xy.x = l_options->mbr.max_x;
+  xy.y = l_options->mbr.max_y + 3.0 * max_bin_degrees;
+  compute_index_ptr (xy, &coord, &l_open_args.head);
+  last_row = qMin (coord.y, l_open_args.head.bin_height - 1);
+  end_col = qMin (coord.x, l_open_args.head.bin_width - 1);
+
+
+  //  A pass never needs more than about three of the largest bins worth of rows at once (the pre-load of the first
+  //  three overlapping rows).  We give it twice that plus a bit so that the faster passes don't stall too often.
+
+  window = (NV_INT32) (6.0 * max_bin_degrees / l_open_args.head.y_bin_size_degrees) + 16;
+
+
+  NV_INT32 num_rows = last_row - first_row + 1;
+
+  rows = (ROW_POINTS **) calloc (num_rows, sizeof (ROW_POINTS *));
+
+  if (rows == NULL)
+    {
+      perror ("Allocating rows array");
+      exit (-1);
+    }
+
+  ref_count = (NV_INT32 *) calloc (num_rows, sizeof (NV_INT32));
+
+  if (ref_count == NULL)
+    {
+      perror ("Allocating ref_count array");
+      exit (-1);
+    }
+
+  for (NV_INT32 i = 0 ; i < num_rows ; i++) ref_count[i] = l_passes;
+
+  low_row = (NV_INT32 *) calloc (l_passes, sizeof (NV_INT32));
+
+  if (low_row == NULL)
+    {
+      perror ("Allocating low_row array");
+      exit (-1);
+    }
+
+  for (NV_INT32 i = 0 ; i < l_passes ; i++) low_row[i] = first_row;
+
+  loaded_row = first_row - 1;
+
+
+  if (!isRunning ()) start ();
+}
+
+
+
+//  Returns the points for PFM row "row", waiting for the reader if it hasn't gotten there yet.  Rows outside of the area
+//  return NULL.  The returned pointer is good until the calling pass releases the row.
+
+ROW_POINTS *rowReader::getRow (NV_INT32 row)
+{
+  if (row < first_row || row > last_row) return (NULL);
+
+  QMutexLocker locker (&mutex);
+
+  while (row > loaded_row) row_loaded.wait (&mutex);
+
+  return (rows[row - first_row]);
+}
+
+
+
+//  Tells the reader that "pass" no longer needs any rows below "row".  The passes move from south to north so this only
+//  ever moves up.
+
+void rowReader::release (NV_INT32 pass, NV_INT32 row)
+{
+  QMutexLocker locker (&mutex);
+
+  row = qMin (row, last_row + 1);
+
+  for (NV_INT32 i = low_row[pass] ; i < row ; i++)
+    {
+      ref_count[i - first_row]--;
+
+      if (!ref_count[i - first_row] && i <= loaded_row) free_row (i);
+    }
+
+  if (row > low_row[pass]) low_row[pass] = row;
+
+  row_released.wakeAll ();
+}
+
+
+
+//  Must be called with the mutex locked (or from the destructor).
+
+void rowReader::free_row (NV_INT32 row)
+{
+  ROW_POINTS *points = rows[row - first_row];
+
+  if (points)
+    {
+      if (points->data) free (points->data);
+      free (points);
+      rows[row - first_row] = NULL;
+    }
+}
+
+
+
+void rowReader::run ()
+{
+  NV_INT32            numrecs, width;
+  BIN_RECORD          *bin;
+  DEPTH_RECORD        *in_depth;
+
+
+  width = end_col - start_col + 1;
+
+  bin = (BIN_RECORD *) calloc (width, sizeof (BIN_RECORD));
+
+  if (bin == NULL)
+    {
+      perror ("Allocating bin array");
+      exit (-1);
+    }
+
+
+  for (NV_INT32 row = first_row ; row <= last_row ; row++)
+    {
+      //  Don't get more than "window" rows ahead of the slowest pass.
+
+      mutex.lock ();
+
+      NV_INT32 min_low = last_row + 1;
+      for (NV_INT32 i = 0 ; i < l_passes ; i++) min_low = qMin (min_low, low_row[i]);
+
+      while (row > min_low + window)
+        {
+          row_released.wait (&mutex);
+
+          min_low = last_row + 1;
+          for (NV_INT32 i = 0 ; i < l_passes ; i++) min_low = qMin (min_low, low_row[i]);
+        }
+
+
+      //  If every pass has already moved past this row there's no point in reading it.
+
+      NV_BOOL needed = (ref_count[row - first_row] > 0);
+
+      mutex.unlock ();
+
+
+      ROW_POINTS *points = NULL;
+
+      if (needed)
+        {
+          points = (ROW_POINTS *) calloc (1, sizeof (ROW_POINTS));
+
+          if (points == NULL)
+            {
+              perror ("Allocating points");
+              exit (-1);
+            }
+
+          read_bin_row (l_pfm_handle, width, row, start_col, bin);
+
+          for (NV_INT32 k = 0 ; k < width ; k++)
+            {
+              if (bin[k].num_soundings && !read_depth_array_index (l_pfm_handle, bin[k].coord, &in_depth, &numrecs))
+                {
+                  points->data = (POINT_DATA *) realloc (points->data, (points->count + numrecs) * sizeof (POINT_DATA));
+
+                  if (points->data == NULL)
+                    {
+                      perror ("Allocating points->data array");
+                      exit (-1);
+                    }
+
+                  for (NV_INT32 m = 0 ; m < numrecs ; m++)
+                    {
+                      //  Don't use invalid, deleted, or reference points.
+
+                      if (!(in_depth[m].validity & (PFM_INVAL | PFM_DELETED | PFM_REFERENCE)))
+                        {
+                          //  Add in the offset (if any).
+
+                          in_depth[m].xyz.z += l_options->offset;
+
+
+                          //  Check for above zero inclusion.
+
+                          if (l_options->zero || in_depth[m].xyz.z >= 0.0)
+                            {
+                              points->data[points->count].xyz = in_depth[m].xyz;
+                              points->data[points->count].l = in_depth[m].line_number;
+                              points->data[points->count].h = in_depth[m].horizontal_error;
+                              points->data[points->count].v = in_depth[m].vertical_error;
+                              points->count++;
+                            }
+                        }
+                    }
+
+                  free (in_depth);
+                }
+            }
+        }
+
+
+      mutex.lock ();
+
+      rows[row - first_row] = points;
+
+
+      //  Somebody may have released this row while we were reading it.
+
+      if (!ref_count[row - first_row]) free_row (row);
+
+      loaded_row = row;
+
+      row_loaded.wakeAll ();
+
+      mutex.unlock ();
+    }
+
+  free (bin);
+}
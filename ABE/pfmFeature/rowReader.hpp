@@ -0,0 +1,58 @@
+#ifndef ROWREADER_H
+#define ROWREADER_H
+
+
+#include "pfmFeatureDef.hpp"
+
+
+/*
+
+    The rowReader thread reads each row of the PFM once and hands the valid points in that row to all of the
+    selectThread passes.  Each row is reference counted by the number of passes.  A pass calls getRow to get a
+    row (waiting if it hasn't been read yet) and calls release when it no longer needs any row below a given
+    row.  When every pass has released a row its memory is freed.  The reader won't get more than "window" rows
+    ahead of the slowest pass so the memory used is bounded no matter how big the PFM is.
+
+*/
+
+class rowReader:public QThread
+{
+  Q_OBJECT 
+
+
+public:
+
+  rowReader (QObject *parent = 0);
+  ~rowReader ();
+
+  void read (OPTIONS *op = NULL, NV_INT32 ph = -1, PFM_OPEN_ARGS *oa = NULL, NV_INT32 passes = 0, NV_FLOAT64 max_bin_size = 0.0);
+
+  ROW_POINTS *getRow (NV_INT32 row);
+  void release (NV_INT32 pass, NV_INT32 row);
+
+
+protected:
+
+
+  QMutex           mutex;
+
+  QWaitCondition   row_loaded, row_released;
+
+  OPTIONS          *l_options;
+
+  PFM_OPEN_ARGS    l_open_args;
+
+  NV_INT32         l_pfm_handle, l_passes, first_row, last_row, start_col, end_col, loaded_row, window, *low_row, *ref_count;
+
+  ROW_POINTS       **rows;
+
+  void             run ();
+  void             free_row (NV_INT32 row);
+
+
+protected slots:
+
+private:
+};
+
+#endif
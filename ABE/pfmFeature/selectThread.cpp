@@ -13,13 +13,14 @@ selectThread::~selectThread ()
 
 
 
-void selectThread::select (OPTIONS *op, NV_INT32 ph, PFM_OPEN_ARGS *oa, FEATURE **f, NV_INT32 p, NV_FLOAT64 ss)
+void selectThread::select (OPTIONS *op, NV_INT32 ph, PFM_OPEN_ARGS *oa, rowReader *rr, FEATURE **f, NV_INT32 p, NV_FLOAT64 ss)
 {
   QMutexLocker locker (&mutex);
 
   l_options = op;
   l_pfm_handle = ph;
   l_open_args = *oa;
+  l_reader = rr;
   l_features = f;
   l_pass = p;
   l_start_size = ss;
@@ -29,16 +30,148 @@ void selectThread::select (OPTIONS *op, NV_INT32 ph, PFM_OPEN_ARGS *oa, FEATURE
 
 
 
+//  Add a point to a bin.  The arrays are grown by doubling so that we don't realloc for every point.
+
+void selectThread::add_point (POINT_CELL *cell, POINT_DATA *point)
+{
+  if (cell->count == cell->size)
+    {
+      cell->size = qMax (cell->size * 2, 64);
+
+      cell->x = (NV_FLOAT64 *) realloc (cell->x, cell->size * sizeof (NV_FLOAT64));
+      cell->y = (NV_FLOAT64 *) realloc (cell->y, cell->size * sizeof (NV_FLOAT64));
+      cell->z = (NV_FLOAT64 *) realloc (cell->z, cell->size * sizeof (NV_FLOAT64));
+      cell->l = (NV_U_INT32 *) realloc (cell->l, cell->size * sizeof (NV_U_INT32));
+      cell->h = (NV_FLOAT32 *) realloc (cell->h, cell->size * sizeof (NV_FLOAT32));
+      cell->v = (NV_FLOAT32 *) realloc (cell->v, cell->size * sizeof (NV_FLOAT32));
+
+      if (cell->x == NULL || cell->y == NULL || cell->z == NULL || cell->l == NULL || cell->h == NULL || cell->v == NULL)
+        {
+          perror ("Allocating cell arrays");
+          exit (-1);
+        }
+    }
+
+  cell->x[cell->count] = point->xyz.x;
+  cell->y[cell->count] = point->xyz.y;
+  cell->z[cell->count] = point->xyz.z;
+  cell->l[cell->count] = point->l;
+  cell->h[cell->count] = point->h;
+  cell->v[cell->count] = point->v;
+
+  cell->count++;
+}
+
+
+
+//  Put the points from PFM rows start_row through end_row into the bins.  The points may fall in 1, 2, or 4 bins due to
+//  overlap.  When we're pre-loading the first three rows (preload set) we accept anything in rows 0 through 3 (relative
+//  to startlat).  Otherwise we only want to add data to the [2] row since the data in the overlap area of the [1] row has
+//  already been loaded.  We have redundant reads due to this but this way we don't have to run through row [1] looking
+//  for data in the overlap area with row [2].  The rows come from the rowReader so the redundant reads don't cost us any
+//  I/O.
+
+void selectThread::load_rows (rowReader *reader, NV_INT32 start_row, NV_INT32 end_row, OPTIONS *options, NV_FLOAT64 startlat,
+                              NV_FLOAT64 x_meter_degrees, NV_FLOAT64 y_meter_degrees, NV_FLOAT64 two_thirds_bin_meters,
+                              NV_FLOAT64 bin_overlap_meters, NV_INT32 num_cols, NV_BOOL preload, POINT_CELL **cells)
+{
+  for (NV_INT32 j = start_row ; j <= end_row ; j++)
+    {
+      ROW_POINTS *points = reader->getRow (j);
+
+      if (points == NULL) continue;
+
+      for (NV_INT32 m = 0 ; m < points->count ; m++)
+        {
+          POINT_DATA *point = &points->data[m];
+
+
+          //  We have to figure out which third of the bin, in both X and Y, that the point is in so that we can tell how many
+          //  total bins it will fall in.
+
+          NV_FLOAT64 x_meter = (point->xyz.x - options->mbr.min_x) / x_meter_degrees;
+          NV_FLOAT64 y_meter = (point->xyz.y - startlat) / y_meter_degrees;
+
+
+          //  These are the indices for the main bin that this point falls in (lower 2/3 of bin determines main bin).
+
+          NV_INT32 col = (NV_INT32) (x_meter / two_thirds_bin_meters);
+          NV_INT32 row = (NV_INT32) (y_meter / two_thirds_bin_meters);
+
+
+          //  Make sure we're inside our latest latitude band.
+
+          NV_BOOL inside;
+          if (preload)
+            {
+              inside = (x_meter >= 0.0 && y_meter >= 0.0 && row >= 0 && row <= 3 && col >= 0 && col <= (num_cols - 1));
+            }
+          else
+            {
+              inside = (x_meter >= 0.0 && (row == 2 || row == 3) && col >= 0 && col <= (num_cols - 1));
+            }
+
+          if (!inside) continue;
+
+
+          //  If the row == 3 then this point MAY be in the top third of the top row so we want to check it
+          //  and add it to row 2 if it is.
+
+          if (row < 3 || (row == 3 && fmod (y_meter, two_thirds_bin_meters) < bin_overlap_meters))
+            {
+              NV_BOOL top_row = NVFalse;
+              if (row == 3)
+                {
+                  top_row = NVTrue;
+                  row = 2;
+                }
+
+              add_point (&cells[row][col], point);
+
+
+              //  Check for X overlap.  If the main bin is not at 0, we have a point in the previous bin.
+
+              NV_BOOL x_overlap = NVFalse;
+              NV_BOOL y_overlap = NVFalse;
+              if (col && fmod (x_meter, two_thirds_bin_meters) < bin_overlap_meters)
+                {
+                  x_overlap = NVTrue;
+
+                  add_point (&cells[row][col - 1], point);
+                }
+
+
+              //  Check for Y overlap (only if not in top third of top row).
+
+              if (row && !top_row && fmod (y_meter, two_thirds_bin_meters) < bin_overlap_meters)
+                {
+                  y_overlap = NVTrue;
+
+                  add_point (&cells[row - 1][col], point);
+                }
+
+
+              //  If both X and Y had overlap then we also need to add it to the bin left and below this bin.
+
+              if (x_overlap && y_overlap) add_point (&cells[row - 1][col - 1], point);
+            }
+        }
+    }
+}
+
+
+
 void selectThread::run ()
 {
-  NV_INT32            percent = 0, old_percent = -1, numrecs, num_cols[3], **depth_count, **min_index, features_count;
+  NV_INT32            percent = 0, old_percent = -1, num_cols[3], *min_index[3], features_count, scratch_size = 0;
   NV_U_INT32          hpc_lines[1024];
   NV_F64_COORD2       xy, order[2] = {{1.0, 0.05}, {2.0, 0.10}};
   NV_I32_COORD2       coord;
   NV_BOOL             oct_hit[8];
   NV_F64_COORD3       oct_pos[8];
-  POINT_DATA          ***depth = NULL;
-  DEPTH_RECORD        *in_depth = NULL;
+  POINT_CELL          *cells[3];
+  NV_FLOAT64          *dist2 = NULL;
+  NV_U_BYTE           *oct_mask = NULL;
   NV_FLOAT64          lat, lon, x_bin_size_degrees[3], x_meter_degrees[3], x_two_thirds_bin_degrees[3], min_dist[8];
   QString             string;
 
@@ -48,6 +181,7 @@ void selectThread::run ()
   OPTIONS *options = l_options;
   NV_INT32 pfm_handle = l_pfm_handle;
   PFM_OPEN_ARGS open_args = l_open_args;
+  rowReader *reader = l_reader;
   FEATURE **features = l_features;
   NV_INT32 pass = l_pass;
   NV_FLOAT64 start_size = l_start_size;
@@ -55,36 +189,6 @@ void selectThread::run ()
   mutex.unlock ();
 
 
-  //qDebug () << __LINE__ << pass;
-
-
-  //  Allocate the base memory pointers.
-
-  depth = (POINT_DATA ***) calloc (3, sizeof (POINT_DATA **));
-
-  if (depth == NULL)
-    {
-      perror ("Allocating depth array");
-      exit (-1);
-    }
-
-  depth_count = (NV_INT32 **) calloc (3, sizeof (NV_INT32 *));
-
-  if (depth_count == NULL)
-    {
-      perror ("Allocating depth_count array");
-      exit (-1);
-    }
-
-  min_index = (NV_INT32 **) calloc (3, sizeof (NV_INT32 *));
-
-  if (min_index == NULL)
-    {
-      perror ("Allocating min_index array");
-      exit (-1);
-    }
-
-
   NV_FLOAT64 bin_size = pow (2.0, (NV_FLOAT64) pass) * start_size;
 
 
@@ -139,21 +243,12 @@ void selectThread::run ()
 
   for (NV_INT32 i = 0 ; i < 3 ; i++)
     {
-      depth[i] = (POINT_DATA **) calloc (save_size, sizeof (POINT_DATA *));
+      cells[i] = (POINT_CELL *) calloc (save_size, sizeof (POINT_CELL));
 
-      if (depth[i] == NULL)
+      if (cells[i] == NULL)
         {
           fprintf(stderr, "%s %d %d\n",__FILE__,__LINE__,save_size);
-          perror ("Allocating depth[i] array");
-          exit (-1);
-        }
-
-
-      depth_count[i] = (NV_INT32 *) calloc (save_size, sizeof (NV_INT32));
-
-      if (depth_count[i] == NULL)
-        {
-          perror ("Allocating depth_count[i] array");
+          perror ("Allocating cells[i] array");
           exit (-1);
         }
 
@@ -165,22 +260,16 @@ void selectThread::run ()
           perror ("Allocating min_index[i] array");
           exit (-1);
         }
-
-
-      //  Just in case NULL is not the same as 0.
-
-      for (NV_INT32 j = 0 ; j < save_size ; j++) depth[i][j] = NULL;
     }
 
 
   //  Pre-load the first three rows of data.
 
-  //qDebug () << __LINE__ << pass;
   for (NV_INT32 i = 0 ; i < 3 ; i++)
     {
       //  startlat is the latitude of the bottom of all three rows.
 
-      NV_FLOAT64 startlat = options->mbr.min_y + (NV_FLOAT64) (i / 3) * y_two_thirds_bin_degrees;
+      NV_FLOAT64 startlat = options->mbr.min_y;
 
 
       //  newlat is the latitude of the bottom of the current row.
@@ -208,7 +297,6 @@ void selectThread::run ()
 
       compute_index_ptr (xy, &coord, &open_args.head);
 
-      NV_INT32 start_col = coord.x;
       NV_INT32 start_row = coord.y;
 
 
@@ -217,196 +305,12 @@ void selectThread::run ()
 
       compute_index_ptr (xy, &coord, &open_args.head);
 
-      NV_INT32 end_col = coord.x;
       NV_INT32 end_row = coord.y;
 
-      //qDebug () << __LINE__ << pass << i << start_col << end_col << start_row << end_row;
-
-      for (NV_INT32 j = start_row ; j <= end_row ; j++)
-        {
-          coord.y = j;
-
-          for (NV_INT32 k = start_col ; k <= end_col ; k++)
-            {
-              coord.x = k;
-
-
-              BIN_RECORD bin;
-              read_bin_record_index (pfm_handle, coord, &bin);
-
-              if (bin.num_soundings)
-                {
-                  //  Read the depth chain for the selected PFM bin.
-
-                  //qDebug () << __LINE__ << pass << j << k;
-
-                  if (!read_depth_array_index (pfm_handle, coord, &in_depth, &numrecs))
-                    {
-                      //qDebug () << __LINE__ << numrecs << pass;
-                      for (NV_INT32 m = 0 ; m < numrecs ; m++)
-                        {
-                          //  Don't use invalid, deleted, or reference points.
-
-                          if (!(in_depth[m].validity & (PFM_INVAL | PFM_DELETED | PFM_REFERENCE)))
-                            {
-                              //  Add in the offset (if any).
-
-                              in_depth[m].xyz.z += l_options->offset;
-
-
-                              //  Check for above zero inclusion.
-
-                              if (options->zero || in_depth[m].xyz.z >= 0.0)
-                                {
-                                  //  The points may fall in 1, 2, or 4 bins due to overlap.  We have to figure out which
-                                  //  third of the bin, in both X and Y, that the point is in so that we can tell how many
-                                  //  total bins it will fall in.
-
-                                  NV_FLOAT64 x_meter = (in_depth[m].xyz.x - options->mbr.min_x) / x_meter_degrees[i];
-                                  NV_FLOAT64 y_meter = (in_depth[m].xyz.y - startlat) / y_meter_degrees;
-
-
-                                  //  These are the indices for the main bin that this point falls in (lower 2/3 of bin determines
-                                  //  main bin).
-
-                                  NV_INT32 col = (NV_INT32) (x_meter / two_thirds_bin_meters);
-                                  NV_INT32 row = (NV_INT32) (y_meter / two_thirds_bin_meters);
-
-
-                                  //  Make sure we're inside our latest latitude band.
-
-                                  if (x_meter >= 0.0 && y_meter >= 0.0 && row >= 0 && row <= 3 && col >= 0 && col <= (num_cols[i] - 1))
-                                    {
-#ifdef __PFM_FEATURE_DEBUG__
-                                      if (col >= save_size)
-                                        {
-                                          fprintf(stderr,"%s %d %d %d\n",__FILE__,__LINE__,col,save_size);
-                                          exit (-1);
-                                        }
-#endif
-
-                                      //  If the row == 3 then this point MAY be in the top third of the top row so we want to check it
-                                      //  and add it to row 2 if it is.
 
-                                      if (row < 3 || (row == 3 && fmod (y_meter, two_thirds_bin_meters) < bin_overlap_meters))
-                                        {
-                                          NV_BOOL top_row = NVFalse;
-                                          if (row == 3)
-                                            {
-                                              top_row = NVTrue;
-                                              row = 2;
-                                            }
-
-                                          depth[row][col] = (POINT_DATA *) realloc (depth[row][col], (depth_count[row][col] + 1) * sizeof (POINT_DATA));
-
-                                          if (depth[row][col] == NULL)
-                                            {
-                                              perror ("Allocating depth[row][col] array");
-                                              exit (-1);
-                                            }
-
-                                          depth[row][col][depth_count[row][col]].xyz = in_depth[m].xyz;
-                                          depth[row][col][depth_count[row][col]].l = in_depth[m].line_number;
-                                          depth[row][col][depth_count[row][col]].h = in_depth[m].horizontal_error;
-                                          depth[row][col][depth_count[row][col]].v = in_depth[m].vertical_error;
-
-                                          depth_count[row][col]++;
-
-
-                                          //  Check for X overlap.
-
-                                          NV_BOOL x_overlap = NVFalse;
-                                          NV_BOOL y_overlap = NVFalse;
-                                          if (fmod (x_meter, two_thirds_bin_meters) < bin_overlap_meters)
-                                            {
-                                              //  If the main bin is not at 0, we have a point in the previous bin.
-
-                                              if (col)
-                                                {
-                                                  x_overlap = NVTrue;
-
-                                                  depth[row][col - 1] = (POINT_DATA *) realloc (depth[row][col - 1], (depth_count[row][col - 1] + 1) *
-                                                                                                sizeof (POINT_DATA));
-
-                                                  if (depth[row][col - 1] == NULL)
-                                                    {
-                                                      perror ("Allocating depth[row][col - 1] array");
-                                                      exit (-1);
-                                                    }
-
-                                                  depth[row][col - 1][depth_count[row][col - 1]].xyz = in_depth[m].xyz;
-                                                  depth[row][col - 1][depth_count[row][col - 1]].l = in_depth[m].line_number;
-                                                  depth[row][col - 1][depth_count[row][col - 1]].h = in_depth[m].horizontal_error;
-                                                  depth[row][col - 1][depth_count[row][col - 1]].v = in_depth[m].vertical_error;
-
-                                                  depth_count[row][col - 1]++;
-                                                }
-                                            }
-
-
-                                          //  Check for Y overlap (only if not in top third of top row).
-
-                                          if (!top_row && fmod (y_meter, two_thirds_bin_meters) < bin_overlap_meters)
-                                            {
-                                              //  If the main bin is not at 0, we have a point in the previous bin.
-
-                                              if (row)
-                                                {
-                                                  y_overlap = NVTrue;
-
-                                                  depth[row - 1][col] = (POINT_DATA *) realloc (depth[row - 1][col], (depth_count[row - 1][col] + 1) *
-                                                                                                sizeof (POINT_DATA));
-
-                                                  if (depth[row - 1][col] == NULL)
-                                                    {
-                                                      perror ("Allocating depth[row - 1][col] array");
-                                                      exit (-1);
-                                                    }
-
-                                                  depth[row - 1][col][depth_count[row - 1][col]].xyz = in_depth[m].xyz;
-                                                  depth[row - 1][col][depth_count[row - 1][col]].l = in_depth[m].line_number;
-                                                  depth[row - 1][col][depth_count[row - 1][col]].h = in_depth[m].horizontal_error;
-                                                  depth[row - 1][col][depth_count[row - 1][col]].v = in_depth[m].vertical_error;
-
-                                                  depth_count[row - 1][col]++;
-                                                }
-                                            }
-
-
-                                          //  If both X and Y had overlap then we also need to add it to the bin left and below this
-                                          //  bin.
-
-                                          if (x_overlap && y_overlap && row && col)
-                                            {
-                                              depth[row - 1][col - 1] = (POINT_DATA *) realloc (depth[row - 1][col - 1], (depth_count[row - 1][col - 1] + 1) *
-                                                                                                sizeof (POINT_DATA));
-
-                                              if (depth[row - 1][col - 1] == NULL)
-                                                {
-                                                  perror ("Allocating depth[row - 1][col - 1] array");
-                                                  exit (-1);
-                                                }
-
-                                              depth[row - 1][col - 1][depth_count[row - 1][col - 1]].xyz = in_depth[m].xyz;
-                                              depth[row - 1][col - 1][depth_count[row - 1][col - 1]].l = in_depth[m].line_number;
-                                              depth[row - 1][col - 1][depth_count[row - 1][col - 1]].h = in_depth[m].horizontal_error;
-                                              depth[row - 1][col - 1][depth_count[row - 1][col - 1]].v = in_depth[m].vertical_error;
-
-                                              depth_count[row - 1][col - 1]++;
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                        }
-
-                      free (in_depth);
-                    }
-                }
-            }
-        }
+      load_rows (reader, start_row, end_row, options, startlat, x_meter_degrees[i], y_meter_degrees, two_thirds_bin_meters,
+                 bin_overlap_meters, num_cols[i], NVTrue, cells);
     }
-  //qDebug () << __LINE__ << pass;
 
 
   //  Compute mins for the first three rows.
@@ -420,27 +324,17 @@ void selectThread::run ()
           NV_FLOAT64 min_depth = 999999999.0;
           min_index[i][j] = -1;
 
-          for (NV_INT32 k = 0 ; k < depth_count[i][j] ; k++)
+          for (NV_INT32 k = 0 ; k < cells[i][j].count ; k++)
             {
-
-#ifdef __PFM_FEATURE_DEBUG__
-              if (j >= save_size)
+              if (cells[i][j].z[k] <= min_depth)
                 {
-                  fprintf(stderr,"%s %d %d %d\n",__FILE__,__LINE__,j,save_size);
-                  exit (-1);
-                }
-#endif
-
-              if (depth[i][j][k].xyz.z <= min_depth)
-                {
-                  min_depth = depth[i][j][k].xyz.z;
+                  min_depth = cells[i][j].z[k];
                   min_index[i][j] = k;
                 }
             }
         }
     }
 
-  //qDebug () << __LINE__ << pass;
 
   //  Here we loop through the entire PFM looking for minimums in each bin and comparing them to maximums in
   //  8 octants to see if we have a possible feature.  Once per row of bin_size sized bins (with 1/3 bin_size 
@@ -461,6 +355,15 @@ void selectThread::run ()
           p = 1;
         }
 
+
+      //  Over the distances we're dealing with (three bins at most) we can use a flat earth approximation to compute the
+      //  distances between the minimum and the surrounding points.  This lets us do the whole octant test without calling
+      //  pfm_geo_distance for every point.
+
+      NV_FLOAT64 x_scale = 1.0 / x_meter_degrees[p];
+      NV_FLOAT64 y_scale = 1.0 / y_meter_degrees;
+
+
       for (NV_INT32 j = 0 ; j < num_cols[p] ; j++)
         {
           NV_INT32 start_row = qMax (p - 1, 0);
@@ -472,21 +375,13 @@ void selectThread::run ()
 
           //  Check to make sure that we found some points.
 
-          if (min_index[p][j] >= 0 && depth_count[p][j])
+          if (min_index[p][j] >= 0 && cells[p][j].count)
             {
-
-#ifdef __PFM_FEATURE_DEBUG__
-              if (j >= save_size)
-                {
-                  fprintf(stderr,"%s %d %d %d\n",__FILE__,__LINE__,j,save_size);
-                  exit (-1);
-                }
-#endif
-              lat = depth[p][j][min_index[p][j]].xyz.y;
-              lon = depth[p][j][min_index[p][j]].xyz.x;
-              NV_FLOAT64 min_depth = depth[p][j][min_index[p][j]].xyz.z;
-              NV_FLOAT32 h = depth[p][j][min_index[p][j]].h;
-              NV_FLOAT32 v = depth[p][j][min_index[p][j]].v;
+              lat = cells[p][j].y[min_index[p][j]];
+              lon = cells[p][j].x[min_index[p][j]];
+              NV_FLOAT64 min_depth = cells[p][j].z[min_index[p][j]];
+              NV_FLOAT32 h = cells[p][j].h[min_index[p][j]];
+              NV_FLOAT32 v = cells[p][j].v[min_index[p][j]];
 
 
               memset (oct_hit, 0, sizeof (oct_hit));
@@ -501,59 +396,75 @@ void selectThread::run ()
                 {
                   for (NV_INT32 m = start_col ; m <= end_col ; m++)
                     {
-                      //  Now, determine octant in relation to the minimum for each depth point.
+                      POINT_CELL *cell = &cells[k][m];
 
-                      for (NV_INT32 n = 0 ; n < depth_count[k][m] ; n++)
+                      if (cell->count > scratch_size)
                         {
+                          scratch_size = cell->size;
 
-#ifdef __PFM_FEATURE_DEBUG__
-                          if (m >= save_size)
+                          dist2 = (NV_FLOAT64 *) realloc (dist2, scratch_size * sizeof (NV_FLOAT64));
+                          oct_mask = (NV_U_BYTE *) realloc (oct_mask, scratch_size * sizeof (NV_U_BYTE));
+
+                          if (dist2 == NULL || oct_mask == NULL)
                             {
-                              fprintf(stderr,"%s %d %d %d\n",__FILE__,__LINE__,m,save_size);
+                              perror ("Allocating scratch arrays");
                               exit (-1);
                             }
-#endif
+                        }
 
-                          //  Only if we exceed the order[options->order] do we compute the octant.
 
-                          if (depth[k][m][n].xyz.z - min_depth >= cut)
-                            {
-                              //  Compute the distance between the points to see if we're outside the combined horizontal
-                              //  uncertainty of the two points.
+                      //  Only if we exceed the order[options->order] and we're outside the combined horizontal uncertainty
+                      //  of the two points do we need to compute the octant.  This loop has no branches so that the
+                      //  compiler can vectorize it.  We use squared distances to avoid the sqrt.
 
-                              NV_FLOAT64 dist;
+                      NV_INT32 count = cell->count;
+                      const NV_FLOAT64 *px = cell->x, *py = cell->y, *pz = cell->z;
+                      const NV_FLOAT32 *ph = cell->h;
+
+                      for (NV_INT32 n = 0 ; n < count ; n++)
+                        {
+                          NV_FLOAT64 dx = (px[n] - lon) * x_scale;
+                          NV_FLOAT64 dy = (py[n] - lat) * y_scale;
+                          NV_FLOAT64 hh = (NV_FLOAT64) (ph[n] + h);
 
-                              pfm_geo_distance (pfm_handle, lat, lon, depth[k][m][n].xyz.y, depth[k][m][n].xyz.x, &dist);
+                          dist2[n] = dx * dx + dy * dy;
+                          oct_mask[n] = (pz[n] - min_depth >= cut) & (dist2[n] >= hh * hh);
+                        }
 
 
-                              if (dist >= depth[k][m][n].h + h)
-                                {
-                                  NV_INT32 octant = get_octant (lon, lat, depth[k][m][n].xyz.x, depth[k][m][n].xyz.y);
+                      //  Now, determine octant in relation to the minimum for each depth point that passed.
 
+                      for (NV_INT32 n = 0 ; n < count ; n++)
+                        {
+                          if (oct_mask[n])
+                            {
+                              NV_INT32 octant = get_octant (lon, lat, px[n], py[n]);
 
-                                  //  If we haven't hit this octant before, mark it as a hit and increment the octant count.
 
-                                  if (!oct_hit[octant])
-                                    {
-                                      oct_hits++;
-                                      oct_hit[octant] = NVTrue;
+                              //  If we haven't hit this octant before, mark it as a hit and increment the octant count.
 
+                              if (!oct_hit[octant])
+                                {
+                                  oct_hits++;
+                                  oct_hit[octant] = NVTrue;
 
-                                      //  We will break out of the loop if we reach 8 octant hits but only if we aren't generating
-                                      //  estimated polygon shapes.
 
-                                      if (!options->output_polygons && oct_hits >= 8) break;
-                                    }
+                                  //  We will break out of the loop if we reach 8 octant hits but only if we aren't generating
+                                  //  estimated polygon shapes.
 
+                                  if (!options->output_polygons && oct_hits >= 8) break;
+                                }
 
-                                  //  Find the closest octant points that exceed our cutoff.  This will allow us
-                                  //  to come up with an estimated shape for the feature.
 
-                                  if (options->output_polygons && dist < min_dist[octant])
-                                    {
-                                      min_dist[octant] = dist;
-                                      oct_pos[octant] = depth[k][m][n].xyz;
-                                    }
+                              //  Find the closest octant points that exceed our cutoff.  This will allow us
+                              //  to come up with an estimated shape for the feature.
+
+                              if (options->output_polygons && dist2[n] < min_dist[octant])
+                                {
+                                  min_dist[octant] = dist2[n];
+                                  oct_pos[octant].x = px[n];
+                                  oct_pos[octant].y = py[n];
+                                  oct_pos[octant].z = pz[n];
                                 }
                             }
                         }
@@ -625,21 +536,21 @@ void selectThread::run ()
                         {
                           for (NV_INT32 m = start_col ; m <= end_col ; m++)
                             {
-                              //  Now, determine octant in relation to the minimum for each depth point.
+                              POINT_CELL *cell = &cells[k][m];
 
-                              for (NV_INT32 n = 0 ; n < depth_count[k][m] ; n++)
+                              for (NV_INT32 n = 0 ; n < cell->count ; n++)
                                 {
-                                  if (fabs (depth[k][m][n].xyz.z - features[pass][features_count].z) <= v_cut)
+                                  if (fabs (cell->z[n] - features[pass][features_count].z) <= v_cut)
                                     {
                                       pfm_geo_distance (pfm_handle, features[pass][features_count].y, features[pass][features_count].x,
-                                                        depth[k][m][n].xyz.y, depth[k][m][n].xyz.x, &cut);
+                                                        cell->y[n], cell->x[n], &cut);
 
                                       if (cut <= h_cut)
                                         {
                                           NV_BOOL hit = NVFalse;
                                           for (NV_INT32 p = 0 ; p < hpc_line_count ; p++)
                                             {
-                                              if (depth[k][m][n].l == hpc_lines[p])
+                                              if (cell->l[n] == hpc_lines[p])
                                                 {
                                                   hit = NVTrue;
                                                   break;
@@ -652,7 +563,7 @@ void selectThread::run ()
 
                                           if (!hit)
                                             {
-                                              hpc_lines[hpc_line_count] = depth[k][m][n].l;
+                                              hpc_lines[hpc_line_count] = cell->l[n];
                                               hpc_line_count++;
 
                                               if (hpc_count > 2 && hpc_line_count > 1)
@@ -674,53 +585,24 @@ void selectThread::run ()
 
 
                   features_count++;
-                  //qDebug () << __LINE__ << features_count << pass;
                 }
             }
         }
 
 
       //  Move everything down one row (in the arrays) and then get the next row.   We only want to move up a row after
-      //  we have dealt with the first row.
+      //  we have dealt with the first row.  Since the bins are just pointers we rotate them instead of copying the
+      //  points.  The old [0] row becomes the new [2] row and we reuse its memory.
 
       if (i)
         {
+          POINT_CELL *tmp_cells = cells[0];
+          NV_INT32 *tmp_index = min_index[0];
+
           for (NV_INT32 j = 1 ; j < 3 ; j++)
             {
-              for (NV_INT32 k = 0 ; k < num_cols[j] ; k++)
-                {
-
-#ifdef __PFM_FEATURE_DEBUG__
-                  if (k >= save_size)
-                    {
-                      fprintf(stderr,"%s %d %d %d\n",__FILE__,__LINE__,k,save_size);
-                      exit (-1);
-                    }
-#endif
-
-                  if (depth_count[j][k])
-                    {
-                      depth[j - 1][k] = (POINT_DATA *) realloc (depth[j - 1][k], depth_count[j][k] * sizeof (POINT_DATA));
-
-                      if (depth[j - 1][k] == NULL)
-                        {
-                          perror ("Allocating depth[j - 1][k] array");
-                          exit (-1);
-                        }
-
-
-                      for (NV_INT32 m = 0 ; m < depth_count[j][k] ; m++) depth[j - 1][k][m] = depth[j][k][m];
-
-                      min_index[j - 1][k] = min_index[j][k];
-                      depth_count[j - 1][k] = depth_count[j][k];
-                    }
-                  else
-                    {
-                      depth[j - 1][k] = NULL;
-                      min_index[j - 1][k] = -1;
-                      depth_count[j - 1][k] = 0;
-                    }
-                }
+              cells[j - 1] = cells[j];
+              min_index[j - 1] = min_index[j];
 
               x_meter_degrees[j - 1] = x_meter_degrees[j];
               x_bin_size_degrees[j - 1] = x_bin_size_degrees[j];
@@ -728,26 +610,15 @@ void selectThread::run ()
               num_cols[j - 1] = num_cols[j];
             }
 
+          cells[2] = tmp_cells;
+          min_index[2] = tmp_index;
+
 
           //  Clear the new [2] arrays.
 
-          for (NV_INT32 k = 0 ; k < num_cols[2] ; k++)
+          for (NV_INT32 k = 0 ; k < save_size ; k++)
             {
-
-#ifdef __PFM_FEATURE_DEBUG__
-              if (k >= save_size)
-                {
-                  fprintf(stderr,"%s %d %d %d\n",__FILE__,__LINE__,k,save_size);
-                  exit (-1);
-                }
-#endif
-
-              if (depth[2][k])
-                {
-                  free (depth[2][k]);
-                }
-              depth[2][k] = NULL;
-              depth_count[2][k] = 0;
+              cells[2][k].count = 0;
               min_index[2][k] = -1;
             }
 
@@ -776,7 +647,6 @@ void selectThread::run ()
 
           compute_index_ptr (xy, &coord, &open_args.head);
 
-          NV_INT32 start_col = coord.x;
           NV_INT32 start_row = coord.y;
 
 
@@ -785,199 +655,21 @@ void selectThread::run ()
 
           compute_index_ptr (xy, &coord, &open_args.head);
 
-          NV_INT32 end_col = coord.x;
           NV_INT32 end_row = qMin (coord.y, open_args.head.bin_height - 1);
 
 
-          //  This is where we want to compute the row number from since we want data to be stored in the [2] array.
-          //  We only want to add data to the [2] array since the data in the overlap area of the [1] array has
-          //  already been loaded.  We have redundant reads due to this but this way we don't have to run through array
-          //  [1] looking for data in the overlap area with array [2].
-
-          NV_FLOAT64 startlat = newlat - (2.0 * y_two_thirds_bin_degrees);
+          //  We're never going to need anything below start_row again so let the reader know that it can free those rows
+          //  (once the other passes are done with them).
 
+          reader->release (pass, start_row);
 
-          for (NV_INT32 j = start_row ; j <= end_row ; j++)
-            {
-              coord.y = j;
-
-              for (NV_INT32 k = start_col ; k <= end_col ; k++)
-                {
-                  coord.x = k;
-
-
-                  BIN_RECORD bin;
-                  read_bin_record_index (pfm_handle, coord, &bin);
-
-                  if (bin.num_soundings)
-                    {
-                      if (!read_depth_array_index (pfm_handle, coord, &in_depth, &numrecs))
-                        {
-                          for (NV_INT32 m = 0 ; m < numrecs ; m++)
-                            {
-                              //  Don't use invalid, deleted, or reference points.
 
-                              if (!(in_depth[m].validity & (PFM_INVAL | PFM_DELETED | PFM_REFERENCE)))
-                                {
-                                  //  Add in the offset (if any).
-
-                                  in_depth[m].xyz.z += l_options->offset;
-
-
-                                  //  Check for above zero inclusion.
-
-                                  if (options->zero || in_depth[m].xyz.z >= 0.0)
-                                    {
-                                      //  The points may fall in 1, 2, or 4 bins due to overlap.  We have to figure out which
-                                      //  third of the bin, in both X and Y, that the point is in so that we can tell how many
-                                      //  total bins it will fall in.
-
-                                      NV_FLOAT64 x_meter = (in_depth[m].xyz.x - options->mbr.min_x) / x_meter_degrees[2];
-                                      NV_FLOAT64 y_meter = (in_depth[m].xyz.y - startlat) / y_meter_degrees;
-
-
-                                      //  These are the indices for the main bin that this point falls in.
-
-                                      NV_INT32 col = (NV_INT32) (x_meter / two_thirds_bin_meters);
-                                      NV_INT32 row = (NV_INT32) (y_meter / two_thirds_bin_meters);
-
-
-                                      //  Make sure we're only in the [2] array since we've already loaded the [1] array.
-                                      //  Yeah, I know, if I was clever I could get 1/3 of the data from the [1] array.
-                                      //  That would be a major PITA.
-
-                                      if (x_meter >= 0.0 && (row == 2 || row == 3) && col >= 0 && col <= (num_cols[2] - 1))
-                                        {
-
-#ifdef __PFM_FEATURE_DEBUG__
-                                          if (col >= save_size)
-                                            {
-                                              fprintf(stderr,"%s %d %d %d\n",__FILE__,__LINE__,col,save_size);
-                                              exit (-1);
-                                            }
-#endif
-
-                                          //  If the row == 3 then this point MAY be in the top third of the top row so we want to check it
-                                          //  and add it to row 2 if it is.
-
-                                          if (row < 3 || (row == 3 && fmod (y_meter, two_thirds_bin_meters) < bin_overlap_meters))
-                                            {
-                                              NV_BOOL top_row = NVFalse;
-                                              if (row == 3)
-                                                {
-                                                  top_row = NVTrue;
-                                                  row = 2;
-                                                }
-
-                                              depth[row][col] = (POINT_DATA *) realloc (depth[row][col], (depth_count[row][col] + 1) *
-                                                                                        sizeof (POINT_DATA));
-
-                                              if (depth[row][col] == NULL)
-                                                {
-                                                  perror ("Allocating depth[row][col] array");
-                                                  exit (-1);
-                                                }
-
-                                              depth[row][col][depth_count[row][col]].xyz = in_depth[m].xyz;
-                                              depth[row][col][depth_count[row][col]].l = in_depth[m].line_number;
-                                              depth[row][col][depth_count[row][col]].h = in_depth[m].horizontal_error;
-                                              depth[row][col][depth_count[row][col]].v = in_depth[m].vertical_error;
-
-                                              depth_count[row][col]++;
-
-
-                                              //  Check for X overlap.
-
-                                              NV_BOOL x_overlap = NVFalse;
-                                              NV_BOOL y_overlap = NVFalse;
-                                              if (fmod (x_meter, two_thirds_bin_meters) < bin_overlap_meters)
-                                                {
-                                                  //  If the main bin is not at 0, we have a point in the previous bin.
-
-                                                  if (col)
-                                                    {
-                                                      x_overlap = NVTrue;
-
-                                                      depth[row][col - 1] = (POINT_DATA *) realloc (depth[row][col - 1], (depth_count[row][col - 1] + 1) *
-                                                                                                    sizeof (POINT_DATA));
-
-                                                      if (depth[row][col - 1] == NULL)
-                                                        {
-                                                          perror ("Allocating depth[row][col - 1] array");
-                                                          exit (-1);
-                                                        }
-
-                                                      depth[row][col - 1][depth_count[row][col - 1]].xyz = in_depth[m].xyz;
-                                                      depth[row][col - 1][depth_count[row][col - 1]].l = in_depth[m].line_number;
-                                                      depth[row][col - 1][depth_count[row][col - 1]].h = in_depth[m].horizontal_error;
-                                                      depth[row][col - 1][depth_count[row][col - 1]].v = in_depth[m].vertical_error;
-
-                                                      depth_count[row][col - 1]++;
-                                                    }
-                                                }
-
-
-                                              //  Check for Y overlap (only if not in top third of top row).
-
-                                              if (!top_row && fmod (y_meter, two_thirds_bin_meters) < bin_overlap_meters)
-                                                {
-                                                  //  If the main bin is not at 0, we have a point in the previous bin.
-
-                                                  if (row)
-                                                    {
-                                                      y_overlap = NVTrue;
-
-                                                      depth[row - 1][col] = (POINT_DATA *) realloc (depth[row - 1][col], (depth_count[row - 1][col] + 1) *
-                                                                                                    sizeof (POINT_DATA));
-
-                                                      if (depth[row - 1][col] == NULL)
-                                                        {
-                                                          perror ("Allocating depth[row - 1][col] array");
-                                                          exit (-1);
-                                                        }
-
-                                                      depth[row - 1][col][depth_count[row - 1][col]].xyz = in_depth[m].xyz;
-                                                      depth[row - 1][col][depth_count[row - 1][col]].l = in_depth[m].line_number;
-                                                      depth[row - 1][col][depth_count[row - 1][col]].h = in_depth[m].horizontal_error;
-                                                      depth[row - 1][col][depth_count[row - 1][col]].v = in_depth[m].vertical_error;
-
-                                                      depth_count[row - 1][col]++;
-                                                    }
-                                                }
-
-
-                                              //  If both X and Y had overlap then we also need to add it to the bin left and below
-                                              //  this bin.
-
-                                              if (x_overlap && y_overlap && row && col)
-                                                {
-                                                  depth[row - 1][col - 1] = (POINT_DATA *) realloc (depth[row - 1][col - 1], (depth_count[row - 1][col - 1] + 1) *
-                                                                                                    sizeof (POINT_DATA));
-
-                                                  if (depth[row - 1][col - 1] == NULL)
-                                                    {
-                                                      perror ("Allocating depth[row - 1][col - 1] array");
-                                                      exit (-1);
-                                                    }
-
-                                                  depth[row - 1][col - 1][depth_count[row - 1][col - 1]].xyz = in_depth[m].xyz;
-                                                  depth[row - 1][col - 1][depth_count[row - 1][col - 1]].l = in_depth[m].line_number;
-                                                  depth[row - 1][col - 1][depth_count[row - 1][col - 1]].h = in_depth[m].horizontal_error;
-                                                  depth[row - 1][col - 1][depth_count[row - 1][col - 1]].v = in_depth[m].vertical_error;
+          //  This is where we want to compute the row number from since we want data to be stored in the [2] array.
 
-                                                  depth_count[row - 1][col - 1]++;
-                                                }
-                                            }
-                                        }
-                                    }
-                                }
-                            }
+          NV_FLOAT64 startlat = newlat - (2.0 * y_two_thirds_bin_degrees);
 
-                          free (in_depth);
-                        }
-                    }
-                }
-            }
+          load_rows (reader, start_row, end_row, options, startlat, x_meter_degrees[2], y_meter_degrees, two_thirds_bin_meters,
+                     bin_overlap_meters, num_cols[2], NVFalse, cells);
 
 
           //  Compute mins for the new row.
@@ -989,20 +681,11 @@ void selectThread::run ()
               NV_FLOAT64 min_depth = 999999999.0;
               min_index[2][j] = -1;
 
-              for (NV_INT32 k = 0 ; k < depth_count[2][j] ; k++)
+              for (NV_INT32 k = 0 ; k < cells[2][j].count ; k++)
                 {
-
-#ifdef __PFM_FEATURE_DEBUG__
-                  if (j >= save_size)
+                  if (cells[2][j].z[k] < min_depth)
                     {
-                      fprintf(stderr,"%s %d %d %d\n",__FILE__,__LINE__,j,save_size);
-                      exit (-1);
-                    }
-#endif
-
-                  if (depth[2][j][k].xyz.z < min_depth)
-                    {
-                      min_depth = depth[2][j][k].xyz.z;
+                      min_depth = cells[2][j].z[k];
                       min_index[2][j] = k;
                     }
                 }
@@ -1021,30 +704,33 @@ void selectThread::run ()
     }
 
 
+  //  Let the reader know that we don't need any more rows.
+
+  reader->release (pass, open_args.head.bin_height);
+
+
   for (NV_INT32 i = 0 ; i < 3 ; i++)
     {
-      for (NV_INT32 j = 0 ; j < num_cols[i] ; j++)
+      for (NV_INT32 j = 0 ; j < save_size ; j++)
         {
-
-#ifdef __PFM_FEATURE_DEBUG__
-          if (j >= save_size)
+          if (cells[i][j].size)
             {
-              fprintf(stderr,"%s %d %d %d\n",__FILE__,__LINE__,j,save_size);
-              exit (-1);
+              free (cells[i][j].x);
+              free (cells[i][j].y);
+              free (cells[i][j].z);
+              free (cells[i][j].l);
+              free (cells[i][j].h);
+              free (cells[i][j].v);
             }
-#endif
-
-          if (depth[i][j]) free (depth[i][j]);
         }
 
-      if (depth_count[i]) free (depth_count[i]);
-      if (min_index[i]) free (min_index[i]);
-
-      if (depth[i]) free (depth[i]);
+      free (cells[i]);
+      free (min_index[i]);
     }
 
+  if (dist2) free (dist2);
+  if (oct_mask) free (oct_mask);
 
-  //qDebug () << __LINE__ << features_count << pass;
 
   emit completed (features_count, pass);
   qApp->processEvents ();
@@ -3,6 +3,7 @@
 
 
 #include "pfmFeatureDef.hpp"
+#include "rowReader.hpp"
 
 
 class selectThread:public QThread
@@ -15,7 +16,8 @@ public:
   selectThread (QObject *parent = 0);
   ~selectThread ();
 
-  void select (OPTIONS *op = NULL, NV_INT32 ph = -1, PFM_OPEN_ARGS *oa = NULL, FEATURE **f = NULL, NV_INT32 pass = 0, NV_FLOAT64 ss = 0.0);
+  void select (OPTIONS *op = NULL, NV_INT32 ph = -1, PFM_OPEN_ARGS *oa = NULL, rowReader *rr = NULL, FEATURE **f = NULL, NV_INT32 pass = 0,
+               NV_FLOAT64 ss = 0.0);
 
 
 signals:
@@ -35,6 +37,8 @@ protected:
 
   FEATURE          **l_features;
 
+  rowReader        *l_reader;
+
   NV_INT32         l_pass, l_pfm_handle;
 
   NV_FLOAT64       l_start_size;
@@ -43,6 +47,10 @@ protected:
 
   void             run ();
   NV_U_BYTE        get_octant (NV_FLOAT64 x0, NV_FLOAT64 y0, NV_FLOAT64 x1, NV_FLOAT64 y1);
+  void             add_point (POINT_CELL *cell, POINT_DATA *point);
+  void             load_rows (rowReader *reader, NV_INT32 start_row, NV_INT32 end_row, OPTIONS *options, NV_FLOAT64 startlat,
+                              NV_FLOAT64 x_meter_degrees, NV_FLOAT64 y_meter_degrees, NV_FLOAT64 two_thirds_bin_meters,
+                              NV_FLOAT64 bin_overlap_meters, NV_INT32 num_cols, NV_BOOL preload, POINT_CELL **cells);
 
 
 protected slots:
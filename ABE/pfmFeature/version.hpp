@@ -15,7 +15,7 @@
 
 #ifndef VERSION
 
-#define     VERSION     "PFM Software - pfmFeature V5.13 - 09/21/11"
+#define     VERSION     "PFM Software - pfmFeature V5.14 - 10/19/26"
 
 #endif
 
@@ -249,4 +249,12 @@
 
     Replaced compute_index calls with compute_index_ptr calls.
 
+
+    Version 5.14
+    Jan C. Depner
+    10/19/26
+
+    Added a single row reader thread that reads each PFM row once and shares the points with all of the selection
+    passes.  Octant search now uses flat earth squared distances in loops that the compiler can vectorize.
+
 */
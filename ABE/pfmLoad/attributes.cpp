@@ -260,7 +260,7 @@ void getGSFAttributes (NV_FLOAT32 *l_attr, PFM_GLOBAL global, gsfSwathBathyPing
     {
       NV_INT32 index = global.gsf_attribute_num[i] - 1;
 
-      l_attr[index] = 0.0;
+      if (index >= 0) l_attr[index] = 0.0;
 
       if (global.gsf_attribute_num[i])
         {
@@ -410,7 +410,7 @@ void getHOFAttributes (NV_FLOAT32 *l_attr, PFM_GLOBAL global, HYDRO_OUTPUT_T hof
     {
       NV_INT32 index = global.hof_attribute_num[i] - 1;
 
-      l_attr[index] = 0.0;
+      if (index >= 0) l_attr[index] = 0.0;
 
       if (global.hof_attribute_num[i])
         {
@@ -624,7 +624,7 @@ void getTOFAttributes (NV_FLOAT32 *l_attr, PFM_GLOBAL global, TOPO_OUTPUT_T tof)
     {
       NV_INT32 index = global.tof_attribute_num[i] - 1;
 
-      l_attr[index] = 0.0;
+      if (index >= 0) l_attr[index] = 0.0;
 
       if (global.tof_attribute_num[i])
         {
@@ -682,7 +682,7 @@ void getWLFAttributes (NV_FLOAT32 *l_attr, PFM_GLOBAL global, WLF_RECORD wlf)
     {
       NV_INT32 index = global.wlf_attribute_num[i] - 1;
 
-      l_attr[index] = 0.0;
+      if (index >= 0) l_attr[index] = 0.0;
 
       if (global.wlf_attribute_num[i])
         {
@@ -756,7 +756,7 @@ void getCZMILAttributes (NV_FLOAT32 *l_attr, PFM_GLOBAL global, CZMIL_CXY_Data c
     {
       NV_INT32 index = global.czmil_attribute_num[i] - 1;
 
-      l_attr[index] = 0.0;
+      if (index >= 0) l_attr[index] = 0.0;
 
       if (global.czmil_attribute_num[i])
         {
@@ -922,7 +922,7 @@ void getBAGAttributes (NV_FLOAT32 *l_attr, PFM_GLOBAL global, BAG_RECORD bag)
     {
       NV_INT32 index = global.bag_attribute_num[i] - 1;
 
-      l_attr[index] = 0.0;
+      if (index >= 0) l_attr[index] = 0.0;
 
       if (global.bag_attribute_num[i])
         {
@@ -948,7 +948,7 @@ void getHAWKEYEAttributes (NV_FLOAT32 *l_attr, PFM_GLOBAL global, HAWKEYE_RECORD
     {
       NV_INT32 index = global.hawkeye_attribute_num[i] - 1;
 
-      l_attr[index] = 0.0;
+      if (index >= 0) l_attr[index] = 0.0;
 
       if (global.hawkeye_attribute_num[i])
         {
@@ -0,0 +1,872 @@
+
+/*********************************************************************************************
+
+    This is public domain software that was developed by the U.S. Naval Oceanographic Office.
+
+    This is a work of the US Government. In accordance with 17 USC 105, copyright protection
+    is not available for any work of the US Government.
+
+    Neither the United States Government nor any employees of the United States Government,
+    makes any warranty, express or implied, without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, or assumes any liability or
+    responsibility for the accuracy, completeness, or usefulness of any information,
+    apparatus, product, or process disclosed, or represents that its use would not infringe
+    privately-owned rights. Reference herein to any specific commercial products, process,
+    or service by trade name, trademark, manufacturer, or otherwise, does not necessarily
+    constitute or imply its endorsement, recommendation, or favoring by the United States
+    Government. The views and opinions of authors expressed herein do not necessarily state
+    or reflect those of the United States Government, and shall not be used for advertising
+    or product endorsement purposes.
+
+*********************************************************************************************/
+
+
+/****************************************  IMPORTANT NOTE  **********************************
+
+    Comments in this file that start with / * ! or / / ! are being used by Doxygen to
+    document the software.  Dashes in these comment blocks are used to create bullet lists.
+    The lack of blank lines after a block of dash preceeded comments means that the next
+    block of dash preceeded comments is a new, indented bullet list.  I've tried to keep the
+    Doxygen formatting to a minimum but there are some other items (like <br> and <pre>)
+    that need to be left alone.  If you see a comment that starts with / * ! or / / ! and
+    there is something that looks a bit weird it is probably due to some arcane Doxygen
+    syntax.  Be very careful modifying blocks of Doxygen comments.
+
+*****************************************  IMPORTANT NOTE  **********************************/
+
+
+
+#include "decodeThread.hpp"
+#include "newgp.h"
+
+
+void getGSFAttributes (NV_FLOAT32 *l_attr, PFM_GLOBAL global, gsfSwathBathyPing mb_ping, NV_INT32 beam);
+void getHOFAttributes (NV_FLOAT32 *l_attr, PFM_GLOBAL global, HYDRO_OUTPUT_T hof);
+void gsf_to_pfm_flags (NV_U_INT32 *pfm_flags, NV_U_CHAR gsf_flags);
+
+
+//  The GSF library keeps its file table and read buffers in static memory so only one thread at a time can be inside
+//  the library.  The CHARTS HOF library keeps the byte swap flag for the last header read in a static so, before
+//  reading records, we re-read the header if another file has read its header since we last read ours.  We read
+//  HOF_READ_RECORDS records each time we get the lock.
+
+#define HOF_READ_RECORDS  256
+
+static QMutex gsfMutex;
+static QMutex hofMutex;
+static FILE *hof_header_fp = NULL;
+
+
+decodeThread::decodeThread (QObject *parent)
+  : QThread(parent)
+{
+}
+
+
+
+decodeThread::~decodeThread ()
+{
+}
+
+
+
+void decodeThread::decode (DECODE_FILE *a_file, PFM_LOAD_PARAMETERS *a_load_parms)
+{
+  QMutexLocker locker (&mutex);
+
+
+  l_file = a_file;
+  l_load_parms = a_load_parms;
+
+
+  if (!isRunning ()) start ();
+}
+
+
+
+void decodeThread::run ()
+{
+  mutex.lock ();
+
+
+  file = l_file;
+  load_parms = l_load_parms;
+
+
+  mutex.unlock ();
+
+
+  strcpy (path, file->name.toAscii ());
+
+  file->opened = NVTrue;
+  file->messages.clear ();
+  file->data_type = file->type;
+
+  batch_num = 0;
+  batch = NULL;
+
+
+  switch (file->type)
+    {
+    case PFM_GSF_DATA:
+      decode_gsf_file ();
+      break;
+
+    case PFM_CHARTS_HOF_DATA:
+      decode_hof_file ();
+      break;
+    }
+
+
+  queue_batch (NVTrue);
+}
+
+
+
+//  Returns the next free record in the current batch, handing the batch to the loader and waiting for a free one if it's full.
+
+DECODED_RECORD *decodeThread::next_record ()
+{
+  if (batch != NULL && batch->count == DECODE_BATCH_SIZE) queue_batch (NVFalse);
+
+
+  if (batch == NULL)
+    {
+      file->freeBatches->acquire ();
+
+      batch = &file->batch[batch_num % DECODE_BATCHES];
+      batch->count = 0;
+      batch->last = NVFalse;
+    }
+
+
+  //  Attributes that aren't set for a file type are always zero.
+
+  DECODED_RECORD *rec = &batch->rec[batch->count++];
+  memset (rec->attr, 0, NUM_ATTR * sizeof (NV_FLOAT32));
+
+  return (rec);
+}
+
+
+
+//  Hands the current batch to the loader.  The last batch is always queued (even if it's empty) so that the loader knows
+//  that we're done.
+
+void decodeThread::queue_batch (NV_BOOL last)
+{
+  if (batch == NULL)
+    {
+      if (!last) return;
+
+      file->freeBatches->acquire ();
+
+      batch = &file->batch[batch_num % DECODE_BATCHES];
+      batch->count = 0;
+    }
+
+  batch->last = last;
+  batch_num++;
+  batch = NULL;
+
+  file->usedBatches->release ();
+}
+
+
+
+/********************************************************************
+ *
+ * Function Name :  decode_gsf_ping
+ *
+ * Description :    All GSF specific massaging of a ping is done here.
+ *                  The soundings are added to the current batch.
+ *
+ * Inputs : gsf_records - gsf data to be processed.
+ *          recnum      - GSF record number
+ *          percent     - percentage of file read
+ *
+ * Returns : none
+ *
+ * Error Conditions : none
+ *
+ ********************************************************************/
+
+void decodeThread::decode_gsf_ping (gsfRecords *gsf_records, NV_INT32 recnum, NV_INT32 percent)
+{
+  NV_U_INT32          flags;
+  NV_FLOAT64          lateral, ang1, ang2, lat, lon;
+  NV_FLOAT32          dep;
+  NV_F64_COORD2       nxy, xy2;
+  NV_FLOAT32          herr, verr;
+  DECODED_RECORD      *rec;
+
+
+  lat = gsf_records->mb_ping.latitude;
+  lon = gsf_records->mb_ping.longitude;
+  ang1 = gsf_records->mb_ping.heading + 90.0;
+  ang2 = gsf_records->mb_ping.heading;
+
+
+  //  Make sure position and ping is valid.   
+
+  if ((lat <= 90.0) && (lon <= 180.0) && !(gsf_records->mb_ping.ping_flags & GSF_IGNORE_PING))
+    {
+      //  Check for 1 beam multibeam.
+
+      if (gsf_records->mb_ping.number_beams == 1)
+        {
+          herr = load_parms[0].pfm_global.horizontal_error;
+          verr = load_parms[0].pfm_global.vertical_error;
+
+          gsf_to_pfm_flags (&flags, gsf_records->mb_ping.beam_flags[0]);
+
+
+          nxy.x = lon;
+          nxy.y = lat;
+
+
+          if (load_parms[0].flags.nom && gsf_records->mb_ping.nominal_depth != NULL)
+            {
+              dep = gsf_records->mb_ping.nominal_depth[0];
+            }
+          else
+            {
+              dep = gsf_records->mb_ping.depth[0];
+            }
+
+
+          rec = next_record ();
+
+          if (load_parms[0].pfm_global.attribute_count) getGSFAttributes (rec->attr, load_parms[0].pfm_global, gsf_records->mb_ping, 0);
+
+          rec->beam = 1;
+          rec->recnum = recnum;
+          rec->depth = dep;
+          rec->xy = nxy;
+          rec->herr = herr;
+          rec->verr = verr;
+          rec->flags = flags;
+          rec->heading = ang2;
+          rec->percent = percent;
+          rec->lidar_null = NVFalse;
+          rec->tv_sec = gsf_records->mb_ping.ping_time.tv_sec;
+          rec->tv_nsec = gsf_records->mb_ping.ping_time.tv_nsec;
+        }
+      else
+        {
+          for (NV_INT32 i = 0 ; i < gsf_records->mb_ping.number_beams ; i++) 
+            {
+              herr = 0.0;
+              verr = 0.0;
+
+              if (load_parms[0].flags.nom && gsf_records->mb_ping.nominal_depth != NULL)
+                {
+                  dep = gsf_records->mb_ping.nominal_depth[i];
+                }
+              else
+                {
+                  dep = gsf_records->mb_ping.depth[i];
+                }
+
+              if (dep != 0.0 && gsf_records->mb_ping.beam_flags != NULL && !(check_flag (gsf_records->mb_ping.beam_flags[i], HMPS_IGNORE_NULL_BEAM))) 
+                {
+                  //  Adjust for cross track position.  
+
+                  lateral = gsf_records->mb_ping.across_track[i];
+                  newgp (lat, lon, ang1, lateral, &nxy.y, &nxy.x);
+
+
+                  //  if the along track array is present then use it 
+                
+                  if (gsf_records->mb_ping.along_track != (NV_FLOAT64 *) NULL) 
+                    {
+                      xy2.y = nxy.y;
+                      xy2.x = nxy.x;
+                      lateral = gsf_records->mb_ping.along_track[i];
+
+                      newgp (xy2.y, xy2.x, ang2, lateral, &nxy.y, &nxy.x);
+                    }
+
+
+                  //  If the horizontal and vertical errors arrays are present then use them 
+
+                  if (gsf_records->mb_ping.horizontal_error != (NV_FLOAT64 *) NULL) 
+                    {
+                      herr = (NV_FLOAT32) gsf_records->mb_ping.horizontal_error[i];
+                    }
+                  else
+                    {
+                      herr = load_parms[0].pfm_global.horizontal_error;
+                    }
+
+                  if (gsf_records->mb_ping.vertical_error != (NV_FLOAT64 *) NULL) 
+                    {
+                      verr = (NV_FLOAT32) gsf_records->mb_ping.vertical_error[i];
+                    }
+                  else
+                    {
+                      verr = load_parms[0].pfm_global.vertical_error;
+                    }
+
+
+                  gsf_to_pfm_flags (&flags, gsf_records->mb_ping.beam_flags[i]);
+
+
+                  rec = next_record ();
+
+                  if (load_parms[0].pfm_global.attribute_count) getGSFAttributes (rec->attr, load_parms[0].pfm_global, gsf_records->mb_ping, i);
+
+                  rec->beam = i + 1;
+                  rec->recnum = recnum;
+                  rec->depth = dep;
+                  rec->xy = nxy;
+                  rec->herr = herr;
+                  rec->verr = verr;
+                  rec->flags = flags;
+                  rec->heading = ang2;
+                  rec->percent = percent;
+                  rec->lidar_null = NVFalse;
+                  rec->tv_sec = gsf_records->mb_ping.ping_time.tv_sec;
+                  rec->tv_nsec = gsf_records->mb_ping.ping_time.tv_nsec;
+                }
+            }
+        }
+    }
+}
+
+
+
+void decodeThread::decode_gsf_file ()
+{
+  gsfDataID         gsf_data_id;
+  gsfRecords        gsf_records;
+  NV_INT32          gsf_handle, percent, records, recnum, status;
+  time_t            sec;
+  long              nsec;
+  extern int        gsfError;
+  NV_BOOL           nom_warning;
+
+
+  nom_warning = NVFalse;
+  recnum = 0;
+
+
+  //  Open the GSF file indexed so we can get the number of records.  We're not in the GUI thread so we can't show the
+  //  progress if the index has to be built.
+
+  gsfMutex.lock ();
+
+  gsf_register_progress_callback (NULL);
+
+  if (gsfOpen (path, GSF_READONLY_INDEX, &gsf_handle)) 
+    {
+      file->messages += QString ("\n\nUnable to open file %1\n").arg (path);
+      file->messages += QString ("%1\n").arg (gsfStringError ());
+      if (gsfError != GSF_FOPEN_ERROR) gsfClose (gsf_handle);
+      gsfMutex.unlock ();
+
+      file->opened = NVFalse;
+      return;
+    }
+
+
+  //  Get the number of records in the file.
+
+  records = gsfIndexTime (gsf_handle, GSF_RECORD_SWATH_BATHYMETRY_PING, -1, &sec, &nsec);
+
+  gsfMutex.unlock ();
+
+
+  memset (&gsf_records, 0, sizeof (gsfRecords));
+  memset (&gsf_data_id, 0, sizeof (gsfDataID));
+
+
+  //  Read all of the data from this file.  
+
+  for (NV_INT32 i = 0 ; i < records ; i++)
+    {
+      gsfMutex.lock ();
+
+      gsf_data_id.recordID = GSF_RECORD_SWATH_BATHYMETRY_PING;
+      gsf_data_id.record_number = i + 1;
+      status = gsfRead (gsf_handle, GSF_RECORD_SWATH_BATHYMETRY_PING, &gsf_data_id, &gsf_records, NULL, 0);
+
+      if (status < 0) 
+        {
+          if (gsfError == GSF_READ_TO_END_OF_FILE)
+            {
+              gsfMutex.unlock ();
+              break;
+            }
+
+          file->messages += QString ("Error reading record - %1\n").arg (gsfStringError ());
+          file->messages += QString ("Record %1 skipped\n").arg (recnum);
+
+          gsfMutex.unlock ();
+        }
+      else
+        {
+          percent = gsfPercent (gsf_handle);
+
+          gsfMutex.unlock ();
+
+
+          //  NOTE: GSF records start at 1 not 0.
+
+          recnum = i + 1;
+
+
+          //  Check for nominal depth present.
+
+          if (!nom_warning && load_parms[0].flags.nom && gsf_records.mb_ping.nominal_depth == NULL)
+            {
+              file->messages += QString ("\nFor file %1\n").arg (path);
+              file->messages += QString ("nominal depth requested, true depth used.\n");
+              nom_warning = NVTrue;
+            }
+
+
+          decode_gsf_ping (&gsf_records, recnum, percent);
+        }
+    }
+
+
+  gsfMutex.lock ();
+  gsfClose (gsf_handle);
+  gsfMutex.unlock ();
+}
+
+
+
+void decodeThread::decode_hof_file ()
+{
+  NV_INT32           beam;
+  FILE               *hof_fp;
+  HYDRO_OUTPUT_T     *hof_buf;
+  NV_INT64           *hof_pos;
+  HOF_HEADER_T       head;
+  NV_INT32           percent, recnum, num_recs;
+  NV_F64_COORD2      xy;
+  NV_FLOAT32         herr, verr;
+  NV_FLOAT64         depth;
+  NV_U_INT32         flags;
+  NV_FLOAT32         eof;
+  NV_BOOL            lidar_null;
+  DECODED_RECORD     *rec;
+
+
+  file->data_type = PFM_CHARTS_HOF_DATA;
+
+
+  //  Open the HOF file.
+
+  hofMutex.lock ();
+
+  if ((hof_fp = open_hof_file (path)) == NULL)
+    {
+      hofMutex.unlock ();
+
+      file->messages += QString ("\n\nUnable to open file %1\n").arg (path);
+      file->opened = NVFalse;
+      return;
+    }
+
+  fseek (hof_fp, 0, SEEK_END);
+  eof = ftell (hof_fp);
+  fseek (hof_fp, 0, SEEK_SET);
+
+  hof_read_header (hof_fp, &head);
+  hof_header_fp = hof_fp;
+
+  hofMutex.unlock ();
+
+
+  hof_buf = (HYDRO_OUTPUT_T *) malloc (HOF_READ_RECORDS * sizeof (HYDRO_OUTPUT_T));
+  hof_pos = (NV_INT64 *) malloc (HOF_READ_RECORDS * sizeof (NV_INT64));
+  if (hof_buf == NULL || hof_pos == NULL)
+    {
+      perror ("Allocating HOF read buffer in decodeThread.cpp");
+      exit (-1);
+    }
+
+
+  //  HOF records start at 1.
+
+  recnum = 1;
+
+
+  //  Read all of the data from this file.  
+
+  do
+    {
+      hofMutex.lock ();
+
+      if (hof_header_fp != hof_fp)
+        {
+          NV_INT64 pos = ftello64 (hof_fp);
+          hof_read_header (hof_fp, &head);
+          fseeko64 (hof_fp, pos, SEEK_SET);
+          hof_header_fp = hof_fp;
+        }
+
+      for (num_recs = 0 ; num_recs < HOF_READ_RECORDS ; num_recs++)
+        {
+          if (!hof_read_record (hof_fp, HOF_NEXT_RECORD, &hof_buf[num_recs])) break;
+          hof_pos[num_recs] = ftell (hof_fp);
+        }
+
+      hofMutex.unlock ();
+
+
+      for (NV_INT32 k = 0 ; k < num_recs ; k++)
+        {
+          HYDRO_OUTPUT_T hof = hof_buf[k];
+
+
+          //  Get the start time for the line name (cvtime uses localtime so the line name is built in the GUI thread).
+
+          if (recnum == 1)
+            {
+              strcpy (file->flightline, head.text.flightline_number);
+              file->line_sec = hof.timestamp / 1000000;
+              file->line_nsec = (hof.timestamp % 1000000) * 1000;
+            }
+
+
+          percent = (NV_INT32) roundf (((NV_FLOAT32) (hof_pos[k]) / eof) * 100.0);
+
+
+          //  Check to see if we want to load HOF data in the old PFM_SHOALS_1K_DATA form.
+
+          if (load_parms[0].flags.old)
+            {
+              file->data_type = PFM_SHOALS_1K_DATA;
+
+              beam = 0;
+
+              xy.y = hof.latitude;
+              xy.x = hof.longitude;
+
+
+              lidar_null = NVFalse;
+
+
+              //  We'll allow 0 ABDC if we're loading NULL points.
+
+              if (hof.abdc || load_parms[0].flags.hof)
+                {
+                  //  HOF uses the lower three bits of the status field for status thusly :
+
+                  //  bit 0 = deleted    (1) 
+                  //  bit 1 = kept       (2) 
+                  //  bit 2 = swapped    (4)
+
+
+                  flags = 0;
+                  if (hof.status & AU_STATUS_DELETED_BIT) flags = PFM_FILTER_INVAL;
+
+
+                  //  If the absolute value of the abdc is below 70 we mark it as filter invalid.  If the value is
+                  //  below 70 (like a -93) but the absolute value is above 70 we will mark it as manually invalid.
+
+                  if (hof.abdc < 70)
+                    {
+                      if (abs (hof.abdc) < 70)
+                        {
+                          flags = PFM_FILTER_INVAL;
+                        }
+                      else
+                        {
+                          flags = PFM_MANUALLY_INVAL;
+                        }
+                    }
+
+
+                  //  Invalidate HOF land flags.
+
+                  if (load_parms[0].flags.lnd && hof.abdc == 70) flags = (PFM_FILTER_INVAL | PFM_MODIFIED);
+
+
+                  if (hof.suspect_status & SUSPECT_STATUS_SUSPECT_BIT) flags |= PFM_SUSPECT;
+                  if (hof.suspect_status & SUSPECT_STATUS_FEATURE_BIT) flags |= PFM_SELECTED_FEATURE;
+
+
+                  if (load_parms[0].flags.lid)
+                    {
+                      //  Flag "shallow water processed" or "shoreline depth swapped" HOF data (these two are mututally exclusive in practice).
+
+                      if (abs (hof.abdc) == 74 || abs (hof.abdc) == 72) flags |= PFM_USER_01;
+
+
+                      //  Flag "APD" data
+
+                      if (hof.bot_channel) flags |= PFM_USER_02;
+
+
+                      //  Flag "land" data
+
+                      if (abs (hof.abdc) == 70) flags |= PFM_USER_03;
+                    }
+
+
+                  herr = verr = 0.0;
+                  rec = NULL;
+
+                  if (hof.correct_depth <= -998.0)
+                    {
+                      if (load_parms[0].flags.hof)
+                        {
+                          //  We're setting the null (-998.0) depths to -999999.0 to put them outside any sane bounds.
+                          //  This will cause them to be set to the null depth for whatever PFM they fall in.  We
+                          //  want to keep them so that the Optech GCS software can reprocess them if possible.
+
+                          lidar_null = NVTrue;
+
+                          rec = next_record ();
+
+                          if (load_parms[0].pfm_global.attribute_count) getHOFAttributes (rec->attr, load_parms[0].pfm_global, hof);
+
+                          depth = -999999.0;
+                        }
+                    }
+                  else
+                    {
+                      hof_get_uncertainty (hof, &herr, &verr, hof.correct_depth, hof.abdc);
+
+                      rec = next_record ();
+
+                      if (load_parms[0].pfm_global.attribute_count) getHOFAttributes (rec->attr, load_parms[0].pfm_global, hof);
+
+
+                      if (load_parms[0].flags.lid && hof.correct_sec_depth > -998.0) flags |= PFM_USER_04;
+
+
+                      depth = -hof.correct_depth;
+                    }
+
+
+                  if (rec != NULL)
+                    {
+                      rec->beam = beam;
+                      rec->recnum = recnum;
+                      rec->depth = depth;
+                      rec->xy = xy;
+                      rec->herr = herr;
+                      rec->verr = verr;
+                      rec->flags = flags;
+                      rec->heading = 0.0;
+                      rec->percent = percent;
+                      rec->lidar_null = lidar_null;
+                      rec->tv_sec = 0;
+                      rec->tv_nsec = 0;
+                    }
+                }
+            }
+          else
+            {
+              file->data_type = PFM_CHARTS_HOF_DATA;
+
+              lidar_null = NVFalse;
+
+
+              if (hof.abdc)
+                {
+                  //  HOF uses the lower three bits of the status field for status thusly :
+                  //
+                  //  bit 0 = deleted    (1) 
+                  //  bit 1 = kept       (2) 
+                  //  bit 2 = swapped    (4)
+
+
+                  flags = 0;
+                  if (hof.status & AU_STATUS_DELETED_BIT) flags = PFM_FILTER_INVAL;
+
+
+                  //  If the absolute value of the abdc is below 70 we mark it as filter invalid.  If the value is
+                  //  below 70 (like a -93) but the absolute value is above 70 we will mark it as manually invalid.
+
+                  if (hof.abdc < 70)
+                    {
+                      if (abs (hof.abdc) < 70)
+                        {
+                          flags = PFM_FILTER_INVAL;
+                        }
+                      else
+                        {
+                          flags = PFM_MANUALLY_INVAL;
+                        }
+                    }
+
+
+                  //  Invalidate HOF land flags.
+
+                  if (load_parms[0].flags.lnd && hof.abdc == 70) flags = (PFM_FILTER_INVAL | PFM_MODIFIED);
+
+                  if (hof.suspect_status & SUSPECT_STATUS_SUSPECT_BIT) flags |= PFM_SUSPECT;
+                  if (hof.suspect_status & SUSPECT_STATUS_FEATURE_BIT) flags |= PFM_SELECTED_FEATURE;
+
+
+                  if (load_parms[0].flags.lid)
+                    {
+                      //  Flag "shallow water processed" or "shoreline depth swapped" HOF data (these two are mututally exclusive in practice).
+
+                      if (abs (hof.abdc) == 74 || abs (hof.abdc) == 72) flags |= PFM_USER_01;
+
+
+                      //  Flag "APD" data
+
+                      if (hof.bot_channel) flags |= PFM_USER_02;
+
+
+                      //  Flag "land" data
+
+                      if (abs (hof.abdc) == 70) flags |= PFM_USER_03;
+                    }
+
+
+                  //  The same attributes will be loaded for primary and secondary returns.
+
+                  NV_FLOAT32 hof_attr[NUM_ATTR];
+                  memset (hof_attr, 0, NUM_ATTR * sizeof (NV_FLOAT32));
+                  if (load_parms[0].pfm_global.attribute_count) getHOFAttributes (hof_attr, load_parms[0].pfm_global, hof);
+
+
+                  beam = 0;
+                  xy.y = hof.latitude;
+                  xy.x = hof.longitude;
+
+                  herr = verr = 0.0;
+                  rec = NULL;
+
+                  if (hof.correct_depth <= -998.0)
+                    {
+                      if (load_parms[0].flags.hof)
+                        {
+                          //  We're setting the null (-998.0) depths to -999999.0 to put them outside any sane bounds.  This will cause
+                          //  them to be set to the null depth for whatever PFM they fall in.  We want to keep them just to see coverage.
+
+                          lidar_null = NVTrue;
+
+                          depth = -999999.0;
+
+                          rec = next_record ();
+                        }
+                    }
+                  else
+                    {
+                      hof_get_uncertainty (hof, &herr, &verr, hof.correct_depth, hof.abdc);
+
+                      if (load_parms[0].flags.lid && hof.correct_sec_depth > -998.0) flags |= PFM_USER_04;
+
+                      depth = -hof.correct_depth;
+
+                      rec = next_record ();
+                    }
+
+
+                  if (rec != NULL)
+                    {
+                      memcpy (rec->attr, hof_attr, NUM_ATTR * sizeof (NV_FLOAT32));
+                      rec->beam = beam;
+                      rec->recnum = recnum;
+                      rec->depth = depth;
+                      rec->xy = xy;
+                      rec->herr = herr;
+                      rec->verr = verr;
+                      rec->flags = flags;
+                      rec->heading = 0.0;
+                      rec->percent = percent;
+                      rec->lidar_null = lidar_null;
+                      rec->tv_sec = 0;
+                      rec->tv_nsec = 0;
+                    }
+
+
+                  if (hof.correct_sec_depth > -998.0)
+                    {
+                      flags = 0;
+
+
+                      //  If the absolute value of the abdc is below 70 we mark it as filter invalid.  If the value is
+                      //  below 70 (like a -93) but the absolute value is above 70 we will mark it as manually invalid.
+
+                      if (hof.sec_abdc < 70)
+                        {
+                          if (abs (hof.sec_abdc) < 70)
+                            {
+                              flags = PFM_FILTER_INVAL;
+                            }
+                          else
+                            {
+                              flags = PFM_MANUALLY_INVAL;
+                            }
+                        }
+
+
+                      //  Invalidate HOF land flags.
+
+                      if (load_parms[0].flags.lnd && hof.sec_abdc == 70) flags = (PFM_FILTER_INVAL | PFM_MODIFIED);
+
+
+                      //  Invalidate HOF secondary returns.
+
+                      if (load_parms[0].flags.sec) flags = (PFM_FILTER_INVAL | PFM_MODIFIED);
+
+
+                      if (load_parms[0].flags.lid)
+                        {
+                          //  Flag "shallow water processed" or "shoreline depth swapped" HOF data (these two are mututally exclusive in practice).
+
+                          if (abs (hof.sec_abdc) == 74 || abs (hof.sec_abdc) == 72) flags |= PFM_USER_01;
+
+
+                          //  Flag "APD" data
+
+                          if (hof.sec_bot_chan) flags |= PFM_USER_02;
+
+
+                          //  Flag "land" data
+
+                          if (abs (hof.sec_abdc) == 70) flags |= PFM_USER_03;
+                        }
+
+
+                      hof_get_uncertainty (hof, &herr, &verr, hof.correct_sec_depth, hof.sec_abdc);
+
+                      if (load_parms[0].flags.lid) flags |= PFM_USER_04;
+
+
+                      rec = next_record ();
+
+                      memcpy (rec->attr, hof_attr, NUM_ATTR * sizeof (NV_FLOAT32));
+                      rec->beam = 1;
+                      rec->recnum = recnum;
+                      rec->depth = -hof.correct_sec_depth;
+                      rec->xy.y = hof.sec_latitude;
+                      rec->xy.x = hof.sec_longitude;
+                      rec->herr = herr;
+                      rec->verr = verr;
+                      rec->flags = flags;
+                      rec->heading = 0.0;
+                      rec->percent = percent;
+                      rec->lidar_null = lidar_null;
+                      rec->tv_sec = 0;
+                      rec->tv_nsec = 0;
+                    }
+                }
+            }
+
+          recnum++;
+        }
+    } while (num_recs == HOF_READ_RECORDS);
+
+
+  free (hof_buf);
+  free (hof_pos);
+
+
+  hofMutex.lock ();
+  fclose (hof_fp);
+  if (hof_header_fp == hof_fp) hof_header_fp = NULL;
+  hofMutex.unlock ();
+}
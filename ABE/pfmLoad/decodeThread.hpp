@@ -0,0 +1,95 @@
+
+/*********************************************************************************************
+
+    This is public domain software that was developed by the U.S. Naval Oceanographic Office.
+
+    This is a work of the US Government. In accordance with 17 USC 105, copyright protection
+    is not available for any work of the US Government.
+
+    Neither the United States Government nor any employees of the United States Government,
+    makes any warranty, express or implied, without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, or assumes any liability or
+    responsibility for the accuracy, completeness, or usefulness of any information,
+    apparatus, product, or process disclosed, or represents that its use would not infringe
+    privately-owned rights. Reference herein to any specific commercial products, process,
+    or service by trade name, trademark, manufacturer, or otherwise, does not necessarily
+    constitute or imply its endorsement, recommendation, or favoring by the United States
+    Government. The views and opinions of authors expressed herein do not necessarily state
+    or reflect those of the United States Government, and shall not be used for advertising
+    or product endorsement purposes.
+
+*********************************************************************************************/
+
+
+/****************************************  IMPORTANT NOTE  **********************************
+
+    Comments in this file that start with / * ! or / / ! are being used by Doxygen to
+    document the software.  Dashes in these comment blocks are used to create bullet lists.
+    The lack of blank lines after a block of dash preceeded comments means that the next
+    block of dash preceeded comments is a new, indented bullet list.  I've tried to keep the
+    Doxygen formatting to a minimum but there are some other items (like <br> and <pre>)
+    that need to be left alone.  If you see a comment that starts with / * ! or / / ! and
+    there is something that looks a bit weird it is probably due to some arcane Doxygen
+    syntax.  Be very careful modifying blocks of Doxygen comments.
+
+*****************************************  IMPORTANT NOTE  **********************************/
+
+
+
+#ifndef DECODETHREAD_H
+#define DECODETHREAD_H
+
+
+#include "pfmLoadDef.hpp"
+
+
+/*!
+    - decodeThread reads an input file and converts it to DECODED_RECORD batches for load_decoded_file (in load_file.cpp).
+      Everything that doesn't depend on the PFM files (reading, flag and attribute conversion, position
+      computation) is done here so that it can overlap with loading the previous file(s) into the PFM(s).
+*/
+
+class decodeThread:public QThread
+{
+  Q_OBJECT 
+
+
+public:
+
+  decodeThread (QObject *parent = 0);
+  ~decodeThread ();
+
+  void decode (DECODE_FILE *a_file = NULL, PFM_LOAD_PARAMETERS *a_load_parms = NULL);
+
+
+protected:
+
+
+  QMutex                   mutex;
+
+  DECODE_FILE              *l_file;
+  PFM_LOAD_PARAMETERS      *l_load_parms;
+
+
+  DECODE_FILE              *file;
+  PFM_LOAD_PARAMETERS      *load_parms;
+  NV_INT32                 batch_num;
+  DECODED_BATCH            *batch;
+  NV_CHAR                  path[1024];
+
+
+  void run ();
+
+  DECODED_RECORD *next_record ();
+  void queue_batch (NV_BOOL last);
+  void decode_gsf_file ();
+  void decode_gsf_ping (gsfRecords *gsf_records, NV_INT32 recnum, NV_INT32 percent);
+  void decode_hof_file ();
+
+
+protected slots:
+
+private:
+};
+
+#endif
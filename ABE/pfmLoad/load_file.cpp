@@ -257,207 +257,34 @@ void Do_PFM_Processing (NV_INT32 beam, NV_FLOAT64 depth, NV_F64_COORD2 nxy, NV_F
 
 /********************************************************************
  *
- * Function Name :  GSF_PFM_Processing
+ * Function Name : load_decoded_file
  *
- * Description :    This is called when GSF records are to be
- *               output to the PFM file. All GSF specific massaging is done
- *               and then passed to Do_PFM_Processing.
+ * Description : Loads a GSF or HOF file that is being decoded by a
+ *               decodeThread (see decodeThread.cpp).  The decoded
+ *               soundings are passed to Do_PFM_Processing in file
+ *               order, with their record numbers, so the PFM is the
+ *               same as it would be if we decoded the file here.
  *
- * Inputs : gsf_records - gsf data to be processed.
+ * Inputs : decode - the file and the batches being filled by the
+ *                   decoder
  *
- * Returns : none
- *
- * Error Conditions : none
- *
- ********************************************************************/
-
-static void GSF_PFM_Processing (gsfRecords * gsf_records, PFM_LOAD_PARAMETERS load_parms[], PFM_DEFINITION pfm_def[],
-                                NV_INT32 percent)
-{
-  NV_INT32            i;
-  NV_U_INT32          flags;
-  NV_FLOAT64          lateral, ang1, ang2, lat, lon;
-  NV_FLOAT32          dep;
-  NV_F64_COORD2       xy2;
-  NV_FLOAT32          herr, verr;
-  NV_F64_COORD2       nxy[1024];
-
-
-  void gsf_to_pfm_flags (NV_U_INT32 *pfm_flags, NV_U_CHAR gsf_flags);
-
-
-  //  Set and then increment the record number.  
-
-  lat = gsf_records->mb_ping.latitude;
-  lon = gsf_records->mb_ping.longitude;
-  ang1 = gsf_records->mb_ping.heading + 90.0;
-  ang2 = gsf_records->mb_ping.heading;
-
-
-  //  Make sure position and ping is valid.   
-
-  if ((lat <= 90.0) && (lon <= 180.0) && !(gsf_records->mb_ping.ping_flags & GSF_IGNORE_PING))
-    {
-      //  Check for 1 beam multibeam.
-
-      if (gsf_records->mb_ping.number_beams == 1)
-        {
-          herr = load_parms[0].pfm_global.horizontal_error;
-          verr = load_parms[0].pfm_global.vertical_error;
-
-          gsf_to_pfm_flags (&flags, gsf_records->mb_ping.beam_flags[0]);
-
-
-          nxy[0].x = lon;
-          nxy[0].y = lat;
-
-
-          if (load_parms[0].flags.nom && gsf_records->mb_ping.nominal_depth != NULL)
-            {
-              dep = gsf_records->mb_ping.nominal_depth[0];
-            }
-          else
-            {
-              dep = gsf_records->mb_ping.depth[0];
-            }
-
-
-          if (load_parms[0].pfm_global.attribute_count) getGSFAttributes (attr, load_parms[0].pfm_global, gsf_records->mb_ping, 0);
-
-          Do_PFM_Processing (1, dep, nxy[0], herr, verr, flags, ang2, attr, load_parms, pfm_def, percent, gsf_records->mb_ping.ping_time.tv_sec, 
-                             gsf_records->mb_ping.ping_time.tv_nsec);
-        }
-      else
-        {
-          for (i = 0 ; i < gsf_records->mb_ping.number_beams ; i++) 
-            {
-              herr = 0.0;
-              verr = 0.0;
-
-              if (load_parms[0].flags.nom && gsf_records->mb_ping.nominal_depth != NULL)
-                {
-                  dep = gsf_records->mb_ping.nominal_depth[i];
-                }
-              else
-                {
-                  dep = gsf_records->mb_ping.depth[i];
-                }
-
-              if (dep != 0.0 && gsf_records->mb_ping.beam_flags != NULL && !(check_flag (gsf_records->mb_ping.beam_flags[i], HMPS_IGNORE_NULL_BEAM))) 
-                {
-                  //  Adjust for cross track position.  
-
-                  lateral = gsf_records->mb_ping.across_track[i];
-                  newgp (lat, lon, ang1, lateral, &nxy[i].y, &nxy[i].x);
-
-
-                  //  if the along track array is present then use it 
-                
-                  if (gsf_records->mb_ping.along_track != (NV_FLOAT64 *) NULL) 
-                    {
-                      xy2.y = nxy[i].y;
-                      xy2.x = nxy[i].x;
-                      lateral = gsf_records->mb_ping.along_track[i];
-
-                      newgp (xy2.y, xy2.x, ang2, lateral, &nxy[i].y, &nxy[i].x);
-                    }
-
-
-                  //  If the horizontal and vertical errors arrays are present then use them 
-
-                  if (gsf_records->mb_ping.horizontal_error != (NV_FLOAT64 *) NULL) 
-                    {
-                      herr = (NV_FLOAT32) gsf_records->mb_ping.horizontal_error[i];
-                    }
-                  else
-                    {
-                      herr = load_parms[0].pfm_global.horizontal_error;
-                    }
-
-                  if (gsf_records->mb_ping.vertical_error != (NV_FLOAT64 *) NULL) 
-                    {
-                      verr = (NV_FLOAT32) gsf_records->mb_ping.vertical_error[i];
-                    }
-                  else
-                    {
-                      verr = load_parms[0].pfm_global.vertical_error;
-                    }
-
-
-                  gsf_to_pfm_flags (&flags, gsf_records->mb_ping.beam_flags[i]);
-
-
-                  if (load_parms[0].pfm_global.attribute_count) getGSFAttributes (attr, load_parms[0].pfm_global, gsf_records->mb_ping, i);
-
-                  Do_PFM_Processing (i + 1, dep, nxy[i], herr, verr, flags, ang2, attr, load_parms, pfm_def, percent, gsf_records->mb_ping.ping_time.tv_sec, 
-                                     gsf_records->mb_ping.ping_time.tv_nsec);
-                }
-            }
-        }
-    }
-}
-
-
-NV_BOOL check_gsf_file (NV_CHAR *path, QProgressBar *preCheck, FILE *errfp)
-{
-  NV_INT32          gsf_handle;
-  extern int        gsfError;
-
-
-  prog = preCheck;
-
-
-  //  Open the GSF file indexed so the library will generate another index file if needed.
-
-  gsf_register_progress_callback (indexProgress);
-
-  if (gsfOpen (path, GSF_READONLY_INDEX, &gsf_handle)) 
-    {
-      fprintf (errfp, "\n\nUnable to open file %s\n", path);
-      gsfPrintError (errfp);
-      if (gsfError != GSF_FOPEN_ERROR) gsfClose (gsf_handle);
-      return (NVFalse);
-    }
-  gsfClose (gsf_handle);
-
-  prog->setValue (100);
-
-  return (NVTrue);
-}
-
-
-
-/********************************************************************
- *
- * Function Name : load_gsf_file
- *
- * Description :
- *
- * Inputs :
- *
- * Returns :
+ * Returns : Number of out of limits soundings (always 0 for HOF)
  *
  * Error Conditions :
  *
  ********************************************************************/
 
-NV_INT32 load_gsf_file (NV_INT32 pfm_fc, NV_INT32 *count, QString file, QProgressBar *fileInput, FILE *errfp, 
-                        PFM_LOAD_PARAMETERS load_parms[], PFM_DEFINITION pfm_def[])
+NV_INT32 load_decoded_file (NV_INT32 pfm_fc, NV_INT32 *count, DECODE_FILE *decode, QProgressBar *fileInput, FILE *errfp, 
+                            PFM_LOAD_PARAMETERS load_parms[], PFM_DEFINITION pfm_def[])
 {
-  gsfDataID         gsf_data_id;
-  gsfRecords        gsf_records;
-  NV_INT32          i, j, gsf_handle, percent, records;
-  time_t            sec;
-  long              nsec;
-  extern int        gsfError;
+  NV_INT32          i, j;
   NV_CHAR           temp[1024], line[1024], *ptr;
-  NV_BOOL           nom_warning;
-
+  DECODED_BATCH     *batch;
+  DECODED_RECORD    *rec;
+  NV_BOOL           last;
 
-  nom_warning = NVFalse;
 
-
-  strcpy (path, file.toAscii ());
+  strcpy (path, decode->name.toAscii ());
   prog = fileInput;
 
 
@@ -468,95 +295,57 @@ NV_INT32 load_gsf_file (NV_INT32 pfm_fc, NV_INT32 *count, QString file, QProgres
   total_out_of_limits = 0;
 
 
-  //  Clear the attributes.
-
-  if (load_parms[0].pfm_global.attribute_count) for (NV_INT32 i = 0 ; i < NUM_ATTR ; i++) attr[i] = 0.0;
-
-
   //  Just so that we don't mistakenly think this might be a HOF LIDAR NULL.
 
   lidar_null = NVFalse;
 
 
-  //  Get the next available file number so that we can put it into the index file.  If we don't read any data from this file that
-  //  is in the defined area we won't put the filename into the list file.  
+  //  Get the next available file and line numbers.  If we don't read any data from this file that is in the defined area
+  //  we won't put the filename into the list file.  For GSF files we generate our own lines from the headings.
 
   for (i = 0 ; i < pfm_file_count ; i++) 
     {
+      line_count[i] = -1; 
+      next_line[i] = get_next_line_number (pfm_def[i].hnd);
       file_number[i] = get_next_list_file_number (pfm_def[i].hnd);
     }
 
-  percent = 0;
-
-
-  //  Open the GSF file indexed so we can get the number of records.
-
-  if (gsfOpen (path, GSF_READONLY_INDEX, &gsf_handle)) 
-    {
-      fprintf (errfp, "\n\nUnable to open file %s\n", path);
-      gsfPrintError (errfp);
-      if (gsfError != GSF_FOPEN_ERROR) gsfClose (gsf_handle);
-      return (0);
-    }
-
-
-  //  Get the number of records in the file.
-
-  records = gsfIndexTime (gsf_handle, GSF_RECORD_SWATH_BATHYMETRY_PING, -1, &sec, &nsec);
-
 
-  //  Get the next available line number for this file so we can generate our own lines from GSF data.
+  //  Load the batches as the decoder fills them.  Keep the GUI alive while we're waiting on the decoder.
 
-  for (i = 0 ; i < pfm_file_count ; i++) 
+  for (NV_INT32 b = 0 ; ; b++)
     {
-      line_count[i] = -1; 
-      next_line[i] = get_next_line_number (pfm_def[i].hnd);
-    }
+      while (!decode->usedBatches->tryAcquire (1, 50)) qApp->processEvents ();
 
+      batch = &decode->batch[b % DECODE_BATCHES];
 
-  memset (&gsf_records, 0, sizeof (gsfRecords));
-  memset (&gsf_data_id, 0, sizeof (gsfDataID));
-
+      for (j = 0 ; j < batch->count ; j++)
+        {
+          rec = &batch->rec[j];
 
-  //  Read all of the data from this file.  
+          recnum = rec->recnum;
+          lidar_null = rec->lidar_null;
 
-  for (i = 0 ; i < records ; i++)
-    {
-      gsf_data_id.recordID = GSF_RECORD_SWATH_BATHYMETRY_PING;
-      gsf_data_id.record_number = i + 1;
-      if (gsfRead (gsf_handle, GSF_RECORD_SWATH_BATHYMETRY_PING, &gsf_data_id, &gsf_records, NULL, 0) < 0) 
-        {
-          if (gsfError == GSF_READ_TO_END_OF_FILE) break;
-          fprintf (errfp, "Error reading record - %s\n", gsfStringError ());
-          fprintf (errfp,"Record %d skipped\n", recnum);
+          Do_PFM_Processing (rec->beam, rec->depth, rec->xy, rec->herr, rec->verr, rec->flags, rec->heading, rec->attr, load_parms,
+                             pfm_def, rec->percent, rec->tv_sec, rec->tv_nsec);
         }
-      else
-        {
-          //  NOTE: GSF records start at 1 not 0.
-
-          recnum = i + 1;
 
-          percent = gsfPercent (gsf_handle);
+      last = batch->last;
 
+      decode->freeBatches->release ();
 
-          //  Check for nominal depth present.
+      if (last) break;
+    }
 
-          if (!nom_warning && load_parms[0].flags.nom && gsf_records.mb_ping.nominal_depth == NULL)
-            {
-              fprintf (errfp, "\nFor file %s\n", path);
-              fprintf (errfp, "nominal depth requested, true depth used.\n");
-              nom_warning = NVTrue;
-            }
 
+  //  The decoder is done with the file so we can write any error messages that it saved.
 
-          GSF_PFM_Processing (&gsf_records, load_parms, pfm_def, percent);
-        }
-    }
+  if (!decode->messages.isEmpty ()) fprintf (errfp, "%s", decode->messages.toAscii ().constData ());
 
-  prog->setValue (100);
+  if (!decode->opened) return (0);
 
 
-  gsfClose (gsf_handle);
+  prog->setValue (100);
 
 
   //  If we actually wrote any data, write the input file name to the list file.   
@@ -565,34 +354,47 @@ NV_INT32 load_gsf_file (NV_INT32 pfm_fc, NV_INT32 *count, QString file, QProgres
     {
       if (out_count[i]) 
         {
-          //  May be MSYS on Windoze so we have to check for either separator.
-
-          if (strrchr (path, '/'))
-            {
-              ptr = strrchr (path, '/');
-            }
-          else if (strrchr (path, '\\'))
-            {
-              ptr = strrchr (path, '\\');
-            }
-          else
+          if (decode->type == PFM_GSF_DATA)
             {
-              ptr = NULL;
-            }
+              //  May be MSYS on Windoze so we have to check for either separator.
 
+              if (strrchr (path, '/'))
+                {
+                  ptr = strrchr (path, '/');
+                }
+              else if (strrchr (path, '\\'))
+                {
+                  ptr = strrchr (path, '\\');
+                }
+              else
+                {
+                  ptr = NULL;
+                }
 
-          if (ptr == NULL) 
-            {
-              strcpy (temp, path);
+
+              if (ptr == NULL) 
+                {
+                  strcpy (temp, path);
+                }
+              else
+                {
+                  strcpy (temp, (ptr + 1));
+                }
+
+              for (j = 0 ; j <= line_count[i] ; j++)
+                {
+                  sprintf (line, "%s-%s", temp, line_time[j]);
+                  write_line_file (pfm_def[i].hnd, line);
+                }
             }
           else
             {
-              strcpy (temp, (ptr + 1));
-            }
+              NV_INT32 year, jday, hour, minute;
+              NV_FLOAT32 second;
+              cvtime (decode->line_sec, decode->line_nsec, &year, &jday, &hour, &minute, &second);
+
+              sprintf (line, "Line %s %d-%03d-%02d:%02d:%02d", decode->flightline, year + 1900, jday, hour, minute, NINT (second));
 
-          for (j = 0 ; j <= line_count[i] ; j++)
-            {
-              sprintf (line, "%s-%s", temp, line_time[j]);
               write_line_file (pfm_def[i].hnd, line);
             }
 
@@ -602,16 +404,50 @@ NV_INT32 load_gsf_file (NV_INT32 pfm_fc, NV_INT32 *count, QString file, QProgres
           nativePath = QDir::toNativeSeparators (QString (path));
           strcpy (native_path, nativePath.toAscii ());
 
-          write_list_file (pfm_def[i].hnd, native_path, PFM_GSF_DATA);
+          write_list_file (pfm_def[i].hnd, native_path, decode->data_type);
           count[i] += out_count[i];
         }
     }
 
+
+  //  We don't return out of range values for HOF data since we load the -998.0 (NBR) values as null depths.
+
+  if (decode->type == PFM_CHARTS_HOF_DATA) total_out_of_limits = 0;
+
   return (total_out_of_limits);
 }
 
 
 
+NV_BOOL check_gsf_file (NV_CHAR *path, QProgressBar *preCheck, FILE *errfp)
+{
+  NV_INT32          gsf_handle;
+  extern int        gsfError;
+
+
+  prog = preCheck;
+
+
+  //  Open the GSF file indexed so the library will generate another index file if needed.
+
+  gsf_register_progress_callback (indexProgress);
+
+  if (gsfOpen (path, GSF_READONLY_INDEX, &gsf_handle)) 
+    {
+      fprintf (errfp, "\n\nUnable to open file %s\n", path);
+      gsfPrintError (errfp);
+      if (gsfError != GSF_FOPEN_ERROR) gsfClose (gsf_handle);
+      return (NVFalse);
+    }
+  gsfClose (gsf_handle);
+
+  prog->setValue (100);
+
+  return (NVTrue);
+}
+
+
+
 NV_BOOL check_hof_file (NV_CHAR *path, QProgressBar *preCheck, FILE *errfp)
 {
   FILE               *hof_fp;
@@ -648,425 +484,6 @@ NV_BOOL check_hof_file (NV_CHAR *path, QProgressBar *preCheck, FILE *errfp)
 
 
 
-/********************************************************************
- *
- * Function Name : load_hof_file
- *
- * Description :
- *
- * Inputs :
- *
- * Returns :
- *
- * Error Conditions :
- *
- ********************************************************************/
-
-NV_INT32 load_hof_file (NV_INT32 pfm_fc, NV_INT32 *count, QString file, QProgressBar *fileInput, FILE *errfp, 
-                        PFM_LOAD_PARAMETERS load_parms[], PFM_DEFINITION pfm_def[])
-{
-  NV_INT32           beam;
-  FILE               *hof_fp;
-  HYDRO_OUTPUT_T     hof;
-  HOF_HEADER_T       head;
-  NV_INT32           i, percent;
-  NV_F64_COORD2      xy;
-  NV_FLOAT32         herr, verr;
-  NV_FLOAT64         depth;
-  NV_U_INT32         flags;
-  NV_FLOAT32         eof;
-  NV_CHAR            line[256];
-  NV_INT32           data_type = PFM_CHARTS_HOF_DATA;
-
-
-  strcpy (path, file.toAscii ());
-  prog = fileInput;
-
-
-  //  Zero count on number of soundings per file. 
-
-  memset (out_count, 0, MAX_PFM_FILES * sizeof (NV_INT32));
-  pfm_file_count = pfm_fc;
-  total_out_of_limits = 0;
-
-
-  //  Clear the attributes.
-
-  if (load_parms[0].pfm_global.attribute_count) for (NV_INT32 i = 0 ; i < NUM_ATTR ; i++) attr[i] = 0.0;
-
-
-  //  Get the next available file number so that we can put it into the index file.  If we don't read any data from this file that
-  //  is in the defined area we won't put the filename into the list file.  
-
-  for (i = 0 ; i < pfm_file_count ; i++) 
-    {
-      line_count[i] = -1; 
-      next_line[i] = get_next_line_number (pfm_def[i].hnd);
-      file_number[i] = get_next_list_file_number (pfm_def[i].hnd);
-    }
-
-  percent = 0;
-
-
-  //  HOF records start at 1.
-
-  recnum = 1;
-
-
-  //  Open the HOF files and read the data.
-
-  if ((hof_fp = open_hof_file (path)) != NULL)
-    {
-      fseek (hof_fp, 0, SEEK_END);
-      eof = ftell (hof_fp);
-      fseek (hof_fp, 0, SEEK_SET);
-
-
-      hof_read_header (hof_fp, &head);
-
-
-      //  Read all of the data from this file.  
-
-      while (hof_read_record (hof_fp, HOF_NEXT_RECORD, &hof))
-        {
-          //  Get the start time for the line name.
-
-          if (recnum == 1)
-            {
-              NV_INT32 year, jday, hour, minute;
-              NV_FLOAT32 second;
-              time_t tv_sec = hof.timestamp / 1000000;
-              long tv_nsec = (hof.timestamp % 1000000) * 1000;
-              cvtime (tv_sec, tv_nsec, &year, &jday, &hour, &minute, &second);
-
-              sprintf (line, "Line %s %d-%03d-%02d:%02d:%02d", head.text.flightline_number, year + 1900, jday, hour, minute, NINT (second));
-            }
-
-
-          percent = (NV_INT32) roundf (((NV_FLOAT32) (ftell (hof_fp)) / eof) * 100.0);
-
-
-          //  Check to see if we want to load HOF data in the old PFM_SHOALS_1K_DATA form.
-
-          if (load_parms[0].flags.old)
-            {
-              data_type = PFM_SHOALS_1K_DATA;
-
-              beam = 0;
-
-              xy.y = hof.latitude;
-              xy.x = hof.longitude;
-
-
-              lidar_null = NVFalse;
-
-
-              //  We'll allow 0 ABDC if we're loading NULL points.
-
-              if (hof.abdc || load_parms[0].flags.hof)
-                {
-                  //  HOF uses the lower three bits of the status field for status thusly :
-
-                  //  bit 0 = deleted    (1) 
-                  //  bit 1 = kept       (2) 
-                  //  bit 2 = swapped    (4)
-
-
-                  flags = 0;
-                  if (hof.status & AU_STATUS_DELETED_BIT) flags = PFM_FILTER_INVAL;
-
-
-                  //  If the absolute value of the abdc is below 70 we mark it as filter invalid.  If the value is
-                  //  below 70 (like a -93) but the absolute value is above 70 we will mark it as manually invalid.
-
-                  if (hof.abdc < 70)
-                    {
-                      if (abs (hof.abdc) < 70)
-                        {
-                          flags = PFM_FILTER_INVAL;
-                        }
-                      else
-                        {
-                          flags = PFM_MANUALLY_INVAL;
-                        }
-                    }
-
-
-                  //  Invalidate HOF land flags.
-
-                  if (load_parms[0].flags.lnd && hof.abdc == 70) flags = (PFM_FILTER_INVAL | PFM_MODIFIED);
-
-
-                  if (hof.suspect_status & SUSPECT_STATUS_SUSPECT_BIT) flags |= PFM_SUSPECT;
-                  if (hof.suspect_status & SUSPECT_STATUS_FEATURE_BIT) flags |= PFM_SELECTED_FEATURE;
-
-
-                  //  Maybe in the future ;-)
-
-                  //  HOF classification status :
-                  //  bit 0 = classified        (1=classified; 0=not classified)
-                  //  bit 1 = non-bare_earth1   (0x02);   
-                  //  bit 2 = non-bare_earth2   (0x04);
-                  //  bit 3 = water             (0x08);   
-
-                  //  if ((hof.classification_status & 0x01) && (!(hof.classification_status & 0x0e))) flags |= PFM_USER_01;
-
-
-                  if (load_parms[0].flags.lid)
-                    {
-                      //  Flag "shallow water processed" or "shoreline depth swapped" HOF data (these two are mututally exclusive in practice).
-
-                      if (abs (hof.abdc) == 74 || abs (hof.abdc) == 72) flags |= PFM_USER_01;
-
-
-                      //  Flag "APD" data
-
-                      if (hof.bot_channel) flags |= PFM_USER_02;
-
-
-                      //  Flag "land" data
-
-                      if (abs (hof.abdc) == 70) flags |= PFM_USER_03;
-                    }
-
-
-                  if (hof.correct_depth <= -998.0)
-                    {
-                      if (load_parms[0].flags.hof)
-                        {
-                          //  We're setting the null (-998.0) depths to -999999.0 to put them outside any sane bounds.
-                          //  This will cause them to be set to the null depth for whatever PFM they fall in.  We
-                          //  want to keep them so that the Optech GCS software can reprocess them if possible.
-
-                          lidar_null = NVTrue;
-
-                          if (load_parms[0].pfm_global.attribute_count) getHOFAttributes (attr, load_parms[0].pfm_global, hof);
-
-                          depth = -999999.0;
-
-                          Do_PFM_Processing (beam, depth, xy, 0.0, 0.0, flags, 0.0, attr, load_parms, pfm_def, percent, 0, 0);
-                        }
-                    }
-                  else
-                    {
-                      hof_get_uncertainty (hof, &herr, &verr, hof.correct_depth, hof.abdc);
-
-                      if (load_parms[0].pfm_global.attribute_count) getHOFAttributes (attr, load_parms[0].pfm_global, hof);
-
-
-                      if (load_parms[0].flags.lid && hof.correct_sec_depth > -998.0) flags |= PFM_USER_04;
-
-
-                      depth = -hof.correct_depth;
-
-                      Do_PFM_Processing (beam, depth, xy, herr, verr, flags, 0.0, attr, load_parms, pfm_def, percent, 0, 0);
-                    }
-                }
-            }
-          else
-            {
-              data_type = PFM_CHARTS_HOF_DATA;
-
-              lidar_null = NVFalse;
-
-
-              if (hof.abdc)
-                {
-                  //  HOF uses the lower three bits of the status field for status thusly :
-                  //
-                  //  bit 0 = deleted    (1) 
-                  //  bit 1 = kept       (2) 
-                  //  bit 2 = swapped    (4)
-
-
-                  flags = 0;
-                  if (hof.status & AU_STATUS_DELETED_BIT) flags = PFM_FILTER_INVAL;
-
-
-                  //  If the absolute value of the abdc is below 70 we mark it as filter invalid.  If the value is
-                  //  below 70 (like a -93) but the absolute value is above 70 we will mark it as manually invalid.
-
-                  if (hof.abdc < 70)
-                    {
-                      if (abs (hof.abdc) < 70)
-                        {
-                          flags = PFM_FILTER_INVAL;
-                        }
-                      else
-                        {
-                          flags = PFM_MANUALLY_INVAL;
-                        }
-                    }
-
-
-                  //  Invalidate HOF land flags.
-
-                  if (load_parms[0].flags.lnd && hof.abdc == 70) flags = (PFM_FILTER_INVAL | PFM_MODIFIED);
-
-                  if (hof.suspect_status & SUSPECT_STATUS_SUSPECT_BIT) flags |= PFM_SUSPECT;
-                  if (hof.suspect_status & SUSPECT_STATUS_FEATURE_BIT) flags |= PFM_SELECTED_FEATURE;
-
-
-                  if (load_parms[0].flags.lid)
-                    {
-                      //  Flag "shallow water processed" or "shoreline depth swapped" HOF data (these two are mututally exclusive in practice).
-
-                      if (abs (hof.abdc) == 74 || abs (hof.abdc) == 72) flags |= PFM_USER_01;
-
-
-                      //  Flag "APD" data
-
-                      if (hof.bot_channel) flags |= PFM_USER_02;
-
-
-                      //  Flag "land" data
-
-                      if (abs (hof.abdc) == 70) flags |= PFM_USER_03;
-                    }
-
-
-                  //  The same attributes will be loaded for primary and secondary returns.
-
-                  if (load_parms[0].pfm_global.attribute_count) getHOFAttributes (attr, load_parms[0].pfm_global, hof);
-
-
-                  beam = 0;
-                  xy.y = hof.latitude;
-                  xy.x = hof.longitude;
-
-
-                  if (hof.correct_depth <= -998.0)
-                    {
-                      if (load_parms[0].flags.hof)
-                        {
-                          //  We're setting the null (-998.0) depths to -999999.0 to put them outside any sane bounds.  This will cause
-                          //  them to be set to the null depth for whatever PFM they fall in.  We want to keep them just to see coverage.
-
-                          lidar_null = NVTrue;
-
-                          depth = -999999.0;
-
-                          Do_PFM_Processing (beam, depth, xy, 0.0, 0.0, flags, 0.0, attr, load_parms, pfm_def, percent, 0, 0);
-                        }
-                    }
-                  else
-                    {
-                      hof_get_uncertainty (hof, &herr, &verr, hof.correct_depth, hof.abdc);
-
-                      if (load_parms[0].flags.lid && hof.correct_sec_depth > -998.0) flags |= PFM_USER_04;
-
-                      depth = -hof.correct_depth;
-
-                      Do_PFM_Processing (beam, depth, xy, herr, verr, flags, 0.0, attr, load_parms, pfm_def, percent, 0, 0);
-                    }
-
-
-                  if (hof.correct_sec_depth > -998.0)
-                    {
-                      flags = 0;
-
-
-                      //  If the absolute value of the abdc is below 70 we mark it as filter invalid.  If the value is
-                      //  below 70 (like a -93) but the absolute value is above 70 we will mark it as manually invalid.
-
-                      if (hof.sec_abdc < 70)
-                        {
-                          if (abs (hof.sec_abdc) < 70)
-                            {
-                              flags = PFM_FILTER_INVAL;
-                            }
-                          else
-                            {
-                              flags = PFM_MANUALLY_INVAL;
-                            }
-                        }
-
-
-                      //  Invalidate HOF land flags.
-
-                      if (load_parms[0].flags.lnd && hof.sec_abdc == 70) flags = (PFM_FILTER_INVAL | PFM_MODIFIED);
-
-
-                      //  Invalidate HOF secondary returns.
-
-                      if (load_parms[0].flags.sec) flags = (PFM_FILTER_INVAL | PFM_MODIFIED);
-
-
-                      if (load_parms[0].flags.lid)
-                        {
-                          //  Flag "shallow water processed" or "shoreline depth swapped" HOF data (these two are mututally exclusive in practice).
-
-                          if (abs (hof.sec_abdc) == 74 || abs (hof.sec_abdc) == 72) flags |= PFM_USER_01;
-
-
-                          //  Flag "APD" data
-
-                          if (hof.sec_bot_chan) flags |= PFM_USER_02;
-
-
-                          //  Flag "land" data
-
-                          if (abs (hof.sec_abdc) == 70) flags |= PFM_USER_03;
-                        }
-
-
-                      hof_get_uncertainty (hof, &herr, &verr, hof.correct_sec_depth, hof.sec_abdc);
-
-                      if (load_parms[0].flags.lid) flags |= PFM_USER_04;
-
-
-                      beam = 1;
-                      xy.y = hof.sec_latitude;
-                      xy.x = hof.sec_longitude;
-                      depth = -hof.correct_sec_depth;
-
-                      Do_PFM_Processing (beam, depth, xy, herr, verr, flags, 0.0, attr, load_parms, pfm_def, percent, 0, 0);
-                    }
-                }
-            }
-          recnum++;
-        }
-
-      prog->setValue (100);
-
-
-      fclose (hof_fp);
-
-
-      //  If we actually wrote any data, write the input file name to the list file.   
-
-      for (i = 0 ; i < pfm_file_count ; i++) 
-        {
-          if (out_count[i]) 
-            {
-              write_line_file (pfm_def[i].hnd, line);
-
-
-              //  Convert to native separators so that we get nice file names on Windows.
-
-              nativePath = QDir::toNativeSeparators (QString (path));
-              strcpy (native_path, nativePath.toAscii ());
-
-              write_list_file (pfm_def[i].hnd, native_path, data_type);
-              count[i] += out_count[i];
-            }
-        }
-    }
-  else
-    {
-      fprintf (errfp, "\n\nUnable to open file %s\n", path);
-      return (0);
-    }
-
-
-  //  We don't return out of range values for HOF data since we load the -998.0 (NBR) values as null depths.
-
-  total_out_of_limits = 0;
-  return (total_out_of_limits);
-}
-
-
-
 NV_BOOL check_tof_file (NV_CHAR *path, QProgressBar *preCheck, FILE *errfp)
 {
   FILE               *tof_fp;
@@ -99,14 +99,12 @@ NV_BOOL check_ivs_xyz_file (NV_CHAR *path, QProgressBar *preCheck, FILE *errfp);
 NV_BOOL check_dted_file (NV_CHAR *path, QProgressBar *preCheck, FILE *errfp);
 NV_BOOL check_chrtr_file (NV_CHAR *path, QProgressBar *preCheck, FILE *errfp);
 
-NV_INT32 load_gsf_file (NV_INT32 pfm_fc, NV_INT32 *count, QString file, QProgressBar *fileInput, FILE *errfp, 
-                        PFM_LOAD_PARAMETERS load_parms[], PFM_DEFINITION pfm_def[]);
+NV_INT32 load_decoded_file (NV_INT32 pfm_fc, NV_INT32 *count, DECODE_FILE *decode, QProgressBar *fileInput, FILE *errfp, 
+                            PFM_LOAD_PARAMETERS load_parms[], PFM_DEFINITION pfm_def[]);
 NV_INT32 load_wlf_file (NV_INT32 pfm_fc, NV_INT32 *count, QString file, QProgressBar *fileInput, FILE *errfp, 
                         PFM_LOAD_PARAMETERS load_parms[], PFM_DEFINITION pfm_def[]);
 NV_INT32 load_hawkeye_file (NV_INT32 pfm_fc, NV_INT32 *count, QString file, QProgressBar *fileInput, FILE *errfp, 
                             PFM_LOAD_PARAMETERS load_parms[], PFM_DEFINITION pfm_def[]);
-NV_INT32 load_hof_file (NV_INT32 pfm_fc, NV_INT32 *count, QString file, QProgressBar *fileInput, FILE *errfp, 
-                        PFM_LOAD_PARAMETERS load_parms[], PFM_DEFINITION pfm_def[]);
 NV_INT32 load_tof_file (NV_INT32 pfm_fc, NV_INT32 *count, QString file, QProgressBar *fileInput, FILE *errfp, 
                         PFM_LOAD_PARAMETERS load_parms[], PFM_DEFINITION pfm_def[]);
 NV_INT32 load_unisips_depth_file (NV_INT32 pfm_fc, NV_INT32 *count, QString file, QProgressBar *fileInput, 
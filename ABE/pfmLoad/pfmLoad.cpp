@@ -1548,9 +1548,59 @@ pfmLoad::slotCustomButtonClicked (int id)
         }
 
 
+      //  GSF and HOF files are decoded on decodeThreads, up to DECODE_THREADS files ahead of the file that we're loading.
+      //  The decoded files are still loaded into the PFM(s) in input file order (by load_decoded_file) so the file numbers
+      //  and the PFM contents don't change.  The Nth decoded file uses decoder N % DECODE_THREADS.
+
+      decodeThread *decoder[DECODE_THREADS];
+      DECODE_FILE *decode_file = new DECODE_FILE[DECODE_THREADS];
+
+      for (NV_INT32 i = 0 ; i < DECODE_THREADS ; i++)
+        {
+          decoder[i] = new decodeThread (this);
+
+          for (NV_INT32 j = 0 ; j < DECODE_BATCHES ; j++)
+            {
+              decode_file[i].batch[j].rec = (DECODED_RECORD *) malloc (DECODE_BATCH_SIZE * sizeof (DECODED_RECORD));
+              if (decode_file[i].batch[j].rec == NULL)
+                {
+                  perror ("Allocating decode batch memory in pfmLoad.cpp");
+                  exit (-1);
+                }
+            }
+
+          decode_file[i].freeBatches = new QSemaphore (DECODE_BATCHES);
+          decode_file[i].usedBatches = new QSemaphore (0);
+        }
+
+      NV_INT32 next_decode = 0, decode_count = 0, decoded_load_count = 0;
+
+
       total_input_count = 0;
       for (NV_INT32 i = 0 ; i < input_file_count ; i++)
         {
+          //  Start decoding any GSF or HOF files that we have a free decoder for.
+
+          while (decode_count - decoded_load_count < DECODE_THREADS)
+            {
+              while (next_decode < input_file_count &&
+                     (!input_file_def[next_decode].status || (input_file_def[next_decode].type != PFM_GSF_DATA &&
+                                                              input_file_def[next_decode].type != PFM_CHARTS_HOF_DATA)))
+                next_decode++;
+
+              if (next_decode >= input_file_count) break;
+
+              NV_INT32 slot = decode_count % DECODE_THREADS;
+
+              decode_file[slot].name = input_file_def[next_decode].name;
+              decode_file[slot].type = input_file_def[next_decode].type;
+              decoder[slot]->decode (&decode_file[slot], load_parms);
+
+              decode_count++;
+              next_decode++;
+            }
+
+
           //  Make sure that the file status was good.
 
           if (input_file_def[i].status)
@@ -1571,7 +1621,19 @@ pfmLoad::slotCustomButtonClicked (int id)
               switch (input_file_def[i].type)
                 {
                 case PFM_GSF_DATA:
-                  out_of_range[i] += load_gsf_file (pfm_file_count, count, input_file_def[i].name, progress.fbar, errfp, load_parms, pfm_def);
+                case PFM_CHARTS_HOF_DATA:
+                  {
+                    NV_INT32 slot = decoded_load_count % DECODE_THREADS;
+
+                    out_of_range[i] += load_decoded_file (pfm_file_count, count, &decode_file[slot], progress.fbar, errfp, load_parms,
+                                                          pfm_def);
+
+
+                    //  The decoder has queued its last batch but we have to make sure it's finished before we reuse it.
+
+                    decoder[slot]->wait ();
+                    decoded_load_count++;
+                  }
                   break;
 
                 case PFM_WLF_DATA:
@@ -1583,10 +1645,6 @@ pfmLoad::slotCustomButtonClicked (int id)
                   out_of_range[i] += load_hawkeye_file (pfm_file_count, count, input_file_def[i].name, progress.fbar, errfp, load_parms, pfm_def);
                   break;
 
-                case PFM_CHARTS_HOF_DATA:
-                  out_of_range[i] += load_hof_file (pfm_file_count, count, input_file_def[i].name, progress.fbar, errfp, load_parms, pfm_def);
-                  break;
-
                 case PFM_SHOALS_TOF_DATA:
                   out_of_range[i] += load_tof_file (pfm_file_count, count, input_file_def[i].name, progress.fbar, errfp, load_parms, pfm_def);
                   break;
@@ -1649,6 +1707,20 @@ pfmLoad::slotCustomButtonClicked (int id)
         }
 
 
+      for (NV_INT32 i = 0 ; i < DECODE_THREADS ; i++)
+        {
+          decoder[i]->wait ();
+          delete decoder[i];
+
+          for (NV_INT32 j = 0 ; j < DECODE_BATCHES ; j++) free (decode_file[i].batch[j].rec);
+
+          delete decode_file[i].freeBatches;
+          delete decode_file[i].usedBatches;
+        }
+
+      delete[] decode_file;
+
+
       //  Just in case we only loaded SRTM data.
 
       if (input_file_count)
@@ -1838,6 +1910,12 @@ pfmLoad::slotCustomButtonClicked (int id)
           BIN_RECORD bin_record;
 
 
+          //  Create (or open) the bin statistics file so that the recompute will fill it in.  This allows pfmView to
+          //  highlight bins using the per bin line and valid sounding counts without reading the soundings.
+
+          open_bin_stats (pfm_def[k].hnd, NVTrue);
+
+
           //  Recompute all of the bins and min/max values.
 
           for (NV_INT32 i = 0; i < pfm_def[k].open_args.head.bin_height; i++)
@@ -46,6 +46,7 @@
 #include "inputPage.hpp"
 #include "runPage.hpp"
 #include "pfmFilter.hpp"
+#include "decodeThread.hpp"
 #include "version.hpp"
 
 
@@ -213,6 +213,59 @@ typedef struct
 } RUN_PROGRESS;
 
 
+//  GSF and HOF files are decoded by decodeThreads, up to DECODE_THREADS files ahead of the file that is being loaded
+//  into the PFM(s).  Each decoder hands its records to the loader in batches of DECODE_BATCH_SIZE records and can get
+//  at most DECODE_BATCHES batches ahead of it.
+
+#define DECODE_THREADS        4
+#define DECODE_BATCHES        4
+#define DECODE_BATCH_SIZE     8192
+
+
+//  Everything that Do_PFM_Processing needs for one sounding.
+
+typedef struct
+{
+  NV_INT32            beam;
+  NV_INT32            recnum;
+  NV_FLOAT64          depth;
+  NV_F64_COORD2       xy;
+  NV_FLOAT32          herr;
+  NV_FLOAT32          verr;
+  NV_U_INT32          flags;
+  NV_FLOAT64          heading;
+  NV_FLOAT32          attr[NUM_ATTR];
+  NV_INT32            percent;
+  NV_BOOL             lidar_null;
+  time_t              tv_sec;
+  long                tv_nsec;
+} DECODED_RECORD;
+
+
+typedef struct
+{
+  NV_INT32            count;
+  NV_BOOL             last;                  //  Last batch for the file
+  DECODED_RECORD      *rec;
+} DECODED_BATCH;
+
+
+typedef struct
+{
+  QString             name;
+  NV_INT32            type;
+  NV_BOOL             opened;                //  Set to NVFalse if the decoder couldn't open the file
+  NV_INT32            data_type;             //  Type to put in the list file (HOF may be loaded as PFM_SHOALS_1K_DATA)
+  NV_CHAR             flightline[64];        //  HOF flightline number and start time for the line name (GSF line names
+  time_t              line_sec;              //  are built from the ping times in Do_PFM_Processing)
+  long                line_nsec;
+  QString             messages;              //  Error messages, written to the error file when the file is loaded
+  DECODED_BATCH       batch[DECODE_BATCHES];
+  QSemaphore          *freeBatches;
+  QSemaphore          *usedBatches;
+} DECODE_FILE;
+
+
 
 #include "load_file.hpp"
 
@@ -45,7 +45,7 @@
 
 #ifndef VERSION
 
-#define     VERSION     "PFM Software - pfmLoad V4.75 - 10/28/11"
+#define     VERSION     "PFM Software - pfmLoad V4.77 - 10/19/26"
 
 #endif
 
@@ -1357,4 +1357,21 @@
 
     Added ability to set the amount of cache memory used for each PFM being built.
 
+
+    Version 4.76
+    Jan C. Depner
+    10/19/26
+
+    Creates the PFM bin statistics file prior to recomputing the bins so that pfmView can use it for
+    highlighting.
+
+
+    Version 4.77
+    Jan C. Depner
+    10/19/26
+
+    GSF and HOF files are now decoded on up to four decodeThreads ahead of the file being loaded.  The
+    decoded soundings are still loaded into the PFM(s) in input file order so file numbers and PFM contents
+    do not change.
+
 </pre>*/
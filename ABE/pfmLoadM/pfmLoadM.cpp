@@ -2052,6 +2052,12 @@ DPRINT
 
 DPRINT
 
+          //  Create (or open) the bin statistics file so that the recompute will fill it in.  This allows pfmView to
+          //  highlight bins using the per bin line and valid sounding counts without reading the soundings.
+
+          open_bin_stats (pfm_def[k].hnd, NVTrue);
+
+
           //  Recompute all of the bins and min/max values.
 
           for (NV_INT32 i = 0; i < pfm_def[k].open_args.head.bin_height; i++)
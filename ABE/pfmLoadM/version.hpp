@@ -45,7 +45,7 @@
 
 #ifndef VERSION
 
-#define     VERSION     "PFM Software - pfmLoadM V4.74 - 10/06/11"
+#define     VERSION     "PFM Software - pfmLoadM V4.76 - 10/19/26"
 
 #endif
 
@@ -1350,4 +1350,19 @@
     Fixed bug in TOF loader.  I was under the impression that if the last return was bad (-998.0)
     then the first return must be bad as well.  This is not the case.
 
+
+    Version 4.75
+    Jan C. Depner
+    10/19/26
+
+    Creates the PFM bin statistics file prior to recomputing the bins so that pfmView can use it for
+    highlighting.
+
+
+    Version 4.76
+    Jan C. Depner
+    10/19/26
+
+    Use a prepared polygon for the area polygon test of every sounding.
+
 </pre>*/
@@ -70,6 +70,14 @@ void writeThread::run ()
   NV_INT32 pfm_file_count = 1;
 
 
+  //  The PFM area polygon can have up to 2000 vertices and we test every sounding against it so we prepare it once.
+
+  PREPARED_POLYGON *area_poly[MAX_PFM_FILES];
+
+  for (NV_INT32 j = 0 ; j < pfm_file_count ; j++)
+    area_poly[j] = prepare_polygon (pfm_def[j].open_args.head.polygon, pfm_def[j].open_args.head.polygon_count);
+
+
   NV_INT32 pos = 0;
   NV_INT32 status = 0;
   NV_INT32 done = 0;
@@ -102,7 +110,7 @@ void writeThread::run ()
       for (NV_INT32 j = 0 ; j < pfm_file_count ; j++) 
         {
           //if (bin_inside_ptr (&pfm_def[j].open_args.head, nxy))
-          if (inside_polygon (pfm_def[j].open_args.head.polygon, pfm_def[j].open_args.head.polygon_count, nxy.x, nxy.y))
+          if (inside_prepared_polygon (area_poly[j], nxy.x, nxy.y))
             {
               //compute_index_ptr (nxy, &depth_record.coord, &pfm_def[j].open_args.head);
               if (pfm_def[j].open_args.head.proj_data.projection)
@@ -189,6 +197,9 @@ void writeThread::run ()
     } while (done < PRODUCERS || usedBuffers[pass]->available ());
 
 
+  for (NV_INT32 j = 0 ; j < pfm_file_count ; j++) free_prepared_polygon (area_poly[j]);
+
+
   emit complete (out_count[0], out_of_limits[0], pass);
   qApp->processEvents ();
 }
@@ -1352,6 +1352,12 @@ pfmLoader::pfmLoader (NV_INT32 argc, NV_CHAR **argv)
       NV_BOOL clear_features (NV_INT32 pfm_handle, NV_I32_COORD2 coord, NV_CHAR *lst, NV_FLOAT64 feature_radius);
 
 
+      //  Create (or open) the bin statistics file so that the recompute will fill it in.  This allows pfmView to
+      //  highlight bins using the per bin line and valid sounding counts without reading the soundings.
+
+      open_bin_stats (pfm_def[k].hnd, NVTrue);
+
+
       //  Recompute all of the bins and min/max values.
 
       for (NV_INT32 i = 0; i < pfm_def[k].open_args.head.bin_height; i++)
@@ -39,7 +39,7 @@
 
 #ifndef VERSION
 
-#define     VERSION     "PFM Software - pfmLoader V1.35 - 10/31/11"
+#define     VERSION     "PFM Software - pfmLoader V1.36 - 10/19/26"
 
 #endif
 
@@ -170,4 +170,12 @@
 
     Now sets max cache memory size (from parameter file) for PFM library.  Happy Halloween!
 
+
+    Version 1.36
+    Jan C. Depner
+    10/19/26
+
+    Creates the PFM bin statistics file prior to recomputing the bins so that pfmView can use it for
+    highlighting.
+
 </pre>*/
@@ -39,7 +39,360 @@
 #include "pfmView.hpp"
 
 
-//!  Computes the minimum and maximum X, Y, and Z for all of the displayed layers (PFM files).
+//  Set a min/max summary to the starting values that we've always used for the displayed area.
+
+static void clear_minmax (MINMAX_TILE *s)
+{
+  s->built = NVFalse;
+  s->count = 0;
+  s->min = 999999999.0;
+  s->max = -999999999.0;
+  s->std = -999999999.0;
+  s->attr_min = 999999999.0;
+  s->attr_max = -999999999.0;
+}
+
+
+
+//  Returns NVTrue if bin a comes before bin b in row major order (the order in which we read the bins).
+
+static NV_BOOL ahead (NV_I32_COORD2 a, NV_I32_COORD2 b)
+{
+  return (a.y < b.y || (a.y == b.y && a.x < b.x));
+}
+
+
+
+/*
+    Merge min/max summary src into dst.  Ties go to the bin that comes first in row major order so that we get the
+    same locations that we would get by reading the whole area row by row no matter what order the summaries are
+    merged in.
+*/
+
+static void merge_minmax (MINMAX_TILE *dst, MINMAX_TILE *src)
+{
+  if (!src->count) return;
+
+  if (src->min < dst->min || (src->min == dst->min && dst->count && ahead (src->min_coord, dst->min_coord)))
+    {
+      dst->min = src->min;
+      dst->min_coord = src->min_coord;
+    }
+
+  if (src->max > dst->max || (src->max == dst->max && dst->count && ahead (src->max_coord, dst->max_coord)))
+    {
+      dst->max = src->max;
+      dst->max_coord = src->max_coord;
+    }
+
+  if (src->std > dst->std || (src->std == dst->std && dst->count && ahead (src->std_coord, dst->std_coord)))
+    {
+      dst->std = src->std;
+      dst->std_coord = src->std_coord;
+    }
+
+  dst->attr_min = qMin (src->attr_min, dst->attr_min);
+  dst->attr_max = qMax (src->attr_max, dst->attr_max);
+
+  dst->count += src->count;
+}
+
+
+
+//  Add count bins from one row (as loaded by loadArrays) to a min/max summary.
+
+static void add_bins (MINMAX_TILE *s, NV_INT32 layer_type, NV_INT32 attribute, NV_INT32 count, BIN_RECORD *bin,
+                      NV_FLOAT32 *row, NV_FLOAT32 *attr, NV_FLOAT32 null_depth)
+{
+  for (NV_INT32 j = 0 ; j < count ; j++)
+    {
+      //  Allow AVERAGE_FILTERED_DEPTH in order to get PFM_INTERPOLATED values (see loadArrays)
+
+      if ((bin[j].num_soundings || layer_type == AVERAGE_FILTERED_DEPTH) && row[j] < null_depth)
+        {
+          if (row[j] < s->min)
+            {
+              s->min = row[j];
+              s->min_coord = bin[j].coord;
+            }
+
+          if (row[j] > s->max)
+            {
+              s->max = row[j];
+              s->max_coord = bin[j].coord;
+            }
+
+          if (bin[j].standard_dev > s->std)
+            {
+              s->std = bin[j].standard_dev;
+              s->std_coord = bin[j].coord;
+            }
+
+          if (attribute)
+            {
+              s->attr_min = qMin (attr[j], s->attr_min);
+              s->attr_max = qMax (attr[j], s->attr_max);
+            }
+
+          s->count++;
+        }
+    }
+}
+
+
+
+/*
+    Build the summaries for the tiles in tile row ty from first_tx to last_tx that aren't already built.  Runs of
+    adjacent tiles are read a bin row at a time.  This is called from the build threads (each with its own PFM
+    handle) so it mustn't touch anything but the tiles in its own row.
+*/
+
+static void build_tile_row (LAYER_MINMAX *lm, NV_INT32 ty, NV_INT32 first_tx, NV_INT32 last_tx, NV_INT32 pfm_handle,
+                            PFM_OPEN_ARGS *open_args, NV_INT32 h_count)
+{
+  MINMAX_TILE *tile = lm->tile[ty];
+  NV_INT32 start_row = ty * MINMAX_TILE_SIZE;
+  NV_INT32 end_row = qMin (start_row + MINMAX_TILE_SIZE, open_args->head.bin_height);
+
+  for (NV_INT32 tx = first_tx ; tx <= last_tx ; tx++)
+    {
+      if (tile[tx].built) continue;
+
+      NV_INT32 run_end = tx;
+      while (run_end < last_tx && !tile[run_end + 1].built) run_end++;
+
+      NV_INT32 start_col = tx * MINMAX_TILE_SIZE;
+      NV_INT32 width = qMin ((run_end + 1) * MINMAX_TILE_SIZE, open_args->head.bin_width) - start_col;
+
+      BIN_RECORD *bin = (BIN_RECORD *) calloc (width, sizeof (BIN_RECORD));
+      NV_FLOAT32 *row = (NV_FLOAT32 *) calloc (width, sizeof (NV_FLOAT32));
+      NV_FLOAT32 *attr = (NV_FLOAT32 *) calloc (width, sizeof (NV_FLOAT32));
+      NV_U_CHAR *flags = (NV_U_CHAR *) calloc (width, sizeof (NV_U_CHAR));
+      if (bin == NULL || row == NULL || attr == NULL || flags == NULL)
+        {
+          perror ("Allocating bin arrays in compute_layer_min_max");
+          exit (-1);
+        }
+
+      for (NV_INT32 i = tx ; i <= run_end ; i++) clear_minmax (&tile[i]);
+
+
+      for (NV_INT32 i = start_row ; i < end_row ; i++)
+        {
+          read_bin_row (pfm_handle, width, i, start_col, bin);
+
+          loadArrays (lm->layer_type, width, bin, row, attr, lm->attribute, flags, H_NONE, h_count, pfm_handle, *open_args, 0.0,
+                      lm->surface_val);
+
+          for (NV_INT32 j = tx ; j <= run_end ; j++)
+            {
+              NV_INT32 offset = (j - tx) * MINMAX_TILE_SIZE;
+
+              add_bins (&tile[j], lm->layer_type, lm->attribute, qMin (MINMAX_TILE_SIZE, width - offset), &bin[offset],
+                        &row[offset], &attr[offset], open_args->head.null_depth);
+            }
+        }
+
+      for (NV_INT32 i = tx ; i <= run_end ; i++) tile[i].built = NVTrue;
+
+      free (bin);
+      free (row);
+      free (attr);
+      free (flags);
+
+      tx = run_end;
+    }
+}
+
+
+
+//!  Thread used to build the min/max summaries for some of the tile rows of a PFM layer.
+
+class minMaxThread:public QThread
+{
+public:
+
+  LAYER_MINMAX            *lm;
+  PFM_OPEN_ARGS           open_args;
+  NV_INT32                pfm_handle, h_count, first_tx, last_tx, row_count, rows_done;
+  NV_INT32                *tile_row;
+
+
+protected:
+
+  void run ()
+  {
+    for (NV_INT32 i = 0 ; i < row_count ; i++)
+      {
+        build_tile_row (lm, tile_row[i], first_tx, last_tx, pfm_handle, &open_args, h_count);
+        rows_done++;
+      }
+  }
+};
+
+
+
+//  Throw away all of the tile summaries for a layer.
+
+static void reset_layer_minmax (LAYER_MINMAX *lm)
+{
+  if (lm->tile)
+    {
+      for (NV_INT32 i = 0 ; i < lm->tiles_high ; i++) if (lm->tile[i]) free (lm->tile[i]);
+      free (lm->tile);
+      lm->tile = NULL;
+    }
+}
+
+
+
+/*
+    Find the tile summaries for PFM layer pfm.  If we don't have any (or they were built from a different layer type
+    or attribute) we start over.  We also start over if the bin file has changed and we didn't invalidate the changed
+    areas ourselves (see invalidate_layer_min_max) since we have no idea what was changed.
+*/
+
+static LAYER_MINMAX *get_layer_minmax (MISC *misc, NV_INT32 pfm, NV_INT32 attribute)
+{
+  PFM_OPEN_ARGS *open_args = &misc->abe_share->open_args[pfm];
+  LAYER_MINMAX *lm = NULL;
+
+
+  for (NV_INT32 i = 0 ; i < MAX_ABE_PFMS ; i++)
+    {
+      if (!strcmp (misc->layer_minmax[i].list_path, open_args->list_path))
+        {
+          lm = &misc->layer_minmax[i];
+          break;
+        }
+    }
+
+
+  //  If we didn't find it, use a slot that doesn't belong to any of the open layers.
+
+  if (lm == NULL)
+    {
+      for (NV_INT32 i = 0 ; i < MAX_ABE_PFMS && lm == NULL ; i++)
+        {
+          NV_BOOL used = NVFalse;
+
+          for (NV_INT32 j = 0 ; j < misc->abe_share->pfm_count ; j++)
+            {
+              if (misc->layer_minmax[i].list_path[0] && !strcmp (misc->layer_minmax[i].list_path, misc->abe_share->open_args[j].list_path))
+                used = NVTrue;
+            }
+
+          if (!used) lm = &misc->layer_minmax[i];
+        }
+
+      reset_layer_minmax (lm);
+      strcpy (lm->list_path, open_args->list_path);
+    }
+
+
+  //  Make sure anything that has been written through our handle has made it to the bin file before we check it (reading
+  //  through the handle flushes it).
+
+  BIN_RECORD bin;
+  read_bin_row (misc->pfm_handle[pfm], 1, 0, 0, &bin);
+
+  QFileInfo bin_info (QString (open_args->bin_path));
+  NV_U_INT32 bin_time = bin_info.lastModified ().toTime_t ();
+  NV_INT64 bin_size = bin_info.size ();
+
+  if (lm->tile && (lm->layer_type != misc->abe_share->layer_type || lm->attribute != attribute || lm->surface_val != misc->surface_val ||
+                   lm->tiles_wide != (open_args->head.bin_width + MINMAX_TILE_SIZE - 1) / MINMAX_TILE_SIZE ||
+                   lm->tiles_high != (open_args->head.bin_height + MINMAX_TILE_SIZE - 1) / MINMAX_TILE_SIZE ||
+                   (!lm->resync && (lm->bin_time != bin_time || lm->bin_size != bin_size))))
+    reset_layer_minmax (lm);
+
+
+  if (lm->tile == NULL)
+    {
+      lm->layer_type = misc->abe_share->layer_type;
+      lm->attribute = attribute;
+      lm->surface_val = misc->surface_val;
+      lm->tiles_wide = (open_args->head.bin_width + MINMAX_TILE_SIZE - 1) / MINMAX_TILE_SIZE;
+      lm->tiles_high = (open_args->head.bin_height + MINMAX_TILE_SIZE - 1) / MINMAX_TILE_SIZE;
+
+      lm->tile = (MINMAX_TILE **) calloc (lm->tiles_high, sizeof (MINMAX_TILE *));
+      if (lm->tile == NULL)
+        {
+          perror (pfmView::tr ("Allocating layer_minmax tile rows in compute_layer_min_max").toAscii ());
+          exit (-1);
+        }
+    }
+
+  lm->bin_time = bin_time;
+  lm->bin_size = bin_size;
+  lm->resync = NVFalse;
+
+  return (lm);
+}
+
+
+
+/*!
+    Marks the min/max tile summaries that overlap mbr as out of date for PFM layer pfm (or for all layers if pfm is
+    -1).  This has to be called after we (or the editor) change bins in a PFM so that compute_layer_min_max will
+    rebuild just those tiles.  If the bin file changes without this being called all of the tiles will be rebuilt.
+*/
+
+void invalidate_layer_min_max (MISC *misc, NV_INT32 pfm, NV_F64_XYMBR mbr)
+{
+  for (NV_INT32 layer = 0 ; layer < misc->abe_share->pfm_count ; layer++)
+    {
+      if (pfm >= 0 && layer != pfm) continue;
+
+      PFM_OPEN_ARGS *open_args = &misc->abe_share->open_args[layer];
+
+      for (NV_INT32 i = 0 ; i < MAX_ABE_PFMS ; i++)
+        {
+          LAYER_MINMAX *lm = &misc->layer_minmax[i];
+
+          if (lm->tile == NULL || strcmp (lm->list_path, open_args->list_path)) continue;
+
+
+          //  Convert the area to bins (plus one all around to be safe).
+
+          NV_INT32 start_x = (NV_INT32) ((mbr.min_x - open_args->head.mbr.min_x) / open_args->head.x_bin_size_degrees) - 1;
+          NV_INT32 end_x = (NV_INT32) ((mbr.max_x - open_args->head.mbr.min_x) / open_args->head.x_bin_size_degrees) + 1;
+          NV_INT32 start_y = (NV_INT32) ((mbr.min_y - open_args->head.mbr.min_y) / open_args->head.y_bin_size_degrees) - 1;
+          NV_INT32 end_y = (NV_INT32) ((mbr.max_y - open_args->head.mbr.min_y) / open_args->head.y_bin_size_degrees) + 1;
+
+          start_x = qMax (start_x, 0);
+          end_x = qMin (end_x, open_args->head.bin_width - 1);
+          start_y = qMax (start_y, 0);
+          end_y = qMin (end_y, open_args->head.bin_height - 1);
+
+
+          //  If the area doesn't overlap the layer we haven't accounted for whatever changed so we leave resync alone.
+
+          if (start_x > end_x || start_y > end_y) continue;
+
+
+          for (NV_INT32 ty = start_y / MINMAX_TILE_SIZE ; ty <= end_y / MINMAX_TILE_SIZE ; ty++)
+            {
+              if (lm->tile[ty] == NULL) continue;
+
+              for (NV_INT32 tx = start_x / MINMAX_TILE_SIZE ; tx <= end_x / MINMAX_TILE_SIZE ; tx++) lm->tile[ty][tx].built = NVFalse;
+            }
+
+          lm->resync = NVTrue;
+        }
+    }
+}
+
+
+
+/*!
+    Computes the minimum and maximum X, Y, and Z for all of the displayed layers (PFM files).
+
+    Instead of reading every bin in the displayed area each time, we keep min/max summaries for MINMAX_TILE_SIZE
+    square tiles of each layer.  The tiles that are completely inside the displayed area come from the summaries
+    (only building the ones that are missing or have been invalidated) and the partial tiles around the edges are
+    read directly.  Large builds are split across threads, each with its own handle for the PFM.
+*/
 
 NV_BOOL compute_layer_min_max (MISC *misc, OPTIONS *options)
 {
@@ -59,7 +412,6 @@ NV_BOOL compute_layer_min_max (MISC *misc, OPTIONS *options)
   NV_BOOL min_lock = NVFalse, max_lock = NVFalse;
 
 
-  //  Pre-read the data to get the min and max (since most disk systems cache this isn't much of a performance hit).
   //  The loop runs from max to min so that we end up with the final bounds defined by PFM layer 0.
 
   for (NV_INT32 pfm = misc->abe_share->pfm_count - 1 ; pfm >= 0 ; pfm--)
@@ -84,43 +436,66 @@ NV_BOOL compute_layer_min_max (MISC *misc, OPTIONS *options)
                 attribute = misc->color_by_attribute;
 
 
-	      //  Allocate the needed arrays.
+              PFM_OPEN_ARGS *open_args = &misc->abe_share->open_args[pfm];
+              LAYER_MINMAX *lm = get_layer_minmax (misc, pfm, attribute);
 
-	      BIN_RECORD *current_record = (BIN_RECORD *) calloc (misc->displayed_area_width[pfm], sizeof (BIN_RECORD));
-	      if (current_record == NULL)
-                {
-                  perror (pfmView::tr ("Allocating current_record in compute_layer_min_max").toAscii ());
-                  exit (-1);
-                }
+              NV_INT32 start_col = misc->displayed_area_column[pfm], end_col = start_col + misc->displayed_area_width[pfm];
+              NV_INT32 start_row = misc->displayed_area_row[pfm], end_row = start_row + misc->displayed_area_height[pfm];
 
-	      misc->current_row = (NV_FLOAT32 *) calloc (misc->displayed_area_width[pfm], sizeof (NV_FLOAT32));
-	      if (misc->current_row == NULL)
-                {
-                  perror (pfmView::tr ("Allocating current_row in compute_layer_min_max").toAscii ());
-                  exit (-1);
-                }
 
-	      if (attribute)
+              //  Figure out which tiles are completely inside the displayed area (the partial tile at the right or top
+              //  edge of the PFM counts if the displayed area goes all the way to the edge).
+
+              NV_INT32 first_tx = (start_col + MINMAX_TILE_SIZE - 1) / MINMAX_TILE_SIZE;
+              NV_INT32 last_tx = (end_col == open_args->head.bin_width) ? lm->tiles_wide - 1 : end_col / MINMAX_TILE_SIZE - 1;
+              NV_INT32 first_ty = (start_row + MINMAX_TILE_SIZE - 1) / MINMAX_TILE_SIZE;
+              NV_INT32 last_ty = (end_row == open_args->head.bin_height) ? lm->tiles_high - 1 : end_row / MINMAX_TILE_SIZE - 1;
+
+              NV_INT32 inner_start_col = end_col, inner_end_col = end_col, inner_start_row = end_row, inner_end_row = end_row;
+              NV_INT32 dirty_rows = 0, dirty_tiles = 0;
+              NV_INT32 *tile_row = NULL;
+
+              if (first_tx <= last_tx && first_ty <= last_ty)
                 {
-                  misc->current_attr = (NV_FLOAT32 *) calloc (misc->displayed_area_width[pfm], sizeof (NV_FLOAT32));
-                  if (misc->current_attr == NULL)
+                  inner_start_col = first_tx * MINMAX_TILE_SIZE;
+                  inner_end_col = qMin ((last_tx + 1) * MINMAX_TILE_SIZE, open_args->head.bin_width);
+                  inner_start_row = first_ty * MINMAX_TILE_SIZE;
+                  inner_end_row = qMin ((last_ty + 1) * MINMAX_TILE_SIZE, open_args->head.bin_height);
+
+
+                  //  Find the tile rows that need building.
+
+                  tile_row = (NV_INT32 *) malloc ((last_ty - first_ty + 1) * sizeof (NV_INT32));
+                  if (tile_row == NULL)
                     {
-                      perror (pfmView::tr ("Allocating current_attr in compute_layer_min_max").toAscii ());
+                      perror (pfmView::tr ("Allocating tile_row in compute_layer_min_max").toAscii ());
                       exit (-1);
                     }
-                }
 
-	      misc->current_flags = (NV_U_CHAR *) calloc (misc->displayed_area_width[pfm], sizeof (NV_CHAR));
-              if (misc->current_flags == NULL)
-                {
-                  perror (pfmView::tr ("Allocating current_flags in compute_layer_min_max").toAscii ());
-                  exit (-1);
+                  for (NV_INT32 ty = first_ty ; ty <= last_ty ; ty++)
+                    {
+                      if (lm->tile[ty] == NULL)
+                        {
+                          lm->tile[ty] = (MINMAX_TILE *) calloc (lm->tiles_wide, sizeof (MINMAX_TILE));
+                          if (lm->tile[ty] == NULL)
+                            {
+                              perror (pfmView::tr ("Allocating layer_minmax tiles in compute_layer_min_max").toAscii ());
+                              exit (-1);
+                            }
+                        }
+
+                      NV_INT32 dirty = 0;
+                      for (NV_INT32 tx = first_tx ; tx <= last_tx ; tx++) if (!lm->tile[ty][tx].built) dirty++;
+
+                      if (dirty) tile_row[dirty_rows++] = ty;
+                      dirty_tiles += dirty;
+                    }
                 }
 
 
-              misc->statusProg->setRange (0, misc->displayed_area_height[pfm]);
+              misc->statusProg->setRange (0, dirty_rows + 1);
               QString title = pfmView::tr (" Loading %1 of %2 : ").arg (misc->abe_share->pfm_count - pfm).arg (misc->abe_share->pfm_count) +
-                QFileInfo (QString (misc->abe_share->open_args[pfm].list_path)).fileName () + " ";
+                QFileInfo (QString (open_args->list_path)).fileName () + " ";
               misc->statusProgPalette.setColor (QPalette::Normal, QPalette::Window, Qt::green);
               misc->statusProgLabel->setPalette (misc->statusProgPalette);
               misc->statusProgLabel->setText (title);
@@ -128,75 +503,200 @@ NV_BOOL compute_layer_min_max (MISC *misc, OPTIONS *options)
               qApp->processEvents();
 
 
-              //  We only want to update the progress bar at about 20% increments.  This makes things go
-              //  marginally faster.
+              //  Build the missing tiles.  If there are enough of them we split the tile rows across threads.  Each
+              //  thread needs its own PFM handle so we're limited by the number of PFM files we can have open.
+
+              NV_INT32 num_threads = 0;
+              minMaxThread *build = NULL;
+
+              if (dirty_tiles >= MINMAX_THREAD_TILES)
+                {
+                  NV_INT32 max_threads = qMin (qMin (QThread::idealThreadCount (), dirty_rows), MAX_PFM_FILES - misc->abe_share->pfm_count - 1);
+
+                  if (max_threads > 1)
+                    {
+                      build = new minMaxThread[max_threads];
+
+                      for (NV_INT32 i = 0 ; i < max_threads ; i++)
+                        {
+                          build[i].open_args = *open_args;
+                          build[i].open_args.checkpoint = 0;
+                          if ((build[i].pfm_handle = open_existing_pfm_file (&build[i].open_args)) < 0) break;
+                          num_threads++;
+                        }
+
+                      if (num_threads < 2)
+                        {
+                          for (NV_INT32 i = 0 ; i < num_threads ; i++) close_pfm_file (build[i].pfm_handle);
+                          num_threads = 0;
+                          delete[] build;
+                          build = NULL;
+                        }
+                    }
+                }
+
+
+              if (num_threads)
+                {
+                  for (NV_INT32 i = 0 ; i < num_threads ; i++)
+                    {
+                      NV_INT32 first = (dirty_rows * i) / num_threads;
+
+                      build[i].lm = lm;
+                      build[i].h_count = options->h_count;
+                      build[i].first_tx = first_tx;
+                      build[i].last_tx = last_tx;
+                      build[i].tile_row = &tile_row[first];
+                      build[i].row_count = (dirty_rows * (i + 1)) / num_threads - first;
+                      build[i].rows_done = 0;
+                      build[i].start ();
+                    }
+
+
+                  //  Keep the progress bar moving while we wait.
 
-              NV_INT32 prog_inc = misc->displayed_area_height[pfm] / 5;
-              if (!prog_inc) prog_inc = 1;
+                  NV_BOOL finished = NVFalse;
+                  while (!finished)
+                    {
+                      NV_INT32 rows_done = 0;
+                      finished = NVTrue;
 
+                      for (NV_INT32 i = 0 ; i < num_threads ; i++)
+                        {
+                          rows_done += build[i].rows_done;
+                          if (!build[i].isFinished ()) finished = NVFalse;
+                        }
 
-              for (NV_INT32 i = 0 ; i < misc->displayed_area_height[pfm] ; i++)
+                      misc->statusProg->setValue (rows_done);
+                      qApp->processEvents ();
+
+                      if (!finished)
+                        {
+                          for (NV_INT32 i = 0 ; i < num_threads ; i++)
+                            {
+                              if (!build[i].isFinished ())
+                                {
+                                  build[i].wait (100);
+                                  break;
+                                }
+                            }
+                        }
+                    }
+
+                  for (NV_INT32 i = 0 ; i < num_threads ; i++)
+                    {
+                      build[i].wait ();
+                      close_pfm_file (build[i].pfm_handle);
+                    }
+
+                  delete[] build;
+                }
+              else
                 {
-                  if (!(i % prog_inc))
+                  for (NV_INT32 i = 0 ; i < dirty_rows ; i++)
                     {
+                      build_tile_row (lm, tile_row[i], first_tx, last_tx, misc->pfm_handle[pfm], open_args, options->h_count);
+
                       misc->statusProg->setValue (i);
                       qApp->processEvents();
                     }
+                }
+
+
+              //  Combine the tile summaries.
+
+              MINMAX_TILE area;
+              clear_minmax (&area);
+
+              for (NV_INT32 ty = first_ty ; ty <= last_ty && tile_row ; ty++)
+                {
+                  for (NV_INT32 tx = first_tx ; tx <= last_tx ; tx++) merge_minmax (&area, &lm->tile[ty][tx]);
+                }
+
+              if (tile_row) free (tile_row);
+
+
+              //  Read the partial tiles around the edges of the displayed area (rows above and below the full tiles
+              //  and the columns to the left and right of them).
+
+              NV_INT32 width = misc->displayed_area_width[pfm];
+
+              BIN_RECORD *current_record = (BIN_RECORD *) calloc (width, sizeof (BIN_RECORD));
+              if (current_record == NULL)
+                {
+                  perror (pfmView::tr ("Allocating current_record in compute_layer_min_max").toAscii ());
+                  exit (-1);
+                }
 
+              misc->current_row = (NV_FLOAT32 *) calloc (width, sizeof (NV_FLOAT32));
+              misc->current_attr = (NV_FLOAT32 *) calloc (width, sizeof (NV_FLOAT32));
+              misc->current_flags = (NV_U_CHAR *) calloc (width, sizeof (NV_CHAR));
+              if (misc->current_row == NULL || misc->current_attr == NULL || misc->current_flags == NULL)
+                {
+                  perror (pfmView::tr ("Allocating current_row in compute_layer_min_max").toAscii ());
+                  exit (-1);
+                }
 
-                  read_bin_row (misc->pfm_handle[pfm], misc->displayed_area_width[pfm], misc->displayed_area_row[pfm] + i, 
-                                misc->displayed_area_column[pfm], current_record);
 
+              MINMAX_TILE edge;
+              clear_minmax (&edge);
 
-                  loadArrays (misc->abe_share->layer_type, misc->displayed_area_width[pfm], current_record, misc->current_row,
-                              misc->current_attr, attribute, misc->current_flags, H_NONE, options->h_count,
-                              misc->pfm_handle[pfm], misc->abe_share->open_args[pfm], 0.0, misc->surface_val);
+              for (NV_INT32 i = start_row ; i < end_row ; i++)
+                {
+                  NV_INT32 span_start[2] = {start_col, inner_end_col}, span_end[2] = {end_col, end_col};
 
+                  if (i >= inner_start_row && i < inner_end_row) span_end[0] = inner_start_col;
 
-                  for (NV_INT32 j = 0 ; j < misc->displayed_area_width[pfm] ; j++)
+                  for (NV_INT32 k = 0 ; k < 2 ; k++)
                     {
-                      //  Allow AVERAGE_FILTERED_DEPTH in order to get PFM_INTERPOLATED values (see loadArrays)
+                      NV_INT32 count = span_end[k] - span_start[k];
 
-                      if (current_record[j].num_soundings || misc->abe_share->layer_type == AVERAGE_FILTERED_DEPTH)
-                        {
-                          if (misc->current_row[j] < misc->abe_share->open_args[pfm].head.null_depth)
-                            {
-                              //  Since the user may have turned on display of minimum, maximum, and max standard deviation
-                              //  we're going to save these so we don't have to read through the data again to find the 
-                              //  locations.
+                      if (count <= 0 || (k && i < inner_start_row) || (k && i >= inner_end_row)) continue;
 
-                              if (misc->current_row[j] < misc->displayed_area_min)
-                                {
-                                  misc->displayed_area_min = misc->current_row[j];
-                                  misc->displayed_area_min_coord.x = misc->displayed_area_column[pfm] + j;
-                                  misc->displayed_area_min_coord.y = misc->displayed_area_row[pfm] + i;
-                                  misc->displayed_area_min_pfm = pfm;
-                                }
+                      read_bin_row (misc->pfm_handle[pfm], count, i, span_start[k], current_record);
 
-                              if (misc->current_row[j] > misc->displayed_area_max) 
-                                {
-                                  misc->displayed_area_max = misc->current_row[j];
-                                  misc->displayed_area_max_coord.x = misc->displayed_area_column[pfm] + j;
-                                  misc->displayed_area_max_coord.y = misc->displayed_area_row[pfm] + i;
-                                  misc->displayed_area_max_pfm = pfm;
-                                }
+                      loadArrays (misc->abe_share->layer_type, count, current_record, misc->current_row, misc->current_attr, attribute,
+                                  misc->current_flags, H_NONE, options->h_count, misc->pfm_handle[pfm], *open_args, 0.0,
+                                  misc->surface_val);
 
-                              if (current_record[j].standard_dev > misc->displayed_area_std) 
-                                {
-                                  misc->displayed_area_std = current_record[j].standard_dev;
-                                  misc->displayed_area_std_coord.x = misc->displayed_area_column[pfm] + j;
-                                  misc->displayed_area_std_coord.y = misc->displayed_area_row[pfm] + i;
-                                  misc->displayed_area_std_pfm = pfm;
-                                }
+                      add_bins (&edge, misc->abe_share->layer_type, attribute, count, current_record, misc->current_row,
+                                misc->current_attr, open_args->head.null_depth);
+                    }
+                }
 
+              merge_minmax (&area, &edge);
 
-                              if (attribute)
-                                {
-                                  misc->displayed_area_attr_min = qMin (misc->current_attr[j], misc->displayed_area_attr_min);
-                                  misc->displayed_area_attr_max = qMax (misc->current_attr[j], misc->displayed_area_attr_max);
-                                }
-                            }
-                        }
+
+              //  Since the user may have turned on display of minimum, maximum, and max standard deviation we're going to
+              //  save the locations so we don't have to read through the data again to find them.
+
+              if (area.count)
+                {
+                  if (area.min < misc->displayed_area_min)
+                    {
+                      misc->displayed_area_min = area.min;
+                      misc->displayed_area_min_coord = area.min_coord;
+                      misc->displayed_area_min_pfm = pfm;
+                    }
+
+                  if (area.max > misc->displayed_area_max) 
+                    {
+                      misc->displayed_area_max = area.max;
+                      misc->displayed_area_max_coord = area.max_coord;
+                      misc->displayed_area_max_pfm = pfm;
+                    }
+
+                  if (area.std > misc->displayed_area_std) 
+                    {
+                      misc->displayed_area_std = area.std;
+                      misc->displayed_area_std_coord = area.std_coord;
+                      misc->displayed_area_std_pfm = pfm;
+                    }
+
+                  if (attribute)
+                    {
+                      misc->displayed_area_attr_min = qMin (area.attr_min, misc->displayed_area_attr_min);
+                      misc->displayed_area_attr_max = qMax (area.attr_max, misc->displayed_area_attr_max);
                     }
                 }
 
@@ -213,7 +713,7 @@ NV_BOOL compute_layer_min_max (MISC *misc, OPTIONS *options)
                 }
 
 
-              misc->statusProg->setValue (misc->displayed_area_height[pfm]);
+              misc->statusProg->setValue (dirty_rows + 1);
               qApp->processEvents();
 
 
@@ -265,7 +765,7 @@ NV_BOOL compute_layer_min_max (MISC *misc, OPTIONS *options)
 
 	      free (current_record);
 	      free (misc->current_row);
-	      if (attribute) free (misc->current_attr);
+	      free (misc->current_attr);
 	      free (misc->current_flags);
             }
         }
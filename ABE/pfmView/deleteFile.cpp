@@ -229,6 +229,10 @@ deleteFile::slotApply ()
   NV_INT32            recnum;
 
 
+  void invalidate_layer_min_max (MISC *misc, NV_INT32 pfm, NV_F64_XYMBR mbr);
+  void invalidate_point_cache (MISC *misc, NV_INT32 pfm, NV_F64_XYMBR mbr);
+
+
   //  Keeps people from multi-clicking the button.  If you try to disable it, you segfault.
 
   if (running) return;
@@ -349,6 +353,9 @@ deleteFile::slotApply ()
             }
         }
 
+      invalidate_layer_min_max (misc, 0, misc->abe_share->open_args[0].head.mbr);
+      invalidate_point_cache (misc, 0, misc->abe_share->open_args[0].head.mbr);
+
 
       misc->statusProg->reset ();
       misc->statusProg->setTextVisible (FALSE);
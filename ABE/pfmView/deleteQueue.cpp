@@ -187,6 +187,10 @@ deleteQueue::slotAccept ()
   NV_INT32            recnum, **pfm_list, *file_count;
 
 
+  void invalidate_layer_min_max (MISC *misc, NV_INT32 pfm, NV_F64_XYMBR mbr);
+  void invalidate_point_cache (MISC *misc, NV_INT32 pfm, NV_F64_XYMBR mbr);
+
+
   //  Keeps people from multi-clicking the button.  If you try to disable it, you segfault.
 
   if (running) return;
@@ -293,6 +297,9 @@ deleteQueue::slotAccept ()
               qApp->processEvents();
             }
 
+          invalidate_layer_min_max (misc, pfm, misc->abe_share->open_args[pfm].head.mbr);
+          invalidate_point_cache (misc, pfm, misc->abe_share->open_args[pfm].head.mbr);
+
 
           //  Mark the files as deleted and then rename the actual files so that they won't get used again.
 
@@ -61,6 +61,25 @@ void loadArrays (NV_INT32 layer_type, NV_INT32 count, BIN_RECORD bin_record[], N
   NV_INT32            i, j, recnum;
   NV_U_INT32          prev_line;
   DEPTH_RECORD        *depth;
+  BIN_STATS           *stats = NULL;
+
+
+  //  The following highlight options need information that isn't in the bin record.  If the PFM has a bin statistics
+  //  file we can get it for the whole row in one read instead of reading every sounding in every bin.  The bin records
+  //  must be a contiguous piece of a single row (they always are coming from read_bin_row).
+
+  if ((highlight == H_MULT || highlight == H_COUNT || highlight == H_IHO_S || highlight == H_IHO_1 || highlight == H_IHO_2 ||
+       highlight == H_PERCENT) && count && bin_stats_available (pfm_handle) &&
+      bin_record[count - 1].coord.y == bin_record[0].coord.y && bin_record[count - 1].coord.x == bin_record[0].coord.x + count - 1)
+    {
+      stats = (BIN_STATS *) malloc (count * sizeof (BIN_STATS));
+
+      if (stats != NULL && read_bin_stats_row (pfm_handle, count, bin_record[0].coord.y, bin_record[0].coord.x, stats))
+        {
+          free (stats);
+          stats = NULL;
+        }
+    }
 
 
   for (i = 0 ; i < count ; i++)
@@ -257,7 +276,11 @@ void loadArrays (NV_INT32 layer_type, NV_INT32 count, BIN_RECORD bin_record[], N
 
             case H_MULT:
               flags[i] = 0;
-              if (!read_depth_array_index (pfm_handle, bin_record[i].coord, &depth, &recnum))
+              if (stats != NULL && check_bin_stats (pfm_handle, &bin_record[i], &stats[i]))
+                {
+                  if (stats[i].num_lines > 1) flags[i] = 1;
+                }
+              else if (!read_depth_array_index (pfm_handle, bin_record[i].coord, &depth, &recnum))
                 {
                   prev_line = depth[0].line_number;
                   for (j = 1 ; j < recnum ; j++)
@@ -276,7 +299,11 @@ void loadArrays (NV_INT32 layer_type, NV_INT32 count, BIN_RECORD bin_record[], N
 
             case H_COUNT:
               flags[i] = 0;
-              if (!read_depth_array_index (pfm_handle, bin_record[i].coord, &depth, &recnum))
+              if (stats != NULL && check_bin_stats (pfm_handle, &bin_record[i], &stats[i]))
+                {
+                  if ((NV_INT32) stats[i].num_valid > h_count) flags[i] = 1;
+                }
+              else if (!read_depth_array_index (pfm_handle, bin_record[i].coord, &depth, &recnum))
                 {
                   NV_INT32 count = 0;
 
@@ -305,10 +332,14 @@ void loadArrays (NV_INT32 layer_type, NV_INT32 count, BIN_RECORD bin_record[], N
 
 	      if (bin_record[i].avg_filtered_depth > 0.0 && bin_record[i].avg_filtered_depth <= 200.0)
 		{
-		  if (!read_depth_array_index (pfm_handle, bin_record[i].coord, &depth, &recnum))
-		    {
-		      NV_FLOAT64 envelope = 0.25 + 0.0075 * bin_record[i].avg_filtered_depth;
+		  NV_FLOAT64 envelope = 0.25 + 0.0075 * bin_record[i].avg_filtered_depth;
 
+		  if (stats != NULL && check_bin_stats (pfm_handle, &bin_record[i], &stats[i]))
+		    {
+		      if (stats[i].max_offset > envelope) flags[i] = 1;
+		    }
+		  else if (!read_depth_array_index (pfm_handle, bin_record[i].coord, &depth, &recnum))
+		    {
 		      for (j = 1 ; j < recnum ; j++)
 			{
 			  if (!(depth[j].validity & (PFM_INVAL | PFM_DELETED | PFM_REFERENCE)))
@@ -334,10 +365,14 @@ void loadArrays (NV_INT32 layer_type, NV_INT32 count, BIN_RECORD bin_record[], N
 
 	      if (bin_record[i].avg_filtered_depth > 0.0 && bin_record[i].avg_filtered_depth <= 200.0)
 		{
-		  if (!read_depth_array_index (pfm_handle, bin_record[i].coord, &depth, &recnum))
-		    {
-		      NV_FLOAT64 envelope = 0.5 + 0.013 * bin_record[i].avg_filtered_depth;
+		  NV_FLOAT64 envelope = 0.5 + 0.013 * bin_record[i].avg_filtered_depth;
 
+		  if (stats != NULL && check_bin_stats (pfm_handle, &bin_record[i], &stats[i]))
+		    {
+		      if (stats[i].max_offset > envelope) flags[i] = 1;
+		    }
+		  else if (!read_depth_array_index (pfm_handle, bin_record[i].coord, &depth, &recnum))
+		    {
 		      for (j = 1 ; j < recnum ; j++)
 			{
 			  if (!(depth[j].validity & (PFM_INVAL | PFM_DELETED | PFM_REFERENCE)))
@@ -363,10 +398,14 @@ void loadArrays (NV_INT32 layer_type, NV_INT32 count, BIN_RECORD bin_record[], N
 
 	      if (bin_record[i].avg_filtered_depth > 0.0 && bin_record[i].avg_filtered_depth <= 200.0)
 		{
-		  if (!read_depth_array_index (pfm_handle, bin_record[i].coord, &depth, &recnum))
-		    {
-		      NV_FLOAT64 envelope = 1.0 + 0.023 * bin_record[i].avg_filtered_depth;
+		  NV_FLOAT64 envelope = 1.0 + 0.023 * bin_record[i].avg_filtered_depth;
 
+		  if (stats != NULL && check_bin_stats (pfm_handle, &bin_record[i], &stats[i]))
+		    {
+		      if (stats[i].max_offset > envelope) flags[i] = 1;
+		    }
+		  else if (!read_depth_array_index (pfm_handle, bin_record[i].coord, &depth, &recnum))
+		    {
 		      for (j = 1 ; j < recnum ; j++)
 			{
 			  if (!(depth[j].validity & (PFM_INVAL | PFM_DELETED | PFM_REFERENCE)))
@@ -392,10 +431,14 @@ void loadArrays (NV_INT32 layer_type, NV_INT32 count, BIN_RECORD bin_record[], N
 
 	      if (bin_record[i].avg_filtered_depth > 20.0)
 		{
-		  if (!read_depth_array_index (pfm_handle, bin_record[i].coord, &depth, &recnum))
-		    {
-		      NV_FLOAT64 envelope = bin_record[i].avg_filtered_depth * (percent / 100.0);
+		  NV_FLOAT64 envelope = bin_record[i].avg_filtered_depth * (percent / 100.0);
 
+		  if (stats != NULL && check_bin_stats (pfm_handle, &bin_record[i], &stats[i]))
+		    {
+		      if (stats[i].max_offset > envelope) flags[i] = 1;
+		    }
+		  else if (!read_depth_array_index (pfm_handle, bin_record[i].coord, &depth, &recnum))
+		    {
 		      for (j = 1 ; j < recnum ; j++)
 			{
 			  if (!(depth[j].validity & (PFM_INVAL | PFM_DELETED | PFM_REFERENCE)))
@@ -433,4 +476,6 @@ void loadArrays (NV_INT32 layer_type, NV_INT32 count, BIN_RECORD bin_record[], N
           flags[i] = 0;
         }
     }
+
+  if (stats != NULL) free (stats);
 }
@@ -823,6 +823,10 @@ void filterPolyArea (OPTIONS *options, MISC *misc, NV_FLOAT64 *mx, NV_FLOAT64 *m
       qApp->processEvents();
 
 
+      invalidate_layer_min_max (misc, pfm, bounds);
+      invalidate_point_cache (misc, pfm, bounds);
+
+
       //  If the average surface is a MISP surface, recompute that also
 
       remisp (misc, options, &bounds);
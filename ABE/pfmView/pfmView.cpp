@@ -137,6 +137,8 @@ pfmView::pfmView (int *argc, char **argv, QWidget *parent):
       misc.cube_attr_available[pfm] = NVFalse;
       misc.last_saved_contour_record[pfm] = 0;
       misc.pfm_alpha[pfm] = 255;
+      misc.layer_minmax[pfm].list_path[0] = 0;
+      misc.layer_minmax[pfm].tile = NULL;
     }
 
 
@@ -2125,6 +2127,11 @@ pfmView::pfmView (int *argc, char **argv, QWidget *parent):
   misc.abe_share->pfm_count = 0;
 
 
+  //  pfmEdit3D's persistent point cache isn't created until the first 3D edit (see size_point_cache).
+
+  misc.cacheShare = NULL;
+
+
   //  Set a couple of things that pfmEdit(3D) will need to know.
 
   misc.abe_share->settings_changed = NVFalse;
@@ -3896,6 +3903,8 @@ pfmView::slotEditDone (int exitCode __attribute__ ((unused)), QProcess::ExitStat
 
   NV_F64_XYMBR mbr = misc.abe_share->edit_area;
 
+  if (pfmEditMod) invalidate_layer_min_max (&misc, -1, mbr);
+
   if (pfmEditMod == 1) remisp (&misc, &options, &mbr);
 
 
@@ -4465,6 +4474,11 @@ pfmView::editCommand (NV_FLOAT64 *mx, NV_FLOAT64 *my, NV_INT32 count)
         {
           threeD_edit = NVTrue;
 
+
+          //  Make sure pfmEdit3D's point cache can hold the edit area.
+
+          size_point_cache (&misc);
+
           editProc->start (QString (options.edit_name_3D), arguments);
         }
       else
@@ -6548,6 +6562,7 @@ pfmView::slotQuit ()
 
   //  Get rid of the shared memory.
 
+  if (misc.cacheShare) misc.cacheShare->detach ();
   misc.abeShare->detach ();
 
 
@@ -8443,6 +8458,17 @@ pfmView::slotEditFeatureDataChanged ()
 
       free (dep);
 
+
+      //  The bin record doesn't change so we have to tell pfmEdit3D's point cache that the point did.
+
+      NV_F64_XYMBR mbr;
+      mbr.min_x = misc.abe_share->open_args[0].head.mbr.min_x + misc.add_feature_coord.x * misc.abe_share->open_args[0].head.x_bin_size_degrees;
+      mbr.min_y = misc.abe_share->open_args[0].head.mbr.min_y + misc.add_feature_coord.y * misc.abe_share->open_args[0].head.y_bin_size_degrees;
+      mbr.max_x = mbr.min_x + misc.abe_share->open_args[0].head.x_bin_size_degrees;
+      mbr.max_y = mbr.min_y + misc.abe_share->open_args[0].head.y_bin_size_degrees;
+
+      invalidate_point_cache (&misc, 0, mbr);
+
       misc.add_feature_index = -1;
     }
 
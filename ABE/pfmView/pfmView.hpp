@@ -67,6 +67,9 @@ void loadArrays (NV_INT32 layer_type, NV_INT32 count, BIN_RECORD bin_record[], N
                  NV_INT32 highlight, NV_INT32 h_count, NV_INT32 pfm_handle, PFM_OPEN_ARGS open_args, NV_FLOAT32 percent, NV_BOOL surface_val);
 void compute_total_mbr (MISC *misc);
 void adjust_bounds (MISC *misc, NV_INT32 pfm);
+void invalidate_layer_min_max (MISC *misc, NV_INT32 pfm, NV_F64_XYMBR mbr);
+void size_point_cache (MISC *misc);
+void invalidate_point_cache (MISC *misc, NV_INT32 pfm, NV_F64_XYMBR mbr);
 NV_INT32 bfd_check_file (MISC *misc, NV_CHAR *path, BFDATA_HEADER *header, NV_INT32 mode);
 NV_BOOL checkFeature (MISC *misc, OPTIONS *options, NV_INT32 ftr, NV_BOOL *highlight, QString *feature_info);
 NV_BOOL readFeature (QWidget *parent, MISC *misc);
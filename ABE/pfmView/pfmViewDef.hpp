@@ -153,6 +153,8 @@ using namespace std;  // Windoze bullshit - God forbid they should follow a stan
 #define         MAX_RECENT                  10     //!<  Maximum number of files in the Open Recent... file list
 #define         PRE_ATTR                    6      //!<  Number of built in attributes for coloring prior to the PFM bin attributes
 #define         NUM_HSV                     NUM_ATTR + PRE_ATTR  //!<  Possible number of scale box HSV settings 
+#define         MINMAX_TILE_SIZE            64     //!<  Number of bins along each side of a layer min/max summary tile
+#define         MINMAX_THREAD_TILES         64     //!<  Minimum number of min/max summary tiles to build before we use threads
 
 
 //  Button hotkeys that are editable by the user.  These are used as indexes into the options.buttonAccel, misc.buttonText,
@@ -344,6 +346,41 @@ typedef struct
 } FILTER_MASK;
 
 
+//!  Minimum, maximum, and maximum standard deviation (with locations) for a tile of bins in a PFM layer.
+
+typedef struct
+{
+  NV_BOOL     built;                      //!<  Set to NVTrue if the summary is up to date
+  NV_INT32    count;                      //!<  Number of bins with valid data in the tile
+  NV_FLOAT32  min;                        //!<  Minimum value
+  NV_FLOAT32  max;                        //!<  Maximum value
+  NV_FLOAT32  std;                        //!<  Maximum standard deviation
+  NV_FLOAT32  attr_min;                   //!<  Minimum attribute value
+  NV_FLOAT32  attr_max;                   //!<  Maximum attribute value
+  NV_I32_COORD2 min_coord;                //!<  PFM coordinates of the minimum value
+  NV_I32_COORD2 max_coord;                //!<  PFM coordinates of the maximum value
+  NV_I32_COORD2 std_coord;                //!<  PFM coordinates of the maximum standard deviation
+} MINMAX_TILE;
+
+
+/*!  Tile summaries for one PFM layer.  These are kept by list file name (not layer number) so that moving layers
+     around doesn't throw them away.  Tile rows are only allocated when they are first used.  */
+
+typedef struct
+{
+  NV_CHAR     list_path[512];             //!<  PFM list file name (empty if this slot isn't used)
+  NV_INT32    layer_type;                 //!<  Layer type the summaries were built from
+  NV_INT32    attribute;                  //!<  Attribute the summaries were built from
+  NV_BOOL     surface_val;                //!<  Surface validity setting the summaries were built from
+  NV_INT32    tiles_wide;                 //!<  Number of tile columns
+  NV_INT32    tiles_high;                 //!<  Number of tile rows
+  MINMAX_TILE **tile;                     //!<  Tile rows (NULL if the row has not been used)
+  NV_U_INT32  bin_time;                   //!<  Modification time of the bin file when last checked
+  NV_INT64    bin_size;                   //!<  Size of the bin file when last checked
+  NV_BOOL     resync;                     //!<  Set when we've invalidated changed areas ourselves
+} LAYER_MINMAX;
+
+
 //!  General stuff (miscellaneous).
 
 typedef struct
@@ -420,6 +457,7 @@ typedef struct
   QColor      widgetBackgroundColor;      //!<  The normal widget background color.
   NV_INT32    feature_polygon_flag;
   QSharedMemory *abeShare;                //!<  ABE's shared memory pointer.
+  QSharedMemory *cacheShare;              //!<  pfmEdit3D's persistent point cache shared memory pointer (NULL until the first 3D edit).
   QSharedMemory *abeRegister;             //!<  ABE's process register
   ABE_SHARE   *abe_share;                 //!<  Pointer to the ABE_SHARE structure in shared memory.
   ABE_REGISTER *abe_register;             //!<  Pointer to the ABE_REGISTER structure in shared memory.
@@ -475,6 +513,7 @@ typedef struct
   NV_U_BYTE   pfm_alpha[MAX_ABE_PFMS];
   NV_INT32    last_saved_contour_record[MAX_ABE_PFMS]; //!<  Record number of the last record saved from the drawn contour file.
   NV_BOOL     contour_in_pfm[MAX_ABE_PFMS]; //!<  NVTrue if a drawn contour enters the PFM (temporary use)
+  LAYER_MINMAX layer_minmax[MAX_ABE_PFMS]; //!<  Tiled min/max summaries used by compute_layer_min_max
 } MISC;
 
 
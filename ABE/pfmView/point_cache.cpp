@@ -0,0 +1,247 @@
+
+/*********************************************************************************************
+
+    This is public domain software that was developed by the U.S. Naval Oceanographic Office.
+
+    This is a work of the US Government. In accordance with 17 USC 105, copyright protection
+    is not available for any work of the US Government.
+
+    Neither the United States Government nor any employees of the United States Government,
+    makes any warranty, express or implied, without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, or assumes any liability or
+    responsibility for the accuracy, completeness, or usefulness of any information,
+    apparatus, product, or process disclosed, or represents that its use would not infringe
+    privately-owned rights. Reference herein to any specific commercial products, process,
+    or service by trade name, trademark, manufacturer, or otherwise, does not necessarily
+    constitute or imply its endorsement, recommendation, or favoring by the United States
+    Government. The views and opinions of authors expressed herein do not necessarily state
+    or reflect those of the United States Government, and shall not be used for advertising
+    or product endorsement purposes.
+
+*********************************************************************************************/
+
+
+/****************************************  IMPORTANT NOTE  **********************************
+
+    Comments in this file that start with / * ! or / / ! are being used by Doxygen to
+    document the API.  Dashes in these comment blocks are used to create bullet lists.  The
+    lack of blank lines after a block of dash preceeded comments means that the next block
+    of dash preceeded comments is a new, indented bullet list.  I've tried to keep the
+    Doxygen formatting to a minimum but there are some other items (like <br> and <pre>)
+    that need to be left alone.  If you see a comment that starts with / * ! or / / ! and
+    there is something that looks a bit weird it is probably due to some arcane Doxygen
+    syntax.  Be very careful modifying blocks of Doxygen comments.
+
+*****************************************  IMPORTANT NOTE  **********************************/
+
+
+#include "pfmView.hpp"
+
+
+/*
+
+    These functions manage pfmView's side of pfmEdit3D's persistent point cache (see POINT_CACHE in ABE.h).  We own the
+    shared memory so that it survives from one edit session to the next but pfmEdit3D is the only program that adds
+    points to it.
+
+*/
+
+
+//  Convert an area to bin indices in PFM layer pfm (plus one all around to be safe).  Returns NVFalse if the area
+//  doesn't overlap the layer.
+
+static NV_BOOL area_bins (MISC *misc, NV_INT32 pfm, NV_F64_XYMBR mbr, NV_I32_COORD2 *ll, NV_I32_COORD2 *ur)
+{
+  PFM_OPEN_ARGS *open_args = &misc->abe_share->open_args[pfm];
+
+  ll->x = qMax ((NV_INT32) ((mbr.min_x - open_args->head.mbr.min_x) / open_args->head.x_bin_size_degrees) - 1, 0);
+  ur->x = qMin ((NV_INT32) ((mbr.max_x - open_args->head.mbr.min_x) / open_args->head.x_bin_size_degrees) + 1, open_args->head.bin_width - 1);
+  ll->y = qMax ((NV_INT32) ((mbr.min_y - open_args->head.mbr.min_y) / open_args->head.y_bin_size_degrees) - 1, 0);
+  ur->y = qMin ((NV_INT32) ((mbr.max_y - open_args->head.mbr.min_y) / open_args->head.y_bin_size_degrees) + 1, open_args->head.bin_height - 1);
+
+  return (ll->x <= ur->x && ll->y <= ur->y);
+}
+
+
+
+//  Round a shared memory offset up to the next 8 byte boundary.
+
+static NV_INT64 align_offset (NV_INT64 offset)
+{
+  return ((offset + 7) & ~((NV_INT64) 7));
+}
+
+
+
+/*!
+    Makes sure that the point cache is big enough to hold the points in the edit area (misc->abe_share->edit_area)
+    before we start pfmEdit3D.  The cache isn't created until the first 3D edit.  When it's too small we make a new
+    one twice the size of the edit area (so that it can hold the last area as well) up to POINT_CACHE_MAX_BINS and
+    POINT_CACHE_MAX_POINTS.  The cache is never made smaller.  If we can't get the shared memory pfmEdit3D will just
+    read everything from the PFM files.
+*/
+
+void size_point_cache (MISC *misc)
+{
+  //  Count the bins and (non-deleted and deleted) points in the edit area.
+
+  NV_INT64 need_bins = 0, need_points = 0;
+
+  for (NV_INT32 pfm = 0 ; pfm < misc->abe_share->pfm_count ; pfm++)
+    {
+      NV_I32_COORD2 ll, ur;
+
+      if (!misc->abe_share->display_pfm[pfm] || !area_bins (misc, pfm, misc->abe_share->edit_area, &ll, &ur)) continue;
+
+      NV_INT32 width = ur.x - ll.x + 1;
+
+      BIN_RECORD *row = (BIN_RECORD *) calloc (width, sizeof (BIN_RECORD));
+      if (row == NULL)
+        {
+          perror (pfmView::tr ("Allocating row in size_point_cache").toAscii ());
+          exit (-1);
+        }
+
+      for (NV_INT32 i = ll.y ; i <= ur.y ; i++)
+        {
+          read_bin_row (misc->pfm_handle[pfm], width, i, ll.x, row);
+
+          for (NV_INT32 j = 0 ; j < width ; j++)
+            {
+              if (row[j].num_soundings)
+                {
+                  need_bins++;
+                  need_points += row[j].num_soundings;
+                }
+            }
+        }
+
+      free (row);
+    }
+
+  if (!need_points) return;
+
+
+  NV_INT32 max_bins = (NV_INT32) qMin (need_bins * 2, (NV_INT64) POINT_CACHE_MAX_BINS);
+  NV_INT32 max_points = (NV_INT32) qMin (need_points * 2, (NV_INT64) POINT_CACHE_MAX_POINTS);
+
+
+  //  If the one we've got is big enough we're done.
+
+  if (misc->cacheShare != NULL)
+    {
+      POINT_CACHE *cache = (POINT_CACHE *) misc->cacheShare->data ();
+
+      if (cache->max_bins >= max_bins && cache->max_points >= max_points) return;
+
+      max_bins = qMax (max_bins, cache->max_bins);
+      max_points = qMax (max_points, cache->max_points);
+
+      misc->cacheShare->detach ();
+      delete misc->cacheShare;
+      misc->cacheShare = NULL;
+    }
+
+
+  //  Lay out the bins, hash table, and point columns following the header.
+
+  POINT_CACHE head;
+
+  memset (&head, 0, sizeof (POINT_CACHE));
+
+  head.max_bins = max_bins;
+  head.max_points = max_points;
+
+  head.hash_size = 1;
+  while (head.hash_size < max_bins * 2) head.hash_size <<= 1;
+
+  NV_INT64 size = align_offset (sizeof (POINT_CACHE));
+
+  head.bin_offset = size;
+  size = align_offset (size + (NV_INT64) max_bins * sizeof (POINT_CACHE_BIN));
+  head.hash_offset = size;
+  size = align_offset (size + (NV_INT64) head.hash_size * sizeof (NV_INT32));
+  head.dx_offset = size;
+  size = align_offset (size + (NV_INT64) max_points * sizeof (NV_FLOAT32));
+  head.dy_offset = size;
+  size = align_offset (size + (NV_INT64) max_points * sizeof (NV_FLOAT32));
+  head.z_offset = size;
+  size = align_offset (size + (NV_INT64) max_points * sizeof (NV_FLOAT64));
+  head.herr_offset = size;
+  size = align_offset (size + (NV_INT64) max_points * sizeof (NV_FLOAT32));
+  head.verr_offset = size;
+  size = align_offset (size + (NV_INT64) max_points * sizeof (NV_FLOAT32));
+  head.val_offset = size;
+  size = align_offset (size + (NV_INT64) max_points * sizeof (NV_U_INT32));
+  head.file_offset = size;
+  size = align_offset (size + (NV_INT64) max_points * sizeof (NV_INT16));
+  head.line_offset = size;
+  size = align_offset (size + (NV_INT64) max_points * sizeof (NV_INT32));
+  head.rec_offset = size;
+  size = align_offset (size + (NV_INT64) max_points * sizeof (NV_U_INT32));
+  head.sub_offset = size;
+  size = align_offset (size + (NV_INT64) max_points * sizeof (NV_INT32));
+  head.addr_offset = size;
+  size = align_offset (size + (NV_INT64) max_points * sizeof (NV_INT64));
+  head.pos_offset = size;
+  size = align_offset (size + (NV_INT64) max_points * sizeof (NV_U_BYTE));
+
+  for (NV_INT32 i = 0 ; i < NUM_ATTR ; i++)
+    {
+      head.attr_offset[i] = size;
+      size = align_offset (size + (NV_INT64) max_points * sizeof (NV_FLOAT32));
+    }
+
+
+  //  The key is the process ID plus "_abe_pfmCache".
+
+  QString skey;
+  skey.sprintf ("%d_abe_pfmCache", misc->process_id);
+
+  misc->cacheShare = new QSharedMemory (skey);
+
+  if (!misc->cacheShare->create ((NV_INT32) size, QSharedMemory::ReadWrite))
+    {
+      delete misc->cacheShare;
+      misc->cacheShare = NULL;
+      return;
+    }
+
+  POINT_CACHE *cache = (POINT_CACHE *) misc->cacheShare->data ();
+
+  *cache = head;
+
+  NV_INT32 *hash = POINT_CACHE_COLUMN (cache, NV_INT32, hash_offset);
+  for (NV_INT32 i = 0 ; i < cache->hash_size ; i++) hash[i] = -1;
+}
+
+
+
+/*!
+    Marks the bins in the point cache that overlap mbr as dropped for PFM layer pfm (or for all layers if pfm is -1).
+    This has to be called whenever we modify depth records since pfmEdit3D can't always tell from the bin record
+    that the points in a cached bin have changed.  The dropped bins stay in the hash chains (they just never match)
+    until pfmEdit3D needs the space.
+*/
+
+void invalidate_point_cache (MISC *misc, NV_INT32 pfm, NV_F64_XYMBR mbr)
+{
+  if (misc->cacheShare == NULL) return;
+
+  POINT_CACHE *cache = (POINT_CACHE *) misc->cacheShare->data ();
+  POINT_CACHE_BIN *bin = POINT_CACHE_COLUMN (cache, POINT_CACHE_BIN, bin_offset);
+
+  NV_BOOL overlap[MAX_ABE_PFMS];
+  NV_I32_COORD2 ll[MAX_ABE_PFMS], ur[MAX_ABE_PFMS];
+
+  for (NV_INT32 layer = 0 ; layer < misc->abe_share->pfm_count ; layer++)
+    overlap[layer] = (pfm < 0 || layer == pfm) && area_bins (misc, layer, mbr, &ll[layer], &ur[layer]);
+
+  for (NV_INT32 i = 0 ; i < cache->num_bins ; i++)
+    {
+      NV_INT32 layer = bin[i].pfm;
+
+      if (layer >= 0 && layer < misc->abe_share->pfm_count && overlap[layer] && bin[i].x >= ll[layer].x && bin[i].x <= ur[layer].x &&
+          bin[i].y >= ll[layer].y && bin[i].y <= ur[layer].y) bin[i].pfm = -1;
+    }
+}
@@ -65,6 +65,10 @@ remisp::remisp (MISC *mi, OPTIONS *op, NV_F64_XYMBR *m)
   gridThread         grid_thread;
 
 
+  void invalidate_layer_min_max (MISC *misc, NV_INT32 pfm, NV_F64_XYMBR mbr);
+  void invalidate_point_cache (MISC *misc, NV_INT32 pfm, NV_F64_XYMBR mbr);
+
+
   misc = mi;
   options = op;
   mbr = m;
@@ -500,6 +504,13 @@ remisp::remisp (MISC *mi, OPTIONS *op, NV_F64_XYMBR *m)
             }
 
           free (array);
+
+
+          //  Let compute_layer_min_max and pfmEdit3D's point cache know that we changed the interpolated surface (and
+          //  possibly hand-drawn contour points) in this area.
+
+          invalidate_layer_min_max (misc, pfm, grid_mbr[pfm]);
+          invalidate_point_cache (misc, pfm, grid_mbr[pfm]);
         }
     }
 
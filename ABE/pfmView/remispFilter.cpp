@@ -67,6 +67,8 @@ remispFilter::remispFilter (MISC *mi, OPTIONS *op, NV_FLOAT64 *x, NV_FLOAT64 *y,
   gridThread         grid_thread;
 
 
+  void invalidate_point_cache (MISC *misc, NV_INT32 pfm, NV_F64_XYMBR mbr);
+
 
   options = op;
   misc = mi;
@@ -516,6 +518,11 @@ remispFilter::remispFilter (MISC *mi, OPTIONS *op, NV_FLOAT64 *x, NV_FLOAT64 *y,
             }
 
           free (array);
+
+
+          //  Let pfmEdit3D's point cache know that we changed the points in this area.
+
+          invalidate_point_cache (misc, pfm, grid_mbr[pfm]);
 	}
     }
 
@@ -58,16 +58,10 @@ void scribe (nvMap *map, OPTIONS *options, MISC *misc, NV_INT32 pfm, NV_FLOAT32
   NV_FLOAT32              level, half_gridx, half_gridy, *contour_x, *contour_y, save_draw_contour_level = 0.0;
   QString                 label = "";
   NV_BOOL                 capture = NVFalse;
+  static TILE_CONTOUR     *tile_contour[MAX_ABE_PFMS];
 
 
 
-  void contourMinMax (NV_FLOAT32, NV_FLOAT32);
-  void contourEmphasis (NV_INT32);
-  void contourMaxDensity (NV_INT32);
-  void contourMaxPoints (NV_INT32);
-  void contourLevels (NV_INT32 numLevels, NV_FLOAT32 *);
-  NV_INT32 initContour (NV_FLOAT32, NV_INT32, NV_INT32, NV_FLOAT32 *);
-  NV_INT32 getContour (NV_FLOAT32 *, NV_INT32 *, NV_INT32 *, NV_FLOAT32 *, NV_FLOAT32 *);
   void smooth_contour (NV_INT32, NV_INT32 *, NV_FLOAT64 *, NV_FLOAT64 *);
   void writeContour (MISC *misc, NV_FLOAT32 z_factor, NV_FLOAT32 z_offset, NV_INT32 count, NV_FLOAT64 *cur_x,
                      NV_FLOAT64 *cur_y);
@@ -151,35 +145,27 @@ void scribe (nvMap *map, OPTIONS *options, MISC *misc, NV_INT32 pfm, NV_FLOAT32
   //  Set the min and max contours, the index contour interval, the maximum contour density, and the number of points to be returned
   //  by the package.
 
-  contourMinMax (misc->abe_share->open_args[pfm].head.min_depth * options->z_factor + options->z_offset, 
-                 misc->abe_share->open_args[pfm].head.max_depth * options->z_factor + options->z_offset);
-  contourMaxDensity (misc->maxd);
-  contourMaxPoints (CONTOUR_POINTS);
+  //  We keep a tiled contour context for each PFM layer.  The tiles are aligned to the PFM's bin rows and columns and
+  //  are cached so that when we pan, zoom, or redraw after an edit only the tiles whose bins (or contour settings)
+  //  changed get traced again.
+
+  if (tile_contour[pfm] == NULL) tile_contour[pfm] = createTileContour (0);
 
 
   //  If the contour interval is set to 0.0 use the user defined levels.
 
-  if (misc->abe_share->cint == 0.0) 
-    {
-      contourLevels (misc->abe_share->num_levels, misc->abe_share->contour_levels);
-      contourEmphasis (9999999);
-    }
-  else
-    {
-      if (options->contour_index)
-        {
-          contourEmphasis (options->contour_index);
-        }
-      else
-        {
-          contourEmphasis (9999999);
-        }
-    }
+  NV_INT32 emphasis = 9999999;
+  if (misc->abe_share->cint != 0.0 && options->contour_index) emphasis = options->contour_index;
+
+  tileContourParameters (tile_contour[pfm], misc->abe_share->open_args[pfm].head.min_depth * options->z_factor + options->z_offset, 
+                         misc->abe_share->open_args[pfm].head.max_depth * options->z_factor + options->z_offset, emphasis,
+                         misc->maxd, CONTOUR_POINTS, misc->abe_share->num_levels, misc->abe_share->contour_levels);
 
 
-  //  Pass the grid array (arranged 1D) to the contouring package.
+  //  Pass the grid array (arranged 1D) to the contouring package along with the PFM row and column of the first grid point.
 
-  initContour (misc->abe_share->cint, nrr, ncc, ar);
+  initTileContour (tile_contour[pfm], misc->abe_share->cint, nrr, ncc, ar, misc->displayed_area_row[pfm] + misc->hatchr_start_y,
+                   misc->displayed_area_column[pfm]);
 
 
   //  Compute half of a grid cell in degrees.
@@ -190,7 +176,7 @@ void scribe (nvMap *map, OPTIONS *options, MISC *misc, NV_INT32 pfm, NV_FLOAT32
 
   //  Get the contours from the package until all are drawn.
 
-  while (getContour (&level, &index_contour, &num_points, contour_x, contour_y))
+  while (getTileContour (tile_contour[pfm], &level, &index_contour, &num_points, contour_x, contour_y))
     {
       //  Convert from grid points (returned contours) to position.
 
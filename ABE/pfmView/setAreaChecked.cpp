@@ -151,6 +151,18 @@ void setAreaChecked (MISC *misc, NV_INT32 type, NV_BOOL area)
                   write_bin_record_validity_index (misc->pfm_handle[pfm], &bin_record, mask);
                 }
             }
+
+
+          //  The CHECKED and VERIFIED flags don't change the min/max values but we've changed the bin file so we need to
+          //  let compute_layer_min_max know where.
+
+          NV_F64_XYMBR mbr;
+          mbr.min_x = misc->abe_share->open_args[pfm].head.mbr.min_x + column * misc->abe_share->open_args[pfm].head.x_bin_size_degrees;
+          mbr.min_y = misc->abe_share->open_args[pfm].head.mbr.min_y + row * misc->abe_share->open_args[pfm].head.y_bin_size_degrees;
+          mbr.max_x = mbr.min_x + width * misc->abe_share->open_args[pfm].head.x_bin_size_degrees;
+          mbr.max_y = mbr.min_y + height * misc->abe_share->open_args[pfm].head.y_bin_size_degrees;
+
+          invalidate_layer_min_max (misc, pfm, mbr);
         }
     }
 
@@ -43,9 +43,9 @@
 #ifndef VERSION
 
 #ifdef OPTECH_CZMIL
-#define     VERSION     "CME Software - Surface Viewer V8.69 - 11/18/11"
+#define     VERSION     "CME Software - Surface Viewer V8.73 - 10/19/26"
 #else
-#define     VERSION     "PFM Software - pfmView V8.69 - 11/18/11"
+#define     VERSION     "PFM Software - pfmView V8.73 - 10/19/26"
 #endif
 
 #endif
@@ -1820,4 +1820,36 @@
 
     Removed support for the GMT surface since no one was using (or wanted) it.
 
+
+    Version 8.70
+    Jan C. Depner
+    10/19/26
+
+    Uses the per bin statistics file (if present) for the multiple line, count, IHO, and percent
+    highlight options instead of reading every sounding in every displayed bin.
+
+
+    Version 8.71
+    Jan C. Depner
+    10/19/26
+
+    Create the persistent point cache shared memory used by pfmEdit3D.
+
+
+    Version 8.72
+    Jan C. Depner
+    10/19/26
+
+    Contours are now traced in parallel by tiles using the tiled contouring in nvutility.  Traced tiles are
+    cached for each PFM layer so panning, zooming, and redrawing after edits only traces the tiles that changed.
+
+
+    Version 8.73
+    Jan C. Depner
+    10/19/26
+
+    Keep tiled min/max summaries for each layer so that compute_layer_min_max only reads the partial
+    tiles around the edges of the displayed area and any tiles that have been changed.  Missing tiles are
+    built in parallel using extra PFM handles.
+
 </pre>*/
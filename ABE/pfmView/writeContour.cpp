@@ -363,6 +363,18 @@ void writeContour (MISC *misc, NV_FLOAT32 z_factor, NV_FLOAT32 z_offset, NV_INT3
 		  recompute_bin_values_index (misc->pfm_handle[pfm], coord, &bin_record, 0);
 		}
 	    }
+
+
+          //  Let compute_layer_min_max and pfmEdit3D's point cache know which bins we changed.
+
+          NV_F64_XYMBR mbr;
+          mbr.min_x = misc->abe_share->open_args[pfm].head.mbr.min_x + min_coord.x * misc->abe_share->open_args[pfm].head.x_bin_size_degrees;
+          mbr.min_y = misc->abe_share->open_args[pfm].head.mbr.min_y + min_coord.y * misc->abe_share->open_args[pfm].head.y_bin_size_degrees;
+          mbr.max_x = misc->abe_share->open_args[pfm].head.mbr.min_x + (max_coord.x + 1) * misc->abe_share->open_args[pfm].head.x_bin_size_degrees;
+          mbr.max_y = misc->abe_share->open_args[pfm].head.mbr.min_y + (max_coord.y + 1) * misc->abe_share->open_args[pfm].head.y_bin_size_degrees;
+
+          invalidate_layer_min_max (misc, pfm, mbr);
+          invalidate_point_cache (misc, pfm, mbr);
 	}
     }
 }
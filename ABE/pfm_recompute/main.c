@@ -138,6 +138,12 @@ NV_INT32 main (NV_INT32 argc, char **argv)
     if (pfm_handle < 0) pfm_error_exit (pfm_error);
 
 
+    /*  Create (or open) the bin statistics file.  Since we're recomputing every
+        bin this will leave a complete set of statistics records.  */
+
+    open_bin_stats (pfm_handle, NVTrue);
+
+
     total = open_args.head.bin_height;
 
     fprintf (stderr, "File : %s\n\n", open_args.list_path);
@@ -15,7 +15,7 @@
 
 #ifndef VERSION
 
-#define     VERSION     "PFM Software - pfm_recompute V1.77 - 05/06/11"
+#define     VERSION     "PFM Software - pfm_recompute V1.78 - 10/19/26"
 
 #endif
 
@@ -124,4 +124,11 @@
 
     Fixed problem with getopt that only happens on Windows.
 
+
+    Version 1.78
+    Jan C. Depner
+    10/19/26
+
+    Creates the PFM bin statistics file prior to recomputing the bins.
+
 */
@@ -29,15 +29,24 @@
 
 using namespace std;
 
-process_env pe;                 // Object for managing process requests/messages
+process_env pe;                 // Object for managing the threads, tasks and events
+
+//
+//  Task queues and events used with pe.
+//
+enum { IMAGE_TASK, MAP_TASK, WRITE_TASK, NUM_TASKS };
+enum { IMAGE_EVENT,             // An rgb image has been read
+       READY_EVENT,             // The memory for an rgb image is free to read into
+       MAPPED_EVENT,            // A block and all blocks before it have been mapped
+       NUM_EVENTS };
 
 image<double> inverse_scale;
 image<double> east_trans;
 image<double> north_trans;
 
-int readers;                    // Number of reader processes to fork
-int mappers;                    // Number of mapper processes to fork
-int writers;                    // Number of writer processes (1 is probably the limit)
+int readers;                    // Number of reader threads
+int mappers;                    // Number of mapper threads (0 for one per processor)
+int writers;                    // Number of writer threads (only 1 is used since GDAL writes one block at a time)
 
 //
 //  The tiled mosaic program will divide the output tif file into a collection
@@ -215,15 +224,56 @@ void compute_geographic_cellsize()
 }
 
 image<float> dem;
-rgb_image *out;
-image<float> *dist;
-image<short> *img;
+image<float> *dist;             // Scratch Voronoi distance image for each mapper
+image<short> *img;              // Scratch Voronoi image for each mapper
 image<float> distx;
 image<short> imgx;
 tile *tiles;
 double camera_roll, camera_pitch, camera_yaw;
 mat4 cam;
 
+//
+//  Mapped blocks are held in a pool of output buffers until the writer has
+//  written them.  The pool holds two buffers per mapper so that the mappers
+//  can keep going while the writer catches up, and a mapper waits for a free
+//  buffer when the writer falls behind.  The block mutex also protects the
+//  count of blocks that have been mapped in order (mapped_through) which is
+//  used to decide when the memory for an rgb image can be re-used.
+//
+rgb_image *out;                 // Output block buffers
+int n_out;                      // Number of output block buffers
+vector<int> free_out;           // Output buffers that aren't in use
+int *out_slot;                  // Output buffer holding each mapped block
+char *mapped;                   // Whether each block has been mapped
+int mapped_through;             // All blocks before this one have been mapped
+int next_mapper;                // Used to give each mapper its scratch images
+pthread_mutex_t block_mutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t block_free = PTHREAD_COND_INITIALIZER;
+
+//
+//  Get an output buffer to map a block into, waiting for the writer to free
+//  one if they are all in use.
+//
+int get_out_buffer()
+{
+    int o;
+
+    pthread_mutex_lock ( &block_mutex );
+    while ( free_out.size() == 0 ) pthread_cond_wait ( &block_free, &block_mutex );
+    o = free_out.back();
+    free_out.pop_back();
+    pthread_mutex_unlock ( &block_mutex );
+    return o;
+}
+
+void release_out_buffer ( int o )
+{
+    pthread_mutex_lock ( &block_mutex );
+    free_out.push_back(o);
+    pthread_mutex_unlock ( &block_mutex );
+    pthread_cond_signal ( &block_free );
+}
+
 //
 //  Function to compute the first row number for a tile (block)
 //
@@ -285,7 +335,7 @@ void set_defaults()
     p.set("pixel_size",       "7.4" );
     p.set("readers",          "2" );
     p.set("writers",          "1" );
-    p.set("mappers",          "2" );
+    p.set("mappers",          "0" );
     p.set("block_x",          "512" );
     p.set("block_y",          "512" );
     p.set("slack",            "20" );
@@ -674,7 +724,7 @@ void output_dist_geotiff ( image<float> & dist, image<unsigned char> & v )
 
 void output_geotiff()
 {
-    int t, k, i;
+    int t, k, i, n;
     int val;
     OGRSpatialReference ref;
     GDALDataset  *df;
@@ -689,7 +739,6 @@ void output_geotiff()
     int          bands[] = { 1, 2, 3 };
     char         file[1000];
     char         s[10];
-    set<short>::iterator it;
 
     options = CSLSetNameValue ( options, "TILED", "YES" );
     sprintf(s,"%d",block_x);
@@ -740,11 +789,15 @@ void output_geotiff()
         CPLFree ( wkt );
     }
 
-    for ( t = 0; t < n_blocks; t++ ) {
-        k = t % mappers;
+    //
+    //  Write the blocks in the order the mappers finish them.  Tiled GeoTIFF
+    //  blocks can be written in any order.
+    //
+    for ( n = 0; n < n_blocks; n++ ) {
+        if ( (t = pe.wait_task(WRITE_TASK)) < 0 ) break;
+        k = out_slot[t];
         trows = tiles[t].rows;
         tcols = tiles[t].cols;
-        pe.wait_for("data",t);
         for ( i = 0; i < 3; i++ ) {
             bd = df->GetRasterBand(i+1);
             //bd->RasterIO( GF_Write, tiles[t].first_col, tiles[t].first_row,
@@ -760,18 +813,9 @@ void output_geotiff()
                              tiles[t].first_row/block_y,
                              out[k].img[3].data );
         }
-        it = tiles[t].imgs_to_free.begin();
-        while ( it != tiles[t].imgs_to_free.end() ) {
-            i = *it;
-            if ( img_replacement[i] > 0 ) {
-                pe.report_complete ( "ready", img_replacement[i] );
-            }
-            it++;
-        }
+        release_out_buffer ( k );
 
-        pe.report_complete ( "writer", t );
-
-        printf ("Writer status - %d of %d blocks completed                 \r", t, n_blocks);
+        printf ("Writer status - %d of %d blocks completed                 \r", n + 1, n_blocks);
         fflush (stdout);
     }
 
@@ -1027,10 +1071,10 @@ void compute_lens_inverse()
     }
 }
 
-void map_block ( int t )
+void map_block ( int t, int k, int o )
 {
     int current = -1;
-    int j, k, r, c, dr, dc, jr, jc;
+    int j, r, c, dr, dc, jr, jc;
     rgb_image rgb;
     double max_north, north, min_east, east, n1, n2, e1, e2;
     double dt, db, dx, dy, ddx, ddy, elev;
@@ -1041,8 +1085,6 @@ void map_block ( int t )
     int i;
     int block = -1;
 
-    k = t % mappers;
-
     row1 = tiles[t].first_row;
     row2 = row1 + block_y;
     if ( row2 > rows ) row2 = rows;
@@ -1088,10 +1130,10 @@ void map_block ( int t )
             if ( dr < 0 ) dr = 0;
             if ( dr >= dem.rows ) dr = dem.rows-1;
             if ( img[k][r-row1+1][c-col1+1] < 1 ) {
-                out[k].img[0][r-row1][c-col1] = 0;
-                out[k].img[1][r-row1][c-col1] = 0;
-                out[k].img[2][r-row1][c-col1] = 0;
-                if ( alpha ) out[k].img[3][r-row1][c-col1] = 0;
+                out[o].img[0][r-row1][c-col1] = 0;
+                out[o].img[1][r-row1][c-col1] = 0;
+                out[o].img[2][r-row1][c-col1] = 0;
+                if ( alpha ) out[o].img[3][r-row1][c-col1] = 0;
                 continue;
             }
             if ( img[k][r-row1+1][c-col1+1] != current ) {
@@ -1099,7 +1141,7 @@ void map_block ( int t )
                 //printf("%d %d switching to %d \n", r, c, current );
                 rgb = imgs[current];
                 if ( !valid_img[current] ) {
-                    pe.wait_for ( "image", current );
+                    pe.wait_for ( IMAGE_EVENT, current );
                     valid_img[current] = 1;
                 }
             }
@@ -1178,9 +1220,9 @@ void map_block ( int t )
             if ( jr >= 0 && jr < rgb.rows && jc >= 0 && jc < rgb.cols){
                 if ( jr == 0 || jc == 0 ||
                         jr == rgb.rows - 1 || jc == rgb.cols - 1 ) {
-                    out[k].img[0][r-row1][c-col1] = rgb.img[0][jr][jc];
-                    out[k].img[1][r-row1][c-col1] = rgb.img[1][jr][jc];
-                    out[k].img[2][r-row1][c-col1] = rgb.img[2][jr][jc];
+                    out[o].img[0][r-row1][c-col1] = rgb.img[0][jr][jc];
+                    out[o].img[1][r-row1][c-col1] = rgb.img[1][jr][jc];
+                    out[o].img[2][r-row1][c-col1] = rgb.img[2][jr][jc];
                 } else {
                     diy = iy - jr;
                     dix = ix - jc;
@@ -1189,18 +1231,18 @@ void map_block ( int t )
                             dix * rgb.img[j][jr][jc+1];
                         ib = (1.0-dix)*rgb.img[j][jr+1][jc] +
                             dix * rgb.img[j][jr+1][jc+1];
-                        out[k].img[j][r-row1][c-col1] = int((1.0-diy)*it +
+                        out[o].img[j][r-row1][c-col1] = int((1.0-diy)*it +
                                 diy*ib + 0.5);
                     }
                 }
-                if ( alpha ) out[k].img[3][r-row1][c-col1] = current&0xff;
-                //out[k].img[1][r-row1][c-col1] = iy/8;
-                //out[k].img[2][r-row1][c-col1] = ix/8;
+                if ( alpha ) out[o].img[3][r-row1][c-col1] = current&0xff;
+                //out[o].img[1][r-row1][c-col1] = iy/8;
+                //out[o].img[2][r-row1][c-col1] = ix/8;
             } else {
-                out[k].img[0][r-row1][c-col1] = 0;
-                out[k].img[1][r-row1][c-col1] = 0;
-                out[k].img[2][r-row1][c-col1] = 0;
-                if ( alpha ) out[k].img[3][r-row1][c-col1] = 0;
+                out[o].img[0][r-row1][c-col1] = 0;
+                out[o].img[1][r-row1][c-col1] = 0;
+                out[o].img[2][r-row1][c-col1] = 0;
+                if ( alpha ) out[o].img[3][r-row1][c-col1] = 0;
             }
         }
     }
@@ -1210,41 +1252,71 @@ void map_block ( int t )
     rgb.img[2].data = 0;
 }
 
-void dem_reader()
+void reader()
 {
-    read_dem(dem);
-    pe.report_complete ( "dem", 0 );
+    int i;
+    while ( (i = pe.get_task(IMAGE_TASK)) >= 0 ) {
+        if ( !pe.wait_for ( READY_EVENT, i ) ) break;
+        imgs[i].read_image();
+        pe.report_complete ( IMAGE_EVENT, i );
+    }
 }
 
-void reader()
+//
+//  Record that block t has been mapped into output buffer o and hand it to
+//  the writer.  Once all of the blocks through the last one needing an rgb
+//  image have been mapped, the memory for that image can be used to read
+//  its replacement.
+//
+void block_mapped ( int t, int o )
 {
     int i;
-    //printf("Reader process %d, %d\n", getpid(), pe.mypid );
-    //nice(2);
-    while ( (i = pe.get_task("image")) >= 0 ) {
-        pe.wait_for ( "ready", i );
-        imgs[i].read_image();
-        pe.report_complete ( "image", i );
-        //printf("Reader process %d, completed %d\n", getpid(), i );
+    set<short>::iterator it;
+
+    pthread_mutex_lock ( &block_mutex );
+    out_slot[t] = o;
+    mapped[t] = 1;
+    while ( mapped_through < n_blocks && mapped[mapped_through] ) {
+        it = tiles[mapped_through].imgs_to_free.begin();
+        while ( it != tiles[mapped_through].imgs_to_free.end() ) {
+            i = *it;
+            if ( img_replacement[i] > 0 ) {
+                pe.report_complete ( READY_EVENT, img_replacement[i] );
+            }
+            it++;
+        }
+        pe.report_complete ( MAPPED_EVENT, mapped_through );
+        mapped_through++;
     }
+    pthread_mutex_unlock ( &block_mutex );
+
+    pe.add_task ( WRITE_TASK, t );
 }
 
+//
+//  Mappers take the next block from the queue whenever they are free.  A
+//  mapper doesn't start a block until the block mappers before it has been
+//  mapped (along with everything ahead of that) so the rgb images in use
+//  always fit in the max_rgb_images computed in main.
+//
 void mapper()
 {
-    int t;
-    //printf("Mapper process %d, %d\n", getpid(), pe.mq );
-    //nice(4);
-    //pe.wait_for ( "dem", 0 );
-    while ( (t = pe.get_task("mapper")) >= 0 ) {
-        map_block ( t );
-        pe.report_complete ( "data", t );
-        pe.wait_for ( "writer", t );
+    int t, k, o;
+
+    pthread_mutex_lock ( &block_mutex );
+    k = next_mapper++;
+    pthread_mutex_unlock ( &block_mutex );
+
+    while ( (t = pe.get_task(MAP_TASK)) >= 0 ) {
+        if ( t >= mappers && !pe.wait_for ( MAPPED_EVENT, t - mappers ) ) break;
+        o = get_out_buffer();
+        map_block ( t, k, o );
+        block_mapped ( t, o );
     }
 }
 
 void writer()
 {
-    //printf("Writer process %d, %d\n", getpid(), pe.mq );
     output_geotiff();
 }
 
@@ -1255,12 +1327,9 @@ bool comp_row ( const int a, const int b )
 
 int main ( int argc, char **argv )
 {
-    int i, j, k, pk, n, pid, t, r, c, rowsx, colsx, rowst, colst;
+    int i, j, k, pk, n, t, r, c, rowsx, colsx, rowst, colst;
     int shrink;
     double pix;
-    int req, task, value;
-    char task_name[16];
-    char s[80];
 
     //log_start();
 
@@ -1293,7 +1362,11 @@ int main ( int argc, char **argv )
     max_dist_2 = max_dist * max_dist;
     readers = p.ivalue("readers");
     mappers = p.ivalue("mappers");
-    writers = p.ivalue("writers");
+    if ( mappers < 1 ) mappers = sysconf ( _SC_NPROCESSORS_ONLN );
+    if ( readers < 1 ) readers = 1;
+    if ( mappers < 1 ) mappers = 1;
+    if ( readers + mappers + 1 > MAX_PROCS ) mappers = MAX_PROCS - readers - 1;
+    writers = 1;
     slack = p.ivalue("slack");
 
 //
@@ -1369,6 +1442,8 @@ int main ( int argc, char **argv )
     compute_lens_inverse();
     read_image_file();
 
+    pe.init ( NUM_TASKS, NUM_EVENTS, num_imgs+1 > n_blocks ? num_imgs+1 : n_blocks );
+
     //fill ( img, dist, 0, rows );
     //spread_dist ( img, dist );
     //if ( p.value("dist_file") != "" ) output_dist_geotiff ( dist, v );
@@ -1443,7 +1518,7 @@ int main ( int argc, char **argv )
                     first_needed[j] = t;
                     last_needed[j] = t;
                     tiles[t].imgs_needed.insert(j);
-                    pe.add_task ( "image", j );
+                    pe.add_task ( IMAGE_TASK, j );
                     img_order[k++] = j;
                 }
                 if ( last_needed[j] < t ) {
@@ -1494,8 +1569,10 @@ int main ( int argc, char **argv )
 
     for ( i = 0; i < max_rgb_images; i++ ) {
         k = img_order[i];
-        pe.complete ( "ready", k );
-        if ( k > 0 ) imgs[k].create_image(input_rows,input_cols);
+        if ( k > 0 ) {
+            pe.complete ( READY_EVENT, k );
+            imgs[k].create_image(input_rows,input_cols);
+        }
     }
     k = 0;
     for ( t = 0; t < n_blocks; t++ ) {
@@ -1524,70 +1601,36 @@ int main ( int argc, char **argv )
         pe.launch ( reader );
     }
 
+    printf("%d readers, %d mappers\n", readers, mappers );
+
     dist = new image<float>[mappers];
     img = new image<short>[mappers];
-    out = new rgb_image[mappers];
     for ( i = 0; i < mappers; i++ ) {
         dist[i].create(block_y+2,block_x+2);
         img[i].create(block_y+2,block_x+2);
+    }
+
+    n_out = 2 * mappers;
+    if ( n_out > n_blocks ) n_out = n_blocks;
+    out = new rgb_image[n_out];
+    for ( i = 0; i < n_out; i++ ) {
         out[i].create_image(block_y,block_x);
+        free_out.push_back(i);
     }
+    out_slot = new int[n_blocks]();
+    mapped = new char[n_blocks]();
+    mapped_through = 0;
+    next_mapper = 0;
 
-    for ( i = 0; i < n_blocks; i++ ) pe.add_task ( "mapper", i );
+    for ( i = 0; i < n_blocks; i++ ) pe.add_task ( MAP_TASK, i );
+    pe.close_tasks ( MAP_TASK );
 
     for ( i = 0; i < mappers; i++ ) {
         pe.launch ( mapper );
     }
-    for ( i = 0; i < writers; i++ ) {
-        pe.launch ( writer );
-    }
+    pe.launch ( writer );
 
-    while ( pe.children > 0 ) {
-        t = pe.receive ( s, 1 );
-        if ( t < 0 ) perror("master receive");
-        sscanf(s,"%d %d %s %d", &req, &pid, task_name, &value );
-        switch ( req ) {
-            case SHUTDOWN:
-                pe.must_quit = 1;
-                pe.children--;
-                pe.shutdown();
-                break;
-            case EXIT:
-                fprintf (stderr, "Completed process %d\n", pid);
-                //log("exit %d",pid);
-                pe.children--;
-                break;
-            case WAIT:
-                if ( pe.must_quit ) {
-                    t = pe.send ( "-1", pid );
-                    break;
-                }
-                if ( pe.ready(task_name,value) ) {
-                    //printf("Sending %d task %d\n",pid,task);
-                    //log("wait %d %s %d",pid,task_name,value);
-                    t = pe.send ( "1", pid );
-                } else {
-                    //log("sleep %d %s %d",pid,task_name,value);
-                    pe.enqueue ( task_name, value, pid );
-                }
-                break;
-            case TASK:
-                if ( pe.must_quit ) {
-                    t = pe.send ( "-1", pid );
-                    break;
-                }
-                task = pe.fetch_task(task_name);
-                //log("task %d %s %d",pid,task_name,task);
-                sprintf(s,"%d",task);
-                //printf("Sending %d task %d\n",pid,task);
-                t = pe.send ( s, pid );
-                break;
-            case REPORT:
-                //log("complete %d %s %d",pid,task_name,value);
-                pe.complete ( task_name, value );
-                break;
-        }
-    }
+    pe.run();
 
     //dump_log();
     return 0;
@@ -1,28 +1,32 @@
 #include <cstdio>
+#include <unistd.h>
 #include "process_mgr.h"
 
+enum { START, APPEND };     // Task queues
+enum { WORK, APPENDED };    // Events
+
 process_env pe;
 
 void start()
 {
     int task;
-    printf("Start process %d\n", getpid() );
-    while ( (task = pe.get_task("start")) >= 0 ) {
+    printf("Start thread %lu\n", (unsigned long)pthread_self() );
+    while ( (task = pe.get_task(START)) >= 0 ) {
         usleep(rand()%1000);
-        pe.report_complete ( "work", task );
-        printf("Process %d, completed %d\n", getpid(), task );
+        pe.report_complete ( WORK, task );
+        printf("Thread %lu, completed %d\n", (unsigned long)pthread_self(), task );
     }
 }
 
 void append()
 {
     int task;
-    printf("Append process %d\n", getpid() );
-    while ( (task = pe.get_task("append")) >= 0 ) {
-        pe.wait_for("work",task);
+    printf("Append thread %lu\n", (unsigned long)pthread_self() );
+    while ( (task = pe.get_task(APPEND)) >= 0 ) {
+        pe.wait_for(WORK,task);
         usleep(rand()%1000);
-        pe.report_complete ( "append", task );
-        printf("Process %d, appended %d\n", getpid(), task );
+        pe.report_complete ( APPENDED, task );
+        printf("Thread %lu, appended %d\n", (unsigned long)pthread_self(), task );
     }
 }
 
@@ -33,9 +37,11 @@ int main ( int argc, char **argv )
     nkids = argc > 1 ? atoi(argv[1]) : 2;
     msgs = argc > 2 ? atoi(argv[2]) : 5;
 
+    pe.init ( 2, 2, nkids*msgs );
+
     for ( i = 0; i < nkids*msgs; i++ ) {
-        pe.add_task("start",i);
-        pe.add_task("append",i);
+        pe.add_task(START,i);
+        pe.add_task(APPEND,i);
     }
 
     for ( i = 0; i < nkids; i++ ) {
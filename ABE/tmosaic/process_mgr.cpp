@@ -12,7 +12,6 @@ int log_ct;
 int start_time;
 timeval now;
 
-process_env *process_event::ppe;
 void log_start()
 {
     gettimeofday ( &now, NULL );
@@ -36,330 +35,164 @@ void dump_log()
     for ( i = 0; i < log_ct; i++ ) printf("%s\n",log_data[i]);
 }
 
-int process_env::pipe_read ( int fd, char *s, int size)
-{
-    int n = 0, left;
-
-    left = size;
-    while ( left > 0 ) {
-       n = read ( fd, s, left );
-       if ( n < 0 ) return n;
-       s += n;
-       left -= n;
-    }
-    return size;
-}
-
-int process_env::pipe_write ( int fd, char *s, int size)
-{
-    int n = 0, left;
-
-    left = size;
-    while ( left > 0 ) {
-       n = write ( fd, s, left );
-       if ( n < 0 ) return n;
-       s += n;
-       left -= n;
-    }
-    return size;
-}
-
-void process_event::wakeup()
-{
-    int t;
-    while ( waiting.size() > 0 ) {
-        t = waiting.front();
-        waiting.pop_front();
-        log ("wakeup %d",t);
-        t = ppe->send ( "1", t );
-        if ( t < 0 ) perror("wakeup send");
-    }
-}
-
-string process_env::event_key ( string event_name, int value )
-{
-    char s[80];
-    string ek;
-
-    sprintf(s,"%s-%d", event_name.c_str(), value );
-    ek = s;
-    return ek;
-}
-
-int process_env::receive ( char *s, int pid )
-{
-    int t, child;
-
-    //printf("Process %d receiving pid %d\n", mypid, pid );
-    if ( mypid >= 0 ) {
-        t = pipe_read ( pipe_in, s, MSG_SIZE );
-    } else {
-        t = read ( master_pipe[0], s, 1 );
-        if ( t != 1 ) {
-            perror("master pipe read");
-            exit(1);
-        }
-        child = s[0];
-        t = pipe_read ( to_parent[child][0], s, MSG_SIZE );
-    }
-        
-    return t;
-}
-
-int process_env::send ( char *s, int pid )
+//
+//  Set up the task queues and event flags.  Events can have values from
+//  0 to num_values-1.
+//
+void process_env::init ( int num_tasks, int num_events, int num_values )
 {
-    int t;
-    char msg[MSG_SIZE];
+    int i;
 
-    //printf("Sending %s to %d\n", s, pid );
-    if ( mypid >= 0 ) {
-        msg[0] = mypid;
-        write ( master_pipe[1], msg, 1 );
-    } else {
-        pipe_out = to_child[pid][1];
-    }
-    strcpy ( msg, s );
-    t = pipe_write ( pipe_out, msg, MSG_SIZE );
-    //printf("Sent %s to %d\n", s, pid );
-    return t;
+    tasks.resize(num_tasks);
+    closed.assign(num_tasks,0);
+    events.resize(num_events);
+    for ( i = 0; i < num_events; i++ ) events[i].assign(num_values,0);
 }
 
 //
-//  Used by the master to add a task to a task queue
+//  Add a task to a task queue
 //
-void process_env::add_task ( string task_name, int value )
+void process_env::add_task ( int task, int value )
 {
-    process_event *p;
-    p = new process_event();
-    p->name = task_name;
-    p->value = value;
-    task_map[task_name].push_back(p);
+    pthread_mutex_lock ( &mutex );
+    tasks[task].push_back(value);
+    pthread_mutex_unlock ( &mutex );
+    pthread_cond_broadcast ( &changed );
 }
 
 //
-//  Used by the master to fetch a task from a task queue
+//  Mark a task queue as finished so that wait_task returns -1 once it is
+//  empty.
 //
-int process_env::fetch_task ( string task_name )
+void process_env::close_tasks ( int task )
 {
-    process_event *p;
-    int value;
-    if ( task_map[task_name].size() < 1 ) return -1;
-    p = task_map[task_name].front();
-    task_map[task_name].pop_front();
-    value = p->value;
-    delete p;
-    return value;
+    pthread_mutex_lock ( &mutex );
+    closed[task] = 1;
+    pthread_mutex_unlock ( &mutex );
+    pthread_cond_broadcast ( &changed );
 }
 
 //
-//  Used by the master to add a process to an event queue
+//  Used by a worker to get a task to work on.  The reply is the task value
+//  or -1 if there is no more work to do.
 //
-void process_env::enqueue ( string event_name, int value, int pid )
+int process_env::get_task ( int task )
 {
-    process_event *p;
-    string k;
-    k = event_key(event_name,value);
-    if ( sb.count(k) == 0 ) {
-        p = new process_event();
-        p->name = event_name;
-        p->value = value;
-        p->ready = false;
-        sb[k] = p;
+    int value = -1;
+
+    pthread_mutex_lock ( &mutex );
+    if ( !must_quit && tasks[task].size() > 0 ) {
+        value = tasks[task].front();
+        tasks[task].pop_front();
     }
-    p = sb[k];
-    p->waiting.push_back(pid);
+    pthread_mutex_unlock ( &mutex );
+    return value;
 }
 
 //
-//  Used by the master to record the completion of an event and to
-//  wake the processes on the event queue.
+//  Like get_task but waits for a task to be added if the queue is empty
+//  and hasn't been closed.
 //
-void process_env::complete ( string event_name, int value )
+int process_env::wait_task ( int task )
 {
-    process_event *p;
-    string k;
-    k = event_key(event_name,value);
-    if ( sb.count(k) == 0 ) {
-        p = new process_event();
-        p->name = event_name;
-        p->value = value;
-        p->ready = true;
-        sb[k] = p;
-    } else {
-        p = sb[k];
-        p->ready = true;
-        p->wakeup();
+    int value = -1;
+
+    pthread_mutex_lock ( &mutex );
+    while ( !must_quit && tasks[task].size() == 0 && !closed[task] ) {
+        pthread_cond_wait ( &changed, &mutex );
     }
+    if ( !must_quit && tasks[task].size() > 0 ) {
+        value = tasks[task].front();
+        tasks[task].pop_front();
+    }
+    pthread_mutex_unlock ( &mutex );
+    return value;
 }
 
 //
-//  Used by the master to check the status of an event
+//  Record the completion of an event and wake the threads waiting for it.
 //
-bool process_env::ready ( string event_name, int value )
-{
-    string k;
-    k = event_key(event_name,value);
-    if ( sb.count(k) == 0 ) return false;
-    return sb[k]->ready;
-}
-
-void process_env::send_exit()
+void process_env::complete ( int event, int value )
 {
-    int t;
-    char s[80];
-    sprintf(s,"%d %d", EXIT, mypid );
-    t = send ( s );
-    if ( t < 0 ) perror("exit send");
+    pthread_mutex_lock ( &mutex );
+    events[event][value] = 1;
+    pthread_mutex_unlock ( &mutex );
+    pthread_cond_broadcast ( &changed );
 }
 
-void process_env::send_shutdown()
+void process_env::report_complete ( int event, int value )
 {
-    int t;
-    char s[80];
-    sprintf(s,"%d %d", SHUTDOWN, mypid );
-    t = send ( s );
-    if ( t < 0 ) perror("shutdown send");
-}
-
-void process_env::shutdown()
-{
-    int t;
-    char s[80];
-    process_event *e;
-    map<string,process_event *>::iterator i = sb.begin();
-
-    strcpy(s,"-1");
-    while ( i != sb.end() ) {
-        e = i->second;
-        list<int>::iterator j = e->waiting.begin();
-        while ( j != e->waiting.end() ) {
-            t = *j;
-            send ( s, t );
-            j++;
-        }
-        i++;
-    }
+    complete ( event, value );
 }
 
 //
-//  Used by a worker to wait for the completion of an event.
-//  This could result in an immediate reply or the process
-//  could be placed in an event queue.
+//  Check the status of an event
 //
-bool process_env::wait_for ( string event_name, int value )
+bool process_env::ready ( int event, int value )
 {
-    int t;
-    char s[80];
-    sprintf(s,"%d %d %s %d", WAIT, mypid, event_name.c_str(), value );
-    t = send ( s );
-    if ( t < 0 ) perror("wait send");
-    t = receive ( s );
-    if ( t > 0 ) sscanf(s,"%d",&t);
+    bool t;
+
+    pthread_mutex_lock ( &mutex );
+    t = events[event][value];
+    pthread_mutex_unlock ( &mutex );
     return t;
 }
 
 //
-//  Used by a worker to get a task to work on.
-//  The worker sends the name of the task and the reply
-//  is an integer: -1 means no more work to do.
+//  Used by a worker to wait for the completion of an event.  Returns false
+//  if the program is shutting down.
 //
-int  process_env::get_task ( string name )
+bool process_env::wait_for ( int event, int value )
 {
-    int t;
-    char s[80];
-    sprintf(s,"%d %d %s 0", TASK, mypid, name.c_str() );
-    t = send ( s );
-    if ( t < 0 ) {
-        perror("task send");
-        return -1;
-    }
-    t = receive ( s );
-    if ( t < 0 ) {
-        perror("task recv");
-        return -1;
+    bool t;
+
+    pthread_mutex_lock ( &mutex );
+    while ( !must_quit && !events[event][value] ) {
+        pthread_cond_wait ( &changed, &mutex );
     }
-    sscanf(s,"%d",&t);
+    t = !must_quit;
+    pthread_mutex_unlock ( &mutex );
     return t;
 }
 
 //
-//  Used by a worker to report that a task has been completed.
+//  Tell all of the threads to give up.
 //
-void process_env::report_complete ( string name, int value )
+void process_env::send_shutdown()
 {
-    int t;
-    char s[80];
+    pthread_mutex_lock ( &mutex );
+    must_quit = 1;
+    pthread_mutex_unlock ( &mutex );
+    pthread_cond_broadcast ( &changed );
+}
 
-    sprintf(s,"%d %d %s %d", REPORT, mypid, name.c_str(), value );
-    t = send ( s );
-    if ( t < 0 ) perror("wait send");
+static void *thread_start ( void *arg )
+{
+    void (*p)() = (void (*)())arg;
+    p();
+    return NULL;
 }
 
 void process_env::launch ( void p() )
 {
-    int pid;
-
-    if ( pipe(to_parent[children]) ) {
-        perror("to_parent pipe create");
+    if ( children >= MAX_PROCS ) {
+        fprintf(stderr,"Too many threads\n");
         exit(1);
     }
-    if ( pipe(to_child[children]) ) {
-        perror("to_parent pipe create");
+    if ( pthread_create ( &threads[children], NULL, thread_start, (void *)p ) ) {
+        perror("thread create");
         exit(1);
     }
-
-    pid = fork();
-    if ( pid == 0 ) {
-        //
-        //      Child
-        //
-        mypid = children;
-        pipe_in = to_child[mypid][0];
-        pipe_out = to_parent[mypid][1];
-	close ( to_child[mypid][1] );
-	close ( to_parent[mypid][0] );
-	close ( master_pipe[0] );
-        p();
-        send_exit();
-       exit(0);
-    } else {
-        //
-        //      Parent
-        //
-	close ( to_child[children][0] );
-	close ( to_parent[children][1] );
-        children++;
-    }
+    children++;
 }
 
+//
+//  Wait for all of the threads to finish.
+//
 void process_env::run()
 {
-    int t, task = 0;
-    char s[80];
-    int req, pid, value;
-    char task_name[16];
+    int i;
 
-    while ( children > 0 ) {
-        receive ( s, 1 );
-        sscanf(s,"%d %d %s %d", &req, &pid, task_name, &value );
-        switch ( req ) {
-            case EXIT:
-                children--;
-            case WAIT:
-                if ( ready(task_name,value) ) {
-                    t = send ( "1", pid );
-                } else {
-                    enqueue ( task_name, value, pid );
-                }
-                break;
-            case TASK:
-                task = fetch_task(task_name);
-                sprintf(s,"%d",task);
-                t = send ( s, pid );
-                break;
-            case REPORT:
-                complete ( task_name, value );
-                break;
-        }
-    }
+    for ( i = 0; i < children; i++ ) pthread_join ( threads[i], NULL );
+    children = 0;
 }
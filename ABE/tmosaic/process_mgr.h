@@ -1,81 +1,63 @@
 #ifndef PROCESS_MGR_H
 #define PROCESS_MGR_H
 
-#include <string>
-#include <map>
-#include <list>
+#include <deque>
 #include <vector>
 #include <cstdio>
 #include <stdarg.h>
+#include <stdlib.h>
+#include <pthread.h>
 #include <sys/time.h>
 #include <time.h>
 
 using namespace std;
 
-#define MSG_SIZE 32
 #define MAX_PROCS 64
 
-
-class process_env;
-
-enum REQ { EXIT, WAIT, TASK, REPORT, SHUTDOWN };
-
-class process_event {
-    public:
-    static process_env *ppe;
-    string name;
-    int value;
-    bool ready;
-    list<int> waiting;
-    void wakeup();
-};
-
-typedef list<process_event *> task_list;
+//
+//  The process environment runs the reader, mapper and writer functions as
+//  threads in one address space.  Work is handed out through task queues and
+//  threads wait for each other through events.  Both are identified by small
+//  integers (the names used by the program are defined by the caller) and an
+//  integer value (an image or block number), so waiting for an event is just a
+//  flag check under the mutex instead of a message to a master process.
+//
+//  Tasks are taken from the front of a queue by whichever thread asks first,
+//  so idle mappers pick up the next block no matter which mapper finished
+//  the last one.
+//
 
 class process_env {
     public:
     int children;
-    int to_parent[MAX_PROCS][2];
-    int to_child[MAX_PROCS][2];
-    int pipe_in;
-    int pipe_out;
-    int master_pipe[2];
     int must_quit;
-    map<string,process_event *> sb;
-    map<string,task_list> task_map;
-    int next;
-    int mpid;
-    int mypid;
-    string event_key ( string event_name, int value );
-    void add_task ( string task_name, int value );
-    int fetch_task ( string task_name );
-    int pipe_read ( int fd, char *s, int size );
-    int pipe_write ( int fd, char *s, int size );
+    pthread_t threads[MAX_PROCS];
+    pthread_mutex_t mutex;
+    pthread_cond_t changed;
+    vector< deque<int> > tasks;             // Task queues
+    vector<int> closed;                     // No more tasks will be added to the queue
+    vector< vector<char> > events;          // Completed events
+    void init ( int num_tasks, int num_events, int num_values );
+    void add_task ( int task, int value );
+    void close_tasks ( int task );
+    int  get_task ( int task );
+    int  wait_task ( int task );
+    void complete ( int event, int value );
+    bool ready ( int event, int value );
+    bool wait_for ( int event, int value );
+    void report_complete ( int event, int value );
     void launch ( void p() );
-    void enqueue ( string event_name, int value, int pid );
-    void complete ( string event_name, int value );
-    bool ready ( string event_name, int value );
-    bool wait_for ( string event_name, int value );
-    int  get_task ( string name );
-    void report_complete ( string name, int value );
-    void send_exit();
     void send_shutdown();
-    void shutdown();
-    int receive ( char *s, int pid=0 );
-    int send ( char *s, int pid=-1 );
     void run();
     process_env() {
-	children=0;
-        process_event::ppe = this;
+        children = 0;
         must_quit = 0;
-        if ( pipe(master_pipe) ) {
-            perror("master pipe create");
-            exit(1);
-        }
-	mypid=-1;
-        pipe_in = master_pipe[0];
+        pthread_mutex_init ( &mutex, NULL );
+        pthread_cond_init ( &changed, NULL );
     }
     ~process_env() {
+        pthread_cond_destroy ( &changed );
+        pthread_mutex_destroy ( &mutex );
     }
 };
 
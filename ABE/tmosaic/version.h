@@ -2,7 +2,7 @@
 
 #ifndef VERSION
 
-#define     VERSION     "Ray Seyfarth - mosaic V1.20 - 01/29/08"
+#define     VERSION     "Ray Seyfarth - mosaic V1.30 - 10/19/26"
 
 #endif
 
@@ -29,4 +29,14 @@
 
     Fixes for elevation induced problems and other goodies.
 
+
+    Version 1.30
+    Jan C. Depner
+    10/19/26
+
+    Replaced the forked reader, mapper and writer processes (and the pipes and string keyed events used to
+    coordinate them) with threads.  Mappers take the next block as soon as they are free, mapped blocks go through
+    a pool of two output buffers per mapper and are written in the order they finish.  The number of mappers
+    defaults to the number of processors.
+
 */
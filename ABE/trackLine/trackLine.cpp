@@ -124,8 +124,6 @@ trackLine::slotCustomButtonClicked (int id __attribute__ ((unused)))
   NV_INT32 points = 0;
   NV_INT32 track_points = 0;
 
-  start_heading = 0.0;
-
 
   //  Use frame geometry to get the absolute x and y.
 
@@ -185,23 +183,9 @@ trackLine::slotCustomButtonClicked (int id __attribute__ ((unused)))
   QApplication::setOverrideCursor (Qt::WaitCursor);
 
 
-  NV_CHAR                   filename[512];
-  NV_INT32                  gsf_handle = -1, wlf_handle = -1, hawkeye_handle = -1, hour, min, ping, eof, percent = 0, old_percent = -1;
-  NV_FLOAT32                sec;
-  NV_BOOL                   first = NVTrue, got_data;
-  INFO                      data, prev_data, last_data = {0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};
-  FILE                      *fp = NULL, *ofp = NULL;
-  gsfDataID                 gsf_id;
-  gsfRecords                gsf_rec;
-  POS_OUTPUT_T              pos;
-  WLF_HEADER                wlf_header;
-  WLF_RECORD                wlf_record;
-  HAWKEYE_META_HEADER       *hawkeye_meta_header;
-  HAWKEYE_CONTENTS_HEADER   *hawkeye_contents_header;
-  HAWKEYE_RECORD            hawkeye_record;
+  FILE                      *ofp = NULL;
   QListWidgetItem           *cur;
   QString                   tmpString;
-  extern NV_INT32           gsfError;
 
 
   //  Add the extension if needed.
@@ -229,505 +213,128 @@ trackLine::slotCustomButtonClicked (int id __attribute__ ((unused)))
   NV_INT32 file_count = input_files.size ();
 
 
-  for (NV_INT32 i = 0 ; i < file_count ; i++)
-    {
-      strcpy (filename, input_files.at (i).toAscii ());
-
-
-      progress.fbar->reset ();
-      progress.fbar->setRange (0, 100);
-      tmpString = QString (tr ("Processing file %1 of %2 - %3").arg (i + 1).arg (file_count).arg (QFileInfo (filename).fileName ()));
-      progress.fbox->setTitle (tmpString);
-      qApp->processEvents ();
-
-
-      progress.fbar->setWhatsThis (tr ("Progress of input file processing"));
-
-
-      first = NVTrue;
-      ping = 0;
-
-
-      //  Open the input files and read the data.
-
-      fprintf (ofp, "FILE %03d = %s\n", i, filename);
-
-      got_data = NVFalse;
-
-      type = TRACKLINE_GSF;
-      if (strstr (filename, ".pos") || strstr (filename, ".out") || strstr (filename, ".POS") || strstr (filename, ".OUT")) type = TRACKLINE_POS;
-      if (strstr (filename, ".wlf") || strstr (filename, ".wtf") || strstr (filename, ".whf")) type = TRACKLINE_WLF;
-      if (strstr (filename, ".bin")) type = TRACKLINE_HWK;
-
-
-      switch (type)
-	{
-        case TRACKLINE_GSF:
-
-          if (!gsfOpen (filename, GSF_READONLY_INDEX, &gsf_handle))
-            {
-              time_t tv_sec;
-              long tv_nsec;
-
-              NV_INT32 records = gsfIndexTime (gsf_handle, GSF_RECORD_SWATH_BATHYMETRY_PING, -1, &tv_sec, &tv_nsec);
-
-              for (NV_INT32 j = 0 ; j < records ; j++)
-                {
-                  gsf_id.recordID = GSF_RECORD_SWATH_BATHYMETRY_PING;
-                  gsf_id.record_number = j + 1;
-                  if (gsfRead (gsf_handle, GSF_RECORD_SWATH_BATHYMETRY_PING, &gsf_id, &gsf_rec, NULL, 0) < 0) break;
-
-                  if (!(gsf_rec.mb_ping.ping_flags & GSF_IGNORE_PING) && gsf_rec.mb_ping.longitude != 0.0 && gsf_rec.mb_ping.latitude != 0.0 &&
-                      fabs (gsf_rec.mb_ping.longitude) <= 180.0 && fabs (gsf_rec.mb_ping.latitude) <= 90.0)
-                    {
-                      ping++;
-
-                      got_data = NVTrue;
-
-                      points++;
-
-                      data.f = i;
-                      data.t = (NV_FLOAT64) gsf_rec.mb_ping.ping_time.tv_sec + (NV_FLOAT64) gsf_rec.mb_ping.ping_time.tv_nsec / 1000000000.0;
-                      data.p = ping;
-                      data.y = gsf_rec.mb_ping.latitude;
-                      data.x = gsf_rec.mb_ping.longitude;
-                      data.h = gsf_rec.mb_ping.heading;
-
-
-                      last_data = data;
-
-
-                      if (first)
-                        {
-                          data.s = 0.0;
+  //  The input files are read by the track threads.  Each thread finds the track points for one file at a time and
+  //  leaves them in a slot.  We write the slots to the track file in input file order.
 
-                          hour = (int) data.t / 3600;
-                          min = ((int) data.t % 3600) / 60;
-                          sec = fmod (data.t, 60.0) * 60.0;
+  TRACK_QUEUE queue;
 
+  NV_INT32 num_threads = qMin (qMax (QThread::idealThreadCount (), 1), MAX_TRACK_THREADS);
+  num_threads = qMax (qMin (num_threads, file_count), 1);
 
-                          //  Save the last good heading since we want to compare it against the current heading.  Conversely, we want to compare
-                          //  speeds using two adjacent points.
+  queue.num_files = file_count;
+  queue.next_file = 0;
+  queue.write_file = 0;
+  queue.num_slots = num_threads * 2;
 
-                          start_heading = data.h;
-
-                          fprintf (ofp, "+,%d,%d,%.9f,%.9f,%f,%f,XXXX,XXX,%02d,%02d,%f\n", data.f, data.p, data.y, data.x, data.h, data.s, hour, min, sec);
-                          first = NVFalse;
-
-                          track_points++;
-                        }
-                      else if (changepos (&data, &prev_data))
-                        {
-                          hour = (int) data.t / 3600;
-                          min = ((int) data.t % 3600) / 60;
-                          sec = fmod (data.t, 60.0) * 60.0;
+  queue.slot = new TRACK_SLOT[queue.num_slots];
+  queue.ready = (NV_BOOL *) calloc (queue.num_slots, sizeof (NV_BOOL));
 
+  if (queue.ready == NULL)
+    {
+      perror ("Allocating slot flags");
+      exit (-1);
+    }
 
-                          //  Save the last good heading since we want to compare it against the current heading.  Conversely, we want to compare
-                          //  speeds using two adjacent points.
+  for (NV_INT32 i = 0 ; i < queue.num_slots ; i++)
+    {
+      queue.slot[i].data = NULL;
+      queue.slot[i].size = queue.slot[i].allocated = 0;
+    }
 
-                          start_heading = data.h;
 
-                          fprintf (ofp, "+,%d,%d,%.9f,%.9f,%f,%f,XXXX,XXX,%02d,%02d,%f\n", data.f, data.p, data.y, data.x, data.h, data.s, hour, min, sec);
+  progress.fbar->setWhatsThis (tr ("Progress of input file processing"));
 
-                          track_points++;
-                        }
 
-                      prev_data = data;
+  trackThread *track_thread = new trackThread[num_threads];
 
+  for (NV_INT32 i = 0 ; i < num_threads ; i++) track_thread[i].prepare (&options, &queue, &input_files);
 
-                      percent = (NV_INT32) roundf (((NV_FLOAT32) (j) / records) * 100.0);
-                      if (percent - old_percent >= 5 || old_percent > percent)
-                        {
-                          progress.fbar->setValue (percent);
-                          old_percent = percent;
 
-                          qApp->processEvents ();
-                        }
-                    }
-                }
+  for (NV_INT32 i = 0 ; i < file_count ; i++)
+    {
+      progress.fbar->reset ();
+      progress.fbar->setRange (0, 100);
+      tmpString = QString (tr ("Processing file %1 of %2 - %3").arg (i + 1).arg (file_count).arg (QFileInfo (input_files.at (i)).fileName ()));
+      progress.fbox->setTitle (tmpString);
+      qApp->processEvents ();
 
-              if (got_data)
-                {
-                  hour = (int) last_data.t / 3600;
-                  min = ((int) last_data.t % 3600) / 60;
-                  sec = fmod (last_data.t, 60.0) * 60.0;
 
-                  fprintf (ofp, "+,%d,%d,%.9f,%.9f,%f,%f,XXXX,XXX,%02d,%02d,%f\n", last_data.f, last_data.p, last_data.y, last_data.x, last_data.h,
-                           last_data.s, hour, min, sec);
+      //  Wait for the track thread to finish this file.  It wakes us up as soon as it's done.  We only time out to
+      //  update the percent bar and keep the GUI responsive while the file is being read.
 
-                  track_points++;
-                }
+      NV_INT32 slot_num = i % queue.num_slots, old_percent = -1;
 
-              gsfClose (gsf_handle);
+      queue.mutex.lock ();
 
-              progress.fbar->setValue (100);
-              qApp->processEvents ();
-            }
-          else
+      while (!queue.ready[slot_num])
+        {
+          if (!queue.slot_ready.wait (&queue.mutex, 100))
             {
-              cur = new QListWidgetItem (QString (gsfStringError ()));
-              trackList->addItem (cur);
-              trackList->setCurrentItem (cur);
-              trackList->scrollToItem (cur);
+              NV_INT32 percent = queue.slot[slot_num].percent;
+              queue.mutex.unlock ();
 
-              if (gsfError != GSF_FOPEN_ERROR) gsfClose (gsf_handle);
-            }
-
-          break;
-
-
-	case TRACKLINE_POS:
-
-	  if ((fp = open_pos_file (filename)) != NULL)
-	    {
-              fseek (fp, 0, SEEK_END);
-              eof = ftell (fp);
-              fseek (fp, 0, SEEK_SET);
-
-
-              //  Set the progress bar.
-
-
-	      while (!pos_read_record (fp, &pos))
-		{
-		  ping++;
-
-		  got_data = NVTrue;
-
-		  points++;
-
-		  data.f = i;
-		  data.t = pos.gps_time;
-		  data.p = ping;
-		  data.y = pos.latitude * RAD_TO_DEG;
-		  data.x = pos.longitude * RAD_TO_DEG;
-		  data.h = (pos.platform_heading - pos.wander_angle) * RAD_TO_DEG;
-
-
-                  last_data = data;
-
-
-		  if (first)
-		    {
-                      data.s = 0.0;
-
-                      hour = (int) data.t / 3600;
-                      min = ((int) data.t % 3600) / 60;
-                      sec = fmod (data.t, 60.0) * 60.0;
-
-
-                      //  Save the last good heading since we want to compare it against the current heading.  Conversely, we want to compare
-                      //  speeds using two adjacent points.
-
-                      start_heading = data.h;
-
-                      fprintf (ofp, "+,%d,%d,%.9f,%.9f,%f,%f,XXXX,XXX,%02d,%02d,%f\n", data.f, data.p, data.y, data.x, data.h, data.s, hour, min, sec);
-		      first = NVFalse;
-
-                      track_points++;
-		    }
-		  else if (changepos (&data, &prev_data))
-		    {
-                      hour = (int) data.t / 3600;
-                      min = ((int) data.t % 3600) / 60;
-                      sec = fmod (data.t, 60.0) * 60.0;
-
-
-                      //  Save the last good heading since we want to compare it against the current heading.  Conversely, we want to compare
-                      //  speeds using two adjacent points.
-
-                      start_heading = data.h;
-
-                      fprintf (ofp, "+,%d,%d,%.9f,%.9f,%f,%f,XXXX,XXX,%02d,%02d,%f\n", data.f, data.p, data.y, data.x, data.h, data.s, hour, min, sec);
-
-                      track_points++;
-		    }
-
-                  prev_data = data;
-
-
-                  //  We don't want to eat up all of the free time on the system with a progress bar.
-
-                  percent = (NV_INT32) roundf (((NV_FLOAT32) (ftell (fp)) / eof) * 100.0);
-                  if (percent - old_percent >= 5 || old_percent > percent)
-                    {
-                      progress.fbar->setValue (percent);
-                      old_percent = percent;
-
-                      qApp->processEvents ();
-                    }
-		}
-
-
-              if (got_data)
+              if (percent != old_percent)
                 {
-                  hour = (int) last_data.t / 3600;
-                  min = ((int) last_data.t % 3600) / 60;
-                  sec = fmod (last_data.t, 60.0) * 60.0;
-
-                  fprintf (ofp, "+,%d,%d,%.9f,%.9f,%f,%f,XXXX,XXX,%02d,%02d,%f\n", last_data.f, last_data.p, last_data.y, last_data.x, last_data.h,
-                           last_data.s, hour, min, sec);
-
-                  track_points++;
+                  progress.fbar->setValue (percent);
+                  old_percent = percent;
                 }
 
-              fclose (fp);
-
-              progress.fbar->setValue (100);
               qApp->processEvents ();
-	    }
-	  break;
-
-
-        case TRACKLINE_WLF:
 
-          if ((wlf_handle = wlf_open_file (filename, &wlf_header, WLF_READONLY)) < 0)
-            {
-              cur = new QListWidgetItem (QString (wlf_strerror ()));
-              trackList->addItem (cur);
-              trackList->setCurrentItem (cur);
-              trackList->scrollToItem (cur);
+              queue.mutex.lock ();
             }
-          else
-            {
-              if (!(wlf_header.opt.sensor_position_present && wlf_header.opt.sensor_attitude_present))
-                {
-                  cur = new QListWidgetItem (tr ("This program requires sensor position and attitude data for WLF files."));
-                  trackList->addItem (cur);
-                  trackList->setCurrentItem (cur);
-                  trackList->scrollToItem (cur);
-                }
-              else
-                {
-                  for (NV_U_INT32 j = 0 ; j < wlf_header.number_of_records ; j++)
-                    {
-                      if (wlf_read_record (wlf_handle, j, &wlf_record, NVFalse, NULL))
-                        {
-                          cur = new QListWidgetItem (QString (wlf_strerror ()));
-                          trackList->addItem (cur);
-                          trackList->setCurrentItem (cur);
-                          trackList->scrollToItem (cur);
-                          break;
-                        }
-
-                      ping++;
-
-                      got_data = NVTrue;
-
-                      points++;
-
-                      data.f = i;
-                      data.t = (NV_FLOAT64) wlf_record.tv_sec + (NV_FLOAT64) wlf_record.tv_nsec / 1000000000.0;
-                      data.p = ping;
-                      data.y = wlf_record.sensor_y;
-                      data.x = wlf_record.sensor_z;
-                      data.h = wlf_record.sensor_heading;
-
-                      last_data = data;
-
-                      if (first)
-                        {
-                          data.s = 0.0;
-
-                          hour = (int) data.t / 3600;
-                          min = ((int) data.t % 3600) / 60;
-                          sec = fmod (data.t, 60.0) * 60.0;
-
-
-                          //  Save the last good heading since we want to compare it against the current heading.  Conversely, we want to compare
-                          //  speeds using two adjacent points.
-
-                          start_heading = data.h;
-
-                          fprintf (ofp, "+,%d,%d,%.9f,%.9f,%f,%f,XXXX,XXX,%02d,%02d,%f\n", data.f, data.p, data.y, data.x, data.h, data.s, hour, min, sec);
-                          first = NVFalse;
-
-                          track_points++;
-                        }
-                      else if (changepos (&data, &prev_data))
-                        {
-                          hour = (int) data.t / 3600;
-                          min = ((int) data.t % 3600) / 60;
-                          sec = fmod (data.t, 60.0) * 60.0;
-
-
-                          //  Save the last good heading since we want to compare it against the current heading.  Conversely, we want to compare
-                          //  speeds using two adjacent points.
-
-                          start_heading = data.h;
-
-                          fprintf (ofp, "+,%d,%d,%.9f,%.9f,%f,%f,XXXX,XXX,%02d,%02d,%f\n", data.f, data.p, data.y, data.x, data.h, data.s, hour, min, sec);
-
-                          track_points++;
-                        }
-
-                      prev_data = data;
-
-
-                      //  We don't want to eat up all of the free time on the system with a progress bar.
-
-                      percent = (NV_INT32) roundf (((NV_FLOAT32) (j) / wlf_header.number_of_records) * 100.0);
-                      if (percent - old_percent >= 5 || old_percent > percent)
-                        {
-                          progress.fbar->setValue (percent);
-                          old_percent = percent;
-
-                          qApp->processEvents ();
-                        }
-                    }
-
-
-                  if (got_data)
-                    {
-                      hour = (int) last_data.t / 3600;
-                      min = ((int) last_data.t % 3600) / 60;
-                      sec = fmod (last_data.t, 60.0) * 60.0;
-
-                      fprintf (ofp, "+,%d,%d,%.9f,%.9f,%f,%f,XXXX,XXX,%02d,%02d,%f\n", last_data.f, last_data.p, last_data.y, last_data.x, last_data.h,
-                               last_data.s, hour, min, sec);
-
-                      track_points++;
-                    }
-                }
-
-              wlf_close_file (wlf_handle);
-            }
-
-          progress.fbar->setValue (100);
-          qApp->processEvents ();
-
-          break;
-
-
-        case TRACKLINE_HWK:
-
-          if ((hawkeye_handle = hawkeye_open_file (filename, &hawkeye_meta_header, &hawkeye_contents_header, HAWKEYE_READONLY)) < 0)
-            {
-              cur = new QListWidgetItem (QString (hawkeye_strerror ()));
-              trackList->addItem (cur);
-              trackList->setCurrentItem (cur);
-              trackList->scrollToItem (cur);
-            }
-          else
-            {
-              //  Check for the required fields.
-
-              if (!hawkeye_contents_header->available.Timestamp || !hawkeye_contents_header->available.Aircraft_Latitude ||
-                  !hawkeye_contents_header->available.Aircraft_Longitude || !hawkeye_contents_header->available.Aircraft_Heading)
-                {
-                  cur = new QListWidgetItem (tr ("This program requires Timestamp, Aircraft_Latitude, Aircraft_Longitude, and Aircraft_Heading data for HAWKEYE files."));
-                  trackList->addItem (cur);
-                  trackList->setCurrentItem (cur);
-                  trackList->scrollToItem (cur);
-                }
-              else
-                {
-                  for (NV_U_INT32 j = 0 ; j < hawkeye_contents_header->NbrOfPointRecords ; j++)
-                    {
-                      if (hawkeye_read_record (hawkeye_handle, j, &hawkeye_record))
-                        {
-                          cur = new QListWidgetItem (QString (hawkeye_strerror ()));
-                          trackList->addItem (cur);
-                          trackList->setCurrentItem (cur);
-                          trackList->scrollToItem (cur);
-                          break;
-                        }
-
-                      ping++;
-
-                      got_data = NVTrue;
-
-                      points++;
-
-                      data.f = i;
-                      data.t = (NV_FLOAT64) hawkeye_record.tv_sec + (NV_FLOAT64) hawkeye_record.tv_nsec / 1000000000.0;
-                      data.p = ping;
-                      data.y = hawkeye_record.Aircraft_Latitude;
-                      data.x = hawkeye_record.Aircraft_Longitude;
-                      data.h = hawkeye_record.Aircraft_Heading;
-
-                      if (first)
-                        {
-                          data.s = 0.0;
-
-                          hour = (int) data.t / 3600;
-                          min = ((int) data.t % 3600) / 60;
-                          sec = fmod (data.t, 60.0) * 60.0;
-
-
-                          //  Save the last good heading since we want to compare it against the current heading.  Conversely, we want to compare
-                          //  speeds using two adjacent points.
-
-                          start_heading = data.h;
-
-                          fprintf (ofp, "+,%d,%d,%.9f,%.9f,%f,%f,XXXX,XXX,%02d,%02d,%f\n", data.f, data.p, data.y, data.x, data.h, data.s, hour, min, sec);
-                          first = NVFalse;
-
-                          track_points++;
-                        }
-                      else if (changepos (&data, &prev_data))
-                        {
-                          hour = (int) data.t / 3600;
-                          min = ((int) data.t % 3600) / 60;
-                          sec = fmod (data.t, 60.0) * 60.0;
-
-
-                          //  Save the last good heading since we want to compare it against the current heading.  Conversely, we want to compare
-                          //  speeds using two adjacent points.
-
-                          start_heading = data.h;
-
-                          fprintf (ofp, "+,%d,%d,%.9f,%.9f,%f,%f,XXXX,XXX,%02d,%02d,%f\n", data.f, data.p, data.y, data.x, data.h, data.s, hour, min, sec);
+        }
 
-                          track_points++;
-                        }
+      queue.mutex.unlock ();
 
-                      prev_data = data;
+      progress.fbar->setValue (100);
+      qApp->processEvents ();
 
 
-                      //  We don't want to eat up all of the free time on the system with a progress bar.
+      TRACK_SLOT *slot = &queue.slot[slot_num];
 
-                      percent = (NV_INT32) roundf (((NV_FLOAT32) (j) / hawkeye_contents_header->NbrOfPointRecords) * 100.0);
-                      if (percent - old_percent >= 5 || old_percent > percent)
-                        {
-                          progress.fbar->setValue (percent);
-                          old_percent = percent;
+      fprintf (ofp, "FILE %03d = %s\n", i, input_files.at (i).toAscii ().data ());
+      if (slot->size) fwrite (slot->data, slot->size, 1, ofp);
 
-                          qApp->processEvents ();
-                        }
-                    }
+      points += slot->points;
+      track_points += slot->track_points;
 
+      for (NV_INT32 j = 0 ; j < slot->messages.size () ; j++)
+        {
+          cur = new QListWidgetItem (slot->messages.at (j));
+          trackList->addItem (cur);
+          trackList->setCurrentItem (cur);
+          trackList->scrollToItem (cur);
+        }
 
-                  if (got_data)
-                    {
-                      hour = (int) last_data.t / 3600;
-                      min = ((int) last_data.t % 3600) / 60;
-                      sec = fmod (last_data.t, 60.0) * 60.0;
+      cur = new QListWidgetItem (tr ("Completed processing file %1 of %2 - %3").arg (i + 1).arg (file_count).arg (QFileInfo (input_files.at (i)).fileName ()));
+      trackList->addItem (cur);
+      trackList->setCurrentItem (cur);
+      trackList->scrollToItem (cur);
 
-                      fprintf (ofp, "+,%d,%d,%.9f,%.9f,%f,%f,XXXX,XXX,%02d,%02d,%f\n", last_data.f, last_data.p, last_data.y, last_data.x, last_data.h,
-                               last_data.s, hour, min, sec);
 
-                      track_points++;
-                    }
-                }
+      //  Free the slot for the next file.
 
-              hawkeye_close_file (hawkeye_handle);
-            }
+      queue.mutex.lock ();
+      queue.ready[slot_num] = NVFalse;
+      queue.write_file++;
+      queue.slot_free.wakeAll ();
+      queue.mutex.unlock ();
+    }
 
-          progress.fbar->setValue (100);
-          qApp->processEvents ();
 
-          break;
-	}
+  for (NV_INT32 i = 0 ; i < num_threads ; i++) track_thread[i].wait ();
 
+  delete[] track_thread;
 
-      cur = new QListWidgetItem (tr ("Completed processing file %1 of %2 - %3").arg (i + 1).arg (file_count).arg (QFileInfo (filename).fileName ()));
-      trackList->addItem (cur);
-      trackList->setCurrentItem (cur);
-      trackList->scrollToItem (cur);
+  for (NV_INT32 i = 0 ; i < queue.num_slots ; i++)
+    {
+      if (queue.slot[i].data) free (queue.slot[i].data);
     }
 
+  delete[] queue.slot;
+  free (queue.ready);
+
 
   fclose (ofp);
 
@@ -741,65 +348,3 @@ trackLine::slotCustomButtonClicked (int id __attribute__ ((unused)))
   QApplication::restoreOverrideCursor ();
   button (QWizard::FinishButton)->setEnabled (TRUE);
 }
-
-
-
-NV_INT32 trackLine::heading_change (INFO *data)
-{
-  NV_FLOAT64          heading1 = start_heading, heading2 = data->h;
-
-
-  //  Check for northerly heading and adjust if necessary
-
-  if (heading1 > (360 - options.heading[type]) && heading2 < options.heading[type]) heading2 += 360;
-  if (heading2 > (360 - options.heading[type]) && heading1 < options.heading[type]) heading1 += 360;
-
-  return (fabs (heading1 - heading2) >= options.heading[type]);
-}
-
-
-
-NV_BOOL trackLine::changepos (INFO *prev_data, INFO *data)
-{
-  NV_FLOAT64          dist;
-  NV_FLOAT64          az;
-  NV_BOOL             change;
-
-
-  change = NVFalse;
-
-
-  //  Heading change greater than options.heading[type].
-
-  if (heading_change (data))
-    {
-      change = NVTrue;
-    }
-
-
-  //  Time change greater than one minute.
-
-  else if (data->t - prev_data->t > 60.0)
-    {
-      change = NVTrue;
-    }
-
-
-  //  Speed greater than options.speed[type].
-
-  else
-    {
-      invgp (NV_A0, NV_B0, prev_data->y, prev_data->x, data->y, data->x, &dist, &az);
-
-
-      data->s = dist / (data->t - prev_data->t) * MPS_TO_KNOTS;
-
-
-      if (data->s > options.speed[type])
-        {
-          change = NVTrue;
-        }
-    }
-
-  return (change);
-}
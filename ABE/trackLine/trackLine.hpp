@@ -6,6 +6,7 @@
 #include "optionsPage.hpp"
 #include "inputPage.hpp"
 #include "runPage.hpp"
+#include "trackThread.hpp"
 #include "version.hpp"
 
 
@@ -35,10 +36,6 @@ protected:
 
   NV_CHAR          *input_filenames[8000];
 
-  NV_FLOAT64       start_heading;
-
-  NV_INT32         type;
-
   RUN_PROGRESS     progress;
 
 
@@ -47,8 +44,6 @@ protected slots:
 
   void slotCustomButtonClicked (int id);
   void slotHelpClicked ();
-  NV_INT32 heading_change (INFO *data);
-  NV_BOOL changepos (INFO *prev_data, INFO *data);
 
 };
 
@@ -33,6 +33,9 @@
 #define TRACKLINE_HWK        3
 
 
+#define MAX_TRACK_THREADS    16
+
+
 typedef struct
 {
   NV_FLOAT64          x;      //  position longitude (dec deg)
@@ -52,6 +55,43 @@ typedef struct
 } RUN_PROGRESS;
 
 
+//  Output for one input file.  The track points are found by the track threads and written to the track file (in input
+//  file order) by the GUI thread so the file is the same no matter which thread finishes first.
+
+typedef struct
+{
+  NV_CHAR             *data;                 //  Track point lines for the file
+  size_t              size;
+  size_t              allocated;
+  NV_INT32            points;
+  NV_INT32            track_points;
+  NV_INT32            percent;
+  QStringList         messages;              //  Errors and warnings for the file
+} TRACK_SLOT;
+
+
+//  Shared state for the track threads and the GUI thread.  Each input file's track points are built by one track
+//  thread.  The .trk file lists the input files in the order they were selected, so the GUI thread appends a file's
+//  points only after every earlier file's points are written.  File i uses slot i % num_slots, so a thread that gets
+//  num_slots files ahead of the .trk file waits on slot_free.
+
+typedef struct
+{
+  QMutex              mutex;
+  QWaitCondition      slot_free;             //  Signaled by the GUI thread when a file's points are in the .trk file
+  QWaitCondition      slot_ready;            //  Signaled by a track thread when it has finished a file
+  QMutex              lib_mutex;             //  GSF and WLF file opens and closes, GSF reads
+  QMutex              pos_mutex;             //  The POS library keeps the byte swap and week rollover of the open file
+  QMutex              hawkeye_mutex;         //  The HAWKEYE library unpacks records into static memory
+  NV_INT32            num_files;
+  NV_INT32            next_file;             //  Next file to be read
+  NV_INT32            write_file;            //  Next file to be written
+  NV_INT32            num_slots;
+  TRACK_SLOT          *slot;                 //  [num_slots]
+  NV_BOOL             *ready;                //  [num_slots]
+} TRACK_QUEUE;
+
+
 typedef struct
 {
   NV_FLOAT64          heading[4];
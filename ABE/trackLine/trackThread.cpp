@@ -0,0 +1,596 @@
+#include "trackThread.hpp"
+
+
+//  GSF record header and swath bathymetry ping record layout (from the GSF specification).  The record header is the
+//  big endian data size followed by the record ID.  If bit 31 of the record ID is set a 4 byte checksum follows.  The
+//  first 32 bytes of the ping record are the time, position, flags, correctors, and heading.
+
+#define GSF_NAV_CHECKSUM_MASK    0x80000000
+#define GSF_NAV_RECORD_ID_MASK   0x003FFFFF
+#define GSF_NAV_PING_ID          2
+#define GSF_NAV_PING_BYTES       32
+
+
+trackThread::trackThread (QObject *parent)
+  : QThread(parent)
+{
+}
+
+
+
+trackThread::~trackThread ()
+{
+}
+
+
+
+void trackThread::prepare (OPTIONS *op, TRACK_QUEUE *tq, QStringList *files)
+{
+  QMutexLocker locker (&mutex);
+
+  l_options = op;
+  l_queue = tq;
+  l_files = files;
+
+  if (!isRunning ()) start ();
+}
+
+
+
+static NV_U_INT32 get_u32 (const NV_U_BYTE *ptr)
+{
+  return (((NV_U_INT32) ptr[0] << 24) | ((NV_U_INT32) ptr[1] << 16) | ((NV_U_INT32) ptr[2] << 8) | (NV_U_INT32) ptr[3]);
+}
+
+
+
+static NV_U_INT16 get_u16 (const NV_U_BYTE *ptr)
+{
+  return ((NV_U_INT16) (((NV_U_INT16) ptr[0] << 8) | (NV_U_INT16) ptr[1]));
+}
+
+
+
+//  Read the navigation from the next swath bathymetry ping record in a GSF file without decoding the beam arrays.
+//  Returns NVFalse at the end of the file or on a bad record header.
+
+static NV_BOOL read_gsf_nav (FILE *fp, time_t *tv_sec, long *tv_nsec, NV_FLOAT64 *lat, NV_FLOAT64 *lon, NV_FLOAT64 *heading,
+                             NV_U_INT16 *ping_flags)
+{
+  NV_U_BYTE header[8], buffer[GSF_NAV_PING_BYTES];
+
+
+  while (fread (header, 8, 1, fp) == 1)
+    {
+      NV_U_INT32 size = get_u32 (header);
+      NV_U_INT32 id = get_u32 (&header[4]);
+
+      if (id & GSF_NAV_CHECKSUM_MASK)
+        {
+          if (fseek (fp, 4, SEEK_CUR)) return (NVFalse);
+        }
+
+      if ((id & GSF_NAV_RECORD_ID_MASK) == GSF_NAV_PING_ID && size >= GSF_NAV_PING_BYTES)
+        {
+          if (fread (buffer, GSF_NAV_PING_BYTES, 1, fp) != 1) return (NVFalse);
+
+          *tv_sec = (time_t) (NV_INT32) get_u32 (buffer);
+          *tv_nsec = (long) (NV_INT32) get_u32 (&buffer[4]);
+          *lon = (NV_FLOAT64) ((NV_INT32) get_u32 (&buffer[8])) / 1.0e7;
+          *lat = (NV_FLOAT64) ((NV_INT32) get_u32 (&buffer[12])) / 1.0e7;
+          *ping_flags = get_u16 (&buffer[20]);
+          *heading = (NV_FLOAT64) get_u16 (&buffer[30]) / 100.0;
+
+          size -= GSF_NAV_PING_BYTES;
+          if (size && fseek (fp, size, SEEK_CUR)) return (NVFalse);
+
+          return (NVTrue);
+        }
+
+      if (fseek (fp, size, SEEK_CUR)) return (NVFalse);
+    }
+
+  return (NVFalse);
+}
+
+
+
+//  Make sure the slot has room for one more track point line and append it.
+
+void trackThread::write_point (INFO *info)
+{
+  NV_INT32 hour = (int) info->t / 3600;
+  NV_INT32 min = ((int) info->t % 3600) / 60;
+  NV_FLOAT32 sec = fmod (info->t, 60.0) * 60.0;
+
+
+  if (slot->size + 256 > slot->allocated)
+    {
+      size_t new_size = qMax (slot->allocated * 2, slot->size + 65536);
+
+      slot->data = (NV_CHAR *) realloc (slot->data, new_size);
+
+      if (slot->data == NULL)
+        {
+          perror ("Allocating track buffer");
+          exit (-1);
+        }
+
+      slot->allocated = new_size;
+    }
+
+  slot->size += snprintf (slot->data + slot->size, 256, "+,%d,%d,%.9f,%.9f,%f,%f,XXXX,XXX,%02d,%02d,%f\n", info->f, info->p, info->y,
+                          info->x, info->h, info->s, hour, min, sec);
+
+  slot->track_points++;
+}
+
+
+
+//  Check one position against the last one and output it if it's a track line point.
+
+void trackThread::add_point (NV_FLOAT64 t, NV_FLOAT64 lat, NV_FLOAT64 lon, NV_FLOAT64 heading)
+{
+  ping++;
+
+  got_data = NVTrue;
+
+  slot->points++;
+
+  data.f = file;
+  data.t = t;
+  data.p = ping;
+  data.y = lat;
+  data.x = lon;
+  data.h = heading;
+
+
+  last_data = data;
+
+
+  if (first)
+    {
+      data.s = 0.0;
+
+
+      //  Save the last good heading since we want to compare it against the current heading.  Conversely, we want to compare
+      //  speeds using two adjacent points.
+
+      start_heading = data.h;
+
+      write_point (&data);
+      first = NVFalse;
+    }
+  else if (changepos (&data, &prev_data))
+    {
+      //  Save the last good heading since we want to compare it against the current heading.  Conversely, we want to compare
+      //  speeds using two adjacent points.
+
+      start_heading = data.h;
+
+      write_point (&data);
+    }
+
+  prev_data = data;
+}
+
+
+
+//  We don't want to eat up all of the free time on the system with a progress bar.
+
+void trackThread::set_percent (NV_INT32 percent)
+{
+  if (percent - old_percent >= 5 || old_percent > percent)
+    {
+      l_queue->mutex.lock ();
+      slot->percent = percent;
+      l_queue->mutex.unlock ();
+
+      old_percent = percent;
+    }
+}
+
+
+
+//  Nav only GSF read.  The time, position, and heading are pulled from the front of each ping record so we don't have
+//  to unpack the beam arrays.  The first ping is checked against gsfRead and, if it doesn't match, we return NVFalse
+//  and the file is read using the GSF library.
+
+NV_BOOL trackThread::process_gsf_nav (NV_CHAR *filename)
+{
+  FILE                      *fp;
+  NV_INT32                  gsf_handle, eof;
+  NV_FLOAT64                lat, lon, heading;
+  NV_U_INT16                ping_flags;
+  NV_BOOL                   valid = NVFalse;
+  time_t                    tv_sec;
+  long                      tv_nsec;
+  gsfDataID                 gsf_id;
+  gsfRecords                gsf_rec;
+
+
+  if ((fp = fopen (filename, "rb")) == NULL) return (NVFalse);
+
+  if (!read_gsf_nav (fp, &tv_sec, &tv_nsec, &lat, &lon, &heading, &ping_flags))
+    {
+      fclose (fp);
+      return (NVFalse);
+    }
+
+
+  l_queue->lib_mutex.lock ();
+
+  if (!gsfOpen (filename, GSF_READONLY, &gsf_handle))
+    {
+      memset (&gsf_rec, 0, sizeof (gsfRecords));
+
+      if (gsfRead (gsf_handle, GSF_RECORD_SWATH_BATHYMETRY_PING, &gsf_id, &gsf_rec, NULL, 0) >= 0 &&
+          gsf_rec.mb_ping.ping_time.tv_sec == tv_sec && gsf_rec.mb_ping.ping_time.tv_nsec == tv_nsec &&
+          gsf_rec.mb_ping.latitude == lat && gsf_rec.mb_ping.longitude == lon && gsf_rec.mb_ping.heading == heading &&
+          gsf_rec.mb_ping.ping_flags == ping_flags) valid = NVTrue;
+
+      gsfFree (&gsf_rec);
+      gsfClose (gsf_handle);
+    }
+
+  l_queue->lib_mutex.unlock ();
+
+
+  if (!valid)
+    {
+      fclose (fp);
+      return (NVFalse);
+    }
+
+
+  fseek (fp, 0, SEEK_END);
+  eof = ftell (fp);
+  fseek (fp, 0, SEEK_SET);
+
+
+  while (read_gsf_nav (fp, &tv_sec, &tv_nsec, &lat, &lon, &heading, &ping_flags))
+    {
+      if (!(ping_flags & GSF_IGNORE_PING) && lon != 0.0 && lat != 0.0 && fabs (lon) <= 180.0 && fabs (lat) <= 90.0)
+        {
+          add_point ((NV_FLOAT64) tv_sec + (NV_FLOAT64) tv_nsec / 1000000000.0, lat, lon, heading);
+
+          set_percent ((NV_INT32) roundf (((NV_FLOAT32) (ftell (fp)) / eof) * 100.0));
+        }
+    }
+
+  fclose (fp);
+
+  return (NVTrue);
+}
+
+
+
+//  The GSF library keeps its file table and error state in globals so, if we can't use the nav only read, the whole
+//  file is read while holding the library mutex.
+
+void trackThread::process_gsf (NV_CHAR *filename)
+{
+  NV_INT32                  gsf_handle = -1;
+  gsfDataID                 gsf_id;
+  gsfRecords                gsf_rec;
+  extern NV_INT32           gsfError;
+
+
+  if (process_gsf_nav (filename)) return;
+
+
+  QMutexLocker locker (&l_queue->lib_mutex);
+
+  if (!gsfOpen (filename, GSF_READONLY_INDEX, &gsf_handle))
+    {
+      time_t tv_sec;
+      long tv_nsec;
+
+      memset (&gsf_rec, 0, sizeof (gsfRecords));
+
+      NV_INT32 records = gsfIndexTime (gsf_handle, GSF_RECORD_SWATH_BATHYMETRY_PING, -1, &tv_sec, &tv_nsec);
+
+      for (NV_INT32 j = 0 ; j < records ; j++)
+        {
+          gsf_id.recordID = GSF_RECORD_SWATH_BATHYMETRY_PING;
+          gsf_id.record_number = j + 1;
+          if (gsfRead (gsf_handle, GSF_RECORD_SWATH_BATHYMETRY_PING, &gsf_id, &gsf_rec, NULL, 0) < 0) break;
+
+          if (!(gsf_rec.mb_ping.ping_flags & GSF_IGNORE_PING) && gsf_rec.mb_ping.longitude != 0.0 && gsf_rec.mb_ping.latitude != 0.0 &&
+              fabs (gsf_rec.mb_ping.longitude) <= 180.0 && fabs (gsf_rec.mb_ping.latitude) <= 90.0)
+            {
+              add_point ((NV_FLOAT64) gsf_rec.mb_ping.ping_time.tv_sec + (NV_FLOAT64) gsf_rec.mb_ping.ping_time.tv_nsec / 1000000000.0,
+                         gsf_rec.mb_ping.latitude, gsf_rec.mb_ping.longitude, gsf_rec.mb_ping.heading);
+
+              set_percent ((NV_INT32) roundf (((NV_FLOAT32) (j) / records) * 100.0));
+            }
+        }
+
+      gsfFree (&gsf_rec);
+      gsfClose (gsf_handle);
+    }
+  else
+    {
+      slot->messages += QString (gsfStringError ());
+
+      if (gsfError != GSF_FOPEN_ERROR) gsfClose (gsf_handle);
+    }
+}
+
+
+
+//  The POS library keeps the byte swap and GPS week state of the open file in statics so only one POS file can be read
+//  at a time.
+
+void trackThread::process_pos (NV_CHAR *filename)
+{
+  FILE                      *fp;
+  NV_INT32                  eof;
+  POS_OUTPUT_T              pos;
+
+
+  QMutexLocker locker (&l_queue->pos_mutex);
+
+  if ((fp = open_pos_file (filename)) != NULL)
+    {
+      fseek (fp, 0, SEEK_END);
+      eof = ftell (fp);
+      fseek (fp, 0, SEEK_SET);
+
+
+      while (!pos_read_record (fp, &pos))
+        {
+          add_point (pos.gps_time, pos.latitude * RAD_TO_DEG, pos.longitude * RAD_TO_DEG,
+                     (pos.platform_heading - pos.wander_angle) * RAD_TO_DEG);
+
+          set_percent ((NV_INT32) roundf (((NV_FLOAT32) (ftell (fp)) / eof) * 100.0));
+        }
+
+      fclose (fp);
+    }
+}
+
+
+
+//  Only the open and close have to be protected.  The point records are scanned in blocks without the waveforms.
+
+void trackThread::process_wlf (NV_CHAR *filename)
+{
+  NV_INT32                  wlf_handle, recnum;
+  WLF_HEADER                wlf_header;
+  WLF_RECORD                wlf_record;
+
+
+  l_queue->lib_mutex.lock ();
+  wlf_handle = wlf_open_file (filename, &wlf_header, WLF_READONLY);
+  if (wlf_handle < 0) slot->messages += QString (wlf_strerror ());
+  l_queue->lib_mutex.unlock ();
+
+  if (wlf_handle < 0) return;
+
+
+  if (!(wlf_header.opt.sensor_position_present && wlf_header.opt.sensor_attitude_present))
+    {
+      slot->messages += tr ("This program requires sensor position and attitude data for WLF files.");
+    }
+  else
+    {
+      NV_INT32 status;
+
+      while ((status = wlf_scan_next (wlf_handle, &wlf_record, &recnum, NVFalse, NULL)) == WLF_SUCCESS)
+        {
+          add_point ((NV_FLOAT64) wlf_record.tv_sec + (NV_FLOAT64) wlf_record.tv_nsec / 1000000000.0, wlf_record.sensor_y,
+                     wlf_record.sensor_x, wlf_record.sensor_heading);
+
+          set_percent ((NV_INT32) roundf (((NV_FLOAT32) (recnum) / wlf_header.number_of_records) * 100.0));
+        }
+
+      if (status != WLF_SCAN_END_OF_FILE)
+        {
+          l_queue->lib_mutex.lock ();
+          slot->messages += QString (wlf_strerror ());
+          l_queue->lib_mutex.unlock ();
+        }
+    }
+
+
+  l_queue->lib_mutex.lock ();
+  wlf_close_file (wlf_handle);
+  l_queue->lib_mutex.unlock ();
+}
+
+
+
+//  The HAWKEYE library unpacks the headers and records into static memory so only one HAWKEYE file can be read at a
+//  time.
+
+void trackThread::process_hwk (NV_CHAR *filename)
+{
+  NV_INT32                  hawkeye_handle;
+  HAWKEYE_META_HEADER       *hawkeye_meta_header;
+  HAWKEYE_CONTENTS_HEADER   *hawkeye_contents_header;
+  HAWKEYE_RECORD            hawkeye_record;
+
+
+  QMutexLocker locker (&l_queue->hawkeye_mutex);
+
+  if ((hawkeye_handle = hawkeye_open_file (filename, &hawkeye_meta_header, &hawkeye_contents_header, HAWKEYE_READONLY)) < 0)
+    {
+      slot->messages += QString (hawkeye_strerror ());
+      return;
+    }
+
+
+  //  Check for the required fields.
+
+  if (!hawkeye_contents_header->available.Timestamp || !hawkeye_contents_header->available.Aircraft_Latitude ||
+      !hawkeye_contents_header->available.Aircraft_Longitude || !hawkeye_contents_header->available.Aircraft_Heading)
+    {
+      slot->messages += tr ("This program requires Timestamp, Aircraft_Latitude, Aircraft_Longitude, and Aircraft_Heading data for HAWKEYE files.");
+    }
+  else
+    {
+      for (NV_U_INT32 j = 0 ; j < hawkeye_contents_header->NbrOfPointRecords ; j++)
+        {
+          if (hawkeye_read_record (hawkeye_handle, j, &hawkeye_record))
+            {
+              slot->messages += QString (hawkeye_strerror ());
+              break;
+            }
+
+          add_point ((NV_FLOAT64) hawkeye_record.tv_sec + (NV_FLOAT64) hawkeye_record.tv_nsec / 1000000000.0,
+                     hawkeye_record.Aircraft_Latitude, hawkeye_record.Aircraft_Longitude, hawkeye_record.Aircraft_Heading);
+
+          set_percent ((NV_INT32) roundf (((NV_FLOAT32) (j) / hawkeye_contents_header->NbrOfPointRecords) * 100.0));
+        }
+    }
+
+  hawkeye_close_file (hawkeye_handle);
+}
+
+
+
+void trackThread::run ()
+{
+  NV_CHAR filename[512];
+
+
+  while (1)
+    {
+      //  Get the next file and wait for its slot to be free.
+
+      l_queue->mutex.lock ();
+
+      file = l_queue->next_file;
+
+      if (file >= l_queue->num_files)
+        {
+          l_queue->mutex.unlock ();
+          break;
+        }
+
+      l_queue->next_file++;
+
+      while (file >= l_queue->write_file + l_queue->num_slots) l_queue->slot_free.wait (&l_queue->mutex);
+
+      slot = &l_queue->slot[file % l_queue->num_slots];
+      slot->size = 0;
+      slot->points = 0;
+      slot->track_points = 0;
+      slot->percent = 0;
+      slot->messages.clear ();
+
+      l_queue->mutex.unlock ();
+
+
+      strcpy (filename, l_files->at (file).toAscii ());
+
+
+      memset (&data, 0, sizeof (INFO));
+      prev_data = last_data = data;
+      first = NVTrue;
+      got_data = NVFalse;
+      ping = 0;
+      old_percent = -1;
+      start_heading = 0.0;
+
+      type = TRACKLINE_GSF;
+      if (strstr (filename, ".pos") || strstr (filename, ".out") || strstr (filename, ".POS") || strstr (filename, ".OUT")) type = TRACKLINE_POS;
+      if (strstr (filename, ".wlf") || strstr (filename, ".wtf") || strstr (filename, ".whf")) type = TRACKLINE_WLF;
+      if (strstr (filename, ".bin")) type = TRACKLINE_HWK;
+
+
+      switch (type)
+        {
+        case TRACKLINE_GSF:
+          process_gsf (filename);
+          break;
+
+        case TRACKLINE_POS:
+          process_pos (filename);
+          break;
+
+        case TRACKLINE_WLF:
+          process_wlf (filename);
+          break;
+
+        case TRACKLINE_HWK:
+          process_hwk (filename);
+          break;
+        }
+
+
+      //  Always output the last point of the file.
+
+      if (got_data) write_point (&last_data);
+
+
+      l_queue->mutex.lock ();
+      slot->percent = 100;
+      l_queue->ready[file % l_queue->num_slots] = NVTrue;
+      l_queue->slot_ready.wakeAll ();
+      l_queue->mutex.unlock ();
+    }
+}
+
+
+
+NV_INT32 trackThread::heading_change (INFO *data)
+{
+  NV_FLOAT64          heading1 = start_heading, heading2 = data->h;
+
+
+  //  Check for northerly heading and adjust if necessary
+
+  if (heading1 > (360 - l_options->heading[type]) && heading2 < l_options->heading[type]) heading2 += 360;
+  if (heading2 > (360 - l_options->heading[type]) && heading1 < l_options->heading[type]) heading1 += 360;
+
+  return (fabs (heading1 - heading2) >= l_options->heading[type]);
+}
+
+
+
+NV_BOOL trackThread::changepos (INFO *prev_data, INFO *data)
+{
+  NV_FLOAT64          dist;
+  NV_FLOAT64          az;
+  NV_BOOL             change;
+
+
+  change = NVFalse;
+
+
+  //  Heading change greater than options.heading[type].
+
+  if (heading_change (data))
+    {
+      change = NVTrue;
+    }
+
+
+  //  Time change greater than one minute.
+
+  else if (data->t - prev_data->t > 60.0)
+    {
+      change = NVTrue;
+    }
+
+
+  //  Speed greater than options.speed[type].
+
+  else
+    {
+      invgp (NV_A0, NV_B0, prev_data->y, prev_data->x, data->y, data->x, &dist, &az);
+
+
+      data->s = dist / (data->t - prev_data->t) * MPS_TO_KNOTS;
+
+
+      if (data->s > l_options->speed[type])
+        {
+          change = NVTrue;
+        }
+    }
+
+  return (change);
+}
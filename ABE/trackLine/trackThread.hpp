@@ -0,0 +1,60 @@
+#ifndef TRACKTHREAD_H
+#define TRACKTHREAD_H
+
+
+#include "trackLineDef.hpp"
+
+
+class trackThread:public QThread
+{
+  Q_OBJECT 
+
+
+public:
+
+  trackThread (QObject *parent = 0);
+  ~trackThread ();
+
+  void prepare (OPTIONS *op = NULL, TRACK_QUEUE *tq = NULL, QStringList *files = NULL);
+
+
+protected:
+
+
+  QMutex           mutex;
+
+  OPTIONS          *l_options;
+
+  TRACK_QUEUE      *l_queue;
+
+  QStringList      *l_files;
+
+  TRACK_SLOT       *slot;
+
+  NV_INT32         file, type, ping, old_percent;
+
+  NV_FLOAT64       start_heading;
+
+  NV_BOOL          first, got_data;
+
+  INFO             data, prev_data, last_data;
+
+  void             run ();
+  void             process_gsf (NV_CHAR *filename);
+  NV_BOOL          process_gsf_nav (NV_CHAR *filename);
+  void             process_pos (NV_CHAR *filename);
+  void             process_wlf (NV_CHAR *filename);
+  void             process_hwk (NV_CHAR *filename);
+  void             add_point (NV_FLOAT64 t, NV_FLOAT64 lat, NV_FLOAT64 lon, NV_FLOAT64 heading);
+  void             write_point (INFO *info);
+  void             set_percent (NV_INT32 percent);
+  NV_INT32         heading_change (INFO *data);
+  NV_BOOL          changepos (INFO *prev_data, INFO *data);
+
+
+protected slots:
+
+private:
+};
+
+#endif
@@ -15,7 +15,7 @@
 
 #ifndef VERSION
 
-#define     VERSION     "PFM Software - trackLine V1.03 - 08/18/11"
+#define     VERSION     "PFM Software - trackLine V1.04 - 10/19/26"
 
 #endif
 
@@ -49,4 +49,15 @@
 
     Fixed speed limits for airborne files in optionsPage.cpp.
 
+
+    Version 1.04
+    Jan C. Depner
+    10/19/26
+
+    Input files are processed in parallel by trackThread (one file per thread).  The track points are written to the
+    track file in input file order so the output is the same as before.  GSF navigation is read directly from the ping
+    records (checked against gsfRead on the first ping) instead of unpacking every ping with gsfRead.  WLF files are
+    scanned in blocks with wlf_scan_next.  Fixed longitude for WLF files (was using sensor_z) and the missing last point
+    for HAWKEYE files.
+
 */
@@ -491,6 +491,304 @@ static void unpack_record (NV_INT32 hnd, NV_U_BYTE *buffer, CHRTR2_RECORD *chrtr
 
 
 
+/********************************************************************************************/
+/*!
+
+ - Function:    define_block_layout
+
+ - Purpose:     Computes the block geometry used for tiled storage and for the block cache.
+                For tiled files a block is a single tile.  For row ordered files a block is a
+                segment of CHRTR2_ROW_BLOCK_WIDTH columns (or less) of a single row.
+
+ - Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
+
+ - Date:        10/19/26
+
+ - Arguments:
+                - hnd            =    The CHRTR2 file handle
+
+ - Returns:
+                - void
+
+ - Caveats:     Must be called after define_record_fields since it needs the record size.
+
+*********************************************************************************************/
+
+static void define_block_layout (NV_INT32 hnd)
+{
+  chrtr2h[hnd].tile_size = chrtr2h[hnd].header.tile_size;
+
+  if (chrtr2h[hnd].tile_size > 0)
+    {
+      chrtr2h[hnd].block_height = chrtr2h[hnd].block_width = chrtr2h[hnd].tile_size;
+    }
+  else
+    {
+      chrtr2h[hnd].tile_size = chrtr2h[hnd].header.tile_size = 0;
+      chrtr2h[hnd].block_height = 1;
+      chrtr2h[hnd].block_width = MAX (1, MIN (CHRTR2_ROW_BLOCK_WIDTH, chrtr2h[hnd].header.width));
+    }
+
+  chrtr2h[hnd].blocks_wide = (chrtr2h[hnd].header.width + chrtr2h[hnd].block_width - 1) / chrtr2h[hnd].block_width;
+  chrtr2h[hnd].blocks_high = (chrtr2h[hnd].header.height + chrtr2h[hnd].block_height - 1) / chrtr2h[hnd].block_height;
+  chrtr2h[hnd].block_bytes = chrtr2h[hnd].block_height * chrtr2h[hnd].block_width * chrtr2h[hnd].record_size;
+}
+
+
+
+/*  Returns the byte offset of a cell in the file.  */
+
+static NV_INT64 cell_pos (NV_INT32 hnd, NV_INT32 row, NV_INT32 col)
+{
+  NV_INT64 cell;
+  NV_INT32 size = chrtr2h[hnd].tile_size;
+
+
+  if (size)
+    {
+      cell = ((NV_INT64) (row / size) * (NV_INT64) chrtr2h[hnd].blocks_wide + (NV_INT64) (col / size)) * (NV_INT64) size *
+        (NV_INT64) size + (NV_INT64) ((row % size) * size + col % size);
+    }
+  else
+    {
+      cell = (NV_INT64) row * (NV_INT64) chrtr2h[hnd].header.width + (NV_INT64) col;
+    }
+
+  return ((NV_INT64) chrtr2h[hnd].header_size + cell * (NV_INT64) chrtr2h[hnd].record_size);
+}
+
+
+
+/*  Returns the number of cells, starting at col and limited to count, that are contiguous in the file.  */
+
+static NV_INT32 contiguous_cells (NV_INT32 hnd, NV_INT32 col, NV_INT32 count)
+{
+  if (chrtr2h[hnd].tile_size) return (MIN (count, chrtr2h[hnd].tile_size - col % chrtr2h[hnd].tile_size));
+
+  return (count);
+}
+
+
+
+/*  Returns the block number of a cell and the byte offset of the cell within that block.  */
+
+static NV_INT32 block_id (NV_INT32 hnd, NV_INT32 row, NV_INT32 col, NV_INT32 *offset)
+{
+  *offset = ((row % chrtr2h[hnd].block_height) * chrtr2h[hnd].block_width + col % chrtr2h[hnd].block_width) *
+    chrtr2h[hnd].record_size;
+
+  return ((row / chrtr2h[hnd].block_height) * chrtr2h[hnd].blocks_wide + col / chrtr2h[hnd].block_width);
+}
+
+
+
+/*  Hash function for the block cache.  */
+
+static NV_U_INT32 block_hash (NV_INT32 hnd, NV_INT32 id)
+{
+  return (((NV_U_INT32) id * 2654435761U) & chrtr2h[hnd].cache_hash_mask);
+}
+
+
+
+/********************************************************************************************/
+/*!
+
+ - Function:    read_block
+
+ - Purpose:     Reads a block of packed records from the CHRTR2 file with a single seek and
+                read.
+
+ - Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
+
+ - Date:        10/19/26
+
+ - Arguments:
+                - hnd            =    The CHRTR2 file handle
+                - id             =    The block number
+                - data           =    Buffer of at least chrtr2h[hnd].block_bytes bytes
+
+ - Returns:
+                - CHRTR2_SUCCESS
+                - CHRTR2_READ_FSEEK_ERROR
+                - CHRTR2_READ_ERROR
+
+*********************************************************************************************/
+
+static NV_INT32 read_block (NV_INT32 hnd, NV_INT32 id, NV_U_BYTE *data)
+{
+  NV_INT32 row, col, bytes;
+
+
+  row = (id / chrtr2h[hnd].blocks_wide) * chrtr2h[hnd].block_height;
+  col = (id % chrtr2h[hnd].blocks_wide) * chrtr2h[hnd].block_width;
+
+
+  /*  Tiles are always full size on disk but the last block of a row in a row ordered file may be short.  */
+
+  if (chrtr2h[hnd].tile_size)
+    {
+      bytes = chrtr2h[hnd].block_bytes;
+    }
+  else
+    {
+      bytes = MIN (chrtr2h[hnd].block_width, chrtr2h[hnd].header.width - col) * chrtr2h[hnd].record_size;
+    }
+
+
+  if (fseeko64 (chrtr2h[hnd].fp, cell_pos (hnd, row, col), SEEK_SET) < 0)
+    {
+      chrtr2_error.system = errno;
+      chrtr2_error.coord.x = col;
+      chrtr2_error.coord.y = row;
+      strcpy (chrtr2_error.file, chrtr2h[hnd].path);
+      return (chrtr2_error.chrtr2 = CHRTR2_READ_FSEEK_ERROR);
+    }
+
+  if (!fread (data, bytes, 1, chrtr2h[hnd].fp))
+    {
+      chrtr2_error.system = errno;
+      chrtr2_error.coord.x = col;
+      chrtr2_error.coord.y = row;
+      strcpy (chrtr2_error.file, chrtr2h[hnd].path);
+      return (chrtr2_error.chrtr2 = CHRTR2_READ_ERROR);
+    }
+
+  return (CHRTR2_SUCCESS);
+}
+
+
+
+/*  Returns the index of a block in the block cache or -1 if it isn't there.  */
+
+static NV_INT32 find_cached_block (NV_INT32 hnd, NV_INT32 id)
+{
+  NV_INT32 i;
+
+
+  i = chrtr2h[hnd].cache_last;
+  if (chrtr2h[hnd].cache[i].id == id) return (i);
+
+  for (i = chrtr2h[hnd].cache_hash[block_hash (hnd, id)] ; i >= 0 ; i = chrtr2h[hnd].cache[i].next)
+    {
+      if (chrtr2h[hnd].cache[i].id == id) return (i);
+    }
+
+  return (-1);
+}
+
+
+
+/********************************************************************************************/
+/*!
+
+ - Function:    get_block
+
+ - Purpose:     Returns a pointer to a block of packed records.  If the block cache is open
+                the block comes from the cache (replacing the least recently used block on a
+                miss).  If not, the block is read into the caller supplied scratch buffer.
+
+ - Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
+
+ - Date:        10/19/26
+
+ - Arguments:
+                - hnd            =    The CHRTR2 file handle
+                - id             =    The block number
+                - scratch        =    Buffer of chrtr2h[hnd].block_bytes bytes (only used if
+                                      there is no block cache)
+
+ - Returns:
+                - Pointer to the block data or NULL on error (see chrtr2_error)
+
+*********************************************************************************************/
+
+static NV_U_BYTE *get_block (NV_INT32 hnd, NV_INT32 id, NV_U_BYTE *scratch)
+{
+  NV_INT32 i, *prev;
+  NV_U_INT32 h, oldest;
+
+
+  if (chrtr2h[hnd].cache == NULL)
+    {
+      if (read_block (hnd, id, scratch)) return (NULL);
+      return (scratch);
+    }
+
+
+  chrtr2h[hnd].cache_clock++;
+
+
+  if ((i = find_cached_block (hnd, id)) < 0)
+    {
+      /*  Cache miss, find the least recently used block (unused blocks have a use count of 0).  */
+
+      i = 0;
+      oldest = chrtr2h[hnd].cache[0].used;
+      for (h = 1 ; h < (NV_U_INT32) chrtr2h[hnd].cache_size ; h++)
+        {
+          if (chrtr2h[hnd].cache[h].used < oldest)
+            {
+              oldest = chrtr2h[hnd].cache[h].used;
+              i = h;
+            }
+        }
+
+
+      /*  Remove it from its hash chain.  */
+
+      if (chrtr2h[hnd].cache[i].id >= 0)
+        {
+          prev = &chrtr2h[hnd].cache_hash[block_hash (hnd, chrtr2h[hnd].cache[i].id)];
+          while (*prev != i) prev = &chrtr2h[hnd].cache[*prev].next;
+          *prev = chrtr2h[hnd].cache[i].next;
+        }
+
+      chrtr2h[hnd].cache[i].id = -1;
+      chrtr2h[hnd].cache[i].used = 0;
+
+
+      if (read_block (hnd, id, chrtr2h[hnd].cache[i].data)) return (NULL);
+
+
+      h = block_hash (hnd, id);
+      chrtr2h[hnd].cache[i].id = id;
+      chrtr2h[hnd].cache[i].next = chrtr2h[hnd].cache_hash[h];
+      chrtr2h[hnd].cache_hash[h] = i;
+    }
+
+
+  chrtr2h[hnd].cache[i].used = chrtr2h[hnd].cache_clock;
+  chrtr2h[hnd].cache_last = i;
+
+  return (chrtr2h[hnd].cache[i].data);
+}
+
+
+
+/*  Copies count packed records (that start at row/col) into any blocks of the block cache that hold them.  This
+    keeps the cache consistent with the file when writing.  */
+
+static void update_cached_blocks (NV_INT32 hnd, NV_INT32 row, NV_INT32 col, NV_INT32 count, NV_U_BYTE *buffer)
+{
+  NV_INT32 i, id, offset, run;
+
+
+  if (chrtr2h[hnd].cache == NULL) return;
+
+  for (i = 0 ; i < count ; i += run)
+    {
+      run = MIN (count - i, chrtr2h[hnd].block_width - (col + i) % chrtr2h[hnd].block_width);
+
+      id = block_id (hnd, row, col + i, &offset);
+
+      if ((id = find_cached_block (hnd, id)) >= 0)
+        memcpy (chrtr2h[hnd].cache[id].data + offset, buffer + i * chrtr2h[hnd].record_size, run * chrtr2h[hnd].record_size);
+    }
+}
+
+
+
 /********************************************************************************************/
 /*!
 
@@ -665,6 +963,8 @@ static NV_INT32 chrtr2_write_header (NV_INT32 hnd)
 
   if (chrtr2h[hnd].num_bits) fprintf (chrtr2h[hnd].fp, N_("[MAX NUMBER OF POINTS] = %d\n"), chrtr2h[hnd].header.max_number_of_points);
 
+  if (chrtr2h[hnd].tile_size) fprintf (chrtr2h[hnd].fp, N_("[TILE SIZE] = %d\n"), chrtr2h[hnd].tile_size);
+
   chrtr2h[hnd].header_size = CHRTR2_HEADER_SIZE;
   fprintf (chrtr2h[hnd].fp, N_("[HEADER SIZE] = %d\n"), chrtr2h[hnd].header_size);
   fprintf (chrtr2h[hnd].fp, N_("[RECORD SIZE] = %d\n"), chrtr2h[hnd].record_size);
@@ -721,7 +1021,7 @@ static NV_INT32 chrtr2_write_header (NV_INT32 hnd)
 
 CHRTR2_DLL NV_INT32 chrtr2_create_file (const NV_CHAR *path, CHRTR2_HEADER *chrtr2_header)
 {
-  NV_INT32             i, hnd, bytes;
+  NV_INT32             i, hnd, bytes, count;
   NV_U_BYTE            *buffer = NULL;
 
     
@@ -802,6 +1102,9 @@ CHRTR2_DLL NV_INT32 chrtr2_create_file (const NV_CHAR *path, CHRTR2_HEADER *chrt
   /*  Define the bit fields and record size.  */
 
   define_record_fields (hnd, NVTrue);
+  define_block_layout (hnd);
+
+  chrtr2_header->tile_size = chrtr2h[hnd].tile_size;
 
 
   /*  Write the header.  */
@@ -810,9 +1113,19 @@ CHRTR2_DLL NV_INT32 chrtr2_create_file (const NV_CHAR *path, CHRTR2_HEADER *chrt
 
 
   /*  Zero the file so that all cells will be set to CHRTR2_NULL (i.e. 0) in case someone wants to play sparse fill games
-      with the file.  */
+      with the file.  Tiled files are written a (padded) tile at a time.  */
+
+  if (chrtr2h[hnd].tile_size)
+    {
+      bytes = chrtr2h[hnd].block_bytes;
+      count = chrtr2h[hnd].blocks_wide * chrtr2h[hnd].blocks_high;
+    }
+  else
+    {
+      bytes = chrtr2h[hnd].record_size * chrtr2h[hnd].header.width;
+      count = chrtr2h[hnd].header.height;
+    }
 
-  bytes = chrtr2h[hnd].record_size * chrtr2h[hnd].header.width;
   buffer = (NV_U_BYTE *) calloc (bytes, sizeof (NV_U_BYTE));
   if (buffer == NULL)
     {
@@ -820,7 +1133,7 @@ CHRTR2_DLL NV_INT32 chrtr2_create_file (const NV_CHAR *path, CHRTR2_HEADER *chrt
       exit (-1);
     }
 
-  for (i = 0 ; i < chrtr2h[hnd].header.height ; i++) fwrite (buffer, bytes, 1, chrtr2h[hnd].fp);
+  for (i = 0 ; i < count ; i++) fwrite (buffer, bytes, 1, chrtr2h[hnd].fp);
 
   free (buffer);
 
@@ -1142,6 +1455,8 @@ CHRTR2_DLL NV_INT32 chrtr2_open_file (const NV_CHAR *path, CHRTR2_HEADER *chrtr2
 
       if (strstr (varin, N_("[MAX NUMBER OF POINTS]"))) sscanf (info, "%d", &chrtr2h[hnd].header.max_number_of_points);
 
+      if (strstr (varin, N_("[TILE SIZE]"))) sscanf (info, "%d", &chrtr2h[hnd].header.tile_size);
+
       if (strstr (varin, N_("[HEADER SIZE]"))) sscanf (info, "%d", &chrtr2h[hnd].header_size);
       if (strstr (varin, N_("[RECORD SIZE]"))) sscanf (info, "%hd", &chrtr2h[hnd].record_size);
     }
@@ -1165,6 +1480,7 @@ CHRTR2_DLL NV_INT32 chrtr2_open_file (const NV_CHAR *path, CHRTR2_HEADER *chrtr2
   chrtr2_inv_cvtime (year[1] - 1900, jday[1], hour[1], minute[1], second[1], &chrtr2h[hnd].header.modification_tv_sec, &dummy_tv_nsec);
 
   define_record_fields (hnd, NVFalse);
+  define_block_layout (hnd);
 
   *chrtr2_header = chrtr2h[hnd].header;
 
@@ -1246,11 +1562,13 @@ CHRTR2_DLL NV_INT32 chrtr2_close_file (NV_INT32 hnd)
     }
 
 
-  /*  Clear the internal structure.  */
+  /*  Free the coverage map and block cache (if any) and clear the internal structure.  */
+
+  if (chrtr2h[hnd].cov_map != NULL) free (chrtr2h[hnd].cov_map);
+  chrtr2_close_cache (hnd);
 
   memset (&chrtr2h[hnd], 0, sizeof (INTERNAL_CHRTR2_STRUCT));
   chrtr2h[hnd].fp = NULL;
-  if (chrtr2h[hnd].cov_map != NULL) free (chrtr2h[hnd].cov_map);
   chrtr2h[hnd].cov_map = NULL;
 
 
@@ -1288,8 +1606,8 @@ CHRTR2_DLL NV_INT32 chrtr2_close_file (NV_INT32 hnd)
 
 CHRTR2_DLL NV_INT32 chrtr2_read_record (NV_INT32 hnd, NV_I32_COORD2 coord, CHRTR2_RECORD *chrtr2_record)
 {
-  NV_INT64 pos;
-  NV_U_BYTE buffer[1024];
+  NV_U_BYTE buffer[1024], *data;
+  NV_INT32 id, offset;
 
 
   /*  Check for record out of bounds.  */
@@ -1302,10 +1620,22 @@ CHRTR2_DLL NV_INT32 chrtr2_read_record (NV_INT32 hnd, NV_I32_COORD2 coord, CHRTR
     }
 
 
-  pos = (NV_INT64) chrtr2h[hnd].header_size + (((NV_INT64) coord.y * (NV_INT64) chrtr2h[hnd].header.width) + (NV_INT64) coord.x) *
-    (NV_INT64) chrtr2h[hnd].record_size;
+  /*  If we have a block cache, get the record from there.  */
 
-  if (fseeko64 (chrtr2h[hnd].fp, pos, SEEK_SET) < 0)
+  if (chrtr2h[hnd].cache != NULL)
+    {
+      id = block_id (hnd, coord.y, coord.x, &offset);
+
+      if ((data = get_block (hnd, id, NULL)) == NULL) return (chrtr2_error.chrtr2);
+
+      unpack_record (hnd, data + offset, chrtr2_record);
+
+      chrtr2_error.system = 0;
+      return (chrtr2_error.chrtr2 = CHRTR2_SUCCESS);
+    }
+
+
+  if (fseeko64 (chrtr2h[hnd].fp, cell_pos (hnd, coord.y, coord.x), SEEK_SET) < 0)
     {
       chrtr2_error.system = errno;
       chrtr2_error.coord = coord;
@@ -1436,9 +1766,8 @@ CHRTR2_DLL NV_INT32 chrtr2_read_record_lat_lon (NV_INT32 hnd, NV_FLOAT64 lat, NV
 
 CHRTR2_DLL NV_INT32 chrtr2_read_row (NV_INT32 hnd, NV_INT32 row, NV_INT32 start_column, NV_INT32 length, CHRTR2_RECORD *chrtr2_record)
 {
-  NV_INT64 pos;
-  NV_U_BYTE *buffer = NULL, *ptr;
-  NV_INT32 i, bytes;
+  NV_U_BYTE *buffer = NULL, *ptr, *data;
+  NV_INT32 i, j, run, bytes, id, offset;
 
 
   /*  Check for record out of bounds.  */
@@ -1453,18 +1782,28 @@ CHRTR2_DLL NV_INT32 chrtr2_read_row (NV_INT32 hnd, NV_INT32 row, NV_INT32 start_
     }
 
 
-  pos = (NV_INT64) chrtr2h[hnd].header_size + (((NV_INT64) row * (NV_INT64) chrtr2h[hnd].header.width) + (NV_INT64) start_column) *
-    (NV_INT64) chrtr2h[hnd].record_size;
-
+  /*  If we have a block cache, unpack the records from the cached blocks that the row segment crosses.  */
 
-  if (fseeko64 (chrtr2h[hnd].fp, pos, SEEK_SET) < 0)
+  if (chrtr2h[hnd].cache != NULL)
     {
-      chrtr2_error.system = errno;
-      chrtr2_error.coord.x = start_column;
-      chrtr2_error.coord.y = row;
-      chrtr2_error.length = length;
-      strcpy (chrtr2_error.file, chrtr2h[hnd].path);
-      return (chrtr2_error.chrtr2 = CHRTR2_READ_FSEEK_ERROR);
+      for (i = 0 ; i < length ; i += run)
+        {
+          run = MIN (length - i, chrtr2h[hnd].block_width - (start_column + i) % chrtr2h[hnd].block_width);
+
+          id = block_id (hnd, row, start_column + i, &offset);
+
+          if ((data = get_block (hnd, id, NULL)) == NULL) return (chrtr2_error.chrtr2);
+
+          ptr = data + offset;
+          for (j = 0 ; j < run ; j++)
+            {
+              unpack_record (hnd, ptr, &chrtr2_record[i + j]);
+              ptr += chrtr2h[hnd].record_size;
+            }
+        }
+
+      chrtr2_error.system = 0;
+      return (chrtr2_error.chrtr2 = CHRTR2_SUCCESS);
     }
 
 
@@ -1477,14 +1816,33 @@ CHRTR2_DLL NV_INT32 chrtr2_read_row (NV_INT32 hnd, NV_INT32 row, NV_INT32 start_
     }
 
 
-  if (!fread (buffer, bytes, 1, chrtr2h[hnd].fp))
+  /*  A row ordered file needs a single read.  A tiled file needs one read for each tile that the row segment crosses.  */
+
+  for (i = 0 ; i < length ; i += run)
     {
-      chrtr2_error.system = errno;
-      chrtr2_error.coord.x = start_column;
-      chrtr2_error.coord.y = row;
-      chrtr2_error.length = length;
-      strcpy (chrtr2_error.file, chrtr2h[hnd].path);
-      return (chrtr2_error.chrtr2 = CHRTR2_READ_ERROR);
+      run = contiguous_cells (hnd, start_column + i, length - i);
+
+      if (fseeko64 (chrtr2h[hnd].fp, cell_pos (hnd, row, start_column + i), SEEK_SET) < 0)
+        {
+          free (buffer);
+          chrtr2_error.system = errno;
+          chrtr2_error.coord.x = start_column;
+          chrtr2_error.coord.y = row;
+          chrtr2_error.length = length;
+          strcpy (chrtr2_error.file, chrtr2h[hnd].path);
+          return (chrtr2_error.chrtr2 = CHRTR2_READ_FSEEK_ERROR);
+        }
+
+      if (!fread (buffer + i * chrtr2h[hnd].record_size, run * chrtr2h[hnd].record_size, 1, chrtr2h[hnd].fp))
+        {
+          free (buffer);
+          chrtr2_error.system = errno;
+          chrtr2_error.coord.x = start_column;
+          chrtr2_error.coord.y = row;
+          chrtr2_error.length = length;
+          strcpy (chrtr2_error.file, chrtr2h[hnd].path);
+          return (chrtr2_error.chrtr2 = CHRTR2_READ_ERROR);
+        }
     }
 
 
@@ -1538,7 +1896,6 @@ CHRTR2_DLL NV_INT32 chrtr2_write_record (NV_INT32 hnd, NV_I32_COORD2 coord, CHRT
   NV_U_BYTE buffer[1024];
   NV_INT32 stat;
   NV_U_INT32 cov_pos;
-  NV_INT64 pos;
 
 
   /*  Check for record out of bounds.  */
@@ -1554,10 +1911,7 @@ CHRTR2_DLL NV_INT32 chrtr2_write_record (NV_INT32 hnd, NV_I32_COORD2 coord, CHRT
   if (pack_record (hnd, buffer, chrtr2_record)) return (chrtr2_error.chrtr2);
 
 
-  pos = (NV_INT64) chrtr2h[hnd].header_size + (((NV_INT64) coord.y * (NV_INT64) chrtr2h[hnd].header.width) + (NV_INT64) coord.x) *
-    (NV_INT64) chrtr2h[hnd].record_size;
-
-  if (fseeko64 (chrtr2h[hnd].fp, pos, SEEK_SET) < 0)
+  if (fseeko64 (chrtr2h[hnd].fp, cell_pos (hnd, coord.y, coord.x), SEEK_SET) < 0)
     {
       chrtr2_error.system = errno;
       chrtr2_error.coord = coord;
@@ -1574,6 +1928,11 @@ CHRTR2_DLL NV_INT32 chrtr2_write_record (NV_INT32 hnd, NV_I32_COORD2 coord, CHRT
     }
 
 
+  /*  Keep the block cache (if any) in sync with the file.  */
+
+  update_cached_blocks (hnd, coord.y, coord.x, 1, buffer);
+
+
   /*  If we're maintaining a coverage map for this file, update the coverage status.  */
 
   if (chrtr2h[hnd].cov_map != NULL)
@@ -1699,14 +2058,13 @@ CHRTR2_DLL NV_INT32 chrtr2_write_record_lat_lon (NV_INT32 hnd, NV_FLOAT64 lat, N
 CHRTR2_DLL NV_INT32 chrtr2_write_row (NV_INT32 hnd, NV_INT32 row, NV_INT32 start_col, NV_INT32 length, CHRTR2_RECORD *chrtr2_record)
 {
   NV_U_BYTE *buffer = NULL, *ptr;
-  NV_INT32 i, bytes, stat;
+  NV_INT32 i, bytes, stat, run;
   NV_U_INT32 cov_pos;
-  NV_INT64 pos;
 
 
   /*  Check for record out of bounds.  */
 
-  if (row < 0 || start_col < 0 || row >= chrtr2h[hnd].header.height || start_col + length >= chrtr2h[hnd].header.width)
+  if (row < 0 || start_col < 0 || row >= chrtr2h[hnd].header.height || start_col + length > chrtr2h[hnd].header.width)
     {
       chrtr2_error.coord.x = start_col;
       chrtr2_error.coord.y = row;
@@ -1751,32 +2109,42 @@ CHRTR2_DLL NV_INT32 chrtr2_write_row (NV_INT32 hnd, NV_INT32 row, NV_INT32 start
     }
 
 
-  pos = (NV_INT64) chrtr2h[hnd].header_size + (((NV_INT64) row * (NV_INT64) chrtr2h[hnd].header.width) + (NV_INT64) start_col) *
-    (NV_INT64) chrtr2h[hnd].record_size;
-
+  /*  A row ordered file needs a single write.  A tiled file needs one write for each tile that the row segment crosses.  */
 
-  if (fseeko64 (chrtr2h[hnd].fp, pos, SEEK_SET) < 0)
+  for (i = 0 ; i < length ; i += run)
     {
-      chrtr2_error.system = errno;
-      chrtr2_error.coord.x = start_col;
-      chrtr2_error.coord.y = row;
-      chrtr2_error.length = length;
-      strcpy (chrtr2_error.file, chrtr2h[hnd].path);
-      return (chrtr2_error.chrtr2 = CHRTR2_WRITE_FSEEK_ERROR);
-    }
+      run = contiguous_cells (hnd, start_col + i, length - i);
 
+      if (fseeko64 (chrtr2h[hnd].fp, cell_pos (hnd, row, start_col + i), SEEK_SET) < 0)
+        {
+          free (buffer);
+          chrtr2_error.system = errno;
+          chrtr2_error.coord.x = start_col;
+          chrtr2_error.coord.y = row;
+          chrtr2_error.length = length;
+          strcpy (chrtr2_error.file, chrtr2h[hnd].path);
+          return (chrtr2_error.chrtr2 = CHRTR2_WRITE_FSEEK_ERROR);
+        }
 
-  if (!fwrite (buffer, bytes, 1, chrtr2h[hnd].fp))
-    {
-      chrtr2_error.system = errno;
-      chrtr2_error.coord.x = start_col;
-      chrtr2_error.coord.y = row;
-      chrtr2_error.length = length;
-      strcpy (chrtr2_error.file, chrtr2h[hnd].path);
-      return (chrtr2_error.chrtr2 = CHRTR2_WRITE_ERROR);
+
+      if (!fwrite (buffer + i * chrtr2h[hnd].record_size, run * chrtr2h[hnd].record_size, 1, chrtr2h[hnd].fp))
+        {
+          free (buffer);
+          chrtr2_error.system = errno;
+          chrtr2_error.coord.x = start_col;
+          chrtr2_error.coord.y = row;
+          chrtr2_error.length = length;
+          strcpy (chrtr2_error.file, chrtr2h[hnd].path);
+          return (chrtr2_error.chrtr2 = CHRTR2_WRITE_ERROR);
+        }
     }
 
 
+  /*  Keep the block cache (if any) in sync with the file.  */
+
+  update_cached_blocks (hnd, row, start_col, length, buffer);
+
+
   free (buffer);
 
 
@@ -1947,6 +2315,260 @@ CHRTR2_DLL NV_INT32 chrtr2_close_cov_map (NV_INT32 hnd)
 
 
 
+/********************************************************************************************/
+/*!
+
+ - Function:    chrtr2_open_cache
+
+ - Purpose:     Creates a block cache for a CHRTR2 file.  Once the cache is open, all of the
+                read functions get their records from blocks held in memory (tiles for tiled
+                files or CHRTR2_ROW_BLOCK_WIDTH column row segments for row ordered files).
+                Blocks are read from the file with a single seek and read the first time they
+                are needed and the least recently used block is replaced when the cache is full.
+                Writes go straight through to the file and also update any cached blocks.
+
+ - Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
+
+ - Date:        10/19/26
+
+ - Arguments:
+                - hnd            =    The CHRTR2 file handle
+                - megabytes      =    Maximum size of the cache in megabytes
+
+ - Returns:
+                - CHRTR2_SUCCESS
+
+ - Caveats:     Calling this on a file that already has a cache will replace the cache with one
+                of the new size.  The memory is freed in chrtr2_close_cache or chrtr2_close_file.
+
+*********************************************************************************************/
+
+CHRTR2_DLL NV_INT32 chrtr2_open_cache (NV_INT32 hnd, NV_INT32 megabytes)
+{
+  NV_INT32 i, size;
+  NV_U_INT32 hash_size;
+
+
+  chrtr2_close_cache (hnd);
+
+
+  /*  Compute the number of blocks.  There's no point in having more blocks than the file has.  */
+
+  size = (NV_INT32) MIN (((NV_INT64) megabytes * 1048576LL) / (NV_INT64) chrtr2h[hnd].block_bytes,
+                         (NV_INT64) chrtr2h[hnd].blocks_wide * (NV_INT64) chrtr2h[hnd].blocks_high);
+  if (size < 1) size = 1;
+
+
+  chrtr2h[hnd].cache = (CHRTR2_BLOCK *) calloc (size, sizeof (CHRTR2_BLOCK));
+  if (chrtr2h[hnd].cache == NULL)
+    {
+      perror ("Allocating cache memory in chrtr2_open_cache");
+      exit (-1);
+    }
+
+  chrtr2h[hnd].cache_data = (NV_U_BYTE *) malloc ((size_t) size * (size_t) chrtr2h[hnd].block_bytes);
+  if (chrtr2h[hnd].cache_data == NULL)
+    {
+      perror ("Allocating cache_data memory in chrtr2_open_cache");
+      exit (-1);
+    }
+
+
+  /*  The hash table is a power of 2 at least twice the size of the cache.  */
+
+  hash_size = 1;
+  while (hash_size < (NV_U_INT32) size * 2) hash_size <<= 1;
+
+  chrtr2h[hnd].cache_hash = (NV_INT32 *) malloc (hash_size * sizeof (NV_INT32));
+  if (chrtr2h[hnd].cache_hash == NULL)
+    {
+      perror ("Allocating cache_hash memory in chrtr2_open_cache");
+      exit (-1);
+    }
+
+  for (i = 0 ; i < (NV_INT32) hash_size ; i++) chrtr2h[hnd].cache_hash[i] = -1;
+
+
+  for (i = 0 ; i < size ; i++)
+    {
+      chrtr2h[hnd].cache[i].id = -1;
+      chrtr2h[hnd].cache[i].next = -1;
+      chrtr2h[hnd].cache[i].used = 0;
+      chrtr2h[hnd].cache[i].data = chrtr2h[hnd].cache_data + (size_t) i * (size_t) chrtr2h[hnd].block_bytes;
+    }
+
+  chrtr2h[hnd].cache_size = size;
+  chrtr2h[hnd].cache_hash_mask = hash_size - 1;
+  chrtr2h[hnd].cache_last = 0;
+  chrtr2h[hnd].cache_clock = 0;
+
+
+  return (chrtr2_error.chrtr2 = CHRTR2_SUCCESS);
+}
+
+
+
+/********************************************************************************************/
+/*!
+
+ - Function:    chrtr2_close_cache
+
+ - Purpose:     Frees the block cache for a CHRTR2 file.
+
+ - Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
+
+ - Date:        10/19/26
+
+ - Arguments:
+                - hnd            =    The CHRTR2 file handle
+
+ - Returns:
+                - CHRTR2_SUCCESS
+
+ - Caveats:     You would normally let chrtr2_close_file handle this.
+
+*********************************************************************************************/
+
+CHRTR2_DLL NV_INT32 chrtr2_close_cache (NV_INT32 hnd)
+{
+  if (chrtr2h[hnd].cache != NULL) free (chrtr2h[hnd].cache);
+  if (chrtr2h[hnd].cache_data != NULL) free (chrtr2h[hnd].cache_data);
+  if (chrtr2h[hnd].cache_hash != NULL) free (chrtr2h[hnd].cache_hash);
+
+  chrtr2h[hnd].cache = NULL;
+  chrtr2h[hnd].cache_data = NULL;
+  chrtr2h[hnd].cache_hash = NULL;
+  chrtr2h[hnd].cache_size = 0;
+
+  return (chrtr2_error.chrtr2 = CHRTR2_SUCCESS);
+}
+
+
+
+/********************************************************************************************/
+/*!
+
+ - Function:    chrtr2_read_window
+
+ - Purpose:     Retrieve a rectangular area of CHRTR2 data from a CHRTR2 file.  The data is
+                read a block at a time (through the block cache if it is open) so each block
+                of the file that overlaps the window is only read once.
+
+ - Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
+
+ - Date:        10/19/26
+
+ - Arguments:
+                - hnd            =    The file handle
+                - start_row      =    First (southernmost) row of the window
+                - start_col      =    First (westernmost) column of the window
+                - rows           =    Number of rows in the window
+                - cols           =    Number of columns in the window
+                - chrtr2_record  =    The returned array of rows * cols CHRTR2 records, stored
+                                      row by row (record[(row - start_row) * cols + (col - start_col)])
+
+ - Returns:
+                - CHRTR2_SUCCESS
+                - CHRTR2_INVALID_ROW_COLUMN
+                - CHRTR2_READ_FSEEK_ERROR
+                - CHRTR2_READ_ERROR
+
+*********************************************************************************************/
+
+CHRTR2_DLL NV_INT32 chrtr2_read_window (NV_INT32 hnd, NV_INT32 start_row, NV_INT32 start_col, NV_INT32 rows, NV_INT32 cols,
+                                        CHRTR2_RECORD *chrtr2_record)
+{
+  NV_U_BYTE *scratch = NULL, *data, *ptr;
+  NV_INT32 i, row, col, end_row, end_col, brow, bcol, row0, row1, col0, col1, bh, bw, offset;
+  CHRTR2_RECORD *out;
+
+
+  /*  Check for window out of bounds.  */
+
+  if (start_row < 0 || start_col < 0 || rows < 1 || cols < 1 || start_row + rows > chrtr2h[hnd].header.height ||
+      start_col + cols > chrtr2h[hnd].header.width)
+    {
+      chrtr2_error.coord.x = start_col;
+      chrtr2_error.coord.y = start_row;
+      chrtr2_error.length = cols;
+      strcpy (chrtr2_error.file, chrtr2h[hnd].path);
+      return (chrtr2_error.chrtr2 = CHRTR2_INVALID_ROW_COLUMN);
+    }
+
+
+  /*  Without a cache each row of the window is contiguous in a row ordered file so we just read the rows.  */
+
+  if (chrtr2h[hnd].cache == NULL && !chrtr2h[hnd].tile_size)
+    {
+      for (i = 0 ; i < rows ; i++)
+        {
+          if (chrtr2_read_row (hnd, start_row + i, start_col, cols, &chrtr2_record[(NV_INT64) i * cols])) return (chrtr2_error.chrtr2);
+        }
+
+      return (chrtr2_error.chrtr2 = CHRTR2_SUCCESS);
+    }
+
+
+  if (chrtr2h[hnd].cache == NULL)
+    {
+      scratch = (NV_U_BYTE *) malloc (chrtr2h[hnd].block_bytes);
+      if (scratch == NULL)
+        {
+          perror ("Allocating scratch memory in chrtr2_read_window");
+          exit (-1);
+        }
+    }
+
+
+  bh = chrtr2h[hnd].block_height;
+  bw = chrtr2h[hnd].block_width;
+  end_row = start_row + rows - 1;
+  end_col = start_col + cols - 1;
+
+
+  /*  Unpack the part of each block that overlaps the window.  */
+
+  for (brow = start_row / bh ; brow <= end_row / bh ; brow++)
+    {
+      row0 = MAX (start_row, brow * bh);
+      row1 = MIN (end_row, brow * bh + bh - 1);
+
+      for (bcol = start_col / bw ; bcol <= end_col / bw ; bcol++)
+        {
+          col0 = MAX (start_col, bcol * bw);
+          col1 = MIN (end_col, bcol * bw + bw - 1);
+
+          if ((data = get_block (hnd, brow * chrtr2h[hnd].blocks_wide + bcol, scratch)) == NULL)
+            {
+              if (scratch) free (scratch);
+              return (chrtr2_error.chrtr2);
+            }
+
+          for (row = row0 ; row <= row1 ; row++)
+            {
+              block_id (hnd, row, col0, &offset);
+              ptr = data + offset;
+              out = &chrtr2_record[(NV_INT64) (row - start_row) * cols + (col0 - start_col)];
+
+              for (col = col0 ; col <= col1 ; col++)
+                {
+                  unpack_record (hnd, ptr, out++);
+                  ptr += chrtr2h[hnd].record_size;
+                }
+            }
+        }
+    }
+
+
+  if (scratch) free (scratch);
+
+
+  chrtr2_error.system = 0;
+  return (chrtr2_error.chrtr2 = CHRTR2_SUCCESS);
+}
+
+
+
 /********************************************************************************************/
 /*!
 
@@ -318,6 +318,31 @@ extern "C" {
        chrtr2_write_row (NV_INT32 hnd, NV_INT32 row, NV_INT32 start_col, NV_INT32 length, CHRTR2_RECORD *chrtr2_record);
        </pre>
 
+
+       If you're going to be reading arbitrary rectangular areas of a large file (for display or area based checking)
+       you can read the whole window into a row major array of records with a single call:
+
+
+       <pre>
+       chrtr2_read_window (NV_INT32 hnd, NV_INT32 start_row, NV_INT32 start_col, NV_INT32 rows, NV_INT32 cols, CHRTR2_RECORD *chrtr2_record);
+       </pre>
+
+
+       If you are going to hit the same part of the file more than once (or read single records all over the place)
+       you should also open a block cache right after you open the file.  The cache holds packed blocks of records in
+       memory so repeated reads don't have to go back to the disk.  Writes go through the cache to the file:
+
+
+       <pre>
+       chrtr2_open_cache (chrtr2_handle, 64);
+       </pre>
+
+
+       Reading windows from very large files is much faster if the file was created with the tile_size field of
+       the header set (we normally use 256).  In that case the records are stored in square tiles instead of rows
+       so a window only touches the tiles that it overlaps.  All of the read and write functions work the same way
+       on either layout.
+
   */
 
 
@@ -339,6 +364,10 @@ extern "C" {
                    computed using the width, height, lon_grid_size_degrees, and lat_grid_size_degrees.  If you set the
                    max_x and max_y they will still be recomputed so the the size is an EXACT (or as close as you can get
                    in binary representation) multiple of the span times the grid size.
+          - (8)  = Not modifiable after creation.  If this is set the records are stored in square tiles of tile_size
+                   by tile_size cells instead of in rows.  Tiles are stored south to north, west to east and the
+                   partial tiles along the north and east edges are padded to full size.  Use chrtr2_retile to
+                   convert an existing file between layouts.
   */
 
   typedef struct
@@ -391,6 +420,7 @@ extern "C" {
     NV_FLOAT32      max_z1;                       /*!<  Maximum possible MSL/ellipsoid separation value for file (3)  */
     NV_FLOAT32      z1_scale;                     /*!<  Scale to multiply MSL/ellipsoid separation values by (2)(6)  */
     NV_INT32        max_number_of_points;         /*!<  Maximum number of points per bin  (2)(6)  */
+    NV_INT32        tile_size;                    /*!<  Tile size in grid cells, 0 for row ordered storage  (1)(8)  */
   } CHRTR2_HEADER;
 
 
@@ -435,6 +465,10 @@ extern "C" {
   CHRTR2_DLL NV_INT32 chrtr2_read_cov_map (NV_INT32 hnd, NV_I32_COORD2 coord, NV_U_INT16 *status);
   CHRTR2_DLL NV_INT32 chrtr2_read_cov_map_row_col (NV_INT32 hnd, NV_INT32 row, NV_INT32 col, NV_U_INT16 *status);
   CHRTR2_DLL NV_INT32 chrtr2_close_cov_map (NV_INT32 hnd);
+  CHRTR2_DLL NV_INT32 chrtr2_open_cache (NV_INT32 hnd, NV_INT32 megabytes);
+  CHRTR2_DLL NV_INT32 chrtr2_close_cache (NV_INT32 hnd);
+  CHRTR2_DLL NV_INT32 chrtr2_read_window (NV_INT32 hnd, NV_INT32 start_row, NV_INT32 start_col, NV_INT32 rows, NV_INT32 cols,
+                                          CHRTR2_RECORD *chrtr2_record);
   CHRTR2_DLL NV_INT32 chrtr2_get_coord (NV_INT32 hnd, NV_FLOAT64 lat, NV_FLOAT64 lon, NV_I32_COORD2 *coord);
   CHRTR2_DLL NV_INT32 chrtr2_get_lat_lon (NV_INT32 hnd, NV_FLOAT64 *lat, NV_FLOAT64 *lon, NV_I32_COORD2 coord);
   CHRTR2_DLL NV_INT32 chrtr2_get_errno ();
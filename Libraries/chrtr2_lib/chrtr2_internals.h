@@ -73,11 +73,24 @@ extern "C" {
 #define                                COV_MAP_MASK                   0x0f    /*!<  Coverage map mask (4 bits).  */
 #define                                CHRTR2_HEADER_SIZE             65536   /*!<  Default CHRTR2 header size.  */
 #define                                CHRTR2_STATUS_BITS             12      /*!<  Number of status bits.  */
+#define                                CHRTR2_ROW_BLOCK_WIDTH         1024    /*!<  Columns per cache block for row ordered files.  */
 
 
 #undef CHRTR2_DEBUG
 
 
+/*  One block of packed records in the block cache.  For tiled files a block is a tile, for row ordered files
+    a block is a segment of CHRTR2_ROW_BLOCK_WIDTH columns of a single row.  */
+
+  typedef struct
+  {
+    NV_INT32      id;                         /*!<  Block number (block row * blocks_wide + block column), -1 if unused.  */
+    NV_INT32      next;                       /*!<  Next block in the hash chain (-1 for end of chain).  */
+    NV_U_INT32    used;                       /*!<  Access counter value at last use (for LRU replacement).  */
+    NV_U_BYTE     *data;                      /*!<  Packed records.  */
+  } CHRTR2_BLOCK;
+
+
 /*  This is the structure we use to keep track of important formatting data for an open CHRTR2 file.  */
 
   typedef struct
@@ -128,6 +141,27 @@ extern "C" {
     /*!  Optional coverage map.  Created with chrtr2_create_cov_map.  */
 
     NV_U_BYTE        *cov_map;
+
+
+    /*!  Block layout.  Tiled files use tile_size by tile_size blocks, row ordered files use single row blocks.  */
+
+    NV_INT32         tile_size;                  /*!<  Tile size in cells (0 for row ordered files).  */
+    NV_INT32         block_height;               /*!<  Rows per block.  */
+    NV_INT32         block_width;                /*!<  Columns per block.  */
+    NV_INT32         blocks_wide;                /*!<  Number of blocks across the grid.  */
+    NV_INT32         blocks_high;                /*!<  Number of blocks down the grid.  */
+    NV_INT32         block_bytes;                /*!<  Size of a full block in bytes.  */
+
+
+    /*!  Optional block cache.  Created with chrtr2_open_cache.  */
+
+    CHRTR2_BLOCK     *cache;                     /*!<  Cached blocks.  */
+    NV_U_BYTE        *cache_data;                /*!<  Memory for all of the cached blocks.  */
+    NV_INT32         cache_size;                 /*!<  Number of cached blocks.  */
+    NV_INT32         *cache_hash;                /*!<  Hash table of block indices (-1 for empty).  */
+    NV_U_INT32       cache_hash_mask;            /*!<  Hash table size - 1 (size is a power of 2).  */
+    NV_INT32         cache_last;                 /*!<  Index of the most recently used block.  */
+    NV_U_INT32       cache_clock;                /*!<  Access counter.  */
   } INTERNAL_CHRTR2_STRUCT;
 
 
@@ -38,7 +38,7 @@
 
 #ifndef CHRTR2_VERSION
 
-#define     CHRTR2_VERSION "PFM Software - CHRTR2 library V2.00 - 03/31/11"
+#define     CHRTR2_VERSION "PFM Software - CHRTR2 library V2.01 - 10/19/26"
 
 #endif
 
@@ -96,4 +96,15 @@
 
     Added ellipsoid_separation and z00_value optional fields to the record.  This is a major format change.
 
+
+    Version 2.01
+    Jan C. Depner
+    10/19/26
+
+    Added optional tiled storage (tile_size in the header, [TILE SIZE] in the file header).  Files created
+    without a tile size are unchanged.  Tiled files can not be read by older versions of the library.
+    Added chrtr2_open_cache/chrtr2_close_cache (LRU cache of packed blocks so that point and window reads don't
+    hit the disk for every record) and chrtr2_read_window to read a rectangular area a block at a time.
+    Fixed the off by one bounds check in chrtr2_write_row that rejected rows that ended on the last column.
+
 </pre>*/
@@ -61,7 +61,6 @@ static NV_BOOL first = NVTrue;
 /*  These should never be called by an application program so we're defining them here.  */
 
 static NV_INT32 czmil_read_cdx_record (NV_INT32 hnd, NV_INT32 recnum);
-static NV_INT32 czmil_append_cdx_record (NV_INT32 hnd, CZMIL_CDX_Data *record);
 
 
 /*  Insert a bunch of static utility functions that really don't need to live in this file.  */
@@ -1299,12 +1298,144 @@ static NV_INT32 czmil_read_cdx_header (NV_INT32 hnd)
 
 
 
+/********************************************************************************************/
+/*!
+
+ - Function:    czmil_scan_buffer_sizes
+
+ - Purpose:     Scan a CXY or CWF file for the byte address and size of each buffer.  Each buffer
+                starts with its own size so we just hop from one to the next.  The file is read
+                in CDX_REGEN_BLOCK_SIZE blocks so that we aren't doing an fseek and a tiny fread
+                for every record.  This is the thread start routine used by czmil_regen_cdx_file.
+
+ - Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
+
+ - Date:        10/19/26
+
+ - Arguments:
+                - arg            =    Pointer to a CZMIL_CDX_SCAN structure
+
+ - Returns:
+                - NULL (status is returned in the CZMIL_CDX_SCAN structure)
+
+ - Caveats:     The scan stops at the end of the file or at the first buffer that is
+                truncated or has an impossible size.  Everything before that is returned.
+
+*********************************************************************************************/
+
+static void *czmil_scan_buffer_sizes (void *arg)
+{
+  CZMIL_CDX_SCAN *scan = (CZMIL_CDX_SCAN *) arg;
+  NV_U_BYTE *block;
+  NV_INT64 address, block_start, block_end, file_end, read_size;
+  NV_INT32 allocated;
+  NV_U_INT16 size;
+  void *new_ptr;
+
+
+  scan->count = 0;
+  scan->status = CZMIL_SUCCESS;
+  scan->system = 0;
+
+
+  if (fseeko64 (scan->fp, 0LL, SEEK_END) < 0)
+    {
+      scan->system = errno;
+      scan->status = CZMIL_REGEN_CDX_ERROR;
+      return (NULL);
+    }
+
+  file_end = ftello64 (scan->fp);
+
+
+  allocated = CDX_REGEN_INITIAL_RECORDS;
+  block = (NV_U_BYTE *) malloc (CDX_REGEN_BLOCK_SIZE);
+  scan->address = (NV_INT64 *) malloc (allocated * sizeof (NV_INT64));
+  scan->size = (NV_U_INT16 *) malloc (allocated * sizeof (NV_U_INT16));
+
+  if (block == NULL || scan->address == NULL || scan->size == NULL)
+    {
+      scan->system = errno;
+      scan->status = CZMIL_REGEN_CDX_ERROR;
+      if (block) free (block);
+      return (NULL);
+    }
+
+
+  address = block_start = block_end = scan->start;
+
+  while (address < file_end)
+    {
+      /*  If the size of the next buffer isn't in the block, read the next block starting at the next buffer.  */
+
+      if (address + scan->size_bytes > block_end)
+        {
+          read_size = MIN (CDX_REGEN_BLOCK_SIZE, file_end - address);
+          if (read_size < scan->size_bytes) break;
+
+          if (fseeko64 (scan->fp, address, SEEK_SET) < 0 || !fread (block, read_size, 1, scan->fp))
+            {
+              scan->system = errno;
+              scan->status = CZMIL_REGEN_CDX_ERROR;
+              break;
+            }
+
+          block_start = address;
+          block_end = address + read_size;
+        }
+
+
+      size = czmil_bit_unpack (&block[address - block_start], 0, scan->size_bytes * 8);
+
+      if (size <= scan->size_bytes || address + size > file_end) break;
+
+
+      if (scan->count == allocated)
+        {
+          allocated *= 2;
+
+          new_ptr = realloc (scan->address, allocated * sizeof (NV_INT64));
+          if (new_ptr == NULL)
+            {
+              scan->system = errno;
+              scan->status = CZMIL_REGEN_CDX_ERROR;
+              break;
+            }
+          scan->address = (NV_INT64 *) new_ptr;
+
+          new_ptr = realloc (scan->size, allocated * sizeof (NV_U_INT16));
+          if (new_ptr == NULL)
+            {
+              scan->system = errno;
+              scan->status = CZMIL_REGEN_CDX_ERROR;
+              break;
+            }
+          scan->size = (NV_U_INT16 *) new_ptr;
+        }
+
+
+      scan->address[scan->count] = address;
+      scan->size[scan->count] = size;
+      scan->count++;
+
+      address += size;
+    }
+
+
+  free (block);
+
+  return (NULL);
+}
+
+
+
 /********************************************************************************************/
 /*!
 
  - Function:    czmil_regen_cdx_file
 
- - Purpose:     Regenerate a missing CZMIL CDX index file from the associated CXY and CWF files.
+ - Purpose:     Regenerate a missing (or out of date) CZMIL CDX index file from the associated CXY
+                and CWF files.
 
  - Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
 
@@ -1315,24 +1446,32 @@ static NV_INT32 czmil_read_cdx_header (NV_INT32 hnd)
 
  - Returns:
                 - CZMIL_SUCCESS
-                - CZMIL_CXY_HEADER_WRITE_FSEEK_ERROR
-                - CZMIL_CXY_HEADER_WRITE_ERROR
+                - CZMIL_CREATE_CDX_ERROR
+                - CZMIL_REGEN_CDX_ERROR
+                - CZMIL_CDX_WRITE_FSEEK_ERROR
+                - CZMIL_CDX_WRITE_ERROR
+                - CZMIL_CDX_HEADER_WRITE_FSEEK_ERROR
+                - CZMIL_CDX_HEADER_WRITE_ERROR
 
- - Caveats:     This function is mostly just a placeholder for now.  We're regenerating the
-                CDX file by reading through the CXY and CWF files and using the buffer sizes
-                to find the location of the next record.
+ - Caveats:     We're regenerating the CDX file by reading through the CXY and CWF files and
+                using the buffer sizes to find the location of the next record.  The CXY and
+                CWF files are scanned at the same time (on separate threads except on Windows)
+                in large blocks and the CDX records are then packed and written in large
+                blocks.  If the CXY and CWF files end with a partial record (or don't have the
+                same number of records) we only index the records that are complete in both
+                files.
 
 *********************************************************************************************/
 
 static NV_INT32 czmil_regen_cdx_file (NV_INT32 hnd)
 {
-  NV_INT32            i;
-  NV_U_INT16          buffer_size;
-
-
-  /*  Position the cxy file to the start of the data.  */
-
-  fseeko64 (czmilh[hnd].cxy_fp, czmilh[hnd].cxy_header.header_size, SEEK_SET);
+  NV_INT32            i, j, bpos, count, num_scans;
+  NV_U_BYTE           *buffer;
+  CZMIL_CDX_SCAN      scan[2];
+#ifndef NVWIN3X
+  pthread_t           thread;
+  NV_BOOL             threaded;
+#endif
 
 
   /*  If the associated CWF file was not opened we're going to force an open anyway (unless it doesn't exist).  */
@@ -1356,7 +1495,9 @@ static NV_INT32 czmil_regen_cdx_file (NV_INT32 hnd)
     }
 
 
-  /*  Try to open the CDX file.  The name was created when we first tried to open it.  */
+  /*  Create the CDX file.  The name was created when we first tried to open it.  */
+
+  if (czmilh[hnd].cdx_fp != NULL) fclose (czmilh[hnd].cdx_fp);
 
   if ((czmilh[hnd].cdx_fp = fopen64 (czmilh[hnd].cdx_path, "wb+")) == NULL)
     {
@@ -1388,7 +1529,7 @@ static NV_INT32 czmil_regen_cdx_file (NV_INT32 hnd)
   /*  These are identical fields from the CXY header.  */
 
   strcpy (czmilh[hnd].cdx_header.creation_software, czmilh[hnd].cxy_header.creation_software);
-  czmilh[hnd].cdx_header.number_of_records = czmilh[hnd].cxy_header.number_of_records;
+  czmilh[hnd].cdx_header.number_of_records = 0;
   czmilh[hnd].cdx_header.header_size = CZMIL_CDX_HEADER_SIZE;
   strcpy (czmilh[hnd].cdx_header.project, czmilh[hnd].cxy_header.project);
   strcpy (czmilh[hnd].cdx_header.mission, czmilh[hnd].cxy_header.mission);
@@ -1403,32 +1544,133 @@ static NV_INT32 czmil_regen_cdx_file (NV_INT32 hnd)
   if (czmil_write_cdx_header (hnd) < 0) return (czmil_error.czmil);
 
 
-  /*  Loop through the CXY file and the CWF file (if available) and regenerate the CDX file.  */
+  /*  Scan the CXY file and the CWF file (if available) for the buffer addresses and sizes.  */
+
+  memset (scan, 0, sizeof (scan));
 
-  for (i = 0 ; i < czmilh[hnd].cxy_header.number_of_records ; i++)
+  scan[0].fp = czmilh[hnd].cxy_fp;
+  scan[0].size_bytes = czmilh[hnd].cxy_buffer_size_bytes;
+  scan[0].start = czmilh[hnd].cxy_header.header_size;
+  num_scans = 1;
+
+  if (czmilh[hnd].cwf_fp != NULL)
     {
-      czmilh[hnd].cdx_record.cxy_address = ftello64 (czmilh[hnd].cxy_fp);
-      fread (&buffer_size, czmilh[hnd].cxy_buffer_size_bytes, 1, czmilh[hnd].cxy_fp);
-      fseeko64 (czmilh[hnd].cxy_fp, czmilh[hnd].cdx_record.cxy_address + (NV_INT64) buffer_size, SEEK_SET);
+      scan[1].fp = czmilh[hnd].cwf_fp;
+      scan[1].size_bytes = czmilh[hnd].cwf_buffer_size_bytes;
+      scan[1].start = czmilh[hnd].cwf_header.header_size;
+      num_scans = 2;
+    }
 
-      czmilh[hnd].cdx_record.cxy_buffer_size = buffer_size;
 
-      czmilh[hnd].cdx_record.cwf_address = czmilh[hnd].cdx_record.cwf_buffer_size = 0;
-      if (czmilh[hnd].cwf_fp != NULL)
+  /*  Scan the CWF file on a separate thread while we scan the CXY file here.  */
+
+#ifdef NVWIN3X
+  for (i = 0 ; i < num_scans ; i++) czmil_scan_buffer_sizes (&scan[i]);
+#else
+  threaded = NVFalse;
+  if (num_scans == 2)
+    {
+      if (pthread_create (&thread, NULL, czmil_scan_buffer_sizes, &scan[1]))
+        {
+          czmil_scan_buffer_sizes (&scan[1]);
+        }
+      else
         {
-          czmilh[hnd].cdx_record.cwf_address = ftello64 (czmilh[hnd].cwf_fp);
-          fread (&buffer_size, czmilh[hnd].cwf_buffer_size_bytes, 1, czmilh[hnd].cwf_fp);
-          fseeko64 (czmilh[hnd].cwf_fp, czmilh[hnd].cdx_record.cwf_address + (NV_INT64) buffer_size, SEEK_SET);
-          czmilh[hnd].cdx_record.cwf_buffer_size = buffer_size;
+          threaded = NVTrue;
         }
+    }
+
+  czmil_scan_buffer_sizes (&scan[0]);
+
+  if (threaded) pthread_join (thread, NULL);
+#endif
+
+
+  count = scan[0].count;
+  if (num_scans == 2 && scan[1].count < count) count = scan[1].count;
 
-      czmil_append_cdx_record (hnd, &czmilh[hnd].cdx_record);
+
+  czmil_error.system = 0;
+  czmil_error.czmil = CZMIL_SUCCESS;
+
+  for (i = 0 ; i < num_scans ; i++)
+    {
+      if (scan[i].status != CZMIL_SUCCESS)
+        {
+          czmil_error.system = scan[i].system;
+          strcpy (czmil_error.file, i ? czmilh[hnd].cwf_path : czmilh[hnd].cxy_path);
+          czmil_error.czmil = CZMIL_REGEN_CDX_ERROR;
+        }
+    }
+
+
+  /*  Pack the CDX records and write them out a block at a time.  */
+
+  buffer = NULL;
+
+  if (count && czmil_error.czmil == CZMIL_SUCCESS)
+    {
+      buffer = (NV_U_BYTE *) calloc (CDX_REGEN_BLOCK_RECORDS, czmilh[hnd].cdx_record_size_bytes);
+
+      if (buffer == NULL)
+        {
+          czmil_error.system = errno;
+          strcpy (czmil_error.file, czmilh[hnd].cdx_path);
+          czmil_error.czmil = CZMIL_REGEN_CDX_ERROR;
+        }
+      else if (fseeko64 (czmilh[hnd].cdx_fp, (NV_INT64) czmilh[hnd].cdx_header.header_size, SEEK_SET) < 0)
+        {
+          czmil_error.system = errno;
+          strcpy (czmil_error.file, czmilh[hnd].cdx_path);
+          czmil_error.czmil = CZMIL_CDX_WRITE_FSEEK_ERROR;
+        }
+      else
+        {
+          for (i = 0 ; i < count ; i += CDX_REGEN_BLOCK_RECORDS)
+            {
+              bpos = 0;
+              for (j = i ; j < count && j < i + CDX_REGEN_BLOCK_RECORDS ; j++)
+                {
+                  czmil_double_bit_pack (buffer, bpos, czmilh[hnd].cdx_cxy_address_bits, scan[0].address[j]);
+                  bpos += czmilh[hnd].cdx_cxy_address_bits;
+                  czmil_double_bit_pack (buffer, bpos, czmilh[hnd].cdx_cwf_address_bits,
+                                         num_scans == 2 ? scan[1].address[j] : 0);
+                  bpos += czmilh[hnd].cdx_cwf_address_bits;
+                  czmil_bit_pack (buffer, bpos, czmilh[hnd].cdx_cxy_buffer_size_bits, scan[0].size[j]);
+                  bpos += czmilh[hnd].cdx_cxy_buffer_size_bits;
+                  czmil_bit_pack (buffer, bpos, czmilh[hnd].cdx_cwf_buffer_size_bits,
+                                  num_scans == 2 ? scan[1].size[j] : 0);
+                  bpos += czmilh[hnd].cdx_cwf_buffer_size_bits;
+                }
+
+              if (!fwrite (buffer, bpos / 8, 1, czmilh[hnd].cdx_fp))
+                {
+                  czmil_error.system = errno;
+                  strcpy (czmil_error.file, czmilh[hnd].cdx_path);
+                  czmil_error.czmil = CZMIL_CDX_WRITE_ERROR;
+                  break;
+                }
+            }
+        }
     }
 
 
   /*  Now update the header since we have to get the correct record count in there.  */
 
-  czmil_write_cdx_header (hnd);
+  if (czmil_error.czmil == CZMIL_SUCCESS)
+    {
+      czmilh[hnd].cdx_header.number_of_records = count;
+      czmil_write_cdx_header (hnd);
+    }
+
+
+  for (i = 0 ; i < num_scans ; i++)
+    {
+      if (scan[i].address) free (scan[i].address);
+      if (scan[i].size) free (scan[i].size);
+    }
+
+  if (buffer) free (buffer);
 
 
   /*  Seek to the end of the header.  */
@@ -1440,16 +1682,16 @@ static NV_INT32 czmil_regen_cdx_file (NV_INT32 hnd)
 
   czmilh[hnd].cxy_pos = czmilh[hnd].cxy_header.header_size;
   czmilh[hnd].cxy_write = NVFalse;
-  if (czmilh[hnd].cwf_fp != NULL) 
+  if (czmilh[hnd].cwf_fp != NULL)
     {
       czmilh[hnd].cwf_pos = czmilh[hnd].cwf_header.header_size;
       czmilh[hnd].cwf_write = NVFalse;
     }
   czmilh[hnd].cdx_pos = czmilh[hnd].cdx_header.header_size;
   czmilh[hnd].cdx_write = NVFalse;
+  czmilh[hnd].cdx_at_end = NVFalse;
 
-  czmil_error.system = 0;
-  return (czmil_error.czmil = CZMIL_SUCCESS);
+  return (czmil_error.czmil);
 }
 
 
@@ -4361,9 +4603,19 @@ static NV_INT32 czmil_read_cdx_record (NV_INT32 hnd, NV_INT32 recnum)
     (NV_INT64) czmilh[hnd].cdx_header.header_size;
 
 
+  /*  If this is the record we just read we don't need to read it again since it is in czmilh[hnd].cdx_record.  This
+      happens when we read the CXY and CWF records for the same shot.  */
+
+  if (!czmilh[hnd].cdx_write && czmilh[hnd].cdx_pos >= 0 &&
+      pos == czmilh[hnd].cdx_pos - (NV_INT64) czmilh[hnd].cdx_record_size_bytes)
+    {
+      czmil_error.system = 0;
+      return (czmil_error.czmil = CZMIL_SUCCESS);
+    }
+
+
   /*  We only want to do the fseek (which flushes the buffer) if our last operation was a write or if we aren't in the
-      correct position.  We also don't need to read the record since it is in czmilh[hnd].cdx_record so, at this
-      point we'll just return.  */
+      correct position.  */
 
   if (czmilh[hnd].cdx_write || pos != czmilh[hnd].cdx_pos)
     {
@@ -4374,125 +4626,37 @@ static NV_INT32 czmil_read_cdx_record (NV_INT32 hnd, NV_INT32 recnum)
           strcpy (czmil_error.file, czmilh[hnd].cdx_path);
           return (czmil_error.czmil = CZMIL_CDX_READ_FSEEK_ERROR);
         }
-
-
-      /*  Read the record.  */
-
-      if (!fread (buffer, czmilh[hnd].cdx_record_size_bytes, 1, czmilh[hnd].cdx_fp))
-        {
-          czmil_error.system = errno;
-          czmil_error.recnum = recnum;
-          strcpy (czmil_error.file, czmilh[hnd].cdx_path);
-          return (czmil_error.czmil = CZMIL_CDX_READ_ERROR);
-        }
-
-
-      /*  Unpack the CXY address, the CWF address, the CXY buffer size, and the CWF buffer size.  */
-
-      bpos = 0;
-      czmilh[hnd].cdx_record.cxy_address = czmil_bit_unpack (buffer, bpos, czmilh[hnd].cdx_cxy_address_bits);
-      bpos += czmilh[hnd].cdx_cxy_address_bits;
-      czmilh[hnd].cdx_record.cwf_address = czmil_bit_unpack (buffer, bpos, czmilh[hnd].cdx_cwf_address_bits);
-      bpos += czmilh[hnd].cdx_cwf_address_bits;
-      czmilh[hnd].cdx_record.cxy_buffer_size = czmil_bit_unpack (buffer, bpos, czmilh[hnd].cdx_cxy_buffer_size_bits) / 8;
-      bpos += czmilh[hnd].cdx_cxy_buffer_size_bits;
-      czmilh[hnd].cdx_record.cwf_buffer_size = czmil_bit_unpack (buffer, bpos, czmilh[hnd].cdx_cwf_buffer_size_bits) / 8;
-      bpos += czmilh[hnd].cdx_cwf_buffer_size_bits;
-
-  
-      czmilh[hnd].cdx_pos += czmilh[hnd].cdx_record_size_bytes;
-      czmilh[hnd].cdx_at_end = NVFalse;
-      czmilh[hnd].cdx_write = NVFalse;
     }
 
-  czmil_error.system = 0;
-  return (czmil_error.czmil = CZMIL_SUCCESS);
-}
-
 
+  /*  Read the record.  */
 
-/********************************************************************************************/
-/*!
-
- - Function:    czmil_append_cdx_record
-
- - Purpose:     Append or update a CZMIL CDX record.
-
- - Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
-
- - Date:        07/20/11
-
- - Arguments:
-                - hnd            =    The file handle
-                - record         =    The CZMIL CDX record
-
- - Returns:
-                - CZMIL_SUCCESS
-                - CZMIL_INVALID_RECORD_NUMBER
-                - CZMIL_CDX_WRITE_FSEEK_ERROR
-                - CZMIL_CDX_WRITE_ERROR
-
- - Caveats:     This function is ONLY used to append a new record to a newly created file.
-                There is no reason to change CXY or CWF addresses after the file has been
-                created.
-
-*********************************************************************************************/
-
-static NV_INT32 czmil_append_cdx_record (NV_INT32 hnd, CZMIL_CDX_Data *record)
-{
-  NV_INT32 bpos;
-  NV_U_BYTE buffer[sizeof (CZMIL_CDX_Data) + 16];
-
-
-  /*  Appending a record is only allowed if you are creating a new file.  */
-
-  if (!czmilh[hnd].cdx_created)
+  if (!fread (buffer, czmilh[hnd].cdx_record_size_bytes, 1, czmilh[hnd].cdx_fp))
     {
+      czmilh[hnd].cdx_pos = -1;
+      czmil_error.system = errno;
+      czmil_error.recnum = recnum;
       strcpy (czmil_error.file, czmilh[hnd].cdx_path);
-      return (czmil_error.czmil = CZMIL_CDX_APPEND_ERROR);
-    }
-
-
-  /*  No need to seek if we're already at the end.  */
-
-  if (!czmilh[hnd].cdx_at_end)
-    {
-      if (fseeko64 (czmilh[hnd].cdx_fp, 0, SEEK_END) < 0)
-        {
-          czmil_error.system = errno;
-          strcpy (czmil_error.file, czmilh[hnd].cdx_path);
-          return (czmil_error.czmil = CZMIL_CDX_WRITE_FSEEK_ERROR);
-        }
+      return (czmil_error.czmil = CZMIL_CDX_READ_ERROR);
     }
 
-  czmilh[hnd].cdx_at_end = NVTrue;
 
-
-  /*  Pack the CXY address, the CWF address, the CXY buffer size, and the CWF record size into the buffer.  */
+  /*  Unpack the CXY address, the CWF address, the CXY buffer size, and the CWF buffer size.  */
 
   bpos = 0;
-  czmil_bit_pack (buffer, bpos, czmilh[hnd].cdx_cxy_address_bits, record->cxy_address);
+  czmilh[hnd].cdx_record.cxy_address = czmil_double_bit_unpack (buffer, bpos, czmilh[hnd].cdx_cxy_address_bits);
   bpos += czmilh[hnd].cdx_cxy_address_bits;
-  czmil_bit_pack (buffer, bpos, czmilh[hnd].cdx_cwf_address_bits, record->cwf_address);
+  czmilh[hnd].cdx_record.cwf_address = czmil_double_bit_unpack (buffer, bpos, czmilh[hnd].cdx_cwf_address_bits);
   bpos += czmilh[hnd].cdx_cwf_address_bits;
-  czmil_bit_pack (buffer, bpos, czmilh[hnd].cdx_cxy_buffer_size_bits, record->cxy_buffer_size);
+  czmilh[hnd].cdx_record.cxy_buffer_size = czmil_bit_unpack (buffer, bpos, czmilh[hnd].cdx_cxy_buffer_size_bits);
   bpos += czmilh[hnd].cdx_cxy_buffer_size_bits;
-  czmil_bit_pack (buffer, bpos, czmilh[hnd].cdx_cwf_buffer_size_bits, record->cwf_buffer_size);
+  czmilh[hnd].cdx_record.cwf_buffer_size = czmil_bit_unpack (buffer, bpos, czmilh[hnd].cdx_cwf_buffer_size_bits);
   bpos += czmilh[hnd].cdx_cwf_buffer_size_bits;
 
 
-  /*  Write the record.  */
-
-  if (!fwrite (buffer, czmilh[hnd].cdx_record_size_bytes, 1, czmilh[hnd].cdx_fp))
-    {
-      czmil_error.system = errno;
-      strcpy (czmil_error.file, czmilh[hnd].cdx_path);
-      return (czmil_error.czmil = CZMIL_CDX_WRITE_ERROR);
-    }
-
-
-  czmilh[hnd].cdx_pos += czmilh[hnd].cdx_record_size_bytes;
-  czmilh[hnd].cdx_write = NVTrue;
+  czmilh[hnd].cdx_pos = pos + czmilh[hnd].cdx_record_size_bytes;
+  czmilh[hnd].cdx_at_end = NVFalse;
+  czmilh[hnd].cdx_write = NVFalse;
 
   czmil_error.system = 0;
   return (czmil_error.czmil = CZMIL_SUCCESS);
@@ -4880,6 +5044,7 @@ CZMIL_DLL NV_CHAR *czmil_strerror ()
       sprintf (message, _("File : %s\nRecord : %d\nBuffer sizes from the CDX and CWF files do not match.\n"),
                czmil_error.file, czmil_error.recnum);
       break;
+
     }
 
   return (message);
@@ -39,6 +39,10 @@
 #ifndef __CZMIL_INTERNALS_H__
 #define __CZMIL_INTERNALS_H__
 
+#ifndef NVWIN3X
+  #include <pthread.h>
+#endif
+
 #ifdef  __cplusplus
 extern "C" {
 #endif
@@ -145,6 +149,13 @@ extern "C" {
 #define CDX_CWF_BUFFER_SIZE_BITS  CWF_BUFFER_SIZE_BYTES * 8
 
 
+/*  These are used by czmil_regen_cdx_file.  */
+
+#define CDX_REGEN_BLOCK_SIZE      4194304       /*!<  Size of the blocks read from the CXY and CWF files while scanning.  */
+#define CDX_REGEN_BLOCK_RECORDS   16384         /*!<  Number of CDX records packed and written at a time.  */
+#define CDX_REGEN_INITIAL_RECORDS 65536         /*!<  Initial size of the scan address/size arrays (doubled as needed).  */
+
+
 /*!  This is a flag that is used to signify that we are packing/unpacking full longitude instead of longitude difference
      from a reference point.  */
 
@@ -293,6 +304,22 @@ typedef struct
 } INTERNAL_CZMIL_STRUCT;
 
 
+/*  Buffer address/size scan of a CXY or CWF file used by czmil_regen_cdx_file.  */
+
+typedef struct
+{
+  FILE              *fp;                        /*!<  CXY or CWF file pointer.  */
+  NV_U_INT16        size_bytes;                 /*!<  Number of bytes used to store the buffer size at the start of each
+                                                      buffer.  */
+  NV_INT64          start;                      /*!<  Byte address at which to start scanning.  */
+  NV_INT64          *address;                   /*!<  Byte address of each buffer found.  */
+  NV_U_INT16        *size;                      /*!<  Size of each buffer found.  */
+  NV_INT32          count;                      /*!<  Number of buffers found.  */
+  NV_INT32          status;                     /*!<  CZMIL_SUCCESS or CZMIL_REGEN_CDX_ERROR.  */
+  NV_INT32          system;                     /*!<  System error (errno) if status is CZMIL_REGEN_CDX_ERROR.  */
+} CZMIL_CDX_SCAN;
+
+
 /*  CZMIL error handling variables.  */
 
 typedef struct 
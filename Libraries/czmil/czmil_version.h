@@ -38,7 +38,7 @@
 
 #ifndef CZMIL_VERSION
 
-#define     CZMIL_VERSION     "PFM Software - CZMIL library V0.01 - 07/20/11"
+#define     CZMIL_VERSION     "PFM Software - CZMIL library V0.02 - 10/19/26"
 
 #endif
 
@@ -51,4 +51,13 @@
 
     First alpha version.
 
+
+    Version 0.02
+    10/19/26
+    Jan Depner
+
+    czmil_regen_cdx_file now scans the CXY and CWF files at the same time in large blocks and writes the CDX records
+    in large blocks.  CDX addresses are now packed/unpacked as 64 bit values and CDX buffer sizes are no longer
+    divided by 8 on read.  Fixed czmil_read_cdx_record returning the previous record on sequential reads.
+
 </pre>*/
@@ -60,6 +60,259 @@ static NV_BOOL update_header = NVFalse;
 static NV_BOOL opened = NVFalse;
 
 
+/*  In memory copy of the file list at the end of the PFMWDB.map file.  Each entry keeps the position of its line in
+    the file so that marking a file only has to rewrite the flags.  The entries are chained in hash buckets by file
+    name so we don't have to scan the whole list (which can run to hundreds of thousands of files) for each lookup.  */
+
+typedef struct
+{
+  NV_CHAR         dflag;                        /*  '+' or '-' (deleted)  */
+  NV_INT16        type;
+  NV_INT16        security;
+  NV_INT16        datum;
+  NV_CHAR         *name;
+  NV_INT32        pos;                          /*  Byte position of the entry in the PFMWDB.map file  */
+  NV_INT32        next;                         /*  Next entry in the hash bucket (-1 for none)  */
+} FILE_ENTRY;
+
+static FILE_ENTRY *file_table = NULL;
+static NV_INT32 file_count = 0, file_table_size = 0;
+static NV_INT32 *file_hash = NULL;
+static NV_INT32 file_hash_size = 0;
+static NV_BOOL file_table_loaded = NVFalse;
+
+
+
+/*  FNV-1a hash of the file name.  */
+
+static NV_U_INT32 hash_name (const NV_CHAR *name)
+{
+  NV_U_INT32 hash = 2166136261U;
+
+  while (*name)
+    {
+      hash ^= (NV_U_BYTE) *name++;
+      hash *= 16777619U;
+    }
+
+  return (hash);
+}
+
+
+
+/*  Free the in memory file table.  */
+
+static void free_file_table ()
+{
+  NV_INT32 i;
+
+  for (i = 0 ; i < file_count ; i++) free (file_table[i].name);
+
+  free (file_table);
+  free (file_hash);
+
+  file_table = NULL;
+  file_hash = NULL;
+  file_count = file_table_size = file_hash_size = 0;
+  file_table_loaded = NVFalse;
+}
+
+
+
+/*  Find a file name in the table.  Returns the entry number or -1 if it isn't there.  */
+
+static NV_INT32 find_entry (const NV_CHAR *name)
+{
+  NV_INT32 i;
+
+  if (!file_hash_size) return (-1);
+
+  for (i = file_hash[hash_name (name) & (file_hash_size - 1)] ; i >= 0 ; i = file_table[i].next)
+    {
+      if (!strcmp (file_table[i].name, name)) return (i);
+    }
+
+  return (-1);
+}
+
+
+
+/*  Rebuild the hash buckets, doubling the number of buckets until there are at least two for every file.  Duplicate
+    names are only linked the first time they are seen so that a lookup finds the same entry that a scan of the list
+    would.  */
+
+static NV_BOOL rehash_file_table ()
+{
+  NV_INT32 i, bucket, size = 1024;
+
+  while (size < file_count * 2) size *= 2;
+
+  if (size != file_hash_size)
+    {
+      free (file_hash);
+
+      if ((file_hash = (NV_INT32 *) malloc (size * sizeof (NV_INT32))) == NULL)
+        {
+          perror ("Allocating file hash table in pfmWDB library");
+          file_hash_size = 0;
+          return (NVFalse);
+        }
+
+      file_hash_size = size;
+    }
+
+  for (i = 0 ; i < file_hash_size ; i++) file_hash[i] = -1;
+
+  for (i = 0 ; i < file_count ; i++)
+    {
+      file_table[i].next = -1;
+
+      if (find_entry (file_table[i].name) < 0)
+        {
+          bucket = hash_name (file_table[i].name) & (file_hash_size - 1);
+          file_table[i].next = file_hash[bucket];
+          file_hash[bucket] = i;
+        }
+    }
+
+  return (NVTrue);
+}
+
+
+
+/*  Add an entry to the end of the file table.  */
+
+static NV_BOOL add_entry (NV_CHAR dflag, NV_INT16 type, NV_INT16 security, NV_INT16 datum, const NV_CHAR *name, NV_INT32 pos)
+{
+  NV_INT32 bucket;
+
+
+  if (file_count == file_table_size)
+    {
+      FILE_ENTRY *new_table;
+      NV_INT32 new_size = file_table_size ? file_table_size * 2 : 1024;
+
+      if ((new_table = (FILE_ENTRY *) realloc (file_table, new_size * sizeof (FILE_ENTRY))) == NULL)
+        {
+          perror ("Allocating file table in pfmWDB library");
+          return (NVFalse);
+        }
+
+      file_table = new_table;
+      file_table_size = new_size;
+    }
+
+
+  if ((file_table[file_count].name = (NV_CHAR *) malloc (strlen (name) + 1)) == NULL)
+    {
+      perror ("Allocating file name in pfmWDB library");
+      return (NVFalse);
+    }
+
+  strcpy (file_table[file_count].name, name);
+  file_table[file_count].dflag = dflag;
+  file_table[file_count].type = type;
+  file_table[file_count].security = security;
+  file_table[file_count].datum = datum;
+  file_table[file_count].pos = pos;
+  file_table[file_count].next = -1;
+
+
+  if (file_count >= file_hash_size / 2)
+    {
+      file_count++;
+      return (rehash_file_table ());
+    }
+
+
+  if (find_entry (name) < 0)
+    {
+      bucket = hash_name (name) & (file_hash_size - 1);
+      file_table[file_count].next = file_hash[bucket];
+      file_hash[bucket] = file_count;
+    }
+
+  file_count++;
+
+  return (NVTrue);
+}
+
+
+
+/*  Read the file list from the PFMWDB.map file into the file table (if we haven't already done so).  */
+
+static NV_BOOL load_file_table ()
+{
+  NV_CHAR string[1024], filename[512], dflag;
+  NV_INT16 type, security, datum;
+  NV_INT32 i, pos;
+
+
+  if (file_table_loaded) return (NVTrue);
+
+  free_file_table ();
+
+  if (!rehash_file_table ()) return (NVFalse);
+
+
+  fseek (fp, l_header.header_size + 64800 * record_size, SEEK_SET);
+
+  for (i = 0 ; i < l_header.files ; i++)
+    {
+      pos = ftell (fp);
+      if (ngets (string, 512, fp) == NULL) break;
+
+      sscanf (string, "%1c %hd %hd %hd %s", &dflag, &type, &security, &datum, filename);
+
+      if (!add_entry (dflag, type, security, datum, filename, pos))
+        {
+          free_file_table ();
+          return (NVFalse);
+        }
+    }
+
+  file_table_loaded = NVTrue;
+
+  return (NVTrue);
+}
+
+
+
+/*  Unpack a PFMWDB.map record buffer.  */
+
+static void unpack_record (NV_U_BYTE *buffer, PFMWDBMAP_RECORD *record)
+{
+  NV_INT32 status;
+
+  status = bit_unpack (buffer, status_pos, l_header.status_bits);
+  record->P = (NV_BOOL) ((status & PFMWDB_P_MASK) > PFMWDB_P_SHIFT);
+  record->U = (NV_BOOL) ((status & PFMWDB_U_MASK) > PFMWDB_U_SHIFT);
+  record->C = (NV_BOOL) ((status & PFMWDB_C_MASK) > PFMWDB_C_SHIFT);
+  record->S = (NV_BOOL) ((status & PFMWDB_S_MASK) > PFMWDB_S_SHIFT);
+  record->checked = (NV_BOOL) ((status & PFMWDB_CHECKED_MASK) > PFMWDB_CHECKED_SHIFT);
+  record->verified = (NV_BOOL) ((status & PFMWDB_VERIFIED_MASK) > PFMWDB_VERIFIED_SHIFT);
+  record->deleted = (NV_BOOL) ((status & PFMWDB_DELETED_MASK) > PFMWDB_DELETED_SHIFT);
+
+  record->records = double_bit_unpack (buffer, records_pos, l_header.records_bits);
+}
+
+
+
+/*  Strip /PFMWDB:: from the front of a file name if it's there.  */
+
+static void strip_name (const NV_CHAR *filename, NV_CHAR *name)
+{
+  if (strstr (filename, "PFMWDB::"))
+    {
+      strcpy (name, &filename[9]);
+    }
+  else
+    {
+      strcpy (name, filename);
+    }
+}
+
+
 /*********************************************************************************************/
 /*!
 
@@ -234,7 +487,10 @@ void PFMWDBMAP_close ()
 
   opened = NVFalse;
 
+  free_file_table ();
+
   fclose (fp);
+  fp = NULL;
 }
 
 
@@ -356,6 +612,12 @@ NV_BOOL PFMWDBMAP_write_header (PFMWDBMAP_HEADER *header)
       fseek (fp, header->header_size, SEEK_SET);
 
       for (i = 0 ; i < size ; i++) fwrite (&zero, 1, 1, fp);
+
+
+      /*  No files yet.  */
+
+      free_file_table ();
+      file_table_loaded = rehash_file_table ();
     }
 
 
@@ -427,7 +689,7 @@ PFMWDBMAP_RECORD PFMWDBMAP_read_record (NV_INT32 lat, NV_INT32 lon)
 {
   NV_U_BYTE buffer[1024];
   PFMWDBMAP_RECORD record;
-  NV_INT32 offset, status;
+  NV_INT32 offset;
 
   offset = ((lat + 90) * 360 + (lon + 180)) * record_size + l_header.header_size;
 
@@ -435,22 +697,79 @@ PFMWDBMAP_RECORD PFMWDBMAP_read_record (NV_INT32 lat, NV_INT32 lon)
   fread (buffer, record_size, 1, fp);
 
 
-  status = bit_unpack (buffer, status_pos, l_header.status_bits);
-  record.P = (NV_BOOL) ((status & PFMWDB_P_MASK) > PFMWDB_P_SHIFT);
-  record.U = (NV_BOOL) ((status & PFMWDB_U_MASK) > PFMWDB_U_SHIFT);
-  record.C = (NV_BOOL) ((status & PFMWDB_C_MASK) > PFMWDB_C_SHIFT);
-  record.S = (NV_BOOL) ((status & PFMWDB_S_MASK) > PFMWDB_S_SHIFT);
-  record.checked = (NV_BOOL) ((status & PFMWDB_CHECKED_MASK) > PFMWDB_CHECKED_SHIFT);
-  record.verified = (NV_BOOL) ((status & PFMWDB_VERIFIED_MASK) > PFMWDB_VERIFIED_SHIFT);
-  record.deleted = (NV_BOOL) ((status & PFMWDB_DELETED_MASK) > PFMWDB_DELETED_SHIFT);
-
-  record.records = double_bit_unpack (buffer, records_pos, l_header.records_bits);
+  unpack_record (buffer, &record);
 
   return (record);
 }
 
 
 
+/*********************************************************************************************/
+/*!
+
+   - Module Name:        PFMWDBMAP_read_records
+
+   - Programmer(s):      Jan C. Depner
+
+   - Date Written:       10/19/26
+
+   - Purpose:            Read a rectangular block of PFMWDB.map records.  Each row of cells is
+                         read with a single fread instead of one read per cell.
+
+   - Arguments:
+                         - lat            =  Integer latitude degrees of the southwest cell
+                         - lon            =  Integer longitude degrees of the southwest cell
+                         - rows           =  Number of one-degree rows (north from lat)
+                         - cols           =  Number of one-degree columns (east from lon)
+                         - records        =  PFMWDBMAP_RECORD array (rows * cols) returned.
+                                             Records are stored by row starting at the
+                                             southwest cell.
+
+   - Return Value:
+                         - NV_BOOL        =  NVFalse on error, otherwise NVTrue
+
+   - Caveats:            The block can't cross the 180 degree meridian.  If you need to do
+                         that, read it as two blocks.
+
+**********************************************************************************************/
+
+NV_BOOL PFMWDBMAP_read_records (NV_INT32 lat, NV_INT32 lon, NV_INT32 rows, NV_INT32 cols, PFMWDBMAP_RECORD *records)
+{
+  NV_U_BYTE *buffer;
+  NV_INT32 i, j, offset;
+
+
+  if (fp == NULL || rows < 1 || cols < 1 || lat < -90 || lat + rows > 90 || lon < -180 || lon + cols > 180) return (NVFalse);
+
+
+  if ((buffer = (NV_U_BYTE *) malloc (cols * record_size)) == NULL)
+    {
+      perror ("Allocating record buffer in PFMWDBMAP_read_records");
+      return (NVFalse);
+    }
+
+
+  for (i = 0 ; i < rows ; i++)
+    {
+      offset = ((lat + i + 90) * 360 + (lon + 180)) * record_size + l_header.header_size;
+
+      if (fseek (fp, offset, SEEK_SET) || !fread (buffer, cols * record_size, 1, fp))
+        {
+          free (buffer);
+          return (NVFalse);
+        }
+
+      for (j = 0 ; j < cols ; j++) unpack_record (&buffer[j * record_size], &records[i * cols + j]);
+    }
+
+
+  free (buffer);
+
+  return (NVTrue);
+}
+
+
+
 /*********************************************************************************************/
 /*!
 
@@ -525,6 +844,7 @@ void PFMWDBMAP_write_record (NV_INT32 lat, NV_INT32 lon, PFMWDBMAP_RECORD record
 void PFMWDBMAP_append_file (const NV_CHAR *filename, NV_INT16 type, NV_INT16 security, NV_INT16 datum)
 {
   NV_CHAR name[512];
+  NV_INT32 pos;
 
 
   /*  Strip /PFMWDB:: from name if present.  */
@@ -539,7 +859,13 @@ void PFMWDBMAP_append_file (const NV_CHAR *filename, NV_INT16 type, NV_INT16 sec
     }
 
 
+  /*  Make sure we have the existing list before we add to it.  */
+
+  load_file_table ();
+
+
   fseek (fp, 0, SEEK_END);
+  pos = ftell (fp);
 
 
   /*  Deletion flag (+/-) then the filename.  */
@@ -548,6 +874,9 @@ void PFMWDBMAP_append_file (const NV_CHAR *filename, NV_INT16 type, NV_INT16 sec
   fflush (fp);
 
 
+  if (file_table_loaded && !add_entry ('+', type, security, datum, name, pos)) free_file_table ();
+
+
   l_header.files++;
   update_header = NVTrue;
 }
@@ -580,28 +909,23 @@ void PFMWDBMAP_append_file (const NV_CHAR *filename, NV_INT16 type, NV_INT16 sec
 NV_BOOL PFMWDBMAP_read_file (NV_CHAR *filename, NV_BOOL *deleted, NV_INT16 *type, NV_INT16 *security, NV_INT16 *datum)
 {
   static NV_INT32 num = 0;
-  NV_CHAR string[1024], dflag;
 
 
   /*  If we've hit the end, reset num and return NVFalse.  */
 
-  if (num >= l_header.files)
+  if (num >= l_header.files || !load_file_table () || num >= file_count)
     {
       num = 0;
       return (NVFalse);
     }
 
 
-  /*  Starting over.  */
-
-  if (!num) fseek (fp, l_header.header_size + 64800 * record_size, SEEK_SET);
-
-
-  ngets (string, 512, fp);
-
-  sscanf (string, "%1c %hd %hd %hd %s", &dflag, type, security, datum, filename);
+  strcpy (filename, file_table[num].name);
+  *type = file_table[num].type;
+  *security = file_table[num].security;
+  *datum = file_table[num].datum;
 
-  if (dflag == '+')
+  if (file_table[num].dflag == '+')
     {
       *deleted = NVFalse;
     }
@@ -618,6 +942,58 @@ NV_BOOL PFMWDBMAP_read_file (NV_CHAR *filename, NV_BOOL *deleted, NV_INT16 *type
 
 
 
+/*********************************************************************************************/
+/*!
+
+   - Module Name:        PFMWDBMAP_find_file
+
+   - Programmer(s):      Jan C. Depner
+
+   - Date Written:       10/19/26
+
+   - Purpose:            Looks up a single file in the file list.  The list is read into memory
+                         and indexed by file name the first time it is needed so this doesn't
+                         have to scan the list (use it instead of looping through
+                         PFMWDBMAP_read_file to check for already loaded files).  The filename
+                         may include the "/PFMWDB::" prefix or not.
+
+   - Arguments:
+                         - filename       =  Name of file (not fully qualified)
+                         - deleted        =  NVTrue if file is marked as PFM_DELETED
+                         - type           =  PFM data type of file
+                         - security       =  Security key of file (see security.cfg)
+                         - datum          =  Datum type of file (from PFMWDB/GSF vertical datums)
+
+   - Return Value:
+                         - NV_BOOL        =  NVFalse if the file isn't in the list, otherwise
+                                             NVTrue
+
+**********************************************************************************************/
+
+NV_BOOL PFMWDBMAP_find_file (const NV_CHAR *filename, NV_BOOL *deleted, NV_INT16 *type, NV_INT16 *security, NV_INT16 *datum)
+{
+  NV_CHAR realname[512];
+  NV_INT32 i;
+
+
+  if (!load_file_table ()) return (NVFalse);
+
+
+  strip_name (filename, realname);
+
+  if ((i = find_entry (realname)) < 0) return (NVFalse);
+
+
+  *deleted = (NV_BOOL) (file_table[i].dflag != '+');
+  *type = file_table[i].type;
+  *security = file_table[i].security;
+  *datum = file_table[i].datum;
+
+  return (NVTrue);
+}
+
+
+
 /*********************************************************************************************/
 /*!
 
@@ -643,61 +1019,52 @@ NV_BOOL PFMWDBMAP_read_file (NV_CHAR *filename, NV_BOOL *deleted, NV_INT16 *type
 
 NV_BOOL PFMWDBMAP_mark_file (const NV_CHAR *filename, NV_INT16 idelete, NV_INT16 itype __attribute__ ((unused)), NV_INT16 isecurity, NV_INT16 idatum)
 {
-  NV_CHAR l_filename[512], realname[512], string[1024], dflag;
-  NV_INT16 type, security, datum;
-  NV_INT32 pos = 0, i;
+  NV_CHAR realname[512], dflag;
+  NV_INT16 security, datum;
+  NV_INT32 i;
 
 
-  fseek (fp, l_header.header_size + 64800 * record_size, SEEK_SET);
+  if (!load_file_table ()) return (NVFalse);
 
 
   /*  Strip the "/PFMWDB::" off of the file name if it's there.  */
 
-  if (strstr (filename, "PFMWDB::"))
+  strip_name (filename, realname);
+
+
+  /*  Look up the file and rewrite the flags at its position in the list.  */
+
+  if ((i = find_entry (realname)) < 0) return (NVFalse);
+
+
+  dflag = file_table[i].dflag;
+  security = file_table[i].security;
+  datum = file_table[i].datum;
+
+  if (idelete < 0)
     {
-      sprintf (realname, &filename[9]);
+      dflag = '-';
     }
-  else
+  else if (idelete > 0)
     {
-      strcpy (realname, filename);
+      dflag = '+';
     }
-
-
-  /*  Loop through the list looking for a match.  */
-
-  for (i = 0 ; i < l_header.files ; i++)
+  else if (isecurity >= 0 || idatum)
     {
-      pos = ftell (fp);
-      ngets (string, 512, fp);
+      if (idatum) datum = idatum;
+      if (isecurity >= 0) security = isecurity;
+    }
 
+  fseek (fp, file_table[i].pos, SEEK_SET);
+  fprintf (fp, "%1c %05hd %05hd %05hd", dflag, file_table[i].type, security, datum);
+  fflush (fp);
 
-      sscanf (string, "%1c %hd %hd %hd %s", &dflag, &type, &security, &datum, l_filename);
 
-      if (!strcmp (l_filename, realname))
-        {
-          fseek (fp, pos, SEEK_SET);
-          if (idelete < 0)
-            {
-              dflag = '-';
-            }
-          else if (idelete > 0)
-            {
-              dflag = '+';
-            }
-          else if (isecurity >= 0 || idatum)
-            {
-              if (idatum) datum = idatum;
-              if (isecurity >= 0) security = isecurity;
-            }
-
-          fprintf (fp, "%1c %05hd %05hd %05hd", dflag, type, security, datum);
-          fflush (fp);
-
-          return (NVTrue);
-        }
-    }
+  file_table[i].dflag = dflag;
+  file_table[i].security = security;
+  file_table[i].datum = datum;
 
-  return (NVFalse);
+  return (NVTrue);
 }
 
 
@@ -810,19 +1177,10 @@ NV_BOOL PFMWDBMAP_flag_file (const NV_CHAR *filename, NV_INT16 security, NV_INT1
 
 NV_BOOL PFMWDBMAP_file_cleanup ()
 {
-  NV_CHAR l_filename[512], temp_file[512], string[1024], dflag;
-  NV_INT16 type, security, datum;
   NV_INT32 i, count, stat, fd, pos;
-  FILE *tfp;
 
 
-  sprintf (temp_file, "%s%1ctemp_file", pfmwdb, SEPARATOR);
-
-  if ((tfp = fopen (temp_file, "w+")) == NULL)
-    {
-      perror (temp_file);
-      return (NVFalse);
-    }
+  if (!load_file_table ()) return (NVFalse);
 
 
   /*  Move to where we put the file list.  */
@@ -830,34 +1188,27 @@ NV_BOOL PFMWDBMAP_file_cleanup ()
   fseek (fp, l_header.header_size + 64800 * record_size, SEEK_SET);
 
 
-  /*  Read the non-deleted file names and write them out to the temporary file.  */
+  /*  Write the non-deleted file names back over the list and squeeze the deleted ones out of the file table.  Since
+      we only ever remove entries the list can't overrun anything we haven't written yet.  */
 
   count = 0;
-  while (ngets (string, 1024, fp) != NULL)
+  for (i = 0 ; i < file_count ; i++)
     {
-      sscanf (string, "%1c %hd %hd %hd %s", &dflag, &type, &security, &datum, l_filename);
+      if (file_table[i].dflag == '+')
+        {
+          file_table[i].pos = ftell (fp);
+          fprintf (fp, "+ %05hd %05hd %05hd %s\n", file_table[i].type, file_table[i].security, file_table[i].datum, file_table[i].name);
 
-      if (dflag == '+')
+          file_table[count++] = file_table[i];
+        }
+      else
         {
-          fprintf (tfp, "+ %05hd %05hd %05hd %s\n", type, security, datum, l_filename);
-          count++;
+          free (file_table[i].name);
         }
     }
 
-
-  /*  Rewind the temporary file.  */
-
-  fseek (tfp, 0, SEEK_SET);
-  fseek (fp, l_header.header_size + 64800 * record_size, SEEK_SET);
-
-
-  /*  Read the temporary file list and replace the PFMWDB.map file list.  */
-
-  for (i = 0 ; i < count ; i++)
-    {
-      ngets (string, 1024, tfp);
-      fprintf (fp, "%s\n", string);
-    }
+  file_count = count;
+  rehash_file_table ();
 
 
   /*  Get the position at which to truncate the file.  */
@@ -865,12 +1216,6 @@ NV_BOOL PFMWDBMAP_file_cleanup ()
   pos = ftell (fp);
 
 
-  /*  Close and remove the temporary file.  */
-
-  fclose (tfp);
-  remove (temp_file);
-
-
   /*  Update the file count and write the header.  */
 
   l_header.files = count;
@@ -935,7 +1280,7 @@ NV_BOOL PFMWDBMAP_file_cleanup ()
 void PFMWDBMAP_recompute ()
 {
   NV_INT32 lat, lon;
-  PFMWDBMAP_RECORD record;
+  PFMWDBMAP_RECORD record[360];
 
   l_header.records = 0;
   strcpy (l_header.classification, "");
@@ -943,16 +1288,18 @@ void PFMWDBMAP_recompute ()
   NV_BOOL cls[4] = {0, 0, 0, 0};
   for (lat = -90 ; lat < 90 ; lat++)
     {
-      for (lon = -180 ; lon < 180 ; lon++)
-        {
-          record = PFMWDBMAP_read_record (lat, lon);
+      /*  Read a full row of cells at a time.  */
 
-          l_header.records += record.records;
+      if (!PFMWDBMAP_read_records (lat, -180, 1, 360, record)) continue;
+
+      for (lon = 0 ; lon < 360 ; lon++)
+        {
+          l_header.records += record[lon].records;
 
-          if (record.P) cls[0] = NVTrue;
-          if (record.U) cls[1] = NVTrue;
-          if (record.C) cls[2] = NVTrue;
-          if (record.S) cls[3] = NVTrue;
+          if (record[lon].P) cls[0] = NVTrue;
+          if (record[lon].U) cls[1] = NVTrue;
+          if (record[lon].C) cls[2] = NVTrue;
+          if (record[lon].S) cls[3] = NVTrue;
         }
     }
 
@@ -271,9 +271,11 @@ extern "C" {
   void PFMWDBMAP_close ();
   NV_BOOL PFMWDBMAP_write_header (PFMWDBMAP_HEADER *header);
   PFMWDBMAP_RECORD PFMWDBMAP_read_record (NV_INT32 lat, NV_INT32 lon);
+  NV_BOOL PFMWDBMAP_read_records (NV_INT32 lat, NV_INT32 lon, NV_INT32 rows, NV_INT32 cols, PFMWDBMAP_RECORD *records);
   void PFMWDBMAP_write_record (NV_INT32 lat, NV_INT32 lon, PFMWDBMAP_RECORD record);
   void PFMWDBMAP_append_file (const NV_CHAR *filename, NV_INT16 type, NV_INT16 security, NV_INT16 datum);
   NV_BOOL PFMWDBMAP_read_file (NV_CHAR *filename, NV_BOOL *deleted, NV_INT16 *type, NV_INT16 *security, NV_INT16 *datum);
+  NV_BOOL PFMWDBMAP_find_file (const NV_CHAR *filename, NV_BOOL *deleted, NV_INT16 *type, NV_INT16 *security, NV_INT16 *datum);
   NV_BOOL PFMWDBMAP_mark_file (const NV_CHAR *filename, NV_INT16 idelete, NV_INT16 itype __attribute__ ((unused)), NV_INT16 isecurity, NV_INT16 idatum);
   NV_BOOL PFMWDBMAP_delete_file (const NV_CHAR *filename);
   NV_BOOL PFMWDBMAP_restore_file (const NV_CHAR *filename);
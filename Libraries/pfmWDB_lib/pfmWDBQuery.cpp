@@ -0,0 +1,409 @@
+/*********************************************************************************************
+
+    This is public domain software that was developed by the U.S. Naval Oceanographic Office.
+
+    This is a work of the US Government. In accordance with 17 USC 105, copyright protection
+    is not available for any work of the US Government.
+
+    Neither the United States Government nor any employees of the United States Government,
+    makes any warranty, express or implied, without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, or assumes any liability or
+    responsibility for the accuracy, completeness, or usefulness of any information,
+    apparatus, product, or process disclosed, or represents that its use would not infringe
+    privately-owned rights. Reference herein to any specific commercial products, process,
+    or service by trade name, trademark, manufacturer, or otherwise, does not necessarily
+    constitute or imply its endorsement, recommendation, or favoring by the United States
+    Government. The views and opinions of authors expressed herein do not necessarily state
+    or reflect those of the United States Government, and shall not be used for advertising
+    or product endorsement purposes.
+
+*********************************************************************************************/
+
+
+/****************************************  IMPORTANT NOTE  **********************************
+
+    Comments in this file that start with / * ! or / / ! are being used by Doxygen to
+    document the software.  Dashes in these comment blocks are used to create bullet lists.
+    The lack of blank lines after a block of dash preceeded comments means that the next
+    block of dash preceeded comments is a new, indented bullet list.  I've tried to keep the
+    Doxygen formatting to a minimum but there are some other items (like <br> and <pre>)
+    that need to be left alone.  If you see a comment that starts with / * ! or / / ! and
+    there is something that looks a bit weird it is probably due to some arcane Doxygen
+    syntax.  Be very careful modifying blocks of Doxygen comments.
+
+*****************************************  IMPORTANT NOTE  **********************************/
+
+
+
+#include <math.h>
+
+#include "pfmWDBQuery.hpp"
+
+
+//  State shared by the query threads.  Each thread takes the next cell from the list, opens the one-degree PFM, and
+//  reads the bins that overlap the query area.
+
+typedef struct
+{
+  QMutex                 mutex;                  //  Protects next_cell
+  QMutex                 pfm_mutex;              //  PFM file opens and closes
+  QMutex                 callback_mutex;         //  Only one thread calls the callback at a time
+  PFMWDB_QUERY           *query;
+  PFMWDB_QUERY_CALLBACK  callback;
+  void                   *user_data;
+  NV_CHAR                pfmwdb[512];
+  NV_INT32               num_cells;
+  NV_INT32               next_cell;
+  PFMWDB_CELL_SUMMARY    *summary;               //  [num_cells]
+} QUERY_STATE;
+
+
+
+class queryThread:public QThread
+{
+public:
+
+  queryThread (QObject *parent = 0) : QThread (parent) {}
+
+  void prepare (QUERY_STATE *qs)
+  {
+    l_state = qs;
+    if (!isRunning ()) start ();
+  }
+
+
+protected:
+
+  QUERY_STATE      *l_state;
+
+  void             run ();
+  void             read_cell (PFMWDB_CELL_SUMMARY *cell, BIN_RECORD **bin_row, DEPTH_RECORD *chunk);
+  void             flush (PFMWDB_CELL_SUMMARY *cell, DEPTH_RECORD *chunk, NV_INT32 *count);
+};
+
+
+
+void queryThread::flush (PFMWDB_CELL_SUMMARY *cell, DEPTH_RECORD *chunk, NV_INT32 *count)
+{
+  if (*count && l_state->callback)
+    {
+      l_state->callback_mutex.lock ();
+      (*l_state->callback) (cell, chunk, *count, l_state->user_data);
+      l_state->callback_mutex.unlock ();
+    }
+
+  *count = 0;
+}
+
+
+
+void queryThread::read_cell (PFMWDB_CELL_SUMMARY *cell, BIN_RECORD **bin_row, DEPTH_RECORD *chunk)
+{
+  PFM_OPEN_ARGS open_args;
+  NV_INT32 hnd, count = 0;
+  NV_F64_XYMBR *mbr = &l_state->query->mbr;
+
+
+  sprintf (open_args.list_path, "%s%1c%1c%02d%1c%03d.pfm", l_state->pfmwdb, SEPARATOR, cell->lat < 0 ? 'S' : 'N', abs (cell->lat),
+           cell->lon < 0 ? 'W' : 'E', abs (cell->lon));
+  open_args.checkpoint = 0;
+
+
+  l_state->pfm_mutex.lock ();
+  hnd = open_existing_pfm_file (&open_args);
+  l_state->pfm_mutex.unlock ();
+
+  if (hnd < 0) return;
+
+  cell->opened = NVTrue;
+
+
+  //  Figure out which bins overlap the query area.
+
+  PFM_OPEN_ARGS *oa = &open_args;
+
+  NV_INT32 start_x = (NV_INT32) ((mbr->min_x - oa->head.mbr.min_x) / oa->head.x_bin_size_degrees);
+  NV_INT32 end_x = (NV_INT32) ((mbr->max_x - oa->head.mbr.min_x) / oa->head.x_bin_size_degrees);
+  NV_INT32 start_y = (NV_INT32) ((mbr->min_y - oa->head.mbr.min_y) / oa->head.y_bin_size_degrees);
+  NV_INT32 end_y = (NV_INT32) ((mbr->max_y - oa->head.mbr.min_y) / oa->head.y_bin_size_degrees);
+
+  start_x = qMax (start_x, 0);
+  start_y = qMax (start_y, 0);
+  end_x = qMin (end_x, oa->head.bin_width - 1);
+  end_y = qMin (end_y, oa->head.bin_height - 1);
+
+  NV_INT32 width = end_x - start_x + 1;
+
+
+  if (width > 0 && end_y >= start_y)
+    {
+      *bin_row = (BIN_RECORD *) realloc (*bin_row, width * sizeof (BIN_RECORD));
+
+      if (*bin_row == NULL)
+        {
+          perror ("Allocating bin row in PFMWDB query");
+          exit (-1);
+        }
+
+
+      for (NV_INT32 i = start_y ; i <= end_y ; i++)
+        {
+          read_bin_row (hnd, width, i, start_x, *bin_row);
+
+          for (NV_INT32 j = 0 ; j < width ; j++)
+            {
+              BIN_RECORD *bin = &(*bin_row)[j];
+              DEPTH_RECORD *depth;
+              NV_INT32 recnum;
+              NV_BOOL hit = NVFalse;
+
+              if (!bin->num_soundings) continue;
+
+              if (read_depth_array_index (hnd, bin->coord, &depth, &recnum)) continue;
+
+              for (NV_INT32 k = 0 ; k < recnum ; k++)
+                {
+                  if (depth[k].validity & l_state->query->exclude_mask) continue;
+
+                  if (depth[k].xyz.x < mbr->min_x || depth[k].xyz.x > mbr->max_x || depth[k].xyz.y < mbr->min_y ||
+                      depth[k].xyz.y > mbr->max_y) continue;
+
+
+                  if (!cell->points)
+                    {
+                      cell->min_z = cell->max_z = depth[k].xyz.z;
+                    }
+                  else
+                    {
+                      cell->min_z = qMin (cell->min_z, depth[k].xyz.z);
+                      cell->max_z = qMax (cell->max_z, depth[k].xyz.z);
+                    }
+
+                  cell->sum_z += depth[k].xyz.z;
+                  cell->sum2_z += depth[k].xyz.z * depth[k].xyz.z;
+                  cell->points++;
+                  hit = NVTrue;
+
+
+                  if (l_state->callback)
+                    {
+                      chunk[count++] = depth[k];
+                      if (count == PFMWDB_QUERY_CHUNK) flush (cell, chunk, &count);
+                    }
+                }
+
+              if (hit) cell->bins++;
+
+              free (depth);
+            }
+        }
+    }
+
+
+  flush (cell, chunk, &count);
+
+
+  l_state->pfm_mutex.lock ();
+  close_pfm_file (hnd);
+  l_state->pfm_mutex.unlock ();
+}
+
+
+
+void queryThread::run ()
+{
+  BIN_RECORD *bin_row = NULL;
+  DEPTH_RECORD *chunk = NULL;
+
+
+  if (l_state->callback)
+    {
+      chunk = (DEPTH_RECORD *) malloc (PFMWDB_QUERY_CHUNK * sizeof (DEPTH_RECORD));
+
+      if (chunk == NULL)
+        {
+          perror ("Allocating point buffer in PFMWDB query");
+          exit (-1);
+        }
+    }
+
+
+  while (1)
+    {
+      l_state->mutex.lock ();
+      NV_INT32 cell = l_state->next_cell++;
+      l_state->mutex.unlock ();
+
+      if (cell >= l_state->num_cells) break;
+
+      read_cell (&l_state->summary[cell], &bin_row, chunk);
+    }
+
+
+  if (bin_row) free (bin_row);
+  if (chunk) free (chunk);
+}
+
+
+
+//  Build the list of cells that overlap the query area and read them with the query threads.  If the PFMWDB.map file
+//  is open we skip the cells that have no records.
+
+static NV_INT32 run_query (PFMWDB_QUERY *query, PFMWDB_QUERY_CALLBACK callback, void *user_data, PFMWDB_CELL_SUMMARY **summary)
+{
+  QUERY_STATE state;
+
+
+  *summary = NULL;
+
+
+  //  Check for the PFMWDB environment variable
+
+  if (getenv ("PFMWDB") == NULL)
+    {
+      fprintf (stderr, "The PFMWDB environment variable is not set.\nThis must point to the folder that contains the one-degree PFM files.");
+      fflush (stderr);
+      return (-1);
+    }
+
+  strcpy (state.pfmwdb, getenv ("PFMWDB"));
+
+
+  NV_INT32 start_lat = qMax ((NV_INT32) floor (query->mbr.min_y), -90);
+  NV_INT32 end_lat = qMin ((NV_INT32) ceil (query->mbr.max_y), 90);
+  NV_INT32 start_lon = qMax ((NV_INT32) floor (query->mbr.min_x), -180);
+  NV_INT32 end_lon = qMin ((NV_INT32) ceil (query->mbr.max_x), 180);
+
+  if (end_lat == start_lat && end_lat < 90) end_lat++;
+  if (end_lon == start_lon && end_lon < 180) end_lon++;
+
+  NV_INT32 rows = end_lat - start_lat, cols = end_lon - start_lon;
+
+  if (rows <= 0 || cols <= 0) return (0);
+
+
+  PFMWDBMAP_RECORD *record = (PFMWDBMAP_RECORD *) malloc (rows * cols * sizeof (PFMWDBMAP_RECORD));
+  state.summary = (PFMWDB_CELL_SUMMARY *) calloc (rows * cols, sizeof (PFMWDB_CELL_SUMMARY));
+
+  if (record == NULL || state.summary == NULL)
+    {
+      perror ("Allocating cell list in PFMWDB query");
+      exit (-1);
+    }
+
+  NV_BOOL have_map = PFMWDBMAP_read_records (start_lat, start_lon, rows, cols, record);
+
+  state.num_cells = 0;
+  for (NV_INT32 i = 0 ; i < rows ; i++)
+    {
+      for (NV_INT32 j = 0 ; j < cols ; j++)
+        {
+          if (!have_map || record[i * cols + j].records)
+            {
+              state.summary[state.num_cells].lat = start_lat + i;
+              state.summary[state.num_cells].lon = start_lon + j;
+              state.num_cells++;
+            }
+        }
+    }
+
+  free (record);
+
+
+  state.query = query;
+  state.callback = callback;
+  state.user_data = user_data;
+  state.next_cell = 0;
+
+
+  NV_INT32 num_threads = query->num_threads;
+  if (num_threads <= 0) num_threads = QThread::idealThreadCount ();
+  num_threads = qMin (qMax (num_threads, 1), PFMWDB_MAX_QUERY_THREADS);
+  num_threads = qMax (qMin (num_threads, state.num_cells), 1);
+
+
+  queryThread query_thread[PFMWDB_MAX_QUERY_THREADS];
+
+  for (NV_INT32 i = 0 ; i < num_threads ; i++) query_thread[i].prepare (&state);
+
+  for (NV_INT32 i = 0 ; i < num_threads ; i++) query_thread[i].wait ();
+
+
+  *summary = state.summary;
+
+  return (state.num_cells);
+}
+
+
+
+/*********************************************************************************************/
+/*!
+
+   - Module Name:        PFMWDB_query_summary
+
+   - Programmer(s):      Jan C. Depner
+
+   - Date Written:       10/19/26
+
+   - Purpose:            Summarizes the points in an area that may span many one-degree cells.
+                         The cells are opened and read in parallel.  If the PFMWDB.map file is
+                         open (see PFMWDBMAP_open) cells with no records are skipped without
+                         trying to open them.
+
+   - Arguments:
+                         - query          =  Query area, validity exclusion mask, and thread
+                                             count
+                         - summary        =  Array of cell summaries returned (one per cell
+                                             that was checked, ordered by latitude then
+                                             longitude from the southwest corner).  Free it
+                                             with free ().
+
+   - Return Value:
+                         - NV_INT32       =  Number of cell summaries or -1 on error
+
+**********************************************************************************************/
+
+NV_INT32 PFMWDB_query_summary (PFMWDB_QUERY *query, PFMWDB_CELL_SUMMARY **summary)
+{
+  return (run_query (query, NULL, NULL, summary));
+}
+
+
+
+/*********************************************************************************************/
+/*!
+
+   - Module Name:        PFMWDB_query_extract
+
+   - Programmer(s):      Jan C. Depner
+
+   - Date Written:       10/19/26
+
+   - Purpose:            Extracts the points in an area that may span many one-degree cells.
+                         The cells are opened and read in parallel and the points are passed
+                         to the callback function.
+
+   - Arguments:
+                         - query          =  Query area, validity exclusion mask, and thread
+                                             count
+                         - callback       =  Function called with the points
+                         - user_data      =  Pointer passed through to the callback
+                         - summary        =  Array of cell summaries returned (see
+                                             PFMWDB_query_summary).  Free it with free ().
+
+   - Return Value:
+                         - NV_INT32       =  Number of cell summaries or -1 on error
+
+   - Caveats:            The callback is called from the query threads but only one call is
+                         made at a time so it doesn't need to do any locking of its own.  The
+                         points from each cell arrive in bin row order but calls for different
+                         cells are interleaved.  Use the cell summary passed to the callback if
+                         you need to know which cell the points came from.  Don't call the
+                         pfmWDB or PFM libraries from the callback.
+
+**********************************************************************************************/
+
+NV_INT32 PFMWDB_query_extract (PFMWDB_QUERY *query, PFMWDB_QUERY_CALLBACK callback, void *user_data, PFMWDB_CELL_SUMMARY **summary)
+{
+  return (run_query (query, callback, user_data, summary));
+}
@@ -0,0 +1,89 @@
+
+/*********************************************************************************************
+
+    This is public domain software that was developed by the U.S. Naval Oceanographic Office.
+
+    This is a work of the US Government. In accordance with 17 USC 105, copyright protection
+    is not available for any work of the US Government.
+
+    Neither the United States Government nor any employees of the United States Government,
+    makes any warranty, express or implied, without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, or assumes any liability or
+    responsibility for the accuracy, completeness, or usefulness of any information,
+    apparatus, product, or process disclosed, or represents that its use would not infringe
+    privately-owned rights. Reference herein to any specific commercial products, process,
+    or service by trade name, trademark, manufacturer, or otherwise, does not necessarily
+    constitute or imply its endorsement, recommendation, or favoring by the United States
+    Government. The views and opinions of authors expressed herein do not necessarily state
+    or reflect those of the United States Government, and shall not be used for advertising
+    or product endorsement purposes.
+
+*********************************************************************************************/
+
+
+/****************************************  IMPORTANT NOTE  **********************************
+
+    Comments in this file that start with / * ! or / / ! are being used by Doxygen to
+    document the software.  Dashes in these comment blocks are used to create bullet lists.
+    The lack of blank lines after a block of dash preceeded comments means that the next
+    block of dash preceeded comments is a new, indented bullet list.  I've tried to keep the
+    Doxygen formatting to a minimum but there are some other items (like <br> and <pre>)
+    that need to be left alone.  If you see a comment that starts with / * ! or / / ! and
+    there is something that looks a bit weird it is probably due to some arcane Doxygen
+    syntax.  Be very careful modifying blocks of Doxygen comments.
+
+*****************************************  IMPORTANT NOTE  **********************************/
+
+
+
+#ifndef __PFMWDB_QUERY_H__
+#define __PFMWDB_QUERY_H__
+
+#include "pfmWDB.h"
+#include "pfm.h"
+
+#include <QtCore>
+
+
+#define     PFMWDB_MAX_QUERY_THREADS              16           /*!<  Maximum number of one-degree cells read at the same time  */
+#define     PFMWDB_QUERY_CHUNK                    65536        /*!<  Maximum number of points passed to the callback at one time  */
+
+
+/*!  Region query definition.  */
+
+typedef struct
+{
+  NV_F64_XYMBR        mbr;                              /*!<  Area to query in degrees (may span any number of cells but
+                                                              can't cross the 180 degree meridian)  */
+  NV_U_INT32          exclude_mask;                     /*!<  Points with any of these validity bits set are skipped
+                                                              (for example PFM_INVAL | PFM_DELETED)  */
+  NV_INT32            num_threads;                      /*!<  Number of cells to read at once (0 for one per processor)  */
+} PFMWDB_QUERY;
+
+
+/*!  Summary of the points from one one-degree cell that fall in the query area.  */
+
+typedef struct
+{
+  NV_INT32            lat;                              /*!<  Latitude degrees of the southwest corner of the cell  */
+  NV_INT32            lon;                              /*!<  Longitude degrees of the southwest corner of the cell  */
+  NV_BOOL             opened;                           /*!<  NVFalse if the cell PFM couldn't be opened  */
+  NV_INT64            points;                           /*!<  Number of points in the query area  */
+  NV_INT32            bins;                             /*!<  Number of bins with points in the query area  */
+  NV_FLOAT64          min_z;                            /*!<  Minimum Z  */
+  NV_FLOAT64          max_z;                            /*!<  Maximum Z  */
+  NV_FLOAT64          sum_z;                            /*!<  Sum of Z (for the mean)  */
+  NV_FLOAT64          sum2_z;                           /*!<  Sum of Z squared (for the standard deviation)  */
+} PFMWDB_CELL_SUMMARY;
+
+
+/*!  Point callback for PFMWDB_query_extract.  It is called with up to PFMWDB_QUERY_CHUNK points at a time.  */
+
+typedef void (*PFMWDB_QUERY_CALLBACK) (PFMWDB_CELL_SUMMARY *cell, DEPTH_RECORD *depth, NV_INT32 count, void *user_data);
+
+
+NV_INT32 PFMWDB_query_summary (PFMWDB_QUERY *query, PFMWDB_CELL_SUMMARY **summary);
+NV_INT32 PFMWDB_query_extract (PFMWDB_QUERY *query, PFMWDB_QUERY_CALLBACK callback, void *user_data, PFMWDB_CELL_SUMMARY **summary);
+
+
+#endif
@@ -39,7 +39,7 @@
 
 #ifndef PFMWDB_VERSION
 
-#define     PFMWDB_VERSION     "PFM Software - pfmWDB library V1.01 - 03/10/11"
+#define     PFMWDB_VERSION     "PFM Software - pfmWDB library V1.02 - 10/19/26"
 
 #endif
 
@@ -62,4 +62,15 @@
   ancillary programs but we need it to be able to unload from these PFMs (also a new feature - supported in
   pfm_unload).  Added tons of comments and documentation of the PFMWDB.map and PFMWDB structures.
 
+
+  Version 1.02
+  Jan C. Depner
+  10/19/26
+
+  The PFMWDB.map file list is read into memory and hashed by file name the first time it's needed so that
+  PFMWDBMAP_mark_file and PFMWDBMAP_file_cleanup don't have to rescan the list.  Added PFMWDBMAP_find_file to look up
+  a single file and PFMWDBMAP_read_records to read a block of cell records (PFMWDBMAP_recompute now reads a row at a
+  time).  Added pfmWDBQuery.cpp with PFMWDB_query_summary and PFMWDB_query_extract to summarize or extract an area
+  that spans many one-degree cells by reading the cells in parallel.
+
 </pre>*/
@@ -64,6 +64,37 @@ static  NV_CHAR                  hyp_err_str[512];
 /*! Variables and functions for the progress callback */
 static  HYP_PROGRESS_CALLBACK  hyp_progress_callback = NULL;
 
+/*! Hypothesis records closer together than HYP_IO_GAP bytes are read with a single read of
+    no more than HYP_IO_SPAN bytes by the row block functions. */
+#define HYP_IO_GAP                  4096
+#define HYP_IO_SPAN                 1048576
+
+/*! Address of a hypothesis record and the node/hypothesis it belongs to (for sorting records by address) */
+typedef struct
+{
+    NV_INT64    address;
+    NV_INT32    node;
+    NV_INT32    hypo;
+}
+HypRecAddr;
+
+/*! Work arrays for hyp_write_nodes */
+typedef struct
+{
+    NV_U_CHAR   *buf;
+    NV_U_CHAR   *data;
+    NV_INT64    *next;
+    NV_INT64    *old_addr;
+    NV_INT64    *new_addr;
+    NV_INT64    *freed;
+    NV_INT32    *old_start;
+    NV_INT32    *old_len;
+    NV_INT32    *new_start;
+    HypRecAddr  *recs;
+    HypRecAddr  *chain;
+}
+HypWriteWork;
+
 
 /*!  Static function arrays for I/O (either HUGE or LARGE).  */
 
@@ -908,6 +939,876 @@ NV_INT32    hyp_write_node( HypHead *p, NV_INT32 x, NV_INT32 y, HypNode *node )
     return 0;
 }
 
+/*! <pre>
+ *******************************************************************************
+ * Function  : hyp_compare_rec_addr
+ * Arguments : a, b - HypRecAddr pointers
+ * Returns   : -1, 0, or 1
+ * Purpose   : qsort comparison function used to sort hypothesis record
+ *   addresses so that we can read and write them front to back.
+ *******************************************************************************
+ </pre>*/
+static int          hyp_compare_rec_addr( const void *a, const void *b )
+{
+    const HypRecAddr *ra = (const HypRecAddr *) a;
+    const HypRecAddr *rb = (const HypRecAddr *) b;
+
+    if( ra->address < rb->address ) return -1;
+    if( ra->address > rb->address ) return 1;
+    return 0;
+}
+
+/*! <pre>
+ *******************************************************************************
+ * Function  : hyp_get_field / hyp_put_field
+ * Arguments : dst, src - destination and source
+ *             size     - size of the field in bytes
+ *             p        - HypHead (for the endian of the file)
+ * Returns   :
+ * Purpose   : Copy a single field out of (or into) a block of file data,
+ *   swapping for endian if necessary.
+ *******************************************************************************
+ </pre>*/
+static void         hyp_get_field( void *dst, NV_U_CHAR *src, NV_INT32 size, HypHead *p )
+{
+    memcpy( dst, src, size );
+    hyp_swap_bytes( dst, size, 1, p->endian );
+}
+
+static void         hyp_put_field( NV_U_CHAR *dst, void *src, NV_INT32 size, HypHead *p )
+{
+    memcpy( dst, src, size );
+    hyp_swap_bytes( dst, size, 1, p->endian );
+}
+
+/*! <pre>
+ *******************************************************************************
+ * Function  : hyp_read_records
+ * Arguments : p     - HypHead
+ *             recs  - array of hypothesis record addresses (sorted on return)
+ *             count - number of addresses in recs
+ *             data  - returned HYP_HYPOTHESIS_RECORD_SIZE bytes of raw file
+ *                     data for each entry of the sorted recs array
+ * Returns   : 0 on success, -1 on error
+ * Purpose   : Reads a set of hypothesis records.  The addresses are sorted
+ *   and records that are close together on disk are read with a single read
+ *   of up to HYP_IO_SPAN bytes instead of one seek and read per record.
+ *******************************************************************************
+ </pre>*/
+static NV_INT32     hyp_read_records( HypHead *p, HypRecAddr *recs, NV_INT32 count, NV_U_CHAR *data )
+{
+    NV_U_CHAR   *span;
+    NV_INT32     i, j, k;
+    NV_INT64     start, size;
+
+    qsort( recs, count, sizeof(HypRecAddr), hyp_compare_rec_addr );
+
+    span = (NV_U_CHAR *) malloc( HYP_IO_SPAN );
+    if( span == NULL )
+    {
+        sprintf( hyp_err_str, "Unable to allocate memory for reading hypotheses." );
+        return -1;
+    }
+
+    for( i = 0; i < count; i = j )
+    {
+        /* Find the records that we can get in one read */
+        start = recs[i].address;
+        for( j = i + 1; j < count; j++ )
+        {
+            if( recs[j].address - (recs[j - 1].address + HYP_HYPOTHESIS_RECORD_SIZE) > HYP_IO_GAP ||
+                recs[j].address + HYP_HYPOTHESIS_RECORD_SIZE - start > HYP_IO_SPAN ) break;
+        }
+        size = recs[j - 1].address + HYP_HYPOTHESIS_RECORD_SIZE - start;
+
+        PFM_FSEEK( p->filehnd, start, SEEK_SET );
+        if( PFM_FREAD( span, size, 1, p->filehnd ) < 1 )
+        {
+            sprintf( hyp_err_str, "Error reading hypotheses at %lld.", (long long) start );
+            free( span );
+            return -1;
+        }
+
+        for( k = i; k < j; k++ )
+            memcpy( &data[(NV_INT64) k * HYP_HYPOTHESIS_RECORD_SIZE], &span[recs[k].address - start],
+                    HYP_HYPOTHESIS_RECORD_SIZE );
+    }
+
+    free( span );
+    return 0;
+}
+
+/*! <pre>
+ *******************************************************************************
+ * Function  : hyp_write_records
+ * Arguments : p     - HypHead
+ *             recs  - array of hypothesis record addresses sorted by address
+ *             count - number of addresses in recs
+ *             data  - HYP_HYPOTHESIS_RECORD_SIZE bytes of raw file data for
+ *                     each entry of recs
+ * Returns   : 0 on success, -1 on error
+ * Purpose   : Writes a set of hypothesis records.  Runs of records that are
+ *   adjacent on disk are written with a single seek and write.
+ *******************************************************************************
+ </pre>*/
+static NV_INT32     hyp_write_records( HypHead *p, HypRecAddr *recs, NV_INT32 count, NV_U_CHAR *data )
+{
+    NV_INT32     i, j;
+
+    for( i = 0; i < count; i = j )
+    {
+        for( j = i + 1; j < count; j++ )
+        {
+            if( recs[j].address != recs[j - 1].address + HYP_HYPOTHESIS_RECORD_SIZE ) break;
+        }
+
+        PFM_FSEEK( p->filehnd, recs[i].address, SEEK_SET );
+        if( PFM_FWRITE( &data[(NV_INT64) i * HYP_HYPOTHESIS_RECORD_SIZE], HYP_HYPOTHESIS_RECORD_SIZE, j - i,
+                        p->filehnd ) < (size_t) (j - i) )
+        {
+            sprintf( hyp_err_str, "Error writing hypotheses at %lld.", (long long) recs[i].address );
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/*! <pre>
+ *******************************************************************************
+ * Function  : hyp_check_rows
+ * Arguments : p         - HypHead
+ *             start_row - first row
+ *             num_rows  - number of rows
+ * Returns   : 0 if the rows are in the file, -1 otherwise
+ * Purpose   : Range check for the row block functions.
+ *******************************************************************************
+ </pre>*/
+static NV_INT32     hyp_check_rows( HypHead *p, NV_INT32 start_row, NV_INT32 num_rows )
+{
+    if( start_row < 0 || num_rows < 1 || start_row + num_rows > p->nrows )
+    {
+        sprintf( hyp_err_str, "Invalid hypothesis row range %d to %d.", start_row, start_row + num_rows - 1 );
+        return -1;
+    }
+    return 0;
+}
+
+/*! <pre>
+ *******************************************************************************
+ * Function  : hyp_read_node_rows
+ * Arguments : p         - HypHead
+ *             start_row - first row to read
+ *             num_rows  - number of rows to read
+ *             nodes     - array of num_rows * p->ncols nodes (row major).  Any
+ *                         hypotheses already in the nodes are freed.  The
+ *                         nodes must be zeroed before the first call.
+ * Returns   : 0 on success, -1 on error or if any node's hypothesis chain is
+ *   inconsistent (same as hyp_read_node)
+ * Purpose   : Reads all of the nodes for a block of rows.  The node records are
+ *   read with a single read.  The hypothesis chains are then followed one link
+ *   at a time for all of the nodes at once, reading the records in file order
+ *   (see hyp_read_records), so a block of rows costs a handful of large reads
+ *   instead of a seek and several small reads per node.
+ *******************************************************************************
+ </pre>*/
+NV_INT32    hyp_read_node_rows( HypHead *p, NV_INT32 start_row, NV_INT32 num_rows, HypNode *nodes )
+{
+    NV_U_CHAR   *buf, *data, *rec;
+    NV_INT64    *next;
+    HypRecAddr  *recs;
+    PHypothesis *h;
+    NV_INT32     i, k, count, level, active, status = 0;
+
+    if( hyp_check_rows( p, start_row, num_rows ) ) return -1;
+
+    count = num_rows * p->ncols;
+    buf  = (NV_U_CHAR *) malloc( (NV_INT64) count * HYP_NODE_RECORD_SIZE );
+    next = (NV_INT64 *) malloc( count * sizeof(NV_INT64) );
+    recs = (HypRecAddr *) malloc( count * sizeof(HypRecAddr) );
+    data = (NV_U_CHAR *) malloc( (NV_INT64) count * HYP_HYPOTHESIS_RECORD_SIZE );
+    if( buf == NULL || next == NULL || recs == NULL || data == NULL )
+    {
+        sprintf( hyp_err_str, "Unable to allocate memory for reading hypothesis rows." );
+        status = -1;
+    }
+    else
+    {
+        /* Read the node records for all of the rows at once */
+        PFM_FSEEK( p->filehnd, HYP_ASCII_HEADER_SIZE + HYP_BINARY_HEADER_SIZE + (NV_INT64)start_row * (NV_INT64)p->ncols * HYP_NODE_RECORD_SIZE, SEEK_SET );
+        if( PFM_FREAD( buf, HYP_NODE_RECORD_SIZE, count, p->filehnd ) < (size_t) count )
+        {
+            printf ("ERROR:  reading HYP node rows failed ...\n");
+            status = -1;
+        }
+    }
+
+    if( !status )
+    {
+        for( i = 0; i < count; i++ )
+        {
+            rec = &buf[(NV_INT64) i * HYP_NODE_RECORD_SIZE];
+            hyp_get_field( &nodes[i].best_hypo, rec, sizeof(NV_FLOAT32), p );
+            hyp_get_field( &nodes[i].n_hypos, rec + 4, sizeof(NV_INT32), p );
+            hyp_get_field( &next[i], rec + 8, sizeof(NV_INT64), p );
+
+            /* Allocate the hypotheses */
+            if( nodes[i].hypos )
+                free( nodes[i].hypos );
+            if( nodes[i].n_hypos <= 0 )
+                nodes[i].hypos = NULL;
+            else
+                nodes[i].hypos = (PHypothesis*)malloc( nodes[i].n_hypos * sizeof(PHypothesis) );
+        }
+
+        /* Follow all of the chains one link at a time */
+        for( level = 0; ; level++ )
+        {
+            active = 0;
+            for( i = 0; i < count; i++ )
+            {
+                if( level < nodes[i].n_hypos )
+                {
+                    if( next[i] )
+                    {
+                        recs[active].address = next[i];
+                        recs[active].node    = i;
+                        recs[active].hypo    = level;
+                        active++;
+                    }
+                    else
+                    {
+                        /* Chain is shorter than the number of hypotheses */
+                        status = -1;
+                    }
+                }
+            }
+            if( !active )
+                break;
+
+            if( hyp_read_records( p, recs, active, data ) )
+            {
+                status = -1;
+                break;
+            }
+
+            for( k = 0; k < active; k++ )
+            {
+                i   = recs[k].node;
+                rec = &data[(NV_INT64) k * HYP_HYPOTHESIS_RECORD_SIZE];
+                h   = &nodes[i].hypos[ level ];
+                hyp_get_field( &h->z,       rec,      sizeof(NV_FLOAT32), p );
+                hyp_get_field( &h->var,     rec + 4,  sizeof(NV_FLOAT32), p );
+                hyp_get_field( &h->n_snds,  rec + 8,  sizeof(NV_INT32),   p );
+                hyp_get_field( &h->avg_tpe, rec + 12, sizeof(NV_FLOAT32), p );
+                hyp_get_field( &next[i],    rec + HYP_POINTER_POS, sizeof(NV_INT64), p );
+                h->ci = (NV_FLOAT32)(p->cube_param->sd2conf_scale * sqrt(h->var ));
+            }
+        }
+
+        /* Check for chains that are longer than the number of hypotheses */
+        for( i = 0; i < count; i++ )
+        {
+            if( next[i] )
+                status = -1;
+        }
+    }
+
+    if( buf ) free( buf );
+    if( next ) free( next );
+    if( recs ) free( recs );
+    if( data ) free( data );
+
+    return status;
+}
+
+/*! <pre>
+ *******************************************************************************
+ * Function  : hyp_write_node_block
+ * Arguments : p        - HypHead
+ *             node_pos - file position of the first node record
+ *             count    - number of nodes
+ *             nodes    - array of count nodes
+ *             dirty    - optional array of count flags (see hyp_write_nodes)
+ *             w        - work arrays (freed by the caller)
+ * Returns   : 0 on success, -1 on error
+ * Purpose   : Does the actual work for hyp_write_nodes.
+ *******************************************************************************
+ </pre>*/
+static NV_INT32     hyp_write_node_block( HypHead *p, NV_INT64 node_pos, NV_INT32 count, HypNode *nodes,
+                                          NV_U_CHAR *dirty, HypWriteWork *w )
+{
+    NV_U_CHAR   *buf = w->buf, *data = w->data, *rec;
+    NV_INT64    *next = w->next, *old_addr, *new_addr, *freed, ptr, zero = 0;
+    NV_INT32    *old_start = w->old_start, *old_len = w->old_len, *new_start = w->new_start;
+    HypRecAddr  *recs = w->recs, *chain = w->chain;
+    PHypothesis *h;
+    NV_INT32     i, k, n, level, active, num_old, num_new, num_freed, used_freed, allocated = count;
+    void        *new_ptr;
+
+    /* Read the existing node records so that we know where the existing chains start */
+    PFM_FFLUSH( p->filehnd );
+    PFM_FSEEK( p->filehnd, node_pos, SEEK_SET );
+    if( PFM_FREAD( buf, HYP_NODE_RECORD_SIZE, count, p->filehnd ) < (size_t) count )
+    {
+        printf ("ERROR:  reading HYP node rows failed ...\n");
+        return -1;
+    }
+
+    for( i = 0; i < count; i++ )
+    {
+        next[i] = 0;
+        if( !dirty || dirty[i] )
+            hyp_get_field( &next[i], &buf[(NV_INT64) i * HYP_NODE_RECORD_SIZE + 8], sizeof(NV_INT64), p );
+    }
+
+    /* Follow all of the existing chains to get the addresses of the existing records */
+    num_old = 0;
+    for( level = 0; ; level++ )
+    {
+        active = 0;
+        for( i = 0; i < count; i++ )
+        {
+            if( next[i] )
+            {
+                recs[active].address = next[i];
+                recs[active].node    = i;
+                recs[active].hypo    = level;
+                active++;
+            }
+        }
+        if( !active )
+            break;
+
+        if( hyp_read_records( p, recs, active, data ) )
+        {
+            return -1;
+        }
+
+        if( num_old + active > allocated )
+        {
+            allocated = (num_old + active) * 2;
+            new_ptr = realloc( chain, allocated * sizeof(HypRecAddr) );
+            if( new_ptr == NULL )
+            {
+                sprintf( hyp_err_str, "Unable to allocate memory for writing hypothesis rows." );
+                return -1;
+            }
+            w->chain = chain = (HypRecAddr *) new_ptr;
+        }
+
+        for( k = 0; k < active; k++ )
+        {
+            i = recs[k].node;
+            chain[num_old++] = recs[k];
+            old_len[i]++;
+            hyp_get_field( &next[i], &data[(NV_INT64) k * HYP_HYPOTHESIS_RECORD_SIZE + HYP_POINTER_POS],
+                           sizeof(NV_INT64), p );
+        }
+    }
+
+    /* Put the existing record addresses in chain order for each node */
+    for( i = 0; i < count; i++ )
+        old_start[i + 1] = old_start[i] + old_len[i];
+
+    w->old_addr = old_addr = (NV_INT64 *) malloc( (num_old + 1) * sizeof(NV_INT64) );
+    if( old_addr == NULL )
+    {
+        sprintf( hyp_err_str, "Unable to allocate memory for writing hypothesis rows." );
+        return -1;
+    }
+    for( k = 0; k < num_old; k++ )
+        old_addr[old_start[chain[k].node] + chain[k].hypo] = chain[k].address;
+
+    /* Records that are no longer needed are freed, everything else is reused in place */
+    num_new = num_freed = 0;
+    for( i = 0; i < count; i++ )
+    {
+        n = ( (!dirty || dirty[i]) && nodes[i].n_hypos > 0 ) ? nodes[i].n_hypos : 0;
+        new_start[i + 1] = new_start[i] + n;
+        if( old_len[i] > n )
+            num_freed += old_len[i] - n;
+    }
+    num_new = new_start[count];
+
+    w->new_addr = new_addr = (NV_INT64 *) malloc( (num_new + 1) * sizeof(NV_INT64) );
+    w->freed = freed = (NV_INT64 *) malloc( (num_freed + 1) * sizeof(NV_INT64) );
+    if( new_addr == NULL || freed == NULL )
+    {
+        sprintf( hyp_err_str, "Unable to allocate memory for writing hypothesis rows." );
+        return -1;
+    }
+
+    num_freed = 0;
+    for( i = 0; i < count; i++ )
+    {
+        n = new_start[i + 1] - new_start[i];
+        for( k = n; k < old_len[i]; k++ )
+            freed[num_freed++] = old_addr[old_start[i] + k];
+    }
+
+    /* Get the addresses for the new records */
+    PFM_FFLUSH( p->filehnd );
+    used_freed = 0;
+    for( i = 0; i < count; i++ )
+    {
+        n = new_start[i + 1] - new_start[i];
+        for( k = 0; k < n; k++ )
+        {
+            if( k < old_len[i] )
+            {
+                ptr = old_addr[old_start[i] + k];
+            }
+            else if( used_freed < num_freed )
+            {
+                /* Reuse a record that was freed from another node in this block */
+                ptr = freed[used_freed++];
+            }
+            else if( p->deleted_ptr )
+            {
+                /* Get new record from list of deleted records */
+                ptr = p->deleted_ptr;
+                PFM_FSEEK( p->filehnd, ptr + HYP_POINTER_POS, SEEK_SET );
+                hyp_fread( &p->deleted_ptr, sizeof(NV_INT64), 1, p ); /* Slide deleted pointer ahead */
+            }
+            else
+            {
+                /* Get new record from the end of the file */
+                ptr = p->file_size;
+                p->file_size += HYP_HYPOTHESIS_RECORD_SIZE;
+            }
+            new_addr[new_start[i] + k] = ptr;
+        }
+    }
+
+    /* Build the hypothesis records and write them in file order */
+    if( num_new )
+    {
+        free( w->recs );
+        free( w->data );
+        w->recs = recs = (HypRecAddr *) malloc( num_new * sizeof(HypRecAddr) );
+        w->data = data = (NV_U_CHAR *) malloc( (NV_INT64) num_new * HYP_HYPOTHESIS_RECORD_SIZE );
+        if( recs == NULL || data == NULL )
+        {
+            sprintf( hyp_err_str, "Unable to allocate memory for writing hypothesis rows." );
+            return -1;
+        }
+
+        for( i = 0; i < count; i++ )
+        {
+            for( k = new_start[i]; k < new_start[i + 1]; k++ )
+            {
+                recs[k].address = new_addr[k];
+                recs[k].node    = i;
+                recs[k].hypo    = k - new_start[i];
+            }
+        }
+        qsort( recs, num_new, sizeof(HypRecAddr), hyp_compare_rec_addr );
+
+        for( k = 0; k < num_new; k++ )
+        {
+            i   = recs[k].node;
+            h   = &nodes[i].hypos[ recs[k].hypo ];
+            rec = &data[(NV_INT64) k * HYP_HYPOTHESIS_RECORD_SIZE];
+            ptr = ( new_start[i] + recs[k].hypo + 1 < new_start[i + 1] ) ? new_addr[new_start[i] + recs[k].hypo + 1] : 0;
+            hyp_put_field( rec,      &h->z,       sizeof(NV_FLOAT32), p );
+            hyp_put_field( rec + 4,  &h->var,     sizeof(NV_FLOAT32), p );
+            hyp_put_field( rec + 8,  &h->n_snds,  sizeof(NV_INT32),   p );
+            hyp_put_field( rec + 12, &h->avg_tpe, sizeof(NV_FLOAT32), p );
+            hyp_put_field( rec + HYP_POINTER_POS, &ptr, sizeof(NV_INT64), p );
+        }
+
+        if( hyp_write_records( p, recs, num_new, data ) )
+        {
+            return -1;
+        }
+    }
+
+    /* Add all records left over onto the deleted records list */
+    if( used_freed < num_freed )
+    {
+        for( k = used_freed; k < num_freed; k++ )
+        {
+            ptr = ( k + 1 < num_freed ) ? freed[k + 1] : p->deleted_ptr;
+            PFM_FSEEK( p->filehnd, freed[k] + HYP_POINTER_POS, SEEK_SET );
+            if( hyp_fwrite( &ptr, sizeof(NV_INT64), 1, p ) < 1 )
+            {
+                printf ("ERROR:  writing deleted_ptr to node failed ...\n");
+                return -1;
+            }
+        }
+
+        /* Change the head of the deleted chain */
+        p->deleted_ptr = freed[used_freed];
+    }
+
+    /* Write the node records for all of the rows at once (nodes that aren't dirty are left as they were) */
+    for( i = 0; i < count; i++ )
+    {
+        if( dirty && !dirty[i] )
+            continue;
+
+        rec = &buf[(NV_INT64) i * HYP_NODE_RECORD_SIZE];
+        ptr = ( new_start[i + 1] > new_start[i] ) ? new_addr[new_start[i]] : zero;
+        hyp_put_field( rec,     &nodes[i].best_hypo, sizeof(NV_FLOAT32), p );
+        hyp_put_field( rec + 4, &nodes[i].n_hypos,   sizeof(NV_INT32),   p );
+        hyp_put_field( rec + 8, &ptr,                sizeof(NV_INT64),   p );
+    }
+
+    PFM_FSEEK( p->filehnd, node_pos, SEEK_SET );
+    if( PFM_FWRITE( buf, HYP_NODE_RECORD_SIZE, count, p->filehnd ) < (size_t) count )
+    {
+        printf ("ERROR: writing HYP node rows failed ...\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+/*! <pre>
+ *******************************************************************************
+ * Function  : hyp_write_nodes
+ * Arguments : p         - HypHead
+ *             start_row - first row to write
+ *             num_rows  - number of rows to write
+ *             nodes     - array of num_rows * p->ncols nodes (row major)
+ *             dirty     - optional array of num_rows * p->ncols flags.  If
+ *                         not NULL, only nodes with a non-zero flag are
+ *                         written.
+ * Returns   : 0 on success, -1 on error
+ * Purpose   : Writes the nodes for a block of rows.  This does the same thing
+ *   as calling hyp_write_node for each node but all of the I/O is batched:
+ *     - the node records are read and written with a single read and write
+ *     - the existing hypothesis chains are followed for all of the nodes at
+ *       once (see hyp_read_records)
+ *     - existing hypothesis records are reused in place, records that are no
+ *       longer needed are reused for nodes that need more records before we
+ *       go to the deleted list or the end of the file, and whatever is left
+ *       over goes on the deleted list
+ *     - the hypothesis records are written in file order and adjacent
+ *       records (e.g. new records at the end of the file) are written with a
+ *       single write
+ *******************************************************************************
+ </pre>*/
+static NV_INT32     hyp_write_nodes( HypHead *p, NV_INT32 start_row, NV_INT32 num_rows, HypNode *nodes,
+                                     NV_U_CHAR *dirty )
+{
+    HypWriteWork w;
+    NV_INT64     node_pos, old_deleted_ptr, old_file_size;
+    NV_INT32     count, status = 0;
+
+    if( hyp_check_rows( p, start_row, num_rows ) ) return -1;
+
+    old_deleted_ptr = p->deleted_ptr;
+    old_file_size   = p->file_size;
+
+    count    = num_rows * p->ncols;
+    node_pos = HYP_ASCII_HEADER_SIZE + HYP_BINARY_HEADER_SIZE + (NV_INT64)start_row * (NV_INT64)p->ncols * HYP_NODE_RECORD_SIZE;
+
+    memset( &w, 0, sizeof(HypWriteWork) );
+    w.buf       = (NV_U_CHAR *) malloc( (NV_INT64) count * HYP_NODE_RECORD_SIZE );
+    w.next      = (NV_INT64 *) malloc( count * sizeof(NV_INT64) );
+    w.old_start = (NV_INT32 *) calloc( count + 1, sizeof(NV_INT32) );
+    w.old_len   = (NV_INT32 *) calloc( count, sizeof(NV_INT32) );
+    w.new_start = (NV_INT32 *) calloc( count + 1, sizeof(NV_INT32) );
+    w.recs      = (HypRecAddr *) malloc( count * sizeof(HypRecAddr) );
+    w.data      = (NV_U_CHAR *) malloc( (NV_INT64) count * HYP_HYPOTHESIS_RECORD_SIZE );
+    w.chain     = (HypRecAddr *) malloc( count * sizeof(HypRecAddr) );
+    if( w.buf == NULL || w.next == NULL || w.old_start == NULL || w.old_len == NULL || w.new_start == NULL ||
+        w.recs == NULL || w.data == NULL || w.chain == NULL )
+    {
+        sprintf( hyp_err_str, "Unable to allocate memory for writing hypothesis rows." );
+        status = -1;
+    }
+    else
+    {
+        status = hyp_write_node_block( p, node_pos, count, nodes, dirty, &w );
+    }
+
+    /* Write deleted pointer if necessary - keep file consistent */
+    if( old_deleted_ptr != p->deleted_ptr )
+    {
+        PFM_FSEEK( p->filehnd, HYP_DELETED_POINTER_POS, SEEK_SET );
+        if (hyp_fwrite( &p->deleted_ptr, sizeof(NV_INT64), 1, p ) < 1)
+          {
+            printf ("ERROR:  writing deleted_ptr to node failed ...\n");
+            status = -1;
+          }
+    }
+
+    /* Write file size if necessary - keep file consistent */
+    if( old_file_size != p->file_size )
+    {
+        PFM_FSEEK( p->filehnd, HYP_FILE_SIZE_POS, SEEK_SET );
+        if (hyp_fwrite( &p->file_size, sizeof(NV_INT64), 1, p ) < 1)
+          {
+            printf ("ERROR:  writing filesize to node failed ...\n");
+            status = -1;
+          }
+    }
+
+    PFM_FFLUSH( p->filehnd );
+
+    if( w.buf ) free( w.buf );
+    if( w.next ) free( w.next );
+    if( w.old_start ) free( w.old_start );
+    if( w.old_len ) free( w.old_len );
+    if( w.new_start ) free( w.new_start );
+    if( w.recs ) free( w.recs );
+    if( w.data ) free( w.data );
+    if( w.chain ) free( w.chain );
+    if( w.old_addr ) free( w.old_addr );
+    if( w.new_addr ) free( w.new_addr );
+    if( w.freed ) free( w.freed );
+
+    return status;
+}
+
+/*! <pre>
+ *******************************************************************************
+ * Function  : hyp_write_node_rows
+ * Arguments : p         - HypHead
+ *             start_row - first row to write
+ *             num_rows  - number of rows to write
+ *             nodes     - array of num_rows * p->ncols nodes (row major)
+ * Returns   : 0 on success, -1 on error
+ * Purpose   : Writes all of the nodes for a block of rows using batched I/O
+ *   (see hyp_write_nodes).  The result is the same as calling hyp_write_node
+ *   for every node in the rows.
+ *******************************************************************************
+ </pre>*/
+NV_INT32    hyp_write_node_rows( HypHead *p, NV_INT32 start_row, NV_INT32 num_rows, HypNode *nodes )
+{
+    return hyp_write_nodes( p, start_row, num_rows, nodes, NULL );
+}
+
+/*! <pre>
+ *******************************************************************************
+ * Function  : hyp_create_node_cache
+ * Arguments : p              - HypHead
+ *             rows_per_block - number of rows read and written at a time
+ *             max_blocks     - maximum number of blocks kept in memory
+ * Returns   : Pointer to the new cache or NULL on error
+ * Purpose   : Creates an in-memory cache of node row blocks.  Nodes are read a
+ *   block of rows at a time with hyp_read_node_rows and modified nodes are
+ *   written back with one batched write per block when the block is evicted
+ *   (least recently used) or when the cache is flushed or freed.
+ *******************************************************************************
+ </pre>*/
+HypNodeCache*   hyp_create_node_cache( HypHead *p, NV_INT32 rows_per_block, NV_INT32 max_blocks )
+{
+    HypNodeCache *c;
+    NV_INT32      i;
+
+    if( rows_per_block < 1 ) rows_per_block = 1;
+    if( rows_per_block > p->nrows ) rows_per_block = p->nrows;
+    if( max_blocks < 1 ) max_blocks = 1;
+
+    c = (HypNodeCache *) calloc( 1, sizeof(HypNodeCache) );
+    if( c == NULL )
+    {
+        sprintf( hyp_err_str, "Unable to allocate memory for hypothesis node cache." );
+        return NULL;
+    }
+
+    c->blocks = (HypNodeBlock *) calloc( max_blocks, sizeof(HypNodeBlock) );
+    if( c->blocks == NULL )
+    {
+        sprintf( hyp_err_str, "Unable to allocate memory for hypothesis node cache." );
+        free( c );
+        return NULL;
+    }
+
+    c->hyp            = p;
+    c->rows_per_block = rows_per_block;
+    c->max_blocks     = max_blocks;
+    for( i = 0; i < max_blocks; i++ )
+        c->blocks[i].start_row = -1;
+
+    return c;
+}
+
+/*! <pre>
+ *******************************************************************************
+ * Function  : hyp_flush_node_block
+ * Arguments : c - HypNodeCache
+ *             b - block to write
+ * Returns   : 0 on success, -1 on error
+ * Purpose   : Writes the modified nodes in a cached block back to the file.
+ *******************************************************************************
+ </pre>*/
+static NV_INT32     hyp_flush_node_block( HypNodeCache *c, HypNodeBlock *b )
+{
+    if( b->start_row < 0 || !b->modified )
+        return 0;
+
+    if( hyp_write_nodes( c->hyp, b->start_row, b->num_rows, b->nodes, b->dirty ) )
+        return -1;
+
+    memset( b->dirty, 0, b->num_rows * c->hyp->ncols );
+    b->modified = NVFalse;
+    return 0;
+}
+
+/*! <pre>
+ *******************************************************************************
+ * Function  : hyp_release_node_block
+ * Arguments : c - HypNodeCache
+ *             b - block to release
+ * Returns   :
+ * Purpose   : Frees the nodes in a cached block (without writing them).
+ *******************************************************************************
+ </pre>*/
+static void         hyp_release_node_block( HypNodeCache *c, HypNodeBlock *b )
+{
+    NV_INT32 i;
+
+    if( b->nodes )
+    {
+        for( i = 0; i < b->num_rows * c->hyp->ncols; i++ )
+            hyp_free_node_data( &b->nodes[i] );
+        free( b->nodes );
+    }
+    if( b->dirty )
+        free( b->dirty );
+
+    memset( b, 0, sizeof(HypNodeBlock) );
+    b->start_row = -1;
+}
+
+/*! <pre>
+ *******************************************************************************
+ * Function  : hyp_cache_get_node
+ * Arguments : c      - HypNodeCache
+ *             x, y   - column and row of the node
+ *             modify - if non-zero the node is marked dirty and will be
+ *                      written back to the file when its block is flushed
+ * Returns   : Pointer to the cached node or NULL on error
+ * Purpose   : Returns a node from the cache, reading its block of rows if it
+ *   isn't already cached.  The node belongs to the cache (don't free it) and
+ *   is only valid until the next call that loads a block (the block it is in
+ *   may be evicted to make room).  If you change n_hypos you must also
+ *   reallocate hypos (with malloc) to match.
+ *******************************************************************************
+ </pre>*/
+HypNode*    hyp_cache_get_node( HypNodeCache *c, NV_INT32 x, NV_INT32 y, NV_INT32 modify )
+{
+    HypHead      *p = c->hyp;
+    HypNodeBlock *b = NULL;
+    NV_INT32      i, start_row, count;
+
+    if( x < 0 || x >= p->ncols || y < 0 || y >= p->nrows )
+    {
+        sprintf( hyp_err_str, "Invalid hypothesis node %d, %d.", x, y );
+        return NULL;
+    }
+
+    start_row = ( y / c->rows_per_block ) * c->rows_per_block;
+
+    /* See if the block is already cached, otherwise use an empty or the least recently used block */
+    for( i = 0; i < c->max_blocks; i++ )
+    {
+        if( c->blocks[i].start_row == start_row )
+        {
+            b = &c->blocks[i];
+            break;
+        }
+    }
+
+    if( b == NULL )
+    {
+        b = &c->blocks[0];
+        for( i = 0; i < c->max_blocks; i++ )
+        {
+            if( c->blocks[i].start_row < 0 )
+            {
+                b = &c->blocks[i];
+                break;
+            }
+            if( c->blocks[i].last_used < b->last_used )
+                b = &c->blocks[i];
+        }
+
+        if( hyp_flush_node_block( c, b ) )
+            return NULL;
+        hyp_release_node_block( c, b );
+
+        b->num_rows = p->nrows - start_row;
+        if( b->num_rows > c->rows_per_block )
+            b->num_rows = c->rows_per_block;
+        count = b->num_rows * p->ncols;
+
+        b->nodes = (HypNode *) calloc( count, sizeof(HypNode) );
+        b->dirty = (NV_U_CHAR *) calloc( count, sizeof(NV_U_CHAR) );
+        if( b->nodes == NULL || b->dirty == NULL )
+        {
+            sprintf( hyp_err_str, "Unable to allocate memory for hypothesis node cache." );
+            hyp_release_node_block( c, b );
+            return NULL;
+        }
+
+        /* Inconsistent chains are reported but the nodes are still usable (same as hyp_get_node) */
+        hyp_read_node_rows( p, start_row, b->num_rows, b->nodes );
+        b->start_row = start_row;
+    }
+
+    b->last_used = ++c->clock;
+
+    i = ( y - start_row ) * p->ncols + x;
+    if( modify )
+    {
+        b->dirty[i] = 1;
+        b->modified = NVTrue;
+    }
+
+    return &b->nodes[i];
+}
+
+/*! <pre>
+ *******************************************************************************
+ * Function  : hyp_flush_node_cache
+ * Arguments : c - HypNodeCache
+ * Returns   : 0 on success, -1 on error
+ * Purpose   : Writes all modified nodes in the cache back to the file.  The
+ *   blocks stay in the cache.
+ *******************************************************************************
+ </pre>*/
+NV_INT32    hyp_flush_node_cache( HypNodeCache *c )
+{
+    NV_INT32 i, status = 0;
+
+    for( i = 0; i < c->max_blocks; i++ )
+    {
+        if( hyp_flush_node_block( c, &c->blocks[i] ) )
+            status = -1;
+    }
+
+    return status;
+}
+
+/*! <pre>
+ *******************************************************************************
+ * Function  : hyp_free_node_cache
+ * Arguments : c - HypNodeCache
+ * Returns   : 0 on success, -1 if any modified nodes couldn't be written
+ * Purpose   : Writes all modified nodes back to the file and frees the cache.
+ *******************************************************************************
+ </pre>*/
+NV_INT32    hyp_free_node_cache( HypNodeCache *c )
+{
+    NV_INT32 i, status;
+
+    status = hyp_flush_node_cache( c );
+
+    for( i = 0; i < c->max_blocks; i++ )
+        hyp_release_node_block( c, &c->blocks[i] );
+
+    free( c->blocks );
+    free( c );
+
+    return status;
+}
+
 /*! <pre>
  *******************************************************************************
  * Function  : hyp_fwrite
@@ -259,6 +259,29 @@ typedef struct _HypHead
 }
 HypHead;
 
+/*! A block of rows of nodes held in a HypNodeCache */
+typedef struct _HypNodeBlock
+{
+    NV_INT32    start_row;          /*!< First row in the block (-1 if the block is empty) */
+    NV_INT32    num_rows;           /*!< Number of rows in the block */
+    HypNode    *nodes;              /*!< num_rows * ncols nodes (row major) */
+    NV_U_CHAR  *dirty;              /*!< Non-zero for each node that has been modified */
+    NV_BOOL     modified;           /*!< NVTrue if any node in the block has been modified */
+    NV_U_INT32  last_used;          /*!< Cache clock value the last time the block was used */
+}
+HypNodeBlock;
+
+/*! In-memory cache of node row blocks - see hyp_create_node_cache */
+typedef struct _HypNodeCache
+{
+    HypHead      *hyp;              /*!< Hypothesis file the cache is reading from and writing to */
+    NV_INT32      rows_per_block;   /*!< Number of rows read or written at a time */
+    NV_INT32      max_blocks;       /*!< Maximum number of blocks in memory */
+    HypNodeBlock *blocks;           /*!< The blocks */
+    NV_U_INT32    clock;            /*!< Incremented each time a block is used (for LRU eviction) */
+}
+HypNodeCache;
+
 /*****************************************************************************
  ***
  *** Hypothesis Public API functions
@@ -298,6 +321,21 @@ NV_INT32     hyp_read_header( HypHead *p );
 NV_INT32     hyp_read_node( HypHead *p, NV_INT32 x, NV_INT32 y, HypNode *node );
 NV_INT32     hyp_write_node( HypHead *p, NV_INT32 x, NV_INT32 y, HypNode *node );
 
+/*! Reads or writes all of the nodes in num_rows rows starting at start_row using a few large
+ * reads and writes instead of several small ones per node.  nodes is num_rows * ncols nodes in
+ * row major order (zero them before the first read).
+ */
+NV_INT32     hyp_read_node_rows( HypHead *p, NV_INT32 start_row, NV_INT32 num_rows, HypNode *nodes );
+NV_INT32     hyp_write_node_rows( HypHead *p, NV_INT32 start_row, NV_INT32 num_rows, HypNode *nodes );
+
+/*! Node cache - nodes are read a block of rows at a time and modified nodes are written back
+ * when their block is evicted or the cache is flushed or freed.
+ */
+HypNodeCache* hyp_create_node_cache( HypHead *p, NV_INT32 rows_per_block, NV_INT32 max_blocks );
+HypNode*     hyp_cache_get_node( HypNodeCache *c, NV_INT32 x, NV_INT32 y, NV_INT32 modify );
+NV_INT32     hyp_flush_node_cache( HypNodeCache *c );
+NV_INT32     hyp_free_node_cache( HypNodeCache *c );
+
 #ifdef  __cplusplus
 }
 #endif
@@ -939,6 +939,27 @@ typedef struct
 } DEPTH_RECORD;
 
 
+  /*!
+    Per-bin statistics record.  These are stored in an optional sidecar file (.sts) that lives next to the
+    bin file.  If the sidecar exists it is opened along with the PFM structure and every call to one of the
+    recompute_bin_values functions refreshes the record for that bin.  This allows applications (e.g. the
+    pfmView highlight modes) to get information that isn't in the BIN_RECORD without reading every depth
+    record in the bin.  Use check_bin_stats to make sure the record matches the bin record before you use it.
+  */
+
+typedef struct
+{
+  NV_U_INT32      num_soundings;              /*!<  Number of soundings in the bin when the record was computed  */
+  NV_U_INT32      num_valid;                  /*!<  Number of soundings not marked PFM_INVAL or PFM_DELETED  */
+  NV_U_INT32      num_lines;                  /*!<  Number of distinct line numbers in the bin  */
+  NV_FLOAT32      avg_filtered_depth;         /*!<  Average filtered depth that max_offset was computed against  */
+  NV_FLOAT32      max_offset;                 /*!<  Maximum absolute difference between avg_filtered_depth and any
+                                                    sounding not marked PFM_INVAL, PFM_DELETED, or PFM_REFERENCE  */
+  NV_FLOAT32      max_horizontal_error;       /*!<  Maximum horizontal error of the valid soundings  */
+  NV_FLOAT32      max_vertical_error;         /*!<  Maximum vertical error of the valid soundings  */
+} BIN_STATS;
+
+
   /*!  PFM file open arguments.  */
 
 typedef struct
@@ -1131,6 +1152,11 @@ typedef struct
 #define             PFM_GEO_DISTANCE_OUT_OF_BOUNDS                  -61
 #define             OPEN_LIST_FILE_NEWER_VERSION_ERROR              -62
 #define             OPEN_HANDLE_FILE_OPEN_ERROR                     -63
+#define             OPEN_BIN_STATS_OPEN_ERROR                       -64
+#define             OPEN_BIN_STATS_CORRUPT_HEADER_ERROR             -65
+#define             READ_BIN_STATS_NOT_OPEN_ERROR                   -66
+#define             READ_BIN_STATS_READ_ERROR                       -67
+#define             WRITE_BIN_STATS_WRITE_ERROR                     -68
 
 
 /*!
@@ -1407,8 +1433,15 @@ void clear_flag (NV_U_BYTE *field, NV_U_BYTE flag);
 void pfm_register_progress_callback (PFM_PROGRESS_CALLBACK progressCB);
 NV_INT32 get_data_extents (NV_INT32 hnd, NV_I32_COORD2 *min_coord, NV_I32_COORD2 *max_coord);
 void compute_center_xy (NV_F64_COORD2 *xy, NV_I32_COORD2 coord, BIN_HEADER *bin);
+NV_INT32 pfm_geo_distance_init (NV_INT32 hnd);
 NV_INT32 pfm_geo_distance (NV_INT32 hnd, NV_FLOAT64 lat0, NV_FLOAT64 lon0, NV_FLOAT64 lat1, NV_FLOAT64 lon1, NV_FLOAT64 *distance);
+NV_INT32 pfm_geo_distance_xy (NV_INT32 hnd, NV_INT32 count, NV_FLOAT64 *lat, NV_FLOAT64 *lon, NV_FLOAT64 *x, NV_FLOAT64 *y);
 NV_INT32 pfm_get_io_type (NV_INT32 hnd);
+NV_INT32 open_bin_stats (NV_INT32 hnd, NV_BOOL create);
+NV_BOOL bin_stats_available (NV_INT32 hnd);
+NV_INT32 read_bin_stats_index (NV_INT32 hnd, NV_I32_COORD2 coord, BIN_STATS *stats);
+NV_INT32 read_bin_stats_row (NV_INT32 hnd, NV_INT32 length, NV_INT32 row, NV_INT32 column, BIN_STATS a[]);
+NV_BOOL check_bin_stats (NV_INT32 hnd, BIN_RECORD *bin, BIN_STATS *stats);
 
 
 #ifdef  __cplusplus
@@ -144,6 +144,18 @@ static NV_BOOL                  geo_dist_init[MAX_PFM_FILES];
 
 
 
+/*  Per-bin statistics sidecar data (see BIN_STATS in pfm.h).  */
+
+#define BIN_STATS_HEADER_SIZE   64                       /*!<  Bin statistics file header size  */
+#define BIN_STATS_RECORD_SIZE   28                       /*!<  Packed bin statistics record size  */
+#define BIN_STATS_VERSION       "PFM Bin Statistics V1.0"
+
+static NV_INT32                 stats_handle[MAX_PFM_FILES];
+static NV_BOOL                  stats_open[MAX_PFM_FILES];
+static NV_BOOL                  stats_writable[MAX_PFM_FILES];
+static NV_CHAR                  stats_path[MAX_PFM_FILES][512];
+
+
 /*  PFM error status            */
 
 static NV_CHAR                  pfm_err_str[512];
@@ -3868,6 +3880,26 @@ NV_INT32 open_pfm_file (PFM_OPEN_ARGS *open_args)
     strcpy (list_path[hnd], dir_list_path);
 
 
+    /*  The optional bin statistics file is the bin file name with a .sts extension.  If it already exists we
+        open it now so that the recompute_bin_values functions will keep it current.  It's not an error if it
+        doesn't exist or can't be opened.  */
+
+    strcpy (stats_path[hnd], open_args->bin_path);
+    if (strlen (stats_path[hnd]) > 4 && !strcmp (&stats_path[hnd][strlen (stats_path[hnd]) - 4], ".bin"))
+      {
+        sprintf (&stats_path[hnd][strlen (stats_path[hnd]) - 4], ".sts");
+      }
+    else
+      {
+        strcat (stats_path[hnd], ".sts");
+      }
+
+    stats_open[hnd] = NVFalse;
+    status = pfm_error;
+    open_bin_stats (hnd, NVFalse);
+    pfm_error = status;
+
+
     /*  Set the null values for horizontal and vertical error based on the number
         of bits used to store them.  This maximizes use of the error field bits.  */
 
@@ -4069,6 +4101,12 @@ void close_pfm_file (NV_INT32 hnd)
 
     close_index (hnd);
 
+    if (stats_open[hnd])
+    {
+        lfclose (stats_handle[hnd]);
+        stats_open[hnd] = NVFalse;
+    }
+
 
     /*  Remove the checkpoint file.  */
 
@@ -7816,6 +7854,518 @@ NV_INT32 add_depth_record_xy (NV_INT32 hnd, DEPTH_RECORD *depth)
 }
 
 
+/***************************************************************************/
+/*!
+
+  - Module Name:        open_bin_stats
+
+  - Programmer(s):      Jan C. Depner
+
+  - Date Written:       October 2026
+
+  - Purpose:            Opens (or creates) the optional bin statistics
+                        file that is associated with the bin file.  This
+                        is called by open_pfm_file with create set to
+                        NVFalse so that an existing statistics file will
+                        be kept current by the recompute_bin_values
+                        functions.  Loaders should call it with create set
+                        to NVTrue prior to recomputing the bins if they
+                        want the statistics to be available.
+
+  - Arguments:
+                        - hnd             =   PFM file handle
+                        - create          =   NVTrue to create the file if
+                                              it doesn't exist
+
+  - Return Value:
+                        - SUCCESS
+                        - OPEN_BIN_STATS_OPEN_ERROR
+                        - OPEN_BIN_STATS_CORRUPT_HEADER_ERROR
+
+  - Caveats:            The statistics records are only refreshed by the
+                        recompute_bin_values functions.  If you modify
+                        depth records without recomputing the bin the
+                        statistics record will be stale.  This is the same
+                        rule that applies to the bin record itself.  Bins
+                        that were loaded prior to creating the statistics
+                        file will not have valid statistics until they are
+                        recomputed.  Use check_bin_stats prior to using a
+                        record.
+
+****************************************************************************/
+
+NV_INT32 open_bin_stats (NV_INT32 hnd, NV_BOOL create)
+{
+    NV_U_BYTE           header[BIN_STATS_HEADER_SIZE];
+    NV_INT32            width, height;
+
+
+#ifdef PFM_DEBUG
+    fprintf (stderr,"%s %d\n",__FILE__,__LINE__); fflush (stderr);
+#endif
+
+
+    if (stats_open[hnd]) return (pfm_error = SUCCESS);
+
+
+    stats_writable[hnd] = NVTrue;
+
+    if ((stats_handle[hnd] = lfopen (stats_path[hnd], "rb+")) < 0)
+    {
+        if (errno == EACCES)
+        {
+            if ((stats_handle[hnd] = lfopen (stats_path[hnd], "rb")) < 0)
+            {
+                sprintf (pfm_err_str, "Unable to open bin statistics file %s", stats_path[hnd]);
+                return (pfm_error = OPEN_BIN_STATS_OPEN_ERROR);
+            }
+            stats_writable[hnd] = NVFalse;
+        }
+        else
+        {
+            if (!create || (stats_handle[hnd] = lfopen (stats_path[hnd], "wb+")) < 0)
+            {
+                sprintf (pfm_err_str, "Unable to open bin statistics file %s", stats_path[hnd]);
+                return (pfm_error = OPEN_BIN_STATS_OPEN_ERROR);
+            }
+
+
+            /*  New file, write the header.  The records are written as the bins are recomputed so unwritten
+                records will read back as zero (which check_bin_stats will reject).  */
+
+            memset (header, 0, BIN_STATS_HEADER_SIZE);
+            strcpy ((NV_CHAR *) header, BIN_STATS_VERSION);
+            pfm_bit_pack (header, 256, 32, bin_header[hnd].bin_width);
+            pfm_bit_pack (header, 288, 32, bin_header[hnd].bin_height);
+
+            if (!lfwrite (header, BIN_STATS_HEADER_SIZE, 1, stats_handle[hnd]))
+            {
+                lfclose (stats_handle[hnd]);
+                sprintf (pfm_err_str, "Unable to write bin statistics file header %s", stats_path[hnd]);
+                return (pfm_error = OPEN_BIN_STATS_OPEN_ERROR);
+            }
+
+            stats_open[hnd] = NVTrue;
+
+            return (pfm_error = SUCCESS);
+        }
+    }
+
+
+    /*  Check the header of an existing file.  If the bin dimensions don't match it isn't ours.  */
+
+    lfseek (stats_handle[hnd], 0, SEEK_SET);
+    if (!lfread (header, BIN_STATS_HEADER_SIZE, 1, stats_handle[hnd]) ||
+        strncmp ((NV_CHAR *) header, BIN_STATS_VERSION, strlen (BIN_STATS_VERSION)))
+    {
+        lfclose (stats_handle[hnd]);
+        sprintf (pfm_err_str, "Bin statistics file %s header corrupt", stats_path[hnd]);
+        return (pfm_error = OPEN_BIN_STATS_CORRUPT_HEADER_ERROR);
+    }
+
+    width = pfm_bit_unpack (header, 256, 32);
+    height = pfm_bit_unpack (header, 288, 32);
+
+    if (width != bin_header[hnd].bin_width || height != bin_header[hnd].bin_height)
+    {
+        lfclose (stats_handle[hnd]);
+        sprintf (pfm_err_str, "Bin statistics file %s dimensions do not match the bin file", stats_path[hnd]);
+        return (pfm_error = OPEN_BIN_STATS_CORRUPT_HEADER_ERROR);
+    }
+
+    stats_open[hnd] = NVTrue;
+
+
+#ifdef PFM_DEBUG
+    fprintf (stderr,"%s %d\n",__FILE__,__LINE__); fflush (stderr);
+#endif
+
+
+    return (pfm_error = SUCCESS);
+}
+
+
+/***************************************************************************/
+/*!
+
+  - Module Name:        bin_stats_available
+
+  - Programmer(s):      Jan C. Depner
+
+  - Date Written:       October 2026
+
+  - Purpose:            Returns NVTrue if the bin statistics file is open
+                        for this PFM.
+
+  - Arguments:
+                        - hnd             =   PFM file handle
+
+  - Return Value:
+                        - NVTrue or NVFalse
+
+****************************************************************************/
+
+NV_BOOL bin_stats_available (NV_INT32 hnd)
+{
+    return (stats_open[hnd]);
+}
+
+
+/***************************************************************************/
+/*!
+
+  - Module Name:        pack_bin_stats / unpack_bin_stats
+
+  - Programmer(s):      Jan C. Depner
+
+  - Date Written:       October 2026
+
+  - Purpose:            Packs/unpacks a bin statistics record.  The float
+                        values are stored as their 32 bit IEEE images so
+                        that we don't lose anything to scaling.  These
+                        functions are only used internal to the library.
+
+****************************************************************************/
+
+static void pack_bin_stats (NV_U_BYTE *buffer, BIN_STATS *stats)
+{
+    NV_U_INT32          bits;
+
+
+    pfm_bit_pack (buffer, 0, 32, stats->num_soundings);
+    pfm_bit_pack (buffer, 32, 32, stats->num_valid);
+    pfm_bit_pack (buffer, 64, 32, stats->num_lines);
+
+    memcpy (&bits, &stats->avg_filtered_depth, 4);
+    pfm_bit_pack (buffer, 96, 32, bits);
+    memcpy (&bits, &stats->max_offset, 4);
+    pfm_bit_pack (buffer, 128, 32, bits);
+    memcpy (&bits, &stats->max_horizontal_error, 4);
+    pfm_bit_pack (buffer, 160, 32, bits);
+    memcpy (&bits, &stats->max_vertical_error, 4);
+    pfm_bit_pack (buffer, 192, 32, bits);
+}
+
+
+static void unpack_bin_stats (NV_U_BYTE *buffer, BIN_STATS *stats)
+{
+    NV_U_INT32          bits;
+
+
+    stats->num_soundings = pfm_bit_unpack (buffer, 0, 32);
+    stats->num_valid = pfm_bit_unpack (buffer, 32, 32);
+    stats->num_lines = pfm_bit_unpack (buffer, 64, 32);
+
+    bits = pfm_bit_unpack (buffer, 96, 32);
+    memcpy (&stats->avg_filtered_depth, &bits, 4);
+    bits = pfm_bit_unpack (buffer, 128, 32);
+    memcpy (&stats->max_offset, &bits, 4);
+    bits = pfm_bit_unpack (buffer, 160, 32);
+    memcpy (&stats->max_horizontal_error, &bits, 4);
+    bits = pfm_bit_unpack (buffer, 192, 32);
+    memcpy (&stats->max_vertical_error, &bits, 4);
+}
+
+
+/***************************************************************************/
+/*!
+
+  - Module Name:        compute_bin_stats
+
+  - Programmer(s):      Jan C. Depner
+
+  - Date Written:       October 2026
+
+  - Purpose:            Computes the statistics record for a bin from its
+                        depth records.  The bin record must already contain
+                        the recomputed average filtered depth.  This
+                        function is only used internal to the library.
+
+  - Arguments:
+                        - hnd             =   PFM file handle
+                        - bin             =   BIN_RECORD structure
+                        - depth           =   depth record array
+                        - numrecs         =   number of depth records
+                        - stats           =   returned statistics record
+
+  - Return Value:
+                        - void
+
+****************************************************************************/
+
+static int compare_line_numbers (const void *a, const void *b)
+{
+    NV_U_INT32 sa = *((NV_U_INT32 *) a), sb = *((NV_U_INT32 *) b);
+
+    if (sa < sb) return (-1);
+    if (sa > sb) return (1);
+    return (0);
+}
+
+
+static void compute_bin_stats (NV_INT32 hnd, BIN_RECORD *bin, DEPTH_RECORD *depth, NV_INT32 numrecs, BIN_STATS *stats)
+{
+    NV_INT32            i;
+    NV_U_INT32          *lines;
+    NV_FLOAT64          offset;
+
+
+    memset (stats, 0, sizeof (BIN_STATS));
+
+    stats->num_soundings = bin->num_soundings;
+    stats->avg_filtered_depth = bin->avg_filtered_depth;
+
+    for (i = 0 ; i < numrecs ; i++)
+    {
+        if (!(depth[i].validity & (PFM_DELETED | PFM_INVAL)))
+        {
+            stats->num_valid++;
+
+            if (depth[i].horizontal_error > stats->max_horizontal_error)
+                stats->max_horizontal_error = depth[i].horizontal_error;
+            if (depth[i].vertical_error > stats->max_vertical_error)
+                stats->max_vertical_error = depth[i].vertical_error;
+
+            if (!(depth[i].validity & PFM_REFERENCE))
+            {
+                offset = fabs (depth[i].xyz.z - bin->avg_filtered_depth);
+                if (offset > stats->max_offset) stats->max_offset = offset;
+            }
+        }
+    }
+
+
+    /*  Count the distinct line numbers.  Most bins only have one or two lines so check the easy case first.  */
+
+    if (numrecs) stats->num_lines = 1;
+
+    for (i = 1 ; i < numrecs ; i++)
+    {
+        if (depth[i].line_number != depth[0].line_number) break;
+    }
+
+    if (i < numrecs)
+    {
+        lines = (NV_U_INT32 *) malloc (numrecs * sizeof (NV_U_INT32));
+
+        if (lines == NULL)
+        {
+            stats->num_lines = 2;
+        }
+        else
+        {
+            for (i = 0 ; i < numrecs ; i++) lines[i] = depth[i].line_number;
+
+            qsort (lines, numrecs, sizeof (NV_U_INT32), compare_line_numbers);
+
+            for (i = 1 ; i < numrecs ; i++)
+            {
+                if (lines[i] != lines[i - 1]) stats->num_lines++;
+            }
+
+            free (lines);
+        }
+    }
+}
+
+
+/***************************************************************************/
+/*!
+
+  - Module Name:        write_bin_stats
+
+  - Programmer(s):      Jan C. Depner
+
+  - Date Written:       October 2026
+
+  - Purpose:            Writes a single bin statistics record.  This
+                        function is only used internal to the library.
+
+  - Arguments:
+                        - hnd             =   PFM file handle
+                        - coord           =   X and Y index values
+                        - stats           =   statistics record
+
+  - Return Value:
+                        - SUCCESS
+                        - WRITE_BIN_STATS_WRITE_ERROR
+
+****************************************************************************/
+
+static NV_INT32 write_bin_stats (NV_INT32 hnd, NV_I32_COORD2 coord, BIN_STATS *stats)
+{
+    NV_U_BYTE           buffer[BIN_STATS_RECORD_SIZE];
+    NV_INT64            address;
+
+
+    address = ((NV_INT64) coord.y * (NV_INT64) bin_header[hnd].bin_width + coord.x) *
+        (NV_INT64) BIN_STATS_RECORD_SIZE + BIN_STATS_HEADER_SIZE;
+
+    pack_bin_stats (buffer, stats);
+
+    lfseek (stats_handle[hnd], address, SEEK_SET);
+    if (!lfwrite (buffer, BIN_STATS_RECORD_SIZE, 1, stats_handle[hnd]))
+    {
+        sprintf (pfm_err_str, "Unable to write to bin statistics file");
+        return (pfm_error = WRITE_BIN_STATS_WRITE_ERROR);
+    }
+
+    return (pfm_error = SUCCESS);
+}
+
+
+/***************************************************************************/
+/*!
+
+  - Module Name:        read_bin_stats_row
+
+  - Programmer(s):      Jan C. Depner
+
+  - Date Written:       October 2026
+
+  - Purpose:            Reads a row of bin statistics records of length
+                        "length", at row "row", and column "column" with a
+                        single read.  This is the statistics counterpart
+                        of read_bin_row.  Records that have never been
+                        written are returned zeroed.
+
+  - Arguments:
+                        - hnd             =   PFM file handle
+                        - length          =   number of columns to read
+                        - row             =   row
+                        - column          =   starting column
+                        - a               =   array of BIN_STATS records
+
+  - Return Value:
+                        - SUCCESS
+                        - READ_BIN_STATS_NOT_OPEN_ERROR
+                        - READ_BIN_STATS_READ_ERROR
+
+****************************************************************************/
+
+NV_INT32 read_bin_stats_row (NV_INT32 hnd, NV_INT32 length, NV_INT32 row, NV_INT32 column, BIN_STATS a[])
+{
+    NV_INT32            i;
+    NV_U_BYTE           *buffer;
+    NV_INT64            address;
+
+
+#ifdef PFM_DEBUG
+    fprintf (stderr,"%s %d\n",__FILE__,__LINE__); fflush (stderr);
+#endif
+
+
+    if (!stats_open[hnd])
+    {
+        sprintf (pfm_err_str, "No bin statistics file for this PFM");
+        return (pfm_error = READ_BIN_STATS_NOT_OPEN_ERROR);
+    }
+
+
+    address = ((NV_INT64) row * (NV_INT64) bin_header[hnd].bin_width + column) *
+        (NV_INT64) BIN_STATS_RECORD_SIZE + BIN_STATS_HEADER_SIZE;
+
+
+    /*  Use calloc so that a short read (records past the end of the file that haven't been written yet)
+        leaves zeroed records.  */
+
+    buffer = (NV_U_BYTE *) calloc (length, BIN_STATS_RECORD_SIZE);
+
+    if (buffer == NULL)
+    {
+        sprintf (pfm_err_str, "Allocating memory in read_bin_stats_row");
+        return (pfm_error = READ_BIN_STATS_READ_ERROR);
+    }
+
+    lfseek (stats_handle[hnd], address, SEEK_SET);
+    lfread (buffer, BIN_STATS_RECORD_SIZE, length, stats_handle[hnd]);
+
+    for (i = 0 ; i < length ; i++) unpack_bin_stats (&buffer[i * BIN_STATS_RECORD_SIZE], &a[i]);
+
+    free (buffer);
+
+
+#ifdef PFM_DEBUG
+    fprintf (stderr,"%s %d\n",__FILE__,__LINE__); fflush (stderr);
+#endif
+
+
+    return (pfm_error = SUCCESS);
+}
+
+
+/***************************************************************************/
+/*!
+
+  - Module Name:        read_bin_stats_index
+
+  - Programmer(s):      Jan C. Depner
+
+  - Date Written:       October 2026
+
+  - Purpose:            Reads the bin statistics record at index coord.
+
+  - Arguments:
+                        - hnd             =   PFM file handle
+                        - coord           =   X and Y index values
+                        - stats           =   BIN_STATS record
+
+  - Return Value:
+                        - SUCCESS
+                        - READ_BIN_STATS_NOT_OPEN_ERROR
+                        - READ_BIN_STATS_READ_ERROR
+
+****************************************************************************/
+
+NV_INT32 read_bin_stats_index (NV_INT32 hnd, NV_I32_COORD2 coord, BIN_STATS *stats)
+{
+    return (read_bin_stats_row (hnd, 1, coord.y, coord.x, stats));
+}
+
+
+/***************************************************************************/
+/*!
+
+  - Module Name:        check_bin_stats
+
+  - Programmer(s):      Jan C. Depner
+
+  - Date Written:       October 2026
+
+  - Purpose:            Checks that a bin statistics record was computed
+                        from the current contents of the bin.  The number
+                        of soundings must match and the average filtered
+                        depth must match to within the depth resolution
+                        (the bin record value has been through the bit
+                        packing).
+
+  - Arguments:
+                        - hnd             =   PFM file handle
+                        - bin             =   BIN_RECORD read from the bin file
+                        - stats           =   BIN_STATS record for the same bin
+
+  - Return Value:
+                        - NVTrue if the statistics can be used
+                        - NVFalse if they are stale or were never computed
+
+****************************************************************************/
+
+NV_BOOL check_bin_stats (NV_INT32 hnd, BIN_RECORD *bin, BIN_STATS *stats)
+{
+    NV_FLOAT64          resolution;
+
+
+    if (!stats->num_soundings || stats->num_soundings != bin->num_soundings) return (NVFalse);
+
+    resolution = 1.0;
+    if (hd[hnd].depth_scale > 0.0) resolution = 1.0 / hd[hnd].depth_scale;
+
+    if (fabs (stats->avg_filtered_depth - bin->avg_filtered_depth) > resolution) return (NVFalse);
+
+    return (NVTrue);
+}
+
+
 /***************************************************************************/
 /*!
 
@@ -8029,7 +8579,6 @@ static NV_INT32 recompute_bin_values (NV_INT32 hnd, BIN_RECORD *bin, NV_U_INT32
                 /*if (bin->validity & PFM_CHECKED) bin->validity &= ~PFM_SUSPECT;*/
             }
         }
-        if (depth == NULL) free (depth_record);
 
 
 
@@ -8083,6 +8632,20 @@ static NV_INT32 recompute_bin_values (NV_INT32 hnd, BIN_RECORD *bin, NV_U_INT32
         }
 
 
+        /*  Refresh the bin statistics record if we have a statistics file.  This has to be done after the
+            average filtered depth has been computed.  */
+
+        if (stats_open[hnd] && stats_writable[hnd])
+        {
+            BIN_STATS stats;
+
+            compute_bin_stats (hnd, bin, depth_record, numrecs, &stats);
+            write_bin_stats (hnd, bin->coord, &stats);
+        }
+
+        if (depth == NULL) free (depth_record);
+
+
         /*  Write the record out.   */
 
         if (write_bin_record_index (hnd, bin))
@@ -9217,6 +9780,102 @@ NV_INT32 bin_inside_ptr (BIN_HEADER *bin, NV_F64_COORD2 xy)
 }
 
 
+/***************************************************************************/
+/*!
+
+  - Module Name:        pfm_geo_distance_init
+
+  - Programmer(s):      Jan C. Depner
+
+  - Date Written:       October 2026
+
+  - Purpose:            Compute the actual X bin size at each Y bin
+                        boundary for pfm_geo_distance and
+                        pfm_geo_distance_xy.  This is done automatically
+                        the first time pfm_geo_distance is called for a PFM
+                        but, if you are going to call pfm_geo_distance from
+                        more than one thread using the same handle, call
+                        this first.  After the tables are built they are
+                        only read so the distance functions may then be
+                        called from any number of threads.
+
+  - Arguments:
+                        - hnd             =   PFM file handle
+
+  - Return Value:
+                        - SUCCESS
+                        - PFM_GEO_DISTANCE_NOT_GEOGRAPHIC_ERROR
+                        - PFM_GEO_DISTANCE_LATLON_PFM_ERROR
+                        - PFM_GEO_DISTANCE_ALLOCATE_ERROR
+
+****************************************************************************/
+
+NV_INT32 pfm_geo_distance_init (NV_INT32 hnd)
+{
+  NV_INT32                i;
+  NV_FLOAT64              az;
+
+
+  if (geo_dist_init[hnd]) return (pfm_error = SUCCESS);
+
+
+  /*  Error out if this is a projected PFM.  */
+
+  if (bin_header[hnd].proj_data.projection)
+    {
+      sprintf (pfm_err_str, "pfm_geo_distance does not work with projected PFM structures");
+      return (pfm_error = PFM_GEO_DISTANCE_NOT_GEOGRAPHIC_ERROR);
+    }
+
+
+  /*  Error out if this is a lat/lon unprojected PFM.  */
+
+  if (bin_header[hnd].bin_size_xy == 0.0)
+    {
+      sprintf (pfm_err_str, "pfm_geo_distance does not work with equal lat/lon PFM structures");
+      return (pfm_error = PFM_GEO_DISTANCE_LATLON_PFM_ERROR);
+    }
+
+
+  /*  Allocate the memory.  */
+
+  geo_distance[hnd] = (NV_FLOAT64 *) calloc (bin_header[hnd].bin_height + 2, sizeof (NV_FLOAT64));
+  if (geo_distance[hnd] == NULL) 
+    {
+      sprintf (pfm_err_str, "Unable to allocate geo_distance array in pfm_geo_distance");
+      return (pfm_error = PFM_GEO_DISTANCE_ALLOCATE_ERROR);
+    }
+
+  geo_post[hnd] = (NV_FLOAT64 *) calloc (bin_header[hnd].bin_height + 2, sizeof (NV_FLOAT64));
+  if (geo_post[hnd] == NULL)
+    {
+      sprintf (pfm_err_str, "Unable to allocate geo_post array in pfm_geo_distance");
+      return (pfm_error = PFM_GEO_DISTANCE_ALLOCATE_ERROR);
+    }
+
+
+  /*  Get the incremental distances.  Go one extra to cover points on the upper boundary.  */
+
+  for (i = 0 ; i <= bin_header[hnd].bin_height + 1 ; i++)
+    {
+      /*  Get the latitude "post" positions.  */
+
+      geo_post[hnd][i] = bin_header[hnd].mbr.min_y + (NV_FLOAT64) i * bin_header[hnd].y_bin_size_degrees;
+
+
+      /*  Compute the actual X bin size at this lat band.  */
+
+      pfm_invgp (A0, B0, geo_post[hnd][i], bin_header[hnd].mbr.min_x, geo_post[hnd][i], bin_header[hnd].mbr.min_x +
+                 bin_header[hnd].x_bin_size_degrees, &geo_distance[hnd][i], &az);
+    }
+
+  geo_dist_init[hnd] = NVTrue;
+
+  return (pfm_error = SUCCESS);
+}
+
+
+
 /***************************************************************************/
 /*!
 
@@ -9272,67 +9931,13 @@ NV_INT32 bin_inside_ptr (BIN_HEADER *bin, NV_F64_COORD2 xy)
 NV_INT32 pfm_geo_distance (NV_INT32 hnd, NV_FLOAT64 lat0, NV_FLOAT64 lon0, NV_FLOAT64 lat1, NV_FLOAT64 lon1,
                            NV_FLOAT64 *distance)
 {
-  NV_INT32                i;
-  NV_FLOAT64              az, x_dist[2], x[2], y[2], x_bin_size, next_lat;
+  NV_FLOAT64              x_dist[2], x[2], y[2], x_bin_size, next_lat;
   NV_I32_COORD2           coord[2];
 
 
   /*  The first time we open a PFM we need to compute the actual X bin size at each Y bin boundary.  */
 
-  if (!geo_dist_init[hnd])
-    {
-      /*  Error out if this is a projected PFM.  */
-
-      if (bin_header[hnd].proj_data.projection)
-        {
-          sprintf (pfm_err_str, "pfm_geo_distance does not work with projected PFM structures");
-          return (pfm_error = PFM_GEO_DISTANCE_NOT_GEOGRAPHIC_ERROR);
-        }
-
-
-      /*  Error out if this is a lat/lon unprojected PFM.  */
-
-      if (bin_header[hnd].bin_size_xy == 0.0)
-        {
-          sprintf (pfm_err_str, "pfm_geo_distance does not work with equal lat/lon PFM structures");
-          return (pfm_error = PFM_GEO_DISTANCE_LATLON_PFM_ERROR);
-        }
-
-
-      /*  Allocate the memory.  */
-
-      geo_distance[hnd] = (NV_FLOAT64 *) calloc (bin_header[hnd].bin_height + 2, sizeof (NV_FLOAT64));
-      if (geo_distance[hnd] == NULL) 
-        {
-          sprintf (pfm_err_str, "Unable to allocate geo_distance array in pfm_geo_distance");
-          return (PFM_GEO_DISTANCE_ALLOCATE_ERROR);
-        }
-
-      geo_post[hnd] = (NV_FLOAT64 *) calloc (bin_header[hnd].bin_height + 2, sizeof (NV_FLOAT64));
-      if (geo_post[hnd] == NULL)
-        {
-          sprintf (pfm_err_str, "Unable to allocate geo_post array in pfm_geo_distance");
-          return (PFM_GEO_DISTANCE_ALLOCATE_ERROR);
-        }
-
-
-      /*  Get the incremental distances.  Go one extra to cover points on the upper boundary.  */
-
-      for (i = 0 ; i <= bin_header[hnd].bin_height + 1 ; i++)
-        {
-          /*  Get the latitude "post" positions.  */
-
-          geo_post[hnd][i] = bin_header[hnd].mbr.min_y + (NV_FLOAT64) i * bin_header[hnd].y_bin_size_degrees;
-
-
-          /*  Compute the actual X bin size at this lat band.  */
-
-          pfm_invgp (A0, B0, geo_post[hnd][i], bin_header[hnd].mbr.min_x, geo_post[hnd][i], bin_header[hnd].mbr.min_x +
-                     bin_header[hnd].x_bin_size_degrees, &geo_distance[hnd][i], &az);
-        }
-
-      geo_dist_init[hnd] = NVTrue;
-    }
+  if (!geo_dist_init[hnd] && pfm_geo_distance_init (hnd)) return (pfm_error);
 
 
   /*  Check the points.  */
@@ -9398,6 +10003,108 @@ NV_INT32 pfm_geo_distance (NV_INT32 hnd, NV_FLOAT64 lat0, NV_FLOAT64 lon0, NV_FL
 
 
 
+/***************************************************************************/
+/*!
+
+  - Module Name:        pfm_geo_distance_xy
+
+  - Programmer(s):      Jan C. Depner
+
+  - Date Written:       October 2026
+
+  - Purpose:            Convert arrays of positions in a geographic PFM to
+                        X and Y in meters from the southwest corner of the
+                        PFM.
+
+  - Method:             X is the distance along the southern boundary of
+                        the PFM from min_x to the longitude and Y is the
+                        distance along the western boundary from min_y to
+                        the latitude.  These are exactly the values that
+                        you would get from
+                        pfm_geo_distance (hnd, min_y, min_x, min_y, lon, &x)
+                        and
+                        pfm_geo_distance (hnd, min_y, min_x, lat, min_x, &y)
+                        but without a function call and table lookups per
+                        point so the loop can be vectorized.  Use this for
+                        fast proximity checks in small areas.
+
+  - Arguments:
+                        - hnd             =   PFM file handle
+                        - count           =   number of points
+                        - lat             =   latitudes
+                        - lon             =   longitudes
+                        - x               =   returned X values (meters)
+                        - y               =   returned Y values (meters)
+
+  - Return Value:
+                        - SUCCESS
+                        - PFM_GEO_DISTANCE_NOT_GEOGRAPHIC_ERROR
+                        - PFM_GEO_DISTANCE_LATLON_PFM_ERROR
+                        - PFM_GEO_DISTANCE_ALLOCATE_ERROR
+                        - PFM_GEO_DISTANCE_OUT_OF_BOUNDS (the X or Y
+                          values for out of bounds longitudes or latitudes
+                          are not modified)
+
+****************************************************************************/
+
+NV_INT32 pfm_geo_distance_xy (NV_INT32 hnd, NV_INT32 count, NV_FLOAT64 *lat, NV_FLOAT64 *lon, NV_FLOAT64 *x, NV_FLOAT64 *y)
+{
+  NV_INT32                i, out = 0, x_in, y_in;
+  NV_FLOAT64              min_x, min_y, max_x, max_y, x_bin_size_degrees, y_bin_size_degrees, bin_size_xy, x_bin_size;
+  NV_FLOAT64              cy, post, xv, yv, xo, yo;
+
+
+  if (!geo_dist_init[hnd] && pfm_geo_distance_init (hnd)) return (pfm_error);
+
+
+  /*  Copy the header values to locals so the compiler knows that storing X and Y can't change them.  The X bin size along
+      the southern boundary is geo_distance[hnd][0].  */
+
+  min_x = bin_header[hnd].mbr.min_x;
+  min_y = bin_header[hnd].mbr.min_y;
+  max_x = bin_header[hnd].mbr.max_x;
+  max_y = bin_header[hnd].mbr.max_y;
+  x_bin_size_degrees = bin_header[hnd].x_bin_size_degrees;
+  y_bin_size_degrees = bin_header[hnd].y_bin_size_degrees;
+  bin_size_xy = bin_header[hnd].bin_size_xy;
+  x_bin_size = geo_distance[hnd][0];
+
+
+  for (i = 0 ; i < count ; i++)
+    {
+      xo = x[i];
+      yo = y[i];
+
+      x_in = (lon[i] <= max_x) & (lon[i] >= min_x);
+      y_in = (lat[i] <= max_y) & (lat[i] >= min_y);
+
+
+      /*  geo_post[hnd][cy] is computed the same way in pfm_geo_distance_init so we don't need to look it up.  */
+
+      cy = (NV_FLOAT64) (NV_INT32) ((lat[i] - min_y) / y_bin_size_degrees + 0.05);
+      post = min_y + cy * y_bin_size_degrees;
+
+      yv = (cy + (lat[i] - post) / y_bin_size_degrees) * bin_size_xy;
+      xv = ((lon[i] - min_x) / x_bin_size_degrees) * x_bin_size;
+
+      x[i] = x_in ? fabs (xv) : xo;
+      y[i] = y_in ? fabs (yv) : yo;
+
+      out += 1 - (x_in & y_in);
+    }
+
+
+  if (out)
+    {
+      sprintf (pfm_err_str, "%d of the points passed to pfm_geo_distance_xy were outside the PFM bounds", out);
+      return (pfm_error = PFM_GEO_DISTANCE_OUT_OF_BOUNDS);
+    }
+
+  return (pfm_error = SUCCESS);
+}
+
+
+
 /***************************************************************************\
  *
  *  Included the cached functions.
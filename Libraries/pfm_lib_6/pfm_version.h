@@ -43,7 +43,7 @@
 
 #ifndef VERSION
 
-#define     VERSION     "PFM Software - PFM I/O library V6.09 - 10/28/11"
+#define     VERSION     "PFM Software - PFM I/O library V6.11 - 10/19/26"
 
 #endif
 
@@ -878,4 +878,21 @@
 
     Minor change to write_bin_header to speed up initialization of new bin files.
 
+
+    Version 6.10
+    10/19/26
+    Jan Depner
+
+    Added pfm_geo_distance_init so that the pfm_geo_distance tables can be built before starting threads and
+    pfm_geo_distance_xy to convert arrays of positions to X/Y meters.
+
+
+    Version 6.11
+    10/19/26
+    Jan Depner
+
+    Added hyp_read_node_rows and hyp_write_node_rows to read and write CUBE hypothesis nodes a block of rows at a
+    time with sorted, coalesced I/O, and a node block cache (hyp_create_node_cache, hyp_cache_get_node,
+    hyp_flush_node_cache, hyp_free_node_cache) that only writes back modified nodes.
+
 </pre>*/
@@ -56,6 +56,8 @@ extern "C" {
 #define         MAX_ATTRIBUTE_SHOTS         2000 /*!<  Maximum number of shots for the attribute viewer.               */
 #define         MAX_DELETE_FILE_QUEUE       100  /*!<  Maximum number of files allowed on the delete file queue.       */
 #define         OTF_GRID_MAX                2147483648
+#define         POINT_CACHE_MAX_BINS        262144  /*!<  Upper limit on the number of PFM bins in the point cache     */
+#define         POINT_CACHE_MAX_POINTS      2000000 /*!<  Upper limit on the number of points in the point cache       */
 
 
 
@@ -218,6 +220,69 @@ extern "C" {
   } POINT_CLOUD;
 
 
+  /* The POINT_CACHE structure is a persistent, read-only cache of the non-deleted points in the PFM bins that have     */
+  /* been loaded by pfmEdit3D.  It is created by pfmView (so that it survives the editor being closed) and is named     */
+  /* parent process ID (ppid in the ABE_SHARE structure) combined with "_abe_pfmCache" (e.g. 35467_abe_pfmCache).       */
+  /* pfmView doesn't create it until the first 3D edit and sizes it from the edit area (up to POINT_CACHE_MAX_BINS and */
+  /* POINT_CACHE_MAX_POINTS).  When pfmEdit3D opens an area that overlaps a previously edited area it only needs to    */
+  /* read the bins that aren't already in the cache.  Each cached bin is stamped with its bin record values so that   */
+  /* bins that have been changed by some other program are reloaded.  Since changing the validity of a point doesn't  */
+  /* always change the bin record, anything that modifies depth records in the cached PFMs (pfmEdit3D's put_buffer   */
+  /* and pfmView's filters, file deletion, etc.) must also mark the affected bins as dropped (pfm set to -1).          */
+  /*                                                                                                                    */
+  /* The POINT_CACHE structure is just the header.  The POINT_CACHE_BIN array, the hash table, and the point columns   */
+  /* (SoA, with the positions stored as offsets from the southwest corner of the bin) follow it in the same shared    */
+  /* memory at the byte offsets stored in the header (use POINT_CACHE_COLUMN to get at them).  When the cache fills   */
+  /* up the oldest bins from previous edit sessions are discarded and the rest are moved down to make room.           */
+
+#define         POINT_CACHE_COLUMN(cache, type, offset)   ((type *) ((NV_U_BYTE *) (cache) + (cache)->offset))
+
+  typedef struct
+  {
+    NV_INT16      pfm;                       /*!<  PFM number (-1 if the bin has been dropped)                           */
+    NV_INT32      x;                         /*!<  X coordinate of the bin cell                                          */
+    NV_INT32      y;                         /*!<  Y coordinate of the bin cell                                          */
+    NV_INT32      session;                   /*!<  Edit session that cached the bin                                      */
+    NV_U_INT32    num_soundings;             /*!<  Stamp - bin num_soundings                                             */
+    NV_U_INT32    validity;                  /*!<  Stamp - bin validity                                                  */
+    NV_FLOAT32    min;                       /*!<  Stamp - bin min_filtered_depth                                        */
+    NV_FLOAT32    max;                       /*!<  Stamp - bin max_filtered_depth                                        */
+    NV_FLOAT32    avg;                       /*!<  Stamp - bin avg_filtered_depth                                        */
+    NV_INT32      start;                     /*!<  Index of the first point for this bin in the point columns            */
+    NV_INT32      count;                     /*!<  Number of points in this bin                                          */
+    NV_INT32      next;                      /*!<  Next bin in the hash chain (-1 for end of chain)                      */
+  } POINT_CACHE_BIN;
+
+
+  typedef struct
+  {
+    NV_INT32      pfm_count;                 /*!<  Number of PFMs that the cache was built from                          */
+    NV_CHAR       pfm_path[MAX_ABE_PFMS][512];/*!< PFM list file names that the cache was built from                     */
+    NV_INT32      max_bins;                  /*!<  Number of bins that the cache can hold                                */
+    NV_INT32      max_points;                /*!<  Number of points that the cache can hold                              */
+    NV_INT32      hash_size;                 /*!<  Size of the bin hash table (power of 2)                               */
+    NV_INT32      session;                   /*!<  Incremented each time pfmEdit3D opens the cache                       */
+    NV_INT32      num_bins;                  /*!<  Number of bins in use (including dropped bins), oldest first          */
+    NV_INT32      num_points;                /*!<  Number of points in use (including those of dropped bins)             */
+    NV_INT64      bin_offset;                /*!<  Offset of the POINT_CACHE_BIN array (max_bins)                        */
+    NV_INT64      hash_offset;               /*!<  Offset of the NV_INT32 hash table of first bin in each chain (-1 for
+                                                   empty)                                                                */
+    NV_INT64      dx_offset;                 /*!<  Offset of the NV_FLOAT32 X offsets from the bin west edge              */
+    NV_INT64      dy_offset;                 /*!<  Offset of the NV_FLOAT32 Y offsets from the bin south edge             */
+    NV_INT64      z_offset;                  /*!<  Offset of the NV_FLOAT64 Z values                                      */
+    NV_INT64      herr_offset;               /*!<  Offset of the NV_FLOAT32 horizontal errors                             */
+    NV_INT64      verr_offset;               /*!<  Offset of the NV_FLOAT32 vertical errors                               */
+    NV_INT64      val_offset;                /*!<  Offset of the NV_U_INT32 validity values                               */
+    NV_INT64      file_offset;               /*!<  Offset of the NV_INT16 file numbers                                    */
+    NV_INT64      line_offset;               /*!<  Offset of the NV_INT32 line numbers (not kludged with the PFM number)  */
+    NV_INT64      rec_offset;                /*!<  Offset of the NV_U_INT32 record (e.g. ping) numbers                    */
+    NV_INT64      sub_offset;                /*!<  Offset of the NV_INT32 subrecord (e.g. beam) numbers                   */
+    NV_INT64      addr_offset;               /*!<  Offset of the NV_INT64 depth record block addresses                    */
+    NV_INT64      pos_offset;                /*!<  Offset of the NV_U_BYTE depth record address positions                 */
+    NV_INT64      attr_offset[NUM_ATTR];     /*!<  Offsets of the NV_FLOAT32 optional attributes                          */
+  } POINT_CACHE;
+
+
 
 
   /*********************************************************************************************************************/
@@ -354,6 +419,36 @@ extern "C" {
   } ABE_SHARE;
 
 
+  /*  In-process filter plugins.  A filter plugin is a shared library (e.g. libhofWaveFilterPlugin.so or                 */
+  /*  hofWaveFilterPlugin.dll) that exports a C function named PFM_FILTER_PLUGIN_ENTRY of type PFM_FILTER_PLUGIN_FUNC.   */
+  /*  pfmEdit3D looks for a plugin named after the filter program (plus "Plugin") and, if it finds it, calls it directly  */
+  /*  with the point cloud instead of starting the program and passing the data through shared memory.  The function     */
+  /*  is called from a worker thread so it must not touch the GUI.  It returns 0 on success or -1 on failure (with a     */
+  /*  message in error).                                                                                                  */
+
+#define         PFM_FILTER_PLUGIN_VERSION   1                        /*!<  Version of the PFM_FILTER_PLUGIN_ARGS structure */
+#define         PFM_FILTER_PLUGIN_ENTRY     "pfm_filter_plugin_run"  /*!<  Name of the exported plugin function           */
+
+  typedef struct
+  {
+    NV_INT32      version;                   /*!<  Set to PFM_FILTER_PLUGIN_VERSION by the caller                        */
+    ABE_SHARE     *abe_share;                /*!<  Shared ABE settings (open_args, pfm_count, edit_area, filterShare)   */
+    POINT_CLOUD   *data;                     /*!<  Point cloud                                                           */
+    NV_INT32      count;                     /*!<  Number of points in data                                              */
+    NV_INT32      *pfm_handle;               /*!<  Open handles for the abe_share->open_args PFMs or NULL to have the
+                                                   plugin open (and close) them itself.  Handles are only valid if the
+                                                   plugin and the caller share one libpfm (i.e. libpfm is a shared
+                                                   library) so pfmEdit3D always passes NULL                              */
+    NV_BOOL       *kill;                     /*!<  Output - count flags (cleared by the caller) that the plugin sets for
+                                                   each point that should be invalidated                                 */
+    NV_INT32      kill_count;                /*!<  Output - number of kill flags set                                     */
+    NV_CHAR       error[512];                /*!<  Output - error message if the plugin fails                            */
+  } PFM_FILTER_PLUGIN_ARGS;
+
+
+  typedef NV_INT32 (*PFM_FILTER_PLUGIN_FUNC) (PFM_FILTER_PLUGIN_ARGS *args);
+
+
 #ifdef  __cplusplus
 }
 #endif
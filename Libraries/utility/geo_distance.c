@@ -82,47 +82,47 @@
 
 ****************************************************************************/
 
-static NV_FLOAT64               *geo_dist;
-static NV_FLOAT64               *geo_post;
-static NV_FLOAT64               l_min_x, l_min_y, l_max_x, l_max_y, x_bin_size_degrees, y_bin_size_degrees, l_bin_size_meters;
-static NV_BOOL                  geo_dist_init;
+/*  Context used by the original (single area) functions.  */
 
+static GEO_DISTANCE_CONTEXT     default_ctx;
 
-void init_geo_distance (NV_FLOAT64 bin_size_meters, NV_FLOAT64 min_x, NV_FLOAT64 min_y, NV_FLOAT64 max_x, NV_FLOAT64 max_y)
+
+void init_geo_distance_context (GEO_DISTANCE_CONTEXT *ctx, NV_FLOAT64 bin_size_meters, NV_FLOAT64 min_x, NV_FLOAT64 min_y,
+                                NV_FLOAT64 max_x, NV_FLOAT64 max_y)
 {
   NV_INT32                i, height;
   NV_FLOAT64              az, x_dist[2], x[2], y[2], mid_lat;
 
 
-  l_min_x = min_x;
-  l_min_y = min_y;
-  l_max_x = max_x;
-  l_max_y = max_y;
-  l_bin_size_meters = bin_size_meters;
+  ctx->min_x = min_x;
+  ctx->min_y = min_y;
+  ctx->max_x = max_x;
+  ctx->max_y = max_y;
+  ctx->bin_size_meters = bin_size_meters;
 
 
   invgp (NV_A0, NV_B0, min_y, min_x, max_y, min_x, &x_dist[0], &az);
 
   height = NINT (x_dist[0] / bin_size_meters);
 
-  y_bin_size_degrees = (max_y - min_y) / (NV_FLOAT64) height;
+  ctx->y_bin_size_degrees = (max_y - min_y) / (NV_FLOAT64) height;
 
   mid_lat = min_y + (max_y - min_y) / 2.0;
 
   newgp (mid_lat, min_x, 90.0, bin_size_meters, &y[0], &x[0]);
 
-  x_bin_size_degrees = x[0] - min_x;
+  ctx->x_bin_size_degrees = x[0] - min_x;
 
 
-  geo_dist = (NV_FLOAT64 *) calloc (height + 2, sizeof (NV_FLOAT64));
-  if (geo_dist == NULL) 
+  ctx->geo_dist = (NV_FLOAT64 *) calloc (height + 2, sizeof (NV_FLOAT64));
+  if (ctx->geo_dist == NULL) 
     {
       perror ("Allocating geo_dist array in init_geo_distance");
       exit (-1);
     }
 
-  geo_post = (NV_FLOAT64 *) calloc (height + 2, sizeof (NV_FLOAT64));
-  if (geo_post == NULL)
+  ctx->geo_post = (NV_FLOAT64 *) calloc (height + 2, sizeof (NV_FLOAT64));
+  if (ctx->geo_post == NULL)
     {
       perror ("Allocating geo_dist array in init_geo_distance");
       exit (-1);
@@ -135,65 +135,69 @@ void init_geo_distance (NV_FLOAT64 bin_size_meters, NV_FLOAT64 min_x, NV_FLOAT64
     {
       /*  Get the latitude "post" positions.  */
 
-      geo_post[i] = min_y + (NV_FLOAT64) i * y_bin_size_degrees;
+      ctx->geo_post[i] = min_y + (NV_FLOAT64) i * ctx->y_bin_size_degrees;
 
 
       /*  Compute the actual X bin size at this lat band.  */
 
-      invgp (NV_A0, NV_B0, geo_post[i], min_x, geo_post[i], min_x + x_bin_size_degrees, &geo_dist[i], &az);
+      invgp (NV_A0, NV_B0, ctx->geo_post[i], min_x, ctx->geo_post[i], min_x + ctx->x_bin_size_degrees, &ctx->geo_dist[i], &az);
     }
 
-  geo_dist_init = NVTrue;
+  ctx->init = NVTrue;
 }
 
 
 
-NV_BOOL geo_distance (NV_FLOAT64 lat0, NV_FLOAT64 lon0, NV_FLOAT64 lat1, NV_FLOAT64 lon1, NV_FLOAT64 *distance)
+NV_BOOL geo_distance_context (GEO_DISTANCE_CONTEXT *ctx, NV_FLOAT64 lat0, NV_FLOAT64 lon0, NV_FLOAT64 lat1, NV_FLOAT64 lon1,
+                              NV_FLOAT64 *distance)
 {
   NV_FLOAT64              x_dist[2], x[2], y[2], x_bin_size, next_lat;
   NV_I32_COORD2           coord[2];
 
 
-  if (!geo_dist_init) return (NVFalse);
+  if (!ctx->init) return (NVFalse);
 
 
   /*  Check the points.  */
 
-  if (lon0 > l_max_x || lon0 < l_min_x || lat0 > l_max_y || lat0 < l_min_y || lon1 > l_max_x || lon1 < l_min_x || lat1 > l_max_y || lat1 < l_min_y)
+  if (lon0 > ctx->max_x || lon0 < ctx->min_x || lat0 > ctx->max_y || lat0 < ctx->min_y || lon1 > ctx->max_x || lon1 < ctx->min_x ||
+      lat1 > ctx->max_y || lat1 < ctx->min_y)
     return (NVFalse);
 
 
   /*  Compute our own indices so we can deal with round-off.  */
 
-  coord[0].x = (NV_INT32) ((NV_FLOAT64) (lon0 - l_min_x) / (NV_FLOAT64) x_bin_size_degrees + 0.05);
-  coord[0].y = (NV_INT32) ((NV_FLOAT64) (lat0 - l_min_y) / (NV_FLOAT64) y_bin_size_degrees + 0.05);
+  coord[0].x = (NV_INT32) ((NV_FLOAT64) (lon0 - ctx->min_x) / (NV_FLOAT64) ctx->x_bin_size_degrees + 0.05);
+  coord[0].y = (NV_INT32) ((NV_FLOAT64) (lat0 - ctx->min_y) / (NV_FLOAT64) ctx->y_bin_size_degrees + 0.05);
 
-  coord[1].x = (NV_INT32) ((NV_FLOAT64) (lon1 - l_min_x) / (NV_FLOAT64) x_bin_size_degrees + 0.05);
-  coord[1].y = (NV_INT32) ((NV_FLOAT64) (lat1 - l_min_y) / (NV_FLOAT64) y_bin_size_degrees + 0.05);
+  coord[1].x = (NV_INT32) ((NV_FLOAT64) (lon1 - ctx->min_x) / (NV_FLOAT64) ctx->x_bin_size_degrees + 0.05);
+  coord[1].y = (NV_INT32) ((NV_FLOAT64) (lat1 - ctx->min_y) / (NV_FLOAT64) ctx->y_bin_size_degrees + 0.05);
 
 
   /*  Get the Y positions in "meters".  */
 
-  y[0] = ((NV_FLOAT64) coord[0].y + (lat0 - geo_post[coord[0].y]) / y_bin_size_degrees) * l_bin_size_meters;
-  y[1] = ((NV_FLOAT64) coord[1].y + (lat1 - geo_post[coord[1].y]) / y_bin_size_degrees) * l_bin_size_meters;
+  y[0] = ((NV_FLOAT64) coord[0].y + (lat0 - ctx->geo_post[coord[0].y]) / ctx->y_bin_size_degrees) * ctx->bin_size_meters;
+  y[1] = ((NV_FLOAT64) coord[1].y + (lat1 - ctx->geo_post[coord[1].y]) / ctx->y_bin_size_degrees) * ctx->bin_size_meters;
 
 
   /*  Get the X positions in "meters" adjusted for the change in Y.  Interpolating the value between the 
       posts on either side of the lat.  This is probably serious overkill but not too computationally
       taxing.  */
 
-  next_lat = geo_post[coord[0].y] + y_bin_size_degrees;
-  x_dist[0] = geo_dist[coord[0].y] + (geo_dist[coord[0].y + 1] - geo_dist[coord[0].y]) * ((lat0 - geo_post[coord[0].y]) / (next_lat - geo_post[coord[0].y]));
+  next_lat = ctx->geo_post[coord[0].y] + ctx->y_bin_size_degrees;
+  x_dist[0] = ctx->geo_dist[coord[0].y] + (ctx->geo_dist[coord[0].y + 1] - ctx->geo_dist[coord[0].y]) *
+    ((lat0 - ctx->geo_post[coord[0].y]) / (next_lat - ctx->geo_post[coord[0].y]));
 
-  next_lat = geo_post[coord[1].y] + y_bin_size_degrees;
-  x_dist[1] = geo_dist[coord[1].y] + (geo_dist[coord[1].y + 1] - geo_dist[coord[1].y]) * ((lat1 - geo_post[coord[1].y]) / (next_lat - geo_post[coord[1].y]));
+  next_lat = ctx->geo_post[coord[1].y] + ctx->y_bin_size_degrees;
+  x_dist[1] = ctx->geo_dist[coord[1].y] + (ctx->geo_dist[coord[1].y + 1] - ctx->geo_dist[coord[1].y]) *
+    ((lat1 - ctx->geo_post[coord[1].y]) / (next_lat - ctx->geo_post[coord[1].y]));
 
 
   x_bin_size = (x_dist[1] + x_dist[0]) / 2.0;
 
 
-  x[0] = ((lon0 - l_min_x) / x_bin_size_degrees) * x_bin_size;
-  x[1] = ((lon1 - l_min_x) / x_bin_size_degrees) * x_bin_size;
+  x[0] = ((lon0 - ctx->min_x) / ctx->x_bin_size_degrees) * x_bin_size;
+  x[1] = ((lon1 - ctx->min_x) / ctx->x_bin_size_degrees) * x_bin_size;
 
 
   /*  Damn, this looks familiar doesn't it?  I wonder what it is?  */
@@ -206,13 +210,129 @@ NV_BOOL geo_distance (NV_FLOAT64 lat0, NV_FLOAT64 lon0, NV_FLOAT64 lat1, NV_FLOA
 
 
 
-void clean_geo_distance ()
+/***************************************************************************/
+/*!
+
+  - Module Name:        geo_distance_xy
+
+  - Programmer(s):      Jan C. Depner
+
+  - Date Written:       October 2026
+
+  - Purpose:            Convert arrays of positions to X and Y in meters
+                        from the southwest corner of the context's area.
+
+  - Method:             X is the distance along the southern boundary of
+                        the area from min_x to the longitude and Y is the
+                        distance along the western boundary from min_y to
+                        the latitude.  These are exactly the values that
+                        you would get from
+                        geo_distance_context (ctx, min_y, min_x, min_y, lon, &x)
+                        and
+                        geo_distance_context (ctx, min_y, min_x, lat, min_x, &y)
+                        but the loop has no table lookups or branches so
+                        the compiler can vectorize it (with -O3
+                        -fno-trapping-math and SSE4.1 or better).  This is the
+                        standard trick for doing fast proximity checks in
+                        a small area.
+
+  - Arguments:
+                        - ctx             =   initialized context
+                        - count           =   number of points
+                        - lat             =   latitudes
+                        - lon             =   longitudes
+                        - x               =   returned X values (meters)
+                        - y               =   returned Y values (meters)
+
+  - Return Value:       Number of points that were outside of the area.
+                        The X (or Y) value for a longitude (or latitude)
+                        outside of the area is not modified (just like
+                        geo_distance).  Returns -1 if the context hasn't
+                        been initialized.
+
+****************************************************************************/
+
+NV_INT32 geo_distance_xy (GEO_DISTANCE_CONTEXT *ctx, NV_INT32 count, NV_FLOAT64 *lat, NV_FLOAT64 *lon, NV_FLOAT64 *x, NV_FLOAT64 *y)
+{
+  NV_INT32                i, out = 0;
+  NV_FLOAT64              min_x, min_y, max_x, max_y, x_bin_size_degrees, y_bin_size_degrees, bin_size_meters, x_bin_size;
+  NV_FLOAT64              cy, post, yv, xv, xo, yo;
+  NV_INT32                x_in, y_in;
+
+
+  if (!ctx->init) return (-1);
+
+
+  /*  Copy the context values to locals so the compiler knows that storing X and Y can't change them.  The X bin size along
+      the southern boundary is geo_dist[0].  */
+
+  min_x = ctx->min_x;
+  min_y = ctx->min_y;
+  max_x = ctx->max_x;
+  max_y = ctx->max_y;
+  x_bin_size_degrees = ctx->x_bin_size_degrees;
+  y_bin_size_degrees = ctx->y_bin_size_degrees;
+  bin_size_meters = ctx->bin_size_meters;
+  x_bin_size = ctx->geo_dist[0];
+
+
+  for (i = 0 ; i < count ; i++)
+    {
+      xo = x[i];
+      yo = y[i];
+
+      x_in = (lon[i] <= max_x) & (lon[i] >= min_x);
+      y_in = (lat[i] <= max_y) & (lat[i] >= min_y);
+
+
+      /*  geo_post[cy] is computed the same way as in init_geo_distance_context so we don't need to look it up.  The index is
+          truncated in floating point (same result as the integer cast in geo_distance_context) to keep the loop vectorizable.  */
+
+      cy = trunc ((lat[i] - min_y) / y_bin_size_degrees + 0.05);
+      post = min_y + cy * y_bin_size_degrees;
+
+      yv = (cy + (lat[i] - post) / y_bin_size_degrees) * bin_size_meters;
+      xv = ((lon[i] - min_x) / x_bin_size_degrees) * x_bin_size;
+
+      x[i] = x_in ? fabs (xv) : xo;
+      y[i] = y_in ? fabs (yv) : yo;
+
+      out += 1 - (x_in & y_in);
+    }
+
+  return (out);
+}
+
+
+
+void clean_geo_distance_context (GEO_DISTANCE_CONTEXT *ctx)
 {
-  if (!geo_dist_init) return;
+  if (!ctx->init) return;
 
-  free (geo_dist);
-  free (geo_post);
+  free (ctx->geo_dist);
+  free (ctx->geo_post);
 
-  geo_dist_init = NVFalse;
+  ctx->init = NVFalse;
 }
 
+
+
+void init_geo_distance (NV_FLOAT64 bin_size_meters, NV_FLOAT64 min_x, NV_FLOAT64 min_y, NV_FLOAT64 max_x, NV_FLOAT64 max_y)
+{
+  clean_geo_distance_context (&default_ctx);
+  init_geo_distance_context (&default_ctx, bin_size_meters, min_x, min_y, max_x, max_y);
+}
+
+
+
+NV_BOOL geo_distance (NV_FLOAT64 lat0, NV_FLOAT64 lon0, NV_FLOAT64 lat1, NV_FLOAT64 lon1, NV_FLOAT64 *distance)
+{
+  return (geo_distance_context (&default_ctx, lat0, lon0, lat1, lon1, distance));
+}
+
+
+
+void clean_geo_distance ()
+{
+  clean_geo_distance_context (&default_ctx);
+}
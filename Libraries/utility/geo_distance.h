@@ -52,9 +52,34 @@ extern "C" {
 #include "newgp.h"
 
 
+  /*!  geo_distance context.  Once it has been initialized by init_geo_distance_context it is only read so any number of
+       threads may use the same context at the same time and each thread may use a different area.  Call
+       clean_geo_distance_context before initializing a context again.  */
+
+  typedef struct
+  {
+    NV_FLOAT64    *geo_dist;                  /*!<  Actual X bin size in meters at each latitude post  */
+    NV_FLOAT64    *geo_post;                  /*!<  Latitude posts  */
+    NV_FLOAT64    min_x;                      /*!<  Area minimum longitude  */
+    NV_FLOAT64    min_y;                      /*!<  Area minimum latitude  */
+    NV_FLOAT64    max_x;                      /*!<  Area maximum longitude  */
+    NV_FLOAT64    max_y;                      /*!<  Area maximum latitude  */
+    NV_FLOAT64    x_bin_size_degrees;         /*!<  X bin size in degrees  */
+    NV_FLOAT64    y_bin_size_degrees;         /*!<  Y bin size in degrees  */
+    NV_FLOAT64    bin_size_meters;            /*!<  Bin size in meters  */
+    NV_BOOL       init;                       /*!<  Set to NVTrue when the context has been initialized  */
+  } GEO_DISTANCE_CONTEXT;
+
+
   void init_geo_distance (NV_FLOAT64 bin_size_meters, NV_FLOAT64 min_x, NV_FLOAT64 min_y, NV_FLOAT64 max_x, NV_FLOAT64 max_y);
   NV_BOOL geo_distance (NV_FLOAT64 lat0, NV_FLOAT64 lon0, NV_FLOAT64 lat1, NV_FLOAT64 lon1, NV_FLOAT64 *distance);
   void clean_geo_distance ();
+  void init_geo_distance_context (GEO_DISTANCE_CONTEXT *ctx, NV_FLOAT64 bin_size_meters, NV_FLOAT64 min_x, NV_FLOAT64 min_y,
+                                  NV_FLOAT64 max_x, NV_FLOAT64 max_y);
+  NV_BOOL geo_distance_context (GEO_DISTANCE_CONTEXT *ctx, NV_FLOAT64 lat0, NV_FLOAT64 lon0, NV_FLOAT64 lat1, NV_FLOAT64 lon1,
+                                NV_FLOAT64 *distance);
+  NV_INT32 geo_distance_xy (GEO_DISTANCE_CONTEXT *ctx, NV_INT32 count, NV_FLOAT64 *lat, NV_FLOAT64 *lon, NV_FLOAT64 *x, NV_FLOAT64 *y);
+  void clean_geo_distance_context (GEO_DISTANCE_CONTEXT *ctx);
 
 
 
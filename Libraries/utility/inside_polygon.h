@@ -45,13 +45,37 @@ extern "C" {
 
 
 #include <stdio.h>
+#include <stdlib.h>
 #include "nvtypes.h"
 #include "line_intersection.h"
 
 
+  /*!  Prepared polygon.  This is built once by prepare_polygon or prepare_polygon2 and then used for any number of
+       point tests.  The polygon is cut into horizontal slabs and each slab holds a copy of the (non-horizontal) edges
+       that cross it so a point only has to be tested against the few edges in its own slab.  */
+
+  typedef struct
+  {
+    NV_INT32      npol;                       /*!<  Number of vertices in the original polygon  */
+    NV_F64_XYMBR  mbr;                        /*!<  Minimum bounding rectangle of the polygon  */
+    NV_INT32      num_slabs;                  /*!<  Number of horizontal slabs  */
+    NV_FLOAT64    slab_scale;                 /*!<  Number of slabs per Y unit  */
+    NV_INT32      *slab_start;                /*!<  Index of the first edge in each slab (num_slabs + 1 entries)  */
+    NV_FLOAT64    *xi;                        /*!<  Edge start X (stored by slab)  */
+    NV_FLOAT64    *yi;                        /*!<  Edge start Y (stored by slab)  */
+    NV_FLOAT64    *xj;                        /*!<  Edge end X (stored by slab)  */
+    NV_FLOAT64    *yj;                        /*!<  Edge end Y (stored by slab)  */
+  } PREPARED_POLYGON;
+
+
   NV_INT32 inside_polygon (NV_F64_COORD2 *poly, NV_INT32 npol, NV_FLOAT64 x, NV_FLOAT64 y);
   NV_INT32 inside_polygon2 (NV_FLOAT64 *poly_x, NV_FLOAT64 *poly_y, NV_INT32 npol, NV_FLOAT64 x, NV_FLOAT64 y);
   NV_INT32 inside_polygon3 (NV_INT32 *xs, NV_INT32 *ys, NV_INT32 count, NV_INT32 x, NV_INT32 y);
+  PREPARED_POLYGON *prepare_polygon (NV_F64_COORD2 *poly, NV_INT32 npol);
+  PREPARED_POLYGON *prepare_polygon2 (NV_FLOAT64 *poly_x, NV_FLOAT64 *poly_y, NV_INT32 npol);
+  void free_prepared_polygon (PREPARED_POLYGON *pp);
+  NV_INT32 inside_prepared_polygon (PREPARED_POLYGON *pp, NV_FLOAT64 x, NV_FLOAT64 y);
+  NV_INT32 inside_prepared_polygon_batch (PREPARED_POLYGON *pp, NV_FLOAT64 *x, NV_FLOAT64 *y, NV_INT32 count, NV_U_BYTE *inside);
   NV_BOOL polygon_collision (NV_F64_COORD2 *poly1, NV_INT32 npol1, NV_F64_COORD2 *poly2, NV_INT32 npol2);
   NV_BOOL polygon_collision2 (NV_FLOAT64 *poly1x, NV_FLOAT64 *poly1y, NV_INT32 npol1, NV_FLOAT64 *poly2x, NV_FLOAT64 *poly2y, NV_INT32 npol2);
 
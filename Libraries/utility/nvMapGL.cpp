@@ -1972,6 +1972,124 @@ nvMapGL::setDataPoints (NV_FLOAT64 x, NV_FLOAT64 y, NV_FLOAT64 z, NV_U_BYTE *poi
 
 
 
+/*!
+
+   - Makes a 3D point cloud from arrays of points.  This replaces any points that were loaded with the single point
+     version of setDataPoints.  The conversion to OpenGL coordinates is split across threads for large point sets.
+
+   - Inputs:
+                    - count         =    Number of points
+                    - x             =    Array of X positions (if projected these would be longitudes).
+                    - y             =    Array of Y positions (if projected these would be latitudes).
+                    - z             =    Array of Z positions (elevations).
+                    - point_color   =    Array of count * 4 RGBA color values (see the single point version).
+                    - point_size    =    Size of the points in OpenGL units.
+                    - sparse_limit  =    If this is greater than zero and there are more than sparse_limit points a
+                                         decimated set of no more than sparse_limit points will also be loaded as the
+                                         sparse points (see setSparsePoints and decimatePoints).  Set to 0 to leave the
+                                         sparse points alone.
+
+   - Returns:       NVTrue
+
+*/
+
+NV_BOOL 
+nvMapGL::setDataPoints (NV_INT32 count, NV_FLOAT64 *x, NV_FLOAT64 *y, NV_FLOAT32 *z, NV_U_BYTE *point_color, NV_INT32 point_size,
+                        NV_INT32 sparse_limit)
+{
+  //  Don't try to draw the points while we're loading the arrays.
+
+  point_count = 0;
+
+
+  if (count)
+    {
+      point_data = (GLfloat *) realloc (point_data, sizeof (GLfloat) * count * 3);
+
+      if (point_data == NULL) 
+        {
+          perror ("point_data");
+          exit (-1);
+        }
+
+      point_color_data = (GLubyte *) realloc (point_color_data, sizeof (GLubyte) * count * 4);
+
+      if (point_color_data == NULL) 
+        {
+          perror ("point_color_data");
+          exit (-1);
+        }
+
+      map_to_screen (count, x, y, z, point_data);
+
+      memcpy (point_color_data, point_color, count * 4);
+    }
+
+
+  //  Build the decimated level of detail from the converted points.
+
+  if (sparse_limit > 0 && count > sparse_limit)
+    {
+      sparse_count = 0;
+
+      NV_INT32 *index = (NV_INT32 *) malloc (sizeof (NV_INT32) * sparse_limit);
+
+      if (index == NULL) 
+        {
+          perror ("Allocating sparse index");
+          exit (-1);
+        }
+
+      NV_INT32 spr_cnt = decimatePoints (count, point_data, sparse_limit, index);
+
+      sparse_data = (GLfloat *) realloc (sparse_data, sizeof (GLfloat) * spr_cnt * 3);
+
+      if (sparse_data == NULL) 
+        {
+          perror ("sparse_data");
+          exit (-1);
+        }
+
+      sparse_color_data = (GLubyte *) realloc (sparse_color_data, sizeof (GLubyte) * spr_cnt * 4);
+
+      if (sparse_color_data == NULL) 
+        {
+          perror ("sparse_color_data");
+          exit (-1);
+        }
+
+      for (NV_INT32 i = 0 ; i < spr_cnt ; i++)
+        {
+          memcpy (&sparse_data[i * 3], &point_data[index[i] * 3], sizeof (GLfloat) * 3);
+          memcpy (&sparse_color_data[i * 4], &point_color_data[index[i] * 4], 4);
+        }
+
+      free (index);
+
+      sparse_data_size = point_size;
+
+      generateSparsePointsDL (spr_cnt);
+    }
+
+
+  point_data_size = point_size;
+
+
+  signalsEnabled = NVTrue;
+
+
+  generateDataPointsDL (count);
+
+
+  update_type = 1;
+  updateGL ();
+
+
+  return (NVTrue);
+}
+
+
+
 //!  Clear "sparse" data points.
 
 void 
@@ -2080,6 +2198,63 @@ nvMapGL::setSparsePoints (NV_FLOAT64 x, NV_FLOAT64 y, NV_FLOAT64 z, NV_U_BYTE *p
 
 
 
+/*!
+
+   - Makes a sparse 3D point cloud from arrays of points.  This replaces any points that were loaded with the single
+     point version of setSparsePoints.  See the array version of setDataPoints for the arguments.
+
+   - Returns:       NVTrue
+
+*/
+
+NV_BOOL 
+nvMapGL::setSparsePoints (NV_INT32 count, NV_FLOAT64 *x, NV_FLOAT64 *y, NV_FLOAT32 *z, NV_U_BYTE *point_color, NV_INT32 point_size)
+{
+  sparse_count = 0;
+
+
+  if (count)
+    {
+      sparse_data = (GLfloat *) realloc (sparse_data, sizeof (GLfloat) * count * 3);
+
+      if (sparse_data == NULL) 
+        {
+          perror ("sparse_data");
+          exit (-1);
+        }
+
+      sparse_color_data = (GLubyte *) realloc (sparse_color_data, sizeof (GLubyte) * count * 4);
+
+      if (sparse_color_data == NULL) 
+        {
+          perror ("sparse_color_data");
+          exit (-1);
+        }
+
+      map_to_screen (count, x, y, z, sparse_data);
+
+      memcpy (sparse_color_data, point_color, count * 4);
+    }
+
+
+  sparse_data_size = point_size;
+
+
+  signalsEnabled = NVTrue;
+
+
+  generateSparsePointsDL (count);
+
+
+  update_type = 1;
+  updateGL ();
+
+
+  return (NVTrue);
+}
+
+
+
 //!  Clear "feature" points.
 
 void 
@@ -3820,6 +3995,171 @@ nvMapGL::map_to_screen (NV_INT32 count, NV_FLOAT64 *map_x, NV_FLOAT64 *map_y, NV
 }
 
 
+//!  Thread used by the array version of map_to_screen to convert part of a point set.
+
+class nvMapGLTransform:public QThread
+{
+public:
+
+  nvMapGL                 *map;
+  NV_FLOAT64              *map_x, *map_y;
+  NV_FLOAT32              *map_z;
+  GLfloat                 *vertices;
+  NV_INT32                first, last;
+
+
+protected:
+
+  void run ()
+  {
+    for (NV_INT32 i = first ; i < last ; i++)
+      map->map_to_screen (map_x[i], map_y[i], map_z[i], &vertices[i * 3], &vertices[i * 3 + 1], &vertices[i * 3 + 2]);
+  }
+};
+
+
+
+/*!
+
+   - Convert arrays of map coordinates to interleaved OpenGL X, Y, Z vertices (the layout used for point_data).  Point
+     sets larger than NVMAPGL_THREAD_POINTS are split across up to QThread::idealThreadCount threads.  This doesn't
+     touch OpenGL so it can be called before the widget has been drawn.
+
+*/
+
+void 
+nvMapGL::map_to_screen (NV_INT32 count, NV_FLOAT64 *map_x, NV_FLOAT64 *map_y, NV_FLOAT32 *map_z, GLfloat *vertices)
+{
+  NV_INT32 num_threads = qMin (qMax (QThread::idealThreadCount (), 1), qMax (count / NVMAPGL_THREAD_POINTS, 1));
+
+
+  if (num_threads == 1)
+    {
+      for (NV_INT32 i = 0 ; i < count ; i++)
+        map_to_screen (map_x[i], map_y[i], map_z[i], &vertices[i * 3], &vertices[i * 3 + 1], &vertices[i * 3 + 2]);
+
+      return;
+    }
+
+
+  nvMapGLTransform *transform = new nvMapGLTransform[num_threads];
+
+  for (NV_INT32 i = 0 ; i < num_threads ; i++)
+    {
+      transform[i].map = this;
+      transform[i].map_x = map_x;
+      transform[i].map_y = map_y;
+      transform[i].map_z = map_z;
+      transform[i].vertices = vertices;
+      transform[i].first = (NV_INT32) (((NV_INT64) count * i) / num_threads);
+      transform[i].last = (NV_INT32) (((NV_INT64) count * (i + 1)) / num_threads);
+      transform[i].start ();
+    }
+
+  for (NV_INT32 i = 0 ; i < num_threads ; i++) transform[i].wait ();
+
+  delete[] transform;
+}
+
+
+
+/*!
+
+   - Screen space decimation of a set of interleaved OpenGL vertices (like those from the array version of
+     map_to_screen).  The points are binned on the horizontal (X/Z) plane of the OpenGL cube and the points with the
+     minimum and maximum vertical (Y) value in each bin are kept so that fliers still show up in the decimated set.
+
+   - Inputs:
+                    - count         =    Number of vertices
+                    - vertices      =    count * 3 interleaved X, Y, Z OpenGL coordinates
+                    - limit         =    Maximum number of points to keep
+                    - index         =    Returned indices of the points to keep (must hold at least limit values).
+                                         The indices are in increasing bin order.
+
+   - Returns:       Number of indices placed in index
+
+*/
+
+NV_INT32 
+nvMapGL::decimatePoints (NV_INT32 count, GLfloat *vertices, NV_INT32 limit, NV_INT32 *index)
+{
+  if (count <= 0 || limit <= 0) return (0);
+
+
+  //  Two points per bin.
+
+  NV_INT32 bins = (NV_INT32) sqrt ((NV_FLOAT64) limit / 2.0);
+
+  if (bins < 1)
+    {
+      index[0] = 0;
+      return (1);
+    }
+
+
+  GLfloat min_x = vertices[0], max_x = vertices[0], min_z = vertices[2], max_z = vertices[2];
+
+  for (NV_INT32 i = 1 ; i < count ; i++)
+    {
+      min_x = qMin (min_x, vertices[i * 3]);
+      max_x = qMax (max_x, vertices[i * 3]);
+      min_z = qMin (min_z, vertices[i * 3 + 2]);
+      max_z = qMax (max_z, vertices[i * 3 + 2]);
+    }
+
+  NV_FLOAT64 scale_x = (max_x > min_x) ? (NV_FLOAT64) bins / (max_x - min_x) : 0.0;
+  NV_FLOAT64 scale_z = (max_z > min_z) ? (NV_FLOAT64) bins / (max_z - min_z) : 0.0;
+
+
+  NV_INT32 *bin_min = (NV_INT32 *) malloc (sizeof (NV_INT32) * bins * bins * 2);
+
+  if (bin_min == NULL) 
+    {
+      perror ("Allocating decimation bins");
+      exit (-1);
+    }
+
+  NV_INT32 *bin_max = &bin_min[bins * bins];
+
+  for (NV_INT32 i = 0 ; i < bins * bins ; i++) bin_min[i] = bin_max[i] = -1;
+
+
+  for (NV_INT32 i = 0 ; i < count ; i++)
+    {
+      NV_INT32 col = qMin ((NV_INT32) ((vertices[i * 3] - min_x) * scale_x), bins - 1);
+      NV_INT32 row = qMin ((NV_INT32) ((vertices[i * 3 + 2] - min_z) * scale_z), bins - 1);
+      NV_INT32 bin = row * bins + col;
+
+      if (bin_min[bin] < 0)
+        {
+          bin_min[bin] = bin_max[bin] = i;
+        }
+      else
+        {
+          if (vertices[i * 3 + 1] < vertices[bin_min[bin] * 3 + 1]) bin_min[bin] = i;
+          if (vertices[i * 3 + 1] > vertices[bin_max[bin] * 3 + 1]) bin_max[bin] = i;
+        }
+    }
+
+
+  NV_INT32 kept = 0;
+
+  for (NV_INT32 i = 0 ; i < bins * bins ; i++)
+    {
+      if (bin_min[i] >= 0)
+        {
+          index[kept++] = bin_min[i];
+          if (bin_max[i] != bin_min[i]) index[kept++] = bin_max[i];
+        }
+    }
+
+  free (bin_min);
+
+  return (kept);
+}
+
+
+
 //!  Convert map coordinates to OpenGL coordinates (vertices from 0.0 to 1.0).
 
 void 
@@ -6665,11 +7005,7 @@ void nvMapGL::generateDataPointsDL (NV_INT32 count)
 
             glPointSize ((GLfloat) point_data_size);
 
-            glBegin (GL_POINTS);
-            {
-              for (NV_INT32 i = 0 ; i < count ; i++) glArrayElement (i);
-            }
-            glEnd ();
+            glDrawArrays (GL_POINTS, 0, count);
 
             glPopAttrib ();
           }
@@ -6759,12 +7095,7 @@ void nvMapGL::generateSparsePointsDL (NV_INT32 count)
 
             glPointSize ((GLfloat) sparse_data_size);
 
-            glBegin (GL_POINTS);
-            {
-              for (NV_INT32 i = 0 ; i < count ; i++) glArrayElement (i);
-            }
-
-            glEnd ();
+            glDrawArrays (GL_POINTS, 0, count);
           }			
       }
 
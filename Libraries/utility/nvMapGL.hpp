@@ -71,6 +71,7 @@
 
 #define NVMAPGL_POLYGON_POINTS   2000
 #define NVMAPGL_ZOOM_LEVELS      100
+#define NVMAPGL_THREAD_POINTS    100000          //  Minimum number of points per thread when converting point arrays
 
 
 #define DATA_COLORS 128
@@ -298,9 +299,12 @@ public:
 
   void clearDataPoints ();
   NV_BOOL setDataPoints (NV_FLOAT64 x, NV_FLOAT64 y, NV_FLOAT64 z, NV_U_BYTE *point_color, NV_INT32 point_size, NV_BOOL done);
+  NV_BOOL setDataPoints (NV_INT32 count, NV_FLOAT64 *x, NV_FLOAT64 *y, NV_FLOAT32 *z, NV_U_BYTE *point_color, NV_INT32 point_size,
+                         NV_INT32 sparse_limit);
 
   void clearSparsePoints ();
   NV_BOOL setSparsePoints (NV_FLOAT64 x, NV_FLOAT64 y, NV_FLOAT64 z, NV_U_BYTE *point_color, NV_INT32 point_size, NV_BOOL done);
+  NV_BOOL setSparsePoints (NV_INT32 count, NV_FLOAT64 *x, NV_FLOAT64 *y, NV_FLOAT32 *z, NV_U_BYTE *point_color, NV_INT32 point_size);
 
   void clearFeaturePoints ();
   NV_BOOL setFeaturePoints (NV_FLOAT64 x, NV_FLOAT64 y, NV_FLOAT64 z, QColor feature_color, NV_FLOAT32 feature_size, NV_INT32 slices,
@@ -468,6 +472,7 @@ public:
   void getMarker3DCoords (NV_INT32 x, NV_INT32 y, NV_FLOAT64 *map_x, NV_FLOAT64 *map_y, NV_FLOAT64 *map_z);
   void getFaux3DCoords (NV_FLOAT64 anchor_x, NV_FLOAT64 anchor_y, NV_FLOAT64 anchor_z, NV_INT32 pixel_x, NV_INT32 pixel_y, NV_F64_COORD3 *coords);
   void map_to_screen (NV_INT32 count, NV_FLOAT64 *map_x, NV_FLOAT64 *map_y, NV_FLOAT64 *map_z, NV_FLOAT32 *vertex_x, NV_FLOAT32 *vertex_y, NV_FLOAT32 *vertex_z);
+  void map_to_screen (NV_INT32 count, NV_FLOAT64 *map_x, NV_FLOAT64 *map_y, NV_FLOAT32 *map_z, GLfloat *vertices);
   void map_to_screen (NV_FLOAT64 map_x, NV_FLOAT64 map_y, NV_FLOAT64 map_z, NV_FLOAT32 *vertex_x, NV_FLOAT32 *vertex_y,
                       NV_FLOAT32 *vertex_z);
   void map_to_screen (NV_FLOAT64 map_x, NV_FLOAT64 map_y, NV_FLOAT32 map_z, NV_FLOAT32 *vertex_x, NV_FLOAT32 *vertex_y,
@@ -478,6 +483,7 @@ public:
   void screen_to_map (NV_FLOAT32 vertex_x, NV_FLOAT32 vertex_y, NV_FLOAT32 vertex_z, NV_FLOAT64 *map_x, NV_FLOAT64 *map_y,
                       NV_FLOAT64 *map_z);
   void displayLayer (NV_INT32 layer, NV_BOOL display);
+  static NV_INT32 decimatePoints (NV_INT32 count, GLfloat *vertices, NV_INT32 limit, NV_INT32 *index);
   void resetMap ();
   void enableSignals ();
   void disableSignals ();
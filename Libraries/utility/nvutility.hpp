@@ -53,6 +53,7 @@
 #include "rproj.hpp"
 #include "setSidebarUrls.hpp"
 #include "smooth_contour.hpp"
+#include "tile_contour.hpp"
 #include "squat.hpp"
 #include "sunshade.hpp"
 #include "survey.hpp"
@@ -38,7 +38,7 @@
 
 #ifndef NVUTILITY_VERSION
 
-#define     NVUTILITY_VERSION     "PFM Software - nvutility library V2.1.22 - 11/04/11"
+#define     NVUTILITY_VERSION     "PFM Software - nvutility library V2.1.27 - 10/19/26"
 
 #endif
 
@@ -587,4 +587,47 @@
 
     Fixed bug in nvMapGL.cpp when coloring by something other than depth/elevation.
 
+
+    Version 2.1.23
+    Jan C. Depner
+    10/19/26
+
+    Added prepared polygons (prepare_polygon, prepare_polygon2, inside_prepared_polygon, inside_prepared_polygon_batch) to
+    inside_polygon.c for fast repeated point in polygon tests against large polygons.  Added the POINT_CACHE structures
+    to ABE.h.
+
+
+    Version 2.1.24
+    Jan C. Depner
+    10/19/26
+
+    Moved the geo_distance tables into a GEO_DISTANCE_CONTEXT structure so that different threads can use different areas
+    (init_geo_distance, geo_distance, and clean_geo_distance still work on a default context).  Added geo_distance_xy to
+    convert arrays of positions to X/Y meters.
+
+
+    Version 2.1.25
+    Jan C. Depner
+    10/19/26
+
+    Added array versions of setDataPoints and setSparsePoints to nvMapGL.cpp so that a whole point cloud can be loaded
+    with one allocation.  The array version of map_to_screen splits large point sets across threads and decimatePoints
+    builds a min/max per bin level of detail for the sparse points.  Point display lists now use glDrawArrays.
+
+
+    Version 2.1.26
+    Jan C. Depner
+    10/19/26
+
+    Added the PFM_FILTER_PLUGIN_ARGS structure and PFM_FILTER_PLUGIN_FUNC type to ABE.h for in-process filter plugins.
+
+
+    Version 2.1.27
+    Jan C. Depner
+    10/19/26
+
+    Added tile_contour.cpp, a tiled, multi-threaded version of the contouring package.  Tiles are aligned to absolute
+    grid rows and columns, traced in parallel, joined across tile edges on their shared grid faces, and cached by
+    position, grid checksum, and contour parameters so that only changed tiles are traced again.
+
 </pre>*/
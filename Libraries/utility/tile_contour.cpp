@@ -0,0 +1,1103 @@
+
+/*********************************************************************************************
+
+    This is public domain software that was developed by the U.S. Naval Oceanographic Office.
+
+    This is a work of the US Government. In accordance with 17 USC 105, copyright protection
+    is not available for any work of the US Government.
+
+    Neither the United States Government nor any employees of the United States Government,
+    makes any warranty, express or implied, without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, or assumes any liability or
+    responsibility for the accuracy, completeness, or usefulness of any information,
+    apparatus, product, or process disclosed, or represents that its use would not infringe
+    privately-owned rights. Reference herein to any specific commercial products, process,
+    or service by trade name, trademark, manufacturer, or otherwise, does not necessarily
+    constitute or imply its endorsement, recommendation, or favoring by the United States
+    Government. The views and opinions of authors expressed herein do not necessarily state
+    or reflect those of the United States Government, and shall not be used for advertising
+    or product endorsement purposes.
+
+*********************************************************************************************/
+
+
+/****************************************  IMPORTANT NOTE  **********************************
+
+    Comments in this file that start with / * ! or / / ! are being used by Doxygen to
+    document the software.  Dashes in these comment blocks are used to create bullet lists.
+    The lack of blank lines after a block of dash preceeded comments means that the next
+    block of dash preceeded comments is a new, indented bullet list.  I've tried to keep the
+    Doxygen formatting to a minimum but there are some other items (like <br> and <pre>)
+    that need to be left alone.  If you see a comment that starts with / * ! or / / ! and
+    there is something that looks a bit weird it is probably due to some arcane Doxygen
+    syntax.  Be very careful modifying blocks of Doxygen comments.
+
+*****************************************  IMPORTANT NOTE  **********************************/
+
+
+/***************************************************************************/
+/*!
+
+  - Module Name:      tile_contour.cpp
+
+  - Purpose:          Tiled, multi-threaded version of the contouring package
+                      in contour.cpp.  The grid is split into tiles that are
+                      aligned to absolute grid rows and columns.  Each tile is
+                      traced independently (in parallel) and the results are
+                      cached by tile position, grid checksum, and contour
+                      parameters so that redrawing a panned or zoomed view
+                      only traces the tiles that changed.  Lines that cross
+                      tile boundaries are joined on the grid face they share
+                      so the output doesn't depend on the tiling or on the
+                      number of threads.
+
+                      Unlike contour.cpp there is no static state so any
+                      number of contexts can be in use at the same time.
+
+****************************************************************************/
+
+#include <QtCore>
+
+#include "tile_contour.hpp"
+
+
+/*  Grid face directions used in face keys.  */
+
+#define TC_HORIZONTAL 0
+#define TC_VERTICAL   1
+
+
+/*  A line from one of the tiles and where it goes in the stitched output.  */
+
+typedef struct
+{
+  TILE_CONTOUR_TILE *tile;
+  NV_INT32    line;
+  NV_INT32    order;
+} TC_LINE_REF;
+
+
+/*  One open end of a tile line, used to join lines across tiles.  */
+
+typedef struct
+{
+  NV_INT64    face;
+  NV_INT32    ref;
+  NV_INT32    end;
+} TC_LINE_END;
+
+
+/*  Work arrays used while tracing a tile.  */
+
+typedef struct
+{
+  NV_INT32    max_segs;
+  NV_INT32    seg_count;
+  NV_INT32    *seg_face;
+  NV_U_BYTE   *used;
+  NV_INT32    *face_ref;
+  NV_INT32    max_points;
+  NV_INT32    max_lines;
+} TC_WORK;
+
+
+static void *tc_alloc (void *ptr, size_t size)
+{
+  void *new_ptr = realloc (ptr, size);
+
+  if (new_ptr == NULL && size)
+    {
+      perror ("Allocating memory in tile_contour.cpp");
+      exit (-1);
+    }
+
+  return (new_ptr);
+}
+
+
+
+/*  FNV-1a hash of a block of memory.  */
+
+static NV_U_INT64 tc_hash (NV_U_INT64 hash, const void *data, size_t size)
+{
+  const NV_U_BYTE *ptr = (const NV_U_BYTE *) data;
+
+  for (size_t i = 0 ; i < size ; i++)
+    {
+      hash ^= ptr[i];
+      hash *= 1099511628211ULL;
+    }
+
+  return (hash);
+}
+
+
+
+static NV_INT64 tc_face_key (NV_INT32 x, NV_INT32 y, NV_INT32 dir)
+{
+  return (((NV_INT64) y << 33) | ((NV_INT64) x << 1) | dir);
+}
+
+
+
+/*  Parameters and grid shared by all of the tiles being traced.  */
+
+typedef struct
+{
+  NV_FLOAT32  *grid;
+  NV_INT32    rows;
+  NV_INT32    columns;
+  NV_INT32    row0;
+  NV_INT32    column0;
+  TILE_CONTOUR *tc;
+} TC_GRID;
+
+
+
+/***************************************************************************/
+/*!
+
+  - Function Name:    traceLevel
+
+  - Purpose:          Traces one contour level through one tile using
+                      marching squares and chains the cell segments into
+                      lines.  Segments that touch an invalid face (invalid
+                      grid value, or too dense for a non-emphasis contour)
+                      are dropped just like contour.cpp stops following a
+                      contour at an invalid face.  Saddle cells are resolved
+                      using the average of the four corners.
+
+****************************************************************************/
+
+static void traceLevel (TC_GRID *g, TILE_CONTOUR_TILE *t, TC_WORK *w, NV_INT32 step, NV_FLOAT32 level, NV_INT32 emph)
+{
+  TILE_CONTOUR *tc = g->tc;
+  NV_INT32 lx0 = t->x0 - g->column0, ly0 = t->y0 - g->row0;
+  NV_INT32 width = t->width, height = t->height;
+  NV_INT32 h_faces = (height + 1) * width;
+  NV_FLOAT32 maxDelta = tc->interval * tc->maxDensity;
+
+  if (tc->interval == 0.0 || emph) maxDelta = 999999999.0F;
+
+
+  w->seg_count = 0;
+
+
+  for (NV_INT32 y = 0 ; y < height ; y++)
+    {
+      NV_FLOAT32 *row = g->grid + (NV_INT64) (ly0 + y) * g->columns + lx0;
+
+      for (NV_INT32 x = 0 ; x < width ; x++)
+        {
+          NV_FLOAT32 v00 = row[x], v10 = row[x + 1], v01 = row[x + g->columns], v11 = row[x + g->columns + 1];
+
+          NV_INT32 c = (v00 >= level) | ((v10 >= level) << 1) | ((v11 >= level) << 2) | ((v01 >= level) << 3);
+
+          if (!c || c == 15) continue;
+
+
+          /*  Faces of the cell - bottom, right, top, left.  */
+
+          NV_INT32 face[4] = {y * width + x, h_faces + y * (width + 1) + x + 1, (y + 1) * width + x, h_faces + y * (width + 1) + x};
+          NV_FLOAT32 fa[4] = {v00, v10, v01, v00}, fb[4] = {v10, v11, v11, v01};
+          NV_INT32 pair[4], pairs = 0;
+
+          switch (c)
+            {
+            case 1: case 14: pair[0] = 3; pair[1] = 0; pairs = 1; break;
+            case 2: case 13: pair[0] = 0; pair[1] = 1; pairs = 1; break;
+            case 3: case 12: pair[0] = 3; pair[1] = 1; pairs = 1; break;
+            case 4: case 11: pair[0] = 1; pair[1] = 2; pairs = 1; break;
+            case 6: case 9:  pair[0] = 0; pair[1] = 2; pairs = 1; break;
+            case 7: case 8:  pair[0] = 3; pair[1] = 2; pairs = 1; break;
+
+            case 5:
+            case 10:
+              pairs = 2;
+              if (((v00 + v10 + v01 + v11) * 0.25F >= level) == (v00 >= level))
+                {
+                  pair[0] = 0; pair[1] = 1; pair[2] = 2; pair[3] = 3;
+                }
+              else
+                {
+                  pair[0] = 3; pair[1] = 0; pair[2] = 1; pair[3] = 2;
+                }
+              break;
+            }
+
+
+          for (NV_INT32 p = 0 ; p < pairs * 2 ; p += 2)
+            {
+              NV_BOOL ok = NVTrue;
+
+              for (NV_INT32 k = 0 ; k < 2 ; k++)
+                {
+                  NV_FLOAT32 a = fa[pair[p + k]], b = fb[pair[p + k]];
+
+                  if (a < tc->minValue || a > tc->maxValue || b < tc->minValue || b > tc->maxValue ||
+                      fabs ((NV_FLOAT64) (a - b)) > maxDelta) ok = NVFalse;
+                }
+
+              if (!ok) continue;
+
+
+              if (w->seg_count == w->max_segs)
+                {
+                  w->max_segs = w->max_segs ? w->max_segs * 2 : 1024;
+                  w->seg_face = (NV_INT32 *) tc_alloc (w->seg_face, w->max_segs * 2 * sizeof (NV_INT32));
+                  w->used = (NV_U_BYTE *) tc_alloc (w->used, w->max_segs);
+                }
+
+              w->seg_face[w->seg_count * 2] = face[pair[p]];
+              w->seg_face[w->seg_count * 2 + 1] = face[pair[p + 1]];
+              w->used[w->seg_count] = 0;
+              w->seg_count++;
+            }
+        }
+    }
+
+  if (!w->seg_count) return;
+
+
+  /*  Each face is shared by at most two segments.  */
+
+  for (NV_INT32 s = 0 ; s < w->seg_count ; s++)
+    {
+      for (NV_INT32 k = 0 ; k < 2 ; k++)
+        {
+          NV_INT32 f = w->seg_face[s * 2 + k];
+
+          if (w->face_ref[f * 2] < 0)
+            {
+              w->face_ref[f * 2] = s;
+            }
+          else
+            {
+              w->face_ref[f * 2 + 1] = s;
+            }
+        }
+    }
+
+
+  /*  Walk the open lines first (those that start on a face with only one segment) and then the closed ones.  */
+
+  for (NV_INT32 pass = 0 ; pass < 2 ; pass++)
+    {
+      for (NV_INT32 s = 0 ; s < w->seg_count ; s++)
+        {
+          for (NV_INT32 k = 0 ; k < 2 ; k++)
+            {
+              if (w->used[s]) break;
+
+              NV_INT32 f = w->seg_face[s * 2 + k];
+
+              if (!pass && w->face_ref[f * 2 + 1] >= 0) continue;
+
+
+              if (t->line_count == w->max_lines)
+                {
+                  w->max_lines = w->max_lines ? w->max_lines * 2 : 256;
+                  t->line = (TILE_CONTOUR_LINE *) tc_alloc (t->line, w->max_lines * sizeof (TILE_CONTOUR_LINE));
+                }
+
+              TILE_CONTOUR_LINE *line = &t->line[t->line_count++];
+
+              line->step = step;
+              line->start = t->point_count;
+              line->count = 0;
+
+
+              NV_INT32 seg = s, end = k, first = f;
+
+              while (1)
+                {
+                  /*  Add the crossing point on face f.  The point is computed from the face alone so that the
+                      two tiles that share a face compute exactly the same point.  */
+
+                  if (t->point_count == w->max_points)
+                    {
+                      w->max_points = w->max_points ? w->max_points * 2 : 4096;
+                      t->x = (NV_FLOAT32 *) tc_alloc (t->x, w->max_points * sizeof (NV_FLOAT32));
+                      t->y = (NV_FLOAT32 *) tc_alloc (t->y, w->max_points * sizeof (NV_FLOAT32));
+                    }
+
+                  NV_INT32 fx, fy, dir;
+                  NV_FLOAT32 *ptr;
+
+                  if (f < h_faces)
+                    {
+                      dir = TC_HORIZONTAL;
+                      fy = f / width;
+                      fx = f % width;
+                      ptr = g->grid + (NV_INT64) (ly0 + fy) * g->columns + lx0 + fx;
+                      NV_FLOAT32 a = ptr[0], b = ptr[1];
+                      t->x[t->point_count] = (NV_FLOAT32) fx + (level - a) / (b - a);
+                      t->y[t->point_count] = (NV_FLOAT32) fy;
+                    }
+                  else
+                    {
+                      dir = TC_VERTICAL;
+                      fy = (f - h_faces) / (width + 1);
+                      fx = (f - h_faces) % (width + 1);
+                      ptr = g->grid + (NV_INT64) (ly0 + fy) * g->columns + lx0 + fx;
+                      NV_FLOAT32 a = ptr[0], b = ptr[g->columns];
+                      t->x[t->point_count] = (NV_FLOAT32) fx;
+                      t->y[t->point_count] = (NV_FLOAT32) fy + (level - a) / (b - a);
+                    }
+
+                  t->point_count++;
+                  line->count++;
+
+                  if (line->count == 1) line->start_face = tc_face_key (t->x0 + fx, t->y0 + fy, dir);
+                  line->end_face = tc_face_key (t->x0 + fx, t->y0 + fy, dir);
+
+
+                  /*  Stop when we run out of segments or get back to where we started.  */
+
+                  if (seg < 0) break;
+
+                  w->used[seg] = 1;
+                  f = w->seg_face[seg * 2 + 1 - end];
+
+                  NV_INT32 next = (w->face_ref[f * 2] == seg) ? w->face_ref[f * 2 + 1] : w->face_ref[f * 2];
+
+                  if (next >= 0 && !w->used[next])
+                    {
+                      seg = next;
+                      end = (w->seg_face[next * 2] == f) ? 0 : 1;
+                    }
+                  else
+                    {
+                      seg = -1;
+                    }
+                }
+
+              line->closed = (pass && f == first);
+            }
+        }
+    }
+
+
+  /*  Clear the face references we used.  */
+
+  for (NV_INT32 s = 0 ; s < w->seg_count ; s++)
+    {
+      w->face_ref[w->seg_face[s * 2] * 2] = w->face_ref[w->seg_face[s * 2] * 2 + 1] = -1;
+      w->face_ref[w->seg_face[s * 2 + 1] * 2] = w->face_ref[w->seg_face[s * 2 + 1] * 2 + 1] = -1;
+    }
+}
+
+
+
+/***************************************************************************/
+/*!
+
+  - Function Name:    traceTile
+
+  - Purpose:          Traces all of the contour levels that pass through a
+                      tile.  The levels are computed from the valid grid
+                      values in the tile the same way initContour computes
+                      them for the whole grid.
+
+****************************************************************************/
+
+static void traceTile (TC_GRID *g, TILE_CONTOUR_TILE *t)
+{
+  TILE_CONTOUR *tc = g->tc;
+  NV_INT32 lx0 = t->x0 - g->column0, ly0 = t->y0 - g->row0;
+  NV_FLOAT32 min = tc->maxValue, max = tc->minValue;
+  TC_WORK w;
+
+
+  t->line_count = t->point_count = 0;
+
+
+  for (NV_INT32 y = 0 ; y <= t->height ; y++)
+    {
+      NV_FLOAT32 *row = g->grid + (NV_INT64) (ly0 + y) * g->columns + lx0;
+
+      for (NV_INT32 x = 0 ; x <= t->width ; x++)
+        {
+          if (row[x] >= tc->minValue && row[x] <= tc->maxValue)
+            {
+              if (row[x] < min) min = row[x];
+              if (row[x] > max) max = row[x];
+            }
+        }
+    }
+
+  if (min > max) return;
+
+
+  memset (&w, 0, sizeof (TC_WORK));
+
+  NV_INT32 faces = (t->height + 1) * t->width + t->height * (t->width + 1);
+  w.face_ref = (NV_INT32 *) tc_alloc (NULL, faces * 2 * sizeof (NV_INT32));
+  for (NV_INT32 i = 0 ; i < faces * 2 ; i++) w.face_ref[i] = -1;
+
+
+  if (tc->interval == 0.0)
+    {
+      for (NV_INT32 i = 0 ; i < tc->numLevels ; i++)
+        {
+          if (tc->levels[i] >= min && tc->levels[i] <= max) traceLevel (g, t, &w, i, tc->levels[i], NVFalse);
+        }
+    }
+  else
+    {
+      NV_INT32 first_step = (NV_INT32) floor ((NV_FLOAT64) (min / tc->interval));
+      if (fmod ((NV_FLOAT64) min, (NV_FLOAT64) tc->interval) != 0) first_step++;
+      NV_INT32 last_step = (NV_INT32) floor ((NV_FLOAT64) (max / tc->interval));
+
+      for (NV_INT32 step = first_step ; step <= last_step ; step++)
+        traceLevel (g, t, &w, step, step * tc->interval, !(step % tc->emphasis));
+    }
+
+
+  free (w.face_ref);
+  free (w.seg_face);
+  free (w.used);
+}
+
+
+
+/*  Thread used by initTileContour to trace part of the tiles that weren't in the cache.  */
+
+class tileContourThread:public QThread
+{
+public:
+
+  TC_GRID                 *grid;
+  TILE_CONTOUR_TILE       **tile;
+  NV_INT32                first, last;
+
+
+protected:
+
+  void run ()
+  {
+    for (NV_INT32 i = first ; i < last ; i++) traceTile (grid, tile[i]);
+  }
+};
+
+
+
+static void freeTile (TILE_CONTOUR_TILE *t)
+{
+  free (t->line);
+  free (t->x);
+  free (t->y);
+  free (t);
+}
+
+
+
+static NV_INT32 compareRefs (const void *a, const void *b)
+{
+  TC_LINE_REF *ra = (TC_LINE_REF *) a;
+  TC_LINE_REF *rb = (TC_LINE_REF *) b;
+  NV_INT32 sa = ra->tile->line[ra->line].step, sb = rb->tile->line[rb->line].step;
+
+  if (sa != sb) return (sa < sb ? -1 : 1);
+
+  return (ra->order < rb->order ? -1 : (ra->order > rb->order ? 1 : 0));
+}
+
+
+
+static NV_INT32 compareEnds (const void *a, const void *b)
+{
+  TC_LINE_END *ea = (TC_LINE_END *) a;
+  TC_LINE_END *eb = (TC_LINE_END *) b;
+
+  if (ea->face != eb->face) return (ea->face < eb->face ? -1 : 1);
+
+  if (ea->ref != eb->ref) return (ea->ref < eb->ref ? -1 : 1);
+
+  return (ea->end - eb->end);
+}
+
+
+
+static NV_INT32 compareUsed (const void *a, const void *b)
+{
+  TILE_CONTOUR_TILE *ta = *((TILE_CONTOUR_TILE **) a);
+  TILE_CONTOUR_TILE *tb = *((TILE_CONTOUR_TILE **) b);
+
+  return (ta->last_used > tb->last_used ? -1 : (ta->last_used < tb->last_used ? 1 : 0));
+}
+
+
+
+/*  Append one tile line (or the reverse of it) to the stitched output of the context.  The point on the shared face
+    is dropped when skip_first is set.  */
+
+static void appendLine (TILE_CONTOUR *tc, NV_INT32 *max_points, TC_GRID *g, TC_LINE_REF *ref, NV_BOOL reverse,
+                        NV_BOOL skip_first)
+{
+  TILE_CONTOUR_TILE *t = ref->tile;
+  TILE_CONTOUR_LINE *line = &t->line[ref->line];
+  NV_FLOAT32 dx = (NV_FLOAT32) (t->x0 - g->column0), dy = (NV_FLOAT32) (t->y0 - g->row0);
+
+  if (tc->point_count + line->count > *max_points)
+    {
+      *max_points = qMax (*max_points * 2, tc->point_count + line->count);
+      tc->x = (NV_FLOAT32 *) tc_alloc (tc->x, *max_points * sizeof (NV_FLOAT32));
+      tc->y = (NV_FLOAT32 *) tc_alloc (tc->y, *max_points * sizeof (NV_FLOAT32));
+    }
+
+  for (NV_INT32 i = skip_first ? 1 : 0 ; i < line->count ; i++)
+    {
+      NV_INT32 j = line->start + (reverse ? line->count - 1 - i : i);
+
+      tc->x[tc->point_count] = t->x[j] + dx;
+      tc->y[tc->point_count] = t->y[j] + dy;
+      tc->point_count++;
+    }
+
+  tc->contour[tc->contour_count - 1].count = tc->point_count - tc->contour[tc->contour_count - 1].start;
+}
+
+
+
+/*  Start a new stitched contour.  */
+
+static void newContour (TILE_CONTOUR *tc, NV_INT32 *max_contours, NV_INT32 step)
+{
+  if (tc->contour_count == *max_contours)
+    {
+      *max_contours = *max_contours ? *max_contours * 2 : 256;
+      tc->contour = (TILE_CONTOUR_OUTPUT *) tc_alloc (tc->contour, *max_contours * sizeof (TILE_CONTOUR_OUTPUT));
+    }
+
+  TILE_CONTOUR_OUTPUT *out = &tc->contour[tc->contour_count++];
+
+  if (tc->interval == 0.0)
+    {
+      out->level = tc->levels[step];
+      out->emph = NVFalse;
+    }
+  else
+    {
+      out->level = step * tc->interval;
+      out->emph = !(step % tc->emphasis);
+    }
+
+  out->start = tc->point_count;
+  out->count = 0;
+}
+
+
+
+/***************************************************************************/
+/*!
+
+  - Function Name:    stitchLevel
+
+  - Purpose:          Joins the lines of one contour level from all of the
+                      tiles.  Open line ends are sorted by the key of the
+                      grid face they end on so that ends that share a face
+                      (there can only be two) are adjacent.  Lines are
+                      then walked in tile order starting with lines that
+                      have a free end, and finally the lines that form
+                      loops across tiles.
+
+****************************************************************************/
+
+static void stitchLevel (TILE_CONTOUR *tc, TC_GRID *g, TC_LINE_REF *ref, NV_INT32 count, NV_INT32 *max_contours,
+                         NV_INT32 *max_points)
+{
+  NV_INT32 step = ref[0].tile->line[ref[0].line].step;
+  TC_LINE_END *end = (TC_LINE_END *) tc_alloc (NULL, count * 2 * sizeof (TC_LINE_END));
+  NV_INT32 *partner = (NV_INT32 *) tc_alloc (NULL, count * 2 * sizeof (NV_INT32));
+  NV_U_BYTE *done = (NV_U_BYTE *) calloc (count, 1);
+  NV_INT32 ends = 0;
+
+  if (done == NULL)
+    {
+      perror ("Allocating done in tile_contour.cpp");
+      exit (-1);
+    }
+
+
+  for (NV_INT32 i = 0 ; i < count ; i++)
+    {
+      TILE_CONTOUR_LINE *line = &ref[i].tile->line[ref[i].line];
+
+      partner[i * 2] = partner[i * 2 + 1] = -1;
+
+      if (line->closed)
+        {
+          newContour (tc, max_contours, step);
+          appendLine (tc, max_points, g, &ref[i], NVFalse, NVFalse);
+          done[i] = 1;
+        }
+      else
+        {
+          end[ends].face = line->start_face;
+          end[ends].ref = i;
+          end[ends].end = 0;
+          ends++;
+          end[ends].face = line->end_face;
+          end[ends].ref = i;
+          end[ends].end = 1;
+          ends++;
+        }
+    }
+
+  qsort (end, ends, sizeof (TC_LINE_END), compareEnds);
+
+  for (NV_INT32 i = 1 ; i < ends ; i++)
+    {
+      if (end[i].face == end[i - 1].face)
+        {
+          partner[end[i].ref * 2 + end[i].end] = end[i - 1].ref * 2 + end[i - 1].end;
+          partner[end[i - 1].ref * 2 + end[i - 1].end] = end[i].ref * 2 + end[i].end;
+        }
+    }
+
+
+  for (NV_INT32 pass = 0 ; pass < 2 ; pass++)
+    {
+      for (NV_INT32 i = 0 ; i < count ; i++)
+        {
+          if (done[i]) continue;
+
+
+          /*  On the first pass only start from a free end.  */
+
+          NV_INT32 in_end;
+
+          if (partner[i * 2] < 0)
+            {
+              in_end = 0;
+            }
+          else if (partner[i * 2 + 1] < 0)
+            {
+              in_end = 1;
+            }
+          else if (pass)
+            {
+              in_end = 0;
+            }
+          else
+            {
+              continue;
+            }
+
+
+          newContour (tc, max_contours, step);
+
+          NV_INT32 j = i;
+          NV_BOOL skip = NVFalse;
+
+          while (j >= 0 && !done[j])
+            {
+              appendLine (tc, max_points, g, &ref[j], (NV_BOOL) in_end, skip);
+              done[j] = 1;
+
+              NV_INT32 p = partner[j * 2 + 1 - in_end];
+
+              if (p < 0)
+                {
+                  j = -1;
+                }
+              else
+                {
+                  j = p / 2;
+                  in_end = p % 2;
+                  skip = NVTrue;
+                }
+            }
+
+
+          /*  Close loops that cross tiles with the first point.  */
+
+          if (j == i)
+            {
+              TILE_CONTOUR_OUTPUT *out = &tc->contour[tc->contour_count - 1];
+
+              tc->x[out->start + out->count - 1] = tc->x[out->start];
+              tc->y[out->start + out->count - 1] = tc->y[out->start];
+            }
+        }
+    }
+
+  free (end);
+  free (partner);
+  free (done);
+}
+
+
+
+/***************************************************************************/
+/*!
+
+  - Function Name:    createTileContour
+
+  - Purpose:          Allocates a tiled contouring context with the same
+                      default parameters as initContour.
+
+  - Inputs:           max_tiles = maximum number of traced tiles to keep in
+                                  the cache (0 for TILE_CONTOUR_MAX_TILES)
+
+  - Outputs:          Pointer to the context
+
+****************************************************************************/
+
+TILE_CONTOUR *createTileContour (NV_INT32 max_tiles)
+{
+  TILE_CONTOUR *tc = (TILE_CONTOUR *) calloc (1, sizeof (TILE_CONTOUR));
+
+  if (tc == NULL)
+    {
+      perror ("Allocating TILE_CONTOUR in tile_contour.cpp");
+      exit (-1);
+    }
+
+  tc->max_tiles = max_tiles > 0 ? max_tiles : TILE_CONTOUR_MAX_TILES;
+
+  tileContourParameters (tc, -1.0e16F, 1.0e16F, 5, 999, 1000, 0, NULL);
+
+  return (tc);
+}
+
+
+
+/***************************************************************************/
+/*!
+
+  - Function Name:    freeTileContour
+
+  - Purpose:          Frees a tiled contouring context and all of its
+                      cached tiles.
+
+  - Inputs:           tc = context
+
+****************************************************************************/
+
+void freeTileContour (TILE_CONTOUR *tc)
+{
+  if (tc == NULL) return;
+
+  for (NV_INT32 i = 0 ; i < tc->tile_count ; i++) freeTile (tc->tile[i]);
+
+  free (tc->tile);
+  free (tc->contour);
+  free (tc->x);
+  free (tc->y);
+  free (tc);
+}
+
+
+
+/***************************************************************************/
+/*!
+
+  - Function Name:    tileContourParameters
+
+  - Purpose:          Sets the optional contour parameters (see
+                      contourMinMax, contourEmphasis, contourMaxDensity,
+                      contourMaxPoints, and contourLevels in contour.cpp).
+                      Cached tiles traced with different parameters are
+                      not reused but are kept so that switching back is
+                      cheap.
+
+  - Inputs:
+                      - tc         = context
+                      - minValue   = minimum valid grid value
+                      - maxValue   = maximum valid grid value
+                      - emphasis   = number of contours between emphasis contours
+                      - maxDensity = maximum number of contours per grid cell
+                      - maxPoints  = maximum number of points returned by getTileContour
+                      - numLevels  = number of user defined levels (used when the interval is 0.0)
+                      - levels     = user defined levels
+
+****************************************************************************/
+
+void tileContourParameters (TILE_CONTOUR *tc, NV_FLOAT32 minValue, NV_FLOAT32 maxValue, NV_INT32 emphasis, NV_INT32 maxDensity,
+                            NV_INT32 maxPoints, NV_INT32 numLevels, NV_FLOAT32 *levels)
+{
+  tc->minValue = minValue;
+  tc->maxValue = maxValue;
+  tc->emphasis = emphasis > 0 ? emphasis : 5;
+  tc->maxDensity = maxDensity;
+  tc->maxPoints = qMax (maxPoints, 2);
+  tc->numLevels = qMin (qMax (numLevels, 0), TILE_CONTOUR_MAX_LEVELS);
+
+  for (NV_INT32 i = 0 ; i < tc->numLevels ; i++) tc->levels[i] = levels[i];
+}
+
+
+
+/***************************************************************************/
+/*!
+
+  - Function Name:    initTileContour
+
+  - Purpose:          Contours a grid.  The grid is split into
+                      TILE_CONTOUR_SIZE tiles aligned to absolute rows and
+                      columns (row0 and column0 are the absolute row and
+                      column of the first grid point).  Tiles that aren't
+                      in the cache are traced in parallel and then all of
+                      the lines are joined into contours in level order.
+                      The contours are returned by getTileContour.
+
+  - Inputs:
+                      - tc       = context
+                      - interval = contour interval (0.0 to use the levels)
+                      - rows     = number of rows in the grid
+                      - columns  = number of columns in the grid
+                      - grid     = grid values (row major)
+                      - row0     = absolute row of the first grid row
+                      - column0  = absolute column of the first grid column
+
+  - Outputs:          NVTrue if there is anything to contour
+
+****************************************************************************/
+
+NV_BOOL initTileContour (TILE_CONTOUR *tc, NV_FLOAT32 interval, NV_INT32 rows, NV_INT32 columns, NV_FLOAT32 *grid,
+                         NV_INT32 row0, NV_INT32 column0)
+{
+  TC_GRID g;
+
+
+  tc->contour_count = tc->point_count = tc->present = tc->present_point = 0;
+
+  if (rows < 2 || columns < 2 || row0 < 0 || column0 < 0) return (NVFalse);
+
+
+  tc->interval = interval;
+  tc->generation++;
+
+
+  /*  Signature of everything other than the grid that changes the traced lines.  */
+
+  tc->signature = tc_hash (14695981039346656037ULL, &tc->interval, sizeof (NV_FLOAT32));
+  tc->signature = tc_hash (tc->signature, &tc->minValue, sizeof (NV_FLOAT32));
+  tc->signature = tc_hash (tc->signature, &tc->maxValue, sizeof (NV_FLOAT32));
+  tc->signature = tc_hash (tc->signature, &tc->emphasis, sizeof (NV_INT32));
+  tc->signature = tc_hash (tc->signature, &tc->maxDensity, sizeof (NV_INT32));
+  if (interval == 0.0)
+    {
+      tc->signature = tc_hash (tc->signature, &tc->numLevels, sizeof (NV_INT32));
+      tc->signature = tc_hash (tc->signature, tc->levels, tc->numLevels * sizeof (NV_FLOAT32));
+    }
+
+
+  g.grid = grid;
+  g.rows = rows;
+  g.columns = columns;
+  g.row0 = row0;
+  g.column0 = column0;
+  g.tc = tc;
+
+
+  /*  Find (or create) the tiles covering the grid cells in row major order.  */
+
+  NV_INT32 first_tx = column0 / TILE_CONTOUR_SIZE, last_tx = (column0 + columns - 2) / TILE_CONTOUR_SIZE;
+  NV_INT32 first_ty = row0 / TILE_CONTOUR_SIZE, last_ty = (row0 + rows - 2) / TILE_CONTOUR_SIZE;
+  NV_INT32 count = (last_tx - first_tx + 1) * (last_ty - first_ty + 1), miss_count = 0;
+
+  TILE_CONTOUR_TILE **tile = (TILE_CONTOUR_TILE **) tc_alloc (NULL, count * sizeof (TILE_CONTOUR_TILE *));
+  TILE_CONTOUR_TILE **miss = (TILE_CONTOUR_TILE **) tc_alloc (NULL, count * sizeof (TILE_CONTOUR_TILE *));
+
+  count = 0;
+
+  for (NV_INT32 ty = first_ty ; ty <= last_ty ; ty++)
+    {
+      NV_INT32 y0 = qMax (ty * TILE_CONTOUR_SIZE, row0);
+      NV_INT32 height = qMin ((ty + 1) * TILE_CONTOUR_SIZE, row0 + rows - 1) - y0;
+
+      for (NV_INT32 tx = first_tx ; tx <= last_tx ; tx++)
+        {
+          NV_INT32 x0 = qMax (tx * TILE_CONTOUR_SIZE, column0);
+          NV_INT32 width = qMin ((tx + 1) * TILE_CONTOUR_SIZE, column0 + columns - 1) - x0;
+
+          NV_U_INT64 checksum = 14695981039346656037ULL;
+
+          for (NV_INT32 y = 0 ; y <= height ; y++)
+            checksum = tc_hash (checksum, grid + (NV_INT64) (y0 - row0 + y) * columns + x0 - column0, (width + 1) * sizeof (NV_FLOAT32));
+
+
+          TILE_CONTOUR_TILE *t = NULL;
+
+          for (NV_INT32 i = 0 ; i < tc->tile_count ; i++)
+            {
+              TILE_CONTOUR_TILE *c = tc->tile[i];
+
+              if (c->x0 == x0 && c->y0 == y0 && c->width == width && c->height == height && c->checksum == checksum &&
+                  c->signature == tc->signature)
+                {
+                  t = c;
+                  break;
+                }
+            }
+
+          if (t == NULL)
+            {
+              t = (TILE_CONTOUR_TILE *) calloc (1, sizeof (TILE_CONTOUR_TILE));
+
+              if (t == NULL)
+                {
+                  perror ("Allocating TILE_CONTOUR_TILE in tile_contour.cpp");
+                  exit (-1);
+                }
+
+              t->x0 = x0;
+              t->y0 = y0;
+              t->width = width;
+              t->height = height;
+              t->checksum = checksum;
+              t->signature = tc->signature;
+              miss[miss_count++] = t;
+            }
+
+          t->last_used = tc->generation;
+          tile[count++] = t;
+        }
+    }
+
+
+  /*  Trace the new tiles.  */
+
+  NV_INT32 num_threads = qMin (qMax (QThread::idealThreadCount (), 1), qMax (miss_count / TILE_CONTOUR_THREAD_TILES, 1));
+
+  if (num_threads == 1)
+    {
+      for (NV_INT32 i = 0 ; i < miss_count ; i++) traceTile (&g, miss[i]);
+    }
+  else
+    {
+      tileContourThread *trace = new tileContourThread[num_threads];
+
+      for (NV_INT32 i = 0 ; i < num_threads ; i++)
+        {
+          trace[i].grid = &g;
+          trace[i].tile = miss;
+          trace[i].first = (miss_count * i) / num_threads;
+          trace[i].last = (miss_count * (i + 1)) / num_threads;
+          trace[i].start ();
+        }
+
+      for (NV_INT32 i = 0 ; i < num_threads ; i++) trace[i].wait ();
+
+      delete[] trace;
+    }
+
+
+  /*  Add the new tiles to the cache and drop the least recently used tiles if it's full (never the ones we're
+      using now).  */
+
+  if (miss_count)
+    {
+      tc->tile = (TILE_CONTOUR_TILE **) tc_alloc (tc->tile, (tc->tile_count + miss_count) * sizeof (TILE_CONTOUR_TILE *));
+      memcpy (&tc->tile[tc->tile_count], miss, miss_count * sizeof (TILE_CONTOUR_TILE *));
+      tc->tile_count += miss_count;
+    }
+
+  if (tc->tile_count > tc->max_tiles)
+    {
+      qsort (tc->tile, tc->tile_count, sizeof (TILE_CONTOUR_TILE *), compareUsed);
+
+      while (tc->tile_count > tc->max_tiles && tc->tile[tc->tile_count - 1]->last_used != tc->generation)
+        freeTile (tc->tile[--tc->tile_count]);
+    }
+
+  free (miss);
+
+
+  /*  Gather all of the lines and sort them by level (keeping the tile and trace order within a level).  */
+
+  NV_INT32 line_count = 0;
+  for (NV_INT32 i = 0 ; i < count ; i++) line_count += tile[i]->line_count;
+
+  if (line_count)
+    {
+      TC_LINE_REF *ref = (TC_LINE_REF *) tc_alloc (NULL, line_count * sizeof (TC_LINE_REF));
+
+      line_count = 0;
+      for (NV_INT32 i = 0 ; i < count ; i++)
+        {
+          for (NV_INT32 j = 0 ; j < tile[i]->line_count ; j++)
+            {
+              ref[line_count].tile = tile[i];
+              ref[line_count].line = j;
+              ref[line_count].order = line_count;
+              line_count++;
+            }
+        }
+
+      qsort (ref, line_count, sizeof (TC_LINE_REF), compareRefs);
+
+
+      NV_INT32 max_contours = 0, max_points = 0;
+
+      for (NV_INT32 i = 0 ; i < line_count ; )
+        {
+          NV_INT32 step = ref[i].tile->line[ref[i].line].step, j = i + 1;
+
+          while (j < line_count && ref[j].tile->line[ref[j].line].step == step) j++;
+
+          stitchLevel (tc, &g, &ref[i], j - i, &max_contours, &max_points);
+
+          i = j;
+        }
+
+      free (ref);
+    }
+
+  free (tile);
+
+
+  return (tc->contour_count > 0);
+}
+
+
+
+/***************************************************************************/
+/*!
+
+  - Function Name:    getTileContour
+
+  - Purpose:          Returns the contours computed by initTileContour one
+                      at a time, in the same way as getContour.  Contours
+                      with more than maxPoints points are returned in
+                      pieces with the last point of each piece repeated as
+                      the first point of the next.
+
+  - Inputs:           tc, level, emph, points, x, y
+
+  - Outputs:          NVTrue if a contour is being returned, NVFalse when
+                      all contours have been returned
+
+****************************************************************************/
+
+NV_BOOL getTileContour (TILE_CONTOUR *tc, NV_FLOAT32 *level, NV_INT32 *emph, NV_INT32 *points, NV_FLOAT32 *x, NV_FLOAT32 *y)
+{
+  while (tc->present < tc->contour_count)
+    {
+      TILE_CONTOUR_OUTPUT *out = &tc->contour[tc->present];
+      NV_INT32 left = out->count - tc->present_point;
+
+      if (left < 2)
+        {
+          tc->present++;
+          tc->present_point = 0;
+          continue;
+        }
+
+      *level = out->level;
+      *emph = out->emph;
+      *points = qMin (left, tc->maxPoints);
+
+      memcpy (x, &tc->x[out->start + tc->present_point], *points * sizeof (NV_FLOAT32));
+      memcpy (y, &tc->y[out->start + tc->present_point], *points * sizeof (NV_FLOAT32));
+
+      tc->present_point += *points - 1;
+
+      return (NVTrue);
+    }
+
+  return (NVFalse);
+}
@@ -0,0 +1,135 @@
+
+/*********************************************************************************************
+
+    This is public domain software that was developed by the U.S. Naval Oceanographic Office.
+
+    This is a work of the US Government. In accordance with 17 USC 105, copyright protection
+    is not available for any work of the US Government.
+
+    Neither the United States Government nor any employees of the United States Government,
+    makes any warranty, express or implied, without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, or assumes any liability or
+    responsibility for the accuracy, completeness, or usefulness of any information,
+    apparatus, product, or process disclosed, or represents that its use would not infringe
+    privately-owned rights. Reference herein to any specific commercial products, process,
+    or service by trade name, trademark, manufacturer, or otherwise, does not necessarily
+    constitute or imply its endorsement, recommendation, or favoring by the United States
+    Government. The views and opinions of authors expressed herein do not necessarily state
+    or reflect those of the United States Government, and shall not be used for advertising
+    or product endorsement purposes.
+
+*********************************************************************************************/
+
+
+/****************************************  IMPORTANT NOTE  **********************************
+
+    Comments in this file that start with / * ! or / / ! are being used by Doxygen to
+    document the software.  Dashes in these comment blocks are used to create bullet lists.
+    The lack of blank lines after a block of dash preceeded comments means that the next
+    block of dash preceeded comments is a new, indented bullet list.  I've tried to keep the
+    Doxygen formatting to a minimum but there are some other items (like <br> and <pre>)
+    that need to be left alone.  If you see a comment that starts with / * ! or / / ! and
+    there is something that looks a bit weird it is probably due to some arcane Doxygen
+    syntax.  Be very careful modifying blocks of Doxygen comments.
+
+*****************************************  IMPORTANT NOTE  **********************************/
+
+
+#ifndef __TILE_CONTOUR_HPP__
+#define __TILE_CONTOUR_HPP__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "nvtypes.h"
+
+
+#define TILE_CONTOUR_SIZE          64     //!<  Number of grid cells along each side of a contour tile
+#define TILE_CONTOUR_MAX_TILES     4096   //!<  Default maximum number of traced tiles kept in the cache
+#define TILE_CONTOUR_THREAD_TILES  4      //!<  Minimum number of tiles to trace in each thread
+#define TILE_CONTOUR_MAX_LEVELS    1000   //!<  Maximum number of user defined contour levels
+
+
+//!  One contour line traced inside a single tile.
+
+typedef struct
+{
+  NV_INT32    step;                       //!<  Interval step (or index into the levels array) of the line
+  NV_BOOL     closed;                     //!<  NVTrue if the line closes on itself inside the tile
+  NV_INT32    start;                      //!<  Index of the first point of the line in the tile point arrays
+  NV_INT32    count;                      //!<  Number of points in the line
+  NV_INT64    start_face;                 //!<  Key of the grid face the line starts on
+  NV_INT64    end_face;                   //!<  Key of the grid face the line ends on
+} TILE_CONTOUR_LINE;
+
+
+//!  Cached contour lines for one tile of the grid.
+
+typedef struct
+{
+  NV_INT32    x0;                         //!<  Absolute column of the first cell in the tile
+  NV_INT32    y0;                         //!<  Absolute row of the first cell in the tile
+  NV_INT32    width;                      //!<  Number of cell columns in the tile
+  NV_INT32    height;                     //!<  Number of cell rows in the tile
+  NV_U_INT64  checksum;                   //!<  Checksum of the grid values the tile was traced from
+  NV_U_INT64  signature;                  //!<  Signature of the contour parameters the tile was traced with
+  NV_INT32    last_used;                  //!<  Generation of the last initTileContour call that used the tile
+  NV_INT32    line_count;                 //!<  Number of lines
+  TILE_CONTOUR_LINE *line;                //!<  Lines in level and trace order
+  NV_INT32    point_count;                //!<  Number of points
+  NV_FLOAT32  *x;                         //!<  Point X positions relative to x0
+  NV_FLOAT32  *y;                         //!<  Point Y positions relative to y0
+} TILE_CONTOUR_TILE;
+
+
+//!  One stitched contour.
+
+typedef struct
+{
+  NV_FLOAT32  level;                      //!<  Contour level
+  NV_INT32    emph;                       //!<  NVTrue if this is an emphasis contour
+  NV_INT32    start;                      //!<  Index of the first point in the contour point arrays
+  NV_INT32    count;                      //!<  Number of points
+} TILE_CONTOUR_OUTPUT;
+
+
+//!  Tiled contouring context.  Create one for each grid that is going to be contoured repeatedly.
+
+typedef struct
+{
+  NV_FLOAT32  interval;                   //!<  Contour interval (0.0 to use the levels array)
+  NV_FLOAT32  minValue;                   //!<  Minimum valid grid value
+  NV_FLOAT32  maxValue;                   //!<  Maximum valid grid value
+  NV_INT32    emphasis;                   //!<  Number of contours between emphasis contours
+  NV_INT32    maxDensity;                 //!<  Maximum number of contours per grid cell
+  NV_INT32    maxPoints;                  //!<  Maximum number of points returned by getTileContour
+  NV_INT32    numLevels;                  //!<  Number of user defined levels
+  NV_FLOAT32  levels[TILE_CONTOUR_MAX_LEVELS]; //!<  User defined levels
+  NV_U_INT64  signature;                  //!<  Signature of the parameters above
+
+  NV_INT32    generation;                 //!<  Incremented on each call to initTileContour
+  NV_INT32    max_tiles;                  //!<  Maximum number of tiles to keep in the cache
+  NV_INT32    tile_count;                 //!<  Number of tiles in the cache
+  TILE_CONTOUR_TILE **tile;               //!<  Cached tiles
+
+  NV_INT32    contour_count;              //!<  Number of stitched contours
+  TILE_CONTOUR_OUTPUT *contour;           //!<  Stitched contours in level order
+  NV_INT32    point_count;                //!<  Number of stitched contour points
+  NV_FLOAT32  *x;                         //!<  Stitched contour X grid positions
+  NV_FLOAT32  *y;                         //!<  Stitched contour Y grid positions
+  NV_INT32    present;                    //!<  Contour being returned by getTileContour
+  NV_INT32    present_point;              //!<  First point of the next piece of the present contour
+} TILE_CONTOUR;
+
+
+TILE_CONTOUR *createTileContour (NV_INT32 max_tiles);
+void freeTileContour (TILE_CONTOUR *tc);
+void tileContourParameters (TILE_CONTOUR *tc, NV_FLOAT32 minValue, NV_FLOAT32 maxValue, NV_INT32 emphasis, NV_INT32 maxDensity,
+                            NV_INT32 maxPoints, NV_INT32 numLevels, NV_FLOAT32 *levels);
+NV_BOOL initTileContour (TILE_CONTOUR *tc, NV_FLOAT32 interval, NV_INT32 rows, NV_INT32 columns, NV_FLOAT32 *grid,
+                         NV_INT32 row0, NV_INT32 column0);
+NV_BOOL getTileContour (TILE_CONTOUR *tc, NV_FLOAT32 *level, NV_INT32 *emph, NV_INT32 *points, NV_FLOAT32 *x, NV_FLOAT32 *y);
+
+
+#endif /* __TILE_CONTOUR_HPP__ */
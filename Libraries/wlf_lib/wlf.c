@@ -35,6 +35,7 @@
 
 
 #define         WAVE_CAT_BLOCK  1048576
+#define         SCAN_BLOCK      4096        /*  Number of records read at a time when scanning.  */
 
 
 #undef WLF_DEBUG
@@ -69,6 +70,12 @@ typedef struct
                                                 on open/create and freed on close.  This saves us from allocating and
                                                 freeing on each waveform read.  It also saves the application the hassle
                                                 of trying to determine if it needs to free the waveform data.  */
+  NV_U_BYTE     *scan_buffer;               /*  Buffer holding a block of SCAN_BLOCK records for sequential reads.  This is
+                                                allocated on the first sequential read and freed on close.  */
+  NV_INT32      scan_start;                 /*  Record number of the first record in scan_buffer.  */
+  NV_INT32      scan_count;                 /*  Number of records in scan_buffer (0 if empty).  */
+  NV_INT32      scan_next;                  /*  Next record to be returned by wlf_scan_next.  */
+  NV_INT32      last_recnum;                /*  Last record read by wlf_read_record (used to detect sequential reads).  */
 
 
   /*  Number of bits needed for each field of the record.  */
@@ -2321,6 +2328,7 @@ WLF_DLL NV_INT32 wlf_create_file (const NV_CHAR *path, WLF_HEADER wlf_header)
   wlfh[hnd].created = NVTrue;
   wlfh[hnd].write = NVTrue;
   wlfh[hnd].header.number_of_records = 0;
+  wlfh[hnd].last_recnum = -1;
 
 
   wlf_error.system = 0;
@@ -2880,6 +2888,7 @@ WLF_DLL NV_INT32 wlf_open_file (const NV_CHAR *path, WLF_HEADER *wlf_header, NV_
   wlfh[hnd].modified = NVFalse;
   wlfh[hnd].created = NVFalse;
   wlfh[hnd].write = NVFalse;
+  wlfh[hnd].last_recnum = -1;
 
 
   wlf_error.system = 0;
@@ -3083,6 +3092,9 @@ WLF_DLL NV_INT32 wlf_close_file (NV_INT32 hnd)
     }
 
 
+  if (wlfh[hnd].scan_buffer) free (wlfh[hnd].scan_buffer);
+
+
   /*  Clear the internal structure.  */
 
   memset (&wlfh[hnd], 0, sizeof (INTERNAL_WLF_STRUCT));
@@ -3161,52 +3173,173 @@ WLF_DLL NV_INT32 wlf_close_file_ratio (NV_INT32 hnd, NV_FLOAT32 *ratio, NV_INT32
 
 /*********************************************************************************************
 
-  Function:    wlf_read_record
+  Function:    read_waveforms
 
-  Purpose:     Retrieve a WLF point and (optionally) waveforms from a WLF file.
+  Purpose:     Read and unpack the waveforms for the current record (the waveform address is set
+               by unpack_point_record) into the wlfh[hnd].wave arrays.
 
   Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
 
   Date:        09/25/09
 
   Arguments:   hnd            -    The file handle
-               recnum         -    The record number of the WLF record to be retrieved
-               wlf_record     -    The returned WLF record
-               wave_flag      -    Set to NVTrue if you want waveforms
-               wave           -    Pointer to the waveform structure
+               recnum         -    The record number (for error reporting)
 
   Returns:     NV_INT32       -    WLF_SUCCESS
-                                   WLF_INVALID_RECORD_NUMBER
-                                   WLF_READ_FSEEK_ERROR
-                                   WLF_READ_ERROR
                                    WLF_WAVE_READ_FSEEK_ERROR
                                    WLF_WAVE_READ_ERROR
 
-  Caveats:     The ***wave structure will be allocated by the software.  If you don't have or
-               want waveforms, set wave_flag to NVFalse and pass a NULL pointer in the
-               ***wave argument (see example in wlf.h).
-
 *********************************************************************************************/
 
-WLF_DLL NV_INT32 wlf_read_record (NV_INT32 hnd, NV_INT32 recnum, WLF_RECORD *wlf_record, NV_BOOL wave_flag, NV_INT32 ***wave)
+static NV_INT32 read_waveforms (NV_INT32 hnd, NV_INT32 recnum)
 {
-  NV_INT64 pos;
-  NV_U_BYTE buffer[1024];
   NV_INT32 i, j, bit_pos, diff, min_diff = 0, num_bits, bytes, range, start32, bias32;
   NV_INT16 start16, bias16;
   NV_BYTE start8, bias8;
 
 
-  /*  Check for record out of bounds.  */
+  if (fseeko64 (wlfh[hnd].fp, wlfh[hnd].waveform_address + wlfh[hnd].waveform_block_offset, SEEK_SET) < 0)
+    {
+      wlf_error.system = errno;
+      wlf_error.recnum = recnum;
+      strcpy (wlf_error.file, wlfh[hnd].path);
+      return (wlf_error.wlf = WLF_WAVE_READ_FSEEK_ERROR);
+    }
 
-  if (recnum >= wlfh[hnd].header.number_of_records || recnum < 0)
+  if (!fread (wlfh[hnd].wave_buffer, wlfh[hnd].waveform_blocksize_bytes, 1, wlfh[hnd].fp))
     {
+      wlf_error.system = errno;
       wlf_error.recnum = recnum;
       strcpy (wlf_error.file, wlfh[hnd].path);
-      return (wlf_error.wlf = WLF_INVALID_RECORD_NUMBER);
+      return (wlf_error.wlf = WLF_WAVE_READ_ERROR);
+    }
+
+  bytes = wlf_bit_unpack (wlfh[hnd].wave_buffer, 0, wlfh[hnd].waveform_blocksize_bits);
+
+  bytes -= wlfh[hnd].waveform_blocksize_bytes;
+
+  if (!fread (wlfh[hnd].wave_buffer, bytes, 1, wlfh[hnd].fp))
+    {
+      wlf_error.system = errno;
+      wlf_error.recnum = recnum;
+      strcpy (wlf_error.file, wlfh[hnd].path);
+      return (wlf_error.wlf = WLF_WAVE_READ_ERROR);
+    }
+
+  bit_pos = 0;
+  for (i = 0 ; i < wlfh[hnd].header.number_of_waveforms ; i++)
+    {
+      wlfh[hnd].waveform_start_value_size = 8;
+      range = wlfh[hnd].header.max_waveform[i] - wlfh[hnd].header.min_waveform[i];
+      if (range > 255) wlfh[hnd].waveform_start_value_size = 16;
+      if (range > 65535) wlfh[hnd].waveform_start_value_size = 32;
+
+
+      /*  Defacto sign extension of the start and bias values (wlf_bit_unpack doesn't sign extend and these
+          are supposed to be signed integers).  */
+
+      switch (wlfh[hnd].waveform_start_value_size)
+        {
+        case 8:
+          start8 = wlf_bit_unpack (wlfh[hnd].wave_buffer, bit_pos, 8);
+          wlfh[hnd].wave[i][0] = start8 + wlfh[hnd].header.min_waveform[i];
+          bit_pos += 8;
+          bias8 = wlf_bit_unpack (wlfh[hnd].wave_buffer, bit_pos, 8);
+          min_diff = bias8;
+          break;
+
+        case 16:
+          start16 = wlf_bit_unpack (wlfh[hnd].wave_buffer, bit_pos, 16);
+          wlfh[hnd].wave[i][0] = start16 + wlfh[hnd].header.min_waveform[i];
+          bit_pos += 16;
+          bias16 = wlf_bit_unpack (wlfh[hnd].wave_buffer, bit_pos, 16);
+          min_diff = bias16;
+          break;
+
+        case 32:
+          start32 = wlf_bit_unpack (wlfh[hnd].wave_buffer, bit_pos, 32);
+          wlfh[hnd].wave[i][0] = start32 + wlfh[hnd].header.min_waveform[i];
+          bit_pos += 32;
+          bias32 = wlf_bit_unpack (wlfh[hnd].wave_buffer, bit_pos, 32);
+          min_diff = bias32;
+          break;
+        }
+      bit_pos += wlfh[hnd].waveform_start_value_size;
+
+
+      /*  Get the number of bits needed to store each offset.  */
+
+      num_bits = wlf_bit_unpack (wlfh[hnd].wave_buffer, bit_pos, 5);
+      bit_pos += 5;
+
+      for (j = 1 ; j < wlfh[hnd].header.waveform_count[i] ; j++)
+        {
+          /*  Just in case we stored a completely flat waveform array.  */
+
+          if (num_bits)
+            {
+              diff = wlf_bit_unpack (wlfh[hnd].wave_buffer, bit_pos, num_bits);
+              bit_pos += num_bits;
+            }
+          else
+            {
+              diff = 0;
+            }
+
+          wlfh[hnd].wave[i][j] = wlfh[hnd].wave[i][j - 1] + diff + min_diff;
+        }
+    }
+
+  return (WLF_SUCCESS);
+}
+
+
+
+/*********************************************************************************************
+
+  Function:    load_scan_block
+
+  Purpose:     Read up to SCAN_BLOCK records starting at recnum into the scan buffer with a
+               single fseek and fread.
+
+  Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
+
+  Date:        10/19/26
+
+  Arguments:   hnd            -    The file handle
+               recnum         -    The first record number to read
+
+  Returns:     NV_INT32       -    WLF_SUCCESS
+                                   WLF_READ_FSEEK_ERROR
+                                   WLF_READ_ERROR
+
+  Caveats:     The caller must make sure that recnum is a valid record number.
+
+*********************************************************************************************/
+
+static NV_INT32 load_scan_block (NV_INT32 hnd, NV_INT32 recnum)
+{
+  NV_INT64 pos;
+  NV_INT32 count;
+
+
+  if (wlfh[hnd].scan_buffer == NULL)
+    {
+      wlfh[hnd].scan_buffer = (NV_U_BYTE *) malloc (SCAN_BLOCK * wlfh[hnd].record_size);
+      if (wlfh[hnd].scan_buffer == NULL)
+        {
+          perror ("Allocating scan buffer in load_scan_block");
+          exit (-1);
+        }
     }
 
 
+  count = wlfh[hnd].header.number_of_records - recnum;
+  if (count > SCAN_BLOCK) count = SCAN_BLOCK;
+
+  wlfh[hnd].scan_count = 0;
+
+
   pos = (NV_INT64) recnum * (NV_INT64) wlfh[hnd].record_size + (NV_INT64) wlfh[hnd].header_size;
 
   if (fseeko64 (wlfh[hnd].fp, pos, SEEK_SET) < 0)
@@ -3217,7 +3350,7 @@ WLF_DLL NV_INT32 wlf_read_record (NV_INT32 hnd, NV_INT32 recnum, WLF_RECORD *wlf
       return (wlf_error.wlf = WLF_READ_FSEEK_ERROR);
     }
 
-  if (!fread (buffer, wlfh[hnd].record_size, 1, wlfh[hnd].fp))
+  if (fread (wlfh[hnd].scan_buffer, wlfh[hnd].record_size, count, wlfh[hnd].fp) != (size_t) count)
     {
       wlf_error.system = errno;
       wlf_error.recnum = recnum;
@@ -3225,114 +3358,295 @@ WLF_DLL NV_INT32 wlf_read_record (NV_INT32 hnd, NV_INT32 recnum, WLF_RECORD *wlf
       return (wlf_error.wlf = WLF_READ_ERROR);
     }
 
+  wlfh[hnd].scan_start = recnum;
+  wlfh[hnd].scan_count = count;
 
-  /*  Unpack the record.  */
+  wlfh[hnd].at_end = NVFalse;
+  wlfh[hnd].write = NVFalse;
 
-  unpack_point_record (hnd, buffer, wlf_record);
 
+  return (WLF_SUCCESS);
+}
 
-  /*  Read and unpack the waveform address and waveforms if requested and present  */
 
-  if (wave_flag && wlfh[hnd].header.number_of_waveforms)
+
+/*  Returns NVTrue if recnum is in the scan buffer.  */
+
+static NV_BOOL in_scan_block (NV_INT32 hnd, NV_INT32 recnum)
+{
+  return (wlfh[hnd].scan_count && recnum >= wlfh[hnd].scan_start && recnum < wlfh[hnd].scan_start + wlfh[hnd].scan_count);
+}
+
+
+
+/*********************************************************************************************
+
+  Function:    wlf_read_record
+
+  Purpose:     Retrieve a WLF point and (optionally) waveforms from a WLF file.
+
+  Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
+
+  Date:        09/25/09
+
+  Arguments:   hnd            -    The file handle
+               recnum         -    The record number of the WLF record to be retrieved
+               wlf_record     -    The returned WLF record
+               wave_flag      -    Set to NVTrue if you want waveforms
+               wave           -    Pointer to the waveform structure
+
+  Returns:     NV_INT32       -    WLF_SUCCESS
+                                   WLF_INVALID_RECORD_NUMBER
+                                   WLF_READ_FSEEK_ERROR
+                                   WLF_READ_ERROR
+                                   WLF_WAVE_READ_FSEEK_ERROR
+                                   WLF_WAVE_READ_ERROR
+
+  Caveats:     The ***wave structure will be allocated by the software.  If you don't have or
+               want waveforms, set wave_flag to NVFalse and pass a NULL pointer in the
+               ***wave argument (see example in wlf.h).
+
+               If records are read sequentially (i.e. recnum, recnum + 1, recnum + 2...) they
+               will be read from the file in blocks.  Random reads only read one record.  To
+               scan an entire file use wlf_scan_next or wlf_read_records.
+
+*********************************************************************************************/
+
+WLF_DLL NV_INT32 wlf_read_record (NV_INT32 hnd, NV_INT32 recnum, WLF_RECORD *wlf_record, NV_BOOL wave_flag, NV_INT32 ***wave)
+{
+  NV_INT64 pos;
+  NV_U_BYTE buffer[1024];
+  NV_INT32 status;
+  NV_BOOL sequential;
+
+
+  /*  Check for record out of bounds.  */
+
+  if (recnum >= wlfh[hnd].header.number_of_records || recnum < 0)
+    {
+      wlf_error.recnum = recnum;
+      strcpy (wlf_error.file, wlfh[hnd].path);
+      return (wlf_error.wlf = WLF_INVALID_RECORD_NUMBER);
+    }
+
+
+  /*  If the caller is reading the file sequentially we read a block of records at a time instead of one record per
+      fseek/fread.  Random reads still only read the one record.  */
+
+  sequential = (recnum == wlfh[hnd].last_recnum + 1);
+  wlfh[hnd].last_recnum = recnum;
+
+  if (!in_scan_block (hnd, recnum) && sequential)
+    {
+      if ((status = load_scan_block (hnd, recnum))) return (status);
+    }
+
+
+  if (in_scan_block (hnd, recnum))
     {
-      if (fseeko64 (wlfh[hnd].fp, wlfh[hnd].waveform_address + wlfh[hnd].waveform_block_offset, SEEK_SET) < 0)
+      unpack_point_record (hnd, &wlfh[hnd].scan_buffer[(recnum - wlfh[hnd].scan_start) * wlfh[hnd].record_size], wlf_record);
+    }
+  else
+    {
+      pos = (NV_INT64) recnum * (NV_INT64) wlfh[hnd].record_size + (NV_INT64) wlfh[hnd].header_size;
+
+      if (fseeko64 (wlfh[hnd].fp, pos, SEEK_SET) < 0)
         {
           wlf_error.system = errno;
           wlf_error.recnum = recnum;
           strcpy (wlf_error.file, wlfh[hnd].path);
-          return (wlf_error.wlf = WLF_WAVE_READ_FSEEK_ERROR);
+          return (wlf_error.wlf = WLF_READ_FSEEK_ERROR);
         }
 
-      if (!fread (wlfh[hnd].wave_buffer, wlfh[hnd].waveform_blocksize_bytes, 1, wlfh[hnd].fp))
+      if (!fread (buffer, wlfh[hnd].record_size, 1, wlfh[hnd].fp))
         {
           wlf_error.system = errno;
           wlf_error.recnum = recnum;
           strcpy (wlf_error.file, wlfh[hnd].path);
-          return (wlf_error.wlf = WLF_WAVE_READ_ERROR);
+          return (wlf_error.wlf = WLF_READ_ERROR);
         }
 
-      bytes = wlf_bit_unpack (wlfh[hnd].wave_buffer, 0, wlfh[hnd].waveform_blocksize_bits);
 
-      bytes -= wlfh[hnd].waveform_blocksize_bytes;
+      /*  Unpack the record.  */
+
+      unpack_point_record (hnd, buffer, wlf_record);
+    }
+
+
+  /*  Read and unpack the waveform address and waveforms if requested and present  */
+
+  if (wave_flag && wlfh[hnd].header.number_of_waveforms)
+    {
+      if ((status = read_waveforms (hnd, recnum))) return (status);
+
+      *wave = wlfh[hnd].wave;
+    }
+
+
+  wlfh[hnd].at_end = NVFalse;
+  wlfh[hnd].write = NVFalse;
+
+
+  wlf_error.system = 0;
+  return (wlf_error.wlf = WLF_SUCCESS);
+}
+
+
+
+/*********************************************************************************************
+
+  Function:    wlf_read_records
+
+  Purpose:     Retrieve a range of WLF points (without waveforms) from a WLF file.  The records
+               are read in large blocks so this is much faster than calling wlf_read_record for
+               each record.
+
+  Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
+
+  Date:        10/19/26
+
+  Arguments:   hnd            -    The file handle
+               start          -    The record number of the first WLF record to be retrieved
+               count          -    The number of records to retrieve
+               wlf_record     -    Array of count WLF records to be returned
+
+  Returns:     NV_INT32       -    WLF_SUCCESS
+                                   WLF_INVALID_RECORD_NUMBER
+                                   WLF_READ_FSEEK_ERROR
+                                   WLF_READ_ERROR
+
+*********************************************************************************************/
+
+WLF_DLL NV_INT32 wlf_read_records (NV_INT32 hnd, NV_INT32 start, NV_INT32 count, WLF_RECORD *wlf_record)
+{
+  NV_INT32 i, recnum, status;
+
+
+  /*  Check for records out of bounds.  */
 
-      if (!fread (wlfh[hnd].wave_buffer, bytes, 1, wlfh[hnd].fp))
+  if (start < 0 || count < 0 || start + count > wlfh[hnd].header.number_of_records)
+    {
+      wlf_error.recnum = start < 0 ? start : start + count - 1;
+      strcpy (wlf_error.file, wlfh[hnd].path);
+      return (wlf_error.wlf = WLF_INVALID_RECORD_NUMBER);
+    }
+
+
+  for (i = 0 ; i < count ; i++)
+    {
+      recnum = start + i;
+
+      if (!in_scan_block (hnd, recnum))
         {
-          wlf_error.system = errno;
-          wlf_error.recnum = recnum;
-          strcpy (wlf_error.file, wlfh[hnd].path);
-          return (wlf_error.wlf = WLF_WAVE_READ_ERROR);
+          if ((status = load_scan_block (hnd, recnum))) return (status);
         }
 
-      bit_pos = 0;
-      for (i = 0 ; i < wlfh[hnd].header.number_of_waveforms ; i++)
-        {
-          wlfh[hnd].waveform_start_value_size = 8;
-          range = wlfh[hnd].header.max_waveform[i] - wlfh[hnd].header.min_waveform[i];
-          if (range > 255) wlfh[hnd].waveform_start_value_size = 16;
-          if (range > 65535) wlfh[hnd].waveform_start_value_size = 32;
+      unpack_point_record (hnd, &wlfh[hnd].scan_buffer[(recnum - wlfh[hnd].scan_start) * wlfh[hnd].record_size], &wlf_record[i]);
+    }
+
 
+  wlf_error.system = 0;
+  return (wlf_error.wlf = WLF_SUCCESS);
+}
 
-          /*  Defacto sign extension of the start and bias values (wlf_bit_unpack doesn't sign extend and these
-              are supposed to be signed integers).  */
 
-          switch (wlfh[hnd].waveform_start_value_size)
-            {
-            case 8:
-              start8 = wlf_bit_unpack (wlfh[hnd].wave_buffer, bit_pos, 8);
-              wlfh[hnd].wave[i][0] = start8 + wlfh[hnd].header.min_waveform[i];
-              bit_pos += 8;
-              bias8 = wlf_bit_unpack (wlfh[hnd].wave_buffer, bit_pos, 8);
-              min_diff = bias8;
-              break;
-
-            case 16:
-              start16 = wlf_bit_unpack (wlfh[hnd].wave_buffer, bit_pos, 16);
-              wlfh[hnd].wave[i][0] = start16 + wlfh[hnd].header.min_waveform[i];
-              bit_pos += 16;
-              bias16 = wlf_bit_unpack (wlfh[hnd].wave_buffer, bit_pos, 16);
-              min_diff = bias16;
-              break;
-
-            case 32:
-              start32 = wlf_bit_unpack (wlfh[hnd].wave_buffer, bit_pos, 32);
-              wlfh[hnd].wave[i][0] = start32 + wlfh[hnd].header.min_waveform[i];
-              bit_pos += 32;
-              bias32 = wlf_bit_unpack (wlfh[hnd].wave_buffer, bit_pos, 32);
-              min_diff = bias32;
-              break;
-            }
-          bit_pos += wlfh[hnd].waveform_start_value_size;
 
+/*********************************************************************************************
 
-          /*  Get the number of bits needed to store each offset.  */
+  Function:    wlf_scan_start
 
-          num_bits = wlf_bit_unpack (wlfh[hnd].wave_buffer, bit_pos, 5);
-          bit_pos += 5;
+  Purpose:     Set the record number at which a sequential scan of the file (using
+               wlf_scan_next) will start.
 
-          for (j = 1 ; j < wlfh[hnd].header.waveform_count[i] ; j++)
-            {
-              /*  Just in case we stored a completely flat waveform array.  */
+  Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
 
-              if (num_bits)
-                {
-                  diff = wlf_bit_unpack (wlfh[hnd].wave_buffer, bit_pos, num_bits);
-                  bit_pos += num_bits;
-                }
-              else
-                {
-                  diff = 0;
-                }
+  Date:        10/19/26
 
-              wlfh[hnd].wave[i][j] = wlfh[hnd].wave[i][j - 1] + diff + min_diff;
-            }
-        }
+  Arguments:   hnd            -    The file handle
+               recnum         -    The first record number to be returned by wlf_scan_next
 
-      *wave = wlfh[hnd].wave;
+  Returns:     NV_INT32       -    WLF_SUCCESS
+                                   WLF_INVALID_RECORD_NUMBER
+
+*********************************************************************************************/
+
+WLF_DLL NV_INT32 wlf_scan_start (NV_INT32 hnd, NV_INT32 recnum)
+{
+  if (recnum > wlfh[hnd].header.number_of_records || recnum < 0)
+    {
+      wlf_error.recnum = recnum;
+      strcpy (wlf_error.file, wlfh[hnd].path);
+      return (wlf_error.wlf = WLF_INVALID_RECORD_NUMBER);
     }
 
+  wlfh[hnd].scan_next = recnum;
 
-  wlfh[hnd].at_end = NVFalse;
-  wlfh[hnd].write = NVFalse;
+
+  wlf_error.system = 0;
+  return (wlf_error.wlf = WLF_SUCCESS);
+}
+
+
+
+/*********************************************************************************************
+
+  Function:    wlf_scan_next
+
+  Purpose:     Retrieve the next WLF point and (optionally) waveforms in a sequential scan of
+               a WLF file.  Records are read in large blocks.  The scan starts at record 0
+               when the file is opened or at the record set with wlf_scan_start.
+
+  Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
+
+  Date:        10/19/26
+
+  Arguments:   hnd            -    The file handle
+               wlf_record     -    The returned WLF record
+               recnum         -    The returned record number of the WLF record
+               wave_flag      -    Set to NVTrue if you want waveforms
+               wave           -    Pointer to the waveform structure
+
+  Returns:     NV_INT32       -    WLF_SUCCESS
+                                   WLF_SCAN_END_OF_FILE
+                                   WLF_READ_FSEEK_ERROR
+                                   WLF_READ_ERROR
+                                   WLF_WAVE_READ_FSEEK_ERROR
+                                   WLF_WAVE_READ_ERROR
+
+  Caveats:     Waveforms are stored in a different part of the file than the points so, if
+               you don't need them, set wave_flag to NVFalse and pass a NULL pointer in the
+               ***wave argument.  That way we never have to leave the point records.
+
+*********************************************************************************************/
+
+WLF_DLL NV_INT32 wlf_scan_next (NV_INT32 hnd, WLF_RECORD *wlf_record, NV_INT32 *recnum, NV_BOOL wave_flag, NV_INT32 ***wave)
+{
+  NV_INT32 status;
+
+
+  if (wlfh[hnd].scan_next >= wlfh[hnd].header.number_of_records)
+    {
+      wlf_error.system = 0;
+      return (wlf_error.wlf = WLF_SCAN_END_OF_FILE);
+    }
+
+
+  *recnum = wlfh[hnd].scan_next++;
+
+  if (!in_scan_block (hnd, *recnum))
+    {
+      if ((status = load_scan_block (hnd, *recnum))) return (status);
+    }
+
+  unpack_point_record (hnd, &wlfh[hnd].scan_buffer[(*recnum - wlfh[hnd].scan_start) * wlfh[hnd].record_size], wlf_record);
+
+
+  if (wave_flag && wlfh[hnd].header.number_of_waveforms)
+    {
+      if ((status = read_waveforms (hnd, *recnum))) return (status);
+
+      *wave = wlfh[hnd].wave;
+    }
 
 
   wlf_error.system = 0;
@@ -3441,6 +3755,7 @@ WLF_DLL NV_INT32 wlf_update_record (NV_INT32 hnd, NV_INT32 recnum, WLF_RECORD wl
   NV_INT64 pos;
   NV_U_BYTE buffer[1024];
   NV_INT32 i, value;
+  NV_BOOL scan;
 
 
   if (recnum >= wlfh[hnd].header.number_of_records || recnum < 0)
@@ -3453,21 +3768,34 @@ WLF_DLL NV_INT32 wlf_update_record (NV_INT32 hnd, NV_INT32 recnum, WLF_RECORD wl
 
   pos = (NV_INT64) recnum * (NV_INT64) wlfh[hnd].record_size + (NV_INT64) wlfh[hnd].header_size;
 
-  if (fseeko64 (wlfh[hnd].fp, pos, SEEK_SET) < 0)
+
+  /*  If the record is in the scan buffer (the usual case when updating records as they are read) we start from that
+      copy instead of reading it again.  */
+
+  scan = in_scan_block (hnd, recnum);
+
+  if (scan)
     {
-      wlf_error.system = errno;
-      wlf_error.recnum = recnum;
-      strcpy (wlf_error.file, wlfh[hnd].path);
-      return (wlf_error.wlf = WLF_UPDATE_RECORD_FSEEK_ERROR);
+      memcpy (buffer, &wlfh[hnd].scan_buffer[(recnum - wlfh[hnd].scan_start) * wlfh[hnd].record_size], wlfh[hnd].record_size);
     }
+  else
+    {
+      if (fseeko64 (wlfh[hnd].fp, pos, SEEK_SET) < 0)
+        {
+          wlf_error.system = errno;
+          wlf_error.recnum = recnum;
+          strcpy (wlf_error.file, wlfh[hnd].path);
+          return (wlf_error.wlf = WLF_UPDATE_RECORD_FSEEK_ERROR);
+        }
 
 
-  if (!fread (buffer, wlfh[hnd].record_size, 1, wlfh[hnd].fp))
-    {
-      wlf_error.system = errno;
-      wlf_error.recnum = recnum;
-      strcpy (wlf_error.file, wlfh[hnd].path);
-      return (wlf_error.wlf = WLF_UPDATE_RECORD_READ_ERROR);
+      if (!fread (buffer, wlfh[hnd].record_size, 1, wlfh[hnd].fp))
+        {
+          wlf_error.system = errno;
+          wlf_error.recnum = recnum;
+          strcpy (wlf_error.file, wlfh[hnd].path);
+          return (wlf_error.wlf = WLF_UPDATE_RECORD_READ_ERROR);
+        }
     }
 
 
@@ -3571,6 +3899,11 @@ WLF_DLL NV_INT32 wlf_update_record (NV_INT32 hnd, NV_INT32 recnum, WLF_RECORD wl
     }
 
 
+  /*  Keep the scan buffer's copy of the record in sync so we don't have to reload the block.  */
+
+  if (scan) memcpy (&wlfh[hnd].scan_buffer[(recnum - wlfh[hnd].scan_start) * wlfh[hnd].record_size], buffer, wlfh[hnd].record_size);
+
+
   wlfh[hnd].modified = NVTrue;
   wlfh[hnd].write = NVTrue;
 
@@ -3817,6 +4150,10 @@ WLF_DLL NV_CHAR *wlf_strerror ()
     case WLF_SENSOR_ATTITUDE_RANGE_ERROR:
       sprintf (message, _("File : %s\n%s\n"), wlf_error.file, wlf_error.info);
       break;
+
+    case WLF_SCAN_END_OF_FILE:
+      sprintf (message, _("End of file reached during sequential scan.\n"));
+      break;
     }
 
   return (message);
@@ -1042,6 +1042,7 @@ extern "C" {
 #define       WLF_VALUE_OUT_OF_RANGE_ERROR     -29
 #define       WLF_SENSOR_POSITION_RANGE_ERROR  -30
 #define       WLF_SENSOR_ATTITUDE_RANGE_ERROR  -31
+#define       WLF_SCAN_END_OF_FILE             -32
 
 
 
@@ -1404,6 +1405,10 @@ extern "C" {
                want waveforms, set wave_flag to NVFalse and pass a NULL pointer in the
                ***wave argument (see example in wlf.h).
 
+               If records are read sequentially (i.e. recnum, recnum + 1, recnum + 2...) they
+               will be read from the file in blocks.  Random reads only read one record.  To
+               scan an entire file use wlf_scan_next or wlf_read_records.
+
   *********************************************************************************************/
 
   WLF_DLL NV_INT32 wlf_read_record (NV_INT32 hnd, NV_INT32 recnum, WLF_RECORD *wlf_record, NV_BOOL wave_flag, NV_INT32 ***wave);
@@ -1412,6 +1417,108 @@ extern "C" {
 
 
 
+
+  /*********************************************************************************************
+
+  Function:    wlf_read_records
+
+  Purpose:     Retrieve a range of WLF points (without waveforms) from a WLF file.  The records
+               are read in large blocks so this is much faster than calling wlf_read_record for
+               each record.
+
+  Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
+
+  Date:        10/19/26
+
+  Arguments:   hnd            -    The file handle
+               start          -    The record number of the first WLF record to be retrieved
+               count          -    The number of records to retrieve
+               wlf_record     -    Array of count WLF records to be returned
+
+  Returns:     NV_INT32       -    WLF_SUCCESS
+                                   WLF_INVALID_RECORD_NUMBER
+                                   WLF_READ_FSEEK_ERROR
+                                   WLF_READ_ERROR
+
+  *********************************************************************************************/
+
+  WLF_DLL NV_INT32 wlf_read_records (NV_INT32 hnd, NV_INT32 start, NV_INT32 count, WLF_RECORD *wlf_record);
+
+
+
+
+
+  /*********************************************************************************************
+
+  Function:    wlf_scan_start
+
+  Purpose:     Set the record number at which a sequential scan of the file (using
+               wlf_scan_next) will start.
+
+  Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
+
+  Date:        10/19/26
+
+  Arguments:   hnd            -    The file handle
+               recnum         -    The first record number to be returned by wlf_scan_next
+
+  Returns:     NV_INT32       -    WLF_SUCCESS
+                                   WLF_INVALID_RECORD_NUMBER
+
+  *********************************************************************************************/
+
+  WLF_DLL NV_INT32 wlf_scan_start (NV_INT32 hnd, NV_INT32 recnum);
+
+
+
+
+
+  /*********************************************************************************************
+
+  Function:    wlf_scan_next
+
+  Purpose:     Retrieve the next WLF point and (optionally) waveforms in a sequential scan of
+               a WLF file.  Records are read in large blocks.  The scan starts at record 0
+               when the file is opened or at the record set with wlf_scan_start.
+
+  Author:      Jan C. Depner (jan.depner@navy.mil, eviltwin69@cableone.net)
+
+  Date:        10/19/26
+
+  Arguments:   hnd            -    The file handle
+               wlf_record     -    The returned WLF record
+               recnum         -    The returned record number of the WLF record
+               wave_flag      -    Set to NVTrue if you want waveforms
+               wave           -    Pointer to the waveform structure
+
+  Returns:     NV_INT32       -    WLF_SUCCESS
+                                   WLF_SCAN_END_OF_FILE
+                                   WLF_READ_FSEEK_ERROR
+                                   WLF_READ_ERROR
+                                   WLF_WAVE_READ_FSEEK_ERROR
+                                   WLF_WAVE_READ_ERROR
+
+  Caveats:     Waveforms are stored in a different part of the file than the points so, if
+               you don't need them, set wave_flag to NVFalse and pass a NULL pointer in the
+               ***wave argument.  That way we never have to leave the point records.
+
+               Example:
+
+               while (wlf_scan_next (wlf_handle, &wlf_record, &recnum, NVFalse, NULL) == WLF_SUCCESS)
+                 {
+                   .
+                   .
+                   .
+                 }
+
+  *********************************************************************************************/
+
+  WLF_DLL NV_INT32 wlf_scan_next (NV_INT32 hnd, WLF_RECORD *wlf_record, NV_INT32 *recnum, NV_BOOL wave_flag, NV_INT32 ***wave);
+
+
+
+
+
   /*********************************************************************************************
 
   Function:    wlf_append_record
@@ -15,7 +15,7 @@
 
 #ifndef WLF_VERSION
 
-#define     WLF_VERSION "PFM Software - WLF library V1.05 - 10/26/10"
+#define     WLF_VERSION "PFM Software - WLF library V1.06 - 10/19/26"
 
 #endif
 
@@ -66,4 +66,13 @@
 
     Fix screwup when reading version string.
 
+
+    Version 1.06
+    Jan C. Depner
+    10/19/26
+
+    Added wlf_read_records, wlf_scan_start, and wlf_scan_next to read blocks of records with a single read.  Sequential
+    calls to wlf_read_record are now also read in blocks.  wlf_update_record updates the block in place so a read then
+    update loop doesn't reload it.
+
 */